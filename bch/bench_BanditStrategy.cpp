@@ -0,0 +1,161 @@
+/**
+ * @file bench_BanditStrategy.cpp
+ * @brief Regret and decision cost of BanditStrategy against rand() % 3.
+ *
+ * ## Benchmark Strategy
+ * Regret: each policy plays the built-in portfolio against a set of
+ * opponents, and its cumulative payoff (1 win, 1/2 draw, 0 loss) is
+ * compared at checkpoints with the best single arm played alone against
+ * the same opponent, which is what the selector could have achieved by
+ * knowing the answer in advance. The rand() % 3 baseline that the console
+ * game uses is listed alongside; its regret grows linearly, a working
+ * selector's grows like log t (UCB1, Thompson) or sqrt t (EXP3).
+ *
+ * Cost: nanoseconds per decision (NextMove() plus ObserveRound()) against
+ * a constant opponent, including the portfolio's own strategies.
+ *
+ * Usage: bench_BanditStrategy [rounds]
+ */
+
+ #include <algorithm>
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <functional>
+ #include <memory>
+ #include <vector>
+ #include "BanditStrategy.hpp"
+ #include "GameRules.hpp"
+ #include "MoveStrategies.hpp"
+
+ namespace {
+
+ using Clock = std::chrono::steady_clock;
+
+ double Payoff(GameMove own, GameMove other) {
+     return IsRoundDraw(own, other) ? 0.5 : DoesFirstMoveWin(own, other) ? 1.0 : 0.0;
+ }
+
+ /**
+  * @brief Plays `rounds` rounds; cumulative payoff after each checkpoint.
+  */
+ std::vector<double> Curve(IMoveStrategy& player, IMoveStrategy& opponent, long rounds,
+                           const std::vector<long>& checkpoints) {
+     std::vector<double> curve;
+     double total {};
+     std::size_t next {};
+     for (long round{1}; round <= rounds; ++round) {
+         GameMove own { player.NextMove() };
+         GameMove other { opponent.NextMove() };
+         total += Payoff(own, other);
+         player.ObserveRound(own, other);
+         opponent.ObserveRound(other, own);
+         if (next < checkpoints.size() && round == checkpoints[next]) {
+             curve.push_back(total);
+             ++next;
+         }
+     }
+     return curve;
+ }
+
+ /**
+  * @brief The console game's computer: rand() % 3, blind to history.
+  */
+ class RandBaseline : public IMoveStrategy {
+ public:
+     GameMove NextMove() override { return static_cast<GameMove>(1 + std::rand() % 3); }
+     void ObserveRound(GameMove, GameMove) override {}
+     bool DependsOnHistory() const override { return false; }
+ };
+
+ std::vector<std::unique_ptr<IMoveStrategy>> BuiltinArms() {
+     std::vector<std::unique_ptr<IMoveStrategy>> arms;
+     for (const char* name : {"rock", "paper", "scissors", "cycle", "copycat", "counter", "random"}) {
+         arms.push_back(MakeMoveStrategy(name, 1));
+     }
+     return arms;
+ }
+
+ const char* PolicyName(BanditPolicy policy) {
+     switch (policy) {
+     case BanditPolicy::Ucb1:     return "ucb1";
+     case BanditPolicy::Thompson: return "thompson";
+     case BanditPolicy::Exp3:     return "exp3";
+     }
+     return "?";
+ }
+
+ void MeasureRegret(const char* opponentName, long rounds, const std::vector<long>& checkpoints) {
+     // Best arm in hindsight, checkpoint by checkpoint.
+     std::vector<double> best(checkpoints.size(), 0.0);
+     for (auto& arm : BuiltinArms()) {
+         auto opponent = MakeMoveStrategy(opponentName, 99);
+         std::vector<double> curve { Curve(*arm, *opponent, rounds, checkpoints) };
+         for (std::size_t i{}; i < curve.size(); ++i) {
+             best[i] = std::max(best[i], curve[i]);
+         }
+     }
+
+     auto print = [&](const char* name, IMoveStrategy& player) {
+         auto opponent = MakeMoveStrategy(opponentName, 99);
+         std::vector<double> curve { Curve(player, *opponent, rounds, checkpoints) };
+         std::printf("%-10s %-10s", opponentName, name);
+         for (std::size_t i{}; i < curve.size(); ++i) {
+             std::printf(" %10.1f", best[i] - curve[i]);
+         }
+         std::printf("\n");
+     };
+     for (BanditPolicy policy : {BanditPolicy::Ucb1, BanditPolicy::Thompson, BanditPolicy::Exp3}) {
+         auto bandit = BanditStrategy::WithBuiltinPortfolio({policy, 1.0, 0.1, 7});
+         print(PolicyName(policy), *bandit);
+     }
+     RandBaseline baseline;
+     print("rand()%3", baseline);
+ }
+
+ double NanosPerDecision(IMoveStrategy& player, long rounds) {
+     GameMove opponent {GameMove::Rock};
+     unsigned sink {};
+     auto begin = Clock::now();
+     for (long round{}; round < rounds; ++round) {
+         GameMove own { player.NextMove() };
+         sink += static_cast<unsigned>(own);
+         player.ObserveRound(own, opponent);
+     }
+     double nanos { std::chrono::duration<double, std::nano>(Clock::now() - begin).count() };
+     if (sink == 0) {
+         std::printf("!");
+     }
+     return nanos / static_cast<double>(rounds);
+ }
+
+ } // namespace
+
+ int main(int argc, char** argv) {
+     long rounds { argc > 1 ? std::atol(argv[1]) : 100000 };
+     std::vector<long> checkpoints;
+     for (long t {100}; t <= rounds; t *= 10) {
+         checkpoints.push_back(t);
+     }
+     std::srand(1);
+
+     std::printf("Regret against the best single arm (payoff: win 1, draw 1/2), built-in portfolio of 7\n");
+     std::printf("%-10s %-10s", "opponent", "player");
+     for (long t : checkpoints) {
+         std::printf(" %10ld", t);
+     }
+     std::printf("\n");
+     for (const char* opponent : {"rock", "cycle", "copycat", "counter", "random"}) {
+         MeasureRegret(opponent, rounds, checkpoints);
+     }
+
+     std::printf("\nCost per decision (NextMove + ObserveRound), %ld rounds\n", rounds);
+     for (BanditPolicy policy : {BanditPolicy::Ucb1, BanditPolicy::Thompson, BanditPolicy::Exp3}) {
+         auto bandit = BanditStrategy::WithBuiltinPortfolio({policy, 1.0, 0.1, 7});
+         std::printf("%-10s %8.1f ns\n", PolicyName(policy), NanosPerDecision(*bandit, rounds));
+     }
+     RandBaseline baseline;
+     std::printf("%-10s %8.1f ns\n", "rand()%3", NanosPerDecision(baseline, rounds));
+     return 0;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,98 @@
+/**
+ * @file bench_BotDetector.cpp
+ * @brief Per-round cost of BotDetector, alone and inside SinglePlayerRpsGame.
+ *
+ * ## Benchmark Strategy
+ * First, rounds from a fixed population of users are fed to OnRound()
+ * directly, which isolates the detector: name lookup, locking and the
+ * window update. Then a SinglePlayerRpsGame plays a long session from a
+ * pre-filled QueuedMoveMessenger, once without an observer and once with
+ * the detector, and the difference per round is what the detector adds
+ * to Play().
+ *
+ * Usage: bench_BotDetector [rounds] [users]
+ */
+
+ #include <algorithm>
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <memory>
+ #include <string>
+ #include <vector>
+ #include "BotDetector.hpp"
+ #include "ComputerPlayer.hpp"
+ #include "QueuedMoveMessenger.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "UserPlayer.hpp"
+
+ namespace {
+
+ using Clock = std::chrono::steady_clock;
+
+ double NanosSince(Clock::time_point begin) {
+     return std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+ }
+
+ double MeasureOnRound(const std::vector<std::string>& names, long rounds) {
+     BotDetector detector;
+     RoundRecord record {};
+     record.computerName = "bot";
+     std::uint64_t state {7};
+     auto begin = Clock::now();
+     for (long i{}; i < rounds; ++i) {
+         state = state * 6364136223846793005ull + 1442695040888963407ull;
+         record.userName = names[static_cast<std::size_t>(i) % names.size()];
+         record.userMove = static_cast<std::uint8_t>(1 + (state >> 33) % 3);
+         record.computerMove = static_cast<std::uint8_t>(1 + (state >> 40) % 3);
+         record.outcome = static_cast<RoundOutcome>((state >> 50) % 3);
+         detector.OnRound(record);
+     }
+     return NanosSince(begin) / static_cast<double>(rounds);
+ }
+
+ double MeasurePlay(int rounds, IRoundObserver* observer) {
+     auto messenger = std::make_unique<QueuedMoveMessenger>();
+     std::uint64_t state {11};
+     for (int i{}; i < rounds; ++i) {
+         state = state * 6364136223846793005ull + 1442695040888963407ull;
+         messenger->PushMove(static_cast<int>(1 + (state >> 33) % 3));
+     }
+     SinglePlayerRpsGame game{std::make_shared<UserPlayer>("ann"), std::make_shared<ComputerPlayer>("bot"),
+                              std::move(messenger), rounds,
+                              [state]() mutable {
+                                  state = state * 6364136223846793005ull + 1442695040888963407ull;
+                                  return static_cast<int>(state >> 33);
+                              }};
+     if (observer) {
+         game.SetRoundObserver(observer, 1);
+     }
+     auto begin = Clock::now();
+     game.Play();
+     return NanosSince(begin) / static_cast<double>(rounds);
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     long rounds { argc > 1 ? std::atol(argv[1]) : 2'000'000L };
+     int users { argc > 2 ? std::atoi(argv[2]) : 1000 };
+
+     std::vector<std::string> names;
+     for (int i{}; i < users; ++i) {
+         names.push_back("user-" + std::to_string(i));
+     }
+     std::printf("BotDetector::OnRound, %d users: %.1f ns per round\n", users, MeasureOnRound(names, rounds));
+
+     int sessionRounds { static_cast<int>(std::min(rounds, 1'000'000L)) };
+     double plain { MeasurePlay(sessionRounds, nullptr) };
+     BotDetector detector;
+     double observed { MeasurePlay(sessionRounds, &detector) };
+     std::printf("SinglePlayerRpsGame::Play, %d rounds\n", sessionRounds);
+     std::printf("%-22s %10.1f ns per round\n", "no observer", plain);
+     std::printf("%-22s %10.1f ns per round\n", "BotDetector", observed);
+     std::printf("%-22s %10.1f ns per round\n", "added", observed - plain);
+     return 0;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,165 @@
+/**
+ * @file bench_GameSessionFactory.cpp
+ * @brief Multi-threaded throughput benchmark for GameSessionFactory::Create.
+ *
+ * ## Benchmark Strategy
+ * Every thread calls Create() in a tight loop while a background writer
+ * re-registers a mode every millisecond. The snapshot-based factory is
+ * compared against a baseline that guards the same map with a mutex, so
+ * contention collapse (ns/op growing with the thread count) is visible.
+ *
+ * A second, single-threaded pass compares the dispatch paths themselves:
+ * the dense built-in array (runtime and compile-time index), the hash-map
+ * fallback for dynamic modes, and the old std::function + unordered_map.
+ *
+ * The creator returns nullptr to keep allocator noise out of the numbers:
+ * only the registry lookup and the creator dispatch are measured.
+ *
+ * Usage: bench_GameSessionFactory [opsPerThread] [maxThreads]
+ */
+
+ #include <atomic>
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <functional>
+ #include <memory>
+ #include <mutex>
+ #include <thread>
+ #include <unordered_map>
+ #include <vector>
+ #include "GameSessionFactory.hpp"
+
+ namespace {
+
+ /**
+  * @brief The pre-snapshot factory design: one map guarded by one mutex.
+  */
+ class MutexFactory {
+ public:
+     void RegisterGame(GameMode mode, GameSessionFactory::CreatorFunc func) {
+         std::lock_guard<std::mutex> lock{m_mutex};
+         m_registry[mode] = std::move(func);
+     }
+
+     std::unique_ptr<IGameSession> Create(GameMode mode) {
+         std::lock_guard<std::mutex> lock{m_mutex};
+         auto it = m_registry.find(mode);
+         return it != m_registry.end() ? it->second() : nullptr;
+     }
+
+ private:
+     std::mutex m_mutex {};
+     std::unordered_map<GameMode, GameSessionFactory::CreatorFunc> m_registry {};
+ };
+
+ /**
+  * @brief Runs `threads` readers plus one writer and returns ns per Create().
+  */
+ template <typename Factory>
+ double MeasureNsPerCreate(Factory& factory, int threads, long opsPerThread)
+ {
+     std::atomic<bool> start {false};
+     std::atomic<bool> stop {false};
+     std::atomic<long> nullSessions {0};
+
+     std::thread writer([&]() {
+         while (!stop.load(std::memory_order_relaxed)) {
+             factory.RegisterGame(GameMode::ConsoleSinglePlayer, []() {
+                 return std::unique_ptr<IGameSession>{};
+             });
+             std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         }
+     });
+
+     std::vector<std::thread> readers;
+     for (int t{}; t < threads; ++t) {
+         readers.emplace_back([&]() {
+             while (!start.load(std::memory_order_acquire)) {
+                 std::this_thread::yield();
+             }
+             long local {};
+             for (long i{}; i < opsPerThread; ++i) {
+                 local += factory.Create(GameMode::ConsoleSinglePlayer) == nullptr;
+             }
+             nullSessions += local;
+         });
+     }
+
+     auto begin = std::chrono::steady_clock::now();
+     start.store(true, std::memory_order_release);
+     for (auto& reader : readers) {
+         reader.join();
+     }
+     auto end = std::chrono::steady_clock::now();
+
+     stop.store(true);
+     writer.join();
+
+     double ns { std::chrono::duration<double, std::nano>(end - begin).count() };
+     return ns / static_cast<double>(opsPerThread);
+ }
+
+ /**
+  * @brief Times `ops` calls of `create` on one thread and returns ns per call.
+  */
+ template <typename CreateFunc>
+ double MeasureDispatchNs(long ops, CreateFunc create)
+ {
+     long nullSessions {};
+     auto begin = std::chrono::steady_clock::now();
+     for (long i{}; i < ops; ++i) {
+         nullSessions += create() == nullptr;
+     }
+     auto end = std::chrono::steady_clock::now();
+     if (nullSessions != ops) {
+         std::printf("unexpected session\n");
+     }
+     return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(ops);
+ }
+
+ void RunDispatchComparison(long ops)
+ {
+     auto nullCreator = []() { return std::unique_ptr<IGameSession>{}; };
+     const auto dynamicMode = static_cast<GameMode>(kBuiltinGameModeCount + 7);
+
+     GameSessionFactory factory;
+     factory.RegisterGame<GameMode::ConsoleSinglePlayer>(nullCreator);
+     factory.RegisterGame(dynamicMode, nullCreator);
+
+     std::unordered_map<GameMode, std::function<std::unique_ptr<IGameSession>()>> legacy;
+     legacy[GameMode::ConsoleSinglePlayer] = nullCreator;
+
+     std::printf("\nSingle-thread dispatch ns per Create()\n");
+     std::printf("%-40s %10.2f\n", "dense array, Create<Mode>()",
+                 MeasureDispatchNs(ops, [&]() { return factory.Create<GameMode::ConsoleSinglePlayer>(); }));
+     std::printf("%-40s %10.2f\n", "dense array, Create(mode)",
+                 MeasureDispatchNs(ops, [&]() { return factory.Create(GameMode::ConsoleSinglePlayer); }));
+     std::printf("%-40s %10.2f\n", "dynamic mode, hash-map fallback",
+                 MeasureDispatchNs(ops, [&]() { return factory.Create(dynamicMode); }));
+     std::printf("%-40s %10.2f\n", "legacy unordered_map + std::function",
+                 MeasureDispatchNs(ops, [&]() { return legacy.find(GameMode::ConsoleSinglePlayer)->second(); }));
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     long opsPerThread { argc > 1 ? std::atol(argv[1]) : 2'000'000L };
+     int maxThreads { argc > 2 ? std::atoi(argv[2]) : 8 };
+
+     std::printf("Create() wall-clock ns per call and per thread (lower is better)\n");
+     std::printf("%8s %16s %16s\n", "threads", "snapshot", "mutex");
+
+     for (int threads {1}; threads <= maxThreads; threads *= 2) {
+         GameSessionFactory snapshotFactory;
+         MutexFactory mutexFactory;
+         double snapshotNs { MeasureNsPerCreate(snapshotFactory, threads, opsPerThread) };
+         double mutexNs { MeasureNsPerCreate(mutexFactory, threads, opsPerThread) };
+         std::printf("%8d %16.2f %16.2f\n", threads, snapshotNs, mutexNs);
+     }
+
+     RunDispatchComparison(opsPerThread);
+     return 0;
+ }
+ 
\ No newline at end of file
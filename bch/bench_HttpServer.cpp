@@ -0,0 +1,162 @@
+/**
+ * @file bench_HttpServer.cpp
+ * @brief Request parsing cost and end-to-end request rate of the HTTP game API.
+ *
+ * ## Benchmark Strategy
+ * Parsing: a typical move request is parsed one million times by
+ * HttpRequestParser and by a straightforward baseline that copies the
+ * request line, headers and body into std::strings and a std::map, which is
+ * what the zero-allocation parser replaces. Reported as nanoseconds per
+ * request.
+ *
+ * End to end: an HttpServer serving HttpGameApi runs on a background thread
+ * on an ephemeral loopback port, and HttpLoadGenerator drives it from the
+ * main thread for a fixed time per configuration. Each connection plays one
+ * long session; a pipeline depth of 1 is plain keep-alive, larger depths
+ * write that many requests per send. The table shows requests per second,
+ * the mean round-trip of a batch and the server's send() calls per request.
+ * Server and generator share the machine, so on few cores both compete for
+ * the same CPU.
+ *
+ * Usage: bench_HttpServer [secondsPerRow]
+ */
+
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <map>
+ #include <sstream>
+ #include <string>
+ #include <thread>
+ #include "GameSessionFactory.hpp"
+ #include "HttpGameApi.hpp"
+ #include "HttpLoadGenerator.hpp"
+ #include "HttpServer.hpp"
+
+ namespace {
+
+ using Clock = std::chrono::steady_clock;
+
+ const std::string kRequest {
+     "POST /sessions/17/moves HTTP/1.1\r\n"
+     "Host: localhost:8080\r\n"
+     "User-Agent: bench\r\n"
+     "Accept: application/json\r\n"
+     "Content-Type: application/json\r\n"
+     "Content-Length: 16\r\n"
+     "\r\n"
+     "{\"move\":\"paper\"}"
+ };
+
+ /**
+  * @brief The allocating baseline: copies everything out of the buffer.
+  */
+ struct BaselineRequest {
+     std::string method;
+     std::string target;
+     std::string version;
+     std::map<std::string, std::string> headers;
+     std::string body;
+ };
+
+ bool ParseBaseline(const std::string& text, BaselineRequest& request) {
+     std::istringstream stream{text};
+     std::string line;
+     if (!std::getline(stream, line)) {
+         return false;
+     }
+     std::istringstream requestLine{line};
+     requestLine >> request.method >> request.target >> request.version;
+     request.headers.clear();
+     while (std::getline(stream, line) && line != "\r") {
+         std::size_t colon { line.find(':') };
+         if (colon == std::string::npos) {
+             return false;
+         }
+         std::string value { line.substr(colon + 1) };
+         value.erase(0, value.find_first_not_of(' '));
+         value.erase(value.find_last_not_of("\r ") + 1);
+         request.headers[line.substr(0, colon)] = value;
+     }
+     auto length = static_cast<std::size_t>(std::stoul(request.headers["Content-Length"]));
+     request.body.assign(text, static_cast<std::size_t>(stream.tellg()), length);
+     return true;
+ }
+
+ void MeasureParsing() {
+     constexpr int kIterations {1000000};
+     std::size_t checksum {};
+
+     auto begin = Clock::now();
+     HttpRequest request {};
+     for (int i{}; i < kIterations; ++i) {
+         std::size_t consumed {};
+         HttpRequestParser::Parse(kRequest, request, consumed);
+         checksum += consumed + request.body.size();
+     }
+     double parser { std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / kIterations };
+
+     begin = Clock::now();
+     BaselineRequest baseline {};
+     for (int i{}; i < kIterations; ++i) {
+         ParseBaseline(kRequest, baseline);
+         checksum += baseline.body.size();
+     }
+     double copying { std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / kIterations };
+
+     std::printf("Parsing a %zu-byte move request (checksum %zu)\n", kRequest.size(), checksum);
+     std::printf("%28s %12.1f ns\n", "HttpRequestParser", parser);
+     std::printf("%28s %12.1f ns\n\n", "copying baseline", copying);
+ }
+
+ void MeasureServer(int connections, int depth, std::chrono::milliseconds duration) {
+     GameSessionFactory factory;
+     HttpGameApi api{factory, GameMode::ConsoleSinglePlayer};
+     int counter {};
+     factory.RegisterGame<GameMode::ConsoleSinglePlayer>([&api, &counter]() {
+         return HttpGameApi::MakeSinglePlayerGame(api.PendingSession(), [&counter]() { return counter++; });
+     });
+     HttpServer server{[&api](const HttpRequest& request, std::string& body) { return api.Handle(request, body); }};
+     std::thread thread{[&server]() { server.Run(); }};
+
+     HttpLoadOptions options {};
+     options.port = server.Port();
+     options.connections = connections;
+     options.pipelineDepth = depth;
+     options.duration = duration;
+     HttpLoadReport report {};
+     try {
+         report = HttpLoadGenerator{options}.Run();
+     } catch (const std::exception& e) {
+         std::printf("%12d %10d   failed: %s\n", connections, depth, e.what());
+     }
+     server.Stop();
+     thread.join();
+
+     HttpServerStats stats { server.Stats() };
+     std::printf("%12d %10d %14.0f %14.1f %16.3f %10llu\n", connections, depth, report.RequestsPerSecond(),
+                 report.meanBatchMicros, static_cast<double>(stats.sendCalls) / static_cast<double>(stats.requests),
+                 static_cast<unsigned long long>(report.failures));
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     double seconds { argc > 1 ? std::atof(argv[1]) : 2.0 };
+     auto duration = std::chrono::milliseconds{static_cast<long long>(seconds * 1000)};
+
+     MeasureParsing();
+
+     std::printf("HttpServer + HttpLoadGenerator, %.1f s per row, %u hardware threads\n", seconds,
+                 std::thread::hardware_concurrency());
+     std::printf("%12s %10s %14s %14s %16s %10s\n", "connections", "pipeline", "requests/s", "us/batch",
+                 "sends/request", "failures");
+     for (int connections : {1, 16, 64}) {
+         for (int depth : {1, 16}) {
+             MeasureServer(connections, depth, duration);
+         }
+     }
+     return 0;
+ }
+ 
\ No newline at end of file
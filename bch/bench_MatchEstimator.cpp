@@ -0,0 +1,75 @@
+/**
+ * @file bench_MatchEstimator.cpp
+ * @brief Throughput, stopping cost and variance reduction of MatchEstimator.
+ *
+ * ## Benchmark Strategy
+ * Throughput: one wave of a fixed number of 21-round matches (minMatches
+ * equal to maxMatches) on 1, 2, 4, ... threads, in matches per second.
+ *
+ * Stopping: win probability estimates for several target half-widths,
+ * reporting the matches and looks the sequential rule used against the
+ * fixed worst-case sample, z^2 / (4 w^2) at p = 1/2, that a single
+ * up-front run would need for the same width.
+ *
+ * Variance reduction: strategy comparisons against one opponent with and
+ * without common random numbers; the matches each needed for the same
+ * half-width are the saving.
+ *
+ * Usage: bench_MatchEstimator [max threads]
+ */
+
+ #include <algorithm>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <thread>
+ #include "MatchEstimator.hpp"
+
+ int main(int argc, char* argv[])
+ {
+     unsigned maxThreads { argc > 1 ? static_cast<unsigned>(std::atoi(argv[1]))
+                                    : std::max(1u, std::thread::hardware_concurrency()) };
+
+     std::printf("Throughput, random vs copycat, 21 rounds\n");
+     for (unsigned threads { 1 }; threads <= maxThreads; threads *= 2) {
+         MatchEstimatorOptions options {};
+         options.minMatches = 400'000;
+         options.maxMatches = options.minMatches;
+         options.threads = threads;
+         WinEstimate estimate { MatchEstimator{options}.EstimateWin("random", "copycat") };
+         std::printf("%3u threads %12.0f matches/s\n", threads, static_cast<double>(estimate.matches) / estimate.seconds);
+     }
+
+     std::printf("\nSequential stopping, 95%% confidence, 21 rounds\n");
+     std::printf("%-22s %8s %10s %10s %6s %8s\n", "pairing", "width", "P(win)", "matches", "looks", "fixed n");
+     const char* pairings[][2] { {"random", "random"}, {"ucb1", "copycat"}, {"counter", "cycle"} };
+     for (const auto& pairing : pairings) {
+         for (double width : {0.01, 0.005, 0.0025}) {
+             MatchEstimatorOptions options {};
+             options.halfWidth = width;
+             WinEstimate estimate { MatchEstimator{options}.EstimateWin(pairing[0], pairing[1]) };
+             double z { MatchEstimator::CriticalValue(0.05) };
+             std::printf("%-9s vs %-9s %8.4f %10.4f %10llu %6d %8.0f\n", pairing[0], pairing[1], width,
+                         estimate.winProbability, static_cast<unsigned long long>(estimate.matches),
+                         estimate.looks, z * z / (4.0 * width * width));
+         }
+     }
+
+     std::printf("\nComparisons, half-width 0.005\n");
+     std::printf("%-30s %-12s %10s %10s %10s %8s\n", "first / second vs opponent", "pairing", "difference",
+                 "matches", "reduction", "seconds");
+     const char* comparisons[][3] { {"ucb1", "thompson", "copycat"}, {"exp3", "random", "counter"},
+                                    {"random", "cycle", "random"} };
+     for (const auto& comparison : comparisons) {
+         for (bool common : {true, false}) {
+             MatchEstimatorOptions options {};
+             options.halfWidth = 0.005;
+             options.commonRandomNumbers = common;
+             WinDifference result { MatchEstimator{options}.CompareWin(comparison[0], comparison[1], comparison[2]) };
+             std::printf("%-8s / %-8s vs %-8s %-12s %10.4f %10llu %10.2f %8.2f\n", comparison[0], comparison[1],
+                         comparison[2], common ? "common" : "independent", result.difference,
+                         static_cast<unsigned long long>(result.matches), result.varianceReduction, result.seconds);
+         }
+     }
+     return 0;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,127 @@
+/**
+ * @file bench_MatchRules.cpp
+ * @brief Rounds saved by the match-termination rules, and their cost per round.
+ *
+ * ## Benchmark Strategy
+ * Whole SinglePlayerRpsGame matches are played from a QueuedMoveMessenger
+ * against a computer that always picks Rock, so the user's scripted move
+ * sets each round's outcome. Two workloads draw outcomes independently per
+ * round: an even match (win, draw and loss equally likely, which is what
+ * any user gets against a uniformly random computer) and a mismatch where
+ * the user wins half of the rounds and loses a quarter. For each round
+ * limit, the same outcome streams are played with every MatchTermination
+ * and the mean number of rounds played is compared with the limit.
+ *
+ * Play() time per round played, with fixed rounds against each rule on a
+ * match that never ends early, shows what evaluating the rule costs.
+ *
+ * Usage: bench_MatchRules [rounds per cell]
+ */
+
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <memory>
+ #include <vector>
+ #include "ComputerPlayer.hpp"
+ #include "MatchRules.hpp"
+ #include "QueuedMoveMessenger.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "UserPlayer.hpp"
+
+ namespace {
+
+ using Clock = std::chrono::steady_clock;
+
+ struct Workload {
+     const char* name;
+
+     /**
+      * Percent of rounds the user wins and draws; the rest are lost.
+      */
+     int winPercent;
+     int drawPercent;
+ };
+
+ /**
+  * Plays one match against Rock and returns the rounds played.
+  */
+ int PlayMatch(const std::vector<int>& moves, int rounds, MatchRules rules) {
+     auto messenger = std::make_unique<QueuedMoveMessenger>();
+     for (int i{}; i < rounds; ++i) {
+         messenger->PushMove(moves[static_cast<std::size_t>(i)]);
+     }
+     SinglePlayerRpsGame game{std::make_shared<UserPlayer>("ann"), std::make_shared<ComputerPlayer>("bot"),
+                              std::move(messenger), rounds, []() { return 0; }, rules};
+     game.Play();
+     return game.RoundsPlayed();
+ }
+
+ /**
+  * Fills `moves` with a user move per round: Paper wins, Rock draws, Scissors loses.
+  */
+ void DrawMoves(std::vector<int>& moves, const Workload& workload, std::uint64_t& state) {
+     for (auto& move : moves) {
+         state = state * 6364136223846793005ull + 1442695040888963407ull;
+         int roll { static_cast<int>((state >> 33) % 100) };
+         move = roll < workload.winPercent ? 2 : roll < workload.winPercent + workload.drawPercent ? 1 : 3;
+     }
+ }
+
+ double NanosPerRound(int rounds, MatchRules rules) {
+     std::vector<int> moves(static_cast<std::size_t>(rounds));
+     std::uint64_t state {3};
+     DrawMoves(moves, Workload{"", 34, 33}, state);
+     auto begin = Clock::now();
+     int played { PlayMatch(moves, rounds, rules) };
+     double nanos { std::chrono::duration<double, std::nano>(Clock::now() - begin).count() };
+     return nanos / static_cast<double>(played);
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     long budget { argc > 1 ? std::atol(argv[1]) : 2'000'000L };
+
+     const Workload workloads[] { {"even", 34, 33}, {"mismatch", 50, 25} };
+     const int limits[] { 3, 7, 21, 101, 1001 };
+     const struct { const char* name; MatchTermination termination; } policies[] {
+         {"best-of", MatchTermination::BestOf},
+         {"first-to", MatchTermination::FirstTo},
+         {"win-by-two", MatchTermination::WinByTwo},
+     };
+
+     std::printf("%-9s %6s %7s | %-10s %11s %8s\n", "workload", "limit", "matches", "rule", "mean rounds", "saved");
+     for (const auto& workload : workloads) {
+         for (int limit : limits) {
+             long matches { budget / limit };
+             for (const auto& policy : policies) {
+                 MatchRules rules {policy.termination, limit / 2 + 1};
+                 std::vector<int> moves(static_cast<std::size_t>(limit));
+                 std::uint64_t state {17};
+                 long played {};
+                 for (long m{}; m < matches; ++m) {
+                     DrawMoves(moves, workload, state);
+                     played += PlayMatch(moves, limit, rules);
+                 }
+                 double mean { static_cast<double>(played) / static_cast<double>(matches) };
+                 std::printf("%-9s %6d %7ld | %-10s %11.1f %7.1f%%\n", workload.name, limit, matches,
+                             policy.name, mean, 100.0 * (1.0 - mean / limit));
+             }
+         }
+     }
+
+     // The targets are out of reach; best-of can only end in the last few rounds.
+     int rounds { static_cast<int>(budget) };
+     std::printf("\nSinglePlayerRpsGame::Play, %d rounds without an early end\n", rounds);
+     std::printf("%-12s %8.1f ns per round\n", "fixed", NanosPerRound(rounds, MatchRules{}));
+     std::printf("%-12s %8.1f ns per round\n", "best-of",
+                 NanosPerRound(rounds, MatchRules{MatchTermination::BestOf, 0}));
+     std::printf("%-12s %8.1f ns per round\n", "first-to",
+                 NanosPerRound(rounds, MatchRules{MatchTermination::FirstTo, rounds + 1}));
+     std::printf("%-12s %8.1f ns per round\n", "win-by-two",
+                 NanosPerRound(rounds, MatchRules{MatchTermination::WinByTwo, rounds + 1}));
+     return 0;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,180 @@
+/**
+ * @file bench_Matchmaker.cpp
+ * @brief Matching throughput of Matchmaker under concurrent submissions.
+ *
+ * ## Benchmark Strategy
+ * Submitter threads push match requests with ratings spread around 1500
+ * while one matcher thread runs pairing passes back to back, creating a
+ * small session through GameSessionFactory for every pair. Throughput is
+ * matched requests per second of wall-clock time, measured from the first
+ * submission until every request is paired.
+ *
+ * The queue itself is then compared with a mutex-guarded deque carrying
+ * the same traffic (N producers, one consumer).
+ *
+ * Usage: bench_Matchmaker [requests] [maxSubmitters]
+ */
+
+ #include <algorithm>
+ #include <atomic>
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <deque>
+ #include <mutex>
+ #include <thread>
+ #include <vector>
+ #include "Matchmaker.hpp"
+
+ namespace {
+
+ using Clock = std::chrono::steady_clock;
+
+ double SecondsSince(Clock::time_point begin) {
+     return std::chrono::duration<double>(Clock::now() - begin).count();
+ }
+
+ class NullSession : public IGameSession {
+ public:
+     explicit NullSession(const MatchedPair& pair) : m_pair{pair} {}
+     void Play() override {}
+
+ private:
+     MatchedPair m_pair {};
+ };
+
+ /**
+  * @brief Sum of four uniform draws: a cheap bell curve around 1500.
+  */
+ int Rating(std::uint64_t& state) {
+     int sum {};
+     for (int i{}; i < 4; ++i) {
+         state = state * 6364136223846793005ull + 1442695040888963407ull;
+         sum += static_cast<int>((state >> 33) % 600);
+     }
+     return 300 + sum;
+ }
+
+ void MeasureMatching(long requests, int submitters) {
+     GameSessionFactory factory;
+     Matchmaker matchmaker{factory, GameMode::ConsoleSinglePlayer};
+     factory.RegisterGame<GameMode::ConsoleSinglePlayer>([&matchmaker]() {
+         return std::make_unique<NullSession>(matchmaker.CurrentPair());
+     });
+
+     long perSubmitter { requests / submitters };
+     long total { perSubmitter * submitters };
+     std::atomic<long> submitted {0};
+     long paired {};
+     long passes {};
+     std::uint64_t longestWait {};
+     auto sink = [&](const MatchedPair& pair, std::unique_ptr<IGameSession> session) {
+         paired += 2;
+         longestWait = std::max(longestWait, pair.waitedNanos);
+         session.reset();
+     };
+
+     auto begin = Clock::now();
+     std::vector<std::thread> threads;
+     for (int s{}; s < submitters; ++s) {
+         threads.emplace_back([&, s]() {
+             std::uint64_t state { 1234u + static_cast<std::uint64_t>(s) };
+             for (long i{}; i < perSubmitter; ++i) {
+                 MatchRequest request { static_cast<std::uint32_t>(s * perSubmitter + i), Rating(state) };
+                 while (!matchmaker.Submit(request)) {
+                     std::this_thread::yield();
+                 }
+             }
+             submitted.fetch_add(perSubmitter);
+         });
+     }
+     // Stop once every request has been drained into a pass. At most one
+     // player per band is then left over, waiting for its band to widen.
+     while (submitted.load() < total || static_cast<long>(matchmaker.Waiting()) + paired < total) {
+         matchmaker.RunPass(sink);
+         ++passes;
+     }
+     double seconds { SecondsSince(begin) };
+     for (auto& thread : threads) {
+         thread.join();
+     }
+
+     std::printf("%12d %14.0f %10ld %10zu %14.2f\n", submitters, static_cast<double>(paired) / seconds,
+                 passes, matchmaker.Waiting(), static_cast<double>(longestWait) / 1e6);
+ }
+
+ template <typename Push, typename Pop>
+ double MeasureQueue(long values, int producers, Push push, Pop pop) {
+     long perProducer { values / producers };
+     auto begin = Clock::now();
+     std::vector<std::thread> threads;
+     for (int p{}; p < producers; ++p) {
+         threads.emplace_back([&]() {
+             for (long i{}; i < perProducer; ++i) {
+                 while (!push(i)) {
+                     std::this_thread::yield();
+                 }
+             }
+         });
+     }
+     long received {};
+     long value {};
+     while (received < perProducer * producers) {
+         if (pop(value)) {
+             ++received;
+         } else {
+             std::this_thread::yield();
+         }
+     }
+     for (auto& thread : threads) {
+         thread.join();
+     }
+     return static_cast<double>(received) / SecondsSince(begin);
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     long requests { argc > 1 ? std::atol(argv[1]) : 2'000'000L };
+     int maxSubmitters { argc > 2 ? std::atoi(argv[2]) : 4 };
+
+     std::printf("Matchmaker: %ld requests, default bands (40 x 100 rating)\n", requests);
+     std::printf("%12s %14s %10s %10s %14s\n", "submitters", "matched/s", "passes", "left", "max wait ms");
+     for (int submitters {1}; submitters <= maxSubmitters; submitters *= 2) {
+         MeasureMatching(requests, submitters);
+     }
+
+     std::printf("\nBand queue alone, values/s with one consumer\n");
+     std::printf("%12s %14s %14s\n", "producers", "MpmcQueue", "mutex+deque");
+     for (int producers {1}; producers <= maxSubmitters; producers *= 2) {
+         MpmcQueue<long> queue{4096};
+         double lockFree { MeasureQueue(requests, producers,
+             [&](long v) { return queue.TryPush(v); },
+             [&](long& v) { return queue.TryPop(v); }) };
+
+         std::mutex mutex;
+         std::deque<long> deque;
+         double locked { MeasureQueue(requests, producers,
+             [&](long v) {
+                 std::lock_guard<std::mutex> lock{mutex};
+                 if (deque.size() >= 4096) {
+                     return false;
+                 }
+                 deque.push_back(v);
+                 return true;
+             },
+             [&](long& v) {
+                 std::lock_guard<std::mutex> lock{mutex};
+                 if (deque.empty()) {
+                     return false;
+                 }
+                 v = deque.front();
+                 deque.pop_front();
+                 return true;
+             }) };
+         std::printf("%12d %14.0f %14.0f\n", producers, lockFree, locked);
+     }
+     return 0;
+ }
+ 
\ No newline at end of file
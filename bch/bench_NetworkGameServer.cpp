@@ -0,0 +1,161 @@
+/**
+ * @file bench_NetworkGameServer.cpp
+ * @brief Server CPU per million rounds on the epoll and io_uring backends.
+ *
+ * ## Benchmark Strategy
+ * A NetworkGameServer hosts S sessions over Unix socket pairs and plays
+ * one million rounds in total. Clients say they depend on history, so the
+ * server asks for one move per exchange: every round costs a Request and a
+ * Moves frame, which is the regime where per-move system calls dominate.
+ * All clients run on one thread that multiplexes their sockets with epoll,
+ * so the client side is identical for both backends.
+ *
+ * The figure of merit is the CPU time (user plus system) of the server
+ * thread, from getrusage(RUSAGE_THREAD), scaled to one million rounds; the
+ * table also shows wall time and system calls per round. Where io_uring is
+ * unavailable its rows are skipped with the reason.
+ *
+ * Usage: bench_NetworkGameServer [totalRounds] [maxSessions]
+ */
+
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <sys/epoll.h>
+ #include <sys/resource.h>
+ #include <sys/socket.h>
+ #include <system_error>
+ #include <thread>
+ #include <unistd.h>
+ #include <vector>
+ #include "BotProtocol.hpp"
+ #include "NetworkBackendFactory.hpp"
+ #include "NetworkGameServer.hpp"
+
+ namespace {
+
+ double ThreadCpuSeconds() {
+     rusage usage {};
+     ::getrusage(RUSAGE_THREAD, &usage);
+     return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+            static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+ }
+
+ /**
+  * @brief Answers every Request on every client socket until each gets Bye.
+  */
+ void RunClients(const std::vector<int>& fds) {
+     int epollFd { ::epoll_create1(0) };
+     std::vector<std::vector<std::uint8_t>> inboxes(fds.size());
+     std::uint8_t frame[BotProtocol::kMaxFrameSize];
+     for (std::size_t i{}; i < fds.size(); ++i) {
+         (void)::write(fds[i], frame, BotProtocol::EncodeHello(0, frame));
+         epoll_event event {};
+         event.events = EPOLLIN;
+         event.data.u64 = i;
+         ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fds[i], &event);
+     }
+
+     std::size_t remaining { fds.size() };
+     std::uint8_t moves[BotProtocol::kMaxBatch] {};
+     std::uint8_t buffer[4096];
+     epoll_event events[256];
+     std::uint64_t nextMove {};
+     while (remaining > 0) {
+         int ready { ::epoll_wait(epollFd, events, 256, 5000) };
+         if (ready <= 0) {
+             std::fprintf(stderr, "clients stalled\n");
+             break;
+         }
+         for (int e{}; e < ready; ++e) {
+             std::size_t i { events[e].data.u64 };
+             ssize_t got { ::read(fds[i], buffer, sizeof(buffer)) };
+             if (got <= 0) {
+                 ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fds[i], nullptr);
+                 --remaining;
+                 continue;
+             }
+             auto& inbox = inboxes[i];
+             inbox.insert(inbox.end(), buffer, buffer + got);
+             std::size_t offset {};
+             BotProtocol::FrameHeader header {};
+             while (std::size_t size = BotProtocol::PeekFrame(inbox.data() + offset, inbox.size() - offset, header)) {
+                 offset += size;
+                 if (header.type == BotProtocol::FrameType::Bye) {
+                     ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fds[i], nullptr);
+                     --remaining;
+                     break;
+                 }
+                 if (header.type == BotProtocol::FrameType::Request && header.count > 0) {
+                     for (std::size_t m{}; m < header.count; ++m) {
+                         moves[m] = static_cast<std::uint8_t>(1 + nextMove++ % 3);
+                     }
+                     (void)::write(fds[i], frame, BotProtocol::EncodeMoves(moves, header.count, frame));
+                 }
+             }
+             inbox.erase(inbox.begin(), inbox.begin() + static_cast<long>(offset));
+         }
+     }
+     ::close(epollFd);
+ }
+
+ void Measure(NetworkBackendKind kind, int totalRounds, int sessions) {
+     std::unique_ptr<INetworkBackend> backend;
+     try {
+         backend = NetworkBackendFactory::Create(kind);
+     } catch (const std::system_error& error) {
+         std::printf("%10s %10d   unavailable: %s\n", "io_uring", sessions, error.what());
+         return;
+     }
+     const char* name { backend->Name() };
+     NetworkGameServer server{std::move(backend)};
+
+     int rounds { totalRounds / sessions };
+     std::vector<int> clientFds;
+     for (int s{}; s < sessions; ++s) {
+         int fds[2] {};
+         if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+             std::perror("socketpair");
+             std::exit(1);
+         }
+         int counter {s};
+         server.AddSession(fds[0], "User", "Bot", rounds, [counter]() mutable { return counter++; });
+         clientFds.push_back(fds[1]);
+     }
+
+     std::thread clients{[&clientFds]() { RunClients(clientFds); }};
+     auto begin = std::chrono::steady_clock::now();
+     double cpuBegin { ThreadCpuSeconds() };
+     auto results = server.Run();
+     double cpu { ThreadCpuSeconds() - cpuBegin };
+     double wall { std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() };
+     clients.join();
+     for (int fd : clientFds) {
+         ::close(fd);
+     }
+
+     double played {};
+     for (const auto& result : results) {
+         played += result.roundsPlayed;
+     }
+     double perMillion { 1e6 / played };
+     std::printf("%10s %10d %16.3f %14.3f %16.2f\n", name, sessions, cpu * perMillion, wall * perMillion,
+                 static_cast<double>(server.Backend().SyscallCount()) / played);
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     int totalRounds { argc > 1 ? std::atoi(argv[1]) : 1000000 };
+     int maxSessions { argc > 2 ? std::atoi(argv[2]) : 1000 };
+
+     std::printf("NetworkGameServer: %d rounds in total, one move per exchange\n", totalRounds);
+     std::printf("%10s %10s %16s %14s %16s\n", "backend", "sessions", "server CPU s/1M", "wall s/1M", "syscalls/round");
+     for (int sessions {10}; sessions <= maxSessions; sessions *= 10) {
+         Measure(NetworkBackendKind::Epoll, totalRounds, sessions);
+         Measure(NetworkBackendKind::IoUring, totalRounds, sessions);
+     }
+     return 0;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,103 @@
+/**
+ * @file bench_PlayerRegistry.cpp
+ * @brief Bulk-operation benchmark for PlayerRegistry versus per-object players.
+ *
+ * ## Benchmark Strategy
+ * The same population is stored twice: as a PlayerRegistry (score column)
+ * and as a vector of shared_ptr<IPlayer> to heap-allocated UserPlayer
+ * objects. For each layout we time a top-K leaderboard and a full score
+ * reset, and report the effective score bandwidth in GB/s.
+ *
+ * Usage: bench_PlayerRegistry [players] [k]
+ */
+
+ #include <algorithm>
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <memory>
+ #include <random>
+ #include <string>
+ #include <utility>
+ #include <vector>
+ #include "PlayerRegistry.hpp"
+ #include "UserPlayer.hpp"
+
+ namespace {
+
+ template <typename Func>
+ double MeasureSeconds(Func func)
+ {
+     auto begin = std::chrono::steady_clock::now();
+     func();
+     auto end = std::chrono::steady_clock::now();
+     return std::chrono::duration<double>(end - begin).count();
+ }
+
+ void Report(const char* label, double seconds, std::size_t players)
+ {
+     double gigabytes { static_cast<double>(players * sizeof(int)) / 1e9 };
+     std::printf("%-36s %10.3f ms %10.2f GB/s\n", label, seconds * 1e3, gigabytes / seconds);
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     std::size_t players { argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 2'000'000u };
+     std::size_t k { argc > 2 ? static_cast<std::size_t>(std::atol(argv[2])) : 100u };
+
+     std::mt19937 rng{12345};
+     std::uniform_int_distribution<int> winsDistribution{0, 50};
+
+     PlayerRegistry registry;
+     registry.Reserve(players);
+     std::vector<std::shared_ptr<IPlayer>> objects;
+     objects.reserve(players);
+
+     for (std::size_t i{}; i < players; ++i) {
+         std::string name { "player" + std::to_string(i) };
+         auto id = registry.Add(name);
+         auto object = std::make_shared<UserPlayer>(name);
+         int wins { winsDistribution(rng) };
+         for (int w{}; w < wins; ++w) {
+             registry.AddWin(id);
+             object->AddWin();
+         }
+         objects.push_back(std::move(object));
+     }
+     // Shuffle the object order so it resembles a long-lived, fragmented heap.
+     std::shuffle(objects.begin(), objects.end(), rng);
+
+     std::printf("%zu players, top-%zu\n", players, k);
+
+     std::vector<PlayerRegistry::PlayerId> top;
+     Report("registry TopKByScore", MeasureSeconds([&]() { top = registry.TopKByScore(k); }), players);
+
+     std::vector<std::pair<int, std::size_t>> objectTop;
+     Report("objects partial_sort by GetScore()", MeasureSeconds([&]() {
+         std::vector<std::pair<int, std::size_t>> all;
+         all.reserve(objects.size());
+         for (std::size_t i{}; i < objects.size(); ++i) {
+             all.emplace_back(objects[i]->GetScore(), i);
+         }
+         std::partial_sort(all.begin(), all.begin() + static_cast<long>(std::min(k, all.size())), all.end(),
+                           [](const auto& a, const auto& b) { return a.first > b.first; });
+         all.resize(std::min(k, all.size()));
+         objectTop = std::move(all);
+     }), players);
+
+     if (!top.empty() && !objectTop.empty() && registry.GetScore(top.front()) != objectTop.front().first) {
+         std::printf("leaderboards disagree!\n");
+         return 1;
+     }
+
+     Report("registry ResetAllScores", MeasureSeconds([&]() { registry.ResetAllScores(); }), players);
+     Report("objects recreate to reset", MeasureSeconds([&]() {
+         for (auto& object : objects) {
+             object = std::make_shared<UserPlayer>("reset");
+         }
+     }), players);
+     return 0;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,125 @@
+/**
+ * @file bench_RoundColumns.cpp
+ * @brief Write and scan benchmark for the columnar round export.
+ *
+ * ## Benchmark Strategy
+ * A headless simulation (random vs counter) streams its rounds into a
+ * RoundColumnWriter. The file size is compared with the same rounds as
+ * CSV text. The reader then scans one column (outcome), two columns
+ * (session id and outcome) and all columns; throughput is reported as
+ * rows per second and as decoded bytes per second (8 bytes per value),
+ * with the file already in the page cache.
+ *
+ * Usage: bench_RoundColumns [matches] [rounds] [path]
+ */
+
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <string>
+ #include <vector>
+ #include "RoundColumnReader.hpp"
+ #include "RoundColumnWriter.hpp"
+ #include "SimulationRunner.hpp"
+
+ namespace {
+
+ using Clock = std::chrono::steady_clock;
+
+ double Seconds(Clock::time_point begin, Clock::time_point end)
+ {
+     return std::chrono::duration<double>(end - begin).count();
+ }
+
+ /**
+  * @brief Counts the CSV bytes the rounds would take, without writing them.
+  */
+ class CsvSizer : public IRoundObserver {
+ public:
+     explicit CsvSizer(IRoundObserver& next) : m_next{next} {}
+
+     void OnRound(const RoundRecord& record) override {
+         m_bytes += std::to_string(record.sessionId).size() + std::to_string(record.round).size() +
+                    6 + record.userName.size() + record.computerName.size() +
+                    std::to_string(record.decisionNanos).size() + 8;
+         m_next.OnRound(record);
+     }
+
+     std::uint64_t Bytes() const { return m_bytes; }
+
+ private:
+     IRoundObserver& m_next;
+     std::uint64_t m_bytes {};
+ };
+
+ void Scan(RoundColumnReader& reader, const char* label, const std::vector<RoundColumn>& columns)
+ {
+     std::vector<std::uint64_t> values;
+     std::uint64_t checksum {};
+     std::uint64_t decoded {};
+     auto begin = Clock::now();
+     for (std::size_t block{}; block < reader.BlockCount(); ++block) {
+         for (RoundColumn column : columns) {
+             reader.ReadColumn(block, column, values);
+             for (std::uint64_t value : values) {
+                 checksum += value;
+             }
+             decoded += values.size();
+         }
+     }
+     double seconds { Seconds(begin, Clock::now()) };
+     std::printf("%-28s %10.1f Mrows/s %8.2f GB/s decoded  (checksum %llu)\n", label,
+                 static_cast<double>(reader.Rows()) / seconds / 1e6,
+                 static_cast<double>(decoded * 8) / seconds / 1e9,
+                 static_cast<unsigned long long>(checksum));
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     std::uint64_t matches { argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000 };
+     std::uint32_t rounds { static_cast<std::uint32_t>(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 500) };
+     std::string path { argc > 3 ? argv[3] : "/tmp/bench_rounds.rcol" };
+
+     SimulationConfig config {};
+     config.masterSeed = 1;
+     config.totalMatches = matches;
+     config.roundsPerMatch = rounds;
+     config.userStrategy = "random";
+     config.computerStrategy = "counter";
+
+     std::uint64_t fileBytes {};
+     std::uint64_t csvBytes {};
+     {
+         RoundColumnWriter writer{path};
+         CsvSizer sizer{writer};
+         auto begin = Clock::now();
+         SimulationRunner{config}.RunShard(0, 1, &sizer);
+         writer.Close();
+         double seconds { Seconds(begin, Clock::now()) };
+         csvBytes = sizer.Bytes();
+         std::printf("wrote %llu rounds in %.2f s (%.1f Mrows/s, simulation included)\n",
+                     static_cast<unsigned long long>(writer.Rows()), seconds,
+                     static_cast<double>(writer.Rows()) / seconds / 1e6);
+     }
+
+     RoundColumnReader reader{path};
+     for (std::size_t block{}; block < reader.BlockCount(); ++block) {
+         for (std::size_t column{}; column < kRoundColumnCount; ++column) {
+             fileBytes += reader.ChunkSize(block, static_cast<RoundColumn>(column));
+         }
+     }
+     std::printf("columnar %.2f bytes/row, CSV %.2f bytes/row\n\n",
+                 static_cast<double>(fileBytes) / static_cast<double>(reader.Rows()),
+                 static_cast<double>(csvBytes) / static_cast<double>(reader.Rows()));
+
+     Scan(reader, "outcome", {RoundColumn::Outcome});
+     Scan(reader, "session id + outcome", {RoundColumn::SessionId, RoundColumn::Outcome});
+     Scan(reader, "all columns", {RoundColumn::SessionId, RoundColumn::Round, RoundColumn::UserMove,
+                                  RoundColumn::ComputerMove, RoundColumn::Outcome, RoundColumn::UserName,
+                                  RoundColumn::ComputerName, RoundColumn::DecisionNanos});
+     std::remove(path.c_str());
+     return 0;
+ }
+ 
\ No newline at end of file
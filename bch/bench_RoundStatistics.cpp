@@ -0,0 +1,140 @@
+/**
+ * @file bench_RoundStatistics.cpp
+ * @brief Update and snapshot cost of RoundStatistics.
+ *
+ * ## Benchmark Strategy
+ * Writer threads report rounds between players drawn from a fixed
+ * population, once alone and once while a reader thread snapshots random
+ * players in a loop, as a dashboard would. The per-round cost should stay
+ * flat as rounds accumulate, since every aggregator is O(1) per update.
+ *
+ * A second pass compares a p99 latency query from QuantileSketch with
+ * sorting the raw samples.
+ *
+ * Usage: bench_RoundStatistics [rounds] [players] [maxThreads]
+ */
+
+ #include <algorithm>
+ #include <atomic>
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <string>
+ #include <thread>
+ #include <vector>
+ #include "RoundStatistics.hpp"
+
+ namespace {
+
+ using Clock = std::chrono::steady_clock;
+
+ double NanosSince(Clock::time_point begin) {
+     return std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+ }
+
+ /**
+  * @brief Returns ns per reported round, and the reader's snapshot count.
+  */
+ std::pair<double, long> MeasureUpdates(const std::vector<std::string>& names, long rounds, int threads, bool withReader) {
+     RoundStatistics statistics;
+     std::atomic<bool> done {false};
+     long snapshots {};
+     std::thread reader;
+     if (withReader) {
+         reader = std::thread([&]() {
+             std::size_t next {};
+             while (!done.load(std::memory_order_relaxed)) {
+                 snapshots += statistics.Snapshot(names[next]).has_value();
+                 next = (next + 7) % names.size();
+             }
+         });
+     }
+
+     long perThread { rounds / threads };
+     auto begin = Clock::now();
+     std::vector<std::thread> writers;
+     for (int t{}; t < threads; ++t) {
+         writers.emplace_back([&, t]() {
+             RoundRecord record {};
+             for (long i{}; i < perThread; ++i) {
+                 auto index = static_cast<std::size_t>(i * 31 + t);
+                 record.userName = names[index % names.size()];
+                 record.computerName = names[(index * 17 + 1) % names.size()];
+                 record.userMove = static_cast<std::uint8_t>(1 + i % 3);
+                 record.computerMove = static_cast<std::uint8_t>(1 + (i / 3) % 3);
+                 record.outcome = static_cast<RoundOutcome>(i % 3);
+                 record.decisionNanos = 500 + static_cast<std::uint64_t>(i % 10000);
+                 statistics.OnRound(record);
+             }
+         });
+     }
+     for (auto& writer : writers) {
+         writer.join();
+     }
+     double nanos { NanosSince(begin) };
+     done = true;
+     if (reader.joinable()) {
+         reader.join();
+     }
+     return {nanos / static_cast<double>(perThread * threads), snapshots};
+ }
+
+ void CompareQuantiles(long samples) {
+     std::vector<std::uint64_t> values;
+     values.reserve(static_cast<std::size_t>(samples));
+     std::uint64_t state {42};
+     for (long i{}; i < samples; ++i) {
+         state = state * 6364136223846793005ull + 1442695040888963407ull;
+         values.push_back(1000 + ((state >> 33) >> ((state >> 5) % 20)));
+     }
+
+     QuantileSketch sketch;
+     auto begin = Clock::now();
+     for (std::uint64_t value : values) {
+         sketch.Add(value);
+     }
+     double addNanos { NanosSince(begin) / static_cast<double>(samples) };
+
+     begin = Clock::now();
+     std::uint64_t estimate { sketch.Quantile(0.99) };
+     double sketchQueryNanos { NanosSince(begin) };
+
+     begin = Clock::now();
+     auto rank = static_cast<std::size_t>(0.99 * static_cast<double>(samples - 1) + 0.5);
+     std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), values.end());
+     std::uint64_t exact { values[rank] };
+     double exactQueryNanos { NanosSince(begin) };
+
+     std::printf("\nQuantileSketch over %ld samples\n", samples);
+     std::printf("%-28s %12.2f ns\n", "Add()", addNanos);
+     std::printf("%-28s %12.0f ns  (p99 %llu)\n", "Quantile(0.99)", sketchQueryNanos,
+                 static_cast<unsigned long long>(estimate));
+     std::printf("%-28s %12.0f ns  (p99 %llu)\n", "nth_element on raw samples", exactQueryNanos,
+                 static_cast<unsigned long long>(exact));
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     long rounds { argc > 1 ? std::atol(argv[1]) : 4'000'000L };
+     int players { argc > 2 ? std::atoi(argv[2]) : 1000 };
+     int maxThreads { argc > 3 ? std::atoi(argv[3]) : 4 };
+
+     std::vector<std::string> names;
+     for (int i{}; i < players; ++i) {
+         names.push_back("player-" + std::to_string(i));
+     }
+
+     std::printf("RoundStatistics::OnRound wall-clock ns per round (%d players)\n", players);
+     std::printf("%8s %14s %18s %14s\n", "threads", "alone", "with snapshots", "snapshots");
+     for (int threads {1}; threads <= maxThreads; threads *= 2) {
+         auto alone = MeasureUpdates(names, rounds, threads, false);
+         auto read = MeasureUpdates(names, rounds, threads, true);
+         std::printf("%8d %14.1f %18.1f %14ld\n", threads, alone.first, read.first, read.second);
+     }
+
+     CompareQuantiles(rounds);
+     return 0;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,257 @@
+/**
+ * @file bench_SharedMemoryMessenger.cpp
+ * @brief Round-latency benchmark: shared-memory transport versus Unix socket.
+ *
+ * ## Benchmark Strategy
+ * The same SinglePlayerRpsGame is played against a client in a forked
+ * process over two transports:
+ * - SharedMemoryMessenger / SharedMemoryClient (rings in shm_open memory,
+ *   futex wake-ups only when a side is asleep), which also streams every
+ *   announcement to the client;
+ * - a socketpair carrying the same records, one send() per announcement
+ *   as on the ring, with the client answering each move request in one
+ *   write.
+ * Each is measured with one move per exchange (pure round-trip latency)
+ * and with 64 moves per exchange. Reported: ns per round and game-side
+ * system calls per round: futex waits, wakes and yields on the rings,
+ * every send() and read() call on the socket.
+ *
+ * Usage: bench_SharedMemoryMessenger [rounds]
+ */
+
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <deque>
+ #include <fcntl.h>
+ #include <string>
+ #include <sys/socket.h>
+ #include <unistd.h>
+ #include "BotProcess.hpp"
+ #include "BotProtocol.hpp"
+ #include "ComputerPlayer.hpp"
+ #include "MoveStrategies.hpp"
+ #include "QueuedMoveMessenger.hpp"
+ #include "SharedMemoryClient.hpp"
+ #include "SharedMemoryMessenger.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "UserPlayer.hpp"
+
+ namespace {
+
+ /**
+  * @brief Writes all of `size` bytes, counting each send() call.
+  */
+ bool SendAll(int fd, const void* data, std::size_t size, std::size_t& syscalls)
+ {
+     const auto* bytes = static_cast<const std::uint8_t*>(data);
+     std::size_t done {};
+     while (done < size) {
+         ssize_t sent { ::send(fd, bytes + done, size - done, MSG_NOSIGNAL) };
+         ++syscalls;
+         if (sent <= 0) {
+             return false;
+         }
+         done += static_cast<std::size_t>(sent);
+     }
+     return true;
+ }
+
+ /**
+  * @brief Reads exactly `size` bytes, counting each read() call.
+  */
+ bool ReadExactly(int fd, void* data, std::size_t size, std::size_t& syscalls)
+ {
+     auto* bytes = static_cast<std::uint8_t*>(data);
+     std::size_t done {};
+     while (done < size) {
+         ssize_t got { ::read(fd, bytes + done, size - done) };
+         ++syscalls;
+         if (got <= 0) {
+             return false;
+         }
+         done += static_cast<std::size_t>(got);
+     }
+     return true;
+ }
+
+ /**
+  * @brief SharedMemoryMessenger's protocol over a blocking socket.
+  *
+  * Every announcement is one ShmRing::Record, sent as it happens just as
+  * SharedMemoryMessenger pushes it; the client answers a move request with
+  * all its Move records in one write. Only the transport differs.
+  */
+ class SocketMessenger : public QueuedMoveMessenger {
+ public:
+     SocketMessenger(int fd, std::size_t maxBatch) : m_fd{fd}, m_maxBatch{maxBatch} {}
+
+     void SetParticipants(std::shared_ptr<IPlayer> user, std::shared_ptr<IPlayer> computer) {
+         m_user = std::move(user);
+         m_computer = std::move(computer);
+     }
+
+     void ShowWelcomeScreen() override { Send(ShmMessageType::Welcome); }
+     void ShowSetupComplete() override { Send(ShmMessageType::SetupComplete); }
+
+     std::size_t RequestMoveChoices(int* moves, std::size_t maxCount) override {
+         std::size_t wanted { std::min(maxCount, m_maxBatch) };
+         if (wanted == 0 || !Send(ShmMessageType::MoveRequest, static_cast<std::int32_t>(wanted))) {
+             return 0;
+         }
+         ShmRing::Record replies[BotProtocol::kMaxBatch];
+         if (!ReadExactly(m_fd, replies, wanted * sizeof(ShmRing::Record), m_syscalls)) {
+             return 0;
+         }
+         for (std::size_t i{}; i < wanted; ++i) {
+             moves[i] = replies[i].a;
+         }
+         return wanted;
+     }
+
+     void DisplayChosenMove(const std::shared_ptr<IPlayer>& player, GameMove move) override {
+         Send(ShmMessageType::ChosenMove, SideOf(player), static_cast<std::int32_t>(move));
+     }
+
+     void AnnounceRoundWinner(const std::shared_ptr<IPlayer>& winner) override {
+         Send(ShmMessageType::RoundWinner, SideOf(winner));
+     }
+
+     void AnnounceDraw() override { Send(ShmMessageType::Draw); }
+
+     void ShowFinalScore(const std::shared_ptr<IPlayer>& user, const std::shared_ptr<IPlayer>& computer) override {
+         Send(ShmMessageType::FinalScore, user->GetScore(), computer->GetScore());
+     }
+
+     void ShowInvalidInputMessage() override { Send(ShmMessageType::InvalidInput); }
+
+     std::size_t SyscallCount() const { return m_syscalls; }
+
+ private:
+     bool Send(ShmMessageType type, std::int32_t a = 0, std::int32_t b = 0) {
+         ShmRing::Record record {static_cast<std::int32_t>(type), a, b, 0};
+         return SendAll(m_fd, &record, sizeof(record), m_syscalls);
+     }
+
+     std::int32_t SideOf(const std::shared_ptr<IPlayer>& player) const {
+         return player == m_user ? kSideUser : player == m_computer ? kSideComputer : kSideUnknown;
+     }
+
+     int m_fd {-1};
+     std::size_t m_maxBatch {1};
+     std::shared_ptr<IPlayer> m_user {};
+     std::shared_ptr<IPlayer> m_computer {};
+     std::size_t m_syscalls {};
+ };
+
+ /**
+  * @brief Client side of SocketMessenger; mirrors SharedMemoryClient::Serve().
+  */
+ int ServeSocket(int fd, IMoveStrategy& strategy)
+ {
+     std::size_t syscalls {};
+     std::deque<GameMove> unplayed;
+     ShmRing::Record record {};
+     while (ReadExactly(fd, &record, sizeof(record), syscalls)) {
+         switch (static_cast<ShmMessageType>(record.type)) {
+             case ShmMessageType::MoveRequest: {
+                 ShmRing::Record moves[BotProtocol::kMaxBatch];
+                 for (std::int32_t i{}; i < record.a; ++i) {
+                     GameMove move { strategy.NextMove() };
+                     unplayed.push_back(move);
+                     moves[i] = ShmRing::Record{static_cast<std::int32_t>(ShmMessageType::Move),
+                                                static_cast<std::int32_t>(move), 0, 0};
+                 }
+                 if (!SendAll(fd, moves, static_cast<std::size_t>(record.a) * sizeof(ShmRing::Record), syscalls)) {
+                     return 1;
+                 }
+                 break;
+             }
+             case ShmMessageType::ChosenMove:
+                 if (record.a == kSideComputer && !unplayed.empty()) {
+                     strategy.ObserveRound(unplayed.front(), static_cast<GameMove>(record.b));
+                     unplayed.pop_front();
+                 }
+                 break;
+             case ShmMessageType::InvalidInput:
+                 if (!unplayed.empty()) {
+                     unplayed.pop_front();
+                 }
+                 break;
+             case ShmMessageType::FinalScore:
+                 return 0;
+             default:
+                 break;
+         }
+     }
+     return 1;
+ }
+
+ void Report(const char* label, std::chrono::steady_clock::duration elapsed, int rounds, std::size_t syscalls)
+ {
+     double ns { std::chrono::duration<double, std::nano>(elapsed).count() };
+     std::printf("%-32s %14.0f %16.3f\n", label, ns / rounds, static_cast<double>(syscalls) / rounds);
+ }
+
+ void RunSharedMemory(const char* label, int rounds, std::size_t maxBatch)
+ {
+     const std::string name { "/rps-bench-" + std::to_string(::getpid()) };
+     auto segment = SharedMemorySegment::Create(name);
+     BotProcess child { BotProcess::Fork([&name](int) {
+         CycleStrategy strategy;
+         SharedMemoryClient client{SharedMemorySegment::Open(name)};
+         return client.Serve(strategy);
+     }) };
+
+     auto user = std::make_shared<UserPlayer>("shm");
+     auto computer = std::make_shared<ComputerPlayer>("host");
+     auto messenger = std::make_unique<SharedMemoryMessenger>(segment, "shm", "host", rounds, maxBatch);
+     messenger->SetParticipants(user, computer);
+
+     auto begin = std::chrono::steady_clock::now();
+     SinglePlayerRpsGame{user, computer, std::move(messenger), rounds, []() { return 0; }}.Play();
+     auto end = std::chrono::steady_clock::now();
+     child.Wait();
+
+     Report(label, end - begin, rounds, segment->ToClient().SyscallCount() + segment->ToServer().SyscallCount());
+ }
+
+ void RunSocket(const char* label, int rounds, std::size_t maxBatch)
+ {
+     BotProcess child { BotProcess::Fork([](int fd) {
+         CycleStrategy strategy;
+         return ServeSocket(fd, strategy);
+     }) };
+     ::fcntl(child.Fd(), F_SETFL, ::fcntl(child.Fd(), F_GETFL) & ~O_NONBLOCK);
+
+     auto user = std::make_shared<UserPlayer>("socket");
+     auto computer = std::make_shared<ComputerPlayer>("host");
+     auto messenger = std::make_unique<SocketMessenger>(child.Fd(), maxBatch);
+     messenger->SetParticipants(user, computer);
+     SocketMessenger* rawMessenger { messenger.get() };
+
+     auto begin = std::chrono::steady_clock::now();
+     SinglePlayerRpsGame game{user, computer, std::move(messenger), rounds, []() { return 0; }};
+     game.Play();
+     auto end = std::chrono::steady_clock::now();
+     std::size_t syscalls { rawMessenger->SyscallCount() };
+     child.Wait();
+
+     Report(label, end - begin, rounds, syscalls);
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     int rounds { argc > 1 ? std::atoi(argv[1]) : 100'000 };
+
+     std::printf("%d rounds against a forked client\n", rounds);
+     std::printf("%-32s %14s %16s\n", "transport", "ns/round", "syscalls/round");
+     RunSharedMemory("shared memory, 1 move/exchange", rounds, 1);
+     RunSocket("socketpair, 1 move/exchange", rounds, 1);
+     RunSharedMemory("shared memory, 64 moves/exchange", rounds, 64);
+     RunSocket("socketpair, 64 moves/exchange", rounds, 64);
+     return 0;
+ }
+ 
\ No newline at end of file
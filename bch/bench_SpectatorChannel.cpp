@@ -0,0 +1,226 @@
+/**
+ * @file bench_SpectatorChannel.cpp
+ * @brief Cost of broadcasting a match to many spectators.
+ *
+ * ## Benchmark Strategy
+ * A SpectatorFeed publishes one line per round to S subscribers, each one
+ * end of a Unix socket pair; a reader thread drains the other ends. The
+ * table reports what the match thread pays per round (encoding plus
+ * Publish) and how fast the fan-out thread delivers, with the number of
+ * send calls per delivered frame showing how much scatter-gather batching
+ * happens.
+ *
+ * The baseline formats the line per subscriber and writes it to each
+ * socket from the match thread, one write per round per spectator, which
+ * is what a per-recipient messenger would do.
+ *
+ * Usage: bench_SpectatorChannel [rounds] [maxSubscribers]
+ */
+
+ #include <atomic>
+ #include <chrono>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <string>
+ #include <string_view>
+ #include <sys/epoll.h>
+ #include <sys/socket.h>
+ #include <thread>
+ #include <unistd.h>
+ #include <vector>
+ #include "SpectatorChannel.hpp"
+ #include "SpectatorFeed.hpp"
+
+ namespace {
+
+ using Clock = std::chrono::steady_clock;
+
+ double NanosSince(Clock::time_point begin) {
+     return std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+ }
+
+ /**
+  * @brief Drains the viewer ends until each has received `endMarker` last.
+  */
+ class Drainer {
+ public:
+     Drainer(const std::vector<int>& fds, std::string endMarker)
+         : m_endMarker{std::move(endMarker)}
+     {
+         m_epollFd = ::epoll_create1(0);
+         for (int fd : fds) {
+             epoll_event event {};
+             event.events = EPOLLIN;
+             event.data.fd = fd;
+             ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event);
+         }
+         m_thread = std::thread([this, remaining = fds.size()]() mutable {
+             epoll_event events[256];
+             char buffer[65536];
+             while (remaining > 0) {
+                 int ready { ::epoll_wait(m_epollFd, events, 256, 5000) };
+                 if (ready <= 0) {
+                     break;
+                 }
+                 for (int i{}; i < ready; ++i) {
+                     ssize_t count { ::read(events[i].data.fd, buffer, sizeof(buffer)) };
+                     if (count <= 0) {
+                         continue;
+                     }
+                     std::string_view tail { buffer, static_cast<std::size_t>(count) };
+                     if (tail.size() >= m_endMarker.size() &&
+                         tail.substr(tail.size() - m_endMarker.size()) == m_endMarker) {
+                         ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, events[i].data.fd, nullptr);
+                         --remaining;
+                     }
+                 }
+             }
+             m_done = Clock::now();
+         });
+     }
+
+     ~Drainer() {
+         ::close(m_epollFd);
+     }
+
+     Clock::time_point Join() {
+         m_thread.join();
+         return m_done;
+     }
+
+ private:
+     std::string m_endMarker {};
+     int m_epollFd {-1};
+     Clock::time_point m_done {};
+     std::thread m_thread {};
+ };
+
+ RoundRecord Round(std::uint32_t round) {
+     RoundRecord record {};
+     record.sessionId = 1;
+     record.round = round;
+     record.userMove = static_cast<std::uint8_t>(1 + round % 3);
+     record.computerMove = static_cast<std::uint8_t>(1 + (round / 3) % 3);
+     record.outcome = static_cast<RoundOutcome>(round % 3);
+     record.userName = "Challenger";
+     record.computerName = "Champion";
+     return record;
+ }
+
+ /**
+  * @brief Returns `count` connected socket pairs as {match side, viewer side}.
+  */
+ std::vector<std::pair<int, int>> SocketPairs(int count) {
+     std::vector<std::pair<int, int>> pairs;
+     for (int i{}; i < count; ++i) {
+         int fds[2] {};
+         if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+             std::perror("socketpair");
+             std::exit(1);
+         }
+         pairs.emplace_back(fds[0], fds[1]);
+     }
+     return pairs;
+ }
+
+ void MeasureChannel(int rounds, int subscribers) {
+     const std::string endMarker {"end\n"};
+     SpectatorOptions options {};
+     while (options.backlogFrames <= static_cast<std::size_t>(rounds)) {
+         options.backlogFrames *= 2;
+     }
+     auto pairs = SocketPairs(subscribers);
+     std::vector<int> viewers;
+     double publishNanos {};
+     double seconds {};
+     SpectatorStats stats {};
+     {
+         SpectatorChannel channel{options};
+         SpectatorFeed feed{channel};
+         for (auto [matchSide, viewer] : pairs) {
+             channel.Subscribe(matchSide);
+             viewers.push_back(viewer);
+         }
+         while (channel.Stats().subscribers < static_cast<std::uint64_t>(subscribers)) {
+             std::this_thread::yield();
+         }
+
+         Drainer drainer{viewers, endMarker};
+         auto begin = Clock::now();
+         for (int r {1}; r <= rounds; ++r) {
+             feed.OnRound(Round(static_cast<std::uint32_t>(r)));
+         }
+         publishNanos = NanosSince(begin) / rounds;
+         channel.Publish(SpectatorChannel::MakeFrame(endMarker));
+         seconds = std::chrono::duration<double>(drainer.Join() - begin).count();
+         stats = channel.Stats();
+     }
+     for (int viewer : viewers) {
+         ::close(viewer);
+     }
+
+     double deliveries { static_cast<double>(rounds) * subscribers };
+     std::printf("%12d %16.0f %18.0f %16.3f %12.0f\n", subscribers, publishNanos, deliveries / seconds,
+                 static_cast<double>(stats.sendCalls) / deliveries, static_cast<double>(stats.skippedFrames));
+ }
+
+ /**
+  * @brief Formats and writes each line per subscriber on the match thread.
+  */
+ void MeasureBaseline(int rounds, int subscribers) {
+     const std::string endMarker {"end\n"};
+     auto pairs = SocketPairs(subscribers);
+     std::vector<int> viewers;
+     for (auto [matchSide, viewer] : pairs) {
+         viewers.push_back(viewer);
+     }
+     Drainer drainer{viewers, endMarker};
+
+     auto begin = Clock::now();
+     for (int r {1}; r <= rounds; ++r) {
+         RoundRecord record { Round(static_cast<std::uint32_t>(r)) };
+         for (auto [matchSide, viewer] : pairs) {
+             std::string line {"round " + std::to_string(record.round) + ": "};
+             line += record.userName;
+             line += " vs ";
+             line += record.computerName;
+             line += "\n";
+             if (::write(matchSide, line.data(), line.size()) < 0) {
+                 std::perror("write");
+             }
+         }
+     }
+     double roundNanos { NanosSince(begin) / rounds };
+     for (auto [matchSide, viewer] : pairs) {
+         (void)::write(matchSide, endMarker.data(), endMarker.size());
+     }
+     double seconds { std::chrono::duration<double>(drainer.Join() - begin).count() };
+     for (auto [matchSide, viewer] : pairs) {
+         ::close(matchSide);
+         ::close(viewer);
+     }
+     std::printf("%12d %16.0f %18.0f\n", subscribers, roundNanos,
+                 static_cast<double>(rounds) * subscribers / seconds);
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     int rounds { argc > 1 ? std::atoi(argv[1]) : 4096 };
+     int maxSubscribers { argc > 2 ? std::atoi(argv[2]) : 1000 };
+
+     std::printf("SpectatorChannel: %d rounds, one line per round\n", rounds);
+     std::printf("%12s %16s %18s %16s %12s\n", "subscribers", "match ns/round", "deliveries/s", "sends/delivery", "skipped");
+     for (int subscribers {10}; subscribers <= maxSubscribers; subscribers *= 10) {
+         MeasureChannel(rounds, subscribers);
+     }
+
+     std::printf("\nBaseline: format and write per subscriber on the match thread\n");
+     std::printf("%12s %16s %18s\n", "subscribers", "match ns/round", "deliveries/s");
+     for (int subscribers {10}; subscribers <= maxSubscribers; subscribers *= 10) {
+         MeasureBaseline(rounds, subscribers);
+     }
+     return 0;
+ }
+ 
\ No newline at end of file
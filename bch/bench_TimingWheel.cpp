@@ -0,0 +1,107 @@
+/**
+ * @file bench_TimingWheel.cpp
+ * @brief Schedule/cancel/expire benchmark for TimingWheel.
+ *
+ * ## Benchmark Strategy
+ * Models an event loop holding `timers` pending move deadlines: every
+ * timer is armed, then each "move" cancels its deadline and re-arms it
+ * (the common case), and finally time advances so all of them expire.
+ * The same workload runs against a std::multimap keyed by deadline (the
+ * usual ordered-container approach) for comparison.
+ *
+ * Usage: bench_TimingWheel [timers] [moves]
+ */
+
+ #include <chrono>
+ #include <cstdint>
+ #include <cstdio>
+ #include <cstdlib>
+ #include <map>
+ #include <random>
+ #include <vector>
+ #include "TimingWheel.hpp"
+
+ namespace {
+
+ using Clock = std::chrono::steady_clock;
+
+ double NsPer(Clock::time_point begin, Clock::time_point end, std::size_t ops)
+ {
+     return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(ops);
+ }
+
+ void RunWheel(std::size_t timerCount, std::size_t moves, const std::vector<std::uint64_t>& delays)
+ {
+     TimingWheel wheel;
+     std::size_t fired {};
+     std::vector<TimingWheel::Timer> timers(timerCount);
+     for (auto& timer : timers) {
+         timer.SetCallback([&fired]() { ++fired; });
+     }
+
+     auto begin = Clock::now();
+     for (std::size_t i{}; i < timerCount; ++i) {
+         wheel.ScheduleAfter(timers[i], delays[i]);
+     }
+     auto armed = Clock::now();
+     for (std::size_t i{}; i < moves; ++i) {
+         TimingWheel::Timer& timer { timers[i % timerCount] };
+         wheel.Cancel(timer);
+         wheel.ScheduleAfter(timer, delays[(i * 7) % timerCount]);
+     }
+     auto moved = Clock::now();
+     wheel.Advance(wheel.Now() + 120'000);
+     auto expired = Clock::now();
+
+     std::printf("%-14s %14.1f %14.1f %14.1f %10zu\n", "TimingWheel", NsPer(begin, armed, timerCount),
+                 NsPer(armed, moved, moves), NsPer(moved, expired, timerCount), fired);
+ }
+
+ void RunMultimap(std::size_t timerCount, std::size_t moves, const std::vector<std::uint64_t>& delays)
+ {
+     std::multimap<std::uint64_t, std::size_t> deadlines;
+     std::vector<std::multimap<std::uint64_t, std::size_t>::iterator> handles(timerCount);
+     std::size_t fired {};
+
+     auto begin = Clock::now();
+     for (std::size_t i{}; i < timerCount; ++i) {
+         handles[i] = deadlines.emplace(delays[i], i);
+     }
+     auto armed = Clock::now();
+     for (std::size_t i{}; i < moves; ++i) {
+         std::size_t index { i % timerCount };
+         deadlines.erase(handles[index]);
+         handles[index] = deadlines.emplace(delays[(i * 7) % timerCount], index);
+     }
+     auto moved = Clock::now();
+     while (!deadlines.empty() && deadlines.begin()->first <= 120'000) {
+         deadlines.erase(deadlines.begin());
+         ++fired;
+     }
+     auto expired = Clock::now();
+
+     std::printf("%-14s %14.1f %14.1f %14.1f %10zu\n", "std::multimap", NsPer(begin, armed, timerCount),
+                 NsPer(armed, moved, moves), NsPer(moved, expired, timerCount), fired);
+ }
+
+ } // namespace
+
+ int main(int argc, char* argv[])
+ {
+     std::size_t timerCount { argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100'000 };
+     std::size_t moves { argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1'000'000 };
+
+     // Deadlines between 1 ms and 2 minutes, as move and session timeouts would be.
+     std::mt19937_64 engine{1};
+     std::vector<std::uint64_t> delays(timerCount);
+     for (auto& delay : delays) {
+         delay = 1 + engine() % 120'000;
+     }
+
+     std::printf("%zu pending timers, %zu cancel+re-arm pairs (ns per operation)\n", timerCount, moves);
+     std::printf("%-14s %14s %14s %14s %10s\n", "", "schedule", "cancel+rearm", "expire", "fired");
+     RunWheel(timerCount, moves, delays);
+     RunMultimap(timerCount, moves, delays);
+     return 0;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,168 @@
+/**
+ * @file AllocationTracker.hpp
+ * @brief Declares the AllocationTracker, AllocationScope and AllocationObserver classes.
+ *
+ * Builds compiled with ROCK_PAPER_SCISSORS_TRACK_ALLOCATIONS replace the
+ * global operator new and operator delete with versions that count every
+ * allocation in per-thread counters before calling malloc and free. The
+ * counters are plain thread_local integers, so counting costs a few
+ * instructions and never takes a lock; a thread only ever sees its own
+ * allocations. rps_tests is always built this way, so tests can assert
+ * allocation budgets; the game is built this way with the CMake option
+ * of the same name.
+ *
+ * Call-site sampling records the return address of operator new for one
+ * allocation in every SetSamplingInterval() allocations, in a fixed
+ * per-thread table that itself never allocates. Reports give each
+ * address as an offset into its binary, for `addr2line -f -C -e`.
+ *
+ * Without the definition nothing is replaced: Enabled() returns false and
+ * every count stays 0.
+ */
+
+ #pragma once
+
+ #include "IRoundObserver.hpp"
+ #include <cstdint>
+ #include <iosfwd>
+ #include <vector>
+ 
+ /**
+  * @brief Heap activity of one thread.
+  */
+ struct AllocationCounts {
+     std::uint64_t allocations {};
+     std::uint64_t deallocations {};
+     std::uint64_t bytes {};
+ 
+     AllocationCounts operator-(const AllocationCounts& earlier) const {
+         return {allocations - earlier.allocations, deallocations - earlier.deallocations, bytes - earlier.bytes};
+     }
+ };
+ 
+ /**
+  * @brief A sampled caller of operator new and how often it was sampled.
+  */
+ struct AllocationCallSite {
+     const void* address {};
+     std::uint64_t samples {};
+ };
+ 
+ /**
+  * @brief Reads the calling thread's allocation counters.
+  */
+ class AllocationTracker {
+ public:
+     /**
+      * @brief Largest number of distinct call sites a thread remembers;
+      *        samples from further sites are counted as dropped.
+      */
+     static constexpr std::size_t kCallSiteCapacity {256};
+ 
+     /**
+      * @brief True if operator new and delete are replaced in this build.
+      */
+     static bool Enabled();
+ 
+     /**
+      * @brief The calling thread's totals since it started.
+      */
+     static AllocationCounts ThreadCounts();
+ 
+     /**
+      * @brief Samples one allocation in every `interval` on all threads; 0 stops sampling.
+      */
+     static void SetSamplingInterval(std::uint32_t interval);
+ 
+     /**
+      * @brief The calling thread's sampled call sites, most sampled first.
+      */
+     static std::vector<AllocationCallSite> ThreadCallSites();
+ 
+     /**
+      * @brief Samples the calling thread could not record because its table was full.
+      */
+     static std::uint64_t ThreadDroppedSamples();
+ 
+     /**
+      * @brief Forgets the calling thread's sampled call sites.
+      */
+     static void ClearThreadCallSites();
+ };
+ 
+ /**
+  * @brief Counts the calling thread's allocations from construction on.
+  */
+ class AllocationScope {
+ public:
+     AllocationScope();
+ 
+     /**
+      * @brief Allocations made on this thread since construction or Restart().
+      */
+     AllocationCounts Counts() const;
+ 
+     void Restart();
+ 
+ private:
+     AllocationCounts m_start {};
+ };
+ 
+ /**
+  * @brief Per-round and per-session allocation counts of the sessions it observes.
+  *
+  * Each OnRound() charges to the round everything the calling thread
+  * allocated since the previous call (or since Reset() for the first
+  * round), after forwarding the round to an optional next observer so the
+  * observers that follow are not counted. Rounds must therefore be
+  * reported on the thread that plays them, as SinglePlayerRpsGame does.
+  */
+ class AllocationObserver : public IRoundObserver {
+ public:
+     /**
+      * @brief Allocation counts of the rounds and sessions seen so far.
+      */
+     struct Report {
+         std::uint64_t sessions {};
+         std::uint64_t rounds {};
+ 
+         /**
+          * @brief Everything allocated from Reset() to the last round or session end.
+          */
+         AllocationCounts total {};
+ 
+         /**
+          * @brief Allocations charged to rounds, and the most charged to one round.
+          */
+         std::uint64_t roundAllocations {};
+         std::uint64_t maxRoundAllocations {};
+         std::uint64_t roundBytes {};
+     };
+ 
+     /**
+      * @param next Observer every round and session end is forwarded to; not owned.
+      */
+     explicit AllocationObserver(IRoundObserver* next = nullptr);
+ 
+     void OnRound(const RoundRecord& record) override;
+     void OnSessionEnd(const SessionSummary& summary) override;
+ 
+     /**
+      * @brief Starts counting afresh from the calling thread's current totals.
+      */
+     void Reset();
+ 
+     Report Snapshot() const;
+ 
+     /**
+      * @brief Writes the report and the calling thread's top sampled call sites.
+      */
+     void Print(std::ostream& out, std::size_t callSites = 10) const;
+ 
+ private:
+     IRoundObserver* m_next {};
+     AllocationScope m_sinceReset {};
+     AllocationCounts m_lastMark {};
+     Report m_report {};
+ };
+ 
\ No newline at end of file
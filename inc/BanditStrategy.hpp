@@ -0,0 +1,127 @@
+/**
+ * @file BanditStrategy.hpp
+ * @brief Declares the BanditStrategy class.
+ *
+ * BanditStrategy treats a portfolio of IMoveStrategy instances as the arms
+ * of a multi-armed bandit. Each round every arm proposes a move and keeps
+ * observing the game as if it had played it, so arms that depend on
+ * history stay current; the bandit policy picks whose proposal is played.
+ * Only the chosen arm is credited with the payoff (1 for a win, 1/2 for a
+ * draw, 0 for a loss), which is the bandit setting the policies assume.
+ *
+ * Policies:
+ *   - UCB1: highest mean payoff plus sqrt(2 ln n / n_i); unplayed arms first.
+ *   - Thompson sampling: a Beta(1 + payoff, 1 + shortfall) draw per arm,
+ *     taken from its normal approximation once both shapes are large.
+ *   - EXP3: exponential weights mixed with uniform exploration, for
+ *     opponents that adapt to the computer.
+ *
+ * With a discount below 1, UCB1 and Thompson statistics decay every round,
+ * so the selector follows opponents that change their play. All state is
+ * sized when the strategy is built; choosing and updating never allocate.
+ */
+
+ #pragma once
+
+ #include "IMoveStrategy.hpp"
+ #include "Xoshiro256.hpp"
+ #include <cstdint>
+ #include <memory>
+ #include <vector>
+ 
+ enum class BanditPolicy : std::uint8_t
+ {
+     Ucb1 = 0,
+     Thompson = 1,
+     Exp3 = 2
+ };
+ 
+ struct BanditOptions {
+     BanditPolicy policy {BanditPolicy::Ucb1};
+ 
+     /**
+      * @brief Factor applied to UCB1 and Thompson statistics each round; 1 keeps everything.
+      */
+     double discount {1.0};
+ 
+     /**
+      * @brief EXP3's share of uniform exploration, in (0, 1].
+      */
+     double exploration {0.1};
+ 
+     /**
+      * @brief Seeds the draws of Thompson sampling and EXP3.
+      */
+     std::uint64_t seed {};
+ };
+ 
+ /**
+  * @brief Picks one strategy of a portfolio per round with a bandit policy.
+  */
+ class BanditStrategy : public IMoveStrategy {
+ public:
+     /**
+      * @param arms    The portfolio; at least one strategy.
+      * @param options Policy and its parameters.
+      * @throws std::invalid_argument if the portfolio is empty, an arm is null
+      *         or a parameter is out of range.
+      */
+     BanditStrategy(std::vector<std::unique_ptr<IMoveStrategy>> arms, BanditOptions options);
+ 
+     /**
+      * @brief Builds a selector over the built-in strategies of MoveStrategies.hpp.
+      */
+     static std::unique_ptr<BanditStrategy> WithBuiltinPortfolio(BanditOptions options);
+ 
+     GameMove NextMove() override;
+     void ObserveRound(GameMove ownMove, GameMove opponentMove) override;
+     bool DependsOnHistory() const override;
+ 
+     std::size_t ArmCount() const;
+ 
+     /**
+      * @brief The arm whose move the last NextMove() returned.
+      */
+     std::size_t ChosenArm() const;
+ 
+     /**
+      * @brief How many times each arm has been chosen.
+      */
+     std::uint64_t Pulls(std::size_t arm) const;
+ 
+ private:
+     struct Arm {
+         std::unique_ptr<IMoveStrategy> strategy {};
+         GameMove proposal {GameMove::Rock};
+         std::uint64_t pulls {};
+ 
+         /**
+          * @brief Discounted number of plays and payoff (UCB1, Thompson).
+          */
+         double weight {};
+         double payoff {};
+ 
+         /**
+          * @brief EXP3 log-weight and the probability it was chosen with.
+          */
+         double logWeight {};
+         double probability {};
+     };
+ 
+     std::size_t SelectUcb1() const;
+     std::size_t SelectThompson();
+     std::size_t SelectExp3();
+     double SampleBeta(double alpha, double beta);
+     double SampleGamma(double shape);
+     double SampleNormal();
+     double UnitInterval();
+ 
+     std::vector<Arm> m_arms {};
+     BanditOptions m_options {};
+     Xoshiro256 m_random {};
+     double m_spareNormal {};
+     bool m_hasSpareNormal {};
+     std::size_t m_chosen {};
+     bool m_proposed {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,144 @@
+/**
+ * @file BotArena.hpp
+ * @brief Declares the BotArena class.
+ *
+ * BotArena plays many bot-versus-bot matches at once on a single thread.
+ * Each side of every SinglePlayerRpsGame is a child process speaking
+ * BotProtocol over a Unix socket; all sockets are multiplexed with epoll.
+ * The user side feeds the session through a QueuedMoveMessenger and the
+ * computer side through the session's move generator.
+ *
+ * Optional deadlines keep a silent bot from pinning its match: a bot that
+ * misses its per-move deadline forfeits that round, and when the per-match
+ * deadline passes every remaining round is forfeited. Forfeits reach the
+ * session as invalid user input, so they take the usual
+ * ShowInvalidInputMessage path. All deadlines share one TimingWheel.
+ */
+
+ #pragma once
+
+ #include "IMoveStrategy.hpp"
+ #include "TimingWheel.hpp"
+ #include <chrono>
+ #include <cstddef>
+ #include <cstdint>
+ #include <functional>
+ #include <memory>
+ #include <string>
+ #include <vector>
+ 
+ /**
+  * @brief Describes how to start one bot.
+  *
+  * If `command` is non-empty it is executed as an external program;
+  * otherwise the arena forks and runs `strategy()` in the child.
+  */
+ struct BotSpec {
+     std::string name {};
+     std::vector<std::string> command {};
+     std::function<std::unique_ptr<IMoveStrategy>()> strategy {};
+ };
+ 
+ /**
+  * @brief The outcome of one arena match.
+  */
+ struct BotMatchResult {
+     int userScore {};
+     int computerScore {};
+     int roundsPlayed {};
+ 
+     /**
+      * @brief Rounds voided because a bot sent something other than a move.
+      */
+     int invalidRounds {};
+ 
+     /**
+      * @brief Rounds forfeited because a bot missed a deadline.
+      */
+     int timedOutRounds {};
+ 
+     /**
+      * @brief False if a bot disconnected or broke the protocol mid-match.
+      */
+     bool completed {};
+ };
+ 
+ /**
+  * @brief Runs bot matches as child processes multiplexed over epoll.
+  */
+ class BotArena {
+ public:
+     BotArena();
+     ~BotArena();
+ 
+     BotArena(const BotArena&) = delete;
+     BotArena& operator=(const BotArena&) = delete;
+ 
+     /**
+      * @brief Queues a match; processes are started by Run().
+      * @param user      Bot playing the user side.
+      * @param computer  Bot playing the computer side.
+      * @param rounds    Number of rounds in the match.
+      * @return Index of the match in the results returned by Run().
+      */
+     std::size_t AddMatch(BotSpec user, BotSpec computer, int rounds);
+ 
+     /**
+      * @brief Sets how long a bot may take to answer a move request.
+      * @param timeout Zero (the default) disables the deadline.
+      */
+     void SetMoveTimeout(std::chrono::milliseconds timeout);
+ 
+     /**
+      * @brief Sets how long a whole match may take.
+      * @param timeout Zero (the default) disables the deadline.
+      */
+     void SetMatchTimeout(std::chrono::milliseconds timeout);
+ 
+     /**
+      * @brief Starts every queued match and runs them all to completion.
+      * @return One result per match, in AddMatch() order.
+      * @throws std::system_error if epoll or a bot process cannot be created.
+      */
+     std::vector<BotMatchResult> Run();
+ 
+     /**
+      * @brief Returns the number of socket reads and writes issued by the last Run().
+      */
+     std::size_t SyscallCount() const;
+ 
+ private:
+     struct Side;
+     struct Match;
+ 
+     void StartMatch(Match& match);
+     void OnReadable(Side& side);
+     void OnWritable(Side& side);
+     void Pump(Match& match);
+     void SendRequest(Side& side, std::size_t count);
+     void SendFrame(Side& side, const unsigned char* frame, std::size_t size);
+     void Flush(Side& side);
+     void WatchWritable(Side& side, bool writable);
+     void EndMatch(Match& match, bool completed);
+     void ArmMoveDeadline(Side& side);
+     void OnMoveDeadline(Side& side);
+     void OnMatchDeadline(Match& match);
+     std::uint64_t NowTicks() const;
+ 
+ private:
+     /**
+      * @brief Deadlines of every match, in milliseconds since Run() started.
+      *
+      * Declared before m_matches so that timers are destroyed first.
+      */
+     TimingWheel m_wheel {};
+     std::chrono::steady_clock::time_point m_start {};
+     std::chrono::milliseconds m_moveTimeout {};
+     std::chrono::milliseconds m_matchTimeout {};
+ 
+     std::vector<std::unique_ptr<Match>> m_matches {};
+     int m_epollFd {-1};
+     std::size_t m_activeMatches {};
+     std::size_t m_syscalls {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,45 @@
+/**
+ * @file BotClient.hpp
+ * @brief Declares the BotClient class.
+ *
+ * BotClient implements the bot side of BotProtocol: it announces itself
+ * with Hello, then answers every Request with moves chosen by an
+ * IMoveStrategy. The rps_bot executable wraps it around stdin/stdout.
+ */
+
+ #pragma once
+
+ #include "BotProtocol.hpp"
+ #include "IMoveStrategy.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ 
+ /**
+  * @brief The bot side of the protocol: answers Requests using a strategy.
+  */
+ class BotClient {
+ public:
+     /**
+      * @brief Constructs a client on already-connected descriptors.
+      * @param inputFd  Descriptor frames are read from.
+      * @param outputFd Descriptor frames are written to (may equal inputFd).
+      * @param strategy Strategy choosing the moves; must outlive the client.
+      */
+     BotClient(int inputFd, int outputFd, IMoveStrategy& strategy);
+ 
+     /**
+      * @brief Sends Hello and serves Requests until Bye or end of stream.
+      * @return 0 on a clean Bye, 1 on an I/O or protocol error.
+      */
+     int Run();
+ 
+ private:
+     bool ReadExactly(std::uint8_t* data, std::size_t size);
+     bool WriteAll(const std::uint8_t* data, std::size_t size);
+ 
+ private:
+     int m_inputFd {-1};
+     int m_outputFd {-1};
+     IMoveStrategy* m_strategy {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,162 @@
+/**
+ * @file BotDetector.hpp
+ * @brief Declares the BotDetector class.
+ *
+ * BotDetector is an IRoundObserver that scores how machine-like each
+ * user's play is, over a window of their last rounds:
+ *   - entropy: of the moves, and of each move given the previous one
+ *     (a script cycling R, P, S has full move entropy but none given the
+ *     previous move);
+ *   - compression: bits per move that an adaptive context model, keyed by
+ *     the previous round, needs to encode the moves, relative to log2(3);
+ *   - exploitability: the best hit rate among simple predictors of the
+ *     next move (repeat, cycle, copy or counter the computer, most
+ *     frequent, context model), i.e. how often a counter-bot would win;
+ *   - win rate: counter-play that wins nearly every round.
+ *
+ * Once a user has played a full window, a score past its threshold raises
+ * a flag, and the handler is called whenever a user gains a new flag. Each
+ * round costs O(1): counts enter and leave the window incrementally and
+ * logarithms come from tables, so nothing is recomputed over the window.
+ *
+ * Locking follows RoundStatistics: a reader-writer lock over the name
+ * table, exclusive only for new names, and a mutex per user. The handler
+ * runs with no lock held. Only the user side of a round is scored; the
+ * computer is ours.
+ */
+
+ #pragma once
+
+ #include "IRoundObserver.hpp"
+ #include <array>
+ #include <cstdint>
+ #include <functional>
+ #include <memory>
+ #include <mutex>
+ #include <optional>
+ #include <shared_mutex>
+ #include <string>
+ #include <string_view>
+ #include <unordered_map>
+ #include <vector>
+ 
+ /**
+  * @brief Reasons a user looks scripted; BotScores::flags holds them as bits.
+  */
+ enum class BotFlag : std::uint8_t
+ {
+     LowEntropy = 1,
+     Compressible = 2,
+     Predictable = 4,
+     PerfectPlay = 8
+ };
+ 
+ constexpr bool HasBotFlag(std::uint8_t flags, BotFlag flag) {
+     return (flags & static_cast<std::uint8_t>(flag)) != 0;
+ }
+ 
+ struct BotDetectorOptions {
+     /**
+      * @brief Rounds scored per user; flags wait until the window is full.
+      */
+     std::size_t windowRounds {64};
+ 
+     /**
+      * @brief LowEntropy below this many bits per move (conditional; at most log2(3) = 1.585).
+      */
+     double entropyFloor {0.9};
+ 
+     /**
+      * @brief Compressible below this ratio of model bits to log2(3) bits per move.
+      */
+     double compressionFloor {0.6};
+ 
+     /**
+      * @brief Predictable above this predictor hit rate (1/3 for random play).
+      */
+     double exploitabilityCeiling {0.75};
+ 
+     /**
+      * @brief PerfectPlay above this win rate (1/3 for random play).
+      */
+     double winRateCeiling {0.85};
+ };
+ 
+ /**
+  * @brief A user's current scores.
+  */
+ struct BotScores {
+     std::string_view name {};
+ 
+     /**
+      * @brief Valid moves in the window, at most BotDetectorOptions::windowRounds.
+      */
+     std::size_t rounds {};
+ 
+     /**
+      * @brief Bits per move of the moves, and of a move given the previous one.
+      */
+     double entropy {};
+     double conditionalEntropy {};
+     double compressionRatio {};
+     double exploitability {};
+     double winRate {};
+ 
+     /**
+      * @brief BotFlag bits raised so far; they stay raised.
+      */
+     std::uint8_t flags {};
+ };
+ 
+ /**
+  * @brief Scores live move streams for scripted play.
+  */
+ class BotDetector : public IRoundObserver {
+ public:
+     /**
+      * @brief Called after a round in which a user gained a flag.
+      */
+     using FlagHandler = std::function<void(const BotScores& scores)>;
+ 
+     /**
+      * @throws std::invalid_argument if the window is not in [2, 4096].
+      */
+     explicit BotDetector(BotDetectorOptions options = {}, FlagHandler handler = {});
+     ~BotDetector() override;
+ 
+     BotDetector(const BotDetector&) = delete;
+     BotDetector& operator=(const BotDetector&) = delete;
+ 
+     void OnRound(const RoundRecord& record) override;
+ 
+     /**
+      * @brief Forgets the previous round, so the next session starts without context.
+      */
+     void OnSessionEnd(const SessionSummary& summary) override;
+ 
+     /**
+      * @brief Returns a user's scores, if the user was ever seen.
+      */
+     std::optional<BotScores> Scores(std::string_view name) const;
+ 
+     static constexpr std::size_t kPredictors {6};
+ 
+ private:
+     struct Player;
+ 
+     Player& Find(std::string_view name);
+     BotScores Score(const Player& player) const;
+ 
+     BotDetectorOptions m_options {};
+     FlagHandler m_handler {};
+ 
+     /**
+      * @brief n * log2(n) for n up to the window.
+      */
+     std::vector<double> m_nLogN {};
+ 
+     mutable std::shared_mutex m_namesMutex {};
+     // No "{}": a default member initializer would need Player to be complete here.
+     std::unordered_map<std::string_view, std::unique_ptr<Player>> m_players;
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @file BotProcess.hpp
+ * @brief Declares the BotProcess class.
+ *
+ * BotProcess owns one child process playing as a bot together with the
+ * arena's end of the Unix socket connected to it. The child either execs
+ * an external bot program (with the socket as its stdin and stdout) or,
+ * for built-in strategies, runs a function directly after fork().
+ */
+
+ #pragma once
+
+ #include <chrono>
+ #include <functional>
+ #include <string>
+ #include <sys/types.h>
+ #include <vector>
+ 
+ /**
+  * @brief A child bot process and the socket used to talk to it.
+  *
+  * Move-only. The destructor closes the socket and reaps the child; a
+  * child still running kExitGrace after seeing end of stream is killed.
+  */
+ class BotProcess {
+ public:
+     /**
+      * @brief How long a child may take to exit once its socket is closed.
+      */
+     static constexpr std::chrono::milliseconds kExitGrace {100};
+
+     BotProcess() = default;
+     ~BotProcess();
+ 
+     BotProcess(BotProcess&& other) noexcept;
+     BotProcess& operator=(BotProcess&& other) noexcept;
+     BotProcess(const BotProcess&) = delete;
+     BotProcess& operator=(const BotProcess&) = delete;
+ 
+     /**
+      * @brief Starts an external bot program.
+      * @param command Program and arguments; the program is looked up in PATH.
+      * @return The running process.
+      * @throws std::system_error if the socket or the process cannot be created.
+      */
+     static BotProcess Launch(const std::vector<std::string>& command);
+ 
+     /**
+      * @brief Forks a child that runs `body` with its end of the socket.
+      * @param body Called in the child; its return value is the exit code.
+      * @return The running process.
+      * @throws std::system_error if the socket or the process cannot be created.
+      */
+     static BotProcess Fork(const std::function<int(int fd)>& body);
+ 
+     /**
+      * @brief Returns the arena's end of the socket (non-blocking), or -1.
+      */
+     int Fd() const;
+ 
+     /**
+      * @brief Returns the child's process id, or -1.
+      */
+     pid_t Pid() const;
+ 
+     /**
+      * @brief Closes the arena's end of the socket, signalling end of stream.
+      */
+     void CloseConnection();
+ 
+     /**
+      * @brief Kills the child; used for bots that stopped responding.
+      */
+     void Kill();
+ 
+     /**
+      * @brief Waits for the child to exit.
+      * @return The child's exit code, or -1 if it was killed or never started.
+      */
+     int Wait();
+ 
+ private:
+     BotProcess(int fd, pid_t pid);
+ 
+     /**
+      * @brief Creates the socket pair and forks; `child` runs in the child.
+      */
+     static BotProcess Spawn(const std::function<int(int fd)>& child);
+ 
+     void Release();
+ 
+ private:
+     int m_fd {-1};
+     pid_t m_pid {-1};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,101 @@
+/**
+ * @file BotProtocol.hpp
+ * @brief Declares the BotProtocol class: the arena <-> bot wire format.
+ *
+ * Every frame starts with a 4-byte header followed by a byte payload:
+ *
+ * | Byte | Field        | Meaning                                         |
+ * | ---- | ------------ | ----------------------------------------------- |
+ * | 0    | type         | FrameType                                       |
+ * | 1    | count        | Moves requested (Request) or carried (Moves)    |
+ * | 2    | historyCount | Opponent moves carried by a Request             |
+ * | 3    | flags        | Hello flags; zero otherwise                     |
+ *
+ * - Hello   (bot -> arena): sent once on startup. Flag kBatchable means
+ *           the bot ignores history, so it may be asked for many moves at once.
+ * - Request (arena -> bot): payload is `historyCount` opponent moves from
+ *           rounds completed since the previous Request, oldest first;
+ *           kNoMove marks a round the opponent forfeited or fumbled. The
+ *           bot answers with one Moves frame of exactly `count` moves, or
+ *           not at all when `count` is 0.
+ * - Moves   (bot -> arena): payload is `count` moves, 1=Rock 2=Paper 3=Scissors.
+ * - Bye     (arena -> bot): the match is over; the bot should exit.
+ *
+ * Batchable bots are asked for up to kMaxBatch moves per exchange, which
+ * keeps the syscall cost per round far below one.
+ */
+
+ #pragma once
+
+ #include <cstddef>
+ #include <cstdint>
+ 
+ /**
+  * @brief Encoding helpers for the bot protocol.
+  */
+ class BotProtocol {
+ public:
+     /**
+      * @brief Identifies the kind of frame.
+      */
+     enum class FrameType : std::uint8_t
+     {
+         Hello = 1,
+         Request = 2,
+         Moves = 3,
+         Bye = 4
+     };
+ 
+     /**
+      * @brief Decoded frame header.
+      */
+     struct FrameHeader {
+         FrameType type {};
+         std::uint8_t count {};
+         std::uint8_t historyCount {};
+         std::uint8_t flags {};
+     };
+ 
+     /**
+      * @brief Hello flag: the bot's moves do not depend on history.
+      */
+     static constexpr std::uint8_t kBatchable {0x01};
+ 
+     /**
+      * @brief History entry for a round in which the opponent played no valid move.
+      */
+     static constexpr std::uint8_t kNoMove {0};
+ 
+     static constexpr std::size_t kHeaderSize {4};
+ 
+     /**
+      * @brief Most moves (or history entries) a single frame can carry.
+      */
+     static constexpr std::size_t kMaxBatch {255};
+ 
+     /**
+      * @brief Largest possible frame; a buffer this big fits any frame.
+      */
+     static constexpr std::size_t kMaxFrameSize {kHeaderSize + kMaxBatch};
+ 
+     static std::size_t EncodeHello(std::uint8_t flags, std::uint8_t* out);
+     static std::size_t EncodeRequest(std::size_t count, const std::uint8_t* history,
+                                      std::size_t historyCount, std::uint8_t* out);
+     static std::size_t EncodeMoves(const std::uint8_t* moves, std::size_t count, std::uint8_t* out);
+     static std::size_t EncodeBye(std::uint8_t* out);
+ 
+     /**
+      * @brief Decodes the frame at the start of a buffer, if it is complete.
+      * @param data    Received bytes.
+      * @param size    Number of received bytes.
+      * @param header  Receives the decoded header.
+      * @return Total size of the frame, or 0 if more bytes are needed.
+      */
+     static std::size_t PeekFrame(const std::uint8_t* data, std::size_t size, FrameHeader& header);
+ 
+     /**
+      * @brief Returns the payload size implied by a header.
+      */
+     static std::size_t PayloadSize(const FrameHeader& header);
+ };
+ 
\ No newline at end of file
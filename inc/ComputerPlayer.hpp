@@ -9,7 +9,9 @@
  #pragma once
 
  #include "IPlayer.hpp"
+ #include "NameInterner.hpp"
  #include <string>
+ #include <string_view>
  
  /**
   * @brief Represents an AI-controlled participant in the game.
@@ -28,11 +30,15 @@
      virtual ~ComputerPlayer() = default;
  
      std::string GetName() const override;
+     std::string_view GetNameView() const override;
      int GetScore() const override;
      void AddWin() override;
  
  private:
-     std::string m_name {};
+     /**
+      * @brief The prefixed name, interned once at construction.
+      */
+     std::string_view m_name {};
      int m_score {};
  };
  
\ No newline at end of file
@@ -11,6 +11,7 @@
  #include "IGameMessenger.hpp"
  #include <memory>
  #include <string>
+ #include <string_view>
  
  /**
   * @brief A console-based implementation of IGameMessenger using std::cin/std::cout.
@@ -37,8 +38,8 @@
      /**
       * @brief Converts a GameMove enum to a human-readable string.
       * @param move The GameMove value.
-      * @return A string representing the GameMove.
+      * @return A view of a string literal representing the GameMove.
       */
-     static std::string ConvertMoveToString(GameMove move);
+     static std::string_view ConvertMoveToString(GameMove move);
  };
  
\ No newline at end of file
@@ -3,16 +3,46 @@
  * @brief Declares the GameMode enum.
  *
  * GameMode is used to identify which type of game session
- * to create in the factory.
+ * to create in the factory. The single-player modes differ only in when
+ * a match ends; MatchRulesFor() maps them to their MatchRules.
  */
 
  #pragma once
 
+ #include <cstddef>
+
  /**
   * @brief Represents the various modes the game can operate in.
   */
  enum class GameMode
  {
-     ConsoleSinglePlayer = 0
+     /**
+      * @brief Plays every configured round.
+      */
+     ConsoleSinglePlayer = 0,
+
+     /**
+      * @brief Best of N: stops once the result can no longer change.
+      */
+     SinglePlayerBestOf,
+
+     /**
+      * @brief First to a majority of the rounds wins.
+      */
+     SinglePlayerFirstTo,
+
+     /**
+      * @brief First to a majority, with a two-win lead.
+      */
+     SinglePlayerWinByTwo
  };
+ 
+ /**
+  * @brief Number of built-in GameMode values.
+  *
+  * Built-in modes are dense and start at 0, so the factory can dispatch them
+  * through a fixed-size array. Keep this in sync when adding enumerators;
+  * values at or above it are treated as dynamically registered modes.
+  */
+ inline constexpr std::size_t kBuiltinGameModeCount {4};
  
\ No newline at end of file
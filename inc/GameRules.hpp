@@ -0,0 +1,28 @@
+/**
+ * @file GameRules.hpp
+ * @brief Declares the Rock-Paper-Scissors round rules.
+ *
+ * These are the rules every session and simulator scores rounds by, so
+ * interactive games and headless runs can never disagree on an outcome.
+ */
+
+ #pragma once
+
+ #include "GameMove.hpp"
+ 
+ /**
+  * @brief Checks if both moves are the same.
+  */
+ constexpr bool IsRoundDraw(GameMove firstMove, GameMove secondMove) {
+     return firstMove == secondMove;
+ }
+ 
+ /**
+  * @brief Checks if the first move beats the second.
+  */
+ constexpr bool DoesFirstMoveWin(GameMove firstMove, GameMove secondMove) {
+     return ((firstMove == GameMove::Rock     && secondMove == GameMove::Scissors) ||
+             (firstMove == GameMove::Paper    && secondMove == GameMove::Rock)     ||
+             (firstMove == GameMove::Scissors && secondMove == GameMove::Paper));
+ }
+ 
\ No newline at end of file
@@ -4,51 +4,149 @@
  *
  * GameSessionFactory creates IGameSession objects for the specified
  * GameMode by storing and invoking registered creation functions.
+ *
+ * The registry is safe to use from many threads at once: Create() reads
+ * an immutable snapshot of the registry through a single atomic pointer
+ * load, while RegisterGame() calls are serialized and publish a new
+ * copy-on-write snapshot.
+ *
+ * Built-in modes (below kBuiltinGameModeCount) are dispatched through a
+ * dense array indexed by the enum value; any other mode falls back to a
+ * hash map. Creators are stored inline and never allocate.
  */
 
  #pragma once
 
  #include "GameMode.hpp"
  #include "IGameSession.hpp"
- #include <functional>
+ #include "InlineFunction.hpp"
+ #include <array>
+ #include <atomic>
  #include <memory>
+ #include <mutex>
  #include <unordered_map>
+ #include <vector>
  
  /**
   * @brief A factory class that can create different types of game sessions.
   */
  class GameSessionFactory {
  public:
+     /**
+      * @brief Size in bytes of the inline storage available to a creator.
+      *
+      * Large enough for a lambda capturing a couple of strings and a few
+      * integers, or for a std::function wrapping a larger callable.
+      */
+     static constexpr std::size_t kCreatorCapacity {96};
+
      /**
       * @brief Type alias for the function that creates a new IGameSession.
       */
-     using CreatorFunc = std::function<std::unique_ptr<IGameSession>()>;
+     using CreatorFunc = InlineFunction<std::unique_ptr<IGameSession>(), kCreatorCapacity>;
  
      /**
-      * @brief Default constructor.
+      * @brief Constructs a factory with an empty registry.
       */
-     GameSessionFactory() = default;
+     GameSessionFactory();
  
      /**
-      * @brief Default destructor.
+      * @brief Destructor. Releases every registry snapshot ever published.
       */
      ~GameSessionFactory() = default;
  
+     GameSessionFactory(const GameSessionFactory&) = delete;
+     GameSessionFactory& operator=(const GameSessionFactory&) = delete;
+ 
      /**
       * @brief Registers a creation function for a specific GameMode.
+      *
+      * Writers are serialized; concurrent Create() calls keep using the
+      * previous snapshot until the new one is published.
+      *
       * @param mode The game mode to register.
       * @param func The function that creates the corresponding IGameSession.
       */
      void RegisterGame(GameMode mode, CreatorFunc func);
+
+     /**
+      * @brief Registers a creation function for a built-in GameMode.
+      *
+      * The mode is checked at compile time to be one of the dense built-in
+      * modes, so its slot in the dispatch array is fixed at compile time.
+      *
+      * @tparam Mode The built-in game mode to register.
+      * @param func The function that creates the corresponding IGameSession.
+      */
+     template <GameMode Mode>
+     void RegisterGame(CreatorFunc func)
+     {
+         static_assert(static_cast<std::size_t>(Mode) < kBuiltinGameModeCount,
+                       "Mode is not a built-in GameMode");
+         RegisterGame(Mode, std::move(func));
+     }
  
      /**
       * @brief Creates an IGameSession for the given GameMode.
+      *
+      * Wait-free with respect to RegisterGame(): costs one acquire load of
+      * the current snapshot plus the lookup and the creator call.
+      *
       * @param mode The game mode for which to create the session.
       * @return A unique_ptr to the created session, or nullptr if mode not found.
       */
-     std::unique_ptr<IGameSession> Create(GameMode mode);
+     std::unique_ptr<IGameSession> Create(GameMode mode) const;
+
+     /**
+      * @brief Creates an IGameSession for a built-in GameMode.
+      *
+      * Skips the range check of Create(GameMode): the dispatch slot is a
+      * compile-time constant.
+      *
+      * @tparam Mode The built-in game mode for which to create the session.
+      * @return A unique_ptr to the created session, or nullptr if mode not registered.
+      */
+     template <GameMode Mode>
+     std::unique_ptr<IGameSession> Create() const
+     {
+         static_assert(static_cast<std::size_t>(Mode) < kBuiltinGameModeCount,
+                       "Mode is not a built-in GameMode");
+         const CreatorFunc& creator {
+             m_registry.load(std::memory_order_acquire)->builtin[static_cast<std::size_t>(Mode)]
+         };
+         return creator ? creator() : nullptr;
+     }
  
  private:
-     std::unordered_map<GameMode, CreatorFunc> m_registry {};
+     /**
+      * @brief An immutable table of creators; never modified once published.
+      */
+     struct Registry {
+         /**
+          * @brief Creators for built-in modes, indexed by the enum value.
+          */
+         std::array<CreatorFunc, kBuiltinGameModeCount> builtin {};
+
+         /**
+          * @brief Creators for modes outside the built-in range.
+          */
+         std::unordered_map<GameMode, CreatorFunc> dynamic {};
+     };
+ 
+     std::atomic<const Registry*> m_registry {};
+ 
+     /**
+      * @brief Serializes writers.
+      */
+     std::mutex m_writerMutex {};
+ 
+     /**
+      * @brief Owns every published snapshot.
+      *
+      * Registrations are rare, so superseded snapshots are simply kept until
+      * the factory is destroyed. Readers may therefore hold a snapshot pointer
+      * without any reference counting or epoch bookkeeping.
+      */
+     std::vector<std::unique_ptr<const Registry>> m_snapshots {};
  };
  
\ No newline at end of file
@@ -0,0 +1,165 @@
+/**
+ * @file HttpGameApi.hpp
+ * @brief Declares the HttpGameApi class.
+ *
+ * HttpGameApi maps HTTP requests onto game sessions. It holds no sockets:
+ * a server hands it each parsed HttpRequest and sends back the status and
+ * JSON body it returns, which keeps the game logic testable without I/O.
+ *
+ *   POST   /sessions             {"user":"Ann","computer":"Bot","rounds":5}
+ *   GET    /sessions/{id}
+ *   POST   /sessions/{id}/moves  {"move":"rock"}
+ *   DELETE /sessions/{id}
+ *
+ * Sessions are created through a GameSessionFactory. The registered
+ * creator reads the requested names and round count from PendingSession()
+ * and must build a SinglePlayerRpsGame around the QueuedMoveMessenger it
+ * finds there; MakeSinglePlayerGame() does exactly that. Each move pushes
+ * the user's choice into the messenger and plays one round, and the API
+ * learns the result as the session's IRoundObserver. Since that takes the
+ * session's only observer slot, the API forwards every round and session
+ * end to an optional next observer; a RoundObserverFanOut there lets
+ * several observers watch the HTTP sessions.
+ *
+ * Players intern their names in NameInterner::Global(), which never
+ * forgets one, so the API accepts at most SetMaxDistinctNames() distinct
+ * names over its lifetime and answers 503 to sessions that would need a
+ * new one beyond that.
+ *
+ * Not thread-safe: one server thread owns the API.
+ */
+
+ #pragma once
+
+ #include "GameMode.hpp"
+ #include "HttpRequestParser.hpp"
+ #include "IRoundObserver.hpp"
+ #include "MatchRules.hpp"
+ #include <cstdint>
+ #include <functional>
+ #include <memory>
+ #include <string>
+ #include <string_view>
+ #include <unordered_map>
+ #include <unordered_set>
+ 
+ class GameSessionFactory;
+ class IGameSession;
+ class QueuedMoveMessenger;
+ class SinglePlayerRpsGame;
+ 
+ /**
+  * @brief What a creator needs to build the session being requested.
+  */
+ struct HttpSessionSetup {
+     std::string userName {};
+     std::string computerName {};
+     int rounds {};
+
+     /**
+      * @brief The API's GameMode applied to `rounds`; see MatchRulesFor().
+      */
+     MatchRules rules {};
+ 
+     /**
+      * @brief Source of the user's moves; the created session must take it.
+      */
+     std::unique_ptr<QueuedMoveMessenger> messenger {};
+ };
+ 
+ /**
+  * @brief Serves the session endpoints on top of a GameSessionFactory.
+  */
+ class HttpGameApi : public IRoundObserver {
+ public:
+     static constexpr int kMaxRounds {10000000};
+     static constexpr std::size_t kMaxNameLength {64};
+     static constexpr std::size_t kMaxDistinctNames {100000};
+ 
+     /**
+      * @param factory Creates sessions; must outlive the API.
+      * @param mode    The mode whose creator builds HTTP sessions.
+      * @param next    Receives every round and session end of every session; not owned.
+      */
+     HttpGameApi(GameSessionFactory& factory, GameMode mode, IRoundObserver* next = nullptr);
+     ~HttpGameApi() override;
+ 
+     HttpGameApi(const HttpGameApi&) = delete;
+     HttpGameApi& operator=(const HttpGameApi&) = delete;
+ 
+     /**
+      * @brief Handles one request.
+      * @param request The parsed request.
+      * @param body    Cleared, then filled with the JSON response body.
+      * @return The HTTP status code.
+      */
+     int Handle(const HttpRequest& request, std::string& body);
+ 
+     /**
+      * @brief The session being created; only valid inside a creator call.
+      * @throws std::logic_error outside a creator call.
+      */
+     HttpSessionSetup& PendingSession();
+ 
+     /**
+      * @brief Builds the SinglePlayerRpsGame an HTTP session expects.
+      * @param setup         From PendingSession(); its messenger is taken.
+      * @param computerMoves Generator values v become moves 1 + (v % 3).
+      */
+     static std::unique_ptr<IGameSession> MakeSinglePlayerGame(HttpSessionSetup& setup,
+                                                               std::function<int()> computerMoves);
+ 
+     /**
+      * @brief Number of sessions that exist (finished ones included until deleted).
+      */
+     std::size_t SessionCount() const;
+ 
+     /**
+      * @brief Caps the distinct user and computer names sessions may use.
+      *
+      * Names already accepted stay usable when the cap is lowered below
+      * their number. The default is kMaxDistinctNames.
+      */
+     void SetMaxDistinctNames(std::size_t limit);
+ 
+     /**
+      * @brief Number of distinct names accepted so far.
+      */
+     std::size_t DistinctNameCount() const;
+ 
+     void OnRound(const RoundRecord& record) override;
+     void OnSessionEnd(const SessionSummary& summary) override;
+ 
+ private:
+     struct Session;
+ 
+     int CreateSession(const HttpRequest& request, std::string& body);
+     bool AdmitNames(std::string_view user, std::string_view computer);
+     int PlayMove(Session& session, const HttpRequest& request, std::string& body);
+     static void WriteStatus(const Session& session, std::string& body);
+     static int Error(int status, std::string_view message, std::string& body);
+ 
+     GameSessionFactory& m_factory;
+     GameMode m_mode {};
+     IRoundObserver* m_next {};
+     // No "{}": a default member initializer would need Session to be complete here.
+     std::unordered_map<std::uint64_t, std::unique_ptr<Session>> m_sessions;
+     std::uint64_t m_nextId {1};
+ 
+     /**
+      * @brief Every name a session was created with; bounds NameInterner growth.
+      */
+     std::unordered_set<std::string> m_names {};
+     std::size_t m_maxDistinctNames {kMaxDistinctNames};
+ 
+     /**
+      * @brief Set while a creator runs.
+      */
+     HttpSessionSetup* m_pending {};
+ 
+     /**
+      * @brief The session whose round is being played; receives OnRound().
+      */
+     Session* m_playing {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,76 @@
+/**
+ * @file HttpLoadGenerator.hpp
+ * @brief Declares the HttpLoadGenerator class.
+ *
+ * HttpLoadGenerator drives the game API over keep-alive connections to
+ * measure request throughput. Each connection creates one long session and
+ * then keeps `pipelineDepth` move requests in flight: it writes a batch in
+ * one send(), waits until every response of the batch has arrived and
+ * sends the next. A depth of 1 is plain request/response keep-alive.
+ *
+ * All connections are multiplexed with epoll on the calling thread. The
+ * batches are built once per connection, so the generator itself does not
+ * allocate while measuring.
+ */
+
+ #pragma once
+
+ #include <chrono>
+ #include <cstdint>
+ #include <string>
+ 
+ struct HttpLoadOptions {
+     std::string address {"127.0.0.1"};
+     std::uint16_t port {};
+     int connections {16};
+ 
+     /**
+      * @brief Requests written back to back before waiting for responses.
+      */
+     int pipelineDepth {16};
+     std::chrono::milliseconds duration {2000};
+ 
+     /**
+      * @brief Length of each connection's session; must outlast the run.
+      */
+     int roundsPerSession {10000000};
+ };
+ 
+ struct HttpLoadReport {
+     std::uint64_t requests {};
+ 
+     /**
+      * @brief Responses with a status other than 2xx.
+      */
+     std::uint64_t failures {};
+     double seconds {};
+ 
+     /**
+      * @brief Mean time from sending a batch to its last response, in microseconds.
+      */
+     double meanBatchMicros {};
+ 
+     double RequestsPerSecond() const;
+ };
+ 
+ /**
+  * @brief Generates pipelined keep-alive load against an HttpServer.
+  */
+ class HttpLoadGenerator {
+ public:
+     /**
+      * @throws std::invalid_argument if a count is not positive or the address is not IPv4.
+      */
+     explicit HttpLoadGenerator(HttpLoadOptions options);
+ 
+     /**
+      * @brief Connects, creates the sessions and runs for the configured duration.
+      * @throws std::system_error if a connection fails.
+      * @throws std::runtime_error if the server answers something unexpected.
+      */
+     HttpLoadReport Run();
+ 
+ private:
+     HttpLoadOptions m_options {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,104 @@
+/**
+ * @file HttpRequestParser.hpp
+ * @brief Declares the HttpRequestParser class and the HttpRequest it fills.
+ *
+ * HttpRequestParser reads one HTTP/1.0 or HTTP/1.1 request from the front
+ * of a receive buffer without allocating: the method, target, header
+ * names and values and the body are string_views into that buffer, and at
+ * most kMaxHeaders headers are kept in a fixed array. Parsing is
+ * stateless; an incomplete request is simply parsed again once more bytes
+ * have arrived. Several pipelined requests in one buffer are taken one at
+ * a time, each call reporting how many bytes its request used.
+ *
+ * Only Content-Length bodies are supported; a request with
+ * Transfer-Encoding is rejected as Invalid.
+ */
+
+ #pragma once
+
+ #include <array>
+ #include <cstddef>
+ #include <string_view>
+ 
+ /**
+  * @brief One header field; both views point into the parsed buffer.
+  */
+ struct HttpHeader {
+     std::string_view name {};
+     std::string_view value {};
+ };
+ 
+ /**
+  * @brief A parsed request. Valid only while the parsed buffer is unchanged.
+  */
+ struct HttpRequest {
+     static constexpr std::size_t kMaxHeaders {32};
+ 
+     std::string_view method {};
+     std::string_view target {};
+ 
+     /**
+      * @brief 0 for HTTP/1.0, 1 for HTTP/1.1.
+      */
+     int minorVersion {};
+ 
+     std::array<HttpHeader, kMaxHeaders> headers {};
+     std::size_t headerCount {};
+     std::string_view body {};
+ 
+     /**
+      * @brief Whether the connection stays open after the response:
+      *        HTTP/1.1 unless "Connection: close", HTTP/1.0 only with
+      *        "Connection: keep-alive".
+      */
+     bool keepAlive {};
+ 
+     /**
+      * @brief Returns the first header named `name` (case-insensitive), or an empty view.
+      */
+     std::string_view Header(std::string_view name) const;
+ };
+ 
+ /**
+  * @brief Parses requests out of a receive buffer.
+  */
+ class HttpRequestParser {
+ public:
+     enum class Result
+     {
+         /**
+          * @brief A whole request was parsed.
+          */
+         Complete,
+ 
+         /**
+          * @brief The buffer ends inside the request; parse again with more bytes.
+          */
+         Incomplete,
+ 
+         /**
+          * @brief The bytes are not a request this parser accepts.
+          */
+         Invalid,
+ 
+         /**
+          * @brief The header block or the body exceeds its limit.
+          */
+         TooLarge
+     };
+ 
+     /**
+      * @brief Largest header block, request line included.
+      */
+     static constexpr std::size_t kMaxHeaderBytes {8192};
+     static constexpr std::size_t kMaxBodyBytes {65536};
+ 
+     /**
+      * @brief Parses the request at the start of `buffer`.
+      * @param buffer   Received bytes, possibly holding several requests.
+      * @param request  Filled in on Complete.
+      * @param consumed Set to the request's size on Complete.
+      */
+     static Result Parse(std::string_view buffer, HttpRequest& request, std::size_t& consumed);
+ };
+ 
\ No newline at end of file
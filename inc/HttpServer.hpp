@@ -0,0 +1,159 @@
+/**
+ * @file HttpServer.hpp
+ * @brief Declares the HttpServer class.
+ *
+ * HttpServer is a small embedded HTTP/1.1 server for local game clients.
+ * One thread runs an epoll loop over a listening TCP socket and its
+ * connections. Connections are persistent (keep-alive) and may pipeline:
+ * every complete request in a receive buffer is parsed in place by
+ * HttpRequestParser and handled in order, and all of their responses go
+ * out in a single send(). Receive and send buffers belong to the
+ * connection and are reused, so a steady request stream does not allocate
+ * once the buffers have grown to size.
+ *
+ * A connection whose responses pile up beyond maxPendingOutput stops
+ * being read until the client catches up.
+ */
+
+ #pragma once
+
+ #include "HttpRequestParser.hpp"
+ #include <atomic>
+ #include <cstddef>
+ #include <cstdint>
+ #include <functional>
+ #include <memory>
+ #include <string>
+ #include <string_view>
+ #include <vector>
+ 
+ /**
+  * @brief Handles one request: fills `body` with JSON and returns the status.
+  */
+ using HttpHandler = std::function<int(const HttpRequest& request, std::string& body)>;
+ 
+ struct HttpServerOptions {
+     /**
+      * @brief IPv4 address to listen on.
+      */
+     std::string address {"127.0.0.1"};
+ 
+     /**
+      * @brief 0 picks a free port; see HttpServer::Port().
+      */
+     std::uint16_t port {};
+     int backlog {512};
+ 
+     /**
+      * @brief Unsent response bytes at which a connection stops being read.
+      */
+     std::size_t maxPendingOutput {std::size_t{1} << 20};
+ };
+ 
+ /**
+  * @brief Counters describing the server since it was created.
+  */
+ struct HttpServerStats {
+     std::uint64_t connections {};
+     std::uint64_t requests {};
+ 
+     /**
+      * @brief Requests answered with 400 or 413 and a closed connection.
+      */
+     std::uint64_t rejected {};
+     std::uint64_t recvCalls {};
+     std::uint64_t sendCalls {};
+ };
+ 
+ /**
+  * @brief Serves HTTP/1.1 requests from one event-loop thread.
+  */
+ class HttpServer {
+ public:
+     /**
+      * @brief Binds and listens; requests are served once Run() is called.
+      * @throws std::invalid_argument if the address is not an IPv4 address.
+      * @throws std::system_error if the socket or event loop cannot be set up.
+      */
+     explicit HttpServer(HttpHandler handler, HttpServerOptions options = {});
+ 
+     /**
+      * @brief Closes the listening socket and every connection.
+      */
+     ~HttpServer();
+ 
+     HttpServer(const HttpServer&) = delete;
+     HttpServer& operator=(const HttpServer&) = delete;
+ 
+     /**
+      * @brief The port actually listened on.
+      */
+     std::uint16_t Port() const;
+ 
+     /**
+      * @brief Serves requests on the calling thread until Stop() is called.
+      * @throws std::system_error if the event loop fails.
+      */
+     void Run();
+ 
+     /**
+      * @brief Makes Run() return soon. Safe to call from any thread.
+      */
+     void Stop();
+ 
+     HttpServerStats Stats() const;
+ 
+     /**
+      * @brief Appends a complete response with a JSON body to `out`.
+      * @param keepAlive    False adds "Connection: close".
+      * @param minorVersion 0 for an HTTP/1.0 request, whose keep-alive must be confirmed.
+      */
+     static void AppendResponse(std::string& out, int status, std::string_view body, bool keepAlive,
+                                int minorVersion = 1);
+ 
+ private:
+     struct Connection;
+ 
+     void Accept();
+     void OnReadable(Connection& connection);
+     void OnWritable(Connection& connection);
+ 
+     /**
+      * @brief Handles every complete request in the receive buffer.
+      */
+     void HandleRequests(Connection& connection);
+     void Flush(Connection& connection);
+     void UpdateInterest(Connection& connection);
+ 
+     /**
+      * @brief Deregisters now; the socket is closed after the current batch of events.
+      */
+     void Close(Connection& connection);
+     void ReleaseClosed();
+ 
+     HttpHandler m_handler {};
+     HttpServerOptions m_options {};
+     int m_listenFd {-1};
+     int m_epollFd {-1};
+     int m_wakeFd {-1};
+     std::uint16_t m_port {};
+     std::atomic<bool> m_stopping {false};
+ 
+     /**
+      * @brief Connections indexed by socket descriptor.
+      */
+     std::vector<std::unique_ptr<Connection>> m_connections {};
+     std::vector<int> m_closed {};
+ 
+     /**
+      * @brief Response body scratch, reused for every request.
+      */
+     std::string m_body {};
+ 
+     std::atomic<std::uint64_t> m_connectionCount {};
+     std::atomic<std::uint64_t> m_requests {};
+     std::atomic<std::uint64_t> m_rejected {};
+     std::atomic<std::uint64_t> m_recvCalls {};
+     std::atomic<std::uint64_t> m_sendCalls {};
+ };
+ 
\ No newline at end of file
@@ -9,6 +9,7 @@
 
  #pragma once
 
+ #include <cstddef>
  #include <memory>
  #include <string>
  #include "IPlayer.hpp"
@@ -58,6 +59,27 @@
       */
      virtual int RequestMoveChoice() = 0;
  
+     /**
+      * @brief Requests up to maxCount upcoming move choices in one call.
+      *
+      * Backends that can deliver several moves per exchange (network, scripted,
+      * bot) override this to fill the buffer in one round trip. The default
+      * asks for a single move through RequestMoveChoice(), so interactive
+      * backends such as the console keep their one-prompt-per-round behaviour.
+      *
+      * @param moves     Buffer receiving the choices, in round order, with the
+      *                  same encoding as RequestMoveChoice().
+      * @param maxCount  Capacity of the buffer; never more than the rounds left.
+      * @return The number of choices written (at least 1 when maxCount > 0).
+      */
+     virtual std::size_t RequestMoveChoices(int* moves, std::size_t maxCount) {
+         if (maxCount == 0) {
+             return 0;
+         }
+         moves[0] = RequestMoveChoice();
+         return 1;
+     }
+ 
      /**
       * @brief Displays the chosen move for a participant.
       * @param player The player who made the move.
@@ -0,0 +1,47 @@
+/**
+ * @file IMoveStrategy.hpp
+ * @brief Declares the IMoveStrategy interface.
+ *
+ * An IMoveStrategy decides which move to play next, optionally based on
+ * how previous rounds went. Strategies drive automated participants:
+ * bots in the arena, headless simulations and computer opponents.
+ */
+
+ #pragma once
+
+ #include "GameMove.hpp"
+ 
+ /**
+  * @brief Chooses moves for an automated participant.
+  */
+ class IMoveStrategy {
+ public:
+     /**
+      * @brief Virtual destructor for safe polymorphic cleanup.
+      */
+     virtual ~IMoveStrategy() = default;
+ 
+     /**
+      * @brief Chooses the move for the next round.
+      * @return The move to play.
+      */
+     virtual GameMove NextMove() = 0;
+ 
+     /**
+      * @brief Informs the strategy of a completed round.
+      * @param ownMove      The move this strategy played.
+      * @param opponentMove The move the opponent played.
+      */
+     virtual void ObserveRound(GameMove ownMove, GameMove opponentMove) = 0;
+ 
+     /**
+      * @brief Tells whether NextMove() depends on observed rounds.
+      *
+      * Strategies that ignore history may have several upcoming moves
+      * requested at once, before the corresponding rounds are observed.
+      *
+      * @return True if moves must be chosen one round at a time.
+      */
+     virtual bool DependsOnHistory() const = 0;
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,88 @@
+/**
+ * @file INetworkBackend.hpp
+ * @brief Declares the INetworkBackend interface.
+ *
+ * An INetworkBackend moves bytes between a single-threaded host and many
+ * connected stream sockets. The host adds sockets, queues outgoing bytes
+ * with Send() and calls Poll(), which pushes everything queued to the
+ * kernel, waits for input and hands each chunk received to a callback.
+ *
+ * How that costs in system calls is up to the implementation:
+ * EpollNetworkBackend pays for a wait plus a recv() and a send() per busy
+ * connection, IoUringNetworkBackend submits every send and collects every
+ * receive in one io_uring_enter() per Poll(). NetworkBackendFactory picks one.
+ */
+
+ #pragma once
+
+ #include <cstddef>
+ #include <cstdint>
+ #include <functional>
+ 
+ /**
+  * @brief Multiplexes many stream sockets for one host thread.
+  *
+  * Connections are identified by small integers, reused after Remove().
+  * All members must be called from the same thread; the callback may call
+  * Send() and Remove().
+  */
+ class INetworkBackend {
+ public:
+     using ConnectionId = std::uint32_t;
+ 
+     /**
+      * @brief Receives `size` bytes read from `connection`; `size` 0 means
+      *        end of stream or a socket error.
+      *
+      * The bytes are only valid during the call. After a size-0 call the
+      * host must Remove() the connection.
+      */
+     using ReceiveHandler = std::function<void(ConnectionId connection, const std::uint8_t* data, std::size_t size)>;
+ 
+     virtual ~INetworkBackend() = default;
+ 
+     /**
+      * @brief Short name of the implementation, e.g. "epoll".
+      */
+     virtual const char* Name() const = 0;
+ 
+     /**
+      * @brief Starts watching a connected stream socket.
+      *
+      * The backend takes ownership of `socketFd`, sets the blocking mode it
+      * needs and closes it once the connection is removed.
+      */
+     virtual ConnectionId Add(int socketFd) = 0;
+ 
+     /**
+      * @brief Queues bytes for `connection`; they go out during the next Poll().
+      *
+      * Bytes queued for one connection are delivered in order.
+      */
+     virtual void Send(ConnectionId connection, const std::uint8_t* data, std::size_t size) = 0;
+ 
+     /**
+      * @brief Stops receiving from `connection` and closes it once what was
+      *        already queued for it has been sent (best effort).
+      */
+     virtual void Remove(ConnectionId connection) = 0;
+ 
+     /**
+      * @brief Sends what is queued, then waits up to `timeoutMs` (-1: no
+      *        limit) for input and passes everything received to `handler`.
+      * @return The number of handler calls made.
+      */
+     virtual std::size_t Poll(const ReceiveHandler& handler, int timeoutMs) = 0;
+ 
+     /**
+      * @brief True when nothing queued is waiting for Poll() and every
+      *        removed connection has been closed.
+      */
+     virtual bool Idle() const = 0;
+ 
+     /**
+      * @brief System calls made so far, for comparing backends.
+      */
+     virtual std::uint64_t SyscallCount() const = 0;
+ };
+ 
\ No newline at end of file
@@ -9,6 +9,7 @@
 
  #pragma once
  #include <string>
+ #include <string_view>
  
  /**
   * @brief Represents a participant in the game (human or computer).
@@ -26,6 +27,12 @@
       */
      virtual std::string GetName() const = 0;
  
+     /**
+      * @brief Retrieves the player's name without copying it.
+      * @return A view of the name, valid for as long as the player exists.
+      */
+     virtual std::string_view GetNameView() const = 0;
+ 
      /**
       * @brief Retrieves the player's current score.
       * @return The score as an integer.
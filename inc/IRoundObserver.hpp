@@ -0,0 +1,87 @@
+/**
+ * @file IRoundObserver.hpp
+ * @brief Declares the IRoundObserver interface and the RoundRecord it receives.
+ *
+ * Sessions and simulators report every finished round, and the end of
+ * every session, to an optional IRoundObserver, which lets exporters and
+ * analytics collect per-round data without going through the
+ * human-facing IGameMessenger.
+ */
+
+ #pragma once
+
+ #include <cstdint>
+ #include <string_view>
+ 
+ /**
+  * @brief How a round ended, from the user's point of view.
+  */
+ enum class RoundOutcome : std::uint8_t
+ {
+     Draw = 0,
+     UserWin = 1,
+     ComputerWin = 2,
+     Forfeit = 3
+ };
+ 
+ /**
+  * @brief Everything known about one finished round.
+  *
+  * The name views are only valid for the duration of the OnRound() call.
+  */
+ struct RoundRecord {
+     std::uint64_t sessionId {};
+ 
+     /**
+      * @brief 1-based round number within the session.
+      */
+     std::uint32_t round {};
+ 
+     /**
+      * @brief GameMove values; 0 for a move that was invalid or missing.
+      */
+     std::uint8_t userMove {};
+     std::uint8_t computerMove {};
+ 
+     RoundOutcome outcome {};
+     std::string_view userName {};
+     std::string_view computerName {};
+ 
+     /**
+      * @brief Time spent obtaining both moves, in nanoseconds (0 if not measured).
+      */
+     std::uint64_t decisionNanos {};
+ };
+ 
+ /**
+  * @brief A finished session, as reported after its last round.
+  *
+  * The name views are only valid for the duration of the OnSessionEnd() call.
+  */
+ struct SessionSummary {
+     std::uint64_t sessionId {};
+     std::uint32_t rounds {};
+     std::string_view userName {};
+     std::string_view computerName {};
+ };
+ 
+ /**
+  * @brief Receives a RoundRecord after every round.
+  */
+ class IRoundObserver {
+ public:
+     virtual ~IRoundObserver() = default;
+ 
+     /**
+      * @brief Called once per round, after the round has been scored.
+      */
+     virtual void OnRound(const RoundRecord& record) = 0;
+ 
+     /**
+      * @brief Called once per session, after its last OnRound().
+      *
+      * Observers that only care about single rounds need not override it.
+      */
+     virtual void OnSessionEnd(const SessionSummary&) {}
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,164 @@
+/**
+ * @file InlineFunction.hpp
+ * @brief Declares the InlineFunction class template.
+ *
+ * InlineFunction is a copyable, type-erased callable wrapper similar to
+ * std::function, except that the callable is always stored in a fixed-size
+ * buffer inside the wrapper. Constructing, copying, invoking and destroying
+ * an InlineFunction never touches the heap; a callable that does not fit is
+ * rejected at compile time.
+ */
+
+ #pragma once
+
+ #include <cstddef>
+ #include <new>
+ #include <type_traits>
+ #include <utility>
+ 
+ template <typename Signature, std::size_t Capacity>
+ class InlineFunction;
+ 
+ /**
+  * @brief Small-buffer-only callable wrapper for signature R(Args...).
+  * @tparam Capacity Size in bytes of the inline storage.
+  *
+  * The stored callable is invoked through a const reference, so it must be
+  * callable as const (as plain lambdas are) and may be invoked concurrently.
+  */
+ template <typename R, typename... Args, std::size_t Capacity>
+ class InlineFunction<R(Args...), Capacity> {
+ public:
+     /**
+      * @brief Constructs an empty wrapper.
+      */
+     InlineFunction() noexcept = default;
+ 
+     /**
+      * @brief Constructs an empty wrapper.
+      */
+     InlineFunction(std::nullptr_t) noexcept {}
+ 
+     /**
+      * @brief Stores a copy of the given callable in the inline buffer.
+      * @param callable Any const-invocable object returning something convertible to R.
+      */
+     template <typename F,
+               typename Stored = std::decay_t<F>,
+               typename = std::enable_if_t<!std::is_same<Stored, InlineFunction>::value &&
+                                           std::is_invocable_r<R, const Stored&, Args...>::value>>
+     InlineFunction(F&& callable)
+     {
+         static_assert(sizeof(Stored) <= Capacity,
+                       "Callable is too large for the InlineFunction buffer");
+         static_assert(alignof(Stored) <= alignof(std::max_align_t),
+                       "Callable is over-aligned for the InlineFunction buffer");
+         static_assert(std::is_copy_constructible<Stored>::value,
+                       "InlineFunction requires a copyable callable");
+         static_assert(std::is_nothrow_move_constructible<Stored>::value,
+                       "InlineFunction moves are noexcept, so the callable's move must be too");
+ 
+         ::new (static_cast<void*>(m_storage)) Stored(std::forward<F>(callable));
+         m_ops = &kOpsFor<Stored>;
+     }
+ 
+     InlineFunction(const InlineFunction& other)
+     {
+         if (other.m_ops) {
+             other.m_ops->copy(m_storage, other.m_storage);
+             m_ops = other.m_ops;
+         }
+     }
+ 
+     InlineFunction(InlineFunction&& other) noexcept
+     {
+         if (other.m_ops) {
+             other.m_ops->move(m_storage, other.m_storage);
+             m_ops = other.m_ops;
+             other.Reset();
+         }
+     }
+ 
+     InlineFunction& operator=(const InlineFunction& other)
+     {
+         if (this != &other) {
+             InlineFunction copy{other};
+             *this = std::move(copy);
+         }
+         return *this;
+     }
+ 
+     InlineFunction& operator=(InlineFunction&& other) noexcept
+     {
+         if (this != &other) {
+             Reset();
+             if (other.m_ops) {
+                 other.m_ops->move(m_storage, other.m_storage);
+                 m_ops = other.m_ops;
+                 other.Reset();
+             }
+         }
+         return *this;
+     }
+ 
+     ~InlineFunction()
+     {
+         Reset();
+     }
+ 
+     /**
+      * @brief Invokes the stored callable. The wrapper must not be empty.
+      */
+     R operator()(Args... args) const
+     {
+         return m_ops->invoke(m_storage, std::forward<Args>(args)...);
+     }
+ 
+     /**
+      * @brief Returns true if a callable is stored.
+      */
+     explicit operator bool() const noexcept
+     {
+         return m_ops != nullptr;
+     }
+ 
+ private:
+     /**
+      * @brief Per-type operation table; one static instance per stored type.
+      */
+     struct Ops {
+         R (*invoke)(const void* storage, Args&&... args);
+         void (*copy)(void* destination, const void* source);
+         void (*move)(void* destination, void* source);
+         void (*destroy)(void* storage);
+     };
+ 
+     template <typename F>
+     static constexpr Ops kOpsFor {
+         [](const void* storage, Args&&... args) -> R {
+             return (*static_cast<const F*>(storage))(std::forward<Args>(args)...);
+         },
+         [](void* destination, const void* source) {
+             ::new (destination) F(*static_cast<const F*>(source));
+         },
+         [](void* destination, void* source) {
+             ::new (destination) F(std::move(*static_cast<F*>(source)));
+         },
+         [](void* storage) {
+             static_cast<F*>(storage)->~F();
+         }
+     };
+ 
+     void Reset() noexcept
+     {
+         if (m_ops) {
+             m_ops->destroy(m_storage);
+             m_ops = nullptr;
+         }
+     }
+ 
+ private:
+     alignas(std::max_align_t) unsigned char m_storage[Capacity] {};
+     const Ops* m_ops {nullptr};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,185 @@
+/**
+ * @file IoUringNetworkBackend.hpp
+ * @brief Declares the IoUringNetworkBackend class.
+ *
+ * IoUringNetworkBackend is the completion-based INetworkBackend. It talks
+ * to the kernel through the raw io_uring system calls and shared rings:
+ *
+ * - Receives: each connection has one multishot recv armed. The kernel
+ *   picks a buffer from a provided-buffer ring, fills it and posts a
+ *   completion naming it, without the recv being resubmitted; the buffer
+ *   goes back into the ring once the handler has seen it.
+ * - Sends: every connection owns a slot of one send arena that is
+ *   registered with the ring, so writes use IORING_OP_WRITE_FIXED and the
+ *   kernel does not pin and map the pages per call.
+ * - Poll(): all writes queued since the last call are submitted, and
+ *   completions waited for, by a single io_uring_enter().
+ *
+ * Construction throws std::system_error when the kernel lacks io_uring or
+ * a feature used here (provided-buffer rings need Linux 5.19); recv falls
+ * back to one-shot mode if multishot recv (Linux 6.0) is refused.
+ */
+
+ #pragma once
+
+ #include "INetworkBackend.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ #include <vector>
+ 
+ struct io_uring_sqe;
+ struct io_uring_cqe;
+ struct io_uring_buf;
+ 
+ /**
+  * @brief Sizes of the rings and buffers of an IoUringNetworkBackend.
+  */
+ struct IoUringOptions {
+     /**
+      * @brief Submission queue entries; the completion queue gets four times as many.
+      */
+     unsigned queueDepth {1024};
+ 
+     /**
+      * @brief Connections that can be open at once; each owns a send slot.
+      */
+     std::size_t maxConnections {4096};
+ 
+     /**
+      * @brief Bytes per send slot: the most a connection can have queued or in flight.
+      */
+     std::size_t sendSlotSize {1024};
+ 
+     /**
+      * @brief Receive buffers in the provided-buffer ring; a power of two.
+      */
+     unsigned receiveBuffers {1024};
+     std::size_t receiveBufferSize {4096};
+ };
+ 
+ /**
+  * @brief An INetworkBackend built on io_uring.
+  */
+ class IoUringNetworkBackend : public INetworkBackend {
+ public:
+     explicit IoUringNetworkBackend(IoUringOptions options = {});
+     ~IoUringNetworkBackend() override;
+ 
+     IoUringNetworkBackend(const IoUringNetworkBackend&) = delete;
+     IoUringNetworkBackend& operator=(const IoUringNetworkBackend&) = delete;
+ 
+     const char* Name() const override;
+     ConnectionId Add(int socketFd) override;
+ 
+     /**
+      * @throws std::length_error if the connection's send slot cannot hold `size` more bytes.
+      */
+     void Send(ConnectionId connection, const std::uint8_t* data, std::size_t size) override;
+     void Remove(ConnectionId connection) override;
+     std::size_t Poll(const ReceiveHandler& handler, int timeoutMs) override;
+     bool Idle() const override;
+     std::uint64_t SyscallCount() const override;
+ 
+     /**
+      * @brief False once the kernel refused multishot recv and receives are re-armed per completion.
+      */
+     bool UsesMultishotReceive() const;
+ 
+ private:
+     struct Connection {
+         int fd {-1};
+         bool open {};
+ 
+         /**
+          * @brief Removed by the host; the slot is freed once no operation is pending.
+          */
+         bool closing {};
+         bool ended {};
+         bool receiveArmed {};
+         bool cancelQueued {};
+ 
+         /**
+          * @brief The send slot holds `inFlight` bytes being written, then
+          *        `queued` bytes waiting for that write to finish.
+          */
+         std::size_t inFlight {};
+         std::size_t queued {};
+         bool dirty {};
+     };
+ 
+     /**
+      * @brief Operation kinds, kept in the low bits of a completion's user data.
+      */
+     enum class Operation : std::uint64_t
+     {
+         Receive = 1,
+         Write = 2,
+         Cancel = 3
+     };
+ 
+     io_uring_sqe* NextSqe();
+     void Enter(unsigned waitFor, int timeoutMs);
+     void ArmReceive(ConnectionId connection);
+     void StartWrite(ConnectionId connection);
+     void QueueCancel(ConnectionId connection);
+     std::uint8_t* SendSlot(ConnectionId connection);
+     void AddBuffer(std::uint16_t bufferId);
+     void RecycleBuffer(std::uint16_t bufferId);
+ 
+     /**
+      * @brief Closes the socket and frees the id once nothing refers to it.
+      */
+     void ReleaseIfIdle(ConnectionId connection);
+ 
+     /**
+      * @brief Unmaps the rings and closes the ring descriptor; safe on a partly built ring.
+      */
+     void CloseRing();
+ 
+ private:
+     IoUringOptions m_options {};
+     int m_ringFd {-1};
+     bool m_multishot {true};
+ 
+     // Submission ring, shared with the kernel.
+     void* m_sqRing {};
+     std::size_t m_sqRingSize {};
+     unsigned* m_sqHead {};
+     unsigned* m_sqTail {};
+     unsigned m_sqMask {};
+     unsigned m_sqEntries {};
+     unsigned* m_sqArray {};
+     io_uring_sqe* m_sqes {};
+     std::size_t m_sqesSize {};
+     unsigned m_sqLocalTail {};
+     unsigned m_toSubmit {};
+ 
+     // Completion ring, in the same mapping.
+     unsigned* m_cqHead {};
+     unsigned* m_cqTail {};
+     unsigned m_cqMask {};
+     io_uring_cqe* m_cqes {};
+ 
+     // Provided receive buffers. The ring's tail overlays the reserved
+     // field of its first entry.
+     io_uring_buf* m_bufferRing {};
+     std::size_t m_bufferRingSize {};
+     std::vector<std::uint8_t> m_receiveArena {};
+     std::uint16_t m_bufferTail {};
+ 
+     /**
+      * @brief Registered with the ring as fixed buffer 0; one slot per connection.
+      */
+     std::vector<std::uint8_t> m_sendArena {};
+ 
+     std::vector<Connection> m_connections {};
+     std::vector<ConnectionId> m_free {};
+     std::vector<ConnectionId> m_dirty {};
+ 
+     /**
+      * @brief Removed connections not yet released.
+      */
+     std::size_t m_closing {};
+     std::uint64_t m_syscalls {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,109 @@
+/**
+ * @file MatchDistribution.hpp
+ * @brief Declares the MatchDistribution class.
+ *
+ * MatchDistribution computes, without simulation, the distribution of the
+ * final margin (user round wins minus computer round wins) of a match in
+ * which both sides play fixed mixed strategies every round. Each round
+ * moves the margin by +1, 0 or -1 with the same probabilities, so the
+ * margin after a + b rounds is the convolution of the margins after a and
+ * after b rounds. N rounds are therefore built by doubling, in O(log N)
+ * convolutions over the score difference rather than N round-by-round
+ * steps; the convolution's inner loop is a contiguous multiply-add that
+ * the compiler vectorizes.
+ *
+ * Margins whose probability falls below kCutoff are dropped as they
+ * appear; their total is reported as truncatedMass, a bound on the error
+ * beyond floating-point rounding. This keeps the work proportional to the
+ * margins that matter, about 20 standard deviations wide.
+ *
+ * Because the result is exact for stationary strategies, it is the
+ * reference that SimulationRunner's "random", "rock", "paper" and
+ * "scissors" campaigns can be checked against.
+ */
+
+ #pragma once
+
+ #include <array>
+ #include <cstdint>
+ #include <optional>
+ #include <string_view>
+ #include <vector>
+ 
+ /**
+  * @brief Probabilities of Rock, Paper and Scissors, indexed move - 1.
+  */
+ using MixedStrategy = std::array<double, 3>;
+ 
+ /**
+  * @brief Exact distribution of a match's final margin.
+  */
+ class MatchDistribution {
+ public:
+     /**
+      * @brief Margin probabilities below this are dropped into truncatedMass.
+      */
+     static constexpr double kCutoff {1e-30};
+ 
+     /**
+      * @brief Computes the distribution for `rounds` rounds.
+      * @throws std::invalid_argument if a strategy has a negative or
+      *         non-finite entry, or its entries do not sum to 1.
+      */
+     static MatchDistribution Compute(const MixedStrategy& user, const MixedStrategy& computer,
+                                      std::uint32_t rounds);
+ 
+     /**
+      * @brief The mixed strategy of a stationary built-in strategy
+      *        ("rock", "paper", "scissors" or "random"), if `name` is one.
+      */
+     static std::optional<MixedStrategy> ForStrategy(std::string_view name);
+ 
+     std::uint32_t Rounds() const;
+ 
+     /**
+      * @brief Per-round probabilities of a user win, a draw and a computer win.
+      */
+     double RoundWinProbability() const;
+     double RoundDrawProbability() const;
+     double RoundLossProbability() const;
+ 
+     /**
+      * @brief P(margin == `margin`); 0 outside the kept range.
+      */
+     double Probability(std::int64_t margin) const;
+ 
+     /**
+      * @brief Smallest margin kept; Probabilities()[i] is P(margin == LowestMargin() + i).
+      */
+     std::int64_t LowestMargin() const;
+     const std::vector<double>& Probabilities() const;
+ 
+     /**
+      * @brief Match outcome probabilities: margin above, at and below 0.
+      */
+     double UserWinProbability() const;
+     double DrawProbability() const;
+     double ComputerWinProbability() const;
+ 
+     /**
+      * @brief Exact mean and variance of the margin.
+      */
+     double MeanMargin() const;
+     double MarginVariance() const;
+ 
+     /**
+      * @brief Total probability of the dropped margins.
+      */
+     double TruncatedMass() const;
+ 
+ private:
+     std::uint32_t m_rounds {};
+     double m_win {};
+     double m_draw {};
+     double m_loss {};
+     std::int64_t m_lowest {};
+     std::vector<double> m_probabilities {};
+     double m_truncated {};
+ };
+ 
\ No newline at end of file
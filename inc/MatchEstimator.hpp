@@ -0,0 +1,150 @@
+/**
+ * @file MatchEstimator.hpp
+ * @brief Declares the MatchEstimator class.
+ *
+ * MatchEstimator answers "how often does strategy A win a match of R rounds
+ * against B?" by Monte Carlo, to a requested precision rather than for a
+ * fixed number of matches. Matches are played by SimulationRunner's round
+ * kernel, so match i is exactly match i of a campaign with the same seed.
+ *
+ * Matches run in waves, each split across threads by match index; every
+ * count is an integer, so an estimate does not depend on the thread count.
+ * After each wave (a "look") the interval is checked and the estimator
+ * stops once its half-width is small enough. Looking repeatedly would
+ * overstate the confidence, so the error budget alpha = 1 - confidence is
+ * split between the looks: the first, a pilot of minMatches, gets
+ * alpha / 8, and look k > 1 gets (7 alpha / 8) * 6 / (pi^2 (k - 1)^2). The
+ * shares sum to alpha, so the final interval holds at the requested level
+ * however many looks it took. Each wave is sized from the current estimate
+ * to reach the target at the next look, so most runs stop at look 2.
+ *
+ * Comparing two strategies against one opponent uses common random
+ * numbers by default: match i of both pairings gets the same streams, so
+ * luck shared by the pairings cancels out of the difference.
+ */
+
+ #pragma once
+
+ #include <cstdint>
+ #include <string>
+ 
+ struct MatchEstimatorOptions {
+     std::uint32_t roundsPerMatch {21};
+     std::uint64_t masterSeed {};
+ 
+     /**
+      * @brief Probability that the final interval holds the true value.
+      */
+     double confidence {0.95};
+ 
+     /**
+      * @brief Stop once the interval's half-width is at most this.
+      */
+     double halfWidth {0.01};
+ 
+     /**
+      * @brief Size of the first wave.
+      */
+     std::uint64_t minMatches {1000};
+ 
+     /**
+      * @brief Stop here even if the interval is still too wide.
+      */
+     std::uint64_t maxMatches {std::uint64_t{1} << 26};
+ 
+     /**
+      * @brief 0 uses every hardware thread.
+      */
+     unsigned threads {};
+ 
+     /**
+      * @brief Pair the matches of a comparison; false gives the second pairing its own seed.
+      */
+     bool commonRandomNumbers {true};
+ };
+ 
+ /**
+  * @brief One strategy's match win probability against another.
+  */
+ struct WinEstimate {
+     std::uint64_t matches {};
+     std::uint64_t wins {};
+     std::uint64_t losses {};
+     std::uint64_t draws {};
+     double winProbability {};
+ 
+     /**
+      * @brief Wilson score interval at the final look's critical value.
+      */
+     double lower {};
+     double upper {};
+     int looks {};
+ 
+     /**
+      * @brief False if maxMatches was reached first.
+      */
+     bool converged {};
+     double seconds {};
+ };
+ 
+ /**
+  * @brief The difference between two strategies' win probabilities against one opponent.
+  */
+ struct WinDifference {
+     std::uint64_t matches {};
+     double firstWinProbability {};
+     double secondWinProbability {};
+ 
+     /**
+      * @brief First minus second, with its normal interval.
+      */
+     double difference {};
+     double lower {};
+     double upper {};
+ 
+     /**
+      * @brief Variance two independent samples would have, over the variance observed.
+      *
+      * How many times more matches the comparison would need without
+      * pairing; about 1 when the pairings are independent, infinite when
+      * they never differ.
+      */
+     double varianceReduction {};
+     int looks {};
+     bool converged {};
+     double seconds {};
+ };
+ 
+ /**
+  * @brief Estimates match outcomes between built-in strategies with a sequential stopping rule.
+  */
+ class MatchEstimator {
+ public:
+     /**
+      * @throws std::invalid_argument if an option is out of range.
+      */
+     explicit MatchEstimator(MatchEstimatorOptions options = {});
+ 
+     /**
+      * @brief Estimates how often `user` wins a match against `computer`.
+      * @throws std::invalid_argument if a strategy name is unknown.
+      */
+     WinEstimate EstimateWin(const std::string& user, const std::string& computer) const;
+ 
+     /**
+      * @brief Estimates how much more often `first` wins against `opponent` than `second` does.
+      * @throws std::invalid_argument if a strategy name is unknown.
+      */
+     WinDifference CompareWin(const std::string& first, const std::string& second,
+                              const std::string& opponent) const;
+ 
+     /**
+      * @brief The z with P(|Z| > z) = alpha for a standard normal Z.
+      * @throws std::invalid_argument unless 0 < alpha < 1.
+      */
+     static double CriticalValue(double alpha);
+ 
+ private:
+     MatchEstimatorOptions m_options {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,115 @@
+/**
+ * @file MatchRules.hpp
+ * @brief Declares the match-termination rules.
+ *
+ * A session always stops after its configured number of rounds; the rules
+ * here may end it earlier, as soon as the match is decided. Every check
+ * works on the running win counts alone, so it costs O(1) per round.
+ * Forfeited and drawn rounds count towards the round limit but give no
+ * one a win.
+ */
+
+ #pragma once
+
+ #include "GameMode.hpp"
+ #include <cstdint>
+ 
+ /**
+  * @brief When a match may end before its round limit.
+  */
+ enum class MatchTermination : std::uint8_t
+ {
+     /**
+      * @brief Every round is played.
+      */
+     FixedRounds,
+ 
+     /**
+      * @brief Ends once the trailing side could not catch up in the rounds left.
+      *
+      * The winner is always the one a full-length match would have had.
+      */
+     BestOf,
+ 
+     /**
+      * @brief Ends when either side reaches winsNeeded.
+      */
+     FirstTo,
+ 
+     /**
+      * @brief Like FirstTo, but the winner must also lead by two wins.
+      */
+     WinByTwo
+ };
+ 
+ struct MatchRules {
+     MatchTermination termination {MatchTermination::FixedRounds};
+ 
+     /**
+      * @brief Target for FirstTo and WinByTwo; ignored otherwise.
+      */
+     int winsNeeded {};
+ };
+ 
+ /**
+  * @brief Checks if the match can stop now.
+  * @param roundsLeft Rounds still allowed by the round limit.
+  */
+ constexpr bool IsMatchDecided(MatchRules rules, int userWins, int computerWins, int roundsLeft) {
+     int leader { userWins > computerWins ? userWins : computerWins };
+     int lead { userWins > computerWins ? userWins - computerWins : computerWins - userWins };
+     switch (rules.termination) {
+         case MatchTermination::BestOf:   return lead > roundsLeft;
+         case MatchTermination::FirstTo:  return leader >= rules.winsNeeded;
+         case MatchTermination::WinByTwo: return leader >= rules.winsNeeded && lead >= 2;
+         default:                         return false;
+     }
+ }
+ 
+ /**
+  * @brief Fewest rounds that must still be played before the match can be decided.
+  *
+  * Lets a session ask its messenger for exactly the moves it is sure to
+  * play. Call only while the match is undecided.
+  *
+  * @return A value in [1, roundsLeft], or 0 if no rounds are left.
+  */
+ constexpr int RoundsBeforeDecision(MatchRules rules, int userWins, int computerWins, int roundsLeft) {
+     int leader { userWins > computerWins ? userWins : computerWins };
+     int lead { userWins > computerWins ? userWins - computerWins : computerWins - userWins };
+     int rounds { roundsLeft };
+     switch (rules.termination) {
+         case MatchTermination::BestOf:
+             // The leader winning k more rounds decides it once lead + k > roundsLeft - k.
+             rounds = (roundsLeft - lead) / 2 + 1;
+             break;
+         case MatchTermination::FirstTo:
+             rounds = rules.winsNeeded - leader;
+             break;
+         case MatchTermination::WinByTwo:
+             rounds = rules.winsNeeded - leader > 2 - lead ? rules.winsNeeded - leader : 2 - lead;
+             break;
+         default:
+             break;
+     }
+     if (rounds < 1) {
+         rounds = 1;
+     }
+     return rounds < roundsLeft ? rounds : roundsLeft;
+ }
+ 
+ /**
+  * @brief The rules a built-in GameMode plays by.
+  *
+  * `rounds` is the session's round limit. FirstTo and WinByTwo modes need a
+  * majority of it, `rounds / 2 + 1` wins.
+  */
+ constexpr MatchRules MatchRulesFor(GameMode mode, int rounds) {
+     switch (mode) {
+         case GameMode::SinglePlayerBestOf:   return {MatchTermination::BestOf, 0};
+         case GameMode::SinglePlayerFirstTo:  return {MatchTermination::FirstTo, rounds / 2 + 1};
+         case GameMode::SinglePlayerWinByTwo: return {MatchTermination::WinByTwo, rounds / 2 + 1};
+         default:                             return {};
+     }
+ }
+ 
\ No newline at end of file
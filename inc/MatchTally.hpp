@@ -0,0 +1,42 @@
+/**
+ * @file MatchTally.hpp
+ * @brief Declares the MatchTally class.
+ *
+ * MatchTally is an IRoundObserver that sums up one session's rounds into
+ * a MatchRecord for ProfileStore::RecordMatch(): rounds won and drawn by
+ * each side and the move model of each player.
+ */
+
+ #pragma once
+
+ #include "IRoundObserver.hpp"
+ #include "ProfileStore.hpp"
+ #include <cstdint>
+ #include <string>
+ 
+ /**
+  * @brief Collects the rounds of one match.
+  */
+ class MatchTally : public IRoundObserver {
+ public:
+     MatchTally() = default;
+ 
+     void OnRound(const RoundRecord& record) override;
+ 
+     /**
+      * @brief Returns the match so far; its name views point into this tally.
+      */
+     MatchRecord Match() const;
+ 
+ private:
+     std::string m_userName {};
+     std::string m_computerName {};
+     MatchRecord m_match {};
+ 
+     /**
+      * @brief Each side's previous valid move (0 before the first one).
+      */
+     std::uint8_t m_lastUserMove {};
+     std::uint8_t m_lastComputerMove {};
+ };
+ 
\ No newline at end of file
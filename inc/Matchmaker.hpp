@@ -0,0 +1,175 @@
+/**
+ * @file Matchmaker.hpp
+ * @brief Declares the Matchmaker class.
+ *
+ * Matchmaker pairs waiting players of similar rating into game sessions.
+ * Frontend threads submit match requests into one lock-free MpmcQueue per
+ * rating band, so submitting never takes a lock or allocates. A matcher
+ * thread periodically runs a pairing pass: it drains every band, orders
+ * the waiting players by rating and pairs neighbours. Players normally
+ * only meet their own band; the longer one has waited, the more bands
+ * away an opponent may be, so outliers are eventually matched too.
+ *
+ * Each pair becomes a session through GameSessionFactory::Create(); the
+ * registered creator reads the players from CurrentPair().
+ */
+
+ #pragma once
+
+ #include "GameMode.hpp"
+ #include "GameSessionFactory.hpp"
+ #include "MpmcQueue.hpp"
+ #include <atomic>
+ #include <cstddef>
+ #include <cstdint>
+ #include <functional>
+ #include <memory>
+ #include <vector>
+ 
+ /**
+  * @brief A player asking to be matched.
+  */
+ struct MatchRequest {
+     /**
+      * @brief The caller's id for the player, e.g. a PlayerRegistry::PlayerId.
+      */
+     std::uint32_t player {};
+     int rating {};
+ };
+ 
+ /**
+  * @brief Two players matched by a pairing pass, lower rating first.
+  */
+ struct MatchedPair {
+     MatchRequest first {};
+     MatchRequest second {};
+ 
+     /**
+      * @brief How long the longer-waiting of the two waited, in nanoseconds.
+      */
+     std::uint64_t waitedNanos {};
+ };
+ 
+ /**
+  * @brief Band layout and widening schedule of a Matchmaker.
+  */
+ struct MatchmakerOptions {
+     /**
+      * @brief Lowest rating of the first band; lower ratings join the first band.
+      */
+     int minRating {0};
+     int bandWidth {100};
+ 
+     /**
+      * @brief Number of bands; higher ratings join the last band.
+      */
+     std::size_t bandCount {40};
+ 
+     /**
+      * @brief Requests each band can hold between passes; a power of two.
+      */
+     std::size_t bandCapacity {4096};
+ 
+     /**
+      * @brief Waiting time after which a player reaches one more band in each direction.
+      */
+     std::uint64_t widenNanos {2'000'000'000ull};
+     std::size_t maxWiden {3};
+ };
+ 
+ /**
+  * @brief Pairs players by rating band and hands each pair to a session factory.
+  */
+ class Matchmaker {
+ public:
+     /**
+      * @brief Returns the current time in nanoseconds.
+      */
+     using Clock = std::function<std::uint64_t()>;
+ 
+     /**
+      * @brief Receives each matched pair and the session created for it.
+      */
+     using SessionSink = std::function<void(const MatchedPair&, std::unique_ptr<IGameSession>)>;
+ 
+     /**
+      * @param factory Creates the sessions; must outlive the matchmaker.
+      * @param mode    The mode passed to GameSessionFactory::Create().
+      * @param options Band layout and widening schedule.
+      * @param clock   Time source; defaults to std::chrono::steady_clock.
+      * @throws std::invalid_argument if the bands are empty or a capacity is not a power of two.
+      */
+     Matchmaker(GameSessionFactory& factory, GameMode mode, MatchmakerOptions options = {}, Clock clock = {});
+ 
+     Matchmaker(const Matchmaker&) = delete;
+     Matchmaker& operator=(const Matchmaker&) = delete;
+ 
+     /**
+      * @brief Queues a request. Lock-free; may be called from any thread.
+      * @return False if the request's band is full until the next pass.
+      */
+     bool Submit(const MatchRequest& request);
+ 
+     /**
+      * @brief Runs one pairing pass and hands every new pair to `sink`.
+      *
+      * Only one pass runs at a time; a call made while another pass is
+      * running returns 0 at once. If the factory or the sink throws, that
+      * pair is dropped, the pairs after it go back to waiting and the
+      * exception propagates.
+      *
+      * @return The number of pairs made.
+      */
+     std::size_t RunPass(const SessionSink& sink);
+ 
+     /**
+      * @brief The pair whose session is being created.
+      *
+      * Only meaningful inside a creator called by RunPass().
+      */
+     const MatchedPair& CurrentPair() const;
+ 
+     /**
+      * @brief Players left unmatched by the last pass.
+      */
+     std::size_t Waiting() const;
+ 
+     /**
+      * @brief Returns the band a rating belongs to.
+      */
+     std::size_t BandOf(int rating) const;
+ 
+ private:
+     struct Ticket {
+         MatchRequest request {};
+         std::uint64_t submittedNanos {};
+     };
+ 
+     /**
+      * @brief How many bands away the ticket's player may be matched at `now`.
+      */
+     std::size_t Reach(const Ticket& ticket, std::uint64_t now) const;
+ 
+     GameSessionFactory& m_factory;
+     GameMode m_mode {};
+     MatchmakerOptions m_options {};
+     Clock m_clock {};
+ 
+     std::vector<std::unique_ptr<MpmcQueue<Ticket>>> m_queues {};
+ 
+     /**
+      * @brief Players carried between passes, per band; only touched by the running pass.
+      */
+     std::vector<std::vector<Ticket>> m_waiting {};
+     std::vector<std::vector<Ticket>> m_leftover {};
+ 
+     /**
+      * @brief Tickets paired by the running pass, two per pair.
+      */
+     std::vector<Ticket> m_paired {};
+     MatchedPair m_current {};
+ 
+     std::atomic<bool> m_passRunning {false};
+     std::atomic<std::size_t> m_waitingCount {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,110 @@
+/**
+ * @file MoveStrategies.hpp
+ * @brief Declares the built-in IMoveStrategy implementations.
+ *
+ * These small strategies serve as reference opponents for bots, headless
+ * simulations and tests. MakeMoveStrategy() builds one from its name.
+ */
+
+ #pragma once
+
+ #include "IMoveStrategy.hpp"
+ #include "Xoshiro256.hpp"
+ #include <cstdint>
+ #include <memory>
+ #include <string_view>
+ 
+ /**
+  * @brief Returns the move that beats the given move.
+  */
+ constexpr GameMove BeatingMove(GameMove move) {
+     return move == GameMove::Rock  ? GameMove::Paper :
+            move == GameMove::Paper ? GameMove::Scissors :
+                                      GameMove::Rock;
+ }
+ 
+ /**
+  * @brief Always plays the same move.
+  */
+ class ConstantStrategy : public IMoveStrategy {
+ public:
+     explicit ConstantStrategy(GameMove move);
+ 
+     GameMove NextMove() override;
+     void ObserveRound(GameMove ownMove, GameMove opponentMove) override;
+     bool DependsOnHistory() const override;
+ 
+ private:
+     GameMove m_move {};
+ };
+ 
+ /**
+  * @brief Plays Rock, Paper, Scissors, Rock, ... in order.
+  */
+ class CycleStrategy : public IMoveStrategy {
+ public:
+     CycleStrategy() = default;
+ 
+     GameMove NextMove() override;
+     void ObserveRound(GameMove ownMove, GameMove opponentMove) override;
+     bool DependsOnHistory() const override;
+ 
+ private:
+     int m_next {};
+ };
+ 
+ /**
+  * @brief Plays uniformly random moves from a seeded generator.
+  */
+ class RandomStrategy : public IMoveStrategy {
+ public:
+     explicit RandomStrategy(std::uint64_t seed);
+ 
+     GameMove NextMove() override;
+     void ObserveRound(GameMove ownMove, GameMove opponentMove) override;
+     bool DependsOnHistory() const override;
+ 
+ private:
+     Xoshiro256 m_engine {};
+ };
+ 
+ /**
+  * @brief Repeats the opponent's previous move (Rock in the first round).
+  */
+ class CopycatStrategy : public IMoveStrategy {
+ public:
+     CopycatStrategy() = default;
+ 
+     GameMove NextMove() override;
+     void ObserveRound(GameMove ownMove, GameMove opponentMove) override;
+     bool DependsOnHistory() const override;
+ 
+ private:
+     GameMove m_lastOpponentMove {GameMove::Rock};
+ };
+ 
+ /**
+  * @brief Plays the move that beats the opponent's previous move.
+  */
+ class CounterLastStrategy : public IMoveStrategy {
+ public:
+     CounterLastStrategy() = default;
+ 
+     GameMove NextMove() override;
+     void ObserveRound(GameMove ownMove, GameMove opponentMove) override;
+     bool DependsOnHistory() const override;
+ 
+ private:
+     GameMove m_lastOpponentMove {GameMove::Scissors};
+ };
+ 
+ /**
+  * @brief Creates a built-in strategy from its name.
+  * @param name One of "rock", "paper", "scissors", "cycle", "random",
+  *             "copycat" or "counter", or "ucb1", "thompson" or "exp3"
+  *             for a BanditStrategy over all of those.
+  * @param seed Seed for strategies that use randomness.
+  * @return The strategy, or nullptr if the name is unknown.
+  */
+ std::unique_ptr<IMoveStrategy> MakeMoveStrategy(std::string_view name, std::uint64_t seed);
+ 
\ No newline at end of file
@@ -0,0 +1,131 @@
+/**
+ * @file MpmcQueue.hpp
+ * @brief Declares the MpmcQueue class template.
+ *
+ * MpmcQueue is a bounded, lock-free, multi-producer multi-consumer FIFO
+ * (Dmitry Vyukov's sequence-numbered ring). Each cell carries a sequence
+ * number that says whether it is ready to be written or read in the
+ * current lap, so a push or pop is one compare-and-swap on a shared
+ * counter plus one release store on the cell. Producers and consumers
+ * only contend with their own kind, on counters kept on separate cache
+ * lines.
+ */
+
+ #pragma once
+
+ #include <atomic>
+ #include <cstddef>
+ #include <memory>
+ #include <stdexcept>
+ #include <utility>
+ 
+ /**
+  * @brief A fixed-capacity lock-free MPMC queue.
+  * @tparam T A default-constructible, movable value type.
+  */
+ template <typename T>
+ class MpmcQueue {
+ public:
+     /**
+      * @param capacity Number of values the queue holds; a power of two, at least 2.
+      * @throws std::invalid_argument otherwise.
+      */
+     explicit MpmcQueue(std::size_t capacity)
+         : m_cells{ValidCapacity(capacity) ? std::make_unique<Cell[]>(capacity) : nullptr},
+           m_mask{capacity - 1}
+     {
+         for (std::size_t i{}; i < capacity; ++i) {
+             m_cells[i].sequence.store(i, std::memory_order_relaxed);
+         }
+     }
+ 
+     MpmcQueue(const MpmcQueue&) = delete;
+     MpmcQueue& operator=(const MpmcQueue&) = delete;
+ 
+     /**
+      * @brief Appends a value if there is room. Never blocks.
+      * @return False if the queue is full.
+      */
+     bool TryPush(T value)
+     {
+         std::size_t position { m_enqueue.load(std::memory_order_relaxed) };
+         for (;;) {
+             Cell& cell { m_cells[position & m_mask] };
+             std::size_t sequence { cell.sequence.load(std::memory_order_acquire) };
+             auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+             if (lag == 0) {
+                 if (m_enqueue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                     cell.value = std::move(value);
+                     cell.sequence.store(position + 1, std::memory_order_release);
+                     return true;
+                 }
+             } else if (lag < 0) {
+                 // The cell still holds a value from the previous lap.
+                 return false;
+             } else {
+                 position = m_enqueue.load(std::memory_order_relaxed);
+             }
+         }
+     }
+ 
+     /**
+      * @brief Removes the oldest value if there is one. Never blocks.
+      * @return False if the queue is empty.
+      */
+     bool TryPop(T& value)
+     {
+         std::size_t position { m_dequeue.load(std::memory_order_relaxed) };
+         for (;;) {
+             Cell& cell { m_cells[position & m_mask] };
+             std::size_t sequence { cell.sequence.load(std::memory_order_acquire) };
+             auto lag = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+             if (lag == 0) {
+                 if (m_dequeue.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                     value = std::move(cell.value);
+                     cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+                     return true;
+                 }
+             } else if (lag < 0) {
+                 return false;
+             } else {
+                 position = m_dequeue.load(std::memory_order_relaxed);
+             }
+         }
+     }
+ 
+     std::size_t Capacity() const
+     {
+         return m_mask + 1;
+     }
+ 
+     /**
+      * @brief Returns the number of values, exact only while the queue is quiescent.
+      */
+     std::size_t SizeApprox() const
+     {
+         std::size_t tail { m_dequeue.load(std::memory_order_relaxed) };
+         std::size_t head { m_enqueue.load(std::memory_order_relaxed) };
+         return head > tail ? head - tail : 0;
+     }
+ 
+ private:
+     struct Cell {
+         std::atomic<std::size_t> sequence {};
+         T value {};
+     };
+ 
+     static bool ValidCapacity(std::size_t capacity)
+     {
+         if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+             throw std::invalid_argument("MpmcQueue capacity must be a power of two of at least 2");
+         }
+         return true;
+     }
+ 
+     std::unique_ptr<Cell[]> m_cells {};
+     std::size_t m_mask {};
+ 
+     alignas(64) std::atomic<std::size_t> m_enqueue {};
+     alignas(64) std::atomic<std::size_t> m_dequeue {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,93 @@
+/**
+ * @file NameInterner.hpp
+ * @brief Declares the NameInterner class.
+ *
+ * NameInterner maps player names to small, stable integer ids and keeps a
+ * single copy of every distinct name. The std::string_view handed out for a
+ * name stays valid for the lifetime of the interner, so players and
+ * messengers can pass names around without copying or allocating.
+ *
+ * That is also why names are never removed: any view may still be in use,
+ * so the table only grows, by the length of each new name plus a few
+ * dozen bytes of index. Code that creates players from names it receives
+ * from outside the process must bound how many distinct names it accepts,
+ * as HttpGameApi does.
+ */
+
+ #pragma once
+
+ #include <cstddef>
+ #include <cstdint>
+ #include <memory>
+ #include <shared_mutex>
+ #include <string_view>
+ #include <unordered_map>
+ #include <vector>
+ 
+ /**
+  * @brief A thread-safe table of interned names.
+  */
+ class NameInterner {
+ public:
+     /**
+      * @brief Dense id of an interned name; ids start at 0.
+      */
+     using NameId = std::uint32_t;
+ 
+     NameInterner() = default;
+     ~NameInterner() = default;
+ 
+     NameInterner(const NameInterner&) = delete;
+     NameInterner& operator=(const NameInterner&) = delete;
+ 
+     /**
+      * @brief Returns the process-wide interner used by the player classes.
+      *
+      * It lives until the process exits and keeps every name ever interned.
+      */
+     static NameInterner& Global();
+ 
+     /**
+      * @brief Interns a name, storing it on first use.
+      * @param name The name to intern.
+      * @return The id of the name; equal names always get the same id.
+      */
+     NameId Intern(std::string_view name);
+ 
+     /**
+      * @brief Returns the stored text of an interned name.
+      * @param id An id previously returned by Intern().
+      * @return A view that remains valid for the lifetime of the interner.
+      */
+     std::string_view GetName(NameId id) const;
+ 
+     /**
+      * @brief Returns the number of distinct names interned so far.
+      */
+     std::size_t Size() const;
+ 
+ private:
+     /**
+      * @brief Copies a name into the arena and returns a stable view of it.
+      */
+     std::string_view Store(std::string_view name);
+ 
+ private:
+     /**
+      * @brief Size of one arena block; longer names get a block of their own.
+      */
+     static constexpr std::size_t kBlockSize {16 * 1024};
+ 
+     mutable std::shared_mutex m_mutex {};
+ 
+     /**
+      * @brief Name text lives in fixed blocks that are never reallocated.
+      */
+     std::vector<std::unique_ptr<char[]>> m_blocks {};
+     std::size_t m_blockUsed {kBlockSize};
+     std::vector<std::unique_ptr<char[]>> m_largeNames {};
+ 
+     std::vector<std::string_view> m_names {};
+     std::unordered_map<std::string_view, NameId> m_ids {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,45 @@
+/**
+ * @file NetworkBackendFactory.hpp
+ * @brief Declares the NetworkBackendFactory class.
+ *
+ * NetworkBackendFactory creates the INetworkBackend a socket frontend
+ * runs on. Both backends implement the same interface, so a host picks
+ * one by NetworkBackendKind and never names the concrete class. Automatic
+ * prefers io_uring and falls back to epoll when the running kernel has no
+ * io_uring, has it disabled, or lacks a feature the backend needs.
+ */
+
+ #pragma once
+
+ #include "INetworkBackend.hpp"
+ #include <memory>
+ #include <string>
+ 
+ /**
+  * @brief Selects an INetworkBackend implementation.
+  */
+ enum class NetworkBackendKind
+ {
+     Automatic,
+     Epoll,
+     IoUring
+ };
+ 
+ /**
+  * @brief Creates network backends by kind.
+  */
+ class NetworkBackendFactory {
+ public:
+     /**
+      * @brief Creates a backend of the given kind.
+      * @throws std::system_error if IoUring is asked for and unavailable.
+      */
+     static std::unique_ptr<INetworkBackend> Create(NetworkBackendKind kind = NetworkBackendKind::Automatic);
+ 
+     /**
+      * @brief Parses "auto", "epoll" or "io_uring".
+      * @throws std::invalid_argument for anything else.
+      */
+     static NetworkBackendKind ParseKind(const std::string& name);
+ };
+ 
\ No newline at end of file
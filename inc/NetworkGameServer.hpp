@@ -0,0 +1,106 @@
+/**
+ * @file NetworkGameServer.hpp
+ * @brief Declares the NetworkGameServer class.
+ *
+ * NetworkGameServer is the socket frontend for remote players. Each
+ * session is a SinglePlayerRpsGame whose user is a client on a connected
+ * stream socket and whose computer player draws moves from a generator.
+ * Clients speak BotProtocol, the same wire format as arena bots:
+ * they send Hello, answer each Request with Moves and receive Bye when the
+ * session is over. A batchable client is asked for many moves at once.
+ *
+ * All sessions run on the calling thread. The user side of every session
+ * is a QueuedMoveMessenger fed from the socket, and all sockets go through
+ * one INetworkBackend, so the same server runs on epoll or io_uring.
+ */
+
+ #pragma once
+
+ #include "INetworkBackend.hpp"
+ #include <chrono>
+ #include <cstddef>
+ #include <cstdint>
+ #include <functional>
+ #include <memory>
+ #include <string>
+ #include <vector>
+ 
+ /**
+  * @brief The outcome of one network session.
+  */
+ struct NetworkSessionResult {
+     int userScore {};
+     int computerScore {};
+     int roundsPlayed {};
+ 
+     /**
+      * @brief Rounds voided because the client sent something other than a move.
+      */
+     int invalidRounds {};
+ 
+     /**
+      * @brief False if the client disconnected or broke the protocol mid-session.
+      */
+     bool completed {};
+ };
+ 
+ /**
+  * @brief Hosts many sessions with remote users over one network backend.
+  */
+ class NetworkGameServer {
+ public:
+     /**
+      * @param backend Carries every session's socket; see NetworkBackendFactory.
+      */
+     explicit NetworkGameServer(std::unique_ptr<INetworkBackend> backend);
+     ~NetworkGameServer();
+ 
+     NetworkGameServer(const NetworkGameServer&) = delete;
+     NetworkGameServer& operator=(const NetworkGameServer&) = delete;
+ 
+     /**
+      * @brief Queues a session; it starts when Run() is called.
+      * @param socketFd      Connected stream socket to the user's client; owned by the server.
+      * @param userName      Name of the remote user.
+      * @param computerName  Name of the computer player.
+      * @param rounds        Number of rounds in the session.
+      * @param computerMoves Generator for the computer's moves, mapped to 1 + (v % 3).
+      * @return Index of the session in the results returned by Run().
+      */
+     std::size_t AddSession(int socketFd, std::string userName, std::string computerName, int rounds,
+                            std::function<int()> computerMoves);
+ 
+     /**
+      * @brief Runs every queued session to completion.
+      *
+      * Returns once every session has ended and the backend has delivered
+      * the final Byes, or after kDrainTimeout if a client stopped reading.
+      *
+      * @return One result per session, in AddSession() order.
+      */
+     std::vector<NetworkSessionResult> Run();
+ 
+     static constexpr std::chrono::milliseconds kDrainTimeout {1000};
+ 
+     INetworkBackend& Backend();
+ 
+ private:
+     struct Session;
+ 
+     void StartSession(Session& session);
+     void OnReceive(INetworkBackend::ConnectionId connection, const std::uint8_t* data, std::size_t size);
+     void Pump(Session& session);
+     void SendRequest(Session& session, std::size_t count);
+     void EndSession(Session& session, bool completed);
+ 
+ private:
+     std::unique_ptr<INetworkBackend> m_backend {};
+     std::vector<std::unique_ptr<Session>> m_sessions {};
+ 
+     /**
+      * @brief Running session of each connection id, or nullptr.
+      */
+     std::vector<Session*> m_byConnection {};
+     std::size_t m_activeSessions {};
+ };
+ 
\ No newline at end of file
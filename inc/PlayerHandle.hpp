@@ -0,0 +1,49 @@
+/**
+ * @file PlayerHandle.hpp
+ * @brief Declares the PlayerHandle class.
+ *
+ * PlayerHandle is a lightweight IPlayer that owns no state of its own:
+ * it forwards every call to one row of a PlayerRegistry.
+ */
+
+ #pragma once
+
+ #include "IPlayer.hpp"
+ #include "PlayerRegistry.hpp"
+ #include <string>
+ #include <string_view>
+ 
+ /**
+  * @brief An IPlayer view onto a single player stored in a PlayerRegistry.
+  *
+  * The registry must outlive the handle.
+  */
+ class PlayerHandle : public IPlayer {
+ public:
+     /**
+      * @brief Constructs a handle for one registry row.
+      * @param registry The registry holding the player's state.
+      * @param id       The player's id in that registry.
+      */
+     PlayerHandle(PlayerRegistry& registry, PlayerRegistry::PlayerId id);
+ 
+     /**
+      * @brief Virtual destructor.
+      */
+     virtual ~PlayerHandle() = default;
+ 
+     std::string GetName() const override;
+     std::string_view GetNameView() const override;
+     int GetScore() const override;
+     void AddWin() override;
+ 
+     /**
+      * @brief Returns the id this handle refers to.
+      */
+     PlayerRegistry::PlayerId GetId() const;
+ 
+ private:
+     PlayerRegistry* m_registry {};
+     PlayerRegistry::PlayerId m_id {};
+ };
+ 
\ No newline at end of file
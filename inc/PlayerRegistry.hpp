@@ -0,0 +1,117 @@
+/**
+ * @file PlayerRegistry.hpp
+ * @brief Declares the PlayerRegistry class.
+ *
+ * PlayerRegistry stores a large population of players as a structure of
+ * arrays: ids, scores, ratings and interned name ids each live in their own
+ * contiguous column. Bulk operations (leaderboards, resets) stream through a single
+ * column instead of chasing one heap object per player.
+ */
+
+ #pragma once
+
+ #include "NameInterner.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ #include <string_view>
+ #include <vector>
+ 
+ /**
+  * @brief A column-oriented store of player state.
+  *
+  * Adding players must not run concurrently with any other call. Once the
+  * population is built, different threads may update different players
+  * concurrently (each player's cells are touched by one thread at a time).
+  */
+ class PlayerRegistry {
+ public:
+     /**
+      * @brief Dense index of a player in the registry; ids start at 0.
+      */
+     using PlayerId = std::uint32_t;
+ 
+     /**
+      * @brief Rating given to players added without an explicit rating.
+      */
+     static constexpr int kInitialRating {1500};
+ 
+     /**
+      * @brief Constructs an empty registry.
+      * @param names The table used to intern player names.
+      */
+     explicit PlayerRegistry(NameInterner& names = NameInterner::Global());
+     ~PlayerRegistry() = default;
+ 
+     /**
+      * @brief Reserves space for the given number of players.
+      * @param playerCount   Expected number of players.
+      */
+     void Reserve(std::size_t playerCount);
+ 
+     /**
+      * @brief Adds a player with a zero score.
+      * @param name   The player's display name.
+      * @param rating The player's initial rating.
+      * @return The id of the new player.
+      */
+     PlayerId Add(std::string_view name, int rating = kInitialRating);
+ 
+     /**
+      * @brief Returns the number of players in the registry.
+      */
+     std::size_t Size() const;
+ 
+     /**
+      * @brief Returns a player's name.
+      *
+      * The view stays valid for the lifetime of the name interner.
+      */
+     std::string_view GetName(PlayerId id) const;
+
+     /**
+      * @brief Returns the interned id of a player's name.
+      */
+     NameInterner::NameId GetNameId(PlayerId id) const;
+ 
+     int GetScore(PlayerId id) const;
+     void AddWin(PlayerId id);
+ 
+     int GetRating(PlayerId id) const;
+     void SetRating(PlayerId id, int rating);
+ 
+     /**
+      * @brief Returns the ids of the K highest-scoring players.
+      *
+      * A single linear pass over the score column with a K-sized heap.
+      * Ties are broken by the lower id.
+      *
+      * @param k Maximum number of ids to return.
+      * @return Player ids ordered from highest to lowest score.
+      */
+     std::vector<PlayerId> TopKByScore(std::size_t k) const;
+ 
+     /**
+      * @brief Sets every player's score back to zero.
+      */
+     void ResetAllScores();
+ 
+     /**
+      * @brief Returns the contiguous score column (Size() entries).
+      */
+     const int* Scores() const;
+ 
+     /**
+      * @brief Returns the contiguous rating column (Size() entries).
+      */
+     const int* Ratings() const;
+ 
+ private:
+     std::vector<PlayerId> m_ids {};
+     std::vector<int> m_scores {};
+     std::vector<int> m_ratings {};
+ 
+     std::vector<NameInterner::NameId> m_nameIds {};
+
+     NameInterner* m_names {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,260 @@
+/**
+ * @file ProfileStore.hpp
+ * @brief Declares PlayerProfile, MatchRecord and the durable ProfileStore.
+ *
+ * ProfileStore keeps lifetime player profiles in memory and makes every
+ * change durable through a write-ahead log in a directory:
+ *
+ * - `wal-<segment>.log`: append-only log segments of match records, each
+ *   framed as [u32 length][u32 CRC-32][payload].
+ * - `profiles.snapshot`: every profile as of the start of some segment,
+ *   written to a temporary file and renamed into place.
+ *
+ * RecordMatch() updates memory and queues the record; a background thread
+ * writes everything queued since its last pass with one write() and one
+ * fdatasync() (group commit), so many writers share each flush. When the
+ * log since the last snapshot grows past a threshold, the store starts a
+ * new segment, snapshots the profiles and deletes the covered segments.
+ *
+ * Opening a directory maps the snapshot and replays the segments after
+ * it. A torn record at the end of the last segment (a crash mid-write) is
+ * dropped; damage anywhere else is reported as an error.
+ */
+
+ #pragma once
+
+ #include <array>
+ #include <condition_variable>
+ #include <cstddef>
+ #include <cstdint>
+ #include <deque>
+ #include <mutex>
+ #include <optional>
+ #include <string>
+ #include <string_view>
+ #include <thread>
+ #include <unordered_map>
+ #include <vector>
+ 
+ /**
+  * @brief How a player tends to move; the state opponent models learn from.
+  */
+ struct MoveModel {
+     /**
+      * @brief Moves played, indexed by GameMove - 1.
+      */
+     std::array<std::uint64_t, 3> moves {};
+ 
+     /**
+      * @brief Consecutive move pairs, indexed [previous - 1][next - 1].
+      */
+     std::array<std::array<std::uint64_t, 3>, 3> follows {};
+ 
+     void Add(const MoveModel& other);
+     bool operator==(const MoveModel& other) const;
+ };
+ 
+ /**
+  * @brief Lifetime statistics of one player.
+  */
+ struct PlayerProfile {
+     std::uint64_t matchesWon {};
+     std::uint64_t matchesLost {};
+     std::uint64_t matchesDrawn {};
+     std::uint64_t roundsWon {};
+     std::uint64_t roundsLost {};
+     std::uint64_t roundsDrawn {};
+     std::int32_t rating {1500};
+     MoveModel model {};
+ 
+     bool operator==(const PlayerProfile& other) const;
+ };
+ 
+ /**
+  * @brief One side of a finished match.
+  */
+ struct MatchSide {
+     std::string_view name {};
+     std::uint32_t roundsWon {};
+     MoveModel model {};
+ };
+ 
+ /**
+  * @brief A finished match between two players, as passed to RecordMatch().
+  */
+ struct MatchRecord {
+     MatchSide user {};
+     MatchSide computer {};
+     std::uint32_t roundsDrawn {};
+ };
+ 
+ /**
+  * @brief Tuning knobs of a ProfileStore.
+  */
+ struct ProfileStoreOptions {
+     /**
+      * @brief Log bytes written since the last snapshot that trigger a new one.
+      */
+     std::uint64_t snapshotBytes {64ull << 20};
+ 
+     /**
+      * @brief Whether each group commit ends with fdatasync().
+      *
+      * Without it a record survives a process crash but not a power loss.
+      */
+     bool syncWrites {true};
+ };
+ 
+ /**
+  * @brief Counts from opening a store directory.
+  */
+ struct ProfileRecovery {
+     std::uint64_t snapshotProfiles {};
+     std::uint64_t replayedRecords {};
+     std::uint64_t discardedBytes {};
+ };
+ 
+ /**
+  * @brief A durable, thread-safe map from player name to PlayerProfile.
+  */
+ class ProfileStore {
+ public:
+     /**
+      * @brief Elo K-factor applied to every recorded match.
+      */
+     static constexpr double kRatingK {32.0};
+ 
+     /**
+      * @brief Opens (creating if needed) the store in `directory` and recovers it.
+      * @throws std::runtime_error if the directory or its files cannot be used.
+      */
+     explicit ProfileStore(std::string directory, ProfileStoreOptions options = {});
+ 
+     /**
+      * @brief Makes every recorded match durable and stops the log thread.
+      */
+     ~ProfileStore();
+ 
+     ProfileStore(const ProfileStore&) = delete;
+     ProfileStore& operator=(const ProfileStore&) = delete;
+ 
+     /**
+      * @brief Applies a match to both players' profiles and logs it.
+      *
+      * The change is visible to Find() at once and durable once
+      * WaitDurable() returns for the returned sequence number.
+      *
+      * @return The match's log sequence number (1 for the first match ever).
+      * @throws std::runtime_error if the log has failed.
+      */
+     std::uint64_t RecordMatch(const MatchRecord& match);
+ 
+     /**
+      * @brief Blocks until the match with sequence number `sequence` is durable.
+      * @throws std::runtime_error if the log has failed.
+      */
+     void WaitDurable(std::uint64_t sequence);
+ 
+     /**
+      * @brief Blocks until every match recorded so far is durable.
+      */
+     void Flush();
+ 
+     /**
+      * @brief Writes a snapshot now and drops the log it covers.
+      */
+     void Compact();
+ 
+     /**
+      * @brief Returns a copy of a player's profile, if the player is known.
+      */
+     std::optional<PlayerProfile> Find(std::string_view name) const;
+ 
+     /**
+      * @brief Returns the number of known players.
+      */
+     std::size_t Size() const;
+ 
+     /**
+      * @brief Returns the sequence number of the last recorded match.
+      */
+     std::uint64_t LastSequence() const;
+ 
+     /**
+      * @brief Returns what opening the directory found.
+      */
+     const ProfileRecovery& Recovery() const;
+ 
+ private:
+     /**
+      * @brief A profile and the name it is indexed by; never moves once added.
+      */
+     struct Entry {
+         std::string name {};
+         PlayerProfile profile {};
+     };
+ 
+     /**
+      * @brief A logged match: the input plus the rating changes it caused.
+      */
+     struct LoggedMatch {
+         MatchRecord match {};
+         std::int32_t userRatingDelta {};
+         std::int32_t computerRatingDelta {};
+     };
+ 
+     void Recover();
+     /**
+      * @brief Loads the profiles of a snapshot.
+      * @return The first log segment the snapshot does not cover.
+      */
+     std::uint64_t LoadSnapshot(const std::string& path);
+     std::uint64_t ReplaySegment(const std::string& path, bool isLast);
+ 
+     /**
+      * @brief Applies a match to memory; callers hold m_mutex.
+      */
+     void Apply(const LoggedMatch& logged);
+     PlayerProfile& Profile(std::string_view name);
+ 
+     void OpenSegment(std::uint64_t segment);
+     std::string SegmentPath(std::uint64_t segment) const;
+     std::string SnapshotPath() const;
+ 
+     void LogLoop();
+     void WriteSnapshot(std::uint64_t firstSegment, std::uint64_t sequence, const std::vector<Entry>& entries);
+     void ThrowIfFailed() const;
+ 
+ private:
+     std::string m_directory {};
+     ProfileStoreOptions m_options {};
+     ProfileRecovery m_recovery {};
+ 
+     /**
+      * @brief Guards everything below except m_file, which only the log thread uses once started.
+      */
+     mutable std::mutex m_mutex {};
+     std::condition_variable m_logWake {};
+     std::condition_variable m_durableWake {};
+ 
+     std::deque<Entry> m_entries {};
+     std::unordered_map<std::string_view, std::uint32_t> m_index {};
+ 
+     /**
+      * @brief Encoded records not yet handed to the log thread.
+      */
+     std::vector<std::uint8_t> m_pending {};
+     std::uint64_t m_sequence {};
+     std::uint64_t m_durableSequence {};
+     std::uint64_t m_segment {};
+     std::uint64_t m_bytesSinceSnapshot {};
+     bool m_compactRequested {false};
+     std::uint64_t m_snapshotSequence {};
+     std::uint64_t m_snapshotCount {};
+     bool m_stopping {false};
+     std::string m_error {};
+ 
+     int m_file {-1};
+     std::thread m_logThread {};
+ };
+ 
\ No newline at end of file
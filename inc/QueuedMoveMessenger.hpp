@@ -0,0 +1,63 @@
+/**
+ * @file QueuedMoveMessenger.hpp
+ * @brief Declares the QueuedMoveMessenger class.
+ *
+ * QueuedMoveMessenger is a headless IGameMessenger for sessions driven by
+ * code rather than by a person: the host pushes user moves as they arrive
+ * (from a bot, a socket, an HTTP request) and the session consumes them.
+ * All display calls are ignored.
+ */
+
+ #pragma once
+
+ #include "IGameMessenger.hpp"
+ #include <cstddef>
+ #include <deque>
+ #include <memory>
+ #include <string>
+ 
+ /**
+  * @brief An IGameMessenger that serves user moves from an in-memory queue.
+  */
+ class QueuedMoveMessenger : public IGameMessenger {
+ public:
+     QueuedMoveMessenger() = default;
+     virtual ~QueuedMoveMessenger() = default;
+ 
+     /**
+      * @brief Appends a user move choice (1=Rock, 2=Paper, 3=Scissors, anything else is invalid).
+      */
+     void PushMove(int choice);
+ 
+     /**
+      * @brief Returns the number of queued moves not yet consumed.
+      */
+     std::size_t PendingMoves() const;
+ 
+     void ShowWelcomeScreen() override;
+     std::string RequestUserPlayerName() override;
+     std::string RequestComputerPlayerName() override;
+     int RequestNumberOfRounds() override;
+     void ShowSetupComplete() override;
+ 
+     /**
+      * @brief Pops the oldest queued move, or returns -1 if the queue is empty.
+      */
+     int RequestMoveChoice() override;
+ 
+     /**
+      * @brief Pops up to maxCount queued moves; an empty queue yields one -1.
+      */
+     std::size_t RequestMoveChoices(int* moves, std::size_t maxCount) override;
+ 
+     void DisplayChosenMove(const std::shared_ptr<IPlayer>& player, GameMove move) override;
+     void AnnounceRoundWinner(const std::shared_ptr<IPlayer>& winner) override;
+     void AnnounceDraw() override;
+     void ShowFinalScore(const std::shared_ptr<IPlayer>& userPlayer,
+                         const std::shared_ptr<IPlayer>& computerPlayer) override;
+     void ShowInvalidInputMessage() override;
+ 
+ private:
+     std::deque<int> m_moves {};
+ };
+ 
\ No newline at end of file
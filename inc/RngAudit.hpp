@@ -0,0 +1,119 @@
+/**
+ * @file RngAudit.hpp
+ * @brief Declares the RngAudit class.
+ *
+ * RngAudit checks a computer-move generator the way SinglePlayerRpsGame
+ * uses it: every value v becomes move v % 3. It streams the moves through
+ * four tests and reports a p-value for each:
+ *   - frequency:   chi-square of the three move counts (2 df);
+ *   - serial:      overlapping-pair chi-square, psi^2(pairs) - psi^2(moves) (6 df);
+ *   - correlation: lag-1 correlation of the moves as -1, 0, 1 (normal);
+ *   - runs:        number of move changes against Binomial(n - 1, 2/3) (normal),
+ *                  and run lengths 1..7 and 8+ against the geometric law (7 df).
+ *
+ * Moves are generated in segments of consecutive values, each from its own
+ * generator made by the factory for that segment's index. Worker threads
+ * take segments round-robin; every statistic is an integer count, so the
+ * report does not depend on the thread count. Generators that share
+ * global state, such as std::rand, must be audited with one thread.
+ */
+
+ #pragma once
+
+ #include <array>
+ #include <cstdint>
+ #include <functional>
+ 
+ /**
+  * @brief Makes the generator for one segment, given the segment index.
+  */
+ using MoveGeneratorFactory = std::function<std::function<int()>(std::uint64_t segment)>;
+ 
+ struct RngAuditOptions {
+     std::uint64_t moves {std::uint64_t{1} << 30};
+ 
+     /**
+      * @brief Consecutive moves drawn from one generator; pairs and runs do not cross segments.
+      */
+     std::uint64_t segmentMoves {std::uint64_t{1} << 24};
+ 
+     /**
+      * @brief 0 uses every hardware thread.
+      */
+     unsigned threads {};
+ };
+ 
+ struct RngTestResult {
+     /**
+      * @brief Chi-square value, or z score for the normal tests.
+      */
+     double statistic {};
+ 
+     /**
+      * @brief Degrees of freedom; 0 for the normal tests.
+      */
+     int degreesOfFreedom {};
+     double pValue {};
+ };
+ 
+ struct RngAuditReport {
+     std::uint64_t moves {};
+     std::array<std::uint64_t, 3> moveCounts {};
+ 
+     /**
+      * @brief Consecutive pairs, indexed by first * 3 + second.
+      */
+     std::array<std::uint64_t, 9> pairCounts {};
+ 
+     /**
+      * @brief Runs by length 1..7, then 8 and longer; runs starting in a
+      *        segment's last 7 moves are not counted.
+      */
+     std::array<std::uint64_t, 8> runLengths {};
+ 
+     RngTestResult frequency {};
+     RngTestResult serial {};
+     RngTestResult correlation {};
+     RngTestResult runs {};
+     RngTestResult runLengthTest {};
+     double seconds {};
+ 
+     double MovesPerSecond() const;
+ 
+     /**
+      * @brief The smallest of the five p-values.
+      */
+     double MinPValue() const;
+ };
+ 
+ /**
+  * @brief Runs the statistical audit of a move generator.
+  */
+ class RngAudit {
+ public:
+     /**
+      * @throws std::invalid_argument if there are fewer than 2 moves or segments are shorter than 2.
+      */
+     RngAudit(MoveGeneratorFactory factory, RngAuditOptions options);
+ 
+     /**
+      * @throws std::runtime_error if a generator returns a negative value,
+      *         which would not be a valid move in the game.
+      */
+     RngAuditReport Run() const;
+ 
+     /**
+      * @brief Upper tail probability of the chi-square distribution.
+      */
+     static double ChiSquarePValue(double statistic, int degreesOfFreedom);
+ 
+     /**
+      * @brief Two-sided tail probability of the standard normal distribution.
+      */
+     static double NormalPValue(double z);
+ 
+ private:
+     MoveGeneratorFactory m_factory {};
+     RngAuditOptions m_options {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ * @file RoundColumnReader.hpp
+ * @brief Declares the RoundColumnReader class.
+ *
+ * RoundColumnReader opens a file written by RoundColumnWriter. Opening
+ * reads only the footer; ReadColumn() then fetches and decodes a single
+ * column chunk, so a scan touches just the bytes of the columns it asks
+ * for, and Stats() lets callers skip blocks without reading them.
+ */
+
+ #pragma once
+
+ #include "RoundColumns.hpp"
+ #include <fstream>
+ #include <string>
+ #include <vector>
+ 
+ /**
+  * @brief Reads a columnar round export block by block.
+  */
+ class RoundColumnReader {
+ public:
+     /**
+      * @brief Opens `path` and loads its footer.
+      * @throws std::runtime_error if the file is missing or malformed.
+      */
+     explicit RoundColumnReader(const std::string& path);
+ 
+     std::uint64_t Rows() const;
+     std::size_t BlockCount() const;
+     std::size_t BlockRows(std::size_t block) const;
+ 
+     /**
+      * @brief Returns the min/max of a column chunk, without reading it.
+      */
+     ColumnStats Stats(std::size_t block, RoundColumn column) const;
+ 
+     ColumnEncoding Encoding(std::size_t block, RoundColumn column) const;
+ 
+     /**
+      * @brief Returns the encoded size of a column chunk in bytes.
+      */
+     std::size_t ChunkSize(std::size_t block, RoundColumn column) const;
+ 
+     /**
+      * @brief Names referenced by the UserName and ComputerName columns, by id.
+      */
+     const std::vector<std::string>& Names() const;
+ 
+     /**
+      * @brief Decodes one column chunk into `out`, replacing its contents.
+      * @throws std::runtime_error on a read error or a corrupt chunk.
+      */
+     void ReadColumn(std::size_t block, RoundColumn column, std::vector<std::uint64_t>& out);
+ 
+ private:
+     const ColumnChunkInfo& Chunk(std::size_t block, RoundColumn column) const;
+ 
+ private:
+     std::ifstream m_file {};
+     std::uint64_t m_rows {};
+     std::vector<RoundBlockInfo> m_blocks {};
+     std::vector<std::string> m_names {};
+     std::vector<std::uint8_t> m_buffer {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+ * @file RoundColumnWriter.hpp
+ * @brief Declares the RoundColumnWriter class.
+ *
+ * RoundColumnWriter is an IRoundObserver that streams rounds to a round
+ * export file (see RoundColumns.hpp). Only the current block is held in
+ * memory: when it fills up, every column is encoded and appended to the
+ * file, so memory use is bounded by the block size plus the name
+ * dictionary, however many rounds are written.
+ */
+
+ #pragma once
+
+ #include "IRoundObserver.hpp"
+ #include "RoundColumns.hpp"
+ #include <array>
+ #include <fstream>
+ #include <string>
+ #include <unordered_map>
+ #include <vector>
+ 
+ /**
+  * @brief Writes rounds to a columnar file.
+  */
+ class RoundColumnWriter : public IRoundObserver {
+ public:
+     /**
+      * @brief Default number of rows per block.
+      */
+     static constexpr std::size_t kDefaultBlockRows {65536};
+ 
+     /**
+      * @brief Creates (or truncates) the file at `path`.
+      * @throws std::runtime_error if the file cannot be opened.
+      */
+     explicit RoundColumnWriter(const std::string& path, std::size_t blockRows = kDefaultBlockRows);
+ 
+     /**
+      * @brief Closes the file if Close() was not called; errors are swallowed.
+      */
+     ~RoundColumnWriter() override;
+ 
+     RoundColumnWriter(const RoundColumnWriter&) = delete;
+     RoundColumnWriter& operator=(const RoundColumnWriter&) = delete;
+ 
+     /**
+      * @brief Buffers one round, writing out the block once it is full.
+      * @throws std::runtime_error on a write error.
+      */
+     void OnRound(const RoundRecord& record) override;
+ 
+     /**
+      * @brief Writes the last partial block and the footer, then closes the file.
+      * @throws std::runtime_error on a write error.
+      */
+     void Close();
+ 
+     /**
+      * @brief Returns the number of rounds written so far.
+      */
+     std::uint64_t Rows() const;
+ 
+ private:
+     /**
+      * @brief Returns the dictionary id of `name`, adding it if new.
+      * @param slot 0 for user names, 1 for computer names; each remembers its last id.
+      */
+     std::uint64_t NameId(std::size_t slot, std::string_view name);
+ 
+     void FlushBlock();
+     void WriteBytes(const std::vector<std::uint8_t>& bytes);
+ 
+ private:
+     std::ofstream m_file {};
+     std::size_t m_blockRows {};
+     std::uint64_t m_offset {};
+     std::uint64_t m_rows {};
+     bool m_closed {false};
+ 
+     std::array<std::vector<std::uint64_t>, kRoundColumnCount> m_columns {};
+     std::vector<RoundBlockInfo> m_blocks {};
+     std::vector<std::uint8_t> m_scratch {};
+ 
+     std::unordered_map<std::string, std::uint64_t> m_nameIds {};
+     std::vector<std::string> m_names {};
+ 
+     /**
+      * @brief Last id returned per slot; names rarely change within a session.
+      */
+     std::array<std::uint64_t, 2> m_recentNameIds {};
+ };
+ 
\ No newline at end of file
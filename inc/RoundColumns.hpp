@@ -0,0 +1,124 @@
+/**
+ * @file RoundColumns.hpp
+ * @brief Declares the column layout and codecs of the round export format.
+ *
+ * A round export file stores RoundRecord fields column by column, in
+ * blocks of up to a few tens of thousands of rows. Every column of every
+ * block is encoded on its own with whichever of three codecs is smallest:
+ *
+ *  - RunLength:   (value, run length) varint pairs; session ids and names
+ *  - DeltaVarint: first value, then zigzag varint deltas; round numbers
+ *  - BitPacked:   frame-of-reference, fixed bit width; moves and outcomes
+ *
+ * The footer records each chunk's offset, size, codec and min/max, so a
+ * reader fetches only the columns it needs and can skip whole blocks.
+ * String columns hold ids into a dictionary stored in the footer.
+ */
+
+ #pragma once
+
+ #include <array>
+ #include <cstddef>
+ #include <cstdint>
+ #include <vector>
+ 
+ /**
+  * @brief Columns of a round export, in file order.
+  */
+ enum class RoundColumn : std::uint8_t
+ {
+     SessionId = 0,
+     Round,
+     UserMove,
+     ComputerMove,
+     Outcome,
+     UserName,
+     ComputerName,
+     DecisionNanos
+ };
+ 
+ /**
+  * @brief Number of RoundColumn values.
+  */
+ inline constexpr std::size_t kRoundColumnCount {8};
+ 
+ /**
+  * @brief Encodings a column chunk can use.
+  */
+ enum class ColumnEncoding : std::uint8_t
+ {
+     RunLength = 0,
+     DeltaVarint = 1,
+     BitPacked = 2
+ };
+ 
+ /**
+  * @brief Smallest and largest value of a column chunk.
+  */
+ struct ColumnStats {
+     std::uint64_t min {};
+     std::uint64_t max {};
+ };
+ 
+ /**
+  * @brief File magic ("RPSR"), written at both ends of a round export.
+  */
+ inline constexpr std::uint32_t kRoundFileMagic {0x52535052};
+ inline constexpr std::uint32_t kRoundFileVersion {1};
+ 
+ /**
+  * @brief Footer entry for one column chunk.
+  */
+ struct ColumnChunkInfo {
+     std::uint64_t offset {};
+     std::uint64_t size {};
+     ColumnEncoding encoding {};
+     ColumnStats stats {};
+ };
+ 
+ /**
+  * @brief Footer entry for one block.
+  */
+ struct RoundBlockInfo {
+     std::uint64_t rows {};
+     std::array<ColumnChunkInfo, kRoundColumnCount> chunks {};
+ };
+ 
+ /**
+  * @brief Encodes and decodes column chunks.
+  */
+ class ColumnCodec {
+ public:
+     /**
+      * @brief Encodes `values` with the smallest encoding and appends it to `out`.
+      * @return The encoding used.
+      */
+     static ColumnEncoding Encode(const std::vector<std::uint64_t>& values, std::vector<std::uint8_t>& out);
+ 
+     /**
+      * @brief Appends `values` encoded with `encoding` to `out`.
+      */
+     static void EncodeAs(ColumnEncoding encoding, const std::vector<std::uint64_t>& values,
+                          std::vector<std::uint8_t>& out);
+ 
+     /**
+      * @brief Decodes `count` values from `size` bytes into `out`, replacing its contents.
+      * @throws std::runtime_error if the chunk is malformed.
+      */
+     static void Decode(ColumnEncoding encoding, const std::uint8_t* data, std::size_t size,
+                        std::size_t count, std::vector<std::uint64_t>& out);
+ 
+     /**
+      * @brief Returns the min/max of `values` (zeros when empty).
+      */
+     static ColumnStats ComputeStats(const std::vector<std::uint64_t>& values);
+ 
+     static void PutVarint(std::vector<std::uint8_t>& out, std::uint64_t value);
+ 
+     /**
+      * @brief Reads a varint at `*cursor`, advancing it.
+      * @throws std::runtime_error if the varint runs past `end`.
+      */
+     static std::uint64_t GetVarint(const std::uint8_t*& cursor, const std::uint8_t* end);
+ };
+ 
\ No newline at end of file
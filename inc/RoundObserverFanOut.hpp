@@ -0,0 +1,36 @@
+/**
+ * @file RoundObserverFanOut.hpp
+ * @brief Declares the RoundObserverFanOut class.
+ *
+ * A session reports to a single IRoundObserver. RoundObserverFanOut is
+ * that observer when several want the same rounds, for example
+ * RoundStatistics, a BotDetector and a RoundColumnWriter on one session.
+ */
+
+ #pragma once
+
+ #include "IRoundObserver.hpp"
+ #include <cstddef>
+ #include <vector>
+ 
+ /**
+  * @brief Forwards every round and session end to each added observer, in order.
+  */
+ class RoundObserverFanOut : public IRoundObserver {
+ public:
+     RoundObserverFanOut() = default;
+ 
+     /**
+      * @param observer Not owned; must outlive the fan-out. nullptr is ignored.
+      */
+     void Add(IRoundObserver* observer);
+ 
+     std::size_t Size() const;
+ 
+     void OnRound(const RoundRecord& record) override;
+     void OnSessionEnd(const SessionSummary& summary) override;
+ 
+ private:
+     std::vector<IRoundObserver*> m_observers {};
+ };
+ 
\ No newline at end of file
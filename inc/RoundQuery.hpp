@@ -0,0 +1,139 @@
+/**
+ * @file RoundQuery.hpp
+ * @brief Declares the RoundQuery description and its text syntax.
+ *
+ * A RoundQuery is a filter / group-by / aggregate pipeline over the rows
+ * of round export files. Fields name a RoundColumn, optionally lagged:
+ * `computer_move@2` is the computer's move two rounds earlier in the
+ * same session (RoundQuery::kMissing, shown as "-", when there is no
+ * such round). Values are written with
+ * the game's own vocabulary - GameMove names for moves and RoundOutcome
+ * names for outcomes - so a query such as
+ *
+ *   where:  computer_move@1=rock,computer_move@2=rock
+ *   group:  user_name
+ *   agg:    count,rate(outcome=user_win)
+ *
+ * reads as "win rate of each user strategy after the opponent played
+ * Rock twice".
+ */
+
+ #pragma once
+
+ #include "RoundColumns.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ #include <string>
+ #include <vector>
+ 
+ /**
+  * @brief A column, optionally taken from an earlier round of the same session.
+  */
+ struct QueryField {
+     RoundColumn column {};
+ 
+     /**
+      * @brief How many rounds back to look; 0 is the current round.
+      */
+     std::uint8_t lag {};
+ 
+     bool operator==(const QueryField& other) const;
+ };
+ 
+ /**
+  * @brief Comparison applied by a QueryFilter.
+  */
+ enum class CompareOp : std::uint8_t
+ {
+     Equal,
+     NotEqual,
+     Less,
+     LessEqual,
+     Greater,
+     GreaterEqual
+ };
+ 
+ /**
+  * @brief Keeps rows whose field compares true against a constant.
+  */
+ struct QueryFilter {
+     QueryField field {};
+     CompareOp op {};
+     std::uint64_t value {};
+ 
+     /**
+      * @brief The constant for name columns; resolved against each file's dictionary.
+      */
+     std::string name {};
+ };
+ 
+ /**
+  * @brief Aggregate functions.
+  */
+ enum class AggregateKind : std::uint8_t
+ {
+     Count,
+     Sum,
+     Min,
+     Max,
+ 
+     /**
+      * @brief Counts rows whose field equals `value`; printed as a rate of Count.
+      */
+     CountEqual
+ };
+ 
+ struct QueryAggregate {
+     AggregateKind kind {};
+     QueryField field {};
+     std::uint64_t value {};
+ };
+ 
+ /**
+  * @brief A complete query.
+  */
+ struct RoundQuery {
+     /**
+      * @brief Largest supported lag.
+      */
+     static constexpr std::uint8_t kMaxLag {8};
+ 
+     /**
+      * @brief Largest number of group-by fields.
+      */
+     static constexpr std::size_t kMaxGroupFields {4};
+ 
+     /**
+      * @brief Value of a lagged field that reaches before the session's first round.
+      */
+     static constexpr std::uint64_t kMissing {~0ull};
+ 
+     std::vector<QueryFilter> filters {};
+     std::vector<QueryField> groupBy {};
+     std::vector<QueryAggregate> aggregates {};
+ 
+     /**
+      * @brief Parses the three comma-separated clauses of the text syntax.
+      *
+      * Filters are `field<op>value` with op one of = != < <= > >=.
+      * Aggregates are count, sum(field), min(field), max(field) and
+      * rate(field=value). An empty aggregate clause means count.
+      *
+      * @throws std::invalid_argument on a syntax error or an unknown name.
+      */
+     static RoundQuery Parse(const std::string& where, const std::string& groupBy,
+                             const std::string& aggregates);
+ 
+     /**
+      * @brief Renders a field as in the text syntax, e.g. "computer_move@1".
+      */
+     static std::string FieldName(const QueryField& field);
+ 
+     /**
+      * @brief Renders a value of `column` with the game's names (moves, outcomes).
+      *
+      * Name columns are rendered by the engine, which knows the dictionaries.
+      */
+     static std::string ValueText(RoundColumn column, std::uint64_t value);
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,70 @@
+/**
+ * @file RoundQueryEngine.hpp
+ * @brief Declares the RoundQueryEngine class.
+ *
+ * RoundQueryEngine runs a RoundQuery over any number of round export
+ * files without loading them into memory. Blocks are handed out to
+ * worker threads one at a time; each worker decodes only the columns the
+ * query touches, skips blocks whose min/max statistics rule out a filter,
+ * and processes a block column-at-a-time: every filter narrows a
+ * selection vector of row indices, then the surviving rows are grouped
+ * and aggregated into a thread-local table. Tables are merged at the end.
+ *
+ * Lagged fields assume that a session's rounds are stored consecutively,
+ * as SinglePlayerRpsGame and SimulationRunner write them.
+ */
+
+ #pragma once
+
+ #include "RoundQuery.hpp"
+ #include <cstdint>
+ #include <string>
+ #include <vector>
+ 
+ /**
+  * @brief One output group: rendered key values and one value per aggregate.
+  */
+ struct QueryRow {
+     std::vector<std::string> keys {};
+     std::vector<std::uint64_t> values {};
+ 
+     /**
+      * @brief Rows matched by the group (the denominator of rate aggregates).
+      */
+     std::uint64_t rows {};
+ };
+ 
+ /**
+  * @brief Output of a query, with scan statistics.
+  */
+ struct QueryResult {
+     /**
+      * @brief Groups sorted by key.
+      */
+     std::vector<QueryRow> rows {};
+ 
+     std::uint64_t blocksScanned {};
+     std::uint64_t blocksPruned {};
+     std::uint64_t rowsScanned {};
+     std::uint64_t rowsMatched {};
+ };
+ 
+ /**
+  * @brief Executes RoundQuery pipelines over round export files.
+  */
+ class RoundQueryEngine {
+ public:
+     /**
+      * @brief Runs `query` over `paths` on up to `threads` threads.
+      * @throws std::runtime_error if a file cannot be read.
+      * @throws std::invalid_argument if the query is malformed.
+      */
+     static QueryResult Run(const RoundQuery& query, const std::vector<std::string>& paths,
+                            unsigned threads);
+ 
+     /**
+      * @brief Formats a result as an aligned text table.
+      */
+     static std::string Format(const RoundQuery& query, const QueryResult& result);
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,143 @@
+/**
+ * @file RoundStatistics.hpp
+ * @brief Declares the RoundStatistics class and its snapshots.
+ *
+ * RoundStatistics is an IRoundObserver that keeps live statistics for
+ * every name it sees: a player in interactive sessions, a strategy in
+ * simulations. Each round updates both sides in O(1): lifetime totals,
+ * a window over the last rounds, a window over the last span of time,
+ * exponentially decayed win rate and decision latency, and quantile
+ * sketches of decision latency and session length.
+ *
+ * Any number of games may report rounds while other threads take
+ * snapshots. The name table is behind a reader-writer lock that is only
+ * taken exclusively when a new name appears; each name's statistics have
+ * their own mutex, held for one update or one snapshot copy.
+ */
+
+ #pragma once
+
+ #include "IRoundObserver.hpp"
+ #include "StreamingStats.hpp"
+ #include <cstdint>
+ #include <functional>
+ #include <memory>
+ #include <mutex>
+ #include <optional>
+ #include <shared_mutex>
+ #include <string>
+ #include <string_view>
+ #include <unordered_map>
+ #include <vector>
+ 
+ /**
+  * @brief Window sizes and decay weights of a RoundStatistics.
+  */
+ struct RoundStatisticsOptions {
+     std::size_t windowRounds {100};
+     std::uint64_t windowNanos {60'000'000'000ull};
+     std::size_t windowBuckets {60};
+ 
+     /**
+      * @brief Weight of the newest round in the decayed averages.
+      */
+     double decay {0.05};
+ };
+ 
+ /**
+  * @brief A consistent copy of one name's statistics.
+  */
+ struct PlayerStatisticsSnapshot {
+     std::string name {};
+ 
+     /**
+      * @brief Every round ever reported, by result.
+      */
+     ResultCounts totals {};
+     std::int64_t streak {};
+     std::uint64_t longestWinStreak {};
+ 
+     /**
+      * @brief The last RoundStatisticsOptions::windowRounds rounds.
+      */
+     ResultCounts recentRounds {};
+     std::array<std::uint64_t, 3> recentMoves {};
+     double recentWinRate {};
+ 
+     /**
+      * @brief Rounds within the last RoundStatisticsOptions::windowNanos.
+      */
+     ResultCounts recentTime {};
+ 
+     double decayedWinRate {};
+     double decayedLatencyNanos {};
+ 
+     /**
+      * @brief Decision latency of rounds this name played as the user.
+      */
+     QuantileSketch latencyNanos {};
+ 
+     /**
+      * @brief Rounds per finished session.
+      */
+     QuantileSketch sessionRounds {};
+ };
+ 
+ /**
+  * @brief Live per-name statistics fed by round events.
+  */
+ class RoundStatistics : public IRoundObserver {
+ public:
+     /**
+      * @brief Returns the current time in nanoseconds for the time windows.
+      */
+     using Clock = std::function<std::uint64_t()>;
+ 
+     /**
+      * @param options Window sizes and decay.
+      * @param clock   Time source; defaults to std::chrono::steady_clock.
+      * @throws std::invalid_argument if a window or the decay is invalid.
+      */
+     explicit RoundStatistics(RoundStatisticsOptions options = {}, Clock clock = {});
+ 
+     void OnRound(const RoundRecord& record) override;
+     void OnSessionEnd(const SessionSummary& summary) override;
+ 
+     /**
+      * @brief Returns a snapshot of one name's statistics, if it was ever seen.
+      */
+     std::optional<PlayerStatisticsSnapshot> Snapshot(std::string_view name) const;
+ 
+     /**
+      * @brief Returns every name seen so far, in order of first appearance.
+      */
+     std::vector<std::string> Names() const;
+ 
+ private:
+     struct PlayerStatistics {
+         PlayerStatistics(std::string playerName, const RoundStatisticsOptions& options);
+ 
+         void Add(RoundResult result, std::uint8_t move, std::uint64_t nowNanos);
+ 
+         std::string name {};
+         mutable std::mutex mutex {};
+         ResultCounts totals {};
+         std::uint64_t longestWinStreak {};
+         RoundWindow rounds;
+         TimeWindow time;
+         Ewma winRate;
+         Ewma latency;
+         QuantileSketch latencyNanos {};
+         QuantileSketch sessionRounds {};
+     };
+ 
+     PlayerStatistics& Statistics(std::string_view name);
+ 
+     RoundStatisticsOptions m_options {};
+     Clock m_clock {};
+ 
+     mutable std::shared_mutex m_namesMutex {};
+     std::unordered_map<std::string_view, std::unique_ptr<PlayerStatistics>> m_players {};
+     std::vector<std::string_view> m_order {};
+ };
+ 
\ No newline at end of file
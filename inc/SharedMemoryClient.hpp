@@ -0,0 +1,62 @@
+/**
+ * @file SharedMemoryClient.hpp
+ * @brief Declares the SharedMemoryClient class.
+ *
+ * SharedMemoryClient is the client-process side of a SharedMemorySegment:
+ * it reads the game's announcements in place and submits moves, either
+ * record by record or by letting Serve() answer with an IMoveStrategy.
+ */
+
+ #pragma once
+
+ #include "GameMove.hpp"
+ #include "IMoveStrategy.hpp"
+ #include "SharedMemorySegment.hpp"
+ #include <memory>
+ 
+ /**
+  * @brief Plays the user side of a game over a shared-memory segment.
+  */
+ class SharedMemoryClient {
+ public:
+     explicit SharedMemoryClient(std::shared_ptr<SharedMemorySegment> segment);
+ 
+     /**
+      * @brief Destructor. Closes the ring to the game so it stops waiting for moves.
+      */
+     ~SharedMemoryClient();
+ 
+     SharedMemoryClient(const SharedMemoryClient&) = delete;
+     SharedMemoryClient& operator=(const SharedMemoryClient&) = delete;
+ 
+     /**
+      * @brief Waits for the next record from the game and returns it in place.
+      * @return The record (valid until Consume()), or nullptr once the game has closed the ring.
+      */
+     const ShmRing::Record* NextAnnouncement();
+ 
+     /**
+      * @brief Releases the record returned by NextAnnouncement().
+      */
+     void Consume();
+ 
+     /**
+      * @brief Sends one move to the game.
+      * @return False if the game has gone away.
+      */
+     bool SubmitMove(GameMove move);
+ 
+     /**
+      * @brief Answers every MoveRequest with the strategy until FinalScore.
+      *
+      * Reports each completed round to the strategy; this needs the game
+      * side to have called SharedMemoryMessenger::SetParticipants().
+      *
+      * @return 0 after FinalScore, 1 if the game went away first.
+      */
+     int Serve(IMoveStrategy& strategy);
+ 
+ private:
+     std::shared_ptr<SharedMemorySegment> m_segment {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,85 @@
+/**
+ * @file SharedMemoryMessenger.hpp
+ * @brief Declares the SharedMemoryMessenger class.
+ *
+ * SharedMemoryMessenger is the game-side IGameMessenger for a client
+ * running in another process on the same host. Every announcement becomes
+ * one record in the segment's ToClient() ring and moves come back through
+ * ToServer(); see SharedMemorySegment for the record layout.
+ */
+
+ #pragma once
+
+ #include "IGameMessenger.hpp"
+ #include "SharedMemorySegment.hpp"
+ #include <cstddef>
+ #include <memory>
+ #include <string>
+ 
+ /**
+  * @brief An IGameMessenger whose user is a process across a shared-memory segment.
+  */
+ class SharedMemoryMessenger : public IGameMessenger {
+ public:
+     /**
+      * @brief Constructs a messenger on a mapped segment.
+      * @param segment      The segment shared with the client.
+      * @param userName     Returned by RequestUserPlayerName().
+      * @param computerName Returned by RequestComputerPlayerName().
+      * @param rounds       Returned by RequestNumberOfRounds().
+      * @param maxBatch     Most moves requested per exchange; keep 1 for
+      *                     clients that react to each round.
+      */
+     SharedMemoryMessenger(std::shared_ptr<SharedMemorySegment> segment,
+                           std::string userName,
+                           std::string computerName,
+                           int rounds,
+                           std::size_t maxBatch = 1);
+ 
+     /**
+      * @brief Destructor. Closes the ring to the client so it stops waiting.
+      */
+     virtual ~SharedMemoryMessenger();
+ 
+     /**
+      * @brief Tells the messenger which player is which, so announcements carry sides.
+      */
+     void SetParticipants(std::shared_ptr<IPlayer> userPlayer, std::shared_ptr<IPlayer> computerPlayer);
+ 
+     void ShowWelcomeScreen() override;
+     std::string RequestUserPlayerName() override;
+     std::string RequestComputerPlayerName() override;
+     int RequestNumberOfRounds() override;
+     void ShowSetupComplete() override;
+ 
+     /**
+      * @brief Requests one move; returns -1 if the client has gone away.
+      */
+     int RequestMoveChoice() override;
+ 
+     /**
+      * @brief Requests up to maxCount moves (capped by maxBatch) in one exchange.
+      */
+     std::size_t RequestMoveChoices(int* moves, std::size_t maxCount) override;
+ 
+     void DisplayChosenMove(const std::shared_ptr<IPlayer>& player, GameMove move) override;
+     void AnnounceRoundWinner(const std::shared_ptr<IPlayer>& winner) override;
+     void AnnounceDraw() override;
+     void ShowFinalScore(const std::shared_ptr<IPlayer>& userPlayer,
+                         const std::shared_ptr<IPlayer>& computerPlayer) override;
+     void ShowInvalidInputMessage() override;
+ 
+ private:
+     void Send(ShmMessageType type, std::int32_t a = 0, std::int32_t b = 0);
+     std::int32_t SideOf(const std::shared_ptr<IPlayer>& player) const;
+ 
+ private:
+     std::shared_ptr<SharedMemorySegment> m_segment {};
+     std::string m_userName {};
+     std::string m_computerName {};
+     int m_rounds {};
+     std::size_t m_maxBatch {1};
+     std::shared_ptr<IPlayer> m_userPlayer {};
+     std::shared_ptr<IPlayer> m_computerPlayer {};
+ };
+ 
\ No newline at end of file
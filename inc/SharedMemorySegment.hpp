@@ -0,0 +1,110 @@
+/**
+ * @file SharedMemorySegment.hpp
+ * @brief Declares the SharedMemorySegment class and its message types.
+ *
+ * A SharedMemorySegment is a named POSIX shared-memory object holding two
+ * ShmRing instances: one from the game (server) to a co-located client and
+ * one back. The game side speaks through SharedMemoryMessenger and the
+ * client side through SharedMemoryClient, using these records:
+ *
+ * | Type          | Direction       | a           | b             |
+ * | ------------- | --------------- | ----------- | ------------- |
+ * | Welcome       | game -> client  |             |               |
+ * | SetupComplete | game -> client  |             |               |
+ * | MoveRequest   | game -> client  | move count  |               |
+ * | ChosenMove    | game -> client  | side        | move          |
+ * | RoundWinner   | game -> client  | side        |               |
+ * | Draw          | game -> client  |             |               |
+ * | InvalidInput  | game -> client  |             |               |
+ * | FinalScore    | game -> client  | user score  | computer score|
+ * | Move          | client -> game  | move        |               |
+ *
+ * A client answers a MoveRequest with exactly `count` Move records. Sides
+ * are kSideUser / kSideComputer, or kSideUnknown if the messenger was not
+ * told which player is which. Moves use GameMove values.
+ */
+
+ #pragma once
+
+ #include "ShmRing.hpp"
+ #include <cstdint>
+ #include <memory>
+ #include <string>
+ 
+ /**
+  * @brief Kinds of records exchanged over a SharedMemorySegment.
+  */
+ enum class ShmMessageType : std::int32_t
+ {
+     Welcome = 1,
+     SetupComplete,
+     MoveRequest,
+     ChosenMove,
+     RoundWinner,
+     Draw,
+     InvalidInput,
+     FinalScore,
+     Move
+ };
+ 
+ inline constexpr std::int32_t kSideUnknown {0};
+ inline constexpr std::int32_t kSideUser {1};
+ inline constexpr std::int32_t kSideComputer {2};
+ 
+ /**
+  * @brief A mapped shared-memory object with a ring in each direction.
+  */
+ class SharedMemorySegment {
+ public:
+     /**
+      * @brief Creates and maps a new segment; the name must not exist yet.
+      * @param name POSIX shared-memory name, e.g. "/rps-1234".
+      * @throws std::system_error if the object cannot be created or mapped.
+      */
+     static std::shared_ptr<SharedMemorySegment> Create(const std::string& name);
+ 
+     /**
+      * @brief Maps a segment created by another process.
+      * @throws std::system_error if it cannot be opened or mapped, or is not a segment.
+      */
+     static std::shared_ptr<SharedMemorySegment> Open(const std::string& name);
+ 
+     /**
+      * @brief Unmaps the segment; the creator also removes its name.
+      */
+     ~SharedMemorySegment();
+ 
+     SharedMemorySegment(const SharedMemorySegment&) = delete;
+     SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+ 
+     /**
+      * @brief Removes the name early; existing mappings stay valid.
+      */
+     void Unlink();
+ 
+     const std::string& Name() const;
+ 
+     /**
+      * @brief Ring carrying announcements and move requests to the client.
+      */
+     ShmRing& ToClient();
+ 
+     /**
+      * @brief Ring carrying moves to the game.
+      */
+     ShmRing& ToServer();
+ 
+ private:
+     struct Region;
+ 
+     SharedMemorySegment(std::string name, Region* region, bool owner);
+     static Region* Map(int fd);
+ 
+ private:
+     std::string m_name {};
+     Region* m_region {};
+     bool m_owner {};
+     ShmRing m_toClient {};
+     ShmRing m_toServer {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,120 @@
+/**
+ * @file ShmRing.hpp
+ * @brief Declares the ShmRing class.
+ *
+ * ShmRing is a single-producer, single-consumer ring of fixed-size records
+ * that lives in memory shared between two processes. Records are read in
+ * place (Peek() returns a pointer into the ring), and neither side makes a
+ * system call while the ring has work for it: a side that finds nothing to
+ * do spins briefly, then sleeps on a futex that the other side only wakes
+ * when it has announced that it is sleeping.
+ */
+
+ #pragma once
+
+ #include <atomic>
+ #include <cstddef>
+ #include <cstdint>
+ 
+ /**
+  * @brief A handle to an SPSC record ring in shared memory.
+  */
+ class ShmRing {
+ public:
+     /**
+      * @brief One message; its meaning is up to the users of the ring.
+      */
+     struct Record {
+         std::int32_t type {};
+         std::int32_t a {};
+         std::int32_t b {};
+         std::int32_t c {};
+     };
+ 
+     /**
+      * @brief Number of records the ring holds; a power of two.
+      */
+     static constexpr std::uint32_t kCapacity {256};
+ 
+     /**
+      * @brief The ring as laid out in shared memory.
+      *
+      * The producer-owned and consumer-owned counters sit on separate cache
+      * lines so the two processes do not invalidate each other's writes.
+      */
+     struct Layout {
+         alignas(64) std::atomic<std::uint32_t> head {};
+         alignas(64) std::atomic<std::uint32_t> tail {};
+         alignas(64) std::atomic<std::uint32_t> consumerWaiting {};
+         std::atomic<std::uint32_t> producerWaiting {};
+         std::atomic<std::uint32_t> closed {};
+         alignas(64) Record records[kCapacity] {};
+     };
+ 
+     /**
+      * @brief Default number of polls before a side sleeps on the futex.
+      */
+     static constexpr int kSpinCount {128};
+ 
+     /**
+      * @brief Constructs a handle; `layout` must already be initialized.
+      * @param spinCount Polls before sleeping; 0 sleeps at once.
+      */
+     explicit ShmRing(Layout* layout = nullptr, int spinCount = kSpinCount);
+ 
+     /**
+      * @brief Constructs an empty, open ring in raw shared memory.
+      */
+     static void Initialize(void* memory);
+ 
+     /**
+      * @brief Appends a record if there is room. Never blocks.
+      * @return False if the ring is full or closed.
+      */
+     bool TryPush(const Record& record);
+ 
+     /**
+      * @brief Appends a record, waiting for room if the ring is full.
+      * @return False if the ring was closed.
+      */
+     bool Push(const Record& record);
+ 
+     /**
+      * @brief Returns the oldest record in place, or nullptr if the ring is empty.
+      */
+     const Record* TryPeek() const;
+ 
+     /**
+      * @brief Returns the oldest record in place, waiting for one if needed.
+      * @return nullptr once the ring is closed and drained.
+      */
+     const Record* Peek();
+ 
+     /**
+      * @brief Releases the record returned by the last Peek() or TryPeek().
+      */
+     void Pop();
+ 
+     /**
+      * @brief Closes the ring and wakes both sides; pending records can still be read.
+      */
+     void Close();
+ 
+     bool IsClosed() const;
+ 
+     /**
+      * @brief Returns the system calls this handle has made (futex waits and wakes, yields).
+      */
+     std::size_t SyscallCount() const;
+ 
+ private:
+     void AwaitChange(std::atomic<std::uint32_t>& word, std::uint32_t observed,
+                      std::atomic<std::uint32_t>& waitingFlag);
+     void WakeIfWaiting(std::atomic<std::uint32_t>& word, std::atomic<std::uint32_t>& waitingFlag);
+ 
+ private:
+     Layout* m_layout {};
+     int m_spinCount {kSpinCount};
+     std::size_t m_syscalls {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,157 @@
+/**
+ * @file SimulationResult.hpp
+ * @brief Declares SimulationConfig and the mergeable SimulationResult.
+ *
+ * A simulation campaign plays `totalMatches` independent matches between
+ * two built-in strategies. Work is split into shards by match index; each
+ * shard produces a SimulationResult covering its index range, and results
+ * merge by adding integer counters. Because every counter is an integer
+ * and every match draws from its own RNG stream, merging shards in any
+ * grouping or order gives bit-identical output to a single-shard run.
+ */
+
+ #pragma once
+
+ #include <array>
+ #include <cstddef>
+ #include <cstdint>
+ #include <string>
+ #include <utility>
+ #include <vector>
+ 
+ /**
+  * @brief Parameters of a simulation campaign; identical for all of its shards.
+  */
+ struct SimulationConfig {
+     std::uint64_t masterSeed {};
+     std::uint64_t totalMatches {};
+     std::uint32_t roundsPerMatch {};
+     std::string userStrategy {};
+     std::string computerStrategy {};
+ 
+     /**
+      * @brief Ratings both sides start every match with, for rating deltas.
+      */
+     std::int32_t userRating {1500};
+     std::int32_t computerRating {1500};
+ 
+     bool operator==(const SimulationConfig& other) const;
+     bool operator!=(const SimulationConfig& other) const;
+ };
+ 
+ /**
+  * @brief Aggregated outcome of some or all matches of a campaign.
+  */
+ class SimulationResult {
+ public:
+     /**
+      * @brief Number of buckets in the match-margin histogram.
+      *
+      * Bucket b counts matches whose (userWins - computerWins) / rounds
+      * falls in [-1 + 2b/(N-1), ...); the middle bucket is an even match.
+      */
+     static constexpr std::size_t kMarginBuckets {41};
+ 
+     SimulationResult() = default;
+ 
+     /**
+      * @brief Constructs an empty result for the matches [begin, end) of a campaign.
+      */
+     SimulationResult(SimulationConfig config, std::uint64_t begin, std::uint64_t end);
+ 
+     /**
+      * @brief Records one finished match.
+      * @param moveCounts Round counts indexed [userMove - 1][computerMove - 1].
+      */
+     void AddMatch(const std::array<std::array<std::uint64_t, 3>, 3>& moveCounts);
+ 
+     /**
+      * @brief Adds another shard's result to this one.
+      * @throws std::invalid_argument if the campaigns differ or the match ranges overlap.
+      */
+     void Merge(const SimulationResult& other);
+ 
+     /**
+      * @brief Loads and merges any number of result files on up to `threads` threads.
+      *
+      * Each thread loads and folds a contiguous slice of `paths`; the slices
+      * are then merged. Counters are integers, so the output does not depend
+      * on the order of `paths` or on `threads`.
+      * @throws std::runtime_error or std::invalid_argument as Load() and Merge().
+      */
+     static SimulationResult MergeFiles(const std::vector<std::string>& paths, unsigned threads);
+ 
+     /**
+      * @brief Writes the result in its little-endian binary format.
+      * @throws std::runtime_error if the file cannot be written.
+      */
+     void Save(const std::string& path) const;
+ 
+     /**
+      * @brief Reads a result written by Save().
+      * @throws std::runtime_error if the file is missing or malformed.
+      */
+     static SimulationResult Load(const std::string& path);
+ 
+     std::vector<std::uint8_t> Serialize() const;
+     static SimulationResult Deserialize(const std::vector<std::uint8_t>& bytes);
+ 
+     const SimulationConfig& Config() const;
+ 
+     /**
+      * @brief Match index ranges covered, sorted and coalesced.
+      */
+     const std::vector<std::pair<std::uint64_t, std::uint64_t>>& Coverage() const;
+ 
+     /**
+      * @brief Returns true once every match of the campaign is covered.
+      */
+     bool IsComplete() const;
+ 
+     std::uint64_t Matches() const;
+     std::uint64_t Rounds() const;
+     std::uint64_t UserRoundWins() const;
+     std::uint64_t ComputerRoundWins() const;
+     std::uint64_t DrawnRounds() const;
+     std::uint64_t UserMatchWins() const;
+     std::uint64_t ComputerMatchWins() const;
+     std::uint64_t DrawnMatches() const;
+ 
+     /**
+      * @brief Sum of the user's per-match Elo changes, in thousandths of a point.
+      */
+     std::int64_t UserRatingDeltaMilli() const;
+ 
+     /**
+      * @brief Round counts indexed [userMove - 1][computerMove - 1].
+      */
+     const std::array<std::array<std::uint64_t, 3>, 3>& MoveCounts() const;
+ 
+     const std::array<std::uint64_t, kMarginBuckets>& MarginHistogram() const;
+ 
+     bool operator==(const SimulationResult& other) const;
+     bool operator!=(const SimulationResult& other) const;
+ 
+ private:
+     /**
+      * @brief Elo change (milli-points) for a match result: 2 win, 1 draw, 0 loss.
+      */
+     std::int64_t RatingDeltaMilli(int userResult) const;
+ 
+ private:
+     SimulationConfig m_config {};
+     std::vector<std::pair<std::uint64_t, std::uint64_t>> m_coverage {};
+ 
+     std::uint64_t m_matches {};
+     std::uint64_t m_rounds {};
+     std::uint64_t m_userRoundWins {};
+     std::uint64_t m_computerRoundWins {};
+     std::uint64_t m_drawnRounds {};
+     std::uint64_t m_userMatchWins {};
+     std::uint64_t m_computerMatchWins {};
+     std::uint64_t m_drawnMatches {};
+     std::int64_t m_userRatingDeltaMilli {};
+     std::array<std::array<std::uint64_t, 3>, 3> m_moveCounts {};
+     std::array<std::uint64_t, kMarginBuckets> m_marginHistogram {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,71 @@
+/**
+ * @file SimulationRunner.hpp
+ * @brief Declares the SimulationRunner class.
+ *
+ * SimulationRunner plays the matches of a SimulationConfig headlessly,
+ * strategy against strategy, without sessions, players or messengers.
+ * A campaign is split into shards of consecutive match indices; every
+ * match seeds its two strategies from its own Xoshiro256 stream, keyed
+ * by the master seed and the match index, so a match plays identically
+ * whichever shard, process or machine it lands on.
+ */
+
+ #pragma once
+
+ #include "IRoundObserver.hpp"
+ #include "SimulationResult.hpp"
+ #include <array>
+ #include <cstdint>
+ #include <utility>
+ 
+ /**
+  * @brief Runs shards of a simulation campaign.
+  */
+ class SimulationRunner {
+ public:
+     /**
+      * @brief Constructs a runner for the given campaign.
+      * @throws std::invalid_argument if either strategy name is unknown.
+      */
+     explicit SimulationRunner(SimulationConfig config);
+ 
+     /**
+      * @brief Returns the match range [begin, end) of shard `index` of `count`.
+      *
+      * Shards are contiguous and differ in size by at most one match.
+      * @throws std::invalid_argument if `index` is not below `count`.
+      */
+     static std::pair<std::uint64_t, std::uint64_t> ShardRange(std::uint64_t totalMatches,
+                                                               std::uint64_t index,
+                                                               std::uint64_t count);
+ 
+     /**
+      * @brief Plays every match of shard `index` of `count`.
+      * @param observer Optional; receives every round, with the match index as session id.
+      */
+     SimulationResult RunShard(std::uint64_t index, std::uint64_t count,
+                               IRoundObserver* observer = nullptr) const;
+ 
+     /**
+      * @brief Plays the matches [begin, end).
+      * @param observer Optional; receives every round, with the match index as session id.
+      * @throws std::invalid_argument if the range is outside the campaign.
+      */
+     SimulationResult RunRange(std::uint64_t begin, std::uint64_t end,
+                               IRoundObserver* observer = nullptr) const;
+
+     /**
+      * @brief Plays match `match` alone; the round kernel behind RunRange().
+      *
+      * The match index need not be below totalMatches, so open-ended
+      * callers can keep drawing matches from the same seeding scheme.
+      * @param moveCounts Incremented per round, indexed [userMove - 1][computerMove - 1].
+      * @param observer   Optional; receives every round, with the match index as session id.
+      */
+     void PlayMatch(std::uint64_t match, std::array<std::array<std::uint64_t, 3>, 3>& moveCounts,
+                    IRoundObserver* observer = nullptr) const;
+ 
+ private:
+     SimulationConfig m_config {};
+ };
+ 
\ No newline at end of file
@@ -3,7 +3,8 @@
  * @brief Declares the SinglePlayerRpsGame class.
  *
  * SinglePlayerRpsGame implements a simple user-vs-computer version of
- * Rock-Paper-Scissors using the IGameSession interface.
+ * Rock-Paper-Scissors using the IGameSession interface. A match ends after
+ * its number of rounds, or earlier once its MatchRules decide it.
  */
 
  #pragma once
@@ -12,6 +13,12 @@
  #include "IPlayer.hpp"
  #include "IGameMessenger.hpp"
  #include "GameMove.hpp"
+ #include "GameRules.hpp"
+ #include "IRoundObserver.hpp"
+ #include "MatchRules.hpp"
+ #include <array>
+ #include <cstddef>
+ #include <cstdint>
  #include <memory>
  #include <unordered_map>
  #include <functional>
@@ -38,14 +45,16 @@
       * @param userPlayer         The human user player.
       * @param computerPlayer     The computer (AI) player.
       * @param messenger          Messenger for input/output.
-      * @param numberOfRounds     How many rounds to play.
+      * @param numberOfRounds     How many rounds to play at most.
       * @param randomGenerator    A function that returns random integers (used for AI moves).
+      * @param rules              When the match may end before numberOfRounds.
       */
      SinglePlayerRpsGame(std::shared_ptr<IPlayer> userPlayer,
                          std::shared_ptr<IPlayer> computerPlayer,
                          std::unique_ptr<IGameMessenger> messenger,
                          int numberOfRounds,
-                         std::function<int()> randomGenerator);
+                         std::function<int()> randomGenerator,
+                         MatchRules rules = {});
  
      /**
       * @brief Destructor.
@@ -53,16 +62,58 @@
      virtual ~SinglePlayerRpsGame() = default;
  
      /**
-      * @brief Starts the game loop for the configured number of rounds.
+      * @brief Plays rounds until the match is finished.
       */
      void Play() override;
+
+     /**
+      * @brief Plays exactly one round.
+      *
+      * Lets event-driven hosts (bot arenas, servers) advance the session as
+      * moves become available instead of blocking inside Play().
+      * Must not be called once IsFinished() returns true.
+      */
+     void PlayRound();
+
+     /**
+      * @brief Shows the final score and ends the session for the observer.
+      *        Call once, after the last round.
+      */
+     void Finish();
+
+     /**
+      * @brief Returns true once every configured round has been played
+      *        or the match rules have decided the match.
+      */
+     bool IsFinished() const;
+
+     /**
+      * @brief Returns the number of rounds played so far.
+      */
+     int RoundsPlayed() const;
+ 
+     /**
+      * @brief Reports every following round to `observer`, tagged with `sessionId`.
+      *
+      * The observer is not owned and must outlive the session; pass nullptr
+      * to stop reporting. Move timings are only measured while observed.
+      * To report to several observers, pass a RoundObserverFanOut.
+      */
+     void SetRoundObserver(IRoundObserver* observer, std::uint64_t sessionId);
  
  private:
      /**
       * @brief Gets the moves for both the user and the computer for a round.
+      * @param roundsRemaining Rounds certain to be played including this one; bounds batch requests.
       * @return A tuple: (isValidMove, userMove, computerMove).
       */
-     std::tuple<bool, GameMove, GameMove> ObtainMoves();
+     std::tuple<bool, GameMove, GameMove> ObtainMoves(int roundsRemaining);
+
+     /**
+      * @brief Returns the next user move choice, refilling the batch if empty.
+      * @param roundsRemaining Rounds certain to be played including this one.
+      */
+     int NextUserChoice(int roundsRemaining);
  
      /**
       * @brief Displays both players' moves for the current round.
@@ -85,21 +136,25 @@
       */
      void ProcessRoundResult(ParticipantType winnerType);
  
+     /**
+      * @brief Sends the finished round to the observer.
+      */
+     void ReportRound(bool isValidMove, GameMove userMove, GameMove computerMove,
+                      ParticipantType winnerType, std::uint64_t decisionNanos);
+ 
  private:
      /**
       * @brief Checks if both moves are the same.
       */
      static constexpr bool IsRoundDraw(GameMove userMove, GameMove computerMove) {
-         return userMove == computerMove;
+         return ::IsRoundDraw(userMove, computerMove);
      }
  
      /**
       * @brief Checks if the user (human) player wins against the computer's move.
       */
      static constexpr bool DoesUserWinRound(GameMove userMove, GameMove computerMove) {
-         return ((userMove == GameMove::Rock     && computerMove == GameMove::Scissors) ||
-                 (userMove == GameMove::Paper    && computerMove == GameMove::Rock)     ||
-                 (userMove == GameMove::Scissors && computerMove == GameMove::Paper));
+         return DoesFirstMoveWin(userMove, computerMove);
      }
  
  private:
@@ -108,6 +163,29 @@
      std::unique_ptr<IGameMessenger> m_messenger {};
      int m_numberOfRounds {};
      std::function<int()> m_randomGenerator {};
+     int m_roundsPlayed {};
+     IRoundObserver* m_roundObserver {nullptr};
+     std::uint64_t m_sessionId {};
+     MatchRules m_rules {};
+
+     /**
+      * @brief Round wins, kept here so the rules never call into the players.
+      */
+     int m_userWins {};
+     int m_computerWins {};
+     bool m_decided {};
+
+     /**
+      * @brief Largest number of user moves requested from the messenger at once.
+      */
+     static constexpr std::size_t kMoveBatchSize {64};
+
+     /**
+      * @brief User choices received but not yet played.
+      */
+     std::array<int, kMoveBatchSize> m_pendingChoices {};
+     std::size_t m_pendingCount {};
+     std::size_t m_pendingIndex {};
  
      /**
       * @brief Maps participant types to the actual player instances.
@@ -0,0 +1,170 @@
+/**
+ * @file SpectatorChannel.hpp
+ * @brief Declares the SpectatorChannel class.
+ *
+ * SpectatorChannel fans a stream of frames out to any number of spectator
+ * connections. A frame is encoded once into an immutable, reference-counted
+ * buffer; publishing it only appends the pointer to a queue, so the match
+ * never waits on spectators. A fan-out thread moves queued frames into a
+ * ring and writes each subscriber's unsent frames with one scatter-gather
+ * send pointing straight into the shared buffers.
+ *
+ * A subscriber that falls more than the ring size behind is either
+ * disconnected or moved to the latest frame, depending on the policy;
+ * either way the others are unaffected.
+ */
+
+ #pragma once
+
+ #include <atomic>
+ #include <cstddef>
+ #include <cstdint>
+ #include <deque>
+ #include <memory>
+ #include <mutex>
+ #include <string>
+ #include <thread>
+ #include <vector>
+ 
+ /**
+  * @brief An encoded frame, shared by every subscriber it is sent to.
+  */
+ using SpectatorFrame = std::shared_ptr<const std::string>;
+ 
+ /**
+  * @brief What happens to a subscriber that falls too far behind.
+  */
+ enum class SlowSubscriberPolicy
+ {
+     /**
+      * @brief Close its connection.
+      */
+     Disconnect,
+ 
+     /**
+      * @brief Skip the frames it missed and continue with the latest one.
+      *
+      * Suits streams whose frames each carry the full state, such as a
+      * running score.
+      */
+     SkipToLatest
+ };
+ 
+ struct SpectatorOptions {
+     /**
+      * @brief Frames kept for subscribers that are behind; a power of two.
+      */
+     std::size_t backlogFrames {256};
+     SlowSubscriberPolicy policy {SlowSubscriberPolicy::SkipToLatest};
+ };
+ 
+ /**
+  * @brief Counters describing the channel since it was created.
+  */
+ struct SpectatorStats {
+     std::uint64_t framesPublished {};
+     std::uint64_t subscribers {};
+ 
+     /**
+      * @brief Subscribers closed because they hung up or, under Disconnect, fell behind.
+      */
+     std::uint64_t disconnected {};
+ 
+     /**
+      * @brief Frames slow subscribers skipped under SkipToLatest, summed over subscribers.
+      */
+     std::uint64_t skippedFrames {};
+     std::uint64_t bytesSent {};
+     std::uint64_t sendCalls {};
+ };
+ 
+ /**
+  * @brief Broadcasts frames to spectator connections from a background thread.
+  */
+ class SpectatorChannel {
+ public:
+     /**
+      * @brief Starts the fan-out thread.
+      * @throws std::invalid_argument if backlogFrames is not a power of two.
+      * @throws std::system_error if the event loop cannot be set up.
+      */
+     explicit SpectatorChannel(SpectatorOptions options = {});
+ 
+     /**
+      * @brief Stops the fan-out thread and closes every subscriber connection.
+      *
+      * Frames not yet sent are discarded.
+      */
+     ~SpectatorChannel();
+ 
+     SpectatorChannel(const SpectatorChannel&) = delete;
+     SpectatorChannel& operator=(const SpectatorChannel&) = delete;
+ 
+     /**
+      * @brief Wraps encoded bytes into a frame.
+      */
+     static SpectatorFrame MakeFrame(std::string bytes);
+ 
+     /**
+      * @brief Adds a subscriber, taking ownership of a connected stream socket.
+      *
+      * The socket is made non-blocking. The subscriber receives the latest
+      * frame, if any, followed by every frame published afterwards.
+      *
+      * @throws std::system_error if the socket cannot be made non-blocking.
+      */
+     void Subscribe(int socketFd);
+ 
+     /**
+      * @brief Queues a frame for every subscriber. Never blocks on I/O.
+      */
+     void Publish(SpectatorFrame frame);
+ 
+     SpectatorStats Stats() const;
+ 
+ private:
+     struct Subscriber;
+ 
+     void Run();
+     void Wake();
+     void TakePending();
+     bool Send(Subscriber& subscriber);
+ 
+     /**
+      * @brief Applies the slow-subscriber policy; false if it must be closed.
+      */
+     bool CatchUp(Subscriber& subscriber);
+     void Close(Subscriber& subscriber);
+ 
+     SpectatorOptions m_options {};
+     int m_epollFd {-1};
+     int m_wakeFd {-1};
+ 
+     /**
+      * @brief Frames and subscribers handed over to the fan-out thread.
+      */
+     std::mutex m_pendingMutex {};
+     std::deque<SpectatorFrame> m_pendingFrames {};
+     std::uint64_t m_pendingDropped {};
+     std::vector<int> m_pendingSubscribers {};
+     std::atomic<bool> m_wakePending {false};
+     std::atomic<bool> m_stopping {false};
+     std::deque<SpectatorFrame> m_takenFrames {};
+ 
+     /**
+      * @brief The last backlogFrames frames, indexed by sequence; fan-out thread only.
+      */
+     std::vector<SpectatorFrame> m_ring {};
+     std::uint64_t m_head {};
+     std::vector<std::unique_ptr<Subscriber>> m_subscribers {};
+ 
+     std::atomic<std::uint64_t> m_framesPublished {};
+     std::atomic<std::uint64_t> m_subscriberCount {};
+     std::atomic<std::uint64_t> m_disconnected {};
+     std::atomic<std::uint64_t> m_skippedFrames {};
+     std::atomic<std::uint64_t> m_bytesSent {};
+     std::atomic<std::uint64_t> m_sendCalls {};
+ 
+     std::thread m_thread {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,48 @@
+/**
+ * @file SpectatorFeed.hpp
+ * @brief Declares the SpectatorFeed class.
+ *
+ * SpectatorFeed is an IRoundObserver that turns rounds into spectator
+ * frames. Each round is formatted once, as one line of text carrying the
+ * moves, the round's winner and the running score, and published to a
+ * SpectatorChannel. Because every line repeats the score, a spectator
+ * that skips lines still sees the current state.
+ */
+
+ #pragma once
+
+ #include "IRoundObserver.hpp"
+ #include "SpectatorChannel.hpp"
+ #include <cstdint>
+ #include <mutex>
+ #include <unordered_map>
+ 
+ /**
+  * @brief Publishes a text line per round and per finished session.
+  */
+ class SpectatorFeed : public IRoundObserver {
+ public:
+     /**
+      * @param channel Receives the frames; must outlive the feed.
+      */
+     explicit SpectatorFeed(SpectatorChannel& channel);
+ 
+     void OnRound(const RoundRecord& record) override;
+     void OnSessionEnd(const SessionSummary& summary) override;
+ 
+ private:
+     struct Score {
+         std::uint32_t userWins {};
+         std::uint32_t computerWins {};
+         std::uint32_t draws {};
+     };
+ 
+     SpectatorChannel& m_channel;
+ 
+     /**
+      * @brief Running score of each session in progress.
+      */
+     std::mutex m_mutex {};
+     std::unordered_map<std::uint64_t, Score> m_scores {};
+ };
+ 
\ No newline at end of file
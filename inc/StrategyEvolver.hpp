@@ -0,0 +1,144 @@
+/**
+ * @file StrategyEvolver.hpp
+ * @brief Declares the StrategyEvolver genetic algorithm.
+ *
+ * StrategyEvolver evolves a population of StrategyGenome lookup tables
+ * against a fixed portfolio of built-in opponents. One Step() is one
+ * generation:
+ *   1. every individual plays matchesPerOpponent headless matches against
+ *      each opponent, on all worker threads;
+ *   2. its fitness is its round wins minus round losses over all of them;
+ *   3. the next population keeps the best eliteCount genomes unchanged and
+ *      fills up with children of tournament-selected parents (uniform
+ *      crossover, then per-gene mutation).
+ *
+ * Every match and every generation's breeding draw from their own
+ * Xoshiro256 stream of the master seed, and fitness is an integer, so a
+ * run does not depend on the thread count. Checkpoints hold the config
+ * and the population about to be evaluated; resuming from one continues
+ * exactly as if the run had not stopped.
+ */
+
+ #pragma once
+
+ #include "StrategyGenome.hpp"
+ #include <cstdint>
+ #include <string>
+ #include <vector>
+ 
+ /**
+  * @brief Parameters of an evolution run.
+  */
+ struct EvolutionConfig {
+     std::uint64_t masterSeed {};
+     std::uint32_t historyLength {2};
+     std::uint32_t populationSize {64};
+     std::uint32_t roundsPerMatch {100};
+     std::uint32_t matchesPerOpponent {4};
+ 
+     /**
+      * @brief Built-in strategy names (see MakeMoveStrategy()) to play against.
+      */
+     std::vector<std::string> opponents {"rock", "cycle", "random", "copycat", "counter"};
+     std::uint32_t eliteCount {2};
+     std::uint32_t tournamentSize {3};
+ 
+     /**
+      * @brief Probability that a child's gene is replaced by a random move.
+      */
+     double mutationRate {0.02};
+ 
+     bool operator==(const EvolutionConfig& other) const;
+     bool operator!=(const EvolutionConfig& other) const;
+ };
+ 
+ /**
+  * @brief What one generation's evaluation found.
+  */
+ struct GenerationReport {
+     std::uint32_t generation {};
+ 
+     /**
+      * @brief Fitness per round, in [-1, 1]: (wins - losses) / rounds.
+      */
+     double bestFitness {};
+     double meanFitness {};
+     std::uint64_t matches {};
+     double seconds {};
+ 
+     double MatchesPerSecond() const;
+ };
+ 
+ /**
+  * @brief Runs a genetic algorithm over StrategyGenome populations.
+  */
+ class StrategyEvolver {
+ public:
+     /**
+      * @brief Creates generation 0 with random genomes.
+      * @param threads Worker threads for evaluation; 0 uses every hardware thread.
+      * @throws std::invalid_argument if the config is inconsistent or names an unknown opponent.
+      */
+     explicit StrategyEvolver(EvolutionConfig config, unsigned threads = 0);
+ 
+     /**
+      * @brief Evaluates the current generation and breeds the next one.
+      */
+     GenerationReport Step();
+ 
+     /**
+      * @brief The generation Step() evaluates next.
+      */
+     std::uint32_t Generation() const;
+ 
+     /**
+      * @brief The population Step() evaluates next.
+      */
+     const std::vector<StrategyGenome>& Population() const;
+ 
+     /**
+      * @brief Best genome of the last evaluated generation.
+      * @throws std::logic_error before the first Step().
+      */
+     const StrategyGenome& Best() const;
+ 
+     /**
+      * @brief Fitness of Best(), as in GenerationReport::bestFitness.
+      */
+     double BestFitness() const;
+ 
+     const EvolutionConfig& Config() const;
+ 
+     /**
+      * @brief Total fitness of `genome`: round wins minus losses over all of
+      *        generation `generation`'s matches for slot `individual`.
+      */
+     std::int64_t Evaluate(const StrategyGenome& genome, std::uint32_t generation,
+                           std::uint32_t individual) const;
+ 
+     /**
+      * @brief Writes a checkpoint; replaces `path` atomically through a rename.
+      * @throws std::runtime_error if the file cannot be written.
+      */
+     void SaveCheckpoint(const std::string& path) const;
+ 
+     /**
+      * @brief Resumes from a checkpoint written by SaveCheckpoint().
+      * @throws std::runtime_error if the file is missing or malformed.
+      */
+     static StrategyEvolver LoadCheckpoint(const std::string& path, unsigned threads = 0);
+ 
+ private:
+     StrategyEvolver(EvolutionConfig config, unsigned threads, bool randomize);
+ 
+     void Breed(const std::vector<std::int64_t>& fitness);
+ 
+     EvolutionConfig m_config {};
+     unsigned m_threads {};
+     std::uint32_t m_generation {};
+     std::vector<StrategyGenome> m_population {};
+     StrategyGenome m_best {};
+     std::int64_t m_bestFitness {};
+     bool m_hasBest {};
+ };
+ 
\ No newline at end of file
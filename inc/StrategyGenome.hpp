@@ -0,0 +1,93 @@
+/**
+ * @file StrategyGenome.hpp
+ * @brief Declares StrategyGenome and the GenomeStrategy that plays it.
+ *
+ * A StrategyGenome is a lookup table keyed by the last k rounds: each of
+ * those rounds is one of 9 (own move, opponent move) pairs, so the table
+ * holds 9^k genes, each a move. The first k rounds, before there is enough
+ * history, are played from k opening genes. With k = 2 a whole strategy is
+ * 83 bytes, which makes genomes cheap to copy, mutate and cross over.
+ */
+
+ #pragma once
+
+ #include "IMoveStrategy.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ #include <vector>
+ 
+ /**
+  * @brief A history-lookup strategy as a flat array of genes.
+  */
+ struct StrategyGenome {
+     /**
+      * @brief Longest supported history; 9^6 genes is 531441 bytes.
+      */
+     static constexpr std::uint32_t kMaxHistoryLength {6};
+ 
+     /**
+      * @brief Rounds of history the table is keyed by (k).
+      */
+     std::uint32_t historyLength {};
+ 
+     /**
+      * @brief k opening moves followed by 9^k table moves; each gene is 0, 1 or 2
+      *        for Rock, Paper or Scissors.
+      */
+     std::vector<std::uint8_t> genes {};
+ 
+     /**
+      * @brief Number of genes a genome with history length k has.
+      * @throws std::invalid_argument if k exceeds kMaxHistoryLength.
+      */
+     static std::size_t GeneCount(std::uint32_t historyLength);
+ 
+     /**
+      * @brief Returns a genome of history length k with every gene Rock.
+      */
+     static StrategyGenome Blank(std::uint32_t historyLength);
+ 
+     /**
+      * @brief Returns true if the gene count matches k and every gene is a move.
+      */
+     bool IsValid() const;
+ 
+     bool operator==(const StrategyGenome& other) const;
+     bool operator!=(const StrategyGenome& other) const;
+ };
+ 
+ /**
+  * @brief Plays a StrategyGenome.
+  *
+  * Keeps a reference to the genome, which must outlive the strategy, and
+  * a rolling table index; neither choosing nor observing allocates.
+  */
+ class GenomeStrategy : public IMoveStrategy {
+ public:
+     /**
+      * @brief Plays `genome`, whose genes must all be 0, 1 or 2 (see IsValid()).
+      * @throws std::invalid_argument if the gene count does not match the history length.
+      */
+     explicit GenomeStrategy(const StrategyGenome& genome);
+ 
+     GameMove NextMove() override;
+     void ObserveRound(GameMove ownMove, GameMove opponentMove) override;
+ 
+     /**
+      * @brief False only for k = 0, where the single table gene is the only move.
+      */
+     bool DependsOnHistory() const override;
+ 
+ private:
+     const std::uint8_t* m_opening {};
+     const std::uint8_t* m_table {};
+     std::uint32_t m_historyLength {};
+ 
+     /**
+      * @brief 9^k; the rolling index stays below it.
+      */
+     std::uint32_t m_tableSize {};
+     std::uint32_t m_index {};
+     std::uint32_t m_roundsSeen {};
+ };
+ 
\ No newline at end of file
@@ -0,0 +1,190 @@
+/**
+ * @file StreamingStats.hpp
+ * @brief Declares constant-time streaming aggregators for round statistics.
+ *
+ * - RoundWindow: the last N rounds of one player in a ring buffer, with
+ *   result and move counts kept up to date as rounds enter and leave.
+ * - TimeWindow: result counts over the last T nanoseconds in B buckets.
+ * - Ewma: an exponentially weighted moving average.
+ * - QuantileSketch: a log-bucketed histogram whose quantiles are within
+ *   1% relative error and which merges by adding bucket counts.
+ *
+ * Updates cost O(1) (TimeWindow amortised). None of these types is
+ * thread-safe; RoundStatistics adds the locking.
+ */
+
+ #pragma once
+
+ #include <array>
+ #include <cstddef>
+ #include <cstdint>
+ #include <vector>
+ 
+ /**
+  * @brief A round from one player's point of view.
+  */
+ enum class RoundResult : std::uint8_t
+ {
+     Win = 0,
+     Loss = 1,
+     Draw = 2,
+ 
+     /**
+      * @brief The round was not scored (a forfeited or invalid move).
+      */
+     Forfeit = 3
+ };
+ 
+ inline constexpr std::size_t kRoundResultCount {4};
+ 
+ /**
+  * @brief Counts of each RoundResult, indexed by its value.
+  */
+ using ResultCounts = std::array<std::uint64_t, kRoundResultCount>;
+ 
+ /**
+  * @brief The last `capacity` rounds of one player.
+  */
+ class RoundWindow {
+ public:
+     explicit RoundWindow(std::size_t capacity);
+ 
+     /**
+      * @brief Adds a round, evicting the oldest once the window is full.
+      * @param move The player's GameMove value, or 0 if there was none.
+      */
+     void Push(RoundResult result, std::uint8_t move);
+ 
+     std::size_t Size() const;
+     std::size_t Capacity() const;
+ 
+     /**
+      * @brief Results of the rounds in the window.
+      */
+     const ResultCounts& Results() const;
+ 
+     /**
+      * @brief Moves in the window, indexed by GameMove - 1.
+      */
+     const std::array<std::uint64_t, 3>& Moves() const;
+ 
+     /**
+      * @brief Wins over scored (non-forfeit) rounds in the window; 0 if none.
+      */
+     double WinRate() const;
+ 
+     /**
+      * @brief Length of the run of equal results ending with the latest round.
+      *
+      * Positive for wins, negative for losses, 0 after a draw or forfeit.
+      * Runs longer than the window are reported in full.
+      */
+     std::int64_t Streak() const;
+ 
+ private:
+     std::vector<std::uint8_t> m_slots {};
+     std::size_t m_next {};
+     std::size_t m_size {};
+     ResultCounts m_results {};
+     std::array<std::uint64_t, 3> m_moves {};
+     std::int64_t m_streak {};
+ };
+ 
+ /**
+  * @brief Result counts over a sliding span of time.
+  *
+  * The span is split into buckets; a bucket is cleared when time moves
+  * past it, so the window slides in steps of span / buckets.
+  */
+ class TimeWindow {
+ public:
+     TimeWindow(std::uint64_t spanNanos, std::size_t buckets);
+ 
+     /**
+      * @brief Counts a round at time `nowNanos`; times must not go backwards.
+      */
+     void Add(std::uint64_t nowNanos, RoundResult result);
+ 
+     /**
+      * @brief Returns the counts of the buckets still inside the span at `nowNanos`.
+      */
+     ResultCounts Totals(std::uint64_t nowNanos) const;
+ 
+ private:
+     void Advance(std::uint64_t bucket);
+ 
+     std::uint64_t m_bucketNanos {};
+     std::vector<ResultCounts> m_buckets {};
+ 
+     /**
+      * @brief Absolute index (time / width) of the newest bucket.
+      */
+     std::uint64_t m_head {};
+ };
+ 
+ /**
+  * @brief An exponentially weighted moving average.
+  */
+ class Ewma {
+ public:
+     /**
+      * @param alpha Weight of each new sample, in (0, 1].
+      */
+     explicit Ewma(double alpha);
+ 
+     /**
+      * @brief Adds a sample; the first sample sets the average directly.
+      */
+     void Add(double sample);
+ 
+     double Value() const;
+ 
+ private:
+     double m_alpha {};
+     double m_value {};
+     bool m_empty {true};
+ };
+ 
+ /**
+  * @brief A mergeable histogram of non-negative integers for quantile queries.
+  *
+  * Values below 2^kSubBits get one bucket each; larger values share a
+  * bucket with the others of the same leading kSubBits + 1 bits. Buckets
+  * are allocated up to the largest value seen.
+  */
+ class QuantileSketch {
+ public:
+     /**
+      * @brief Mantissa bits kept per value; relative error is below 2^-(kSubBits + 1).
+      */
+     static constexpr int kSubBits {6};
+ 
+     void Add(std::uint64_t value);
+ 
+     /**
+      * @brief Adds another sketch's values to this one.
+      */
+     void Merge(const QuantileSketch& other);
+ 
+     std::uint64_t Count() const;
+     std::uint64_t Min() const;
+     std::uint64_t Max() const;
+ 
+     /**
+      * @brief Returns a value whose rank is within one bucket of `q * Count()`.
+      * @param q Quantile in [0, 1]; 0 if the sketch is empty.
+      */
+     std::uint64_t Quantile(double q) const;
+ 
+     bool operator==(const QuantileSketch& other) const;
+ 
+ private:
+     static std::size_t BucketOf(std::uint64_t value);
+     static std::uint64_t BucketMidpoint(std::size_t bucket);
+ 
+     std::vector<std::uint64_t> m_counts {};
+     std::uint64_t m_count {};
+     std::uint64_t m_min {~std::uint64_t{0}};
+     std::uint64_t m_max {};
+ };
+ 
\ No newline at end of file
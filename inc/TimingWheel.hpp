@@ -0,0 +1,167 @@
+/**
+ * @file TimingWheel.hpp
+ * @brief Declares the TimingWheel class.
+ *
+ * TimingWheel keeps deadlines for an event loop. Time is an integer tick
+ * count chosen by the owner (BotArena uses milliseconds). Timers live in
+ * four levels of 256 slots each: a timer sits in the level of the highest
+ * byte in which its deadline differs from the current tick, and moves down
+ * a level when the wheel reaches the start of its slot. Deadlines more
+ * than 2^32 ticks away wait in an overflow list.
+ *
+ * Timers are intrusive (the wheel never allocates), and both Schedule()
+ * and Cancel() are O(1), so a loop can arm and disarm a deadline for every
+ * move of every session without measurable cost.
+ */
+
+ #pragma once
+
+ #include "InlineFunction.hpp"
+ #include <cstddef>
+ #include <cstdint>
+ 
+ /**
+  * @brief A hierarchical timing wheel of intrusive timers.
+  */
+ class TimingWheel {
+ public:
+     /**
+      * @brief Callback run when a timer expires.
+      */
+     using Callback = InlineFunction<void(), 48>;
+ 
+     /**
+      * @brief A timer that can be armed on one wheel at a time.
+      *
+      * The timer must outlive its time on the wheel or be destroyed while
+      * armed (which cancels it). A callback may re-arm its own timer and
+      * arm or cancel others, but must not destroy its own timer.
+      */
+     class Timer {
+     public:
+         Timer() = default;
+         explicit Timer(Callback callback);
+         ~Timer();
+ 
+         Timer(const Timer&) = delete;
+         Timer& operator=(const Timer&) = delete;
+ 
+         /**
+          * @brief Replaces the callback; the timer should not be armed.
+          */
+         void SetCallback(Callback callback);
+ 
+         /**
+          * @brief Returns true while the timer is scheduled and has not fired.
+          */
+         bool IsArmed() const;
+ 
+         /**
+          * @brief Returns the tick the timer was last scheduled for.
+          */
+         std::uint64_t Deadline() const;
+ 
+     private:
+         friend class TimingWheel;
+ 
+         Callback m_callback {};
+         Timer* m_prev {};
+         Timer* m_next {};
+         Timer** m_list {};
+         int m_slot {-1};
+         TimingWheel* m_wheel {};
+         std::uint64_t m_deadline {};
+     };
+ 
+     static constexpr int kLevels {4};
+     static constexpr int kSlotBits {8};
+     static constexpr std::size_t kSlots {std::size_t{1} << kSlotBits};
+ 
+     /**
+      * @brief Constructs an empty wheel whose current tick is `now`.
+      */
+     explicit TimingWheel(std::uint64_t now = 0);
+ 
+     /**
+      * @brief Destructor. Disarms every timer still on the wheel.
+      */
+     ~TimingWheel();
+ 
+     TimingWheel(const TimingWheel&) = delete;
+     TimingWheel& operator=(const TimingWheel&) = delete;
+ 
+     /**
+      * @brief Arms a timer (re-arming it if already armed). O(1).
+      * @param timer    The timer to arm.
+      * @param deadline Absolute tick; a deadline not after Now() fires on the next Advance().
+      */
+     void Schedule(Timer& timer, std::uint64_t deadline);
+ 
+     /**
+      * @brief Arms a timer `delay` ticks after Now(). O(1).
+      */
+     void ScheduleAfter(Timer& timer, std::uint64_t delay);
+ 
+     /**
+      * @brief Disarms a timer; does nothing if it is not armed. O(1).
+      */
+     void Cancel(Timer& timer);
+ 
+     /**
+      * @brief Moves the current tick forward, running every expired timer.
+      * @param now The new current tick; earlier values are ignored.
+      * @return Number of timers that fired.
+      */
+     std::size_t Advance(std::uint64_t now);
+ 
+     /**
+      * @brief Returns the current tick.
+      */
+     std::uint64_t Now() const;
+ 
+     /**
+      * @brief Returns the number of armed timers.
+      */
+     std::size_t Size() const;
+ 
+     /**
+      * @brief Returns how many ticks may pass before Advance() has work to do.
+      *
+      * Never later than the next expiry, though it may be earlier (when
+      * timers only need to move down a level). Returns UINT64_MAX when the
+      * wheel is empty. Suitable as an event-loop wait timeout.
+      */
+     std::uint64_t TicksUntilNextEvent() const;
+ 
+ private:
+     void Place(Timer& timer);
+     void Link(Timer& timer, Timer*& list, int slot);
+     void Unlink(Timer& timer);
+     void ProcessTick();
+     void Redistribute(Timer*& list);
+     std::size_t NextOccupiedSlot(int level, std::size_t from) const;
+     std::uint64_t NextEventTick() const;
+     std::size_t FireExpired();
+ 
+ private:
+     Timer* m_slots[kLevels][kSlots] {};
+ 
+     /**
+      * @brief One bit per slot: set while the slot's list is non-empty.
+      */
+     std::uint64_t m_occupied[kLevels][kSlots / 64] {};
+ 
+     /**
+      * @brief Timers due now, waiting to be run.
+      */
+     Timer* m_expired {};
+ 
+     /**
+      * @brief Timers more than 2^32 ticks away.
+      */
+     Timer* m_overflow {};
+ 
+     std::uint64_t m_now {};
+     std::size_t m_size {};
+ };
+ 
\ No newline at end of file
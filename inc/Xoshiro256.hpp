@@ -0,0 +1,62 @@
+/**
+ * @file Xoshiro256.hpp
+ * @brief Declares the Xoshiro256 random number generator.
+ *
+ * Xoshiro256 is xoshiro256** (Blackman & Vigna): 32 bytes of state, a few
+ * cycles per number and good statistical quality. Its state is filled
+ * with SplitMix64, so any 64-bit seed (even 0) gives a usable generator.
+ *
+ * Simulations derive one generator per (master seed, stream) pair with
+ * ForStream(). A stream depends only on those two numbers, so the same
+ * work item draws the same numbers no matter which thread, process or
+ * shard runs it.
+ */
+
+ #pragma once
+
+ #include <cstdint>
+ #include <limits>
+ 
+ /**
+  * @brief The xoshiro256** generator; satisfies UniformRandomBitGenerator.
+  */
+ class Xoshiro256 {
+ public:
+     using result_type = std::uint64_t;
+ 
+     /**
+      * @brief Seeds the state from `seed` through SplitMix64.
+      */
+     explicit Xoshiro256(std::uint64_t seed = 0);
+ 
+     /**
+      * @brief Returns the generator for stream `stream` of `masterSeed`.
+      *
+      * Both numbers are mixed through SplitMix64, so neighbouring streams
+      * and neighbouring master seeds give unrelated sequences.
+      */
+     static Xoshiro256 ForStream(std::uint64_t masterSeed, std::uint64_t stream);
+ 
+     /**
+      * @brief Advances `state` and returns the next SplitMix64 output.
+      */
+     static std::uint64_t SplitMix64(std::uint64_t& state);
+ 
+     static constexpr result_type min() { return 0; }
+     static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+ 
+     /**
+      * @brief Returns the next 64 random bits.
+      */
+     result_type operator()();
+ 
+     /**
+      * @brief Returns a uniformly distributed value in [0, bound), without modulo bias.
+      * @param bound Exclusive upper limit; must be non-zero.
+      */
+     std::uint64_t NextBelow(std::uint64_t bound);
+ 
+ private:
+     std::uint64_t m_state[4] {};
+ };
+ 
\ No newline at end of file
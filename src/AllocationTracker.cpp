@@ -0,0 +1,363 @@
+/**
+ * @file AllocationTracker.cpp
+ * @brief Implements the AllocationTracker classes and, in tracking builds,
+ *        the replacement global operator new and operator delete.
+ */
+
+ #include "AllocationTracker.hpp"
+ #include <algorithm>
+ #include <atomic>
+ #include <cstdlib>
+ #include <iomanip>
+ #include <new>
+ #include <ostream>
+ #if defined(__linux__)
+ #include <dlfcn.h>
+ #endif
+ 
+ #if defined(__GNUC__)
+ #define ROCK_PAPER_SCISSORS_CALLER() __builtin_return_address(0)
+ #elif defined(_MSC_VER)
+ #include <intrin.h>
+ #define ROCK_PAPER_SCISSORS_CALLER() _ReturnAddress()
+ #else
+ #define ROCK_PAPER_SCISSORS_CALLER() nullptr
+ #endif
+ 
+ namespace {
+ 
+ /**
+  * @brief One thread's counters and call-site table.
+  *
+  * Constant-initialized, so operator new can use it before anything else
+  * on the thread has run and it never needs a destructor.
+  */
+ struct ThreadState {
+     AllocationCounts counts {};
+     std::uint32_t countdown {};
+     std::uint64_t dropped {};
+     AllocationCallSite sites[AllocationTracker::kCallSiteCapacity] {};
+ };
+ 
+ thread_local ThreadState t_state {};
+ 
+ std::atomic<std::uint32_t> g_samplingInterval {0};
+ 
+ /**
+  * @brief Adds a sample for `caller` to the thread's open-addressed table.
+  */
+ void RecordCallSite(ThreadState& state, const void* caller) {
+     constexpr std::size_t kMask { AllocationTracker::kCallSiteCapacity - 1 };
+     static_assert((AllocationTracker::kCallSiteCapacity & kMask) == 0, "capacity must be a power of two");
+     std::size_t slot { static_cast<std::size_t>((reinterpret_cast<std::uintptr_t>(caller) >> 4) *
+                                                 0x9E3779B97F4A7C15ull >> 56) & kMask };
+     for (std::size_t probe{}; probe < AllocationTracker::kCallSiteCapacity; ++probe) {
+         AllocationCallSite& site { state.sites[(slot + probe) & kMask] };
+         if (site.address == caller) {
+             ++site.samples;
+             return;
+         }
+         if (site.address == nullptr) {
+             site.address = caller;
+             site.samples = 1;
+             return;
+         }
+     }
+     ++state.dropped;
+ }
+ 
+ #ifdef ROCK_PAPER_SCISSORS_TRACK_ALLOCATIONS
+ 
+ void CountAllocation(std::size_t size, const void* caller) {
+     ThreadState& state { t_state };
+     ++state.counts.allocations;
+     state.counts.bytes += size;
+     std::uint32_t interval { g_samplingInterval.load(std::memory_order_relaxed) };
+     if (interval != 0 && ++state.countdown >= interval) {
+         state.countdown = 0;
+         if (caller != nullptr) {
+             RecordCallSite(state, caller);
+         }
+     }
+ }
+ 
+ void CountDeallocation(void* pointer) {
+     if (pointer != nullptr) {
+         ++t_state.counts.deallocations;
+     }
+ }
+ 
+ void* AlignedMalloc(std::size_t size, std::size_t alignment) {
+ #if defined(_MSC_VER)
+     return _aligned_malloc(size, alignment);
+ #else
+     return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+ #endif
+ }
+ 
+ /**
+  * @brief malloc that follows operator new's contract: retry through the
+  *        new handler, or return nullptr when `nothrow` and there is none.
+  */
+ void* Allocate(std::size_t size, std::size_t alignment, bool nothrow, const void* caller) {
+     std::size_t request { size == 0 ? 1 : size };
+     for (;;) {
+         void* pointer { alignment == 0 ? std::malloc(request) : AlignedMalloc(request, alignment) };
+         if (pointer != nullptr) {
+             CountAllocation(size, caller);
+             return pointer;
+         }
+         std::new_handler handler { std::get_new_handler() };
+         if (handler == nullptr) {
+             if (nothrow) {
+                 return nullptr;
+             }
+             throw std::bad_alloc();
+         }
+         if (nothrow) {
+             try {
+                 handler();
+             } catch (...) {
+                 return nullptr;
+             }
+         } else {
+             handler();
+         }
+     }
+ }
+ 
+ void Release(void* pointer) noexcept {
+     CountDeallocation(pointer);
+     std::free(pointer);
+ }
+ 
+ void ReleaseAligned(void* pointer) noexcept {
+     CountDeallocation(pointer);
+ #if defined(_MSC_VER)
+     _aligned_free(pointer);
+ #else
+     std::free(pointer);
+ #endif
+ }
+ 
+ #endif
+ 
+ } // namespace
+ 
+ #ifdef ROCK_PAPER_SCISSORS_TRACK_ALLOCATIONS
+ 
+ void* operator new(std::size_t size) {
+     return Allocate(size, 0, false, ROCK_PAPER_SCISSORS_CALLER());
+ }
+ 
+ void* operator new[](std::size_t size) {
+     return Allocate(size, 0, false, ROCK_PAPER_SCISSORS_CALLER());
+ }
+ 
+ void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+     return Allocate(size, 0, true, ROCK_PAPER_SCISSORS_CALLER());
+ }
+ 
+ void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+     return Allocate(size, 0, true, ROCK_PAPER_SCISSORS_CALLER());
+ }
+ 
+ void* operator new(std::size_t size, std::align_val_t alignment) {
+     return Allocate(size, static_cast<std::size_t>(alignment), false, ROCK_PAPER_SCISSORS_CALLER());
+ }
+ 
+ void* operator new[](std::size_t size, std::align_val_t alignment) {
+     return Allocate(size, static_cast<std::size_t>(alignment), false, ROCK_PAPER_SCISSORS_CALLER());
+ }
+ 
+ void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+     return Allocate(size, static_cast<std::size_t>(alignment), true, ROCK_PAPER_SCISSORS_CALLER());
+ }
+ 
+ void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+     return Allocate(size, static_cast<std::size_t>(alignment), true, ROCK_PAPER_SCISSORS_CALLER());
+ }
+ 
+ void operator delete(void* pointer) noexcept {
+     Release(pointer);
+ }
+ 
+ void operator delete[](void* pointer) noexcept {
+     Release(pointer);
+ }
+ 
+ void operator delete(void* pointer, std::size_t) noexcept {
+     Release(pointer);
+ }
+ 
+ void operator delete[](void* pointer, std::size_t) noexcept {
+     Release(pointer);
+ }
+ 
+ void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+     Release(pointer);
+ }
+ 
+ void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+     Release(pointer);
+ }
+ 
+ void operator delete(void* pointer, std::align_val_t) noexcept {
+     ReleaseAligned(pointer);
+ }
+ 
+ void operator delete[](void* pointer, std::align_val_t) noexcept {
+     ReleaseAligned(pointer);
+ }
+ 
+ void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+     ReleaseAligned(pointer);
+ }
+ 
+ void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+     ReleaseAligned(pointer);
+ }
+ 
+ void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+     ReleaseAligned(pointer);
+ }
+ 
+ void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+     ReleaseAligned(pointer);
+ }
+ 
+ #endif
+ 
+ bool AllocationTracker::Enabled() {
+ #ifdef ROCK_PAPER_SCISSORS_TRACK_ALLOCATIONS
+     return true;
+ #else
+     return false;
+ #endif
+ }
+ 
+ AllocationCounts AllocationTracker::ThreadCounts() {
+     return t_state.counts;
+ }
+ 
+ void AllocationTracker::SetSamplingInterval(std::uint32_t interval) {
+     g_samplingInterval.store(interval, std::memory_order_relaxed);
+ }
+ 
+ std::vector<AllocationCallSite> AllocationTracker::ThreadCallSites() {
+     // Copy the table first: filling the vector allocates, which may sample.
+     AllocationCallSite sites[kCallSiteCapacity];
+     std::copy(std::begin(t_state.sites), std::end(t_state.sites), sites);
+     std::vector<AllocationCallSite> result;
+     for (const AllocationCallSite& site : sites) {
+         if (site.address != nullptr) {
+             result.push_back(site);
+         }
+     }
+     std::sort(result.begin(), result.end(), [](const AllocationCallSite& a, const AllocationCallSite& b) {
+         return a.samples > b.samples;
+     });
+     return result;
+ }
+ 
+ std::uint64_t AllocationTracker::ThreadDroppedSamples() {
+     return t_state.dropped;
+ }
+ 
+ void AllocationTracker::ClearThreadCallSites() {
+     std::fill(std::begin(t_state.sites), std::end(t_state.sites), AllocationCallSite{});
+     t_state.dropped = 0;
+     t_state.countdown = 0;
+ }
+ 
+ AllocationScope::AllocationScope()
+     : m_start{AllocationTracker::ThreadCounts()} {
+ }
+ 
+ AllocationCounts AllocationScope::Counts() const {
+     return AllocationTracker::ThreadCounts() - m_start;
+ }
+ 
+ void AllocationScope::Restart() {
+     m_start = AllocationTracker::ThreadCounts();
+ }
+ 
+ AllocationObserver::AllocationObserver(IRoundObserver* next)
+     : m_next{next}, m_lastMark{AllocationTracker::ThreadCounts()} {
+ }
+ 
+ void AllocationObserver::OnRound(const RoundRecord& record) {
+     if (m_next != nullptr) {
+         m_next->OnRound(record);
+     }
+     AllocationCounts now { AllocationTracker::ThreadCounts() };
+     AllocationCounts round { now - m_lastMark };
+     m_lastMark = now;
+     ++m_report.rounds;
+     m_report.roundAllocations += round.allocations;
+     m_report.roundBytes += round.bytes;
+     m_report.maxRoundAllocations = std::max(m_report.maxRoundAllocations, round.allocations);
+     m_report.total = m_sinceReset.Counts();
+ }
+ 
+ void AllocationObserver::OnSessionEnd(const SessionSummary& summary) {
+     if (m_next != nullptr) {
+         m_next->OnSessionEnd(summary);
+     }
+     ++m_report.sessions;
+     m_lastMark = AllocationTracker::ThreadCounts();
+     m_report.total = m_sinceReset.Counts();
+ }
+ 
+ void AllocationObserver::Reset() {
+     m_sinceReset.Restart();
+     m_lastMark = AllocationTracker::ThreadCounts();
+     m_report = {};
+ }
+ 
+ AllocationObserver::Report AllocationObserver::Snapshot() const {
+     return m_report;
+ }
+ 
+ void AllocationObserver::Print(std::ostream& out, std::size_t callSites) const {
+     if (!AllocationTracker::Enabled()) {
+         out << "Allocation tracking is not compiled into this build.\n";
+         return;
+     }
+     std::ios::fmtflags flags { out.flags() };
+     std::streamsize precision { out.precision() };
+     double rounds { static_cast<double>(std::max<std::uint64_t>(m_report.rounds, 1)) };
+     double sessions { static_cast<double>(std::max<std::uint64_t>(m_report.sessions, 1)) };
+     out << "Allocations: " << m_report.total.allocations << " (" << m_report.total.bytes << " bytes, "
+         << m_report.total.deallocations << " frees) over " << m_report.sessions << " sessions and "
+         << m_report.rounds << " rounds\n"
+         << std::fixed << std::setprecision(2)
+         << "  per session: " << static_cast<double>(m_report.total.allocations) / sessions << "\n"
+         << "  per round:   " << static_cast<double>(m_report.roundAllocations) / rounds << " ("
+         << static_cast<double>(m_report.roundBytes) / rounds << " bytes), at most "
+         << m_report.maxRoundAllocations << "\n";
+     out.flags(flags);
+     out.precision(precision);
+     std::vector<AllocationCallSite> sites { AllocationTracker::ThreadCallSites() };
+     if (sites.empty()) {
+         return;
+     }
+     out << "  sampled call sites (resolve with addr2line -f -C -e <binary> <offset>):\n";
+     for (std::size_t i{}; i < sites.size() && i < callSites; ++i) {
+         out << "    " << std::setw(8) << sites[i].samples << " samples at " << sites[i].address;
+ #if defined(__linux__)
+         // Position-independent binaries load anywhere; addr2line wants the offset.
+         Dl_info info {};
+         if (dladdr(sites[i].address, &info) != 0 && info.dli_fname != nullptr) {
+             out << " = " << info.dli_fname << "+0x" << std::hex
+                 << (reinterpret_cast<std::uintptr_t>(sites[i].address) - reinterpret_cast<std::uintptr_t>(info.dli_fbase))
+                 << std::dec;
+         }
+ #endif
+         out << "\n";
+     }
+     if (std::uint64_t dropped { AllocationTracker::ThreadDroppedSamples() }; dropped > 0) {
+         out << "    (" << dropped << " samples from further sites dropped)\n";
+     }
+ }
+ 
\ No newline at end of file
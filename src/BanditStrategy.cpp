@@ -0,0 +1,242 @@
+/**
+ * @file BanditStrategy.cpp
+ * @brief Implements the BanditStrategy class.
+ */
+
+ #include "BanditStrategy.hpp"
+ #include "GameRules.hpp"
+ #include "MoveStrategies.hpp"
+ #include <algorithm>
+ #include <cmath>
+ #include <limits>
+ #include <stdexcept>
+
+ namespace {
+ 
+ /**
+  * @brief Beta shapes from which Thompson sampling draws a normal approximation.
+  */
+ constexpr double kNormalBetaShape {16.0};
+ 
+ double Payoff(GameMove ownMove, GameMove opponentMove) {
+     if (IsRoundDraw(ownMove, opponentMove)) {
+         return 0.5;
+     }
+     return DoesFirstMoveWin(ownMove, opponentMove) ? 1.0 : 0.0;
+ }
+ 
+ } // namespace
+ 
+ BanditStrategy::BanditStrategy(std::vector<std::unique_ptr<IMoveStrategy>> arms, BanditOptions options)
+     : m_options{options},
+       m_random{options.seed}
+ {
+     if (arms.empty()) {
+         throw std::invalid_argument("BanditStrategy: the portfolio is empty");
+     }
+     if (!(m_options.discount > 0.0 && m_options.discount <= 1.0)) {
+         throw std::invalid_argument("BanditStrategy: discount must be in (0, 1]");
+     }
+     if (!(m_options.exploration > 0.0 && m_options.exploration <= 1.0)) {
+         throw std::invalid_argument("BanditStrategy: exploration must be in (0, 1]");
+     }
+     m_arms.resize(arms.size());
+     for (std::size_t i{}; i < arms.size(); ++i) {
+         if (!arms[i]) {
+             throw std::invalid_argument("BanditStrategy: null arm");
+         }
+         m_arms[i].strategy = std::move(arms[i]);
+     }
+ }
+ 
+ std::unique_ptr<BanditStrategy> BanditStrategy::WithBuiltinPortfolio(BanditOptions options) {
+     std::vector<std::unique_ptr<IMoveStrategy>> arms;
+     arms.push_back(std::make_unique<ConstantStrategy>(GameMove::Rock));
+     arms.push_back(std::make_unique<ConstantStrategy>(GameMove::Paper));
+     arms.push_back(std::make_unique<ConstantStrategy>(GameMove::Scissors));
+     arms.push_back(std::make_unique<CycleStrategy>());
+     arms.push_back(std::make_unique<CopycatStrategy>());
+     arms.push_back(std::make_unique<CounterLastStrategy>());
+     arms.push_back(std::make_unique<RandomStrategy>(Xoshiro256::ForStream(options.seed, 1)()));
+     return std::make_unique<BanditStrategy>(std::move(arms), options);
+ }
+ 
+ GameMove BanditStrategy::NextMove() {
+     for (auto& arm : m_arms) {
+         arm.proposal = arm.strategy->NextMove();
+     }
+     switch (m_options.policy) {
+     case BanditPolicy::Ucb1:     m_chosen = SelectUcb1(); break;
+     case BanditPolicy::Thompson: m_chosen = SelectThompson(); break;
+     case BanditPolicy::Exp3:     m_chosen = SelectExp3(); break;
+     }
+     m_proposed = true;
+     return m_arms[m_chosen].proposal;
+ }
+ 
+ void BanditStrategy::ObserveRound(GameMove ownMove, GameMove opponentMove) {
+     if (!m_proposed) {
+         // A round we did not choose for: keep the arms in step, credit nobody.
+         for (auto& arm : m_arms) {
+             arm.strategy->ObserveRound(arm.strategy->NextMove(), opponentMove);
+         }
+         return;
+     }
+     m_proposed = false;
+     for (auto& arm : m_arms) {
+         arm.strategy->ObserveRound(arm.proposal, opponentMove);
+     }
+ 
+     Arm& chosen { m_arms[m_chosen] };
+     double payoff { Payoff(ownMove, opponentMove) };
+     ++chosen.pulls;
+     if (m_options.policy == BanditPolicy::Exp3) {
+         // Importance-weighted estimate, so unchosen arms are not penalized.
+         double estimate { payoff / chosen.probability };
+         chosen.logWeight += m_options.exploration * estimate / static_cast<double>(m_arms.size());
+         return;
+     }
+     if (m_options.discount < 1.0) {
+         for (auto& arm : m_arms) {
+             arm.weight *= m_options.discount;
+             arm.payoff *= m_options.discount;
+         }
+     }
+     chosen.weight += 1.0;
+     chosen.payoff += payoff;
+ }
+ 
+ bool BanditStrategy::DependsOnHistory() const {
+     return true;
+ }
+ 
+ std::size_t BanditStrategy::ArmCount() const {
+     return m_arms.size();
+ }
+ 
+ std::size_t BanditStrategy::ChosenArm() const {
+     return m_chosen;
+ }
+ 
+ std::uint64_t BanditStrategy::Pulls(std::size_t arm) const {
+     return m_arms.at(arm).pulls;
+ }
+ 
+ std::size_t BanditStrategy::SelectUcb1() const {
+     double total {};
+     for (std::size_t i{}; i < m_arms.size(); ++i) {
+         if (m_arms[i].pulls == 0) {
+             return i;
+         }
+         total += m_arms[i].weight;
+     }
+     double logTotal { 2.0 * std::log(total) };
+     std::size_t best {};
+     double bestScore { -std::numeric_limits<double>::infinity() };
+     for (std::size_t i{}; i < m_arms.size(); ++i) {
+         const Arm& arm { m_arms[i] };
+         double score { arm.payoff / arm.weight + std::sqrt(std::max(logTotal, 0.0) / arm.weight) };
+         if (score > bestScore) {
+             bestScore = score;
+             best = i;
+         }
+     }
+     return best;
+ }
+ 
+ std::size_t BanditStrategy::SelectThompson() {
+     std::size_t best {};
+     double bestDraw { -1.0 };
+     for (std::size_t i{}; i < m_arms.size(); ++i) {
+         const Arm& arm { m_arms[i] };
+         double draw { SampleBeta(1.0 + arm.payoff, 1.0 + arm.weight - arm.payoff) };
+         if (draw > bestDraw) {
+             bestDraw = draw;
+             best = i;
+         }
+     }
+     return best;
+ }
+ 
+ std::size_t BanditStrategy::SelectExp3() {
+     double maxLog { -std::numeric_limits<double>::infinity() };
+     for (const auto& arm : m_arms) {
+         maxLog = std::max(maxLog, arm.logWeight);
+     }
+     double sum {};
+     for (auto& arm : m_arms) {
+         arm.probability = std::exp(arm.logWeight - maxLog);
+         sum += arm.probability;
+     }
+     double uniform { m_options.exploration / static_cast<double>(m_arms.size()) };
+     double target { UnitInterval() };
+     std::size_t chosen { m_arms.size() - 1 };
+     double cumulative {};
+     for (std::size_t i{}; i < m_arms.size(); ++i) {
+         Arm& arm { m_arms[i] };
+         arm.probability = (1.0 - m_options.exploration) * arm.probability / sum + uniform;
+         cumulative += arm.probability;
+         if (target < cumulative && chosen == m_arms.size() - 1) {
+             chosen = i;
+         }
+     }
+     // Keep the weights near 0 so exp() never overflows in a long game.
+     for (auto& arm : m_arms) {
+         arm.logWeight -= maxLog;
+     }
+     return chosen;
+ }
+ 
+ double BanditStrategy::SampleBeta(double alpha, double beta) {
+     if (alpha >= kNormalBetaShape && beta >= kNormalBetaShape) {
+         // Both shapes large: the Beta is close to normal, and one draw is far cheaper than two Gammas.
+         double sum { alpha + beta };
+         double mean { alpha / sum };
+         return mean + std::sqrt(mean * (1.0 - mean) / (sum + 1.0)) * SampleNormal();
+     }
+     double x { SampleGamma(alpha) };
+     double y { SampleGamma(beta) };
+     return x / (x + y);
+ }
+ 
+ double BanditStrategy::SampleGamma(double shape) {
+     // Marsaglia and Tsang; shapes here are always at least 1.
+     double d { shape - 1.0 / 3.0 };
+     double c { 1.0 / std::sqrt(9.0 * d) };
+     for (;;) {
+         double x { SampleNormal() };
+         double v { 1.0 + c * x };
+         if (v <= 0.0) {
+             continue;
+         }
+         v = v * v * v;
+         double u { UnitInterval() };
+         if (u < 1.0 - 0.0331 * x * x * x * x || std::log(u) < 0.5 * x * x + d * (1.0 - v + std::log(v))) {
+             return d * v;
+         }
+     }
+ }
+ 
+ double BanditStrategy::SampleNormal() {
+     // Marsaglia polar method; it yields two variates, the second is kept for the next call.
+     if (m_hasSpareNormal) {
+         m_hasSpareNormal = false;
+         return m_spareNormal;
+     }
+     for (;;) {
+         double u { 2.0 * UnitInterval() - 1.0 };
+         double v { 2.0 * UnitInterval() - 1.0 };
+         double s { u * u + v * v };
+         if (s > 0.0 && s < 1.0) {
+             double scale { std::sqrt(-2.0 * std::log(s) / s) };
+             m_spareNormal = v * scale;
+             m_hasSpareNormal = true;
+             return u * scale;
+         }
+     }
+ }
+ 
+ double BanditStrategy::UnitInterval() {
+     return static_cast<double>(m_random() >> 11) * 0x1.0p-53;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,471 @@
+/**
+ * @file BotArena.cpp
+ * @brief Implements the BotArena class.
+ */
+
+ #include "BotArena.hpp"
+ #include "BotClient.hpp"
+ #include "BotProcess.hpp"
+ #include "BotProtocol.hpp"
+ #include "ComputerPlayer.hpp"
+ #include "QueuedMoveMessenger.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "UserPlayer.hpp"
+ #include <algorithm>
+ #include <cerrno>
+ #include <climits>
+ #include <cstdint>
+ #include <deque>
+ #include <sys/epoll.h>
+ #include <sys/socket.h>
+ #include <system_error>
+ #include <unistd.h>
+
+ namespace {
+ 
+ /**
+  * @brief Queued in place of a move that a bot failed to deliver in time.
+  */
+ constexpr int kForfeitedMove {-1};
+ 
+ bool IsMove(int choice)
+ {
+     return choice >= 1 && choice <= 3;
+ }
+ 
+ } // namespace
+ 
+ /**
+  * @brief One participant of a match: its process plus protocol state.
+  */
+ struct BotArena::Side {
+     Match* match {};
+     BotSpec spec {};
+     BotProcess process {};
+ 
+     bool helloReceived {};
+     bool batchable {};
+     bool requestOutstanding {};
+     bool watchingWritable {};
+ 
+     /**
+      * @brief Moves received from the bot and not yet played.
+      */
+     std::deque<int> moves {};
+ 
+     /**
+      * @brief Moves still owed for rounds already forfeited; dropped on arrival.
+      */
+     std::size_t lateMoves {};
+ 
+     bool missedDeadline {};
+     TimingWheel::Timer moveDeadline {};
+ 
+     /**
+      * @brief Opponent moves from completed rounds not yet reported to the bot.
+      */
+     std::vector<std::uint8_t> history {};
+ 
+     std::vector<std::uint8_t> inbox {};
+     std::vector<std::uint8_t> outbox {};
+ };
+ 
+ /**
+  * @brief A match: two sides and the session they play.
+  */
+ struct BotArena::Match {
+     Side user {};
+     Side computer {};
+     int rounds {};
+ 
+     std::shared_ptr<IPlayer> userPlayer {};
+     std::shared_ptr<IPlayer> computerPlayer {};
+     QueuedMoveMessenger* messenger {};
+     std::unique_ptr<SinglePlayerRpsGame> game {};
+ 
+     /**
+      * @brief The computer side's move for the round being played.
+      */
+     int nextComputerMove {1};
+ 
+     BotMatchResult result {};
+     bool done {};
+ 
+     /**
+      * @brief Set once the match deadline passes; remaining rounds are forfeited.
+      */
+     bool expired {};
+     TimingWheel::Timer matchDeadline {};
+ };
+ 
+ BotArena::BotArena() = default;
+ 
+ BotArena::~BotArena() {
+     if (m_epollFd >= 0) {
+         ::close(m_epollFd);
+     }
+ }
+ 
+ std::size_t BotArena::AddMatch(BotSpec user, BotSpec computer, int rounds) {
+     auto match = std::make_unique<Match>();
+     match->user.spec = std::move(user);
+     match->computer.spec = std::move(computer);
+     match->rounds = rounds;
+     m_matches.push_back(std::move(match));
+     return m_matches.size() - 1;
+ }
+ 
+ void BotArena::SetMoveTimeout(std::chrono::milliseconds timeout) {
+     m_moveTimeout = timeout;
+ }
+ 
+ void BotArena::SetMatchTimeout(std::chrono::milliseconds timeout) {
+     m_matchTimeout = timeout;
+ }
+ 
+ std::vector<BotMatchResult> BotArena::Run() {
+     m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+     if (m_epollFd < 0) {
+         throw std::system_error(errno, std::generic_category(), "epoll_create1");
+     }
+     m_syscalls = 0;
+     m_start = std::chrono::steady_clock::now();
+     m_wheel.Advance(0);
+ 
+     for (auto& match : m_matches) {
+         StartMatch(*match);
+     }
+ 
+     constexpr int kMaxEvents {256};
+     epoll_event events[kMaxEvents] {};
+     while (m_activeMatches > 0) {
+         // Sleep until the next deadline needs checking, or indefinitely.
+         std::uint64_t untilDeadline { m_wheel.TicksUntilNextEvent() };
+         int timeout { untilDeadline > static_cast<std::uint64_t>(INT_MAX) ? -1 : static_cast<int>(untilDeadline) };
+         int ready { ::epoll_wait(m_epollFd, events, kMaxEvents, timeout) };
+         if (ready < 0) {
+             if (errno == EINTR) {
+                 continue;
+             }
+             throw std::system_error(errno, std::generic_category(), "epoll_wait");
+         }
+         for (int i{}; i < ready; ++i) {
+             auto* side = static_cast<Side*>(events[i].data.ptr);
+             if (side->match->done) {
+                 continue;
+             }
+             if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                 OnReadable(*side);
+             }
+             if (!side->match->done && (events[i].events & EPOLLOUT)) {
+                 OnWritable(*side);
+             }
+         }
+         m_wheel.Advance(NowTicks());
+     }
+ 
+     std::vector<BotMatchResult> results;
+     results.reserve(m_matches.size());
+     for (auto& match : m_matches) {
+         match->user.process.Wait();
+         match->computer.process.Wait();
+         results.push_back(match->result);
+     }
+ 
+     ::close(m_epollFd);
+     m_epollFd = -1;
+     return results;
+ }
+ 
+ std::size_t BotArena::SyscallCount() const {
+     return m_syscalls;
+ }
+ 
+ void BotArena::StartMatch(Match& match) {
+     match.user.match = &match;
+     match.computer.match = &match;
+ 
+     for (Side* side : {&match.user, &match.computer}) {
+         if (!side->spec.command.empty()) {
+             side->process = BotProcess::Launch(side->spec.command);
+         } else {
+             const BotSpec& spec { side->spec };
+             side->process = BotProcess::Fork([&spec](int fd) {
+                 std::unique_ptr<IMoveStrategy> strategy { spec.strategy ? spec.strategy() : nullptr };
+                 if (!strategy) {
+                     return 2;
+                 }
+                 BotClient client{fd, fd, *strategy};
+                 return client.Run();
+             });
+         }
+ 
+         epoll_event event {};
+         event.events = EPOLLIN;
+         event.data.ptr = side;
+         if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, side->process.Fd(), &event) != 0) {
+             throw std::system_error(errno, std::generic_category(), "epoll_ctl");
+         }
+     }
+ 
+     auto messenger = std::make_unique<QueuedMoveMessenger>();
+     match.messenger = messenger.get();
+     match.userPlayer = std::make_shared<UserPlayer>(match.user.spec.name);
+     match.computerPlayer = std::make_shared<ComputerPlayer>(match.computer.spec.name);
+ 
+     // The session maps generator values v to moves 1 + (v % 3).
+     Match* self { &match };
+     match.game = std::make_unique<SinglePlayerRpsGame>(
+         match.userPlayer,
+         match.computerPlayer,
+         std::move(messenger),
+         match.rounds,
+         [self]() { return self->nextComputerMove - 1; }
+     );
+ 
+     ++m_activeMatches;
+     if (match.game->IsFinished()) {
+         EndMatch(match, true);
+         return;
+     }
+ 
+     // Waiting for Hello counts against the first move's deadline.
+     ArmMoveDeadline(match.user);
+     ArmMoveDeadline(match.computer);
+     if (m_matchTimeout.count() > 0) {
+         match.matchDeadline.SetCallback([this, self]() { OnMatchDeadline(*self); });
+         m_wheel.ScheduleAfter(match.matchDeadline, static_cast<std::uint64_t>(m_matchTimeout.count()));
+     }
+ }
+ 
+ void BotArena::OnReadable(Side& side) {
+     std::uint8_t buffer[4096];
+     while (true) {
+         ssize_t got { ::recv(side.process.Fd(), buffer, sizeof(buffer), 0) };
+         ++m_syscalls;
+         if (got > 0) {
+             side.inbox.insert(side.inbox.end(), buffer, buffer + got);
+             // A short read drained the socket; epoll is level-triggered, so
+             // anything arriving later raises a new event instead of costing
+             // an extra recv() that would only return EAGAIN.
+             if (static_cast<std::size_t>(got) < sizeof(buffer)) {
+                 break;
+             }
+             continue;
+         }
+         if (got < 0 && errno == EINTR) {
+             continue;
+         }
+         if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+             break;
+         }
+         // End of stream or hard error: the bot is gone.
+         EndMatch(*side.match, false);
+         return;
+     }
+ 
+     std::size_t offset {};
+     BotProtocol::FrameHeader header {};
+     while (std::size_t frameSize = BotProtocol::PeekFrame(side.inbox.data() + offset,
+                                                           side.inbox.size() - offset, header)) {
+         const std::uint8_t* payload { side.inbox.data() + offset + BotProtocol::kHeaderSize };
+         if (header.type == BotProtocol::FrameType::Hello) {
+             side.helloReceived = true;
+             side.batchable = (header.flags & BotProtocol::kBatchable) != 0;
+         } else if (header.type == BotProtocol::FrameType::Moves && side.requestOutstanding) {
+             // Moves for rounds that were already forfeited arrive too late to count.
+             std::size_t late { std::min<std::size_t>(side.lateMoves, header.count) };
+             side.lateMoves -= late;
+             side.moves.insert(side.moves.end(), payload + late, payload + header.count);
+             side.requestOutstanding = false;
+             m_wheel.Cancel(side.moveDeadline);
+         } else {
+             EndMatch(*side.match, false);
+             return;
+         }
+         offset += frameSize;
+     }
+     side.inbox.erase(side.inbox.begin(), side.inbox.begin() + static_cast<long>(offset));
+ 
+     Pump(*side.match);
+ }
+ 
+ void BotArena::OnWritable(Side& side) {
+     Flush(side);
+ }
+ 
+ void BotArena::Pump(Match& match) {
+     SinglePlayerRpsGame& game { *match.game };
+     while (!game.IsFinished() &&
+            (match.expired || (!match.user.moves.empty() && !match.computer.moves.empty()))) {
+         int userMove { kForfeitedMove };
+         int computerMove { kForfeitedMove };
+         if (!match.expired) {
+             userMove = match.user.moves.front();
+             computerMove = match.computer.moves.front();
+             match.user.moves.pop_front();
+             match.computer.moves.pop_front();
+         }
+ 
+         // A late or malformed move from either bot voids the round.
+         bool valid { IsMove(userMove) && IsMove(computerMove) };
+         if (userMove == kForfeitedMove || computerMove == kForfeitedMove) {
+             ++match.result.timedOutRounds;
+         } else if (!valid) {
+             ++match.result.invalidRounds;
+         }
+         match.messenger->PushMove(valid ? userMove : -1);
+         match.nextComputerMove = valid ? computerMove : 1;
+         game.PlayRound();
+ 
+         match.user.history.push_back(IsMove(computerMove) ? static_cast<std::uint8_t>(computerMove)
+                                                           : BotProtocol::kNoMove);
+         match.computer.history.push_back(IsMove(userMove) ? static_cast<std::uint8_t>(userMove)
+                                                           : BotProtocol::kNoMove);
+     }
+ 
+     if (game.IsFinished()) {
+         EndMatch(match, true);
+         return;
+     }
+ 
+     std::size_t remaining { static_cast<std::size_t>(match.rounds - game.RoundsPlayed()) };
+     for (Side* side : {&match.user, &match.computer}) {
+         if (!match.done && side->helloReceived && !side->requestOutstanding && side->moves.empty()) {
+             SendRequest(*side, side->batchable ? std::min(remaining, BotProtocol::kMaxBatch) : 1);
+         }
+     }
+ }
+ 
+ void BotArena::SendRequest(Side& side, std::size_t count) {
+     std::uint8_t frame[BotProtocol::kMaxFrameSize];
+     std::size_t sent {};
+     // History beyond one frame's capacity goes out in move-less Requests first.
+     while (side.history.size() - sent > BotProtocol::kMaxBatch) {
+         SendFrame(side, frame, BotProtocol::EncodeRequest(0, side.history.data() + sent,
+                                                           BotProtocol::kMaxBatch, frame));
+         sent += BotProtocol::kMaxBatch;
+     }
+     SendFrame(side, frame, BotProtocol::EncodeRequest(count, side.history.data() + sent,
+                                                       side.history.size() - sent, frame));
+     side.history.clear();
+     side.requestOutstanding = true;
+     ArmMoveDeadline(side);
+ }
+ 
+ void BotArena::SendFrame(Side& side, const unsigned char* frame, std::size_t size) {
+     side.outbox.insert(side.outbox.end(), frame, frame + size);
+     Flush(side);
+ }
+ 
+ void BotArena::Flush(Side& side) {
+     std::size_t sent {};
+     while (sent < side.outbox.size()) {
+         ssize_t put { ::send(side.process.Fd(), side.outbox.data() + sent, side.outbox.size() - sent,
+                              MSG_NOSIGNAL | MSG_DONTWAIT) };
+         ++m_syscalls;
+         if (put > 0) {
+             sent += static_cast<std::size_t>(put);
+         } else if (put < 0 && errno == EINTR) {
+             continue;
+         } else if (put < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+             break;
+         } else {
+             EndMatch(*side.match, false);
+             return;
+         }
+     }
+     side.outbox.erase(side.outbox.begin(), side.outbox.begin() + static_cast<long>(sent));
+     WatchWritable(side, !side.outbox.empty());
+ }
+ 
+ void BotArena::WatchWritable(Side& side, bool writable) {
+     if (side.watchingWritable == writable) {
+         return;
+     }
+     epoll_event event {};
+     event.events = EPOLLIN | (writable ? EPOLLOUT : 0u);
+     event.data.ptr = &side;
+     ::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, side.process.Fd(), &event);
+     side.watchingWritable = writable;
+ }
+ 
+ void BotArena::EndMatch(Match& match, bool completed) {
+     if (match.done) {
+         return;
+     }
+     match.done = true;
+     --m_activeMatches;
+     m_wheel.Cancel(match.matchDeadline);
+     m_wheel.Cancel(match.user.moveDeadline);
+     m_wheel.Cancel(match.computer.moveDeadline);
+ 
+     match.result.userScore = match.userPlayer->GetScore();
+     match.result.computerScore = match.computerPlayer->GetScore();
+     match.result.roundsPlayed = match.game->RoundsPlayed();
+     match.result.completed = completed;
+     if (completed) {
+         match.game->Finish();
+     }
+ 
+     std::uint8_t bye[BotProtocol::kHeaderSize];
+     std::size_t byeSize { BotProtocol::EncodeBye(bye) };
+     for (Side* side : {&match.user, &match.computer}) {
+         if (side->process.Fd() < 0) {
+             continue;
+         }
+         if (completed) {
+             // Best effort: a bot that misses Bye still sees end of stream.
+             ::send(side->process.Fd(), bye, byeSize, MSG_NOSIGNAL | MSG_DONTWAIT);
+             ++m_syscalls;
+         }
+         ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, side->process.Fd(), nullptr);
+         side->process.CloseConnection();
+         if (side->missedDeadline) {
+             // It may be stuck; do not let Run() wait for it to notice.
+             side->process.Kill();
+         }
+     }
+ }
+ 
+ void BotArena::ArmMoveDeadline(Side& side) {
+     if (m_moveTimeout.count() <= 0) {
+         return;
+     }
+     Side* self { &side };
+     side.moveDeadline.SetCallback([this, self]() { OnMoveDeadline(*self); });
+     m_wheel.ScheduleAfter(side.moveDeadline, static_cast<std::uint64_t>(m_moveTimeout.count()));
+ }
+ 
+ void BotArena::OnMoveDeadline(Side& side) {
+     Match& match { *side.match };
+     if (match.done) {
+         return;
+     }
+     // Forfeit the round the bot owes a move for and give it another
+     // deadline for the next one; its late answer is discarded.
+     side.missedDeadline = true;
+     side.moves.push_back(kForfeitedMove);
+     if (side.requestOutstanding) {
+         ++side.lateMoves;
+     }
+     ArmMoveDeadline(side);
+     Pump(match);
+ }
+ 
+ void BotArena::OnMatchDeadline(Match& match) {
+     if (match.done) {
+         return;
+     }
+     match.expired = true;
+     for (Side* side : {&match.user, &match.computer}) {
+         side->missedDeadline = side->missedDeadline || side->requestOutstanding || !side->helloReceived;
+     }
+     Pump(match);
+ }
+ 
+ std::uint64_t BotArena::NowTicks() const {
+     auto elapsed = std::chrono::steady_clock::now() - m_start;
+     return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**
+ * @file BotClient.cpp
+ * @brief Implements the BotClient class.
+ */
+
+ #include "BotClient.hpp"
+ #include <cerrno>
+ #include <deque>
+ #include <unistd.h>
+
+ BotClient::BotClient(int inputFd, int outputFd, IMoveStrategy& strategy)
+     : m_inputFd{inputFd}, m_outputFd{outputFd}, m_strategy{&strategy}
+ {
+ }
+ 
+ int BotClient::Run() {
+     std::uint8_t frame[BotProtocol::kMaxFrameSize] {};
+     std::uint8_t flags { m_strategy->DependsOnHistory() ? std::uint8_t{0} : BotProtocol::kBatchable };
+     if (!WriteAll(frame, BotProtocol::EncodeHello(flags, frame))) {
+         return 1;
+     }
+ 
+     // Moves sent but not yet paired with the opponent's reply in a history.
+     std::deque<GameMove> unobserved;
+     std::uint8_t moves[BotProtocol::kMaxBatch] {};
+ 
+     while (true) {
+         if (!ReadExactly(frame, BotProtocol::kHeaderSize)) {
+             return 1;
+         }
+         BotProtocol::FrameHeader header {};
+         BotProtocol::PeekFrame(frame, BotProtocol::kHeaderSize, header);
+         std::size_t payload { BotProtocol::PayloadSize(header) };
+         if (payload > 0 && !ReadExactly(frame + BotProtocol::kHeaderSize, payload)) {
+             return 1;
+         }
+ 
+         if (header.type == BotProtocol::FrameType::Bye) {
+             return 0;
+         }
+         if (header.type != BotProtocol::FrameType::Request) {
+             return 1;
+         }
+ 
+         for (std::size_t i{}; i < header.historyCount && !unobserved.empty(); ++i) {
+             std::uint8_t opponentMove { frame[BotProtocol::kHeaderSize + i] };
+             // Strategies only learn from rounds in which both sides moved.
+             if (opponentMove != BotProtocol::kNoMove) {
+                 m_strategy->ObserveRound(unobserved.front(), static_cast<GameMove>(opponentMove));
+             }
+             unobserved.pop_front();
+         }
+ 
+         if (header.count == 0) {
+             continue;
+         }
+         for (std::size_t i{}; i < header.count; ++i) {
+             GameMove move { m_strategy->NextMove() };
+             unobserved.push_back(move);
+             moves[i] = static_cast<std::uint8_t>(move);
+         }
+         if (!WriteAll(frame, BotProtocol::EncodeMoves(moves, header.count, frame))) {
+             return 1;
+         }
+     }
+ }
+ 
+ bool BotClient::ReadExactly(std::uint8_t* data, std::size_t size) {
+     std::size_t done {};
+     while (done < size) {
+         ssize_t got { ::read(m_inputFd, data + done, size - done) };
+         if (got > 0) {
+             done += static_cast<std::size_t>(got);
+         } else if (got < 0 && errno == EINTR) {
+             continue;
+         } else {
+             return false;
+         }
+     }
+     return true;
+ }
+ 
+ bool BotClient::WriteAll(const std::uint8_t* data, std::size_t size) {
+     std::size_t done {};
+     while (done < size) {
+         ssize_t put { ::write(m_outputFd, data + done, size - done) };
+         if (put > 0) {
+             done += static_cast<std::size_t>(put);
+         } else if (put < 0 && errno == EINTR) {
+             continue;
+         } else {
+             return false;
+         }
+     }
+     return true;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,295 @@
+/**
+ * @file BotDetector.cpp
+ * @brief Implements the BotDetector class.
+ */
+
+ #include "BotDetector.hpp"
+ #include <algorithm>
+ #include <cmath>
+ #include <stdexcept>
+
+ namespace {
+ 
+ constexpr std::size_t kMaxWindow {4096};
+ 
+ /**
+  * @brief Context-model counts are halved when a context reaches this total.
+  */
+ constexpr std::uint32_t kModelCap {64};
+ 
+ /**
+  * @brief The context of a user's first round in a session.
+  */
+ constexpr std::size_t kNoContext {9};
+ constexpr std::uint8_t kNoPair {9};
+ 
+ /**
+  * @brief Code lengths are summed in fixed point, 1/65536 bit, so the window sum is exact.
+  */
+ constexpr double kFixedOne {65536.0};
+ 
+ /**
+  * @brief log2(n) in fixed point for every n a code length can need (2 * total + 3).
+  */
+ struct Log2Table {
+     std::array<std::uint32_t, 2 * kModelCap + 4> values {};
+ 
+     Log2Table() {
+         for (std::size_t n {1}; n < values.size(); ++n) {
+             values[n] = static_cast<std::uint32_t>(std::lround(std::log2(static_cast<double>(n)) * kFixedOne));
+         }
+     }
+ };
+ 
+ const Log2Table& FixedLog2() {
+     static const Log2Table table;
+     return table;
+ }
+ 
+ /**
+  * @brief The move after `move` in Rock, Paper, Scissors order, which also beats it.
+  */
+ constexpr std::uint8_t Beat(std::uint8_t move) {
+     return move == 0 ? 0 : static_cast<std::uint8_t>(move % 3 + 1);
+ }
+ 
+ } // namespace
+ 
+ struct BotDetector::Player {
+     /**
+      * @brief One scored round, kept so its counts can leave the window.
+      */
+     struct Entry {
+         std::uint32_t codeBits {};
+         std::uint8_t move {};
+         std::uint8_t pair {kNoPair};
+         std::uint8_t hits {};
+         bool win {};
+     };
+ 
+     Player(std::string playerName, std::size_t window)
+         : name{std::move(playerName)},
+           entries(window)
+     {
+     }
+ 
+     std::string name {};
+     mutable std::mutex mutex {};
+ 
+     std::vector<Entry> entries {};
+     std::size_t head {};
+     std::size_t count {};
+ 
+     std::array<std::uint32_t, 3> moves {};
+     std::array<std::uint32_t, 9> pairs {};
+     std::array<std::uint32_t, kPredictors> hits {};
+     std::uint32_t wins {};
+     std::uint64_t codeBits {};
+ 
+     /**
+      * @brief Adaptive move counts per context: the previous round's two moves, or none.
+      */
+     std::array<std::array<std::uint8_t, 3>, kNoContext + 1> model {};
+ 
+     std::uint8_t lastUser {};
+     std::uint8_t lastComputer {};
+     std::uint8_t flags {};
+ };
+ 
+ BotDetector::BotDetector(BotDetectorOptions options, FlagHandler handler)
+     : m_options{options},
+       m_handler{std::move(handler)}
+ {
+     if (m_options.windowRounds < 2 || m_options.windowRounds > kMaxWindow) {
+         throw std::invalid_argument("BotDetector: the window must hold 2 to 4096 rounds");
+     }
+     m_nLogN.resize(m_options.windowRounds + 1);
+     for (std::size_t n {1}; n < m_nLogN.size(); ++n) {
+         m_nLogN[n] = static_cast<double>(n) * std::log2(static_cast<double>(n));
+     }
+     FixedLog2();
+ }
+ 
+ BotDetector::~BotDetector() = default;
+ 
+ void BotDetector::OnRound(const RoundRecord& record) {
+     std::uint8_t move { record.userMove };
+     if (move < 1 || move > 3) {
+         return;
+     }
+     Player& player { Find(record.userName) };
+     std::unique_lock<std::mutex> lock{player.mutex};
+ 
+     // Score the predictors and the model on this move before learning from it.
+     std::uint8_t last { player.lastUser };
+     std::uint8_t computer { player.lastComputer };
+     std::size_t context { last != 0 && computer != 0 ? (last - 1) * 3u + (computer - 1) : kNoContext };
+     auto& counts = player.model[context];
+     std::uint32_t total { std::uint32_t{counts[0]} + counts[1] + counts[2] };
+     std::uint8_t modelGuess {};
+     if (total > 0) {
+         modelGuess = static_cast<std::uint8_t>(
+             1 + (std::max_element(counts.begin(), counts.end()) - counts.begin()));
+     }
+     std::uint8_t frequent {};
+     if (player.count > 0) {
+         frequent = static_cast<std::uint8_t>(
+             1 + (std::max_element(player.moves.begin(), player.moves.end()) - player.moves.begin()));
+     }
+     const std::uint8_t guesses[kPredictors] {modelGuess, last, Beat(last), computer, Beat(computer), frequent};
+ 
+     Player::Entry entry {};
+     entry.move = move;
+     entry.pair = last != 0 ? static_cast<std::uint8_t>((last - 1) * 3 + (move - 1)) : kNoPair;
+     entry.win = record.outcome == RoundOutcome::UserWin;
+     for (std::size_t p{}; p < kPredictors; ++p) {
+         entry.hits |= static_cast<std::uint8_t>((guesses[p] == move) << p);
+     }
+     // Krichevsky-Trofimov estimate: P(move) = (count + 1/2) / (total + 3/2).
+     const auto& log2 = FixedLog2().values;
+     entry.codeBits = log2[2 * total + 3] - log2[2u * counts[move - 1] + 1];
+ 
+     ++counts[move - 1];
+     if (total + 1 >= kModelCap) {
+         for (auto& count : counts) {
+             count = static_cast<std::uint8_t>((count + 1) / 2);
+         }
+     }
+ 
+     if (player.count == player.entries.size()) {
+         const Player::Entry& oldest { player.entries[player.head] };
+         --player.moves[oldest.move - 1];
+         if (oldest.pair != kNoPair) {
+             --player.pairs[oldest.pair];
+         }
+         for (std::size_t p{}; p < kPredictors; ++p) {
+             player.hits[p] -= (oldest.hits >> p) & 1u;
+         }
+         player.wins -= oldest.win;
+         player.codeBits -= oldest.codeBits;
+         --player.count;
+     }
+     player.entries[player.head] = entry;
+     player.head = (player.head + 1) % player.entries.size();
+     ++player.count;
+     ++player.moves[move - 1];
+     if (entry.pair != kNoPair) {
+         ++player.pairs[entry.pair];
+     }
+     for (std::size_t p{}; p < kPredictors; ++p) {
+         player.hits[p] += (entry.hits >> p) & 1u;
+     }
+     player.wins += entry.win;
+     player.codeBits += entry.codeBits;
+     player.lastUser = move;
+     player.lastComputer = record.computerMove <= 3 ? record.computerMove : 0;
+ 
+     if (player.count < player.entries.size()) {
+         return;
+     }
+     BotScores scores { Score(player) };
+     std::uint8_t raised {};
+     if (scores.conditionalEntropy < m_options.entropyFloor) {
+         raised |= static_cast<std::uint8_t>(BotFlag::LowEntropy);
+     }
+     if (scores.compressionRatio < m_options.compressionFloor) {
+         raised |= static_cast<std::uint8_t>(BotFlag::Compressible);
+     }
+     if (scores.exploitability > m_options.exploitabilityCeiling) {
+         raised |= static_cast<std::uint8_t>(BotFlag::Predictable);
+     }
+     if (scores.winRate > m_options.winRateCeiling) {
+         raised |= static_cast<std::uint8_t>(BotFlag::PerfectPlay);
+     }
+     if ((raised & ~player.flags) == 0) {
+         return;
+     }
+     player.flags |= raised;
+     scores.flags = player.flags;
+     lock.unlock();
+     if (m_handler) {
+         m_handler(scores);
+     }
+ }
+ 
+ void BotDetector::OnSessionEnd(const SessionSummary& summary) {
+     Player& player { Find(summary.userName) };
+     std::lock_guard<std::mutex> lock{player.mutex};
+     player.lastUser = 0;
+     player.lastComputer = 0;
+ }
+ 
+ std::optional<BotScores> BotDetector::Scores(std::string_view name) const {
+     const Player* player {nullptr};
+     {
+         std::shared_lock<std::shared_mutex> lock{m_namesMutex};
+         auto it = m_players.find(name);
+         if (it == m_players.end()) {
+             return std::nullopt;
+         }
+         player = it->second.get();
+     }
+     std::lock_guard<std::mutex> lock{player->mutex};
+     return Score(*player);
+ }
+ 
+ BotScores BotDetector::Score(const Player& player) const {
+     BotScores scores {};
+     scores.name = player.name;
+     scores.rounds = player.count;
+     scores.flags = player.flags;
+     if (player.count == 0) {
+         return scores;
+     }
+     double rounds { static_cast<double>(player.count) };
+ 
+     double moveSum {};
+     for (auto count : player.moves) {
+         moveSum += m_nLogN[count];
+     }
+     scores.entropy = (m_nLogN[player.count] - moveSum) / rounds;
+ 
+     // H(move | previous) = H(pair) - H(previous move).
+     std::uint32_t pairTotal {};
+     double pairSum {};
+     std::array<std::uint32_t, 3> firsts {};
+     for (std::size_t i{}; i < player.pairs.size(); ++i) {
+         pairTotal += player.pairs[i];
+         pairSum += m_nLogN[player.pairs[i]];
+         firsts[i / 3] += player.pairs[i];
+     }
+     if (pairTotal > 0) {
+         double firstSum {};
+         for (auto count : firsts) {
+             firstSum += m_nLogN[count];
+         }
+         // Both entropies share the n log n term, which cancels.
+         scores.conditionalEntropy = (firstSum - pairSum) / static_cast<double>(pairTotal);
+     }
+ 
+     scores.compressionRatio = static_cast<double>(player.codeBits) / kFixedOne / (rounds * std::log2(3.0));
+     scores.exploitability = static_cast<double>(*std::max_element(player.hits.begin(), player.hits.end())) / rounds;
+     scores.winRate = static_cast<double>(player.wins) / rounds;
+     return scores;
+ }
+ 
+ BotDetector::Player& BotDetector::Find(std::string_view name) {
+     {
+         std::shared_lock<std::shared_mutex> lock{m_namesMutex};
+         auto it = m_players.find(name);
+         if (it != m_players.end()) {
+             return *it->second;
+         }
+     }
+ 
+     std::unique_lock<std::shared_mutex> lock{m_namesMutex};
+     auto it = m_players.find(name);
+     if (it == m_players.end()) {
+         // Entries are never removed, so references handed out stay valid.
+         auto player = std::make_unique<Player>(std::string{name}, m_options.windowRounds);
+         std::string_view key { player->name };
+         it = m_players.emplace(key, std::move(player)).first;
+     }
+     return *it->second;
+ }
+ 
\ No newline at end of file
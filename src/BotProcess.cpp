@@ -0,0 +1,177 @@
+/**
+ * @file BotProcess.cpp
+ * @brief Implements the BotProcess class.
+ */
+
+ #include "BotProcess.hpp"
+ #include <cerrno>
+ #include <csignal>
+ #include <fcntl.h>
+ #include <sys/socket.h>
+ #include <sys/syscall.h>
+ #include <sys/wait.h>
+ #include <system_error>
+ #include <thread>
+ #include <unistd.h>
+
+ namespace {
+ 
+ /**
+  * @brief Closes every descriptor above stderr except `keep`.
+  *
+  * Forked bots must not hold on to the arena's ends of other bots' sockets,
+  * or those bots would never see end of stream.
+  */
+ void CloseInheritedDescriptors(int keep)
+ {
+ #ifdef SYS_close_range
+     bool closed { keep <= 3 || ::syscall(SYS_close_range, 3u, static_cast<unsigned>(keep) - 1u, 0u) == 0 };
+     if (closed && ::syscall(SYS_close_range, static_cast<unsigned>(keep) + 1u, ~0u, 0u) == 0) {
+         return;
+     }
+ #endif
+     long maxFd { ::sysconf(_SC_OPEN_MAX) };
+     if (maxFd < 0 || maxFd > 65536) {
+         maxFd = 65536;
+     }
+     for (int fd {3}; fd < maxFd; ++fd) {
+         if (fd != keep) {
+             ::close(fd);
+         }
+     }
+ }
+ 
+ } // namespace
+ 
+ BotProcess::BotProcess(int fd, pid_t pid)
+     : m_fd{fd}, m_pid{pid}
+ {
+ }
+ 
+ BotProcess::~BotProcess() {
+     Release();
+ }
+ 
+ BotProcess::BotProcess(BotProcess&& other) noexcept
+     : m_fd{other.m_fd}, m_pid{other.m_pid}
+ {
+     other.m_fd = -1;
+     other.m_pid = -1;
+ }
+ 
+ BotProcess& BotProcess::operator=(BotProcess&& other) noexcept {
+     if (this != &other) {
+         Release();
+         m_fd = other.m_fd;
+         m_pid = other.m_pid;
+         other.m_fd = -1;
+         other.m_pid = -1;
+     }
+     return *this;
+ }
+ 
+ BotProcess BotProcess::Launch(const std::vector<std::string>& command) {
+     // Built before forking: the child of a multithreaded parent may only
+     // make async-signal-safe calls, and malloc is not one of them.
+     std::vector<char*> argv;
+     for (const auto& arg : command) {
+         argv.push_back(const_cast<char*>(arg.c_str()));
+     }
+     argv.push_back(nullptr);
+     return Spawn([&argv](int fd) {
+         if (::dup2(fd, STDIN_FILENO) < 0 || ::dup2(fd, STDOUT_FILENO) < 0) {
+             return 127;
+         }
+         ::execvp(argv[0], argv.data());
+         return 127;
+     });
+ }
+ 
+ BotProcess BotProcess::Fork(const std::function<int(int fd)>& body) {
+     return Spawn(body);
+ }
+ 
+ BotProcess BotProcess::Spawn(const std::function<int(int fd)>& child) {
+     int fds[2] {};
+     if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+         throw std::system_error(errno, std::generic_category(), "socketpair");
+     }
+ 
+     pid_t pid { ::fork() };
+     if (pid < 0) {
+         int error { errno };
+         ::close(fds[0]);
+         ::close(fds[1]);
+         throw std::system_error(error, std::generic_category(), "fork");
+     }
+ 
+     if (pid == 0) {
+         ::close(fds[0]);
+         CloseInheritedDescriptors(fds[1]);
+         // Never return into the parent's code (and its atexit handlers).
+         ::_exit(child(fds[1]));
+     }
+ 
+     ::close(fds[1]);
+     ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+     return BotProcess{fds[0], pid};
+ }
+ 
+ int BotProcess::Fd() const {
+     return m_fd;
+ }
+ 
+ pid_t BotProcess::Pid() const {
+     return m_pid;
+ }
+ 
+ void BotProcess::CloseConnection() {
+     if (m_fd >= 0) {
+         ::close(m_fd);
+         m_fd = -1;
+     }
+ }
+ 
+ void BotProcess::Kill() {
+     if (m_pid > 0) {
+         ::kill(m_pid, SIGKILL);
+     }
+ }
+ 
+ int BotProcess::Wait() {
+     if (m_pid < 0) {
+         return -1;
+     }
+     int status {};
+     while (::waitpid(m_pid, &status, 0) < 0 && errno == EINTR) {
+     }
+     m_pid = -1;
+     return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+ }
+ 
+ void BotProcess::Release() {
+     CloseConnection();
+     if (m_pid > 0) {
+         // Give the child time to see end of stream and exit by itself.
+         int status {};
+         auto deadline { std::chrono::steady_clock::now() + kExitGrace };
+         pid_t reaped {};
+         while (std::chrono::steady_clock::now() < deadline) {
+             reaped = ::waitpid(m_pid, &status, WNOHANG);
+             if (reaped < 0 && errno == EINTR) {
+                 reaped = 0;
+             }
+             if (reaped != 0) {
+                 break;
+             }
+             std::this_thread::sleep_for(std::chrono::milliseconds{1});
+         }
+         if (reaped == 0) {
+             // Still running after losing its connection: do not wait forever.
+             ::kill(m_pid, SIGKILL);
+             ::waitpid(m_pid, &status, 0);
+         }
+         m_pid = -1;
+     }
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**
+ * @file BotProtocol.cpp
+ * @brief Implements the BotProtocol class.
+ */
+
+ #include "BotProtocol.hpp"
+ #include <cstring>
+
+ std::size_t BotProtocol::EncodeHello(std::uint8_t flags, std::uint8_t* out) {
+     out[0] = static_cast<std::uint8_t>(FrameType::Hello);
+     out[1] = 0;
+     out[2] = 0;
+     out[3] = flags;
+     return kHeaderSize;
+ }
+ 
+ std::size_t BotProtocol::EncodeRequest(std::size_t count, const std::uint8_t* history,
+                                        std::size_t historyCount, std::uint8_t* out) {
+     out[0] = static_cast<std::uint8_t>(FrameType::Request);
+     out[1] = static_cast<std::uint8_t>(count);
+     out[2] = static_cast<std::uint8_t>(historyCount);
+     out[3] = 0;
+     if (historyCount > 0) {
+         std::memcpy(out + kHeaderSize, history, historyCount);
+     }
+     return kHeaderSize + historyCount;
+ }
+ 
+ std::size_t BotProtocol::EncodeMoves(const std::uint8_t* moves, std::size_t count, std::uint8_t* out) {
+     out[0] = static_cast<std::uint8_t>(FrameType::Moves);
+     out[1] = static_cast<std::uint8_t>(count);
+     out[2] = 0;
+     out[3] = 0;
+     if (count > 0) {
+         std::memcpy(out + kHeaderSize, moves, count);
+     }
+     return kHeaderSize + count;
+ }
+ 
+ std::size_t BotProtocol::EncodeBye(std::uint8_t* out) {
+     out[0] = static_cast<std::uint8_t>(FrameType::Bye);
+     out[1] = 0;
+     out[2] = 0;
+     out[3] = 0;
+     return kHeaderSize;
+ }
+ 
+ std::size_t BotProtocol::PayloadSize(const FrameHeader& header) {
+     switch (header.type) {
+         case FrameType::Request: return header.historyCount;
+         case FrameType::Moves:   return header.count;
+         default:                 return 0;
+     }
+ }
+ 
+ std::size_t BotProtocol::PeekFrame(const std::uint8_t* data, std::size_t size, FrameHeader& header) {
+     if (size < kHeaderSize) {
+         return 0;
+     }
+     header.type = static_cast<FrameType>(data[0]);
+     header.count = data[1];
+     header.historyCount = data[2];
+     header.flags = data[3];
+ 
+     std::size_t frameSize { kHeaderSize + PayloadSize(header) };
+     return size >= frameSize ? frameSize : 0;
+ }
+ 
\ No newline at end of file
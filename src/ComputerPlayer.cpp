@@ -6,11 +6,16 @@
  #include "ComputerPlayer.hpp"
 
  ComputerPlayer::ComputerPlayer(const std::string& computerName)
-     : m_name{"[Computer] " + computerName}, m_score{}
+     : m_name{NameInterner::Global().GetName(NameInterner::Global().Intern("[Computer] " + computerName))},
+       m_score{}
  {
  }
  
  std::string ComputerPlayer::GetName() const {
+     return std::string{m_name};
+ }
+ 
+ std::string_view ComputerPlayer::GetNameView() const {
      return m_name;
  }
  
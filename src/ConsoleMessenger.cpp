@@ -58,11 +58,11 @@
  }
  
  void ConsoleMessenger::DisplayChosenMove(const std::shared_ptr<IPlayer>& player, GameMove move) {
-     std::cout << player->GetName() << " chose: " << ConvertMoveToString(move) << "\n";
+     std::cout << player->GetNameView() << " chose: " << ConvertMoveToString(move) << "\n";
  }
  
  void ConsoleMessenger::AnnounceRoundWinner(const std::shared_ptr<IPlayer>& winner) {
-     std::cout << winner->GetName() << " wins this round!\n\n";
+     std::cout << winner->GetNameView() << " wins this round!\n\n";
  }
  
  void ConsoleMessenger::AnnounceDraw() {
@@ -72,15 +72,15 @@
  void ConsoleMessenger::ShowFinalScore(const std::shared_ptr<IPlayer>& userPlayer,
                                        const std::shared_ptr<IPlayer>& computerPlayer) {
      std::cout << "Final Score => "
-               << userPlayer->GetName() << ": " << userPlayer->GetScore() << " | "
-               << computerPlayer->GetName() << ": " << computerPlayer->GetScore() << "\n";
+               << userPlayer->GetNameView() << ": " << userPlayer->GetScore() << " | "
+               << computerPlayer->GetNameView() << ": " << computerPlayer->GetScore() << "\n";
  }
  
  void ConsoleMessenger::ShowInvalidInputMessage() {
      std::cout << "Invalid input!\n\n";
  }
  
- std::string ConsoleMessenger::ConvertMoveToString(GameMove move) {
+ std::string_view ConsoleMessenger::ConvertMoveToString(GameMove move) {
      switch(move) {
          case GameMove::Rock:     return "Rock";
          case GameMove::Paper:    return "Paper";
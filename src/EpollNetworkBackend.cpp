@@ -0,0 +1,219 @@
+/**
+ * @file EpollNetworkBackend.cpp
+ * @brief Implements the EpollNetworkBackend class.
+ */
+
+ #include "EpollNetworkBackend.hpp"
+ #include <algorithm>
+ #include <cerrno>
+ #include <fcntl.h>
+ #include <stdexcept>
+ #include <sys/epoll.h>
+ #include <sys/socket.h>
+ #include <system_error>
+ #include <unistd.h>
+
+ namespace {
+ 
+ constexpr std::size_t kScratchSize {65536};
+ constexpr int kMaxEvents {256};
+ 
+ } // namespace
+ 
+ EpollNetworkBackend::EpollNetworkBackend()
+     : m_scratch(kScratchSize)
+ {
+     m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+     if (m_epollFd < 0) {
+         throw std::system_error(errno, std::generic_category(), "epoll_create1");
+     }
+ }
+ 
+ EpollNetworkBackend::~EpollNetworkBackend() {
+     for (auto& connection : m_connections) {
+         if (connection.open) {
+             ::close(connection.fd);
+         }
+     }
+     ::close(m_epollFd);
+ }
+ 
+ const char* EpollNetworkBackend::Name() const {
+     return "epoll";
+ }
+ 
+ INetworkBackend::ConnectionId EpollNetworkBackend::Add(int socketFd) {
+     int flags { ::fcntl(socketFd, F_GETFL) };
+     if (flags < 0 || ::fcntl(socketFd, F_SETFL, flags | O_NONBLOCK) < 0) {
+         int error { errno };
+         ::close(socketFd);
+         throw std::system_error(error, std::generic_category(), "fcntl");
+     }
+     m_syscalls += 2;
+ 
+     ConnectionId id {};
+     if (m_free.empty()) {
+         id = static_cast<ConnectionId>(m_connections.size());
+         m_connections.emplace_back();
+     } else {
+         id = m_free.back();
+         m_free.pop_back();
+     }
+ 
+     epoll_event event {};
+     event.events = EPOLLIN;
+     event.data.u32 = id;
+     ++m_syscalls;
+     if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, socketFd, &event) != 0) {
+         int error { errno };
+         ::close(socketFd);
+         m_free.push_back(id);
+         throw std::system_error(error, std::generic_category(), "epoll_ctl");
+     }
+ 
+     Connection& connection { m_connections[id] };
+     connection = Connection{};
+     connection.fd = socketFd;
+     connection.open = true;
+     return id;
+ }
+ 
+ void EpollNetworkBackend::Send(ConnectionId connection, const std::uint8_t* data, std::size_t size) {
+     if (connection >= m_connections.size() || !m_connections[connection].open) {
+         throw std::invalid_argument("EpollNetworkBackend: unknown connection");
+     }
+     Connection& target { m_connections[connection] };
+     if (target.outbox.empty()) {
+         m_dirty.push_back(connection);
+     }
+     target.outbox.insert(target.outbox.end(), data, data + size);
+ }
+ 
+ void EpollNetworkBackend::Remove(ConnectionId connection) {
+     if (connection >= m_connections.size() || !m_connections[connection].open) {
+         throw std::invalid_argument("EpollNetworkBackend: unknown connection");
+     }
+     Connection& target { m_connections[connection] };
+     if (!target.outbox.empty()) {
+         // Best effort: whatever the socket does not take now is dropped.
+         Flush(connection);
+     }
+     ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, target.fd, nullptr);
+     ::close(target.fd);
+     m_syscalls += 2;
+     target = Connection{};
+     m_failed.erase(std::remove(m_failed.begin(), m_failed.end(), connection), m_failed.end());
+     m_free.push_back(connection);
+ }
+ 
+ std::size_t EpollNetworkBackend::Poll(const ReceiveHandler& handler, int timeoutMs) {
+     for (ConnectionId id : m_dirty) {
+         if (m_connections[id].open && !m_connections[id].outbox.empty() && !Flush(id)) {
+             m_failed.push_back(id);
+         }
+     }
+     m_dirty.clear();
+ 
+     std::size_t calls {};
+     std::vector<ConnectionId> failed;
+     failed.swap(m_failed);
+     for (ConnectionId id : failed) {
+         Connection& connection { m_connections[id] };
+         if (connection.open && !connection.ended) {
+             connection.ended = true;
+             handler(id, nullptr, 0);
+             ++calls;
+         }
+     }
+     if (calls > 0) {
+         return calls;
+     }
+ 
+     epoll_event events[kMaxEvents] {};
+     int ready { ::epoll_wait(m_epollFd, events, kMaxEvents, timeoutMs) };
+     ++m_syscalls;
+     if (ready < 0) {
+         if (errno == EINTR) {
+             return 0;
+         }
+         throw std::system_error(errno, std::generic_category(), "epoll_wait");
+     }
+ 
+     for (int i{}; i < ready; ++i) {
+         ConnectionId id { events[i].data.u32 };
+         // The handler may have removed (and the host re-added) this id
+         // earlier in the batch; the calls below are harmless on a fresh
+         // socket, so hang-ups are only trusted once recv() confirms them.
+         if (!m_connections[id].open || m_connections[id].ended) {
+             continue;
+         }
+         if ((events[i].events & EPOLLOUT) && !Flush(id)) {
+             m_connections[id].ended = true;
+             handler(id, nullptr, 0);
+             ++calls;
+             continue;
+         }
+         if (!(events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+             continue;
+         }
+         // Level-triggered: one recv() per wakeup; anything left raises
+         // another event instead of costing a recv() that returns EAGAIN.
+         ssize_t got { ::recv(m_connections[id].fd, m_scratch.data(), m_scratch.size(), 0) };
+         ++m_syscalls;
+         if (got > 0) {
+             handler(id, m_scratch.data(), static_cast<std::size_t>(got));
+             ++calls;
+         } else if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+             m_connections[id].ended = true;
+             handler(id, nullptr, 0);
+             ++calls;
+         }
+     }
+     return calls;
+ }
+ 
+ bool EpollNetworkBackend::Idle() const {
+     // Remove() closes right away, so only queued bytes can be outstanding.
+     return m_dirty.empty();
+ }
+ 
+ std::uint64_t EpollNetworkBackend::SyscallCount() const {
+     return m_syscalls;
+ }
+ 
+ bool EpollNetworkBackend::Flush(ConnectionId connection) {
+     Connection& target { m_connections[connection] };
+     std::size_t sent {};
+     while (sent < target.outbox.size()) {
+         ssize_t put { ::send(target.fd, target.outbox.data() + sent, target.outbox.size() - sent,
+                              MSG_NOSIGNAL | MSG_DONTWAIT) };
+         ++m_syscalls;
+         if (put > 0) {
+             sent += static_cast<std::size_t>(put);
+         } else if (put < 0 && errno == EINTR) {
+             continue;
+         } else if (put < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+             break;
+         } else {
+             target.outbox.clear();
+             return false;
+         }
+     }
+     target.outbox.erase(target.outbox.begin(), target.outbox.begin() + static_cast<long>(sent));
+     WatchWritable(connection, !target.outbox.empty());
+     return true;
+ }
+ 
+ void EpollNetworkBackend::WatchWritable(ConnectionId connection, bool writable) {
+     Connection& target { m_connections[connection] };
+     if (target.watchingWritable == writable) {
+         return;
+     }
+     epoll_event event {};
+     event.events = EPOLLIN | (writable ? EPOLLOUT : 0u);
+     event.data.u32 = connection;
+     ::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, target.fd, &event);
+     ++m_syscalls;
+     target.watchingWritable = writable;
+ }
+ 
\ No newline at end of file
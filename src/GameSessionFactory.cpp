@@ -5,13 +5,38 @@
 
  #include "GameSessionFactory.hpp"
 
+ GameSessionFactory::GameSessionFactory()
+ {
+     m_snapshots.push_back(std::make_unique<const Registry>());
+     m_registry.store(m_snapshots.back().get(), std::memory_order_release);
+ }
+ 
  void GameSessionFactory::RegisterGame(GameMode mode, CreatorFunc func) {
-     m_registry[mode] = std::move(func);
+     std::lock_guard<std::mutex> lock{m_writerMutex};
+ 
+     // Copy the current table, apply the change, then publish the copy.
+     auto next = std::make_unique<Registry>(*m_registry.load(std::memory_order_relaxed));
+     auto index = static_cast<std::size_t>(mode);
+     if (index < kBuiltinGameModeCount) {
+         next->builtin[index] = std::move(func);
+     } else {
+         next->dynamic[mode] = std::move(func);
+     }
+ 
+     m_snapshots.push_back(std::move(next));
+     m_registry.store(m_snapshots.back().get(), std::memory_order_release);
  }
  
- std::unique_ptr<IGameSession> GameSessionFactory::Create(GameMode mode) {
-     auto it = m_registry.find(mode);
-     if (it != m_registry.end()) {
+ std::unique_ptr<IGameSession> GameSessionFactory::Create(GameMode mode) const {
+     const Registry* registry { m_registry.load(std::memory_order_acquire) };
+     auto index = static_cast<std::size_t>(mode);
+     if (index < kBuiltinGameModeCount) {
+         const CreatorFunc& creator { registry->builtin[index] };
+         return creator ? creator() : nullptr;
+     }
+
+     auto it = registry->dynamic.find(mode);
+     if (it != registry->dynamic.end()) {
          return it->second();
      }
      return nullptr;
@@ -0,0 +1,430 @@
+/**
+ * @file HttpGameApi.cpp
+ * @brief Implements the HttpGameApi class.
+ */
+
+ #include "HttpGameApi.hpp"
+ #include "ComputerPlayer.hpp"
+ #include "GameSessionFactory.hpp"
+ #include "QueuedMoveMessenger.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "UserPlayer.hpp"
+ #include <charconv>
+ #include <stdexcept>
+
+ namespace {
+ 
+ constexpr std::string_view kCollection {"/sessions"};
+ constexpr std::string_view kMoves {"/moves"};
+ 
+ std::string_view MoveName(std::uint8_t move) {
+     switch (move) {
+     case 1: return "rock";
+     case 2: return "paper";
+     case 3: return "scissors";
+     default: return "none";
+     }
+ }
+ 
+ std::string_view OutcomeName(RoundOutcome outcome) {
+     switch (outcome) {
+     case RoundOutcome::Draw: return "draw";
+     case RoundOutcome::UserWin: return "user";
+     case RoundOutcome::ComputerWin: return "computer";
+     case RoundOutcome::Forfeit: return "forfeit";
+     }
+     return "unknown";
+ }
+ 
+ int ParseMove(std::string_view name) {
+     if (name == "rock") {
+         return 1;
+     }
+     if (name == "paper") {
+         return 2;
+     }
+     if (name == "scissors") {
+         return 3;
+     }
+     return -1;
+ }
+ 
+ bool ParseNumber(std::string_view text, std::uint64_t& value) {
+     auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+     return error == std::errc{} && end == text.data() + text.size() && !text.empty();
+ }
+ 
+ void AppendNumber(std::string& out, std::int64_t value) {
+     char digits[24];
+     auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+     (void)error;
+     out.append(digits, end);
+ }
+ 
+ void AppendField(std::string& out, std::string_view name, std::int64_t value) {
+     out += '"';
+     out += name;
+     out += "\":";
+     AppendNumber(out, value);
+     out += ',';
+ }
+ 
+ void AppendField(std::string& out, std::string_view name, std::string_view value) {
+     out += '"';
+     out += name;
+     out += "\":\"";
+     out += value;
+     out += "\",";
+ }
+ 
+ void AppendField(std::string& out, std::string_view name, bool value) {
+     out += '"';
+     out += name;
+     out += "\":";
+     out += value ? "true" : "false";
+     out += ',';
+ }
+ 
+ /**
+  * @brief Replaces the trailing comma of the last field with the closing brace.
+  */
+ void CloseObject(std::string& out) {
+     out.back() = '}';
+ }
+ 
+ /**
+  * @brief Finds the raw value of `key` in a flat JSON object.
+  *
+  * Request bodies are tiny flat objects, so this scans for "key" followed
+  * by a colon rather than building a document. Strings are returned
+  * without their quotes and must not contain escapes; nested objects and
+  * arrays are not supported.
+  *
+  * @return False if the key is missing or its value is malformed.
+  */
+ bool FindJsonValue(std::string_view json, std::string_view key, std::string_view& value, bool& isString) {
+     std::size_t position {};
+     while ((position = json.find(key, position)) != std::string_view::npos) {
+         std::size_t end { position + key.size() };
+         bool quoted { position > 0 && json[position - 1] == '"' && end < json.size() && json[end] == '"' };
+         position = end;
+         if (!quoted) {
+             continue;
+         }
+         std::size_t colon { json.find_first_not_of(" \t\r\n", end + 1) };
+         if (colon == std::string_view::npos || json[colon] != ':') {
+             continue;
+         }
+         std::size_t start { json.find_first_not_of(" \t\r\n", colon + 1) };
+         if (start == std::string_view::npos) {
+             return false;
+         }
+         if (json[start] == '"') {
+             std::size_t close { json.find('"', start + 1) };
+             if (close == std::string_view::npos) {
+                 return false;
+             }
+             value = json.substr(start + 1, close - start - 1);
+             isString = true;
+             return value.find('\\') == std::string_view::npos;
+         }
+         std::size_t stop { json.find_first_of(",} \t\r\n", start) };
+         value = json.substr(start, stop == std::string_view::npos ? json.size() - start : stop - start);
+         isString = false;
+         return !value.empty();
+     }
+     return false;
+ }
+ 
+ bool FindJsonString(std::string_view json, std::string_view key, std::string_view& value) {
+     bool isString {};
+     return FindJsonValue(json, key, value, isString) && isString;
+ }
+ 
+ bool FindJsonNumber(std::string_view json, std::string_view key, std::uint64_t& value) {
+     std::string_view text {};
+     bool isString {};
+     return FindJsonValue(json, key, text, isString) && !isString && ParseNumber(text, value);
+ }
+ 
+ /**
+  * @brief Names are echoed into JSON unescaped, so they must need no escaping.
+  */
+ bool IsValidName(std::string_view name) {
+     if (name.empty() || name.size() > HttpGameApi::kMaxNameLength) {
+         return false;
+     }
+     for (char c : name) {
+         if (static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\') {
+             return false;
+         }
+     }
+     return true;
+ }
+ 
+ } // namespace
+ 
+ struct HttpGameApi::Session {
+     std::uint64_t id {};
+     std::string userName {};
+     std::string computerName {};
+     int rounds {};
+     QueuedMoveMessenger* messenger {};
+     std::unique_ptr<SinglePlayerRpsGame> game {};
+ 
+     int userScore {};
+     int computerScore {};
+     int draws {};
+     bool finished {};
+ 
+     /**
+      * @brief The last round played, as reported to OnRound().
+      */
+     RoundRecord lastRound {};
+ };
+ 
+ HttpGameApi::HttpGameApi(GameSessionFactory& factory, GameMode mode, IRoundObserver* next)
+     : m_factory{factory}
+     , m_mode{mode}
+     , m_next{next}
+ {
+ }
+ 
+ HttpGameApi::~HttpGameApi() = default;
+ 
+ int HttpGameApi::Handle(const HttpRequest& request, std::string& body) {
+     body.clear();
+     std::string_view path { request.target.substr(0, request.target.find('?')) };
+     if (path.substr(0, kCollection.size()) != kCollection) {
+         return Error(404, "not found", body);
+     }
+     path.remove_prefix(kCollection.size());
+     if (path.empty() || path == "/") {
+         if (request.method != "POST") {
+             return Error(405, "method not allowed", body);
+         }
+         return CreateSession(request, body);
+     }
+ 
+     if (path[0] != '/') {
+         return Error(404, "not found", body);
+     }
+     path.remove_prefix(1);
+     std::size_t slash { path.find('/') };
+     std::uint64_t id {};
+     if (!ParseNumber(path.substr(0, slash), id)) {
+         return Error(404, "not found", body);
+     }
+     auto found = m_sessions.find(id);
+     if (found == m_sessions.end()) {
+         return Error(404, "no such session", body);
+     }
+     Session& session { *found->second };
+ 
+     if (slash == std::string_view::npos) {
+         if (request.method == "GET") {
+             WriteStatus(session, body);
+             return 200;
+         }
+         if (request.method == "DELETE") {
+             m_sessions.erase(found);
+             return 204;
+         }
+         return Error(405, "method not allowed", body);
+     }
+     if (path.substr(slash) != kMoves) {
+         return Error(404, "not found", body);
+     }
+     if (request.method != "POST") {
+         return Error(405, "method not allowed", body);
+     }
+     return PlayMove(session, request, body);
+ }
+ 
+ HttpSessionSetup& HttpGameApi::PendingSession() {
+     if (!m_pending) {
+         throw std::logic_error("HttpGameApi: no session is being created");
+     }
+     return *m_pending;
+ }
+ 
+ std::unique_ptr<IGameSession> HttpGameApi::MakeSinglePlayerGame(HttpSessionSetup& setup,
+                                                                 std::function<int()> computerMoves) {
+     return std::make_unique<SinglePlayerRpsGame>(
+         std::make_shared<UserPlayer>(setup.userName),
+         std::make_shared<ComputerPlayer>(setup.computerName),
+         std::move(setup.messenger),
+         setup.rounds,
+         std::move(computerMoves),
+         setup.rules
+     );
+ }
+ 
+ std::size_t HttpGameApi::SessionCount() const {
+     return m_sessions.size();
+ }
+ 
+ void HttpGameApi::SetMaxDistinctNames(std::size_t limit) {
+     m_maxDistinctNames = limit;
+ }
+ 
+ std::size_t HttpGameApi::DistinctNameCount() const {
+     return m_names.size();
+ }
+ 
+ void HttpGameApi::OnRound(const RoundRecord& record) {
+     if (m_next != nullptr) {
+         m_next->OnRound(record);
+     }
+     if (!m_playing) {
+         return;
+     }
+     Session& session { *m_playing };
+     session.lastRound = record;
+     session.lastRound.userName = {};
+     session.lastRound.computerName = {};
+     switch (record.outcome) {
+     case RoundOutcome::UserWin:
+         ++session.userScore;
+         break;
+     case RoundOutcome::ComputerWin:
+     case RoundOutcome::Forfeit:
+         ++session.computerScore;
+         break;
+     case RoundOutcome::Draw:
+         ++session.draws;
+         break;
+     }
+ }
+ 
+ void HttpGameApi::OnSessionEnd(const SessionSummary& summary) {
+     if (m_next != nullptr) {
+         m_next->OnSessionEnd(summary);
+     }
+ }
+ 
+ int HttpGameApi::CreateSession(const HttpRequest& request, std::string& body) {
+     std::string_view user {};
+     std::string_view computer {};
+     std::uint64_t rounds {};
+     if (!FindJsonString(request.body, "user", user) || !FindJsonString(request.body, "computer", computer) ||
+         !FindJsonNumber(request.body, "rounds", rounds)) {
+         return Error(400, "expected user, computer and rounds", body);
+     }
+     if (!IsValidName(user) || !IsValidName(computer)) {
+         return Error(400, "invalid player name", body);
+     }
+     if (rounds < 1 || rounds > static_cast<std::uint64_t>(kMaxRounds)) {
+         return Error(400, "rounds out of range", body);
+     }
+     if (!AdmitNames(user, computer)) {
+         return Error(503, "too many distinct player names", body);
+     }
+ 
+     HttpSessionSetup setup {};
+     setup.userName = std::string{user};
+     setup.computerName = std::string{computer};
+     setup.rounds = static_cast<int>(rounds);
+     setup.rules = MatchRulesFor(m_mode, setup.rounds);
+     setup.messenger = std::make_unique<QueuedMoveMessenger>();
+     QueuedMoveMessenger* messenger { setup.messenger.get() };
+ 
+     m_pending = &setup;
+     std::unique_ptr<IGameSession> created;
+     try {
+         created = m_factory.Create(m_mode);
+     } catch (...) {
+         m_pending = nullptr;
+         throw;
+     }
+     m_pending = nullptr;
+ 
+     auto* game = dynamic_cast<SinglePlayerRpsGame*>(created.get());
+     if (!game || setup.messenger) {
+         return Error(500, "game mode does not create HTTP sessions", body);
+     }
+     created.release();
+ 
+     auto session = std::make_unique<Session>();
+     session->id = m_nextId++;
+     session->userName = std::move(setup.userName);
+     session->computerName = std::move(setup.computerName);
+     session->rounds = setup.rounds;
+     session->messenger = messenger;
+     session->game.reset(game);
+     session->game->SetRoundObserver(this, session->id);
+ 
+     Session& stored { *session };
+     m_sessions.emplace(stored.id, std::move(session));
+     WriteStatus(stored, body);
+     return 201;
+ }
+ 
+ bool HttpGameApi::AdmitNames(std::string_view user, std::string_view computer) {
+     std::string userName {user};
+     std::string computerName {computer};
+     bool newUser { m_names.count(userName) == 0 };
+     bool newComputer { computerName != userName && m_names.count(computerName) == 0 };
+     std::size_t added { static_cast<std::size_t>(newUser) + static_cast<std::size_t>(newComputer) };
+     if (added > 0 && m_names.size() + added > m_maxDistinctNames) {
+         return false;
+     }
+     m_names.insert(std::move(userName));
+     m_names.insert(std::move(computerName));
+     return true;
+ }
+ 
+ int HttpGameApi::PlayMove(Session& session, const HttpRequest& request, std::string& body) {
+     std::string_view name {};
+     int move {};
+     if (!FindJsonString(request.body, "move", name) || (move = ParseMove(name)) < 0) {
+         return Error(400, "move must be rock, paper or scissors", body);
+     }
+     if (session.finished) {
+         return Error(409, "session is finished", body);
+     }
+ 
+     session.messenger->PushMove(move);
+     m_playing = &session;
+     session.game->PlayRound();
+     if (session.game->IsFinished()) {
+         session.game->Finish();
+         session.finished = true;
+     }
+     m_playing = nullptr;
+ 
+     const RoundRecord& round { session.lastRound };
+     body += '{';
+     AppendField(body, "id", static_cast<std::int64_t>(session.id));
+     AppendField(body, "round", static_cast<std::int64_t>(round.round));
+     AppendField(body, "user", MoveName(round.userMove));
+     AppendField(body, "computer", MoveName(round.computerMove));
+     AppendField(body, "winner", OutcomeName(round.outcome));
+     AppendField(body, "userScore", static_cast<std::int64_t>(session.userScore));
+     AppendField(body, "computerScore", static_cast<std::int64_t>(session.computerScore));
+     AppendField(body, "finished", session.finished);
+     CloseObject(body);
+     return 200;
+ }
+ 
+ void HttpGameApi::WriteStatus(const Session& session, std::string& body) {
+     body += '{';
+     AppendField(body, "id", static_cast<std::int64_t>(session.id));
+     AppendField(body, "user", std::string_view{session.userName});
+     AppendField(body, "computer", std::string_view{session.computerName});
+     AppendField(body, "rounds", static_cast<std::int64_t>(session.rounds));
+     AppendField(body, "played", static_cast<std::int64_t>(session.game->RoundsPlayed()));
+     AppendField(body, "userScore", static_cast<std::int64_t>(session.userScore));
+     AppendField(body, "computerScore", static_cast<std::int64_t>(session.computerScore));
+     AppendField(body, "draws", static_cast<std::int64_t>(session.draws));
+     AppendField(body, "finished", session.finished);
+     CloseObject(body);
+ }
+ 
+ int HttpGameApi::Error(int status, std::string_view message, std::string& body) {
+     body += '{';
+     AppendField(body, "error", message);
+     CloseObject(body);
+     return status;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,264 @@
+/**
+ * @file HttpLoadGenerator.cpp
+ * @brief Implements the HttpLoadGenerator class.
+ */
+
+ #include "HttpLoadGenerator.hpp"
+ #include <arpa/inet.h>
+ #include <cerrno>
+ #include <charconv>
+ #include <cstring>
+ #include <netinet/in.h>
+ #include <netinet/tcp.h>
+ #include <stdexcept>
+ #include <string_view>
+ #include <sys/epoll.h>
+ #include <sys/socket.h>
+ #include <system_error>
+ #include <unistd.h>
+ #include <vector>
+
+ namespace {
+ 
+ constexpr std::size_t kInputSize {65536};
+ constexpr int kStallTimeoutMs {5000};
+ constexpr const char* kMoves[] {"rock", "paper", "scissors"};
+ 
+ using Clock = std::chrono::steady_clock;
+ 
+ struct Client {
+     int fd {-1};
+     std::string batch {};
+     std::vector<char> input {};
+     std::size_t inputSize {};
+     int outstanding {};
+     bool done {};
+     Clock::time_point sentAt {};
+ };
+ 
+ /**
+  * @brief Reads one response from the front of `buffer`.
+  *
+  * Understands exactly what HttpServer writes: a status line, headers with
+  * an optional "Content-Length" and a body of that length.
+  *
+  * @return The response's size, or 0 if it is not complete yet.
+  */
+ std::size_t ParseResponse(std::string_view buffer, int& status, std::string_view& body) {
+     std::size_t headerEnd { buffer.find("\r\n\r\n") };
+     if (headerEnd == std::string_view::npos) {
+         return 0;
+     }
+     std::string_view head { buffer.substr(0, headerEnd) };
+     if (head.size() < 12 || head.substr(0, 9) != "HTTP/1.1 ") {
+         throw std::runtime_error("HttpLoadGenerator: malformed response");
+     }
+     std::from_chars(head.data() + 9, head.data() + 12, status);
+ 
+     std::size_t length {};
+     constexpr std::string_view kLength {"\r\nContent-Length: "};
+     std::size_t field { head.find(kLength) };
+     if (field != std::string_view::npos) {
+         const char* digits { head.data() + field + kLength.size() };
+         std::from_chars(digits, head.data() + head.size(), length);
+     }
+     std::size_t bodyStart { headerEnd + 4 };
+     if (buffer.size() - bodyStart < length) {
+         return 0;
+     }
+     body = buffer.substr(bodyStart, length);
+     return bodyStart + length;
+ }
+ 
+ void SendAll(int fd, std::string_view data) {
+     while (!data.empty()) {
+         ssize_t put { ::send(fd, data.data(), data.size(), MSG_NOSIGNAL) };
+         if (put < 0) {
+             if (errno == EINTR) {
+                 continue;
+             }
+             throw std::system_error(errno, std::generic_category(), "send");
+         }
+         data.remove_prefix(static_cast<std::size_t>(put));
+     }
+ }
+ 
+ /**
+  * @brief Receives into the client's buffer; false on end of stream.
+  */
+ bool Receive(Client& client) {
+     if (client.inputSize == client.input.size()) {
+         throw std::runtime_error("HttpLoadGenerator: response exceeds the receive buffer");
+     }
+     ssize_t got { ::recv(client.fd, client.input.data() + client.inputSize,
+                          client.input.size() - client.inputSize, 0) };
+     if (got < 0 && errno == EINTR) {
+         return true;
+     }
+     if (got <= 0) {
+         return false;
+     }
+     client.inputSize += static_cast<std::size_t>(got);
+     return true;
+ }
+ 
+ /**
+  * @brief Creates the client's session and returns its id.
+  */
+ std::uint64_t CreateSession(Client& client, int index, int rounds) {
+     std::string body { "{\"user\":\"load" + std::to_string(index) + "\",\"computer\":\"Bot\",\"rounds\":" +
+                        std::to_string(rounds) + "}" };
+     SendAll(client.fd, "POST /sessions HTTP/1.1\r\nHost: localhost\r\nContent-Length: " +
+                        std::to_string(body.size()) + "\r\n\r\n" + body);
+     int status {};
+     std::string_view response {};
+     std::size_t size {};
+     while ((size = ParseResponse({client.input.data(), client.inputSize}, status, response)) == 0) {
+         if (!Receive(client)) {
+             throw std::runtime_error("HttpLoadGenerator: connection closed while creating a session");
+         }
+     }
+     constexpr std::string_view kId {"\"id\":"};
+     std::size_t field { response.find(kId) };
+     std::uint64_t id {};
+     if (status != 201 || field == std::string_view::npos) {
+         throw std::runtime_error("HttpLoadGenerator: session creation failed: " + std::string{response});
+     }
+     std::from_chars(response.data() + field + kId.size(), response.data() + response.size(), id);
+     client.inputSize = 0;
+     return id;
+ }
+ 
+ } // namespace
+ 
+ double HttpLoadReport::RequestsPerSecond() const {
+     return seconds > 0 ? static_cast<double>(requests) / seconds : 0.0;
+ }
+ 
+ HttpLoadGenerator::HttpLoadGenerator(HttpLoadOptions options)
+     : m_options{std::move(options)}
+ {
+     if (m_options.connections < 1 || m_options.pipelineDepth < 1 || m_options.roundsPerSession < 1) {
+         throw std::invalid_argument("HttpLoadGenerator: counts must be positive");
+     }
+     in_addr address {};
+     if (::inet_pton(AF_INET, m_options.address.c_str(), &address) != 1) {
+         throw std::invalid_argument("HttpLoadGenerator: not an IPv4 address: " + m_options.address);
+     }
+ }
+ 
+ HttpLoadReport HttpLoadGenerator::Run() {
+     sockaddr_in address {};
+     address.sin_family = AF_INET;
+     address.sin_port = htons(m_options.port);
+     ::inet_pton(AF_INET, m_options.address.c_str(), &address.sin_addr);
+ 
+     int epollFd { ::epoll_create1(EPOLL_CLOEXEC) };
+     if (epollFd < 0) {
+         throw std::system_error(errno, std::generic_category(), "epoll_create1");
+     }
+     std::vector<Client> clients(static_cast<std::size_t>(m_options.connections));
+     auto closeAll = [&]() {
+         for (auto& client : clients) {
+             if (client.fd >= 0) {
+                 ::close(client.fd);
+             }
+         }
+         ::close(epollFd);
+     };
+ 
+     HttpLoadReport report {};
+     try {
+         for (std::size_t i{}; i < clients.size(); ++i) {
+             Client& client { clients[i] };
+             client.fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+             if (client.fd < 0 || ::connect(client.fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                 throw std::system_error(errno, std::generic_category(), "connect");
+             }
+             int noDelay {1};
+             ::setsockopt(client.fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+             client.input.resize(kInputSize);
+ 
+             std::string id { std::to_string(CreateSession(client, static_cast<int>(i), m_options.roundsPerSession)) };
+             for (int r{}; r < m_options.pipelineDepth; ++r) {
+                 std::string body { std::string{"{\"move\":\""} + kMoves[r % 3] + "\"}" };
+                 client.batch += "POST /sessions/" + id + "/moves HTTP/1.1\r\nHost: localhost\r\nContent-Length: " +
+                                 std::to_string(body.size()) + "\r\n\r\n" + body;
+             }
+ 
+             epoll_event event {};
+             event.events = EPOLLIN;
+             event.data.u64 = i;
+             ::epoll_ctl(epollFd, EPOLL_CTL_ADD, client.fd, &event);
+         }
+ 
+         auto start = Clock::now();
+         auto deadline = start + m_options.duration;
+         double batchSeconds {};
+         std::uint64_t batches {};
+         for (auto& client : clients) {
+             client.sentAt = Clock::now();
+             client.outstanding = m_options.pipelineDepth;
+             SendAll(client.fd, client.batch);
+         }
+ 
+         std::size_t active { clients.size() };
+         epoll_event events[256];
+         while (active > 0) {
+             int ready { ::epoll_wait(epollFd, events, 256, kStallTimeoutMs) };
+             if (ready < 0 && errno == EINTR) {
+                 continue;
+             }
+             if (ready <= 0) {
+                 throw std::runtime_error("HttpLoadGenerator: server stopped responding");
+             }
+             for (int e{}; e < ready; ++e) {
+                 Client& client { clients[events[e].data.u64] };
+                 if (client.done) {
+                     continue;
+                 }
+                 if (!Receive(client)) {
+                     throw std::runtime_error("HttpLoadGenerator: server closed a connection");
+                 }
+ 
+                 std::size_t offset {};
+                 int status {};
+                 std::string_view body {};
+                 while (std::size_t size = ParseResponse({client.input.data() + offset, client.inputSize - offset},
+                                                         status, body)) {
+                     offset += size;
+                     ++report.requests;
+                     if (status < 200 || status > 299) {
+                         ++report.failures;
+                     }
+                     --client.outstanding;
+                 }
+                 std::memmove(client.input.data(), client.input.data() + offset, client.inputSize - offset);
+                 client.inputSize -= offset;
+ 
+                 if (client.outstanding > 0) {
+                     continue;
+                 }
+                 auto now = Clock::now();
+                 batchSeconds += std::chrono::duration<double>(now - client.sentAt).count();
+                 ++batches;
+                 if (now >= deadline) {
+                     client.done = true;
+                     --active;
+                     continue;
+                 }
+                 client.sentAt = now;
+                 client.outstanding = m_options.pipelineDepth;
+                 SendAll(client.fd, client.batch);
+             }
+         }
+         report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+         report.meanBatchMicros = batches > 0 ? batchSeconds / static_cast<double>(batches) * 1e6 : 0.0;
+     } catch (...) {
+         closeAll();
+         throw;
+     }
+     closeAll();
+     return report;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,199 @@
+/**
+ * @file HttpRequestParser.cpp
+ * @brief Implements the HttpRequestParser class.
+ */
+
+ #include "HttpRequestParser.hpp"
+ #include <cstdint>
+
+ namespace {
+ 
+ constexpr std::string_view kLineEnd {"\r\n"};
+ constexpr std::string_view kHeaderEnd {"\r\n\r\n"};
+ 
+ char Lower(char c) {
+     return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+ }
+ 
+ bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+     if (a.size() != b.size()) {
+         return false;
+     }
+     for (std::size_t i{}; i < a.size(); ++i) {
+         if (Lower(a[i]) != Lower(b[i])) {
+             return false;
+         }
+     }
+     return true;
+ }
+ 
+ /**
+  * @brief RFC 9110 token characters, as used in methods and header names.
+  */
+ bool IsTokenChar(char c) {
+     if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+         return true;
+     }
+     switch (c) {
+     case '!': case '#': case '$': case '%': case '&': case '\'': case '*': case '+':
+     case '-': case '.': case '^': case '_': case '`': case '|': case '~':
+         return true;
+     default:
+         return false;
+     }
+ }
+ 
+ bool IsToken(std::string_view text) {
+     if (text.empty()) {
+         return false;
+     }
+     for (char c : text) {
+         if (!IsTokenChar(c)) {
+             return false;
+         }
+     }
+     return true;
+ }
+ 
+ std::string_view Trim(std::string_view text) {
+     while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+         text.remove_prefix(1);
+     }
+     while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+         text.remove_suffix(1);
+     }
+     return text;
+ }
+ 
+ /**
+  * @brief True if the comma-separated list `value` contains `token`.
+  */
+ bool ListContains(std::string_view value, std::string_view token) {
+     while (!value.empty()) {
+         std::size_t comma { value.find(',') };
+         if (EqualsIgnoreCase(Trim(value.substr(0, comma)), token)) {
+             return true;
+         }
+         if (comma == std::string_view::npos) {
+             break;
+         }
+         value.remove_prefix(comma + 1);
+     }
+     return false;
+ }
+ 
+ /**
+  * @brief Parses a Content-Length value; false if it is not a plain decimal.
+  */
+ bool ParseLength(std::string_view text, std::size_t& length) {
+     if (text.empty() || text.size() > 12) {
+         return false;
+     }
+     std::size_t value {};
+     for (char c : text) {
+         if (c < '0' || c > '9') {
+             return false;
+         }
+         value = value * 10 + static_cast<std::size_t>(c - '0');
+     }
+     length = value;
+     return true;
+ }
+ 
+ } // namespace
+ 
+ std::string_view HttpRequest::Header(std::string_view name) const {
+     for (std::size_t i{}; i < headerCount; ++i) {
+         if (EqualsIgnoreCase(headers[i].name, name)) {
+             return headers[i].value;
+         }
+     }
+     return {};
+ }
+ 
+ HttpRequestParser::Result HttpRequestParser::Parse(std::string_view buffer, HttpRequest& request,
+                                                    std::size_t& consumed) {
+     std::size_t headerEnd { buffer.find(kHeaderEnd) };
+     if (headerEnd == std::string_view::npos) {
+         return buffer.size() > kMaxHeaderBytes ? Result::TooLarge : Result::Incomplete;
+     }
+     if (headerEnd + kHeaderEnd.size() > kMaxHeaderBytes) {
+         return Result::TooLarge;
+     }
+ 
+     // Request line: method SP target SP HTTP/1.x
+     std::string_view head { buffer.substr(0, headerEnd + kLineEnd.size()) };
+     std::size_t lineEnd { head.find(kLineEnd) };
+     std::string_view line { head.substr(0, lineEnd) };
+     std::size_t firstSpace { line.find(' ') };
+     std::size_t lastSpace { line.rfind(' ') };
+     if (firstSpace == std::string_view::npos || lastSpace == firstSpace) {
+         return Result::Invalid;
+     }
+     request.method = line.substr(0, firstSpace);
+     request.target = line.substr(firstSpace + 1, lastSpace - firstSpace - 1);
+     std::string_view version { line.substr(lastSpace + 1) };
+     if (!IsToken(request.method) || request.target.empty() ||
+         request.target.find(' ') != std::string_view::npos) {
+         return Result::Invalid;
+     }
+     if (version == "HTTP/1.1") {
+         request.minorVersion = 1;
+     } else if (version == "HTTP/1.0") {
+         request.minorVersion = 0;
+     } else {
+         return Result::Invalid;
+     }
+ 
+     request.headerCount = 0;
+     request.keepAlive = request.minorVersion == 1;
+     bool haveLength {};
+     std::size_t contentLength {};
+     std::size_t position { lineEnd + kLineEnd.size() };
+     while (position < head.size()) {
+         std::size_t end { head.find(kLineEnd, position) };
+         std::string_view field { head.substr(position, end - position) };
+         position = end + kLineEnd.size();
+ 
+         std::size_t colon { field.find(':') };
+         if (colon == std::string_view::npos || !IsToken(field.substr(0, colon))) {
+             // Also rejects obsolete line folding, which starts with whitespace.
+             return Result::Invalid;
+         }
+         if (request.headerCount == HttpRequest::kMaxHeaders) {
+             return Result::TooLarge;
+         }
+         HttpHeader& header { request.headers[request.headerCount++] };
+         header.name = field.substr(0, colon);
+         header.value = Trim(field.substr(colon + 1));
+ 
+         if (EqualsIgnoreCase(header.name, "Content-Length")) {
+             std::size_t length {};
+             if (!ParseLength(header.value, length) || (haveLength && length != contentLength)) {
+                 return Result::Invalid;
+             }
+             haveLength = true;
+             contentLength = length;
+         } else if (EqualsIgnoreCase(header.name, "Transfer-Encoding")) {
+             return Result::Invalid;
+         } else if (EqualsIgnoreCase(header.name, "Connection")) {
+             if (ListContains(header.value, "close")) {
+                 request.keepAlive = false;
+             } else if (ListContains(header.value, "keep-alive")) {
+                 request.keepAlive = true;
+             }
+         }
+     }
+ 
+     if (contentLength > kMaxBodyBytes) {
+         return Result::TooLarge;
+     }
+     std::size_t bodyStart { headerEnd + kHeaderEnd.size() };
+     if (buffer.size() - bodyStart < contentLength) {
+         return Result::Incomplete;
+     }
+     request.body = buffer.substr(bodyStart, contentLength);
+     consumed = bodyStart + contentLength;
+     return Result::Complete;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,385 @@
+/**
+ * @file HttpServer.cpp
+ * @brief Implements the HttpServer class.
+ */
+
+ #include "HttpServer.hpp"
+ #include <algorithm>
+ #include <arpa/inet.h>
+ #include <cerrno>
+ #include <charconv>
+ #include <cstring>
+ #include <netinet/in.h>
+ #include <netinet/tcp.h>
+ #include <stdexcept>
+ #include <sys/epoll.h>
+ #include <sys/eventfd.h>
+ #include <sys/socket.h>
+ #include <system_error>
+ #include <unistd.h>
+
+ namespace {
+ 
+ constexpr int kMaxEvents {256};
+ 
+ /**
+  * @brief Receive buffer size a connection starts with.
+  */
+ constexpr std::size_t kInitialInput {16384};
+ 
+ /**
+  * @brief Large enough for one request at both parser limits.
+  */
+ constexpr std::size_t kMaxInput {HttpRequestParser::kMaxHeaderBytes + HttpRequestParser::kMaxBodyBytes};
+ 
+ std::string_view ReasonPhrase(int status) {
+     switch (status) {
+     case 200: return "OK";
+     case 201: return "Created";
+     case 204: return "No Content";
+     case 400: return "Bad Request";
+     case 404: return "Not Found";
+     case 405: return "Method Not Allowed";
+     case 409: return "Conflict";
+     case 413: return "Content Too Large";
+     case 500: return "Internal Server Error";
+     default: return "Unknown";
+     }
+ }
+ 
+ void AppendNumber(std::string& out, std::size_t value) {
+     char digits[24];
+     auto [end, error] = std::to_chars(digits, digits + sizeof(digits), value);
+     (void)error;
+     out.append(digits, end);
+ }
+ 
+ } // namespace
+ 
+ /**
+  * @brief A client connection and its reusable buffers.
+  */
+ struct HttpServer::Connection {
+     int fd {-1};
+     std::vector<char> input {};
+     std::size_t inputSize {};
+     std::string output {};
+     std::size_t outputSent {};
+ 
+     /**
+      * @brief Set after a response that ends the connection; nothing more is read.
+      */
+     bool closing {};
+     bool closed {};
+     std::uint32_t interest {};
+ };
+ 
+ HttpServer::HttpServer(HttpHandler handler, HttpServerOptions options)
+     : m_handler{std::move(handler)}
+     , m_options{std::move(options)}
+ {
+     sockaddr_in address {};
+     address.sin_family = AF_INET;
+     address.sin_port = htons(m_options.port);
+     if (::inet_pton(AF_INET, m_options.address.c_str(), &address.sin_addr) != 1) {
+         throw std::invalid_argument("HttpServer: not an IPv4 address: " + m_options.address);
+     }
+ 
+     m_listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+     if (m_listenFd < 0) {
+         throw std::system_error(errno, std::generic_category(), "socket");
+     }
+     int reuse {1};
+     ::setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+     socklen_t length { sizeof(address) };
+     if (::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+         ::listen(m_listenFd, m_options.backlog) != 0 ||
+         ::getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+         int error { errno };
+         ::close(m_listenFd);
+         throw std::system_error(error, std::generic_category(), "bind/listen");
+     }
+     m_port = ntohs(address.sin_port);
+ 
+     m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+     m_wakeFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+     if (m_epollFd < 0 || m_wakeFd < 0) {
+         int error { errno };
+         ::close(m_listenFd);
+         if (m_epollFd >= 0) {
+             ::close(m_epollFd);
+         }
+         throw std::system_error(error, std::generic_category(), "epoll_create1/eventfd");
+     }
+     for (int fd : {m_listenFd, m_wakeFd}) {
+         epoll_event event {};
+         event.events = EPOLLIN;
+         event.data.fd = fd;
+         ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event);
+     }
+ }
+ 
+ HttpServer::~HttpServer() {
+     for (auto& connection : m_connections) {
+         if (connection && !connection->closed) {
+             ::close(connection->fd);
+         }
+     }
+     ReleaseClosed();
+     ::close(m_wakeFd);
+     ::close(m_epollFd);
+     ::close(m_listenFd);
+ }
+ 
+ std::uint16_t HttpServer::Port() const {
+     return m_port;
+ }
+ 
+ void HttpServer::Run() {
+     epoll_event events[kMaxEvents] {};
+     while (!m_stopping.load(std::memory_order_acquire)) {
+         int ready { ::epoll_wait(m_epollFd, events, kMaxEvents, -1) };
+         if (ready < 0) {
+             if (errno == EINTR) {
+                 continue;
+             }
+             throw std::system_error(errno, std::generic_category(), "epoll_wait");
+         }
+         for (int i{}; i < ready; ++i) {
+             int fd { events[i].data.fd };
+             if (fd == m_listenFd) {
+                 Accept();
+                 continue;
+             }
+             if (fd == m_wakeFd) {
+                 continue;
+             }
+             Connection& connection { *m_connections[static_cast<std::size_t>(fd)] };
+             if (!connection.closed && (events[i].events & EPOLLOUT)) {
+                 OnWritable(connection);
+             }
+             if (!connection.closed && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+                 OnReadable(connection);
+             }
+         }
+         ReleaseClosed();
+     }
+ }
+ 
+ void HttpServer::Stop() {
+     m_stopping.store(true, std::memory_order_release);
+     std::uint64_t one {1};
+     (void)::write(m_wakeFd, &one, sizeof(one));
+ }
+ 
+ HttpServerStats HttpServer::Stats() const {
+     HttpServerStats stats {};
+     stats.connections = m_connectionCount.load(std::memory_order_relaxed);
+     stats.requests = m_requests.load(std::memory_order_relaxed);
+     stats.rejected = m_rejected.load(std::memory_order_relaxed);
+     stats.recvCalls = m_recvCalls.load(std::memory_order_relaxed);
+     stats.sendCalls = m_sendCalls.load(std::memory_order_relaxed);
+     return stats;
+ }
+ 
+ void HttpServer::AppendResponse(std::string& out, int status, std::string_view body, bool keepAlive,
+                                 int minorVersion) {
+     out += "HTTP/1.1 ";
+     AppendNumber(out, static_cast<std::size_t>(status));
+     out += ' ';
+     out += ReasonPhrase(status);
+     out += "\r\n";
+     if (status != 204) {
+         out += "Content-Type: application/json\r\nContent-Length: ";
+         AppendNumber(out, body.size());
+         out += "\r\n";
+     }
+     if (!keepAlive) {
+         out += "Connection: close\r\n";
+     } else if (minorVersion == 0) {
+         out += "Connection: keep-alive\r\n";
+     }
+     out += "\r\n";
+     if (status != 204) {
+         out += body;
+     }
+ }
+ 
+ void HttpServer::Accept() {
+     for (;;) {
+         int fd { ::accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC) };
+         if (fd < 0) {
+             // EAGAIN ends the backlog; running out of descriptors leaves
+             // the rest queued until a connection closes.
+             return;
+         }
+         int noDelay {1};
+         ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+ 
+         auto index = static_cast<std::size_t>(fd);
+         if (m_connections.size() <= index) {
+             m_connections.resize(index + 1);
+         }
+         if (!m_connections[index]) {
+             m_connections[index] = std::make_unique<Connection>();
+         }
+         Connection& connection { *m_connections[index] };
+         connection.fd = fd;
+         connection.input.resize(kInitialInput);
+         connection.inputSize = 0;
+         connection.output.clear();
+         connection.outputSent = 0;
+         connection.closing = false;
+         connection.closed = false;
+         connection.interest = EPOLLIN;
+ 
+         epoll_event event {};
+         event.events = EPOLLIN;
+         event.data.fd = fd;
+         if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+             ::close(fd);
+             connection.closed = true;
+             continue;
+         }
+         m_connectionCount.fetch_add(1, std::memory_order_relaxed);
+     }
+ }
+ 
+ void HttpServer::OnReadable(Connection& connection) {
+     if (connection.inputSize == connection.input.size()) {
+         // A partial request fills the buffer; the parser limits keep it below kMaxInput.
+         if (connection.input.size() == kMaxInput) {
+             return;
+         }
+         connection.input.resize(std::min(connection.input.size() * 2, kMaxInput));
+     }
+     ssize_t got { ::recv(connection.fd, connection.input.data() + connection.inputSize,
+                          connection.input.size() - connection.inputSize, 0) };
+     m_recvCalls.fetch_add(1, std::memory_order_relaxed);
+     if (got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+         Close(connection);
+         return;
+     }
+     if (got < 0) {
+         return;
+     }
+     connection.inputSize += static_cast<std::size_t>(got);
+     HandleRequests(connection);
+     Flush(connection);
+ }
+ 
+ void HttpServer::OnWritable(Connection& connection) {
+     Flush(connection);
+     if (!connection.closed && !connection.closing && connection.inputSize > 0) {
+         // Requests held back while the output was full.
+         HandleRequests(connection);
+         Flush(connection);
+     }
+ }
+ 
+ void HttpServer::HandleRequests(Connection& connection) {
+     std::size_t offset {};
+     HttpRequest request {};
+     while (!connection.closing && connection.output.size() - connection.outputSent < m_options.maxPendingOutput) {
+         std::string_view pending { connection.input.data() + offset, connection.inputSize - offset };
+         std::size_t consumed {};
+         auto result = HttpRequestParser::Parse(pending, request, consumed);
+         if (result == HttpRequestParser::Result::Incomplete) {
+             break;
+         }
+         if (result != HttpRequestParser::Result::Complete) {
+             int status { result == HttpRequestParser::Result::TooLarge ? 413 : 400 };
+             AppendResponse(connection.output, status, {}, false);
+             m_rejected.fetch_add(1, std::memory_order_relaxed);
+             connection.closing = true;
+             offset = connection.inputSize;
+             break;
+         }
+ 
+         int status {};
+         try {
+             status = m_handler(request, m_body);
+         } catch (const std::exception&) {
+             status = 500;
+             m_body.clear();
+         }
+         AppendResponse(connection.output, status, m_body, request.keepAlive, request.minorVersion);
+         m_requests.fetch_add(1, std::memory_order_relaxed);
+         offset += consumed;
+         if (!request.keepAlive) {
+             connection.closing = true;
+         }
+     }
+ 
+     if (connection.closing) {
+         connection.inputSize = 0;
+     } else if (offset > 0) {
+         std::memmove(connection.input.data(), connection.input.data() + offset, connection.inputSize - offset);
+         connection.inputSize -= offset;
+     }
+ }
+ 
+ void HttpServer::Flush(Connection& connection) {
+     while (connection.outputSent < connection.output.size()) {
+         ssize_t put { ::send(connection.fd, connection.output.data() + connection.outputSent,
+                              connection.output.size() - connection.outputSent, MSG_NOSIGNAL) };
+         m_sendCalls.fetch_add(1, std::memory_order_relaxed);
+         if (put > 0) {
+             connection.outputSent += static_cast<std::size_t>(put);
+         } else if (put < 0 && errno == EINTR) {
+             continue;
+         } else if (put < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+             break;
+         } else {
+             Close(connection);
+             return;
+         }
+     }
+     if (connection.outputSent == connection.output.size()) {
+         connection.output.clear();
+         connection.outputSent = 0;
+         if (connection.closing) {
+             Close(connection);
+             return;
+         }
+     }
+     UpdateInterest(connection);
+ }
+ 
+ void HttpServer::UpdateInterest(Connection& connection) {
+     std::size_t unsent { connection.output.size() - connection.outputSent };
+     std::uint32_t interest {};
+     if (unsent > 0) {
+         interest |= EPOLLOUT;
+     }
+     if (!connection.closing && unsent < m_options.maxPendingOutput) {
+         interest |= EPOLLIN;
+     }
+     if (interest == connection.interest) {
+         return;
+     }
+     epoll_event event {};
+     event.events = interest;
+     event.data.fd = connection.fd;
+     ::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+     connection.interest = interest;
+ }
+ 
+ void HttpServer::Close(Connection& connection) {
+     ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, connection.fd, nullptr);
+     connection.closed = true;
+     m_closed.push_back(connection.fd);
+ }
+ 
+ void HttpServer::ReleaseClosed() {
+     // The descriptor stays open until the batch is done, so a later event
+     // in the same batch cannot refer to a new connection reusing it.
+     for (int fd : m_closed) {
+         ::close(fd);
+         Connection& connection { *m_connections[static_cast<std::size_t>(fd)] };
+         std::vector<char>{}.swap(connection.input);
+         std::string{}.swap(connection.output);
+     }
+     m_closed.clear();
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,463 @@
+/**
+ * @file IoUringNetworkBackend.cpp
+ * @brief Implements the IoUringNetworkBackend class.
+ *
+ * liburing is not required: the few ring operations needed here are done
+ * directly on the mapped rings, following the kernel's io_uring ABI.
+ */
+
+ #include "IoUringNetworkBackend.hpp"
+ #include <algorithm>
+ #include <cerrno>
+ #include <cstring>
+ #include <fcntl.h>
+ #include <linux/io_uring.h>
+ #include <linux/time_types.h>
+ #include <signal.h>
+ #include <stdexcept>
+ #include <sys/mman.h>
+ #include <sys/syscall.h>
+ #include <sys/uio.h>
+ #include <system_error>
+ #include <unistd.h>
+
+ namespace {
+ 
+ /**
+  * @brief Provided-buffer group all receives draw from.
+  */
+ constexpr std::uint16_t kBufferGroup {0};
+ 
+ constexpr unsigned kOperationBits {8};
+ constexpr std::uint64_t kOperationMask {(1u << kOperationBits) - 1};
+ 
+ int SetupRing(unsigned entries, io_uring_params& params) {
+     return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+ }
+ 
+ int RegisterRing(int ringFd, unsigned opcode, const void* argument, unsigned count) {
+     return static_cast<int>(::syscall(__NR_io_uring_register, ringFd, opcode, argument, count));
+ }
+ 
+ } // namespace
+ 
+ IoUringNetworkBackend::IoUringNetworkBackend(IoUringOptions options)
+     : m_options{options}
+ {
+     unsigned buffers { m_options.receiveBuffers };
+     if (m_options.queueDepth == 0 || m_options.maxConnections == 0 || m_options.sendSlotSize == 0 ||
+         m_options.receiveBufferSize == 0 || buffers == 0 || (buffers & (buffers - 1)) != 0 || buffers > 32768) {
+         throw std::invalid_argument("IoUringNetworkBackend: invalid options");
+     }
+ 
+     try {
+         // Cooperative task running saves an interrupt per completion; older
+         // kernels reject the flag, so retry without it.
+         io_uring_params params {};
+         params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN;
+         params.cq_entries = m_options.queueDepth * 4;
+         m_ringFd = SetupRing(m_options.queueDepth, params);
+         if (m_ringFd < 0 && errno == EINVAL) {
+             params = io_uring_params{};
+             params.flags = IORING_SETUP_CQSIZE;
+             params.cq_entries = m_options.queueDepth * 4;
+             m_ringFd = SetupRing(m_options.queueDepth, params);
+         }
+         ++m_syscalls;
+         if (m_ringFd < 0) {
+             throw std::system_error(errno, std::generic_category(), "io_uring_setup");
+         }
+         if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG) ||
+             !(params.features & IORING_FEAT_NODROP)) {
+             throw std::system_error(ENOTSUP, std::generic_category(), "io_uring features");
+         }
+ 
+         std::size_t sqSize { params.sq_off.array + params.sq_entries * sizeof(unsigned) };
+         std::size_t cqSize { params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe) };
+         m_sqRingSize = std::max(sqSize, cqSize);
+         void* ring { ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             m_ringFd, IORING_OFF_SQ_RING) };
+         if (ring == MAP_FAILED) {
+             throw std::system_error(errno, std::generic_category(), "mmap");
+         }
+         m_sqRing = ring;
+         m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+         void* sqes { ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                             m_ringFd, IORING_OFF_SQES) };
+         if (sqes == MAP_FAILED) {
+             throw std::system_error(errno, std::generic_category(), "mmap");
+         }
+         m_sqes = static_cast<io_uring_sqe*>(sqes);
+ 
+         auto* base = static_cast<std::uint8_t*>(m_sqRing);
+         m_sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+         m_sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+         m_sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+         m_sqEntries = params.sq_entries;
+         m_sqArray = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+         m_sqLocalTail = *m_sqTail;
+         m_cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+         m_cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+         m_cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+         m_cqes = reinterpret_cast<io_uring_cqe*>(base + params.cq_off.cqes);
+ 
+         // The provided-buffer ring must be page aligned; an anonymous mapping is.
+         m_bufferRingSize = buffers * sizeof(io_uring_buf);
+         void* bufferRing { ::mmap(nullptr, m_bufferRingSize, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+         if (bufferRing == MAP_FAILED) {
+             throw std::system_error(errno, std::generic_category(), "mmap");
+         }
+         m_bufferRing = static_cast<io_uring_buf*>(bufferRing);
+         io_uring_buf_reg bufferRegistration {};
+         bufferRegistration.ring_addr = reinterpret_cast<std::uint64_t>(m_bufferRing);
+         bufferRegistration.ring_entries = buffers;
+         bufferRegistration.bgid = kBufferGroup;
+         ++m_syscalls;
+         if (RegisterRing(m_ringFd, IORING_REGISTER_PBUF_RING, &bufferRegistration, 1) < 0) {
+             throw std::system_error(errno, std::generic_category(), "io_uring_register(PBUF_RING)");
+         }
+         m_receiveArena.resize(buffers * m_options.receiveBufferSize);
+         for (unsigned i{}; i < buffers; ++i) {
+             AddBuffer(static_cast<std::uint16_t>(i));
+         }
+         __atomic_store_n(&m_bufferRing[0].resv, m_bufferTail, __ATOMIC_RELEASE);
+ 
+         // Sized once: the kernel keeps the registered pages pinned.
+         m_sendArena.resize(m_options.maxConnections * m_options.sendSlotSize);
+         iovec arena { m_sendArena.data(), m_sendArena.size() };
+         ++m_syscalls;
+         if (RegisterRing(m_ringFd, IORING_REGISTER_BUFFERS, &arena, 1) < 0) {
+             throw std::system_error(errno, std::generic_category(), "io_uring_register(BUFFERS)");
+         }
+     } catch (...) {
+         CloseRing();
+         throw;
+     }
+ }
+ 
+ IoUringNetworkBackend::~IoUringNetworkBackend() {
+     // Closing the ring cancels whatever is still pending on the sockets.
+     CloseRing();
+     for (auto& connection : m_connections) {
+         if (connection.open) {
+             ::close(connection.fd);
+         }
+     }
+ }
+ 
+ const char* IoUringNetworkBackend::Name() const {
+     return "io_uring";
+ }
+ 
+ INetworkBackend::ConnectionId IoUringNetworkBackend::Add(int socketFd) {
+     if (m_free.empty() && m_connections.size() == m_options.maxConnections) {
+         ::close(socketFd);
+         throw std::runtime_error("IoUringNetworkBackend: too many connections");
+     }
+     // io_uring waits for readiness itself; on a non-blocking socket a
+     // write would complete with -EAGAIN instead.
+     int flags { ::fcntl(socketFd, F_GETFL) };
+     if (flags < 0 || ::fcntl(socketFd, F_SETFL, flags & ~O_NONBLOCK) < 0) {
+         int error { errno };
+         ::close(socketFd);
+         throw std::system_error(error, std::generic_category(), "fcntl");
+     }
+     m_syscalls += 2;
+ 
+     ConnectionId id {};
+     if (m_free.empty()) {
+         id = static_cast<ConnectionId>(m_connections.size());
+         m_connections.emplace_back();
+     } else {
+         id = m_free.back();
+         m_free.pop_back();
+     }
+     Connection& connection { m_connections[id] };
+     connection = Connection{};
+     connection.fd = socketFd;
+     connection.open = true;
+     ArmReceive(id);
+     return id;
+ }
+ 
+ void IoUringNetworkBackend::Send(ConnectionId connection, const std::uint8_t* data, std::size_t size) {
+     if (connection >= m_connections.size() || !m_connections[connection].open ||
+         m_connections[connection].closing) {
+         throw std::invalid_argument("IoUringNetworkBackend: unknown connection");
+     }
+     Connection& target { m_connections[connection] };
+     if (target.inFlight + target.queued + size > m_options.sendSlotSize) {
+         throw std::length_error("IoUringNetworkBackend: send slot full");
+     }
+     std::memcpy(SendSlot(connection) + target.inFlight + target.queued, data, size);
+     target.queued += size;
+     // With a write in flight, its completion starts the next one.
+     if (target.inFlight == 0 && !target.dirty) {
+         target.dirty = true;
+         m_dirty.push_back(connection);
+     }
+ }
+ 
+ void IoUringNetworkBackend::Remove(ConnectionId connection) {
+     if (connection >= m_connections.size() || !m_connections[connection].open ||
+         m_connections[connection].closing) {
+         throw std::invalid_argument("IoUringNetworkBackend: unknown connection");
+     }
+     Connection& target { m_connections[connection] };
+     target.closing = true;
+     ++m_closing;
+     if (target.ended) {
+         target.queued = 0;
+     }
+     if (target.receiveArmed) {
+         QueueCancel(connection);
+     }
+     ReleaseIfIdle(connection);
+ }
+ 
+ std::size_t IoUringNetworkBackend::Poll(const ReceiveHandler& handler, int timeoutMs) {
+     for (ConnectionId id : m_dirty) {
+         Connection& connection { m_connections[id] };
+         connection.dirty = false;
+         if (connection.open && connection.inFlight == 0 && connection.queued > 0) {
+             StartWrite(id);
+         }
+     }
+     m_dirty.clear();
+ 
+     // Submit and wait in one call; skip the wait if completions are already in.
+     bool ready { *m_cqHead != __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE) };
+     if (m_toSubmit > 0 || !ready) {
+         Enter(ready ? 0 : 1, timeoutMs);
+     }
+ 
+     std::size_t calls {};
+     unsigned head { *m_cqHead };
+     unsigned tail { __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE) };
+     while (head != tail) {
+         const io_uring_cqe& cqe { m_cqes[head & m_cqMask] };
+         std::uint64_t userData { cqe.user_data };
+         int result { cqe.res };
+         unsigned flags { cqe.flags };
+         ++head;
+         __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+ 
+         auto id = static_cast<ConnectionId>(userData >> kOperationBits);
+         auto operation = static_cast<Operation>(userData & kOperationMask);
+         if (operation == Operation::Cancel) {
+             continue;
+         }
+         Connection& connection { m_connections[id] };
+         bool live { connection.open && !connection.closing && !connection.ended };
+ 
+         if (operation == Operation::Receive) {
+             bool more { (flags & IORING_CQE_F_MORE) != 0 };
+             connection.receiveArmed = more;
+             if (result > 0) {
+                 auto bufferId = static_cast<std::uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+                 if (live) {
+                     handler(id, m_receiveArena.data() + bufferId * m_options.receiveBufferSize,
+                             static_cast<std::size_t>(result));
+                     ++calls;
+                 }
+                 RecycleBuffer(bufferId);
+             } else if (result == -EINVAL && m_multishot && !more) {
+                 // Multishot recv is newer than provided-buffer rings.
+                 m_multishot = false;
+             } else if (result != -ENOBUFS && result != -ECANCELED) {
+                 // End of stream or a socket error.
+                 if (live) {
+                     connection.ended = true;
+                     handler(id, nullptr, 0);
+                     ++calls;
+                 }
+             }
+             // Running out of buffers, a one-shot recv or a refused
+             // multishot only ends this recv; arm another.
+             if (!connection.receiveArmed && connection.open && !connection.closing && !connection.ended) {
+                 ArmReceive(id);
+             }
+         } else {
+             std::uint8_t* slot { SendSlot(id) };
+             if (result < 0) {
+                 connection.inFlight = 0;
+                 connection.queued = 0;
+                 if (live) {
+                     connection.ended = true;
+                     handler(id, nullptr, 0);
+                     ++calls;
+                 }
+             } else {
+                 // Keep what the socket did not take in front of what was queued meanwhile.
+                 std::size_t written { static_cast<std::size_t>(result) };
+                 std::size_t rest { connection.inFlight - written + connection.queued };
+                 std::memmove(slot, slot + written, rest);
+                 connection.inFlight = 0;
+                 connection.queued = rest;
+                 if (connection.queued > 0 && !connection.ended) {
+                     StartWrite(id);
+                 } else {
+                     connection.queued = 0;
+                 }
+             }
+         }
+         if (connection.closing) {
+             ReleaseIfIdle(id);
+         }
+     }
+     return calls;
+ }
+ 
+ bool IoUringNetworkBackend::Idle() const {
+     return m_dirty.empty() && m_toSubmit == 0 && m_closing == 0;
+ }
+ 
+ std::uint64_t IoUringNetworkBackend::SyscallCount() const {
+     return m_syscalls;
+ }
+ 
+ bool IoUringNetworkBackend::UsesMultishotReceive() const {
+     return m_multishot;
+ }
+ 
+ io_uring_sqe* IoUringNetworkBackend::NextSqe() {
+     if (m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries) {
+         Enter(0, 0);
+         if (m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries) {
+             throw std::runtime_error("IoUringNetworkBackend: submission queue full");
+         }
+     }
+     unsigned index { m_sqLocalTail & m_sqMask };
+     io_uring_sqe* sqe { &m_sqes[index] };
+     std::memset(sqe, 0, sizeof(*sqe));
+     m_sqArray[index] = index;
+     ++m_sqLocalTail;
+     ++m_toSubmit;
+     return sqe;
+ }
+ 
+ void IoUringNetworkBackend::Enter(unsigned waitFor, int timeoutMs) {
+     __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+ 
+     unsigned flags { waitFor > 0 ? IORING_ENTER_GETEVENTS : 0u };
+     __kernel_timespec timeout {};
+     io_uring_getevents_arg argument {};
+     const void* extra { nullptr };
+     std::size_t extraSize {};
+     if (waitFor > 0 && timeoutMs >= 0) {
+         timeout.tv_sec = timeoutMs / 1000;
+         timeout.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+         argument.sigmask_sz = _NSIG / 8;
+         argument.ts = reinterpret_cast<std::uint64_t>(&timeout);
+         flags |= IORING_ENTER_EXT_ARG;
+         extra = &argument;
+         extraSize = sizeof(argument);
+     }
+     long submitted { ::syscall(__NR_io_uring_enter, m_ringFd, m_toSubmit, waitFor, flags, extra, extraSize) };
+     ++m_syscalls;
+     if (submitted >= 0) {
+         m_toSubmit -= static_cast<unsigned>(submitted);
+         return;
+     }
+     // Interrupted, timed out, or completions must be reaped before more
+     // can be submitted: the caller's next Poll() carries on.
+     if (errno != EINTR && errno != ETIME && errno != EBUSY && errno != EAGAIN) {
+         throw std::system_error(errno, std::generic_category(), "io_uring_enter");
+     }
+ }
+ 
+ void IoUringNetworkBackend::ArmReceive(ConnectionId connection) {
+     io_uring_sqe* sqe { NextSqe() };
+     sqe->opcode = IORING_OP_RECV;
+     sqe->fd = m_connections[connection].fd;
+     sqe->flags = IOSQE_BUFFER_SELECT;
+     sqe->buf_group = kBufferGroup;
+     sqe->ioprio = m_multishot ? IORING_RECV_MULTISHOT : 0;
+     sqe->user_data = (static_cast<std::uint64_t>(connection) << kOperationBits) |
+                      static_cast<std::uint64_t>(Operation::Receive);
+     m_connections[connection].receiveArmed = true;
+ }
+ 
+ void IoUringNetworkBackend::StartWrite(ConnectionId connection) {
+     Connection& target { m_connections[connection] };
+     target.inFlight = target.queued;
+     target.queued = 0;
+ 
+     io_uring_sqe* sqe { NextSqe() };
+     sqe->opcode = IORING_OP_WRITE_FIXED;
+     sqe->fd = target.fd;
+     sqe->addr = reinterpret_cast<std::uint64_t>(SendSlot(connection));
+     sqe->len = static_cast<std::uint32_t>(target.inFlight);
+     sqe->buf_index = 0;
+     sqe->user_data = (static_cast<std::uint64_t>(connection) << kOperationBits) |
+                      static_cast<std::uint64_t>(Operation::Write);
+ }
+ 
+ void IoUringNetworkBackend::QueueCancel(ConnectionId connection) {
+     Connection& target { m_connections[connection] };
+     if (target.cancelQueued) {
+         return;
+     }
+     target.cancelQueued = true;
+     io_uring_sqe* sqe { NextSqe() };
+     sqe->opcode = IORING_OP_ASYNC_CANCEL;
+     sqe->fd = -1;
+     sqe->addr = (static_cast<std::uint64_t>(connection) << kOperationBits) |
+                 static_cast<std::uint64_t>(Operation::Receive);
+     sqe->user_data = (static_cast<std::uint64_t>(connection) << kOperationBits) |
+                      static_cast<std::uint64_t>(Operation::Cancel);
+ }
+ 
+ std::uint8_t* IoUringNetworkBackend::SendSlot(ConnectionId connection) {
+     return m_sendArena.data() + connection * m_options.sendSlotSize;
+ }
+ 
+ void IoUringNetworkBackend::AddBuffer(std::uint16_t bufferId) {
+     // Field by field: entry 0's reserved field is the ring's tail.
+     io_uring_buf& entry { m_bufferRing[m_bufferTail & (m_options.receiveBuffers - 1)] };
+     entry.addr = reinterpret_cast<std::uint64_t>(m_receiveArena.data() + bufferId * m_options.receiveBufferSize);
+     entry.len = static_cast<std::uint32_t>(m_options.receiveBufferSize);
+     entry.bid = bufferId;
+     ++m_bufferTail;
+ }
+ 
+ void IoUringNetworkBackend::RecycleBuffer(std::uint16_t bufferId) {
+     AddBuffer(bufferId);
+     __atomic_store_n(&m_bufferRing[0].resv, m_bufferTail, __ATOMIC_RELEASE);
+ }
+ 
+ void IoUringNetworkBackend::ReleaseIfIdle(ConnectionId connection) {
+     Connection& target { m_connections[connection] };
+     // Bytes still queued go out first (Poll() starts their write), unless
+     // the connection already failed.
+     if (!target.open || !target.closing || target.receiveArmed || target.inFlight > 0 ||
+         (target.queued > 0 && !target.ended)) {
+         return;
+     }
+     ::close(target.fd);
+     ++m_syscalls;
+     target = Connection{};
+     --m_closing;
+     m_free.push_back(connection);
+ }
+ 
+ void IoUringNetworkBackend::CloseRing() {
+     if (m_ringFd >= 0) {
+         ::close(m_ringFd);
+         m_ringFd = -1;
+     }
+     if (m_bufferRing) {
+         ::munmap(m_bufferRing, m_bufferRingSize);
+         m_bufferRing = nullptr;
+     }
+     if (m_sqes) {
+         ::munmap(m_sqes, m_sqesSize);
+         m_sqes = nullptr;
+     }
+     if (m_sqRing) {
+         ::munmap(m_sqRing, m_sqRingSize);
+         m_sqRing = nullptr;
+     }
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,187 @@
+/**
+ * @file MatchDistribution.cpp
+ * @brief Implements the MatchDistribution class.
+ */
+
+ #include "MatchDistribution.hpp"
+ #include "GameRules.hpp"
+ #include <cmath>
+ #include <stdexcept>
+
+ namespace {
+ 
+ /**
+  * @brief Probabilities of the margins lowest, lowest + 1, ...
+  */
+ struct Band {
+     std::int64_t lowest {};
+     std::vector<double> probabilities {};
+ };
+ 
+ /**
+  * @brief Drops negligible margins from both ends, adding them to `truncated`.
+  */
+ void Trim(Band& band, double& truncated) {
+     std::vector<double>& p { band.probabilities };
+     std::size_t first {};
+     std::size_t last { p.size() };
+     while (first < last && p[first] < MatchDistribution::kCutoff) {
+         truncated += p[first++];
+     }
+     while (last > first && p[last - 1] < MatchDistribution::kCutoff) {
+         truncated += p[--last];
+     }
+     p.erase(p.begin() + static_cast<std::ptrdiff_t>(last), p.end());
+     p.erase(p.begin(), p.begin() + static_cast<std::ptrdiff_t>(first));
+     band.lowest += static_cast<std::int64_t>(first);
+ }
+ 
+ /**
+  * @brief The margin distribution of two independent stretches of rounds played back to back.
+  */
+ Band Convolve(const Band& a, const Band& b, double& truncated) {
+     Band sum {};
+     sum.lowest = a.lowest + b.lowest;
+     sum.probabilities.assign(a.probabilities.size() + b.probabilities.size() - 1, 0.0);
+     const double* source { b.probabilities.data() };
+     std::size_t width { b.probabilities.size() };
+     for (std::size_t i{}; i < a.probabilities.size(); ++i) {
+         double weight { a.probabilities[i] };
+         double* target { sum.probabilities.data() + i };
+         // Contiguous multiply-add over b: the loop the compiler vectorizes.
+         for (std::size_t j{}; j < width; ++j) {
+             target[j] += weight * source[j];
+         }
+     }
+     Trim(sum, truncated);
+     return sum;
+ }
+ 
+ void Validate(const MixedStrategy& strategy) {
+     double total {};
+     for (double p : strategy) {
+         if (!(p >= 0.0) || !std::isfinite(p)) {
+             throw std::invalid_argument("MatchDistribution: move probabilities must be finite and non-negative");
+         }
+         total += p;
+     }
+     if (std::fabs(total - 1.0) > 1e-9) {
+         throw std::invalid_argument("MatchDistribution: move probabilities must sum to 1");
+     }
+ }
+ 
+ } // namespace
+ 
+ MatchDistribution MatchDistribution::Compute(const MixedStrategy& user, const MixedStrategy& computer,
+                                              std::uint32_t rounds) {
+     Validate(user);
+     Validate(computer);
+ 
+     MatchDistribution result {};
+     result.m_rounds = rounds;
+     for (int u { 1 }; u <= 3; ++u) {
+         for (int c { 1 }; c <= 3; ++c) {
+             double p { user[static_cast<std::size_t>(u) - 1] * computer[static_cast<std::size_t>(c) - 1] };
+             if (DoesFirstMoveWin(static_cast<GameMove>(u), static_cast<GameMove>(c))) {
+                 result.m_win += p;
+             } else if (DoesFirstMoveWin(static_cast<GameMove>(c), static_cast<GameMove>(u))) {
+                 result.m_loss += p;
+             } else {
+                 result.m_draw += p;
+             }
+         }
+     }
+ 
+     Band round { -1, {result.m_loss, result.m_draw, result.m_win} };
+     double ignored {};
+     Trim(round, ignored);
+ 
+     // Binary powering: `power` holds 2^k rounds while the bits of `rounds` are consumed.
+     Band match { 0, {1.0} };
+     Band power { round };
+     for (std::uint32_t remaining { rounds }; remaining > 0;) {
+         if (remaining & 1u) {
+             match = Convolve(match, power, result.m_truncated);
+         }
+         remaining >>= 1;
+         if (remaining > 0) {
+             power = Convolve(power, power, result.m_truncated);
+         }
+     }
+     result.m_lowest = match.lowest;
+     result.m_probabilities = std::move(match.probabilities);
+     return result;
+ }
+ 
+ std::optional<MixedStrategy> MatchDistribution::ForStrategy(std::string_view name) {
+     if (name == "rock")     return MixedStrategy{1.0, 0.0, 0.0};
+     if (name == "paper")    return MixedStrategy{0.0, 1.0, 0.0};
+     if (name == "scissors") return MixedStrategy{0.0, 0.0, 1.0};
+     if (name == "random")   return MixedStrategy{1.0 / 3.0, 1.0 / 3.0, 1.0 / 3.0};
+     return std::nullopt;
+ }
+ 
+ std::uint32_t MatchDistribution::Rounds() const {
+     return m_rounds;
+ }
+ 
+ double MatchDistribution::RoundWinProbability() const {
+     return m_win;
+ }
+ 
+ double MatchDistribution::RoundDrawProbability() const {
+     return m_draw;
+ }
+ 
+ double MatchDistribution::RoundLossProbability() const {
+     return m_loss;
+ }
+ 
+ double MatchDistribution::Probability(std::int64_t margin) const {
+     if (margin < m_lowest || margin >= m_lowest + static_cast<std::int64_t>(m_probabilities.size())) {
+         return 0.0;
+     }
+     return m_probabilities[static_cast<std::size_t>(margin - m_lowest)];
+ }
+ 
+ std::int64_t MatchDistribution::LowestMargin() const {
+     return m_lowest;
+ }
+ 
+ const std::vector<double>& MatchDistribution::Probabilities() const {
+     return m_probabilities;
+ }
+ 
+ double MatchDistribution::UserWinProbability() const {
+     double total {};
+     for (std::size_t i{}; i < m_probabilities.size(); ++i) {
+         total += m_lowest + static_cast<std::int64_t>(i) > 0 ? m_probabilities[i] : 0.0;
+     }
+     return total;
+ }
+ 
+ double MatchDistribution::DrawProbability() const {
+     return Probability(0);
+ }
+ 
+ double MatchDistribution::ComputerWinProbability() const {
+     double total {};
+     for (std::size_t i{}; i < m_probabilities.size(); ++i) {
+         total += m_lowest + static_cast<std::int64_t>(i) < 0 ? m_probabilities[i] : 0.0;
+     }
+     return total;
+ }
+ 
+ double MatchDistribution::MeanMargin() const {
+     return m_rounds * (m_win - m_loss);
+ }
+ 
+ double MatchDistribution::MarginVariance() const {
+     double step { m_win - m_loss };
+     return m_rounds * (m_win + m_loss - step * step);
+ }
+ 
+ double MatchDistribution::TruncatedMass() const {
+     return m_truncated;
+ }
+ 
\ No newline at end of file
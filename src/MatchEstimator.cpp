@@ -0,0 +1,328 @@
+/**
+ * @file MatchEstimator.cpp
+ * @brief Implements the MatchEstimator class.
+ */
+
+ #include "MatchEstimator.hpp"
+ #include "GameRules.hpp"
+ #include "SimulationRunner.hpp"
+ #include "Xoshiro256.hpp"
+ #include <algorithm>
+ #include <array>
+ #include <chrono>
+ #include <cmath>
+ #include <exception>
+ #include <functional>
+ #include <limits>
+ #include <stdexcept>
+ #include <thread>
+ #include <vector>
+
+ namespace {
+ 
+ using Clock = std::chrono::steady_clock;
+ using MoveCounts = std::array<std::array<std::uint64_t, 3>, 3>;
+ 
+ /**
+  * @brief Wave sizes aim this much past the projected need, to save a look.
+  */
+ constexpr double kWaveMargin {1.05};
+ 
+ /**
+  * @brief Share of the error budget spent at look `look` (1-based); the shares sum to `alpha`.
+  */
+ double LookAlpha(double alpha, int look) {
+     if (look == 1) {
+         return alpha / 8.0;
+     }
+     constexpr double kPi {3.14159265358979323846};
+     double later { static_cast<double>(look - 1) };
+     return alpha * 7.0 / 8.0 * 6.0 / (kPi * kPi * later * later);
+ }
+ 
+ /**
+  * @brief The user's match result: 1 won, 0 drawn, -1 lost.
+  */
+ int MatchResult(const MoveCounts& counts) {
+     std::uint64_t won {};
+     std::uint64_t lost {};
+     for (int user { 1 }; user <= 3; ++user) {
+         for (int computer { 1 }; computer <= 3; ++computer) {
+             std::uint64_t rounds { counts[static_cast<std::size_t>(user) - 1][static_cast<std::size_t>(computer) - 1] };
+             if (DoesFirstMoveWin(static_cast<GameMove>(user), static_cast<GameMove>(computer))) {
+                 won += rounds;
+             } else if (DoesFirstMoveWin(static_cast<GameMove>(computer), static_cast<GameMove>(user))) {
+                 lost += rounds;
+             }
+         }
+     }
+     return (won > lost) - (won < lost);
+ }
+ 
+ /**
+  * @brief Match counts; integers, so slices add up to the same totals in any order.
+  */
+ struct Tally {
+     std::uint64_t wins {};
+     std::uint64_t losses {};
+ 
+     /**
+      * @brief For comparisons: wins of the second pairing, and matches
+      *        only one of the two pairings won.
+      */
+     std::uint64_t secondWins {};
+     std::uint64_t firstOnly {};
+     std::uint64_t secondOnly {};
+ 
+     void Merge(const Tally& other) {
+         wins += other.wins;
+         losses += other.losses;
+         secondWins += other.secondWins;
+         firstOnly += other.firstOnly;
+         secondOnly += other.secondOnly;
+     }
+ };
+ 
+ using MatchPlayer = std::function<void(std::uint64_t match, Tally& tally)>;
+ using HalfWidth = std::function<double(const Tally& tally, double matches, double z)>;
+ 
+ /**
+  * @brief Plays the matches [begin, end) in contiguous slices, one per thread.
+  */
+ void RunWave(std::uint64_t begin, std::uint64_t end, unsigned threads, const MatchPlayer& play, Tally& tally) {
+     std::uint64_t count { end - begin };
+     std::size_t slices { static_cast<std::size_t>(std::min<std::uint64_t>(threads, count)) };
+     std::vector<Tally> tallies(slices);
+     std::vector<std::exception_ptr> errors(slices);
+     auto playSlice = [&](std::size_t slice) {
+         try {
+             auto range = SimulationRunner::ShardRange(count, slice, slices);
+             for (std::uint64_t match { begin + range.first }; match < begin + range.second; ++match) {
+                 play(match, tallies[slice]);
+             }
+         } catch (...) {
+             errors[slice] = std::current_exception();
+         }
+     };
+ 
+     std::vector<std::thread> workers;
+     for (std::size_t slice { 1 }; slice < slices; ++slice) {
+         workers.emplace_back(playSlice, slice);
+     }
+     if (slices > 0) {
+         playSlice(0);
+     }
+     for (auto& worker : workers) {
+         worker.join();
+     }
+     for (const auto& error : errors) {
+         if (error) {
+             std::rethrow_exception(error);
+         }
+     }
+     for (const auto& slice : tallies) {
+         tally.Merge(slice);
+     }
+ }
+ 
+ struct Sequence {
+     std::uint64_t matches {};
+ 
+     /**
+      * @brief Critical value of the final look.
+      */
+     double z {};
+     int looks {};
+     bool converged {};
+ };
+ 
+ /**
+  * @brief Plays waves until the half-width at the current look's critical value is small enough.
+  */
+ Sequence RunSequential(const MatchEstimatorOptions& options, const MatchPlayer& play,
+                        const HalfWidth& halfWidth, Tally& tally) {
+     unsigned threads { options.threads > 0 ? options.threads
+                                            : std::max(1u, std::thread::hardware_concurrency()) };
+     double alpha { 1.0 - options.confidence };
+     Sequence sequence {};
+     std::uint64_t target { options.minMatches };
+     while (true) {
+         RunWave(sequence.matches, target, threads, play, tally);
+         sequence.matches = target;
+         ++sequence.looks;
+         sequence.z = MatchEstimator::CriticalValue(LookAlpha(alpha, sequence.looks));
+         double n { static_cast<double>(sequence.matches) };
+         double width { halfWidth(tally, n, sequence.z) };
+         if (width <= options.halfWidth) {
+             sequence.converged = true;
+             return sequence;
+         }
+         if (sequence.matches >= options.maxMatches) {
+             return sequence;
+         }
+ 
+         // The half-width shrinks as 1 / sqrt(n); aim for the next look's critical value.
+         double nextWidth { halfWidth(tally, n, MatchEstimator::CriticalValue(LookAlpha(alpha, sequence.looks + 1))) };
+         double needed { n * (nextWidth / options.halfWidth) * (nextWidth / options.halfWidth) * kWaveMargin };
+         std::uint64_t grown { sequence.matches + sequence.matches / 4 };
+         target = needed < static_cast<double>(options.maxMatches)
+                      ? std::max(grown, static_cast<std::uint64_t>(std::ceil(needed)))
+                      : options.maxMatches;
+         target = std::min(target, options.maxMatches);
+     }
+ }
+ 
+ double WilsonCenter(double successes, double n, double z) {
+     return (successes / n + z * z / (2.0 * n)) / (1.0 + z * z / n);
+ }
+ 
+ double WilsonHalfWidth(double successes, double n, double z) {
+     double p { successes / n };
+     return z / (1.0 + z * z / n) * std::sqrt(p * (1.0 - p) / n + z * z / (4.0 * n * n));
+ }
+ 
+ /**
+  * @brief Variance of the per-match difference of the two pairings' wins.
+  */
+ double PairedVariance(const Tally& tally, double n) {
+     double mean { (static_cast<double>(tally.firstOnly) - static_cast<double>(tally.secondOnly)) / n };
+     double square { static_cast<double>(tally.firstOnly + tally.secondOnly) / n };
+     return std::max(0.0, square - mean * mean);
+ }
+ 
+ SimulationConfig MakeConfig(const MatchEstimatorOptions& options, std::uint64_t seed,
+                             const std::string& user, const std::string& computer) {
+     SimulationConfig config {};
+     config.masterSeed = seed;
+     config.totalMatches = options.maxMatches;
+     config.roundsPerMatch = options.roundsPerMatch;
+     config.userStrategy = user;
+     config.computerStrategy = computer;
+     return config;
+ }
+ 
+ double SecondsSince(Clock::time_point begin) {
+     return std::chrono::duration<double>(Clock::now() - begin).count();
+ }
+ 
+ } // namespace
+ 
+ MatchEstimator::MatchEstimator(MatchEstimatorOptions options)
+     : m_options{options}
+ {
+     if (m_options.roundsPerMatch < 1) {
+         throw std::invalid_argument("MatchEstimator: a match needs at least one round");
+     }
+     if (!(m_options.confidence > 0.0 && m_options.confidence < 1.0)) {
+         throw std::invalid_argument("MatchEstimator: confidence must be between 0 and 1");
+     }
+     if (!(m_options.halfWidth > 0.0)) {
+         throw std::invalid_argument("MatchEstimator: half-width must be positive");
+     }
+     if (m_options.minMatches < 2 || m_options.maxMatches < m_options.minMatches) {
+         throw std::invalid_argument("MatchEstimator: need 2 <= minMatches <= maxMatches");
+     }
+ }
+ 
+ WinEstimate MatchEstimator::EstimateWin(const std::string& user, const std::string& computer) const {
+     auto begin = Clock::now();
+     SimulationRunner runner{MakeConfig(m_options, m_options.masterSeed, user, computer)};
+     MatchPlayer play = [&runner](std::uint64_t match, Tally& tally) {
+         MoveCounts counts {};
+         runner.PlayMatch(match, counts);
+         int result { MatchResult(counts) };
+         tally.wins += result > 0;
+         tally.losses += result < 0;
+     };
+     HalfWidth halfWidth = [](const Tally& tally, double n, double z) {
+         return WilsonHalfWidth(static_cast<double>(tally.wins), n, z);
+     };
+ 
+     Tally tally {};
+     Sequence sequence { RunSequential(m_options, play, halfWidth, tally) };
+ 
+     WinEstimate estimate {};
+     double n { static_cast<double>(sequence.matches) };
+     double center { WilsonCenter(static_cast<double>(tally.wins), n, sequence.z) };
+     double width { WilsonHalfWidth(static_cast<double>(tally.wins), n, sequence.z) };
+     estimate.matches = sequence.matches;
+     estimate.wins = tally.wins;
+     estimate.losses = tally.losses;
+     estimate.draws = sequence.matches - tally.wins - tally.losses;
+     estimate.winProbability = static_cast<double>(tally.wins) / n;
+     estimate.lower = std::max(0.0, center - width);
+     estimate.upper = std::min(1.0, center + width);
+     estimate.looks = sequence.looks;
+     estimate.converged = sequence.converged;
+     estimate.seconds = SecondsSince(begin);
+     return estimate;
+ }
+ 
+ WinDifference MatchEstimator::CompareWin(const std::string& first, const std::string& second,
+                                          const std::string& opponent) const {
+     auto begin = Clock::now();
+     std::uint64_t secondSeed { m_options.masterSeed };
+     if (!m_options.commonRandomNumbers) {
+         std::uint64_t state { m_options.masterSeed };
+         secondSeed = Xoshiro256::SplitMix64(state);
+     }
+     SimulationRunner firstRunner{MakeConfig(m_options, m_options.masterSeed, first, opponent)};
+     SimulationRunner secondRunner{MakeConfig(m_options, secondSeed, second, opponent)};
+     MatchPlayer play = [&firstRunner, &secondRunner](std::uint64_t match, Tally& tally) {
+         MoveCounts firstCounts {};
+         MoveCounts secondCounts {};
+         firstRunner.PlayMatch(match, firstCounts);
+         secondRunner.PlayMatch(match, secondCounts);
+         bool firstWon { MatchResult(firstCounts) > 0 };
+         bool secondWon { MatchResult(secondCounts) > 0 };
+         tally.wins += firstWon;
+         tally.secondWins += secondWon;
+         tally.firstOnly += firstWon && !secondWon;
+         tally.secondOnly += secondWon && !firstWon;
+     };
+     HalfWidth halfWidth = [](const Tally& tally, double n, double z) {
+         return z * std::sqrt(PairedVariance(tally, n) / n);
+     };
+ 
+     Tally tally {};
+     Sequence sequence { RunSequential(m_options, play, halfWidth, tally) };
+ 
+     WinDifference result {};
+     double n { static_cast<double>(sequence.matches) };
+     double p1 { static_cast<double>(tally.wins) / n };
+     double p2 { static_cast<double>(tally.secondWins) / n };
+     double variance { PairedVariance(tally, n) };
+     double width { sequence.z * std::sqrt(variance / n) };
+     result.matches = sequence.matches;
+     result.firstWinProbability = p1;
+     result.secondWinProbability = p2;
+     result.difference = p1 - p2;
+     result.lower = result.difference - width;
+     result.upper = result.difference + width;
+     double independent { p1 * (1.0 - p1) + p2 * (1.0 - p2) };
+     result.varianceReduction = variance > 0.0 ? independent / variance
+                                               : std::numeric_limits<double>::infinity();
+     result.looks = sequence.looks;
+     result.converged = sequence.converged;
+     result.seconds = SecondsSince(begin);
+     return result;
+ }
+ 
+ double MatchEstimator::CriticalValue(double alpha) {
+     if (!(alpha > 0.0 && alpha < 1.0)) {
+         throw std::invalid_argument("MatchEstimator: alpha must be between 0 and 1");
+     }
+     // erfc(z / sqrt(2)) falls monotonically from 1 at z = 0; bisect to double precision.
+     double low {0.0};
+     double high {40.0};
+     for (int i{}; i < 100; ++i) {
+         double middle { (low + high) / 2.0 };
+         if (std::erfc(middle / std::sqrt(2.0)) > alpha) {
+             low = middle;
+         } else {
+             high = middle;
+         }
+     }
+     return (low + high) / 2.0;
+ }
+ 
\ No newline at end of file
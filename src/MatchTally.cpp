@@ -0,0 +1,54 @@
+/**
+ * @file MatchTally.cpp
+ * @brief Implements the MatchTally class.
+ */
+
+ #include "MatchTally.hpp"
+
+ namespace {
+ 
+ void AddMove(MoveModel& model, std::uint8_t& lastMove, std::uint8_t move) {
+     if (move < 1 || move > 3) {
+         return;
+     }
+     ++model.moves[move - 1];
+     if (lastMove != 0) {
+         ++model.follows[lastMove - 1][move - 1];
+     }
+     lastMove = move;
+ }
+ 
+ } // namespace
+ 
+ void MatchTally::OnRound(const RoundRecord& record) {
+     if (m_userName.empty()) {
+         m_userName = record.userName;
+         m_computerName = record.computerName;
+     }
+ 
+     switch (record.outcome) {
+     case RoundOutcome::UserWin:
+         ++m_match.user.roundsWon;
+         break;
+     case RoundOutcome::ComputerWin:
+         ++m_match.computer.roundsWon;
+         break;
+     case RoundOutcome::Draw:
+         ++m_match.roundsDrawn;
+         break;
+     case RoundOutcome::Forfeit:
+         // Nobody scores a forfeited round, as in the session itself.
+         break;
+     }
+ 
+     AddMove(m_match.user.model, m_lastUserMove, record.userMove);
+     AddMove(m_match.computer.model, m_lastComputerMove, record.computerMove);
+ }
+ 
+ MatchRecord MatchTally::Match() const {
+     MatchRecord match { m_match };
+     match.user.name = m_userName;
+     match.computer.name = m_computerName;
+     return match;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,149 @@
+/**
+ * @file Matchmaker.cpp
+ * @brief Implements the Matchmaker class.
+ */
+
+ #include "Matchmaker.hpp"
+ #include <algorithm>
+ #include <chrono>
+ #include <stdexcept>
+
+ namespace {
+ 
+ std::uint64_t SteadyNanos() {
+     return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count());
+ }
+ 
+ std::uint64_t Elapsed(std::uint64_t since, std::uint64_t now) {
+     return now > since ? now - since : 0;
+ }
+ 
+ /**
+  * @brief Lets the next pass start however this one ends.
+  */
+ struct PassGuard {
+     std::atomic<bool>& running;
+ 
+     ~PassGuard() {
+         running.store(false, std::memory_order_release);
+     }
+ };
+ 
+ } // namespace
+ 
+ Matchmaker::Matchmaker(GameSessionFactory& factory, GameMode mode, MatchmakerOptions options, Clock clock)
+     : m_factory{factory},
+       m_mode{mode},
+       m_options{options},
+       m_clock{clock ? std::move(clock) : Clock{SteadyNanos}}
+ {
+     if (m_options.bandCount == 0 || m_options.bandWidth <= 0 || m_options.widenNanos == 0) {
+         throw std::invalid_argument("Matchmaker needs at least one band of positive width and a positive widening interval");
+     }
+     for (std::size_t band{}; band < m_options.bandCount; ++band) {
+         m_queues.push_back(std::make_unique<MpmcQueue<Ticket>>(m_options.bandCapacity));
+     }
+     m_waiting.resize(m_options.bandCount);
+     m_leftover.resize(m_options.bandCount);
+ }
+ 
+ bool Matchmaker::Submit(const MatchRequest& request) {
+     return m_queues[BandOf(request.rating)]->TryPush(Ticket{request, m_clock()});
+ }
+ 
+ std::size_t Matchmaker::RunPass(const SessionSink& sink) {
+     bool idle {false};
+     if (!m_passRunning.compare_exchange_strong(idle, true, std::memory_order_acquire)) {
+         return 0;
+     }
+     PassGuard guard{m_passRunning};
+     std::uint64_t now { m_clock() };
+ 
+     // Bands cover disjoint rating ranges in order, so walking the bands in
+     // order with each one sorted visits every waiting player by rating.
+     Ticket ticket {};
+     for (std::size_t band{}; band < m_options.bandCount; ++band) {
+         std::vector<Ticket>& waiting { m_waiting[band] };
+         while (m_queues[band]->TryPop(ticket)) {
+             waiting.push_back(ticket);
+         }
+         std::sort(waiting.begin(), waiting.end(), [](const Ticket& a, const Ticket& b) {
+             return a.request.rating != b.request.rating ? a.request.rating < b.request.rating
+                                                         : a.submittedNanos < b.submittedNanos;
+         });
+         m_leftover[band].clear();
+     }
+ 
+     // Pair each player with the next one by rating if either of them has
+     // waited long enough to reach the other's band.
+     m_paired.clear();
+     const Ticket* held {nullptr};
+     std::size_t heldBand {};
+     for (std::size_t band{}; band < m_options.bandCount; ++band) {
+         for (const Ticket& next : m_waiting[band]) {
+             if (held && band - heldBand <= std::max(Reach(*held, now), Reach(next, now))) {
+                 m_paired.push_back(*held);
+                 m_paired.push_back(next);
+                 held = nullptr;
+                 continue;
+             }
+             if (held) {
+                 m_leftover[heldBand].push_back(*held);
+             }
+             held = &next;
+             heldBand = band;
+         }
+     }
+     if (held) {
+         m_leftover[heldBand].push_back(*held);
+     }
+     std::swap(m_waiting, m_leftover);
+ 
+     std::size_t waitingCount {};
+     for (const auto& waiting : m_waiting) {
+         waitingCount += waiting.size();
+     }
+     m_waitingCount.store(waitingCount, std::memory_order_relaxed);
+ 
+     std::size_t handed {};
+     try {
+         for (; 2 * handed < m_paired.size(); ++handed) {
+             const Ticket& a { m_paired[2 * handed] };
+             const Ticket& b { m_paired[2 * handed + 1] };
+             m_current = MatchedPair{a.request, b.request, Elapsed(std::min(a.submittedNanos, b.submittedNanos), now)};
+             sink(m_current, m_factory.Create(m_mode));
+         }
+     } catch (...) {
+         // The failing pair is dropped; later pairs wait for the next pass.
+         for (std::size_t i {2 * (handed + 1)}; i < m_paired.size(); ++i) {
+             m_waiting[BandOf(m_paired[i].request.rating)].push_back(m_paired[i]);
+             ++waitingCount;
+         }
+         m_waitingCount.store(waitingCount, std::memory_order_relaxed);
+         throw;
+     }
+     return handed;
+ }
+ 
+ const MatchedPair& Matchmaker::CurrentPair() const {
+     return m_current;
+ }
+ 
+ std::size_t Matchmaker::Waiting() const {
+     return m_waitingCount.load(std::memory_order_relaxed);
+ }
+ 
+ std::size_t Matchmaker::BandOf(int rating) const {
+     if (rating <= m_options.minRating) {
+         return 0;
+     }
+     auto band = static_cast<std::size_t>((static_cast<long long>(rating) - m_options.minRating) / m_options.bandWidth);
+     return std::min(band, m_options.bandCount - 1);
+ }
+ 
+ std::size_t Matchmaker::Reach(const Ticket& ticket, std::uint64_t now) const {
+     auto widened = static_cast<std::size_t>(Elapsed(ticket.submittedNanos, now) / m_options.widenNanos);
+     return std::min(widened, m_options.maxWiden);
+ }
+ 
\ No newline at end of file
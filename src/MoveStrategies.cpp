@@ -0,0 +1,91 @@
+/**
+ * @file MoveStrategies.cpp
+ * @brief Implements the built-in IMoveStrategy classes.
+ */
+
+ #include "MoveStrategies.hpp"
+ #include "BanditStrategy.hpp"
+
+ ConstantStrategy::ConstantStrategy(GameMove move)
+     : m_move{move}
+ {
+ }
+ 
+ GameMove ConstantStrategy::NextMove() {
+     return m_move;
+ }
+ 
+ void ConstantStrategy::ObserveRound(GameMove, GameMove) {
+ }
+ 
+ bool ConstantStrategy::DependsOnHistory() const {
+     return false;
+ }
+ 
+ GameMove CycleStrategy::NextMove() {
+     GameMove move { static_cast<GameMove>(1 + m_next) };
+     m_next = (m_next + 1) % 3;
+     return move;
+ }
+ 
+ void CycleStrategy::ObserveRound(GameMove, GameMove) {
+ }
+ 
+ bool CycleStrategy::DependsOnHistory() const {
+     return false;
+ }
+ 
+ RandomStrategy::RandomStrategy(std::uint64_t seed)
+     : m_engine{seed}
+ {
+ }
+ 
+ GameMove RandomStrategy::NextMove() {
+     return static_cast<GameMove>(1 + static_cast<int>(m_engine.NextBelow(3)));
+ }
+ 
+ void RandomStrategy::ObserveRound(GameMove, GameMove) {
+ }
+ 
+ bool RandomStrategy::DependsOnHistory() const {
+     return false;
+ }
+ 
+ GameMove CopycatStrategy::NextMove() {
+     return m_lastOpponentMove;
+ }
+ 
+ void CopycatStrategy::ObserveRound(GameMove, GameMove opponentMove) {
+     m_lastOpponentMove = opponentMove;
+ }
+ 
+ bool CopycatStrategy::DependsOnHistory() const {
+     return true;
+ }
+ 
+ GameMove CounterLastStrategy::NextMove() {
+     return BeatingMove(m_lastOpponentMove);
+ }
+ 
+ void CounterLastStrategy::ObserveRound(GameMove, GameMove opponentMove) {
+     m_lastOpponentMove = opponentMove;
+ }
+ 
+ bool CounterLastStrategy::DependsOnHistory() const {
+     return true;
+ }
+ 
+ std::unique_ptr<IMoveStrategy> MakeMoveStrategy(std::string_view name, std::uint64_t seed) {
+     if (name == "rock")     return std::make_unique<ConstantStrategy>(GameMove::Rock);
+     if (name == "paper")    return std::make_unique<ConstantStrategy>(GameMove::Paper);
+     if (name == "scissors") return std::make_unique<ConstantStrategy>(GameMove::Scissors);
+     if (name == "cycle")    return std::make_unique<CycleStrategy>();
+     if (name == "random")   return std::make_unique<RandomStrategy>(seed);
+     if (name == "copycat")  return std::make_unique<CopycatStrategy>();
+     if (name == "counter")  return std::make_unique<CounterLastStrategy>();
+     if (name == "ucb1")     return BanditStrategy::WithBuiltinPortfolio({BanditPolicy::Ucb1, 1.0, 0.1, seed});
+     if (name == "thompson") return BanditStrategy::WithBuiltinPortfolio({BanditPolicy::Thompson, 1.0, 0.1, seed});
+     if (name == "exp3")     return BanditStrategy::WithBuiltinPortfolio({BanditPolicy::Exp3, 1.0, 0.1, seed});
+     return nullptr;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**
+ * @file NameInterner.cpp
+ * @brief Implements the NameInterner class.
+ */
+
+ #include "NameInterner.hpp"
+ #include <cstring>
+ #include <mutex>
+
+ NameInterner& NameInterner::Global() {
+     static NameInterner interner;
+     return interner;
+ }
+ 
+ NameInterner::NameId NameInterner::Intern(std::string_view name) {
+     {
+         std::shared_lock<std::shared_mutex> lock{m_mutex};
+         auto it = m_ids.find(name);
+         if (it != m_ids.end()) {
+             return it->second;
+         }
+     }
+ 
+     std::unique_lock<std::shared_mutex> lock{m_mutex};
+     // Another writer may have interned the same name in the meantime.
+     auto it = m_ids.find(name);
+     if (it != m_ids.end()) {
+         return it->second;
+     }
+ 
+     std::string_view stored { Store(name) };
+     auto id = static_cast<NameId>(m_names.size());
+     m_names.push_back(stored);
+     m_ids.emplace(stored, id);
+     return id;
+ }
+ 
+ std::string_view NameInterner::GetName(NameId id) const {
+     std::shared_lock<std::shared_mutex> lock{m_mutex};
+     return m_names[id];
+ }
+ 
+ std::size_t NameInterner::Size() const {
+     std::shared_lock<std::shared_mutex> lock{m_mutex};
+     return m_names.size();
+ }
+ 
+ std::string_view NameInterner::Store(std::string_view name) {
+     if (name.empty()) {
+         return std::string_view{};
+     }
+ 
+     if (name.size() > kBlockSize) {
+         m_largeNames.push_back(std::make_unique<char[]>(name.size()));
+         std::memcpy(m_largeNames.back().get(), name.data(), name.size());
+         return std::string_view{m_largeNames.back().get(), name.size()};
+     }
+ 
+     if (kBlockSize - m_blockUsed < name.size()) {
+         m_blocks.push_back(std::make_unique<char[]>(kBlockSize));
+         m_blockUsed = 0;
+     }
+     char* destination { m_blocks.back().get() + m_blockUsed };
+     std::memcpy(destination, name.data(), name.size());
+     m_blockUsed += name.size();
+     return std::string_view{destination, name.size()};
+ }
+ 
\ No newline at end of file
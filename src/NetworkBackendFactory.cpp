@@ -0,0 +1,42 @@
+/**
+ * @file NetworkBackendFactory.cpp
+ * @brief Implements the NetworkBackendFactory class.
+ */
+
+ #include "NetworkBackendFactory.hpp"
+ #include "EpollNetworkBackend.hpp"
+ #include "IoUringNetworkBackend.hpp"
+ #include <stdexcept>
+ #include <system_error>
+
+ std::unique_ptr<INetworkBackend> NetworkBackendFactory::Create(NetworkBackendKind kind) {
+     switch (kind) {
+     case NetworkBackendKind::Epoll:
+         return std::make_unique<EpollNetworkBackend>();
+     case NetworkBackendKind::IoUring:
+         return std::make_unique<IoUringNetworkBackend>();
+     case NetworkBackendKind::Automatic:
+         break;
+     }
+     try {
+         return std::make_unique<IoUringNetworkBackend>();
+     } catch (const std::system_error&) {
+         // ENOSYS on old kernels, EPERM where io_uring is disabled or
+         // filtered, EINVAL or ENOTSUP for a missing feature.
+         return std::make_unique<EpollNetworkBackend>();
+     }
+ }
+ 
+ NetworkBackendKind NetworkBackendFactory::ParseKind(const std::string& name) {
+     if (name == "auto") {
+         return NetworkBackendKind::Automatic;
+     }
+     if (name == "epoll") {
+         return NetworkBackendKind::Epoll;
+     }
+     if (name == "io_uring") {
+         return NetworkBackendKind::IoUring;
+     }
+     throw std::invalid_argument("unknown network backend: " + name);
+ }
+ 
\ No newline at end of file
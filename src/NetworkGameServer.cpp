@@ -0,0 +1,238 @@
+/**
+ * @file NetworkGameServer.cpp
+ * @brief Implements the NetworkGameServer class.
+ */
+
+ #include "NetworkGameServer.hpp"
+ #include "BotProtocol.hpp"
+ #include "ComputerPlayer.hpp"
+ #include "QueuedMoveMessenger.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "UserPlayer.hpp"
+ #include <algorithm>
+ #include <unistd.h>
+
+ namespace {
+ 
+ bool IsMove(int choice)
+ {
+     return choice >= 1 && choice <= 3;
+ }
+ 
+ } // namespace
+ 
+ /**
+  * @brief A session plus the protocol state of its client.
+  */
+ struct NetworkGameServer::Session {
+     int socketFd {-1};
+     INetworkBackend::ConnectionId connection {};
+     std::string userName {};
+     std::string computerName {};
+     int rounds {};
+     std::function<int()> computerMoves {};
+ 
+     std::shared_ptr<IPlayer> userPlayer {};
+     std::shared_ptr<IPlayer> computerPlayer {};
+     QueuedMoveMessenger* messenger {};
+     std::unique_ptr<SinglePlayerRpsGame> game {};
+ 
+     /**
+      * @brief The computer's move for the round being played.
+      */
+     int nextComputerMove {1};
+ 
+     bool helloReceived {};
+     bool batchable {};
+ 
+     /**
+      * @brief Moves asked for by the last Request and not yet received.
+      */
+     std::size_t movesOwed {};
+ 
+     /**
+      * @brief Computer moves from rounds played since the last Request.
+      */
+     std::vector<std::uint8_t> history {};
+     std::vector<std::uint8_t> inbox {};
+ 
+     NetworkSessionResult result {};
+     bool done {};
+ };
+ 
+ NetworkGameServer::NetworkGameServer(std::unique_ptr<INetworkBackend> backend)
+     : m_backend{std::move(backend)}
+ {
+ }
+ 
+ NetworkGameServer::~NetworkGameServer() {
+     // Sockets of sessions that never started were not handed to the backend.
+     for (auto& session : m_sessions) {
+         if (session->socketFd >= 0) {
+             ::close(session->socketFd);
+         }
+     }
+ }
+ 
+ std::size_t NetworkGameServer::AddSession(int socketFd, std::string userName, std::string computerName,
+                                           int rounds, std::function<int()> computerMoves) {
+     auto session = std::make_unique<Session>();
+     session->socketFd = socketFd;
+     session->userName = std::move(userName);
+     session->computerName = std::move(computerName);
+     session->rounds = rounds;
+     session->computerMoves = std::move(computerMoves);
+     m_sessions.push_back(std::move(session));
+     return m_sessions.size() - 1;
+ }
+ 
+ std::vector<NetworkSessionResult> NetworkGameServer::Run() {
+     for (auto& session : m_sessions) {
+         if (session->socketFd >= 0) {
+             StartSession(*session);
+         }
+     }
+ 
+     INetworkBackend::ReceiveHandler handler {
+         [this](INetworkBackend::ConnectionId connection, const std::uint8_t* data, std::size_t size) {
+             OnReceive(connection, data, size);
+         }
+     };
+     while (m_activeSessions > 0) {
+         m_backend->Poll(handler, -1);
+     }
+     // Completion-based backends still owe the last Byes and closes.
+     auto deadline = std::chrono::steady_clock::now() + kDrainTimeout;
+     while (!m_backend->Idle() && std::chrono::steady_clock::now() < deadline) {
+         m_backend->Poll(handler, 10);
+     }
+ 
+     std::vector<NetworkSessionResult> results;
+     results.reserve(m_sessions.size());
+     for (auto& session : m_sessions) {
+         results.push_back(session->result);
+     }
+     return results;
+ }
+ 
+ INetworkBackend& NetworkGameServer::Backend() {
+     return *m_backend;
+ }
+ 
+ void NetworkGameServer::StartSession(Session& session) {
+     int socketFd { session.socketFd };
+     session.socketFd = -1;
+     session.connection = m_backend->Add(socketFd);
+     if (m_byConnection.size() <= session.connection) {
+         m_byConnection.resize(session.connection + 1);
+     }
+     m_byConnection[session.connection] = &session;
+ 
+     auto messenger = std::make_unique<QueuedMoveMessenger>();
+     session.messenger = messenger.get();
+     session.userPlayer = std::make_shared<UserPlayer>(session.userName);
+     session.computerPlayer = std::make_shared<ComputerPlayer>(session.computerName);
+ 
+     // The session maps generator values v to moves 1 + (v % 3).
+     Session* self { &session };
+     session.game = std::make_unique<SinglePlayerRpsGame>(
+         session.userPlayer,
+         session.computerPlayer,
+         std::move(messenger),
+         session.rounds,
+         [self]() { return self->nextComputerMove - 1; }
+     );
+ 
+     ++m_activeSessions;
+     if (session.game->IsFinished()) {
+         EndSession(session, true);
+     }
+ }
+ 
+ void NetworkGameServer::OnReceive(INetworkBackend::ConnectionId connection, const std::uint8_t* data,
+                                   std::size_t size) {
+     Session* session { connection < m_byConnection.size() ? m_byConnection[connection] : nullptr };
+     if (!session) {
+         return;
+     }
+     if (size == 0) {
+         EndSession(*session, false);
+         return;
+     }
+ 
+     session->inbox.insert(session->inbox.end(), data, data + size);
+     std::size_t offset {};
+     BotProtocol::FrameHeader header {};
+     SinglePlayerRpsGame& game { *session->game };
+     while (std::size_t frameSize = BotProtocol::PeekFrame(session->inbox.data() + offset,
+                                                           session->inbox.size() - offset, header)) {
+         const std::uint8_t* payload { session->inbox.data() + offset + BotProtocol::kHeaderSize };
+         if (header.type == BotProtocol::FrameType::Hello && !session->helloReceived) {
+             session->helloReceived = true;
+             session->batchable = (header.flags & BotProtocol::kBatchable) != 0;
+         } else if (header.type == BotProtocol::FrameType::Moves && header.count <= session->movesOwed &&
+                    header.count > 0) {
+             session->movesOwed = 0;
+             for (std::size_t i{}; i < header.count && !game.IsFinished(); ++i) {
+                 int userMove { payload[i] };
+                 bool valid { IsMove(userMove) };
+                 session->result.invalidRounds += valid ? 0 : 1;
+                 int computerMove { 1 + static_cast<int>(static_cast<unsigned>(session->computerMoves()) % 3) };
+                 session->messenger->PushMove(valid ? userMove : -1);
+                 session->nextComputerMove = computerMove;
+                 game.PlayRound();
+                 session->history.push_back(static_cast<std::uint8_t>(computerMove));
+             }
+         } else {
+             EndSession(*session, false);
+             return;
+         }
+         offset += frameSize;
+     }
+     session->inbox.erase(session->inbox.begin(), session->inbox.begin() + static_cast<long>(offset));
+ 
+     Pump(*session);
+ }
+ 
+ void NetworkGameServer::Pump(Session& session) {
+     SinglePlayerRpsGame& game { *session.game };
+     if (game.IsFinished()) {
+         EndSession(session, true);
+         return;
+     }
+     if (session.helloReceived && session.movesOwed == 0) {
+         std::size_t remaining { static_cast<std::size_t>(session.rounds - game.RoundsPlayed()) };
+         SendRequest(session, session.batchable ? std::min(remaining, BotProtocol::kMaxBatch) : 1);
+     }
+ }
+ 
+ void NetworkGameServer::SendRequest(Session& session, std::size_t count) {
+     // At most kMaxBatch rounds are played per Request, so the history
+     // always fits in this one frame.
+     std::uint8_t frame[BotProtocol::kMaxFrameSize];
+     std::size_t size { BotProtocol::EncodeRequest(count, session.history.data(), session.history.size(), frame) };
+     m_backend->Send(session.connection, frame, size);
+     session.history.clear();
+     session.movesOwed = count;
+ }
+ 
+ void NetworkGameServer::EndSession(Session& session, bool completed) {
+     if (session.done) {
+         return;
+     }
+     session.done = true;
+     --m_activeSessions;
+ 
+     session.result.userScore = session.userPlayer->GetScore();
+     session.result.computerScore = session.computerPlayer->GetScore();
+     session.result.roundsPlayed = session.game->RoundsPlayed();
+     session.result.completed = completed;
+     if (completed) {
+         session.game->Finish();
+         std::uint8_t bye[BotProtocol::kHeaderSize];
+         m_backend->Send(session.connection, bye, BotProtocol::EncodeBye(bye));
+     }
+     m_byConnection[session.connection] = nullptr;
+     m_backend->Remove(session.connection);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,32 @@
+/**
+ * @file PlayerHandle.cpp
+ * @brief Implements the PlayerHandle class.
+ */
+
+ #include "PlayerHandle.hpp"
+
+ PlayerHandle::PlayerHandle(PlayerRegistry& registry, PlayerRegistry::PlayerId id)
+     : m_registry{&registry}, m_id{id}
+ {
+ }
+ 
+ std::string PlayerHandle::GetName() const {
+     return std::string{m_registry->GetName(m_id)};
+ }
+ 
+ std::string_view PlayerHandle::GetNameView() const {
+     return m_registry->GetName(m_id);
+ }
+ 
+ int PlayerHandle::GetScore() const {
+     return m_registry->GetScore(m_id);
+ }
+ 
+ void PlayerHandle::AddWin() {
+     m_registry->AddWin(m_id);
+ }
+ 
+ PlayerRegistry::PlayerId PlayerHandle::GetId() const {
+     return m_id;
+ }
+ 
\ No newline at end of file
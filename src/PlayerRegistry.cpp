@@ -0,0 +1,108 @@
+/**
+ * @file PlayerRegistry.cpp
+ * @brief Implements the PlayerRegistry class.
+ */
+
+ #include "PlayerRegistry.hpp"
+ #include <algorithm>
+ #include <queue>
+ #include <utility>
+
+ PlayerRegistry::PlayerRegistry(NameInterner& names)
+     : m_names{&names}
+ {
+ }
+ 
+ void PlayerRegistry::Reserve(std::size_t playerCount) {
+     m_ids.reserve(playerCount);
+     m_scores.reserve(playerCount);
+     m_ratings.reserve(playerCount);
+     m_nameIds.reserve(playerCount);
+ }
+ 
+ PlayerRegistry::PlayerId PlayerRegistry::Add(std::string_view name, int rating) {
+     auto id = static_cast<PlayerId>(m_ids.size());
+     m_ids.push_back(id);
+     m_scores.push_back(0);
+     m_ratings.push_back(rating);
+     m_nameIds.push_back(m_names->Intern(name));
+     return id;
+ }
+ 
+ std::size_t PlayerRegistry::Size() const {
+     return m_ids.size();
+ }
+ 
+ std::string_view PlayerRegistry::GetName(PlayerId id) const {
+     return m_names->GetName(m_nameIds[id]);
+ }
+ 
+ NameInterner::NameId PlayerRegistry::GetNameId(PlayerId id) const {
+     return m_nameIds[id];
+ }
+ 
+ int PlayerRegistry::GetScore(PlayerId id) const {
+     return m_scores[id];
+ }
+ 
+ void PlayerRegistry::AddWin(PlayerId id) {
+     ++m_scores[id];
+ }
+ 
+ int PlayerRegistry::GetRating(PlayerId id) const {
+     return m_ratings[id];
+ }
+ 
+ void PlayerRegistry::SetRating(PlayerId id, int rating) {
+     m_ratings[id] = rating;
+ }
+ 
+ std::vector<PlayerRegistry::PlayerId> PlayerRegistry::TopKByScore(std::size_t k) const {
+     k = std::min(k, m_scores.size());
+     if (k == 0) {
+         return {};
+     }
+ 
+     // Min-heap of the best K seen so far: its top is the entry to beat.
+     // Comparing (score, -id) breaks ties in favor of the lower id.
+     using Entry = std::pair<int, PlayerId>;
+     auto better = [](const Entry& a, const Entry& b) {
+         return a.first != b.first ? a.first > b.first : a.second < b.second;
+     };
+     std::priority_queue<Entry, std::vector<Entry>, decltype(better)> heap{better};
+ 
+     const int* scores { m_scores.data() };
+     const std::size_t count { m_scores.size() };
+     for (std::size_t i{}; i < k; ++i) {
+         heap.emplace(scores[i], static_cast<PlayerId>(i));
+     }
+     int threshold { heap.top().first };
+     for (std::size_t i{k}; i < count; ++i) {
+         // Ties with the threshold lose to the earlier (lower) id already held.
+         if (scores[i] > threshold) {
+             heap.pop();
+             heap.emplace(scores[i], static_cast<PlayerId>(i));
+             threshold = heap.top().first;
+         }
+     }
+ 
+     std::vector<PlayerId> result(k);
+     for (std::size_t i{k}; i-- > 0;) {
+         result[i] = heap.top().second;
+         heap.pop();
+     }
+     return result;
+ }
+ 
+ void PlayerRegistry::ResetAllScores() {
+     std::fill(m_scores.begin(), m_scores.end(), 0);
+ }
+ 
+ const int* PlayerRegistry::Scores() const {
+     return m_scores.data();
+ }
+ 
+ const int* PlayerRegistry::Ratings() const {
+     return m_ratings.data();
+ }
+ 
\ No newline at end of file
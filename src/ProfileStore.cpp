@@ -0,0 +1,678 @@
+/**
+ * @file ProfileStore.cpp
+ * @brief Implements the ProfileStore class.
+ */
+
+ #include "ProfileStore.hpp"
+ #include <algorithm>
+ #include <cerrno>
+ #include <cmath>
+ #include <cstdio>
+ #include <cstring>
+ #include <fcntl.h>
+ #include <filesystem>
+ #include <stdexcept>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <unistd.h>
+
+ namespace {
+ 
+ constexpr std::uint32_t kSnapshotMagic {0x50535052}; // "RPSP"
+ constexpr std::uint32_t kSnapshotVersion {1};
+ constexpr std::size_t kRecordHeaderSize {8};
+ 
+ /**
+  * @brief Upper bound on one encoded record; anything larger is damage.
+  */
+ constexpr std::uint32_t kMaxRecordSize {1u << 16};
+ 
+ constexpr std::array<std::uint32_t, 256> MakeCrcTable() {
+     std::array<std::uint32_t, 256> table {};
+     for (std::uint32_t i{}; i < 256; ++i) {
+         std::uint32_t value { i };
+         for (int bit{}; bit < 8; ++bit) {
+             value = (value >> 1) ^ ((value & 1u) ? 0xEDB88320u : 0u);
+         }
+         table[i] = value;
+     }
+     return table;
+ }
+ 
+ constexpr std::array<std::uint32_t, 256> kCrcTable { MakeCrcTable() };
+ 
+ std::uint32_t Crc32(const std::uint8_t* data, std::size_t size) {
+     std::uint32_t crc { 0xFFFFFFFFu };
+     for (std::size_t i{}; i < size; ++i) {
+         crc = kCrcTable[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+     }
+     return ~crc;
+ }
+ 
+ std::runtime_error SystemError(const std::string& what, const std::string& path) {
+     return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+ }
+ 
+ void PutFixed(std::vector<std::uint8_t>& out, std::uint64_t value, int size) {
+     for (int i{}; i < size; ++i) {
+         out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+     }
+ }
+ 
+ void PutVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+     while (value >= 0x80) {
+         out.push_back(static_cast<std::uint8_t>(value | 0x80));
+         value >>= 7;
+     }
+     out.push_back(static_cast<std::uint8_t>(value));
+ }
+ 
+ std::uint64_t ZigZag(std::int64_t value) {
+     return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+ }
+ 
+ std::int64_t UnZigZag(std::uint64_t value) {
+     return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+ }
+ 
+ void PutModel(std::vector<std::uint8_t>& out, const MoveModel& model) {
+     for (std::uint64_t count : model.moves) {
+         PutVarint(out, count);
+     }
+     for (const auto& row : model.follows) {
+         for (std::uint64_t count : row) {
+             PutVarint(out, count);
+         }
+     }
+ }
+ 
+ /**
+  * @brief Bounds-checked little-endian reader over a byte range.
+  */
+ class Reader {
+ public:
+     Reader(const std::uint8_t* data, std::size_t size, const char* what)
+         : m_data{data}, m_end{data + size}, m_what{what} {}
+ 
+     std::uint64_t Fixed(int size) {
+         Need(static_cast<std::size_t>(size));
+         std::uint64_t value {};
+         for (int i{}; i < size; ++i) {
+             value |= static_cast<std::uint64_t>(m_data[i]) << (8 * i);
+         }
+         m_data += size;
+         return value;
+     }
+ 
+     std::uint64_t Varint() {
+         std::uint64_t value {};
+         for (int shift{}; shift < 64; shift += 7) {
+             Need(1);
+             std::uint8_t byte { *m_data++ };
+             value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+             if (!(byte & 0x80)) {
+                 return value;
+             }
+         }
+         throw std::runtime_error(std::string("Corrupt ") + m_what);
+     }
+ 
+     std::string_view Bytes(std::size_t size) {
+         Need(size);
+         std::string_view view { reinterpret_cast<const char*>(m_data), size };
+         m_data += size;
+         return view;
+     }
+ 
+     MoveModel Model() {
+         MoveModel model {};
+         for (std::uint64_t& count : model.moves) {
+             count = Varint();
+         }
+         for (auto& row : model.follows) {
+             for (std::uint64_t& count : row) {
+                 count = Varint();
+             }
+         }
+         return model;
+     }
+ 
+     bool AtEnd() const {
+         return m_data == m_end;
+     }
+ 
+ private:
+     void Need(std::size_t size) const {
+         if (static_cast<std::size_t>(m_end - m_data) < size) {
+             throw std::runtime_error(std::string("Truncated ") + m_what);
+         }
+     }
+ 
+     const std::uint8_t* m_data {};
+     const std::uint8_t* m_end {};
+     const char* m_what {};
+ };
+ 
+ /**
+  * @brief A read-only private mapping of a whole file.
+  */
+ class MappedFile {
+ public:
+     explicit MappedFile(const std::string& path) {
+         int fd { ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+         if (fd < 0) {
+             throw SystemError("Cannot open", path);
+         }
+         struct stat info {};
+         if (::fstat(fd, &info) != 0) {
+             ::close(fd);
+             throw SystemError("Cannot stat", path);
+         }
+         m_size = static_cast<std::size_t>(info.st_size);
+         if (m_size > 0) {
+             void* data { ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0) };
+             if (data == MAP_FAILED) {
+                 ::close(fd);
+                 throw SystemError("Cannot map", path);
+             }
+             ::madvise(data, m_size, MADV_SEQUENTIAL);
+             m_data = static_cast<const std::uint8_t*>(data);
+         }
+         ::close(fd);
+     }
+ 
+     ~MappedFile() {
+         if (m_data) {
+             ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+         }
+     }
+ 
+     MappedFile(const MappedFile&) = delete;
+     MappedFile& operator=(const MappedFile&) = delete;
+ 
+     const std::uint8_t* Data() const { return m_data; }
+     std::size_t Size() const { return m_size; }
+ 
+ private:
+     const std::uint8_t* m_data {nullptr};
+     std::size_t m_size {};
+ };
+ 
+ void WriteAll(int fd, const std::uint8_t* data, std::size_t size, const std::string& path) {
+     while (size > 0) {
+         ssize_t written { ::write(fd, data, size) };
+         if (written < 0) {
+             if (errno == EINTR) {
+                 continue;
+             }
+             throw SystemError("Cannot write", path);
+         }
+         data += written;
+         size -= static_cast<std::size_t>(written);
+     }
+ }
+ 
+ /**
+  * @brief Makes a file creation or rename in `directory` durable.
+  */
+ void SyncDirectory(const std::string& directory) {
+     int fd { ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+     if (fd < 0) {
+         throw SystemError("Cannot open", directory);
+     }
+     int result { ::fsync(fd) };
+     ::close(fd);
+     if (result != 0) {
+         throw SystemError("Cannot sync", directory);
+     }
+ }
+ 
+ /**
+  * @brief Returns the segment number of a `wal-<hex>.log` file name, if it is one.
+  */
+ std::optional<std::uint64_t> SegmentNumber(const std::string& fileName) {
+     if (fileName.size() != 4 + 16 + 4 || fileName.compare(0, 4, "wal-") != 0 ||
+         fileName.compare(20, 4, ".log") != 0) {
+         return std::nullopt;
+     }
+     std::uint64_t segment {};
+     for (std::size_t i { 4 }; i < 20; ++i) {
+         char c { fileName[i] };
+         int digit { c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1 };
+         if (digit < 0) {
+             return std::nullopt;
+         }
+         segment = segment << 4 | static_cast<std::uint64_t>(digit);
+     }
+     return segment;
+ }
+ 
+ } // namespace
+ 
+ void MoveModel::Add(const MoveModel& other) {
+     for (std::size_t move{}; move < 3; ++move) {
+         moves[move] += other.moves[move];
+         for (std::size_t next{}; next < 3; ++next) {
+             follows[move][next] += other.follows[move][next];
+         }
+     }
+ }
+ 
+ bool MoveModel::operator==(const MoveModel& other) const {
+     return moves == other.moves && follows == other.follows;
+ }
+ 
+ bool PlayerProfile::operator==(const PlayerProfile& other) const {
+     return matchesWon == other.matchesWon && matchesLost == other.matchesLost &&
+            matchesDrawn == other.matchesDrawn && roundsWon == other.roundsWon &&
+            roundsLost == other.roundsLost && roundsDrawn == other.roundsDrawn &&
+            rating == other.rating && model == other.model;
+ }
+ 
+ ProfileStore::ProfileStore(std::string directory, ProfileStoreOptions options)
+     : m_directory{std::move(directory)},
+       m_options{options}
+ {
+     Recover();
+     m_logThread = std::thread([this]() { LogLoop(); });
+ }
+ 
+ ProfileStore::~ProfileStore() {
+     {
+         std::lock_guard<std::mutex> lock{m_mutex};
+         m_stopping = true;
+     }
+     m_logWake.notify_one();
+     m_logThread.join();
+     if (m_file >= 0) {
+         ::close(m_file);
+     }
+ }
+ 
+ std::uint64_t ProfileStore::RecordMatch(const MatchRecord& match) {
+     std::lock_guard<std::mutex> lock{m_mutex};
+     ThrowIfFailed();
+ 
+     LoggedMatch logged {};
+     logged.match = match;
+     {
+         // Elo on the match result, from both players' ratings before it.
+         double userRating { static_cast<double>(Profile(match.user.name).rating) };
+         double computerRating { static_cast<double>(Profile(match.computer.name).rating) };
+         double expected { 1.0 / (1.0 + std::pow(10.0, (computerRating - userRating) / 400.0)) };
+         double score { match.user.roundsWon > match.computer.roundsWon ? 1.0 :
+                        match.user.roundsWon < match.computer.roundsWon ? 0.0 : 0.5 };
+         auto delta = static_cast<std::int32_t>(std::lround(kRatingK * (score - expected)));
+         logged.userRatingDelta = delta;
+         logged.computerRatingDelta = -delta;
+     }
+     Apply(logged);
+ 
+     // Frame: [u32 length][u32 crc][payload], length and crc filled in last.
+     std::size_t start { m_pending.size() };
+     m_pending.resize(start + kRecordHeaderSize);
+     for (const MatchSide* side : {&match.user, &match.computer}) {
+         PutVarint(m_pending, side->name.size());
+         m_pending.insert(m_pending.end(), side->name.begin(), side->name.end());
+         PutVarint(m_pending, side->roundsWon);
+         PutModel(m_pending, side->model);
+     }
+     PutVarint(m_pending, match.roundsDrawn);
+     PutVarint(m_pending, ZigZag(logged.userRatingDelta));
+     PutVarint(m_pending, ZigZag(logged.computerRatingDelta));
+ 
+     auto payloadSize = static_cast<std::uint32_t>(m_pending.size() - start - kRecordHeaderSize);
+     std::uint32_t crc { Crc32(m_pending.data() + start + kRecordHeaderSize, payloadSize) };
+     for (int i{}; i < 4; ++i) {
+         m_pending[start + i] = static_cast<std::uint8_t>(payloadSize >> (8 * i));
+         m_pending[start + 4 + i] = static_cast<std::uint8_t>(crc >> (8 * i));
+     }
+     m_bytesSinceSnapshot += kRecordHeaderSize + payloadSize;
+ 
+     if (start == 0) {
+         m_logWake.notify_one();
+     }
+     return ++m_sequence;
+ }
+ 
+ void ProfileStore::WaitDurable(std::uint64_t sequence) {
+     std::unique_lock<std::mutex> lock{m_mutex};
+     m_durableWake.wait(lock, [&]() { return m_durableSequence >= sequence || !m_error.empty(); });
+     if (m_durableSequence < sequence) {
+         ThrowIfFailed();
+     }
+ }
+ 
+ void ProfileStore::Flush() {
+     WaitDurable(LastSequence());
+ }
+ 
+ void ProfileStore::Compact() {
+     std::unique_lock<std::mutex> lock{m_mutex};
+     ThrowIfFailed();
+     std::uint64_t target { m_sequence };
+     std::uint64_t snapshots { m_snapshotCount };
+     m_compactRequested = true;
+     m_logWake.notify_one();
+     // A snapshot already in progress may predate `target`; wait for one that does not.
+     m_durableWake.wait(lock, [&]() {
+         return (m_snapshotCount > snapshots && m_snapshotSequence >= target) || !m_error.empty();
+     });
+     ThrowIfFailed();
+ }
+ 
+ std::optional<PlayerProfile> ProfileStore::Find(std::string_view name) const {
+     std::lock_guard<std::mutex> lock{m_mutex};
+     auto it = m_index.find(name);
+     if (it == m_index.end()) {
+         return std::nullopt;
+     }
+     return m_entries[it->second].profile;
+ }
+ 
+ std::size_t ProfileStore::Size() const {
+     std::lock_guard<std::mutex> lock{m_mutex};
+     return m_entries.size();
+ }
+ 
+ std::uint64_t ProfileStore::LastSequence() const {
+     std::lock_guard<std::mutex> lock{m_mutex};
+     return m_sequence;
+ }
+ 
+ const ProfileRecovery& ProfileStore::Recovery() const {
+     return m_recovery;
+ }
+ 
+ void ProfileStore::Recover() {
+     std::error_code error;
+     std::filesystem::create_directories(m_directory, error);
+     if (error) {
+         throw std::runtime_error("Cannot create profile directory " + m_directory + ": " + error.message());
+     }
+ 
+     std::uint64_t firstSegment {};
+     if (std::filesystem::exists(SnapshotPath())) {
+         firstSegment = LoadSnapshot(SnapshotPath());
+     }
+ 
+     std::vector<std::uint64_t> segments;
+     for (const auto& file : std::filesystem::directory_iterator(m_directory)) {
+         if (auto segment = SegmentNumber(file.path().filename().string())) {
+             segments.push_back(*segment);
+         }
+     }
+     std::sort(segments.begin(), segments.end());
+ 
+     for (std::size_t i{}; i < segments.size(); ++i) {
+         if (segments[i] < firstSegment) {
+             // Left behind by a crash between a snapshot and its cleanup.
+             std::filesystem::remove(SegmentPath(segments[i]), error);
+             continue;
+         }
+         m_bytesSinceSnapshot += ReplaySegment(SegmentPath(segments[i]), i + 1 == segments.size());
+     }
+     m_durableSequence = m_sequence;
+ 
+     // Replay cut off any torn tail, so appending to the last segment is safe.
+     m_segment = segments.empty() ? firstSegment : std::max(firstSegment, segments.back());
+     OpenSegment(m_segment);
+ }
+ 
+ std::uint64_t ProfileStore::LoadSnapshot(const std::string& path) {
+     MappedFile file{path};
+     if (file.Size() < 4 || Crc32(file.Data(), file.Size() - 4) !=
+                            Reader(file.Data() + file.Size() - 4, 4, "profile snapshot").Fixed(4)) {
+         throw std::runtime_error("Corrupt profile snapshot: " + path);
+     }
+ 
+     Reader reader{file.Data(), file.Size() - 4, "profile snapshot"};
+     if (reader.Fixed(4) != kSnapshotMagic || reader.Fixed(4) != kSnapshotVersion) {
+         throw std::runtime_error("Not a profile snapshot: " + path);
+     }
+     std::uint64_t firstSegment { reader.Fixed(8) };
+     m_sequence = reader.Fixed(8);
+     m_snapshotSequence = m_sequence;
+     std::uint64_t count { reader.Fixed(8) };
+ 
+     m_index.reserve(count);
+     for (std::uint64_t i{}; i < count; ++i) {
+         std::string_view name { reader.Bytes(reader.Varint()) };
+         PlayerProfile& profile { Profile(name) };
+         profile.matchesWon = reader.Varint();
+         profile.matchesLost = reader.Varint();
+         profile.matchesDrawn = reader.Varint();
+         profile.roundsWon = reader.Varint();
+         profile.roundsLost = reader.Varint();
+         profile.roundsDrawn = reader.Varint();
+         profile.rating = static_cast<std::int32_t>(UnZigZag(reader.Varint()));
+         profile.model = reader.Model();
+     }
+     if (!reader.AtEnd()) {
+         throw std::runtime_error("Trailing bytes in profile snapshot: " + path);
+     }
+     m_recovery.snapshotProfiles = count;
+     return firstSegment;
+ }
+ 
+ std::uint64_t ProfileStore::ReplaySegment(const std::string& path, bool isLast) {
+     std::size_t valid {};
+     std::size_t size {};
+     {
+         MappedFile file{path};
+         size = file.Size();
+         while (size - valid >= kRecordHeaderSize) {
+             Reader header{file.Data() + valid, kRecordHeaderSize, "profile log"};
+             auto payloadSize = static_cast<std::uint32_t>(header.Fixed(4));
+             auto crc = static_cast<std::uint32_t>(header.Fixed(4));
+             const std::uint8_t* payload { file.Data() + valid + kRecordHeaderSize };
+             if (payloadSize > kMaxRecordSize || payloadSize > size - valid - kRecordHeaderSize ||
+                 Crc32(payload, payloadSize) != crc) {
+                 break;
+             }
+ 
+             Reader reader{payload, payloadSize, "profile log"};
+             LoggedMatch logged {};
+             for (MatchSide* side : {&logged.match.user, &logged.match.computer}) {
+                 side->name = reader.Bytes(reader.Varint());
+                 side->roundsWon = static_cast<std::uint32_t>(reader.Varint());
+                 side->model = reader.Model();
+             }
+             logged.match.roundsDrawn = static_cast<std::uint32_t>(reader.Varint());
+             logged.userRatingDelta = static_cast<std::int32_t>(UnZigZag(reader.Varint()));
+             logged.computerRatingDelta = static_cast<std::int32_t>(UnZigZag(reader.Varint()));
+             if (!reader.AtEnd()) {
+                 throw std::runtime_error("Corrupt profile log: " + path);
+             }
+ 
+             Apply(logged);
+             ++m_sequence;
+             ++m_recovery.replayedRecords;
+             valid += kRecordHeaderSize + payloadSize;
+         }
+     }
+ 
+     if (valid < size) {
+         if (!isLast) {
+             throw std::runtime_error("Corrupt profile log: " + path);
+         }
+         // A write cut short by a crash; drop it so the segment stays well-formed.
+         if (::truncate(path.c_str(), static_cast<off_t>(valid)) != 0) {
+             throw SystemError("Cannot truncate", path);
+         }
+         m_recovery.discardedBytes += size - valid;
+     }
+     return valid;
+ }
+ 
+ void ProfileStore::Apply(const LoggedMatch& logged) {
+     const MatchRecord& match { logged.match };
+     PlayerProfile& user { Profile(match.user.name) };
+     PlayerProfile& computer { Profile(match.computer.name) };
+ 
+     bool userWon { match.user.roundsWon > match.computer.roundsWon };
+     bool computerWon { match.computer.roundsWon > match.user.roundsWon };
+     user.matchesWon += userWon;
+     user.matchesLost += computerWon;
+     user.matchesDrawn += !userWon && !computerWon;
+     computer.matchesWon += computerWon;
+     computer.matchesLost += userWon;
+     computer.matchesDrawn += !userWon && !computerWon;
+ 
+     user.roundsWon += match.user.roundsWon;
+     user.roundsLost += match.computer.roundsWon;
+     user.roundsDrawn += match.roundsDrawn;
+     computer.roundsWon += match.computer.roundsWon;
+     computer.roundsLost += match.user.roundsWon;
+     computer.roundsDrawn += match.roundsDrawn;
+ 
+     user.rating += logged.userRatingDelta;
+     computer.rating += logged.computerRatingDelta;
+     user.model.Add(match.user.model);
+     computer.model.Add(match.computer.model);
+ }
+ 
+ PlayerProfile& ProfileStore::Profile(std::string_view name) {
+     auto it = m_index.find(name);
+     if (it != m_index.end()) {
+         return m_entries[it->second].profile;
+     }
+     m_entries.push_back(Entry{std::string{name}, PlayerProfile{}});
+     m_index.emplace(m_entries.back().name, static_cast<std::uint32_t>(m_entries.size() - 1));
+     return m_entries.back().profile;
+ }
+ 
+ void ProfileStore::OpenSegment(std::uint64_t segment) {
+     std::string path { SegmentPath(segment) };
+     m_file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+     if (m_file < 0) {
+         throw SystemError("Cannot open", path);
+     }
+     SyncDirectory(m_directory);
+ }
+ 
+ std::string ProfileStore::SegmentPath(std::uint64_t segment) const {
+     char name[32];
+     std::snprintf(name, sizeof(name), "wal-%016llx.log", static_cast<unsigned long long>(segment));
+     return m_directory + "/" + name;
+ }
+ 
+ std::string ProfileStore::SnapshotPath() const {
+     return m_directory + "/profiles.snapshot";
+ }
+ 
+ void ProfileStore::LogLoop() {
+     std::vector<std::uint8_t> writing;
+     std::vector<Entry> entries;
+     std::unique_lock<std::mutex> lock{m_mutex};
+     while (true) {
+         m_logWake.wait(lock, [&]() { return m_stopping || m_compactRequested || !m_pending.empty(); });
+         if (m_stopping && !m_compactRequested && m_pending.empty()) {
+             break;
+         }
+ 
+         // Take everything queued so far as one group.
+         writing.swap(m_pending);
+         std::uint64_t through { m_sequence };
+         bool compact { m_compactRequested || m_bytesSinceSnapshot >= m_options.snapshotBytes };
+         std::uint64_t nextSegment { m_segment + 1 };
+         if (compact) {
+             m_compactRequested = false;
+             entries.assign(m_entries.begin(), m_entries.end());
+             m_segment = nextSegment;
+             m_bytesSinceSnapshot = 0;
+         }
+         lock.unlock();
+ 
+         std::string error;
+         try {
+             WriteAll(m_file, writing.data(), writing.size(), SegmentPath(nextSegment - 1));
+             if (m_options.syncWrites && !writing.empty() && ::fdatasync(m_file) != 0) {
+                 throw SystemError("Cannot sync", SegmentPath(nextSegment - 1));
+             }
+             if (compact) {
+                 ::close(m_file);
+                 m_file = -1;
+                 OpenSegment(nextSegment);
+                 WriteSnapshot(nextSegment, through, entries);
+                 entries.clear();
+             }
+         } catch (const std::exception& e) {
+             error = e.what();
+         }
+         writing.clear();
+ 
+         lock.lock();
+         if (!error.empty()) {
+             m_error = error;
+             m_durableWake.notify_all();
+             break;
+         }
+         m_durableSequence = through;
+         if (compact) {
+             m_snapshotSequence = through;
+             ++m_snapshotCount;
+         }
+         m_durableWake.notify_all();
+     }
+ }
+ 
+ void ProfileStore::WriteSnapshot(std::uint64_t firstSegment, std::uint64_t sequence,
+                                  const std::vector<Entry>& entries) {
+     std::vector<std::uint8_t> out;
+     PutFixed(out, kSnapshotMagic, 4);
+     PutFixed(out, kSnapshotVersion, 4);
+     PutFixed(out, firstSegment, 8);
+     PutFixed(out, sequence, 8);
+     PutFixed(out, entries.size(), 8);
+     for (const Entry& entry : entries) {
+         const PlayerProfile& profile { entry.profile };
+         PutVarint(out, entry.name.size());
+         out.insert(out.end(), entry.name.begin(), entry.name.end());
+         PutVarint(out, profile.matchesWon);
+         PutVarint(out, profile.matchesLost);
+         PutVarint(out, profile.matchesDrawn);
+         PutVarint(out, profile.roundsWon);
+         PutVarint(out, profile.roundsLost);
+         PutVarint(out, profile.roundsDrawn);
+         PutVarint(out, ZigZag(profile.rating));
+         PutModel(out, profile.model);
+     }
+     PutFixed(out, Crc32(out.data(), out.size()), 4);
+ 
+     std::string temporary { SnapshotPath() + ".tmp" };
+     int fd { ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) };
+     if (fd < 0) {
+         throw SystemError("Cannot create", temporary);
+     }
+     try {
+         WriteAll(fd, out.data(), out.size(), temporary);
+         if (::fsync(fd) != 0) {
+             throw SystemError("Cannot sync", temporary);
+         }
+     } catch (...) {
+         ::close(fd);
+         throw;
+     }
+     ::close(fd);
+     if (std::rename(temporary.c_str(), SnapshotPath().c_str()) != 0) {
+         throw SystemError("Cannot rename", temporary);
+     }
+     SyncDirectory(m_directory);
+ 
+     // Everything before the new segment is now covered by the snapshot.
+     for (const auto& file : std::filesystem::directory_iterator(m_directory)) {
+         auto segment = SegmentNumber(file.path().filename().string());
+         if (segment && *segment < firstSegment) {
+             std::error_code ignored;
+             std::filesystem::remove(file.path(), ignored);
+         }
+     }
+ }
+ 
+ void ProfileStore::ThrowIfFailed() const {
+     if (!m_error.empty()) {
+         throw std::runtime_error("Profile log failed: " + m_error);
+     }
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,74 @@
+/**
+ * @file QueuedMoveMessenger.cpp
+ * @brief Implements the QueuedMoveMessenger class.
+ */
+
+ #include "QueuedMoveMessenger.hpp"
+
+ void QueuedMoveMessenger::PushMove(int choice) {
+     m_moves.push_back(choice);
+ }
+ 
+ std::size_t QueuedMoveMessenger::PendingMoves() const {
+     return m_moves.size();
+ }
+ 
+ void QueuedMoveMessenger::ShowWelcomeScreen() {
+ }
+ 
+ std::string QueuedMoveMessenger::RequestUserPlayerName() {
+     return {};
+ }
+ 
+ std::string QueuedMoveMessenger::RequestComputerPlayerName() {
+     return {};
+ }
+ 
+ int QueuedMoveMessenger::RequestNumberOfRounds() {
+     return -1;
+ }
+ 
+ void QueuedMoveMessenger::ShowSetupComplete() {
+ }
+ 
+ int QueuedMoveMessenger::RequestMoveChoice() {
+     if (m_moves.empty()) {
+         return -1;
+     }
+     int choice { m_moves.front() };
+     m_moves.pop_front();
+     return choice;
+ }
+ 
+ std::size_t QueuedMoveMessenger::RequestMoveChoices(int* moves, std::size_t maxCount) {
+     if (maxCount == 0) {
+         return 0;
+     }
+     if (m_moves.empty()) {
+         moves[0] = -1;
+         return 1;
+     }
+     std::size_t count {};
+     while (count < maxCount && !m_moves.empty()) {
+         moves[count++] = m_moves.front();
+         m_moves.pop_front();
+     }
+     return count;
+ }
+ 
+ void QueuedMoveMessenger::DisplayChosenMove(const std::shared_ptr<IPlayer>&, GameMove) {
+ }
+ 
+ void QueuedMoveMessenger::AnnounceRoundWinner(const std::shared_ptr<IPlayer>&) {
+ }
+ 
+ void QueuedMoveMessenger::AnnounceDraw() {
+ }
+ 
+ void QueuedMoveMessenger::ShowFinalScore(const std::shared_ptr<IPlayer>&,
+                                          const std::shared_ptr<IPlayer>&) {
+ }
+ 
+ void QueuedMoveMessenger::ShowInvalidInputMessage() {
+ }
+ 
\ No newline at end of file
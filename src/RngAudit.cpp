@@ -0,0 +1,374 @@
+/**
+ * @file RngAudit.cpp
+ * @brief Implements the RngAudit class.
+ */
+
+ #include "RngAudit.hpp"
+ #include <algorithm>
+ #include <chrono>
+ #include <cmath>
+ #include <exception>
+ #include <limits>
+ #include <stdexcept>
+ #include <thread>
+ #include <vector>
+
+ namespace {
+ 
+ /**
+  * @brief Moves generated, then tallied, per pass; small enough for L1.
+  */
+ constexpr std::size_t kBatch {4096};
+ 
+ struct Tally {
+     std::array<std::uint64_t, 3> moves {};
+     std::array<std::uint64_t, 9> pairs {};
+     std::array<std::uint64_t, 8> runLengths {};
+ 
+     void Merge(const Tally& other) {
+         for (std::size_t i{}; i < moves.size(); ++i) moves[i] += other.moves[i];
+         for (std::size_t i{}; i < pairs.size(); ++i) pairs[i] += other.pairs[i];
+         for (std::size_t i{}; i < runLengths.size(); ++i) runLengths[i] += other.runLengths[i];
+     }
+ };
+ 
+ /**
+  * @brief Tallies one segment drawn from a fresh generator.
+  */
+ class SegmentScanner {
+ public:
+     SegmentScanner()
+         : m_values(kBatch),
+           m_moves(kCarry + kBatch),
+           m_changes(kCarry + kBatch)
+     {
+     }
+ 
+     void Scan(const std::function<int()>& generator, std::uint64_t length, Tally& tally) {
+         bool first {true};
+         while (length > 0) {
+             std::size_t count { static_cast<std::size_t>(std::min<std::uint64_t>(length, kBatch)) };
+             length -= count;
+ 
+             int smallest {0};
+             for (std::size_t i{}; i < count; ++i) {
+                 int value { generator() };
+                 m_values[i] = value;
+                 smallest = std::min(smallest, value);
+             }
+             if (smallest < 0) {
+                 throw std::runtime_error("RngAudit: the generator returned a negative value");
+             }
+ 
+             // The first kCarry slots hold the previous batch's last moves.
+             std::uint8_t* moves { m_moves.data() };
+             std::uint8_t* changes { m_changes.data() };
+             std::size_t end { kCarry + count };
+             for (std::size_t i{}; i < count; ++i) {
+                 moves[kCarry + i] = static_cast<std::uint8_t>(static_cast<std::uint32_t>(m_values[i]) % 3);
+             }
+ 
+             std::uint32_t ones {};
+             std::uint32_t twos {};
+             for (std::size_t i { kCarry }; i < end; ++i) {
+                 ones += moves[i] == 1;
+                 twos += moves[i] == 2;
+             }
+             tally.moves[0] += count - ones - twos;
+             tally.moves[1] += ones;
+             tally.moves[2] += twos;
+ 
+             std::size_t begin { first ? kCarry + 1 : kCarry };
+             std::uint32_t pairs[9] {};
+             for (std::size_t i { begin }; i < end; ++i) {
+                 std::uint32_t index { moves[i - 1] * 3u + moves[i] };
+                 for (std::uint32_t k{}; k < 9; ++k) {
+                     pairs[k] += index == k;
+                 }
+             }
+             for (std::size_t k{}; k < 9; ++k) {
+                 tally.pairs[k] += pairs[k];
+             }
+ 
+             // A run starts where the move changes (and at the segment's first move).
+             // Its length is at least k + 1 if the next k moves bring no change, so
+             // runs are binned by windowed counts rather than by a serial scan. A start
+             // is binned once the 7 moves after it are known; starts in the last 7
+             // moves of a segment are dropped, whatever their length.
+             std::size_t from { first ? kCarry : 1 };
+             for (std::size_t i { from }; i < end; ++i) {
+                 changes[i] = moves[i] != moves[i - 1];
+             }
+             if (first) {
+                 changes[kCarry] = 1;
+             }
+             // One accumulator per length keeps the loop in vector registers.
+             std::uint32_t atLeast1 {}, atLeast2 {}, atLeast3 {}, atLeast4 {};
+             std::uint32_t atLeast5 {}, atLeast6 {}, atLeast7 {}, atLeast8 {};
+             std::size_t last { end > 7 ? end - 7 : 0 };
+             for (std::size_t i { from }; i < last; ++i) {
+                 std::uint32_t open { changes[i] };
+                 atLeast1 += open;
+                 open &= changes[i + 1] ^ 1u;
+                 atLeast2 += open;
+                 open &= changes[i + 2] ^ 1u;
+                 atLeast3 += open;
+                 open &= changes[i + 3] ^ 1u;
+                 atLeast4 += open;
+                 open &= changes[i + 4] ^ 1u;
+                 atLeast5 += open;
+                 open &= changes[i + 5] ^ 1u;
+                 atLeast6 += open;
+                 open &= changes[i + 6] ^ 1u;
+                 atLeast7 += open;
+                 open &= changes[i + 7] ^ 1u;
+                 atLeast8 += open;
+             }
+             tally.runLengths[0] += atLeast1 - atLeast2;
+             tally.runLengths[1] += atLeast2 - atLeast3;
+             tally.runLengths[2] += atLeast3 - atLeast4;
+             tally.runLengths[3] += atLeast4 - atLeast5;
+             tally.runLengths[4] += atLeast5 - atLeast6;
+             tally.runLengths[5] += atLeast6 - atLeast7;
+             tally.runLengths[6] += atLeast7 - atLeast8;
+             tally.runLengths[7] += atLeast8;
+ 
+             // Starts up to end - 8 are binned; the next batch resumes at its slot 1.
+             if (end >= 2 * kCarry) {
+                 std::copy(moves + end - kCarry, moves + end, moves);
+             }
+             first = false;
+         }
+     }
+ 
+ private:
+     /**
+      * @brief Moves kept from one batch to the next: the lookahead of the run bins.
+      */
+     static constexpr std::size_t kCarry {8};
+ 
+     std::vector<int> m_values {};
+     std::vector<std::uint8_t> m_moves {};
+     std::vector<std::uint8_t> m_changes {};
+ };
+ 
+ double ChiSquare(const std::uint64_t* observed, const double* expected, std::size_t cells) {
+     double sum {};
+     for (std::size_t i{}; i < cells; ++i) {
+         double difference { static_cast<double>(observed[i]) - expected[i] };
+         sum += difference * difference / expected[i];
+     }
+     return sum;
+ }
+ 
+ /**
+  * @brief Regularized upper incomplete gamma function Q(a, x).
+  */
+ double UpperGamma(double a, double x) {
+     if (x <= 0.0) {
+         return 1.0;
+     }
+     double logPrefix { a * std::log(x) - x - std::lgamma(a) };
+     if (x < a + 1.0) {
+         // Series for P(a, x).
+         double term { 1.0 / a };
+         double sum { term };
+         for (int n {1}; n < 1000 && std::fabs(term) > std::fabs(sum) * 1e-16; ++n) {
+             term *= x / (a + n);
+             sum += term;
+         }
+         return std::max(0.0, 1.0 - sum * std::exp(logPrefix));
+     }
+     // Continued fraction for Q(a, x), modified Lentz.
+     constexpr double kTiny {1e-300};
+     double b { x + 1.0 - a };
+     double c { 1.0 / kTiny };
+     double d { 1.0 / b };
+     double h { d };
+     for (int n {1}; n < 1000; ++n) {
+         double an { -n * (n - a) };
+         b += 2.0;
+         d = an * d + b;
+         d = std::fabs(d) < kTiny ? kTiny : d;
+         c = b + an / c;
+         c = std::fabs(c) < kTiny ? kTiny : c;
+         d = 1.0 / d;
+         double delta { d * c };
+         h *= delta;
+         if (std::fabs(delta - 1.0) < 1e-16) {
+             break;
+         }
+     }
+     return std::exp(logPrefix) * h;
+ }
+ 
+ RngTestResult ChiSquareTest(double statistic, int degreesOfFreedom) {
+     return {statistic, degreesOfFreedom, RngAudit::ChiSquarePValue(statistic, degreesOfFreedom)};
+ }
+ 
+ RngTestResult NormalTest(double z) {
+     return {z, 0, RngAudit::NormalPValue(z)};
+ }
+ 
+ /**
+  * @brief A degenerate sequence (e.g. a constant generator) fails outright.
+  */
+ RngTestResult Failed(int degreesOfFreedom) {
+     return {std::numeric_limits<double>::infinity(), degreesOfFreedom, 0.0};
+ }
+ 
+ void Evaluate(RngAuditReport& report) {
+     double n { static_cast<double>(report.moves) };
+     double third[3] {n / 3.0, n / 3.0, n / 3.0};
+     report.frequency = ChiSquareTest(ChiSquare(report.moveCounts.data(), third, 3), 2);
+ 
+     // Good's serial test, with the single-move counts taken over the first elements of the pairs.
+     std::array<std::uint64_t, 3> rows {};
+     std::array<std::uint64_t, 3> columns {};
+     std::uint64_t pairTotal {};
+     for (std::size_t a{}; a < 3; ++a) {
+         for (std::size_t b{}; b < 3; ++b) {
+             rows[a] += report.pairCounts[a * 3 + b];
+             columns[b] += report.pairCounts[a * 3 + b];
+             pairTotal += report.pairCounts[a * 3 + b];
+         }
+     }
+     double pairs { static_cast<double>(pairTotal) };
+     double ninth[9];
+     std::fill(std::begin(ninth), std::end(ninth), pairs / 9.0);
+     double pairThird[3] {pairs / 3.0, pairs / 3.0, pairs / 3.0};
+     report.serial = ChiSquareTest(ChiSquare(report.pairCounts.data(), ninth, 9) -
+                                   ChiSquare(rows.data(), pairThird, 3), 6);
+ 
+     // Lag-1 correlation of the moves as -1, 0, 1.
+     double sumX {}, sumY {}, sumXX {}, sumYY {}, sumXY {};
+     for (int a{}; a < 3; ++a) {
+         sumX += (a - 1) * static_cast<double>(rows[a]);
+         sumXX += (a - 1) * (a - 1) * static_cast<double>(rows[a]);
+         sumY += (a - 1) * static_cast<double>(columns[a]);
+         sumYY += (a - 1) * (a - 1) * static_cast<double>(columns[a]);
+         for (int b{}; b < 3; ++b) {
+             sumXY += (a - 1) * (b - 1) * static_cast<double>(report.pairCounts[a * 3 + b]);
+         }
+     }
+     double varianceX { pairs * sumXX - sumX * sumX };
+     double varianceY { pairs * sumYY - sumY * sumY };
+     if (varianceX > 0 && varianceY > 0) {
+         double r { (pairs * sumXY - sumX * sumY) / std::sqrt(varianceX * varianceY) };
+         report.correlation = NormalTest(r * std::sqrt(pairs));
+     } else {
+         report.correlation = Failed(0);
+     }
+ 
+     // With independent uniform moves each step changes the move with probability 2/3.
+     std::uint64_t repeats { report.pairCounts[0] + report.pairCounts[4] + report.pairCounts[8] };
+     double changes { pairs - static_cast<double>(repeats) };
+     report.runs = pairs > 0 ? NormalTest((changes - pairs * 2.0 / 3.0) / std::sqrt(pairs * 2.0 / 9.0)) : Failed(0);
+ 
+     std::uint64_t runTotal {};
+     for (auto count : report.runLengths) {
+         runTotal += count;
+     }
+     if (runTotal > 0) {
+         double expected[8];
+         double share { 2.0 / 3.0 };
+         for (std::size_t k{}; k < 7; ++k) {
+             expected[k] = static_cast<double>(runTotal) * share;
+             share /= 3.0;
+         }
+         expected[7] = static_cast<double>(runTotal) * share * 1.5; // (1/3)^7
+         report.runLengthTest = ChiSquareTest(ChiSquare(report.runLengths.data(), expected, 8), 7);
+     } else {
+         report.runLengthTest = Failed(7);
+     }
+ }
+ 
+ } // namespace
+ 
+ double RngAuditReport::MovesPerSecond() const {
+     return seconds > 0 ? static_cast<double>(moves) / seconds : 0.0;
+ }
+ 
+ double RngAuditReport::MinPValue() const {
+     return std::min({frequency.pValue, serial.pValue, correlation.pValue, runs.pValue, runLengthTest.pValue});
+ }
+ 
+ RngAudit::RngAudit(MoveGeneratorFactory factory, RngAuditOptions options)
+     : m_factory{std::move(factory)},
+       m_options{options}
+ {
+     if (!m_factory) {
+         throw std::invalid_argument("RngAudit: no generator factory");
+     }
+     if (m_options.moves < 2 || m_options.segmentMoves < 2) {
+         throw std::invalid_argument("RngAudit: at least two moves per run and per segment are needed");
+     }
+ }
+ 
+ RngAuditReport RngAudit::Run() const {
+     auto begin = std::chrono::steady_clock::now();
+     std::uint64_t segments { (m_options.moves + m_options.segmentMoves - 1) / m_options.segmentMoves };
+     unsigned threads { m_options.threads > 0 ? m_options.threads
+                                              : std::max(1u, std::thread::hardware_concurrency()) };
+     std::size_t slices { static_cast<std::size_t>(std::min<std::uint64_t>(threads, segments)) };
+ 
+     std::vector<Tally> tallies(slices);
+     std::vector<std::exception_ptr> errors(slices);
+     auto scanSlice = [&](std::size_t slice) {
+         try {
+             SegmentScanner scanner;
+             for (std::uint64_t segment { slice }; segment < segments; segment += slices) {
+                 std::uint64_t first { segment * m_options.segmentMoves };
+                 std::uint64_t length { std::min(m_options.segmentMoves, m_options.moves - first) };
+                 std::function<int()> generator { m_factory(segment) };
+                 if (!generator) {
+                     throw std::runtime_error("RngAudit: the factory returned no generator");
+                 }
+                 scanner.Scan(generator, length, tallies[slice]);
+             }
+         } catch (...) {
+             errors[slice] = std::current_exception();
+         }
+     };
+ 
+     std::vector<std::thread> workers;
+     for (std::size_t slice { 1 }; slice < slices; ++slice) {
+         workers.emplace_back(scanSlice, slice);
+     }
+     scanSlice(0);
+     for (auto& worker : workers) {
+         worker.join();
+     }
+     for (const auto& error : errors) {
+         if (error) {
+             std::rethrow_exception(error);
+         }
+     }
+     for (std::size_t slice { 1 }; slice < slices; ++slice) {
+         tallies[0].Merge(tallies[slice]);
+     }
+ 
+     RngAuditReport report {};
+     report.moves = m_options.moves;
+     report.moveCounts = tallies[0].moves;
+     report.pairCounts = tallies[0].pairs;
+     report.runLengths = tallies[0].runLengths;
+     Evaluate(report);
+     report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+     return report;
+ }
+ 
+ double RngAudit::ChiSquarePValue(double statistic, int degreesOfFreedom) {
+     if (degreesOfFreedom < 1) {
+         throw std::invalid_argument("RngAudit: degrees of freedom must be positive");
+     }
+     if (!(statistic < std::numeric_limits<double>::infinity())) {
+         return 0.0;
+     }
+     return UpperGamma(degreesOfFreedom / 2.0, statistic / 2.0);
+ }
+ 
+ double RngAudit::NormalPValue(double z) {
+     return std::erfc(std::fabs(z) / std::sqrt(2.0));
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,129 @@
+/**
+ * @file RoundColumnReader.cpp
+ * @brief Implements the RoundColumnReader class.
+ */
+
+ #include "RoundColumnReader.hpp"
+ #include <stdexcept>
+
+ namespace {
+ 
+ /**
+  * @brief Size of the fixed trailer: footer offset (8) and magic (4).
+  */
+ constexpr std::size_t kTrailerSize {12};
+ 
+ std::uint64_t GetFixed(const std::uint8_t* data, int size) {
+     std::uint64_t value {};
+     for (int i{}; i < size; ++i) {
+         value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+     }
+     return value;
+ }
+ 
+ } // namespace
+ 
+ RoundColumnReader::RoundColumnReader(const std::string& path)
+     : m_file{path, std::ios::binary | std::ios::ate}
+ {
+     if (!m_file) {
+         throw std::runtime_error("Cannot open round export: " + path);
+     }
+     auto fileSize = static_cast<std::uint64_t>(m_file.tellg());
+     if (fileSize < 8 + kTrailerSize) {
+         throw std::runtime_error("Round export too short: " + path);
+     }
+ 
+     std::uint8_t header[8] {};
+     std::uint8_t trailer[kTrailerSize] {};
+     m_file.seekg(0);
+     m_file.read(reinterpret_cast<char*>(header), sizeof(header));
+     m_file.seekg(static_cast<std::streamoff>(fileSize - kTrailerSize));
+     m_file.read(reinterpret_cast<char*>(trailer), sizeof(trailer));
+     std::uint64_t footerOffset { GetFixed(trailer, 8) };
+     if (!m_file || GetFixed(header, 4) != kRoundFileMagic || GetFixed(header + 4, 4) != kRoundFileVersion ||
+         GetFixed(trailer + 8, 4) != kRoundFileMagic || footerOffset < 8 || footerOffset > fileSize - kTrailerSize) {
+         throw std::runtime_error("Not a round export: " + path);
+     }
+ 
+     std::vector<std::uint8_t> footer(fileSize - kTrailerSize - footerOffset);
+     m_file.seekg(static_cast<std::streamoff>(footerOffset));
+     m_file.read(reinterpret_cast<char*>(footer.data()), static_cast<std::streamsize>(footer.size()));
+     if (!m_file) {
+         throw std::runtime_error("Cannot read round export footer: " + path);
+     }
+ 
+     const std::uint8_t* cursor { footer.data() };
+     const std::uint8_t* end { footer.data() + footer.size() };
+     std::uint64_t blocks { ColumnCodec::GetVarint(cursor, end) };
+     for (std::uint64_t b{}; b < blocks; ++b) {
+         RoundBlockInfo block {};
+         block.rows = ColumnCodec::GetVarint(cursor, end);
+         for (ColumnChunkInfo& chunk : block.chunks) {
+             chunk.offset = ColumnCodec::GetVarint(cursor, end);
+             chunk.size = ColumnCodec::GetVarint(cursor, end);
+             if (cursor == end || chunk.offset + chunk.size > footerOffset) {
+                 throw std::runtime_error("Corrupt round export footer: " + path);
+             }
+             chunk.encoding = static_cast<ColumnEncoding>(*cursor++);
+             chunk.stats.min = ColumnCodec::GetVarint(cursor, end);
+             chunk.stats.max = ColumnCodec::GetVarint(cursor, end);
+         }
+         m_rows += block.rows;
+         m_blocks.push_back(block);
+     }
+ 
+     std::uint64_t names { ColumnCodec::GetVarint(cursor, end) };
+     for (std::uint64_t n{}; n < names; ++n) {
+         std::uint64_t size { ColumnCodec::GetVarint(cursor, end) };
+         if (static_cast<std::uint64_t>(end - cursor) < size) {
+             throw std::runtime_error("Corrupt round export dictionary: " + path);
+         }
+         m_names.emplace_back(reinterpret_cast<const char*>(cursor), size);
+         cursor += size;
+     }
+ }
+ 
+ std::uint64_t RoundColumnReader::Rows() const {
+     return m_rows;
+ }
+ 
+ std::size_t RoundColumnReader::BlockCount() const {
+     return m_blocks.size();
+ }
+ 
+ std::size_t RoundColumnReader::BlockRows(std::size_t block) const {
+     return m_blocks.at(block).rows;
+ }
+ 
+ ColumnStats RoundColumnReader::Stats(std::size_t block, RoundColumn column) const {
+     return Chunk(block, column).stats;
+ }
+ 
+ ColumnEncoding RoundColumnReader::Encoding(std::size_t block, RoundColumn column) const {
+     return Chunk(block, column).encoding;
+ }
+ 
+ std::size_t RoundColumnReader::ChunkSize(std::size_t block, RoundColumn column) const {
+     return Chunk(block, column).size;
+ }
+ 
+ const std::vector<std::string>& RoundColumnReader::Names() const {
+     return m_names;
+ }
+ 
+ void RoundColumnReader::ReadColumn(std::size_t block, RoundColumn column, std::vector<std::uint64_t>& out) {
+     const ColumnChunkInfo& chunk { Chunk(block, column) };
+     m_buffer.resize(chunk.size);
+     m_file.seekg(static_cast<std::streamoff>(chunk.offset));
+     m_file.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(chunk.size));
+     if (!m_file) {
+         throw std::runtime_error("Cannot read round export chunk");
+     }
+     ColumnCodec::Decode(chunk.encoding, m_buffer.data(), m_buffer.size(), m_blocks[block].rows, out);
+ }
+ 
+ const ColumnChunkInfo& RoundColumnReader::Chunk(std::size_t block, RoundColumn column) const {
+     return m_blocks.at(block).chunks.at(static_cast<std::size_t>(column));
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,141 @@
+/**
+ * @file RoundColumnWriter.cpp
+ * @brief Implements the RoundColumnWriter class.
+ */
+
+ #include "RoundColumnWriter.hpp"
+ #include <stdexcept>
+
+ namespace {
+ 
+ void PutFixed(std::vector<std::uint8_t>& out, std::uint64_t value, int size) {
+     for (int i{}; i < size; ++i) {
+         out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+     }
+ }
+ 
+ } // namespace
+ 
+ RoundColumnWriter::RoundColumnWriter(const std::string& path, std::size_t blockRows)
+     : m_file{path, std::ios::binary | std::ios::trunc},
+       m_blockRows{blockRows == 0 ? kDefaultBlockRows : blockRows}
+ {
+     if (!m_file) {
+         throw std::runtime_error("Cannot create round export: " + path);
+     }
+     for (auto& column : m_columns) {
+         column.reserve(m_blockRows);
+     }
+ 
+     std::vector<std::uint8_t> header;
+     PutFixed(header, kRoundFileMagic, 4);
+     PutFixed(header, kRoundFileVersion, 4);
+     WriteBytes(header);
+ }
+ 
+ RoundColumnWriter::~RoundColumnWriter() {
+     try {
+         Close();
+     } catch (...) {
+         // Destructors must not throw; call Close() to observe write errors.
+     }
+ }
+ 
+ void RoundColumnWriter::OnRound(const RoundRecord& record) {
+     m_columns[static_cast<std::size_t>(RoundColumn::SessionId)].push_back(record.sessionId);
+     m_columns[static_cast<std::size_t>(RoundColumn::Round)].push_back(record.round);
+     m_columns[static_cast<std::size_t>(RoundColumn::UserMove)].push_back(record.userMove);
+     m_columns[static_cast<std::size_t>(RoundColumn::ComputerMove)].push_back(record.computerMove);
+     m_columns[static_cast<std::size_t>(RoundColumn::Outcome)].push_back(static_cast<std::uint64_t>(record.outcome));
+     m_columns[static_cast<std::size_t>(RoundColumn::UserName)].push_back(NameId(0, record.userName));
+     m_columns[static_cast<std::size_t>(RoundColumn::ComputerName)].push_back(NameId(1, record.computerName));
+     m_columns[static_cast<std::size_t>(RoundColumn::DecisionNanos)].push_back(record.decisionNanos);
+     ++m_rows;
+ 
+     if (m_columns.front().size() >= m_blockRows) {
+         FlushBlock();
+     }
+ }
+ 
+ void RoundColumnWriter::Close() {
+     if (m_closed) {
+         return;
+     }
+     m_closed = true;
+     FlushBlock();
+ 
+     std::vector<std::uint8_t> footer;
+     ColumnCodec::PutVarint(footer, m_blocks.size());
+     for (const RoundBlockInfo& block : m_blocks) {
+         ColumnCodec::PutVarint(footer, block.rows);
+         for (const ColumnChunkInfo& chunk : block.chunks) {
+             ColumnCodec::PutVarint(footer, chunk.offset);
+             ColumnCodec::PutVarint(footer, chunk.size);
+             footer.push_back(static_cast<std::uint8_t>(chunk.encoding));
+             ColumnCodec::PutVarint(footer, chunk.stats.min);
+             ColumnCodec::PutVarint(footer, chunk.stats.max);
+         }
+     }
+     ColumnCodec::PutVarint(footer, m_names.size());
+     for (const std::string& name : m_names) {
+         ColumnCodec::PutVarint(footer, name.size());
+         footer.insert(footer.end(), name.begin(), name.end());
+     }
+ 
+     // Trailer: where the footer starts, then the magic again.
+     PutFixed(footer, m_offset, 8);
+     PutFixed(footer, kRoundFileMagic, 4);
+     WriteBytes(footer);
+ 
+     m_file.close();
+     if (!m_file) {
+         throw std::runtime_error("Cannot finish round export");
+     }
+ }
+ 
+ std::uint64_t RoundColumnWriter::Rows() const {
+     return m_rows;
+ }
+ 
+ std::uint64_t RoundColumnWriter::NameId(std::size_t slot, std::string_view name) {
+     std::uint64_t recent { m_recentNameIds[slot] };
+     if (recent < m_names.size() && m_names[recent] == name) {
+         return recent;
+     }
+ 
+     auto [it, inserted] = m_nameIds.try_emplace(std::string{name}, m_names.size());
+     if (inserted) {
+         m_names.emplace_back(name);
+     }
+     m_recentNameIds[slot] = it->second;
+     return it->second;
+ }
+ 
+ void RoundColumnWriter::FlushBlock() {
+     if (m_columns.front().empty()) {
+         return;
+     }
+ 
+     RoundBlockInfo block {};
+     block.rows = m_columns.front().size();
+     for (std::size_t column{}; column < kRoundColumnCount; ++column) {
+         m_scratch.clear();
+         ColumnChunkInfo& chunk { block.chunks[column] };
+         chunk.offset = m_offset;
+         chunk.encoding = ColumnCodec::Encode(m_columns[column], m_scratch);
+         chunk.size = m_scratch.size();
+         chunk.stats = ColumnCodec::ComputeStats(m_columns[column]);
+         WriteBytes(m_scratch);
+         m_columns[column].clear();
+     }
+     m_blocks.push_back(block);
+ }
+ 
+ void RoundColumnWriter::WriteBytes(const std::vector<std::uint8_t>& bytes) {
+     m_file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+     if (!m_file) {
+         throw std::runtime_error("Write to round export failed");
+     }
+     m_offset += bytes.size();
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,227 @@
+/**
+ * @file RoundColumns.cpp
+ * @brief Implements the ColumnCodec class.
+ */
+
+ #include "RoundColumns.hpp"
+ #include <algorithm>
+ #include <stdexcept>
+
+ namespace {
+ 
+ /**
+  * @brief Zero bytes appended to a bit-packed chunk so decoding can always load 9 bytes.
+  */
+ constexpr std::size_t kBitPackPadding {8};
+ 
+ std::uint64_t ZigZag(std::uint64_t delta) {
+     auto signedDelta = static_cast<std::int64_t>(delta);
+     return (static_cast<std::uint64_t>(signedDelta) << 1) ^ static_cast<std::uint64_t>(signedDelta >> 63);
+ }
+ 
+ std::uint64_t UnZigZag(std::uint64_t value) {
+     return (value >> 1) ^ (~(value & 1) + 1);
+ }
+ 
+ std::uint64_t LoadWord(const std::uint8_t* data) {
+     std::uint64_t word {};
+     for (int i{}; i < 8; ++i) {
+         word |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+     }
+     return word;
+ }
+ 
+ int BitWidth(std::uint64_t value) {
+     int width {};
+     while (value != 0) {
+         ++width;
+         value >>= 1;
+     }
+     return width;
+ }
+ 
+ void EncodeRunLength(const std::vector<std::uint64_t>& values, std::vector<std::uint8_t>& out) {
+     std::size_t i {};
+     while (i < values.size()) {
+         std::size_t run {1};
+         while (i + run < values.size() && values[i + run] == values[i]) {
+             ++run;
+         }
+         ColumnCodec::PutVarint(out, values[i]);
+         ColumnCodec::PutVarint(out, run);
+         i += run;
+     }
+ }
+ 
+ void EncodeDeltaVarint(const std::vector<std::uint64_t>& values, std::vector<std::uint8_t>& out) {
+     std::uint64_t previous {};
+     for (std::uint64_t value : values) {
+         ColumnCodec::PutVarint(out, ZigZag(value - previous));
+         previous = value;
+     }
+ }
+ 
+ void EncodeBitPacked(const std::vector<std::uint64_t>& values, std::vector<std::uint8_t>& out) {
+     ColumnStats stats { ColumnCodec::ComputeStats(values) };
+     int width { BitWidth(stats.max - stats.min) };
+     ColumnCodec::PutVarint(out, stats.min);
+     out.push_back(static_cast<std::uint8_t>(width));
+ 
+     std::size_t start { out.size() };
+     out.resize(start + (values.size() * static_cast<std::size_t>(width) + 7) / 8 + kBitPackPadding, 0);
+     std::uint8_t* packed { out.data() + start };
+     std::size_t bit {};
+     for (std::uint64_t value : values) {
+         std::uint64_t offset { value - stats.min };
+         for (int written{}; written < width;) {
+             int shift { static_cast<int>(bit % 8) };
+             int take { std::min(8 - shift, width - written) };
+             packed[bit / 8] |= static_cast<std::uint8_t>(((offset >> written) & ((1u << take) - 1)) << shift);
+             written += take;
+             bit += static_cast<std::size_t>(take);
+         }
+     }
+ }
+ 
+ void DecodeRunLength(const std::uint8_t* cursor, const std::uint8_t* end, std::size_t count,
+                      std::vector<std::uint64_t>& out) {
+     out.resize(count);
+     std::uint64_t* target { out.data() };
+     std::size_t filled {};
+     while (filled < count) {
+         std::uint64_t value { ColumnCodec::GetVarint(cursor, end) };
+         std::uint64_t run { ColumnCodec::GetVarint(cursor, end) };
+         if (run > count - filled) {
+             throw std::runtime_error("Run-length chunk overflows its block");
+         }
+         std::fill_n(target + filled, run, value);
+         filled += run;
+     }
+ }
+ 
+ void DecodeDeltaVarint(const std::uint8_t* cursor, const std::uint8_t* end, std::size_t count,
+                        std::vector<std::uint64_t>& out) {
+     out.resize(count);
+     std::uint64_t value {};
+     for (std::size_t i{}; i < count; ++i) {
+         // Single-byte deltas (consecutive rounds, repeated values) are the common case.
+         if (cursor < end && *cursor < 0x80) {
+             value += UnZigZag(*cursor++);
+         } else {
+             value += UnZigZag(ColumnCodec::GetVarint(cursor, end));
+         }
+         out[i] = value;
+     }
+ }
+ 
+ void DecodeBitPacked(const std::uint8_t* cursor, const std::uint8_t* end, std::size_t count,
+                      std::vector<std::uint64_t>& out) {
+     std::uint64_t base { ColumnCodec::GetVarint(cursor, end) };
+     if (cursor == end || *cursor > 64) {
+         throw std::runtime_error("Corrupt bit-packed chunk header");
+     }
+     const int width { *cursor++ };
+     std::size_t needed { (count * static_cast<std::size_t>(width) + 7) / 8 + kBitPackPadding };
+     if (static_cast<std::size_t>(end - cursor) < needed) {
+         throw std::runtime_error("Truncated bit-packed chunk");
+     }
+ 
+     out.resize(count);
+     std::uint64_t* target { out.data() };
+     if (width == 0) {
+         std::fill_n(target, count, base);
+         return;
+     }
+     const std::uint64_t mask { width == 64 ? ~0ull : (1ull << width) - 1 };
+     std::size_t bit {};
+     for (std::size_t i{}; i < count; ++i, bit += static_cast<std::size_t>(width)) {
+         const std::uint8_t* word { cursor + bit / 8 };
+         const int shift { static_cast<int>(bit % 8) };
+         std::uint64_t value { LoadWord(word) >> shift };
+         if (shift + width > 64) {
+             value |= static_cast<std::uint64_t>(word[8]) << (64 - shift);
+         }
+         target[i] = base + (value & mask);
+     }
+ }
+ 
+ } // namespace
+ 
+ ColumnEncoding ColumnCodec::Encode(const std::vector<std::uint64_t>& values, std::vector<std::uint8_t>& out) {
+     ColumnEncoding best {ColumnEncoding::RunLength};
+     std::vector<std::uint8_t> bestBytes;
+     for (ColumnEncoding encoding : {ColumnEncoding::RunLength, ColumnEncoding::DeltaVarint, ColumnEncoding::BitPacked}) {
+         std::vector<std::uint8_t> candidate;
+         EncodeAs(encoding, values, candidate);
+         if (bestBytes.empty() || candidate.size() < bestBytes.size()) {
+             best = encoding;
+             bestBytes = std::move(candidate);
+         }
+     }
+     out.insert(out.end(), bestBytes.begin(), bestBytes.end());
+     return best;
+ }
+ 
+ void ColumnCodec::EncodeAs(ColumnEncoding encoding, const std::vector<std::uint64_t>& values,
+                            std::vector<std::uint8_t>& out) {
+     switch (encoding) {
+     case ColumnEncoding::RunLength:
+         EncodeRunLength(values, out);
+         break;
+     case ColumnEncoding::DeltaVarint:
+         EncodeDeltaVarint(values, out);
+         break;
+     case ColumnEncoding::BitPacked:
+         EncodeBitPacked(values, out);
+         break;
+     }
+ }
+ 
+ void ColumnCodec::Decode(ColumnEncoding encoding, const std::uint8_t* data, std::size_t size,
+                          std::size_t count, std::vector<std::uint64_t>& out) {
+     const std::uint8_t* end { data + size };
+     switch (encoding) {
+     case ColumnEncoding::RunLength:
+         DecodeRunLength(data, end, count, out);
+         return;
+     case ColumnEncoding::DeltaVarint:
+         DecodeDeltaVarint(data, end, count, out);
+         return;
+     case ColumnEncoding::BitPacked:
+         DecodeBitPacked(data, end, count, out);
+         return;
+     }
+     throw std::runtime_error("Unknown column encoding");
+ }
+ 
+ ColumnStats ColumnCodec::ComputeStats(const std::vector<std::uint64_t>& values) {
+     if (values.empty()) {
+         return {};
+     }
+     auto [min, max] = std::minmax_element(values.begin(), values.end());
+     return {*min, *max};
+ }
+ 
+ void ColumnCodec::PutVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+     while (value >= 0x80) {
+         out.push_back(static_cast<std::uint8_t>(value | 0x80));
+         value >>= 7;
+     }
+     out.push_back(static_cast<std::uint8_t>(value));
+ }
+ 
+ std::uint64_t ColumnCodec::GetVarint(const std::uint8_t*& cursor, const std::uint8_t* end) {
+     std::uint64_t value {};
+     for (int shift{}; shift < 64; shift += 7) {
+         if (cursor == end) {
+             break;
+         }
+         std::uint8_t byte { *cursor++ };
+         value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+         if ((byte & 0x80) == 0) {
+             return value;
+         }
+     }
+     throw std::runtime_error("Truncated or overlong varint");
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,29 @@
+/**
+ * @file RoundObserverFanOut.cpp
+ * @brief Implements the RoundObserverFanOut class.
+ */
+
+ #include "RoundObserverFanOut.hpp"
+
+ void RoundObserverFanOut::Add(IRoundObserver* observer) {
+     if (observer != nullptr) {
+         m_observers.push_back(observer);
+     }
+ }
+ 
+ std::size_t RoundObserverFanOut::Size() const {
+     return m_observers.size();
+ }
+ 
+ void RoundObserverFanOut::OnRound(const RoundRecord& record) {
+     for (IRoundObserver* observer : m_observers) {
+         observer->OnRound(record);
+     }
+ }
+ 
+ void RoundObserverFanOut::OnSessionEnd(const SessionSummary& summary) {
+     for (IRoundObserver* observer : m_observers) {
+         observer->OnSessionEnd(summary);
+     }
+ }
+ 
\ No newline at end of file
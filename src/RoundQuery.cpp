@@ -0,0 +1,261 @@
+/**
+ * @file RoundQuery.cpp
+ * @brief Implements RoundQuery parsing and rendering.
+ */
+
+ #include "RoundQuery.hpp"
+ #include "GameMove.hpp"
+ #include "IRoundObserver.hpp"
+ #include <array>
+ #include <cstdlib>
+ #include <stdexcept>
+ #include <utility>
+
+ namespace {
+ 
+ constexpr std::array<std::pair<const char*, RoundColumn>, kRoundColumnCount> kColumnNames {{
+     {"session", RoundColumn::SessionId},
+     {"round", RoundColumn::Round},
+     {"user_move", RoundColumn::UserMove},
+     {"computer_move", RoundColumn::ComputerMove},
+     {"outcome", RoundColumn::Outcome},
+     {"user_name", RoundColumn::UserName},
+     {"computer_name", RoundColumn::ComputerName},
+     {"nanos", RoundColumn::DecisionNanos},
+ }};
+ 
+ constexpr std::array<std::pair<const char*, GameMove>, 3> kMoveNames {{
+     {"rock", GameMove::Rock},
+     {"paper", GameMove::Paper},
+     {"scissors", GameMove::Scissors},
+ }};
+ 
+ constexpr std::array<std::pair<const char*, RoundOutcome>, 4> kOutcomeNames {{
+     {"draw", RoundOutcome::Draw},
+     {"user_win", RoundOutcome::UserWin},
+     {"computer_win", RoundOutcome::ComputerWin},
+     {"forfeit", RoundOutcome::Forfeit},
+ }};
+ 
+ std::string Trim(const std::string& text) {
+     auto begin = text.find_first_not_of(" \t");
+     if (begin == std::string::npos) {
+         return {};
+     }
+     auto end = text.find_last_not_of(" \t");
+     return text.substr(begin, end - begin + 1);
+ }
+ 
+ std::vector<std::string> SplitList(const std::string& text) {
+     std::vector<std::string> items;
+     std::size_t start {};
+     while (start <= text.size()) {
+         auto comma = text.find(',', start);
+         if (comma == std::string::npos) {
+             comma = text.size();
+         }
+         std::string item { Trim(text.substr(start, comma - start)) };
+         if (!item.empty()) {
+             items.push_back(item);
+         }
+         start = comma + 1;
+     }
+     return items;
+ }
+ 
+ bool IsNameColumn(RoundColumn column) {
+     return column == RoundColumn::UserName || column == RoundColumn::ComputerName;
+ }
+ 
+ QueryField ParseField(const std::string& text) {
+     QueryField field {};
+     std::string name { Trim(text) };
+     auto at = name.find('@');
+     if (at != std::string::npos) {
+         char* end {};
+         unsigned long lag { std::strtoul(name.c_str() + at + 1, &end, 10) };
+         if (*end != '\0' || at + 1 == name.size() || lag > RoundQuery::kMaxLag) {
+             throw std::invalid_argument("Bad lag in field: " + name);
+         }
+         field.lag = static_cast<std::uint8_t>(lag);
+         name = name.substr(0, at);
+     }
+     for (const auto& [columnName, column] : kColumnNames) {
+         if (name == columnName) {
+             field.column = column;
+             return field;
+         }
+     }
+     throw std::invalid_argument("Unknown field: " + name);
+ }
+ 
+ /**
+  * @brief Parses a constant for `column`; name columns keep the text in `name`.
+  */
+ std::uint64_t ParseValue(RoundColumn column, const std::string& text, std::string* name) {
+     std::string value { Trim(text) };
+     if (IsNameColumn(column)) {
+         if (!name) {
+             throw std::invalid_argument("Name columns cannot be aggregated by value");
+         }
+         *name = value;
+         return 0;
+     }
+     if (column == RoundColumn::UserMove || column == RoundColumn::ComputerMove) {
+         for (const auto& [moveName, move] : kMoveNames) {
+             if (value == moveName) {
+                 return static_cast<std::uint64_t>(move);
+             }
+         }
+         if (value == "none") {
+             return 0;
+         }
+     }
+     if (column == RoundColumn::Outcome) {
+         for (const auto& [outcomeName, outcome] : kOutcomeNames) {
+             if (value == outcomeName) {
+                 return static_cast<std::uint64_t>(outcome);
+             }
+         }
+     }
+     char* end {};
+     std::uint64_t number { std::strtoull(value.c_str(), &end, 10) };
+     if (value.empty() || *end != '\0') {
+         throw std::invalid_argument("Bad value: " + value);
+     }
+     return number;
+ }
+ 
+ QueryFilter ParseFilter(const std::string& text) {
+     auto position = text.find_first_of("=!<>");
+     if (position == std::string::npos || position == 0) {
+         throw std::invalid_argument("Bad filter: " + text);
+     }
+ 
+     QueryFilter filter {};
+     filter.field = ParseField(text.substr(0, position));
+     std::size_t valueStart { position + 1 };
+     bool orEqual { valueStart < text.size() && text[valueStart] == '=' };
+     switch (text[position]) {
+     case '=':
+         filter.op = CompareOp::Equal;
+         break;
+     case '!':
+         if (!orEqual) {
+             throw std::invalid_argument("Bad filter: " + text);
+         }
+         filter.op = CompareOp::NotEqual;
+         break;
+     case '<':
+         filter.op = orEqual ? CompareOp::LessEqual : CompareOp::Less;
+         break;
+     default:
+         filter.op = orEqual ? CompareOp::GreaterEqual : CompareOp::Greater;
+         break;
+     }
+     if (orEqual) {
+         ++valueStart;
+     }
+ 
+     if (IsNameColumn(filter.field.column) &&
+         filter.op != CompareOp::Equal && filter.op != CompareOp::NotEqual) {
+         throw std::invalid_argument("Names only support = and !=: " + text);
+     }
+     filter.value = ParseValue(filter.field.column, text.substr(valueStart), &filter.name);
+     return filter;
+ }
+ 
+ QueryAggregate ParseAggregate(const std::string& text) {
+     QueryAggregate aggregate {};
+     if (text == "count") {
+         aggregate.kind = AggregateKind::Count;
+         return aggregate;
+     }
+ 
+     auto open = text.find('(');
+     if (open == std::string::npos || text.back() != ')') {
+         throw std::invalid_argument("Bad aggregate: " + text);
+     }
+     std::string function { Trim(text.substr(0, open)) };
+     std::string argument { text.substr(open + 1, text.size() - open - 2) };
+ 
+     if (function == "rate") {
+         auto equals = argument.find('=');
+         if (equals == std::string::npos) {
+             throw std::invalid_argument("rate() needs field=value: " + text);
+         }
+         aggregate.kind = AggregateKind::CountEqual;
+         aggregate.field = ParseField(argument.substr(0, equals));
+         aggregate.value = ParseValue(aggregate.field.column, argument.substr(equals + 1), nullptr);
+         return aggregate;
+     }
+ 
+     if (function == "sum") {
+         aggregate.kind = AggregateKind::Sum;
+     } else if (function == "min") {
+         aggregate.kind = AggregateKind::Min;
+     } else if (function == "max") {
+         aggregate.kind = AggregateKind::Max;
+     } else {
+         throw std::invalid_argument("Unknown aggregate: " + function);
+     }
+     aggregate.field = ParseField(argument);
+     if (IsNameColumn(aggregate.field.column)) {
+         throw std::invalid_argument("Name columns cannot be aggregated: " + text);
+     }
+     return aggregate;
+ }
+ 
+ } // namespace
+ 
+ bool QueryField::operator==(const QueryField& other) const {
+     return column == other.column && lag == other.lag;
+ }
+ 
+ RoundQuery RoundQuery::Parse(const std::string& where, const std::string& groupBy,
+                              const std::string& aggregates) {
+     RoundQuery query {};
+     for (const std::string& item : SplitList(where)) {
+         query.filters.push_back(ParseFilter(item));
+     }
+     for (const std::string& item : SplitList(groupBy)) {
+         query.groupBy.push_back(ParseField(item));
+     }
+     if (query.groupBy.size() > kMaxGroupFields) {
+         throw std::invalid_argument("Too many group-by fields");
+     }
+     for (const std::string& item : SplitList(aggregates)) {
+         query.aggregates.push_back(ParseAggregate(item));
+     }
+     if (query.aggregates.empty()) {
+         query.aggregates.push_back(QueryAggregate{});
+     }
+     return query;
+ }
+ 
+ std::string RoundQuery::FieldName(const QueryField& field) {
+     std::string name { kColumnNames[static_cast<std::size_t>(field.column)].first };
+     if (field.lag > 0) {
+         name += "@" + std::to_string(field.lag);
+     }
+     return name;
+ }
+ 
+ std::string RoundQuery::ValueText(RoundColumn column, std::uint64_t value) {
+     if (value == kMissing) {
+         return "-";
+     }
+     if (column == RoundColumn::UserMove || column == RoundColumn::ComputerMove) {
+         for (const auto& [moveName, move] : kMoveNames) {
+             if (value == static_cast<std::uint64_t>(move)) {
+                 return moveName;
+             }
+         }
+         return "none";
+     }
+     if (column == RoundColumn::Outcome && value < kOutcomeNames.size()) {
+         return kOutcomeNames[value].first;
+     }
+     return std::to_string(value);
+ }
+ 
\ No newline at end of file
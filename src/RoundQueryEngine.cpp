@@ -0,0 +1,678 @@
+/**
+ * @file RoundQueryEngine.cpp
+ * @brief Implements the RoundQueryEngine class.
+ */
+
+ #include "RoundQueryEngine.hpp"
+ #include "RoundColumnReader.hpp"
+ #include <algorithm>
+ #include <array>
+ #include <atomic>
+ #include <exception>
+ #include <map>
+ #include <memory>
+ #include <numeric>
+ #include <sstream>
+ #include <stdexcept>
+ #include <thread>
+ #include <unordered_map>
+
+ namespace {
+ 
+ /**
+  * @brief Filter constant for a name that a file's dictionary does not contain.
+  */
+ constexpr std::uint64_t kAbsentName {RoundQuery::kMissing - 1};
+ 
+ bool IsNameColumn(RoundColumn column) {
+     return column == RoundColumn::UserName || column == RoundColumn::ComputerName;
+ }
+ 
+ /**
+  * @brief The query with every distinct field assigned a slot.
+  */
+ struct Plan {
+     std::vector<QueryField> fields {};
+     std::vector<std::size_t> filterSlots {};
+     std::vector<std::size_t> groupSlots {};
+     std::vector<std::size_t> aggregateSlots {};
+     std::array<bool, kRoundColumnCount> columns {};
+     std::uint8_t maxLag {};
+     bool groupsByName {};
+ 
+     std::size_t Slot(const QueryField& field) {
+         auto it = std::find(fields.begin(), fields.end(), field);
+         if (it != fields.end()) {
+             return static_cast<std::size_t>(it - fields.begin());
+         }
+         if (field.lag > RoundQuery::kMaxLag) {
+             throw std::invalid_argument("Lag too large: " + RoundQuery::FieldName(field));
+         }
+         columns[static_cast<std::size_t>(field.column)] = true;
+         maxLag = std::max(maxLag, field.lag);
+         fields.push_back(field);
+         return fields.size() - 1;
+     }
+ };
+ 
+ Plan MakePlan(const RoundQuery& query) {
+     if (query.groupBy.size() > RoundQuery::kMaxGroupFields) {
+         throw std::invalid_argument("Too many group-by fields");
+     }
+     Plan plan {};
+     for (const QueryFilter& filter : query.filters) {
+         plan.filterSlots.push_back(plan.Slot(filter.field));
+     }
+     for (const QueryField& field : query.groupBy) {
+         plan.groupSlots.push_back(plan.Slot(field));
+         plan.groupsByName = plan.groupsByName || IsNameColumn(field.column);
+     }
+     for (const QueryAggregate& aggregate : query.aggregates) {
+         plan.aggregateSlots.push_back(aggregate.kind == AggregateKind::Count ? 0 : plan.Slot(aggregate.field));
+     }
+     if (plan.maxLag > 0) {
+         plan.columns[static_cast<std::size_t>(RoundColumn::SessionId)] = true;
+         plan.columns[static_cast<std::size_t>(RoundColumn::Round)] = true;
+     }
+     return plan;
+ }
+ 
+ struct GroupKey {
+     std::uint32_t file {};
+     std::array<std::uint64_t, RoundQuery::kMaxGroupFields> values {};
+ 
+     bool operator==(const GroupKey& other) const {
+         return file == other.file && values == other.values;
+     }
+ };
+ 
+ struct GroupKeyHash {
+     std::size_t operator()(const GroupKey& key) const {
+         std::uint64_t hash { key.file * 0x9E3779B97F4A7C15ull };
+         for (std::uint64_t value : key.values) {
+             hash = (hash ^ value) * 0xBF58476D1CE4E5B9ull;
+             hash ^= hash >> 31;
+         }
+         return static_cast<std::size_t>(hash);
+     }
+ };
+ 
+ struct Accumulator {
+     std::uint64_t rows {};
+     std::vector<std::uint64_t> values {};
+ };
+ 
+ using GroupTable = std::unordered_map<GroupKey, Accumulator, GroupKeyHash>;
+ 
+ /**
+  * @brief Returns false if no value in [stats.min, stats.max] can satisfy the filter.
+  */
+ bool CanMatch(CompareOp op, std::uint64_t value, ColumnStats stats) {
+     switch (op) {
+     case CompareOp::Equal:        return stats.min <= value && value <= stats.max;
+     case CompareOp::NotEqual:     return !(stats.min == value && stats.max == value);
+     case CompareOp::Less:         return stats.min < value;
+     case CompareOp::LessEqual:    return stats.min <= value;
+     case CompareOp::Greater:      return stats.max > value;
+     case CompareOp::GreaterEqual: return stats.max >= value;
+     }
+     return true;
+ }
+ 
+ /**
+  * @brief Narrows the selection to rows passing `compare`; branch-free per row.
+  * @param dense True if the selection is still "every row" and `selection` is unset.
+  */
+ template <typename CompareFunc>
+ std::size_t Select(const std::uint64_t* data, std::uint64_t value, std::uint32_t* selection,
+                    std::size_t count, bool dense, CompareFunc compare) {
+     std::size_t kept {};
+     if (dense) {
+         for (std::size_t row{}; row < count; ++row) {
+             selection[kept] = static_cast<std::uint32_t>(row);
+             kept += compare(data[row], value);
+         }
+     } else {
+         for (std::size_t i{}; i < count; ++i) {
+             std::uint32_t row { selection[i] };
+             selection[kept] = row;
+             kept += compare(data[row], value);
+         }
+     }
+     return kept;
+ }
+ 
+ std::size_t ApplyFilter(CompareOp op, const std::uint64_t* data, std::uint64_t value,
+                         std::uint32_t* selection, std::size_t count, bool dense) {
+     switch (op) {
+     case CompareOp::Equal:
+         return Select(data, value, selection, count, dense, [](std::uint64_t a, std::uint64_t b) { return a == b; });
+     case CompareOp::NotEqual:
+         return Select(data, value, selection, count, dense, [](std::uint64_t a, std::uint64_t b) { return a != b; });
+     case CompareOp::Less:
+         return Select(data, value, selection, count, dense, [](std::uint64_t a, std::uint64_t b) { return a < b; });
+     case CompareOp::LessEqual:
+         return Select(data, value, selection, count, dense, [](std::uint64_t a, std::uint64_t b) { return a <= b; });
+     case CompareOp::Greater:
+         return Select(data, value, selection, count, dense, [](std::uint64_t a, std::uint64_t b) { return a > b; });
+     case CompareOp::GreaterEqual:
+         return Select(data, value, selection, count, dense, [](std::uint64_t a, std::uint64_t b) { return a >= b; });
+     }
+     return 0;
+ }
+ 
+ /**
+  * @brief An opened input file and the query constants resolved against it.
+  */
+ struct InputFile {
+     std::string path {};
+     std::unique_ptr<RoundColumnReader> metadata {};
+     std::vector<std::uint64_t> filterValues {};
+ };
+ 
+ /**
+  * @brief Per-thread scan state; reused across blocks to avoid reallocation.
+  */
+ class Worker {
+ public:
+     Worker(const RoundQuery& query, const Plan& plan, const std::vector<InputFile>& files)
+         : m_query{query},
+           m_plan{plan},
+           m_files{files},
+           m_readers(files.size()),
+           m_lagged(plan.fields.size()),
+           m_data(plan.fields.size())
+     {
+     }
+ 
+     void ProcessBlock(std::size_t file, std::size_t block) {
+         const RoundColumnReader& metadata { *m_files[file].metadata };
+         const std::vector<std::uint64_t>& filterValues { m_files[file].filterValues };
+         const std::size_t rows { metadata.BlockRows(block) };
+ 
+         for (std::size_t i{}; i < m_query.filters.size(); ++i) {
+             const QueryFilter& filter { m_query.filters[i] };
+             if (filter.field.lag == 0 &&
+                 !CanMatch(filter.op, filterValues[i], metadata.Stats(block, filter.field.column))) {
+                 ++m_blocksPruned;
+                 return;
+             }
+         }
+         ++m_blocksScanned;
+         m_rowsScanned += rows;
+ 
+         RoundColumnReader& reader { Reader(file) };
+         for (std::size_t column{}; column < kRoundColumnCount; ++column) {
+             if (m_plan.columns[column]) {
+                 reader.ReadColumn(block, static_cast<RoundColumn>(column), m_current[column]);
+             }
+         }
+         BindFields(reader, file, block, rows);
+ 
+         m_selection.resize(rows);
+         std::size_t selected { rows };
+         bool dense { true };
+         for (std::size_t i{}; i < m_query.filters.size(); ++i) {
+             selected = ApplyFilter(m_query.filters[i].op, m_data[m_plan.filterSlots[i]], filterValues[i],
+                                    m_selection.data(), selected, dense);
+             dense = false;
+         }
+         if (dense) {
+             std::iota(m_selection.begin(), m_selection.end(), 0u);
+         }
+         m_rowsMatched += selected;
+         Aggregate(file, selected);
+     }
+ 
+     GroupTable& Table() { return m_table; }
+ 
+     std::uint64_t m_blocksScanned {};
+     std::uint64_t m_blocksPruned {};
+     std::uint64_t m_rowsScanned {};
+     std::uint64_t m_rowsMatched {};
+ 
+ private:
+     RoundColumnReader& Reader(std::size_t file) {
+         if (!m_readers[file]) {
+             m_readers[file] = std::make_unique<RoundColumnReader>(m_files[file].path);
+         }
+         return *m_readers[file];
+     }
+ 
+     const std::vector<std::uint64_t>& Current(RoundColumn column) const {
+         return m_current[static_cast<std::size_t>(column)];
+     }
+ 
+     /**
+      * @brief Points every field slot at its values, computing lagged fields.
+      */
+     void BindFields(RoundColumnReader& reader, std::size_t file, std::size_t block, std::size_t rows) {
+         if (m_plan.maxLag > 0) {
+             LoadTail(reader, file, block);
+         }
+         const std::size_t tail { m_tail[static_cast<std::size_t>(RoundColumn::SessionId)].size() };
+ 
+         const auto& sessions = Current(RoundColumn::SessionId);
+         const auto& rounds = Current(RoundColumn::Round);
+         const auto& tailSessions = m_tail[static_cast<std::size_t>(RoundColumn::SessionId)];
+         const auto& tailRounds = m_tail[static_cast<std::size_t>(RoundColumn::Round)];
+ 
+         for (std::size_t slot{}; slot < m_plan.fields.size(); ++slot) {
+             const QueryField& field { m_plan.fields[slot] };
+             const auto& values = Current(field.column);
+             if (field.lag == 0) {
+                 m_data[slot] = values.data();
+                 continue;
+             }
+ 
+             // A lagged value exists if the row `lag` back is the same session, `lag` rounds earlier.
+             const std::size_t lag { field.lag };
+             const auto& tailValues = m_tail[static_cast<std::size_t>(field.column)];
+             std::vector<std::uint64_t>& lagged { m_lagged[slot] };
+             lagged.resize(rows);
+             const std::size_t head { std::min(lag, rows) };
+             for (std::size_t row{}; row < head; ++row) {
+                 lagged[row] = RoundQuery::kMissing;
+                 if (lag - row <= tail) {
+                     std::size_t source { tail - (lag - row) };
+                     if (tailSessions[source] == sessions[row] && tailRounds[source] + lag == rounds[row]) {
+                         lagged[row] = tailValues[source];
+                     }
+                 }
+             }
+             for (std::size_t row { head }; row < rows; ++row) {
+                 std::size_t source { row - lag };
+                 bool sameSession { static_cast<bool>((sessions[source] == sessions[row]) & (rounds[source] + lag == rounds[row])) };
+                 lagged[row] = sameSession ? values[source] : RoundQuery::kMissing;
+             }
+             m_data[slot] = lagged.data();
+         }
+ 
+         if (m_plan.maxLag > 0) {
+             SaveTail(file, block, rows);
+         }
+     }
+ 
+     /**
+      * @brief Makes m_tail hold the last rows of the block before `block`.
+      *
+      * Workers take runs of consecutive blocks, so the tail saved from the
+      * previous block is usually still there; otherwise it is decoded.
+      */
+     void LoadTail(RoundColumnReader& reader, std::size_t file, std::size_t block) {
+         if (m_tailFile == file && m_tailBlock + 1 == block) {
+             return;
+         }
+         for (std::size_t column{}; column < kRoundColumnCount; ++column) {
+             m_tail[column].clear();
+             if (m_plan.columns[column] && block > 0) {
+                 reader.ReadColumn(block - 1, static_cast<RoundColumn>(column), m_tail[column]);
+                 std::size_t keep { std::min<std::size_t>(m_plan.maxLag, m_tail[column].size()) };
+                 m_tail[column].erase(m_tail[column].begin(), m_tail[column].end() - static_cast<std::ptrdiff_t>(keep));
+             }
+         }
+     }
+ 
+     void SaveTail(std::size_t file, std::size_t block, std::size_t rows) {
+         std::size_t keep { std::min<std::size_t>(m_plan.maxLag, rows) };
+         for (std::size_t column{}; column < kRoundColumnCount; ++column) {
+             if (m_plan.columns[column]) {
+                 m_tail[column].assign(m_current[column].end() - static_cast<std::ptrdiff_t>(keep), m_current[column].end());
+             }
+         }
+         m_tailFile = file;
+         m_tailBlock = block;
+     }
+ 
+     Accumulator& Group(const GroupKey& key) {
+         auto [it, inserted] = m_table.try_emplace(key);
+         if (inserted) {
+             it->second.values.assign(m_query.aggregates.size(), 0);
+             for (std::size_t a{}; a < m_query.aggregates.size(); ++a) {
+                 if (m_query.aggregates[a].kind == AggregateKind::Min) {
+                     it->second.values[a] = RoundQuery::kMissing;
+                 }
+             }
+         }
+         return it->second;
+     }
+ 
+     /**
+      * @brief Resolves the group of every selected row into m_groups.
+      *
+      * A small direct-mapped cache in front of the hash table makes the
+      * common case (few distinct groups) a hash, a compare and a load.
+      */
+     void ResolveGroups(std::size_t file, std::size_t selected) {
+         m_groups.resize(selected);
+         GroupKey key {};
+         key.file = m_plan.groupsByName ? static_cast<std::uint32_t>(file) : 0;
+         const std::size_t groupFields { m_plan.groupSlots.size() };
+         const std::uint64_t* columns[RoundQuery::kMaxGroupFields] {};
+         for (std::size_t g{}; g < groupFields; ++g) {
+             columns[g] = m_data[m_plan.groupSlots[g]];
+         }
+ 
+         for (std::size_t i{}; i < selected; ++i) {
+             const std::uint32_t row { m_selection[i] };
+             std::uint64_t hash { key.file };
+             for (std::size_t g{}; g < groupFields; ++g) {
+                 key.values[g] = columns[g][row];
+                 hash = (hash ^ key.values[g]) * 0x9E3779B97F4A7C15ull;
+             }
+             CacheEntry& entry { m_groupCache[(hash >> 56) % kGroupCacheSize] };
+             if (!entry.group || !(entry.key == key)) {
+                 entry.key = key;
+                 entry.group = &Group(key);
+             }
+             m_groups[i] = entry.group;
+         }
+     }
+ 
+     void Aggregate(std::size_t file, std::size_t selected) {
+         if (m_plan.groupSlots.empty()) {
+             AggregateInto(Group(GroupKey{}), selected);
+             return;
+         }
+ 
+         ResolveGroups(file, selected);
+         for (std::size_t i{}; i < selected; ++i) {
+             ++m_groups[i]->rows;
+         }
+ 
+         // Then update one aggregate at a time over the whole selection.
+         for (std::size_t a{}; a < m_query.aggregates.size(); ++a) {
+             const QueryAggregate& aggregate { m_query.aggregates[a] };
+             const std::uint64_t* data { m_data[m_plan.aggregateSlots[a]] };
+             switch (aggregate.kind) {
+             case AggregateKind::Count:
+                 for (std::size_t i{}; i < selected; ++i) {
+                     ++m_groups[i]->values[a];
+                 }
+                 break;
+             case AggregateKind::CountEqual:
+                 for (std::size_t i{}; i < selected; ++i) {
+                     m_groups[i]->values[a] += data[m_selection[i]] == aggregate.value;
+                 }
+                 break;
+             case AggregateKind::Sum:
+                 for (std::size_t i{}; i < selected; ++i) {
+                     std::uint64_t value { data[m_selection[i]] };
+                     m_groups[i]->values[a] += value == RoundQuery::kMissing ? 0 : value;
+                 }
+                 break;
+             case AggregateKind::Min:
+                 for (std::size_t i{}; i < selected; ++i) {
+                     std::uint64_t& slot { m_groups[i]->values[a] };
+                     slot = std::min(slot, data[m_selection[i]]);
+                 }
+                 break;
+             case AggregateKind::Max:
+                 for (std::size_t i{}; i < selected; ++i) {
+                     std::uint64_t value { data[m_selection[i]] };
+                     std::uint64_t& slot { m_groups[i]->values[a] };
+                     if (value != RoundQuery::kMissing) {
+                         slot = std::max(slot, value);
+                     }
+                 }
+                 break;
+             }
+         }
+     }
+ 
+     /**
+      * @brief Ungrouped aggregation: tight reductions into locals.
+      */
+     void AggregateInto(Accumulator& group, std::size_t selected) {
+         group.rows += selected;
+         for (std::size_t a{}; a < m_query.aggregates.size(); ++a) {
+             const QueryAggregate& aggregate { m_query.aggregates[a] };
+             const std::uint64_t* data { m_data[m_plan.aggregateSlots[a]] };
+             std::uint64_t& slot { group.values[a] };
+             switch (aggregate.kind) {
+             case AggregateKind::Count:
+                 slot += selected;
+                 break;
+             case AggregateKind::CountEqual: {
+                 std::uint64_t count {};
+                 for (std::size_t i{}; i < selected; ++i) {
+                     count += data[m_selection[i]] == aggregate.value;
+                 }
+                 slot += count;
+                 break;
+             }
+             case AggregateKind::Sum: {
+                 std::uint64_t sum {};
+                 for (std::size_t i{}; i < selected; ++i) {
+                     std::uint64_t value { data[m_selection[i]] };
+                     sum += value == RoundQuery::kMissing ? 0 : value;
+                 }
+                 slot += sum;
+                 break;
+             }
+             case AggregateKind::Min:
+                 for (std::size_t i{}; i < selected; ++i) {
+                     slot = std::min(slot, data[m_selection[i]]);
+                 }
+                 break;
+             case AggregateKind::Max:
+                 for (std::size_t i{}; i < selected; ++i) {
+                     std::uint64_t value { data[m_selection[i]] };
+                     if (value != RoundQuery::kMissing) {
+                         slot = std::max(slot, value);
+                     }
+                 }
+                 break;
+             }
+         }
+     }
+ 
+ private:
+     const RoundQuery& m_query;
+     const Plan& m_plan;
+     const std::vector<InputFile>& m_files;
+     std::vector<std::unique_ptr<RoundColumnReader>> m_readers;
+ 
+     std::array<std::vector<std::uint64_t>, kRoundColumnCount> m_current {};
+     std::array<std::vector<std::uint64_t>, kRoundColumnCount> m_tail {};
+     std::size_t m_tailFile {~std::size_t{0}};
+     std::size_t m_tailBlock {~std::size_t{0}};
+     std::vector<std::vector<std::uint64_t>> m_lagged;
+     std::vector<const std::uint64_t*> m_data;
+     std::vector<std::uint32_t> m_selection {};
+     std::vector<Accumulator*> m_groups {};
+     GroupTable m_table {};
+ 
+     struct CacheEntry {
+         GroupKey key {};
+         Accumulator* group {nullptr};
+     };
+     static constexpr std::size_t kGroupCacheSize {64};
+     std::array<CacheEntry, kGroupCacheSize> m_groupCache {};
+ };
+ 
+ /**
+  * @brief A group key part: a value, or a name for name columns.
+  */
+ using KeyPart = std::pair<std::uint64_t, std::string>;
+ 
+ void MergeInto(Accumulator& target, const Accumulator& source, const RoundQuery& query) {
+     if (target.values.empty()) {
+         target = source;
+         return;
+     }
+     target.rows += source.rows;
+     for (std::size_t a{}; a < query.aggregates.size(); ++a) {
+         switch (query.aggregates[a].kind) {
+         case AggregateKind::Min:
+             target.values[a] = std::min(target.values[a], source.values[a]);
+             break;
+         case AggregateKind::Max:
+             target.values[a] = std::max(target.values[a], source.values[a]);
+             break;
+         default:
+             target.values[a] += source.values[a];
+             break;
+         }
+     }
+ }
+ 
+ } // namespace
+ 
+ QueryResult RoundQueryEngine::Run(const RoundQuery& query, const std::vector<std::string>& paths,
+                                   unsigned threads) {
+     const Plan plan { MakePlan(query) };
+ 
+     std::vector<InputFile> files(paths.size());
+     std::vector<std::pair<std::size_t, std::size_t>> work;
+     for (std::size_t f{}; f < paths.size(); ++f) {
+         InputFile& file { files[f] };
+         file.path = paths[f];
+         file.metadata = std::make_unique<RoundColumnReader>(paths[f]);
+         const std::vector<std::string>& names { file.metadata->Names() };
+         for (const QueryFilter& filter : query.filters) {
+             std::uint64_t value { filter.value };
+             if (IsNameColumn(filter.field.column)) {
+                 auto it = std::find(names.begin(), names.end(), filter.name);
+                 value = it == names.end() ? kAbsentName : static_cast<std::uint64_t>(it - names.begin());
+             }
+             file.filterValues.push_back(value);
+         }
+         for (std::size_t block{}; block < file.metadata->BlockCount(); ++block) {
+             work.emplace_back(f, block);
+         }
+     }
+ 
+     std::size_t workerCount { std::max<std::size_t>(1, std::min<std::size_t>(threads, work.size())) };
+     std::vector<std::unique_ptr<Worker>> workers;
+     for (std::size_t w{}; w < workerCount; ++w) {
+         workers.push_back(std::make_unique<Worker>(query, plan, files));
+     }
+ 
+     // Blocks are handed out in runs so lagged fields can reuse the previous block's tail.
+     constexpr std::size_t kBlocksPerGrab {4};
+     std::atomic<std::size_t> next {0};
+     std::vector<std::exception_ptr> errors(workerCount);
+     auto scan = [&](std::size_t w) {
+         try {
+             for (std::size_t first { next.fetch_add(kBlocksPerGrab) }; first < work.size();
+                  first = next.fetch_add(kBlocksPerGrab)) {
+                 std::size_t last { std::min(first + kBlocksPerGrab, work.size()) };
+                 for (std::size_t item { first }; item < last; ++item) {
+                     workers[w]->ProcessBlock(work[item].first, work[item].second);
+                 }
+             }
+         } catch (...) {
+             errors[w] = std::current_exception();
+         }
+     };
+ 
+     std::vector<std::thread> pool;
+     for (std::size_t w { 1 }; w < workerCount; ++w) {
+         pool.emplace_back(scan, w);
+     }
+     scan(0);
+     for (auto& thread : pool) {
+         thread.join();
+     }
+     for (const auto& error : errors) {
+         if (error) {
+             std::rethrow_exception(error);
+         }
+     }
+ 
+     QueryResult result {};
+     std::map<std::vector<KeyPart>, Accumulator> merged;
+     for (const auto& worker : workers) {
+         result.blocksScanned += worker->m_blocksScanned;
+         result.blocksPruned += worker->m_blocksPruned;
+         result.rowsScanned += worker->m_rowsScanned;
+         result.rowsMatched += worker->m_rowsMatched;
+ 
+         for (const auto& [key, accumulator] : worker->Table()) {
+             std::vector<KeyPart> parts;
+             for (std::size_t g{}; g < query.groupBy.size(); ++g) {
+                 std::uint64_t value { key.values[g] };
+                 if (IsNameColumn(query.groupBy[g].column) && value != RoundQuery::kMissing) {
+                     parts.emplace_back(0, files[key.file].metadata->Names().at(value));
+                 } else {
+                     parts.emplace_back(value, std::string{});
+                 }
+             }
+             MergeInto(merged[parts], accumulator, query);
+         }
+     }
+ 
+     for (const auto& [parts, accumulator] : merged) {
+         QueryRow row {};
+         for (std::size_t g{}; g < parts.size(); ++g) {
+             bool isName { IsNameColumn(query.groupBy[g].column) && parts[g].first != RoundQuery::kMissing };
+             row.keys.push_back(isName ? parts[g].second : RoundQuery::ValueText(query.groupBy[g].column, parts[g].first));
+         }
+         row.values = accumulator.values;
+         row.rows = accumulator.rows;
+         result.rows.push_back(std::move(row));
+     }
+     return result;
+ }
+ 
+ std::string RoundQueryEngine::Format(const RoundQuery& query, const QueryResult& result) {
+     std::vector<std::vector<std::string>> table;
+     std::vector<std::string> header;
+     for (const QueryField& field : query.groupBy) {
+         header.push_back(RoundQuery::FieldName(field));
+     }
+     for (const QueryAggregate& aggregate : query.aggregates) {
+         std::string field { RoundQuery::FieldName(aggregate.field) };
+         switch (aggregate.kind) {
+         case AggregateKind::Count:      header.push_back("count"); break;
+         case AggregateKind::Sum:        header.push_back("sum(" + field + ")"); break;
+         case AggregateKind::Min:        header.push_back("min(" + field + ")"); break;
+         case AggregateKind::Max:        header.push_back("max(" + field + ")"); break;
+         case AggregateKind::CountEqual:
+             header.push_back("rate(" + field + "=" + RoundQuery::ValueText(aggregate.field.column, aggregate.value) + ")");
+             break;
+         }
+     }
+     table.push_back(header);
+ 
+     for (const QueryRow& row : result.rows) {
+         std::vector<std::string> cells { row.keys };
+         for (std::size_t a{}; a < query.aggregates.size(); ++a) {
+             std::ostringstream cell;
+             AggregateKind kind { query.aggregates[a].kind };
+             if ((kind == AggregateKind::Min || kind == AggregateKind::Max) &&
+                 (row.values[a] == RoundQuery::kMissing || row.rows == 0)) {
+                 cell << "-";
+             } else if (kind == AggregateKind::CountEqual) {
+                 cell.setf(std::ios::fixed);
+                 cell.precision(2);
+                 cell << 100.0 * static_cast<double>(row.values[a]) / static_cast<double>(std::max<std::uint64_t>(row.rows, 1))
+                      << "%";
+             } else {
+                 cell << row.values[a];
+             }
+             cells.push_back(cell.str());
+         }
+         table.push_back(cells);
+     }
+ 
+     std::vector<std::size_t> widths(header.size());
+     for (const auto& cells : table) {
+         for (std::size_t c{}; c < cells.size(); ++c) {
+             widths[c] = std::max(widths[c], cells[c].size());
+         }
+     }
+ 
+     std::ostringstream out;
+     for (const auto& cells : table) {
+         for (std::size_t c{}; c < cells.size(); ++c) {
+             out << (c ? "  " : "") << std::string(widths[c] - cells[c].size(), ' ') << cells[c];
+         }
+         out << "\n";
+     }
+     out << result.rowsMatched << " of " << result.rowsScanned << " rows matched; "
+         << result.blocksScanned << " blocks scanned, " << result.blocksPruned << " pruned\n";
+     return out.str();
+ }
+ 
\ No newline at end of file
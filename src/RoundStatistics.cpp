@@ -0,0 +1,148 @@
+/**
+ * @file RoundStatistics.cpp
+ * @brief Implements the RoundStatistics class.
+ */
+
+ #include "RoundStatistics.hpp"
+ #include <algorithm>
+ #include <chrono>
+
+ namespace {
+ 
+ std::uint64_t SteadyNanos() {
+     return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count());
+ }
+ 
+ RoundResult UserResult(RoundOutcome outcome) {
+     switch (outcome) {
+     case RoundOutcome::UserWin:     return RoundResult::Win;
+     case RoundOutcome::ComputerWin: return RoundResult::Loss;
+     case RoundOutcome::Draw:        return RoundResult::Draw;
+     default:                        return RoundResult::Forfeit;
+     }
+ }
+ 
+ RoundResult ComputerResult(RoundOutcome outcome) {
+     switch (outcome) {
+     case RoundOutcome::UserWin:     return RoundResult::Loss;
+     case RoundOutcome::ComputerWin: return RoundResult::Win;
+     case RoundOutcome::Draw:        return RoundResult::Draw;
+     default:                        return RoundResult::Forfeit;
+     }
+ }
+ 
+ } // namespace
+ 
+ RoundStatistics::PlayerStatistics::PlayerStatistics(std::string playerName, const RoundStatisticsOptions& options)
+     : name{std::move(playerName)},
+       rounds{options.windowRounds},
+       time{options.windowNanos, options.windowBuckets},
+       winRate{options.decay},
+       latency{options.decay}
+ {
+ }
+ 
+ void RoundStatistics::PlayerStatistics::Add(RoundResult result, std::uint8_t move, std::uint64_t nowNanos) {
+     ++totals[static_cast<std::size_t>(result)];
+     rounds.Push(result, move);
+     if (rounds.Streak() > 0) {
+         longestWinStreak = std::max(longestWinStreak, static_cast<std::uint64_t>(rounds.Streak()));
+     }
+     time.Add(nowNanos, result);
+     if (result != RoundResult::Forfeit) {
+         winRate.Add(result == RoundResult::Win ? 1.0 : 0.0);
+     }
+ }
+ 
+ RoundStatistics::RoundStatistics(RoundStatisticsOptions options, Clock clock)
+     : m_options{options},
+       m_clock{clock ? std::move(clock) : Clock{SteadyNanos}}
+ {
+     // Build one set of aggregators up front so bad options fail here.
+     PlayerStatistics check{"", m_options};
+ }
+ 
+ void RoundStatistics::OnRound(const RoundRecord& record) {
+     std::uint64_t now { m_clock() };
+ 
+     PlayerStatistics& user { Statistics(record.userName) };
+     {
+         std::lock_guard<std::mutex> lock{user.mutex};
+         user.Add(UserResult(record.outcome), record.userMove, now);
+         if (record.decisionNanos != 0) {
+             user.latency.Add(static_cast<double>(record.decisionNanos));
+             user.latencyNanos.Add(record.decisionNanos);
+         }
+     }
+ 
+     PlayerStatistics& computer { Statistics(record.computerName) };
+     {
+         std::lock_guard<std::mutex> lock{computer.mutex};
+         computer.Add(ComputerResult(record.outcome), record.computerMove, now);
+     }
+ }
+ 
+ void RoundStatistics::OnSessionEnd(const SessionSummary& summary) {
+     for (std::string_view name : {summary.userName, summary.computerName}) {
+         PlayerStatistics& player { Statistics(name) };
+         std::lock_guard<std::mutex> lock{player.mutex};
+         player.sessionRounds.Add(summary.rounds);
+     }
+ }
+ 
+ std::optional<PlayerStatisticsSnapshot> RoundStatistics::Snapshot(std::string_view name) const {
+     const PlayerStatistics* player {nullptr};
+     {
+         std::shared_lock<std::shared_mutex> lock{m_namesMutex};
+         auto it = m_players.find(name);
+         if (it == m_players.end()) {
+             return std::nullopt;
+         }
+         player = it->second.get();
+     }
+     std::uint64_t now { m_clock() };
+ 
+     PlayerStatisticsSnapshot snapshot {};
+     std::lock_guard<std::mutex> lock{player->mutex};
+     snapshot.name = player->name;
+     snapshot.totals = player->totals;
+     snapshot.streak = player->rounds.Streak();
+     snapshot.longestWinStreak = player->longestWinStreak;
+     snapshot.recentRounds = player->rounds.Results();
+     snapshot.recentMoves = player->rounds.Moves();
+     snapshot.recentWinRate = player->rounds.WinRate();
+     snapshot.recentTime = player->time.Totals(now);
+     snapshot.decayedWinRate = player->winRate.Value();
+     snapshot.decayedLatencyNanos = player->latency.Value();
+     snapshot.latencyNanos = player->latencyNanos;
+     snapshot.sessionRounds = player->sessionRounds;
+     return snapshot;
+ }
+ 
+ std::vector<std::string> RoundStatistics::Names() const {
+     std::shared_lock<std::shared_mutex> lock{m_namesMutex};
+     return std::vector<std::string>(m_order.begin(), m_order.end());
+ }
+ 
+ RoundStatistics::PlayerStatistics& RoundStatistics::Statistics(std::string_view name) {
+     {
+         std::shared_lock<std::shared_mutex> lock{m_namesMutex};
+         auto it = m_players.find(name);
+         if (it != m_players.end()) {
+             return *it->second;
+         }
+     }
+ 
+     std::unique_lock<std::shared_mutex> lock{m_namesMutex};
+     auto it = m_players.find(name);
+     if (it == m_players.end()) {
+         // Entries are never removed, so references handed out stay valid.
+         auto player = std::make_unique<PlayerStatistics>(std::string{name}, m_options);
+         std::string_view key { player->name };
+         it = m_players.emplace(key, std::move(player)).first;
+         m_order.push_back(key);
+     }
+     return *it->second;
+ }
+ 
\ No newline at end of file
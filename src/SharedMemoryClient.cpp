@@ -0,0 +1,70 @@
+/**
+ * @file SharedMemoryClient.cpp
+ * @brief Implements the SharedMemoryClient class.
+ */
+
+ #include "SharedMemoryClient.hpp"
+ #include <deque>
+
+ SharedMemoryClient::SharedMemoryClient(std::shared_ptr<SharedMemorySegment> segment)
+     : m_segment{std::move(segment)}
+ {
+ }
+ 
+ SharedMemoryClient::~SharedMemoryClient() {
+     m_segment->ToServer().Close();
+ }
+ 
+ const ShmRing::Record* SharedMemoryClient::NextAnnouncement() {
+     return m_segment->ToClient().Peek();
+ }
+ 
+ void SharedMemoryClient::Consume() {
+     m_segment->ToClient().Pop();
+ }
+ 
+ bool SharedMemoryClient::SubmitMove(GameMove move) {
+     return m_segment->ToServer().Push(
+         ShmRing::Record{static_cast<std::int32_t>(ShmMessageType::Move), static_cast<std::int32_t>(move), 0, 0});
+ }
+ 
+ int SharedMemoryClient::Serve(IMoveStrategy& strategy) {
+     // Moves submitted whose round has not been announced yet.
+     std::deque<GameMove> unplayed;
+ 
+     while (const ShmRing::Record* record = NextAnnouncement()) {
+         auto type = static_cast<ShmMessageType>(record->type);
+         std::int32_t a { record->a };
+         std::int32_t b { record->b };
+         Consume();
+ 
+         switch (type) {
+             case ShmMessageType::MoveRequest:
+                 for (std::int32_t i{}; i < a; ++i) {
+                     GameMove move { strategy.NextMove() };
+                     unplayed.push_back(move);
+                     if (!SubmitMove(move)) {
+                         return 1;
+                     }
+                 }
+                 break;
+             case ShmMessageType::ChosenMove:
+                 if (a == kSideComputer && !unplayed.empty()) {
+                     strategy.ObserveRound(unplayed.front(), static_cast<GameMove>(b));
+                     unplayed.pop_front();
+                 }
+                 break;
+             case ShmMessageType::InvalidInput:
+                 if (!unplayed.empty()) {
+                     unplayed.pop_front();
+                 }
+                 break;
+             case ShmMessageType::FinalScore:
+                 return 0;
+             default:
+                 break;
+         }
+     }
+     return 1;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,114 @@
+/**
+ * @file SharedMemoryMessenger.cpp
+ * @brief Implements the SharedMemoryMessenger class.
+ */
+
+ #include "SharedMemoryMessenger.hpp"
+ #include <algorithm>
+
+ SharedMemoryMessenger::SharedMemoryMessenger(std::shared_ptr<SharedMemorySegment> segment,
+                                              std::string userName,
+                                              std::string computerName,
+                                              int rounds,
+                                              std::size_t maxBatch)
+     : m_segment{std::move(segment)},
+       m_userName{std::move(userName)},
+       m_computerName{std::move(computerName)},
+       m_rounds{rounds},
+       m_maxBatch{std::max<std::size_t>(maxBatch, 1)}
+ {
+ }
+ 
+ SharedMemoryMessenger::~SharedMemoryMessenger() {
+     m_segment->ToClient().Close();
+ }
+ 
+ void SharedMemoryMessenger::SetParticipants(std::shared_ptr<IPlayer> userPlayer,
+                                             std::shared_ptr<IPlayer> computerPlayer) {
+     m_userPlayer = std::move(userPlayer);
+     m_computerPlayer = std::move(computerPlayer);
+ }
+ 
+ void SharedMemoryMessenger::ShowWelcomeScreen() {
+     Send(ShmMessageType::Welcome);
+ }
+ 
+ std::string SharedMemoryMessenger::RequestUserPlayerName() {
+     return m_userName;
+ }
+ 
+ std::string SharedMemoryMessenger::RequestComputerPlayerName() {
+     return m_computerName;
+ }
+ 
+ int SharedMemoryMessenger::RequestNumberOfRounds() {
+     return m_rounds;
+ }
+ 
+ void SharedMemoryMessenger::ShowSetupComplete() {
+     Send(ShmMessageType::SetupComplete);
+ }
+ 
+ int SharedMemoryMessenger::RequestMoveChoice() {
+     int move {-1};
+     return RequestMoveChoices(&move, 1) == 1 ? move : -1;
+ }
+ 
+ std::size_t SharedMemoryMessenger::RequestMoveChoices(int* moves, std::size_t maxCount) {
+     std::size_t wanted { std::min(maxCount, m_maxBatch) };
+     if (wanted == 0) {
+         return 0;
+     }
+     Send(ShmMessageType::MoveRequest, static_cast<std::int32_t>(wanted));
+ 
+     ShmRing& replies { m_segment->ToServer() };
+     std::size_t count {};
+     while (count < wanted) {
+         // Read in place; the slot is released as soon as the move is copied out.
+         const ShmRing::Record* record { replies.Peek() };
+         if (!record) {
+             break;
+         }
+         if (record->type == static_cast<std::int32_t>(ShmMessageType::Move)) {
+             moves[count++] = record->a;
+         }
+         replies.Pop();
+     }
+     return count;
+ }
+ 
+ void SharedMemoryMessenger::DisplayChosenMove(const std::shared_ptr<IPlayer>& player, GameMove move) {
+     Send(ShmMessageType::ChosenMove, SideOf(player), static_cast<std::int32_t>(move));
+ }
+ 
+ void SharedMemoryMessenger::AnnounceRoundWinner(const std::shared_ptr<IPlayer>& winner) {
+     Send(ShmMessageType::RoundWinner, SideOf(winner));
+ }
+ 
+ void SharedMemoryMessenger::AnnounceDraw() {
+     Send(ShmMessageType::Draw);
+ }
+ 
+ void SharedMemoryMessenger::ShowFinalScore(const std::shared_ptr<IPlayer>& userPlayer,
+                                            const std::shared_ptr<IPlayer>& computerPlayer) {
+     Send(ShmMessageType::FinalScore, userPlayer->GetScore(), computerPlayer->GetScore());
+ }
+ 
+ void SharedMemoryMessenger::ShowInvalidInputMessage() {
+     Send(ShmMessageType::InvalidInput);
+ }
+ 
+ void SharedMemoryMessenger::Send(ShmMessageType type, std::int32_t a, std::int32_t b) {
+     m_segment->ToClient().Push(ShmRing::Record{static_cast<std::int32_t>(type), a, b, 0});
+ }
+ 
+ std::int32_t SharedMemoryMessenger::SideOf(const std::shared_ptr<IPlayer>& player) const {
+     if (player && player == m_userPlayer) {
+         return kSideUser;
+     }
+     if (player && player == m_computerPlayer) {
+         return kSideComputer;
+     }
+     return kSideUnknown;
+ }
+ 
\ No newline at end of file
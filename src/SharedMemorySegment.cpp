@@ -0,0 +1,113 @@
+/**
+ * @file SharedMemorySegment.cpp
+ * @brief Implements the SharedMemorySegment class.
+ */
+
+ #include "SharedMemorySegment.hpp"
+ #include <cerrno>
+ #include <fcntl.h>
+ #include <new>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <system_error>
+ #include <unistd.h>
+
+ /**
+  * @brief The contents of the shared-memory object.
+  */
+ struct SharedMemorySegment::Region {
+     static constexpr std::uint32_t kMagic {0x52505331}; // "RPS1"
+ 
+     std::atomic<std::uint32_t> magic {};
+     ShmRing::Layout toClient {};
+     ShmRing::Layout toServer {};
+ };
+ 
+ std::shared_ptr<SharedMemorySegment> SharedMemorySegment::Create(const std::string& name) {
+     int fd { ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600) };
+     if (fd < 0) {
+         throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+     }
+     if (::ftruncate(fd, sizeof(Region)) != 0) {
+         int error { errno };
+         ::close(fd);
+         ::shm_unlink(name.c_str());
+         throw std::system_error(error, std::generic_category(), "ftruncate " + name);
+     }
+ 
+     Region* region {};
+     try {
+         region = ::new (static_cast<void*>(Map(fd))) Region{};
+     } catch (...) {
+         ::shm_unlink(name.c_str());
+         throw;
+     }
+     // Published last, so Open() never sees half-initialized rings.
+     region->magic.store(Region::kMagic, std::memory_order_release);
+ 
+     return std::shared_ptr<SharedMemorySegment>(new SharedMemorySegment{name, region, true});
+ }
+ 
+ std::shared_ptr<SharedMemorySegment> SharedMemorySegment::Open(const std::string& name) {
+     int fd { ::shm_open(name.c_str(), O_RDWR, 0) };
+     if (fd < 0) {
+         throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+     }
+     struct stat info {};
+     if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Region)) {
+         ::close(fd);
+         throw std::system_error(EINVAL, std::generic_category(), "not a game segment: " + name);
+     }
+ 
+     Region* region { Map(fd) };
+     if (region->magic.load(std::memory_order_acquire) != Region::kMagic) {
+         ::munmap(region, sizeof(Region));
+         throw std::system_error(EINVAL, std::generic_category(), "not a game segment: " + name);
+     }
+     return std::shared_ptr<SharedMemorySegment>(new SharedMemorySegment{name, region, false});
+ }
+ 
+ SharedMemorySegment::SharedMemorySegment(std::string name, Region* region, bool owner)
+     : m_name{std::move(name)},
+       m_region{region},
+       m_owner{owner},
+       m_toClient{&region->toClient},
+       m_toServer{&region->toServer}
+ {
+ }
+ 
+ SharedMemorySegment::~SharedMemorySegment() {
+     Unlink();
+     ::munmap(m_region, sizeof(Region));
+ }
+ 
+ void SharedMemorySegment::Unlink() {
+     if (m_owner) {
+         ::shm_unlink(m_name.c_str());
+         m_owner = false;
+     }
+ }
+ 
+ const std::string& SharedMemorySegment::Name() const {
+     return m_name;
+ }
+ 
+ ShmRing& SharedMemorySegment::ToClient() {
+     return m_toClient;
+ }
+ 
+ ShmRing& SharedMemorySegment::ToServer() {
+     return m_toServer;
+ }
+ 
+ SharedMemorySegment::Region* SharedMemorySegment::Map(int fd) {
+     void* memory { ::mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) };
+     int error { errno };
+     // The mapping keeps the object alive; the descriptor is no longer needed.
+     ::close(fd);
+     if (memory == MAP_FAILED) {
+         throw std::system_error(error, std::generic_category(), "mmap");
+     }
+     return static_cast<Region*>(memory);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,146 @@
+/**
+ * @file ShmRing.cpp
+ * @brief Implements the ShmRing class.
+ */
+
+ #include "ShmRing.hpp"
+ #include <climits>
+ #include <linux/futex.h>
+ #include <new>
+ #include <sys/syscall.h>
+ #include <thread>
+ #include <unistd.h>
+
+ namespace {
+ 
+ static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "futex words must be lock-free");
+ static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex words must be 32-bit");
+ 
+ constexpr std::uint32_t kIndexMask {ShmRing::kCapacity - 1};
+ static_assert((ShmRing::kCapacity & kIndexMask) == 0, "capacity must be a power of two");
+ 
+ // The futexes are shared between processes, so FUTEX_PRIVATE_FLAG must not be used.
+ void FutexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected)
+ {
+     ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+ }
+ 
+ void FutexWakeAll(std::atomic<std::uint32_t>& word)
+ {
+     ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+ }
+ 
+ } // namespace
+ 
+ ShmRing::ShmRing(Layout* layout, int spinCount)
+     : m_layout{layout}, m_spinCount{spinCount}
+ {
+ }
+ 
+ void ShmRing::Initialize(void* memory) {
+     ::new (memory) Layout{};
+ }
+ 
+ bool ShmRing::TryPush(const Record& record) {
+     std::uint32_t head { m_layout->head.load(std::memory_order_relaxed) };
+     if (m_layout->closed.load(std::memory_order_acquire) ||
+         head - m_layout->tail.load(std::memory_order_acquire) == kCapacity) {
+         return false;
+     }
+     m_layout->records[head & kIndexMask] = record;
+     // Sequentially consistent so it cannot pass the load of consumerWaiting below.
+     m_layout->head.store(head + 1, std::memory_order_seq_cst);
+     WakeIfWaiting(m_layout->head, m_layout->consumerWaiting);
+     return true;
+ }
+ 
+ bool ShmRing::Push(const Record& record) {
+     while (!TryPush(record)) {
+         if (m_layout->closed.load(std::memory_order_acquire)) {
+             return false;
+         }
+         std::uint32_t tail { m_layout->tail.load(std::memory_order_acquire) };
+         if (m_layout->head.load(std::memory_order_relaxed) - tail == kCapacity) {
+             AwaitChange(m_layout->tail, tail, m_layout->producerWaiting);
+         }
+     }
+     return true;
+ }
+ 
+ const ShmRing::Record* ShmRing::TryPeek() const {
+     std::uint32_t tail { m_layout->tail.load(std::memory_order_relaxed) };
+     if (m_layout->head.load(std::memory_order_acquire) == tail) {
+         return nullptr;
+     }
+     return &m_layout->records[tail & kIndexMask];
+ }
+ 
+ const ShmRing::Record* ShmRing::Peek() {
+     while (true) {
+         if (const Record* record = TryPeek()) {
+             return record;
+         }
+         if (m_layout->closed.load(std::memory_order_acquire)) {
+             // A record pushed just before Close() must still be seen.
+             return TryPeek();
+         }
+         AwaitChange(m_layout->head, m_layout->tail.load(std::memory_order_relaxed), m_layout->consumerWaiting);
+     }
+ }
+ 
+ void ShmRing::Pop() {
+     std::uint32_t tail { m_layout->tail.load(std::memory_order_relaxed) };
+     m_layout->tail.store(tail + 1, std::memory_order_seq_cst);
+     WakeIfWaiting(m_layout->tail, m_layout->producerWaiting);
+ }
+ 
+ void ShmRing::Close() {
+     m_layout->closed.store(1, std::memory_order_seq_cst);
+     FutexWakeAll(m_layout->head);
+     FutexWakeAll(m_layout->tail);
+     m_syscalls += 2;
+ }
+ 
+ bool ShmRing::IsClosed() const {
+     return m_layout->closed.load(std::memory_order_acquire) != 0;
+ }
+ 
+ std::size_t ShmRing::SyscallCount() const {
+     return m_syscalls;
+ }
+ 
+ void ShmRing::AwaitChange(std::atomic<std::uint32_t>& word, std::uint32_t observed,
+                           std::atomic<std::uint32_t>& waitingFlag) {
+     for (int spin{}; spin < m_spinCount; ++spin) {
+         if (word.load(std::memory_order_acquire) != observed ||
+             m_layout->closed.load(std::memory_order_acquire)) {
+             return;
+         }
+         if (spin % 16 == 15) {
+             // Let the peer run if it shares our CPU.
+             std::this_thread::yield();
+             ++m_syscalls;
+         }
+     }
+ 
+     // Announce the sleep, then re-check: the peer either sees the flag and
+     // wakes us, or we see its update here. FUTEX_WAIT itself also returns
+     // at once if the word changed in between.
+     waitingFlag.store(1, std::memory_order_seq_cst);
+     if (word.load(std::memory_order_seq_cst) == observed &&
+         !m_layout->closed.load(std::memory_order_seq_cst)) {
+         FutexWait(word, observed);
+         ++m_syscalls;
+     }
+     waitingFlag.store(0, std::memory_order_relaxed);
+ }
+ 
+ void ShmRing::WakeIfWaiting(std::atomic<std::uint32_t>& word, std::atomic<std::uint32_t>& waitingFlag) {
+     // Only the waiter clears its flag: clearing it here could erase a
+     // newer announcement made after the peer woke and went back to sleep.
+     if (waitingFlag.load(std::memory_order_seq_cst)) {
+         FutexWakeAll(word);
+         ++m_syscalls;
+     }
+ }
+ 
\ No newline at end of file
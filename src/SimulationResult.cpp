@@ -0,0 +1,413 @@
+/**
+ * @file SimulationResult.cpp
+ * @brief Implements SimulationConfig and SimulationResult.
+ */
+
+ #include "SimulationResult.hpp"
+ #include "GameRules.hpp"
+ #include <algorithm>
+ #include <cmath>
+ #include <exception>
+ #include <fstream>
+ #include <iterator>
+ #include <stdexcept>
+ #include <thread>
+
+ namespace {
+ 
+ constexpr std::uint32_t kFileMagic {0x4D495352}; // "RSIM" little-endian
+ constexpr std::uint32_t kFileVersion {1};
+ 
+ /**
+  * @brief Elo K-factor applied to every simulated match.
+  */
+ constexpr double kRatingK {32.0};
+ 
+ void PutU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+     for (int i{}; i < 4; ++i) {
+         out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+     }
+ }
+ 
+ void PutU64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+     for (int i{}; i < 8; ++i) {
+         out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+     }
+ }
+ 
+ void PutString(std::vector<std::uint8_t>& out, const std::string& value) {
+     PutU32(out, static_cast<std::uint32_t>(value.size()));
+     out.insert(out.end(), value.begin(), value.end());
+ }
+ 
+ /**
+  * @brief Bounds-checked little-endian reader over a byte buffer.
+  */
+ class Reader {
+ public:
+     explicit Reader(const std::vector<std::uint8_t>& bytes)
+         : m_bytes{bytes}
+     {
+     }
+ 
+     std::uint64_t Get(int size) {
+         Require(static_cast<std::size_t>(size));
+         std::uint64_t value {};
+         for (int i{}; i < size; ++i) {
+             value |= static_cast<std::uint64_t>(m_bytes[m_offset++]) << (8 * i);
+         }
+         return value;
+     }
+ 
+     std::uint32_t U32() { return static_cast<std::uint32_t>(Get(4)); }
+     std::uint64_t U64() { return Get(8); }
+ 
+     std::string String() {
+         std::size_t size { U32() };
+         Require(size);
+         std::string value(m_bytes.begin() + static_cast<std::ptrdiff_t>(m_offset),
+                           m_bytes.begin() + static_cast<std::ptrdiff_t>(m_offset + size));
+         m_offset += size;
+         return value;
+     }
+ 
+     bool AtEnd() const { return m_offset == m_bytes.size(); }
+ 
+ private:
+     void Require(std::size_t size) const {
+         if (m_bytes.size() - m_offset < size) {
+             throw std::runtime_error("Truncated simulation result");
+         }
+     }
+ 
+ private:
+     const std::vector<std::uint8_t>& m_bytes;
+     std::size_t m_offset {};
+ };
+ 
+ } // namespace
+ 
+ bool SimulationConfig::operator==(const SimulationConfig& other) const {
+     return masterSeed == other.masterSeed && totalMatches == other.totalMatches &&
+            roundsPerMatch == other.roundsPerMatch && userStrategy == other.userStrategy &&
+            computerStrategy == other.computerStrategy && userRating == other.userRating &&
+            computerRating == other.computerRating;
+ }
+ 
+ bool SimulationConfig::operator!=(const SimulationConfig& other) const {
+     return !(*this == other);
+ }
+ 
+ SimulationResult::SimulationResult(SimulationConfig config, std::uint64_t begin, std::uint64_t end)
+     : m_config{std::move(config)}
+ {
+     if (begin > end || end > m_config.totalMatches) {
+         throw std::invalid_argument("Match range outside the campaign");
+     }
+     if (begin < end) {
+         m_coverage.emplace_back(begin, end);
+     }
+ }
+ 
+ void SimulationResult::AddMatch(const std::array<std::array<std::uint64_t, 3>, 3>& moveCounts) {
+     std::uint64_t userWins {};
+     std::uint64_t computerWins {};
+     std::uint64_t draws {};
+     for (std::size_t user{}; user < 3; ++user) {
+         for (std::size_t computer{}; computer < 3; ++computer) {
+             std::uint64_t count { moveCounts[user][computer] };
+             m_moveCounts[user][computer] += count;
+             GameMove userMove { static_cast<GameMove>(user + 1) };
+             GameMove computerMove { static_cast<GameMove>(computer + 1) };
+             if (IsRoundDraw(userMove, computerMove)) {
+                 draws += count;
+             } else if (DoesFirstMoveWin(userMove, computerMove)) {
+                 userWins += count;
+             } else {
+                 computerWins += count;
+             }
+         }
+     }
+ 
+     std::uint64_t rounds { userWins + computerWins + draws };
+     ++m_matches;
+     m_rounds += rounds;
+     m_userRoundWins += userWins;
+     m_computerRoundWins += computerWins;
+     m_drawnRounds += draws;
+ 
+     int userResult { userWins > computerWins ? 2 : userWins == computerWins ? 1 : 0 };
+     m_userMatchWins += userResult == 2;
+     m_drawnMatches += userResult == 1;
+     m_computerMatchWins += userResult == 0;
+     m_userRatingDeltaMilli += RatingDeltaMilli(userResult);
+ 
+     std::size_t bucket { kMarginBuckets / 2 };
+     if (rounds > 0) {
+         std::uint64_t shifted { userWins + rounds - computerWins };
+         bucket = static_cast<std::size_t>(shifted * (kMarginBuckets - 1) / (2 * rounds));
+     }
+     ++m_marginHistogram[bucket];
+ }
+ 
+ void SimulationResult::Merge(const SimulationResult& other) {
+     if (m_config != other.m_config) {
+         throw std::invalid_argument("Cannot merge results of different simulation campaigns");
+     }
+ 
+     std::vector<std::pair<std::uint64_t, std::uint64_t>> coverage;
+     coverage.reserve(m_coverage.size() + other.m_coverage.size());
+     std::merge(m_coverage.begin(), m_coverage.end(),
+                other.m_coverage.begin(), other.m_coverage.end(),
+                std::back_inserter(coverage));
+ 
+     std::vector<std::pair<std::uint64_t, std::uint64_t>> coalesced;
+     for (const auto& range : coverage) {
+         if (!coalesced.empty() && range.first < coalesced.back().second) {
+             throw std::invalid_argument("Simulation results cover overlapping matches");
+         }
+         if (!coalesced.empty() && range.first == coalesced.back().second) {
+             coalesced.back().second = range.second;
+         } else {
+             coalesced.push_back(range);
+         }
+     }
+     m_coverage = std::move(coalesced);
+ 
+     m_matches += other.m_matches;
+     m_rounds += other.m_rounds;
+     m_userRoundWins += other.m_userRoundWins;
+     m_computerRoundWins += other.m_computerRoundWins;
+     m_drawnRounds += other.m_drawnRounds;
+     m_userMatchWins += other.m_userMatchWins;
+     m_computerMatchWins += other.m_computerMatchWins;
+     m_drawnMatches += other.m_drawnMatches;
+     m_userRatingDeltaMilli += other.m_userRatingDeltaMilli;
+     for (std::size_t user{}; user < 3; ++user) {
+         for (std::size_t computer{}; computer < 3; ++computer) {
+             m_moveCounts[user][computer] += other.m_moveCounts[user][computer];
+         }
+     }
+     for (std::size_t bucket{}; bucket < kMarginBuckets; ++bucket) {
+         m_marginHistogram[bucket] += other.m_marginHistogram[bucket];
+     }
+ }
+ 
+ SimulationResult SimulationResult::MergeFiles(const std::vector<std::string>& paths, unsigned threads) {
+     if (paths.empty()) {
+         throw std::invalid_argument("No simulation results to merge");
+     }
+ 
+     std::size_t slices { std::min<std::size_t>(std::max(threads, 1u), paths.size()) };
+     std::vector<SimulationResult> partials(slices);
+     std::vector<std::exception_ptr> errors(slices);
+ 
+     auto mergeSlice = [&](std::size_t slice) {
+         try {
+             std::size_t begin { paths.size() * slice / slices };
+             std::size_t end { paths.size() * (slice + 1) / slices };
+             partials[slice] = Load(paths[begin]);
+             for (std::size_t i { begin + 1 }; i < end; ++i) {
+                 partials[slice].Merge(Load(paths[i]));
+             }
+         } catch (...) {
+             errors[slice] = std::current_exception();
+         }
+     };
+ 
+     std::vector<std::thread> workers;
+     for (std::size_t slice { 1 }; slice < slices; ++slice) {
+         workers.emplace_back(mergeSlice, slice);
+     }
+     mergeSlice(0);
+     for (auto& worker : workers) {
+         worker.join();
+     }
+ 
+     for (const auto& error : errors) {
+         if (error) {
+             std::rethrow_exception(error);
+         }
+     }
+     for (std::size_t slice { 1 }; slice < slices; ++slice) {
+         partials[0].Merge(partials[slice]);
+     }
+     return std::move(partials[0]);
+ }
+ 
+ std::vector<std::uint8_t> SimulationResult::Serialize() const {
+     std::vector<std::uint8_t> out;
+     PutU32(out, kFileMagic);
+     PutU32(out, kFileVersion);
+ 
+     PutU64(out, m_config.masterSeed);
+     PutU64(out, m_config.totalMatches);
+     PutU32(out, m_config.roundsPerMatch);
+     PutString(out, m_config.userStrategy);
+     PutString(out, m_config.computerStrategy);
+     PutU32(out, static_cast<std::uint32_t>(m_config.userRating));
+     PutU32(out, static_cast<std::uint32_t>(m_config.computerRating));
+ 
+     PutU32(out, static_cast<std::uint32_t>(m_coverage.size()));
+     for (const auto& range : m_coverage) {
+         PutU64(out, range.first);
+         PutU64(out, range.second);
+     }
+ 
+     for (std::uint64_t counter : {m_matches, m_rounds, m_userRoundWins, m_computerRoundWins,
+                                   m_drawnRounds, m_userMatchWins, m_computerMatchWins, m_drawnMatches}) {
+         PutU64(out, counter);
+     }
+     PutU64(out, static_cast<std::uint64_t>(m_userRatingDeltaMilli));
+     for (const auto& row : m_moveCounts) {
+         for (std::uint64_t count : row) {
+             PutU64(out, count);
+         }
+     }
+     for (std::uint64_t count : m_marginHistogram) {
+         PutU64(out, count);
+     }
+     return out;
+ }
+ 
+ SimulationResult SimulationResult::Deserialize(const std::vector<std::uint8_t>& bytes) {
+     Reader reader{bytes};
+     if (reader.U32() != kFileMagic || reader.U32() != kFileVersion) {
+         throw std::runtime_error("Not a simulation result");
+     }
+ 
+     SimulationResult result;
+     result.m_config.masterSeed = reader.U64();
+     result.m_config.totalMatches = reader.U64();
+     result.m_config.roundsPerMatch = reader.U32();
+     result.m_config.userStrategy = reader.String();
+     result.m_config.computerStrategy = reader.String();
+     result.m_config.userRating = static_cast<std::int32_t>(reader.U32());
+     result.m_config.computerRating = static_cast<std::int32_t>(reader.U32());
+ 
+     std::uint32_t ranges { reader.U32() };
+     for (std::uint32_t i{}; i < ranges; ++i) {
+         std::uint64_t begin { reader.U64() };
+         std::uint64_t end { reader.U64() };
+         if (begin >= end || end > result.m_config.totalMatches ||
+             (!result.m_coverage.empty() && begin <= result.m_coverage.back().second)) {
+             throw std::runtime_error("Corrupt simulation result coverage");
+         }
+         result.m_coverage.emplace_back(begin, end);
+     }
+ 
+     for (std::uint64_t* counter : {&result.m_matches, &result.m_rounds, &result.m_userRoundWins,
+                                    &result.m_computerRoundWins, &result.m_drawnRounds,
+                                    &result.m_userMatchWins, &result.m_computerMatchWins,
+                                    &result.m_drawnMatches}) {
+         *counter = reader.U64();
+     }
+     result.m_userRatingDeltaMilli = static_cast<std::int64_t>(reader.U64());
+     for (auto& row : result.m_moveCounts) {
+         for (std::uint64_t& count : row) {
+             count = reader.U64();
+         }
+     }
+     for (std::uint64_t& count : result.m_marginHistogram) {
+         count = reader.U64();
+     }
+     if (!reader.AtEnd()) {
+         throw std::runtime_error("Trailing bytes after simulation result");
+     }
+     return result;
+ }
+ 
+ void SimulationResult::Save(const std::string& path) const {
+     std::vector<std::uint8_t> bytes { Serialize() };
+     std::ofstream file{path, std::ios::binary | std::ios::trunc};
+     file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+     if (!file) {
+         throw std::runtime_error("Cannot write simulation result: " + path);
+     }
+ }
+ 
+ SimulationResult SimulationResult::Load(const std::string& path) {
+     std::ifstream file{path, std::ios::binary};
+     if (!file) {
+         throw std::runtime_error("Cannot read simulation result: " + path);
+     }
+     std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+     return Deserialize(bytes);
+ }
+ 
+ const SimulationConfig& SimulationResult::Config() const {
+     return m_config;
+ }
+ 
+ const std::vector<std::pair<std::uint64_t, std::uint64_t>>& SimulationResult::Coverage() const {
+     return m_coverage;
+ }
+ 
+ bool SimulationResult::IsComplete() const {
+     if (m_config.totalMatches == 0) {
+         return true;
+     }
+     return m_coverage.size() == 1 && m_coverage.front().first == 0 &&
+            m_coverage.front().second == m_config.totalMatches;
+ }
+ 
+ std::uint64_t SimulationResult::Matches() const {
+     return m_matches;
+ }
+ 
+ std::uint64_t SimulationResult::Rounds() const {
+     return m_rounds;
+ }
+ 
+ std::uint64_t SimulationResult::UserRoundWins() const {
+     return m_userRoundWins;
+ }
+ 
+ std::uint64_t SimulationResult::ComputerRoundWins() const {
+     return m_computerRoundWins;
+ }
+ 
+ std::uint64_t SimulationResult::DrawnRounds() const {
+     return m_drawnRounds;
+ }
+ 
+ std::uint64_t SimulationResult::UserMatchWins() const {
+     return m_userMatchWins;
+ }
+ 
+ std::uint64_t SimulationResult::ComputerMatchWins() const {
+     return m_computerMatchWins;
+ }
+ 
+ std::uint64_t SimulationResult::DrawnMatches() const {
+     return m_drawnMatches;
+ }
+ 
+ std::int64_t SimulationResult::UserRatingDeltaMilli() const {
+     return m_userRatingDeltaMilli;
+ }
+ 
+ const std::array<std::array<std::uint64_t, 3>, 3>& SimulationResult::MoveCounts() const {
+     return m_moveCounts;
+ }
+ 
+ const std::array<std::uint64_t, SimulationResult::kMarginBuckets>& SimulationResult::MarginHistogram() const {
+     return m_marginHistogram;
+ }
+ 
+ bool SimulationResult::operator==(const SimulationResult& other) const {
+     return Serialize() == other.Serialize();
+ }
+ 
+ bool SimulationResult::operator!=(const SimulationResult& other) const {
+     return !(*this == other);
+ }
+ 
+ std::int64_t SimulationResult::RatingDeltaMilli(int userResult) const {
+     // Every match starts from the configured ratings, so the change is
+     // one of three constants; rounding it keeps the sum an exact integer.
+     double expected { 1.0 / (1.0 + std::pow(10.0, (m_config.computerRating - m_config.userRating) / 400.0)) };
+     double score { userResult / 2.0 };
+     return std::llround(1000.0 * kRatingK * (score - expected));
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,103 @@
+/**
+ * @file SimulationRunner.cpp
+ * @brief Implements the SimulationRunner class.
+ */
+
+ #include "SimulationRunner.hpp"
+ #include "GameRules.hpp"
+ #include "MoveStrategies.hpp"
+ #include "Xoshiro256.hpp"
+ #include <algorithm>
+ #include <memory>
+ #include <stdexcept>
+
+ namespace {
+ 
+ /**
+  * @brief Builds one side's strategy for a match from that side's own stream.
+  */
+ std::unique_ptr<IMoveStrategy> MakeSideStrategy(const std::string& name, std::uint64_t masterSeed,
+                                                 std::uint64_t match, std::uint64_t side) {
+     Xoshiro256 stream { Xoshiro256::ForStream(masterSeed, match * 2 + side) };
+     return MakeMoveStrategy(name, stream());
+ }
+ 
+ } // namespace
+ 
+ SimulationRunner::SimulationRunner(SimulationConfig config)
+     : m_config{std::move(config)}
+ {
+     if (!MakeMoveStrategy(m_config.userStrategy, 0)) {
+         throw std::invalid_argument("Unknown strategy: " + m_config.userStrategy);
+     }
+     if (!MakeMoveStrategy(m_config.computerStrategy, 0)) {
+         throw std::invalid_argument("Unknown strategy: " + m_config.computerStrategy);
+     }
+ }
+ 
+ std::pair<std::uint64_t, std::uint64_t> SimulationRunner::ShardRange(std::uint64_t totalMatches,
+                                                                      std::uint64_t index,
+                                                                      std::uint64_t count) {
+     if (index >= count) {
+         throw std::invalid_argument("Shard index must be below the shard count");
+     }
+     std::uint64_t base { totalMatches / count };
+     std::uint64_t extra { totalMatches % count };
+     std::uint64_t begin { index * base + std::min(index, extra) };
+     return {begin, begin + base + (index < extra ? 1 : 0)};
+ }
+ 
+ SimulationResult SimulationRunner::RunShard(std::uint64_t index, std::uint64_t count,
+                                             IRoundObserver* observer) const {
+     auto range = ShardRange(m_config.totalMatches, index, count);
+     return RunRange(range.first, range.second, observer);
+ }
+ 
+ SimulationResult SimulationRunner::RunRange(std::uint64_t begin, std::uint64_t end,
+                                             IRoundObserver* observer) const {
+     SimulationResult result{m_config, begin, end};
+ 
+     for (std::uint64_t match { begin }; match < end; ++match) {
+         std::array<std::array<std::uint64_t, 3>, 3> moveCounts {};
+         PlayMatch(match, moveCounts, observer);
+         result.AddMatch(moveCounts);
+     }
+     return result;
+ }
+ 
+ void SimulationRunner::PlayMatch(std::uint64_t match, std::array<std::array<std::uint64_t, 3>, 3>& moveCounts,
+                                  IRoundObserver* observer) const {
+     auto user = MakeSideStrategy(m_config.userStrategy, m_config.masterSeed, match, 0);
+     auto computer = MakeSideStrategy(m_config.computerStrategy, m_config.masterSeed, match, 1);
+ 
+     for (std::uint32_t round{}; round < m_config.roundsPerMatch; ++round) {
+         GameMove userMove { user->NextMove() };
+         GameMove computerMove { computer->NextMove() };
+         ++moveCounts[static_cast<std::size_t>(userMove) - 1][static_cast<std::size_t>(computerMove) - 1];
+         user->ObserveRound(userMove, computerMove);
+         computer->ObserveRound(computerMove, userMove);
+ 
+         if (observer) {
+             RoundRecord record {};
+             record.sessionId = match;
+             record.round = round + 1;
+             record.userMove = static_cast<std::uint8_t>(userMove);
+             record.computerMove = static_cast<std::uint8_t>(computerMove);
+             record.outcome = IsRoundDraw(userMove, computerMove)      ? RoundOutcome::Draw :
+                              DoesFirstMoveWin(userMove, computerMove) ? RoundOutcome::UserWin :
+                                                                         RoundOutcome::ComputerWin;
+             record.userName = m_config.userStrategy;
+             record.computerName = m_config.computerStrategy;
+             observer->OnRound(record);
+         }
+     }
+     if (observer) {
+         SessionSummary summary {};
+         summary.sessionId = match;
+         summary.rounds = m_config.roundsPerMatch;
+         summary.userName = m_config.userStrategy;
+         summary.computerName = m_config.computerStrategy;
+         observer->OnSessionEnd(summary);
+     }
+ }
+ 
\ No newline at end of file
@@ -4,42 +4,93 @@
  */
 
  #include "SinglePlayerRpsGame.hpp"
+ #include <algorithm>
+ #include <chrono>
 
  SinglePlayerRpsGame::SinglePlayerRpsGame(std::shared_ptr<IPlayer> userPlayer,
                                           std::shared_ptr<IPlayer> computerPlayer,
                                           std::unique_ptr<IGameMessenger> messenger,
                                           int numberOfRounds,
-                                          std::function<int()> randomGenerator)
+                                          std::function<int()> randomGenerator,
+                                          MatchRules rules)
      : m_userPlayer{userPlayer},
        m_computerPlayer{computerPlayer},
        m_messenger{std::move(messenger)},
        m_numberOfRounds{numberOfRounds},
-       m_randomGenerator{std::move(randomGenerator)}
+       m_randomGenerator{std::move(randomGenerator)},
+       m_rules{rules}
  {
      m_playersByType[ParticipantType::User]      = m_userPlayer;
      m_playersByType[ParticipantType::Computer]  = m_computerPlayer;
  }
  
  void SinglePlayerRpsGame::Play() {
-     for (int i{}; i < m_numberOfRounds; ++i) {
-         auto [isValidMove, userMove, computerMove] = ObtainMoves();
- 
-         if (!isValidMove) {
-             m_messenger->ShowInvalidInputMessage();
-         } else {
-             DisplayRoundMoves(userMove, computerMove);
-             ParticipantType winnerType = DetermineRoundOutcome(userMove, computerMove);
-             ProcessRoundResult(winnerType);
-         }
+     while (!IsFinished()) {
+         PlayRound();
      }
  
      // After all rounds, show final score
+     Finish();
+ }
+ 
+ void SinglePlayerRpsGame::PlayRound() {
+     std::chrono::steady_clock::time_point begin {};
+     if (m_roundObserver) {
+         begin = std::chrono::steady_clock::now();
+     }
+     auto [isValidMove, userMove, computerMove] = ObtainMoves(
+         RoundsBeforeDecision(m_rules, m_userWins, m_computerWins, m_numberOfRounds - m_roundsPlayed));
+     std::uint64_t decisionNanos {};
+     if (m_roundObserver) {
+         decisionNanos = static_cast<std::uint64_t>(
+             std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+     }
+     ++m_roundsPlayed;
+ 
+     ParticipantType winnerType {ParticipantType::NoOne};
+     if (!isValidMove) {
+         m_messenger->ShowInvalidInputMessage();
+     } else {
+         DisplayRoundMoves(userMove, computerMove);
+         winnerType = DetermineRoundOutcome(userMove, computerMove);
+         ProcessRoundResult(winnerType);
+     }
+     m_decided = IsMatchDecided(m_rules, m_userWins, m_computerWins, m_numberOfRounds - m_roundsPlayed);
+ 
+     if (m_roundObserver) {
+         ReportRound(isValidMove, userMove, computerMove, winnerType, decisionNanos);
+     }
+ }
+ 
+ void SinglePlayerRpsGame::Finish() {
      m_messenger->ShowFinalScore(m_userPlayer, m_computerPlayer);
+ 
+     if (m_roundObserver) {
+         SessionSummary summary {};
+         summary.sessionId = m_sessionId;
+         summary.rounds = static_cast<std::uint32_t>(m_roundsPlayed);
+         summary.userName = m_userPlayer->GetNameView();
+         summary.computerName = m_computerPlayer->GetNameView();
+         m_roundObserver->OnSessionEnd(summary);
+     }
+ }
+ 
+ bool SinglePlayerRpsGame::IsFinished() const {
+     return m_decided || m_roundsPlayed >= m_numberOfRounds;
+ }
+ 
+ int SinglePlayerRpsGame::RoundsPlayed() const {
+     return m_roundsPlayed;
+ }
+ 
+ void SinglePlayerRpsGame::SetRoundObserver(IRoundObserver* observer, std::uint64_t sessionId) {
+     m_roundObserver = observer;
+     m_sessionId = sessionId;
  }
  
- std::tuple<bool, GameMove, GameMove> SinglePlayerRpsGame::ObtainMoves() {
+ std::tuple<bool, GameMove, GameMove> SinglePlayerRpsGame::ObtainMoves(int roundsRemaining) {
      // User picks a move (or gets -1 if invalid).
-     int userChoice { m_messenger->RequestMoveChoice() };
+     int userChoice { NextUserChoice(roundsRemaining) };
      bool isValidMove { (userChoice >= 1 && userChoice <= 3) };
  
      GameMove userMove = static_cast<GameMove>(userChoice);
@@ -48,6 +99,20 @@
      return { isValidMove, userMove, computerMove };
  }
  
+ int SinglePlayerRpsGame::NextUserChoice(int roundsRemaining) {
+     if (m_pendingIndex == m_pendingCount) {
+         // Never ask for moves beyond the end of the match.
+         std::size_t wanted { std::min(kMoveBatchSize, static_cast<std::size_t>(roundsRemaining)) };
+         m_pendingCount = std::min(m_messenger->RequestMoveChoices(m_pendingChoices.data(), wanted), wanted);
+         m_pendingIndex = 0;
+         if (m_pendingCount == 0) {
+             // A backend that delivered nothing forfeits the move.
+             return -1;
+         }
+     }
+     return m_pendingChoices[m_pendingIndex++];
+ }
+ 
  void SinglePlayerRpsGame::DisplayRoundMoves(GameMove userMove, GameMove computerMove) {
      m_messenger->DisplayChosenMove(m_userPlayer, userMove);
      m_messenger->DisplayChosenMove(m_computerPlayer, computerMove);
@@ -67,8 +132,26 @@
      if (winnerType == ParticipantType::NoOne) {
          m_messenger->AnnounceDraw();
      } else {
+         ++(winnerType == ParticipantType::User ? m_userWins : m_computerWins);
          m_playersByType[winnerType]->AddWin();
          m_messenger->AnnounceRoundWinner(m_playersByType[winnerType]);
      }
  }
+ 
+ void SinglePlayerRpsGame::ReportRound(bool isValidMove, GameMove userMove, GameMove computerMove,
+                                       ParticipantType winnerType, std::uint64_t decisionNanos) {
+     RoundRecord record {};
+     record.sessionId = m_sessionId;
+     record.round = static_cast<std::uint32_t>(m_roundsPlayed);
+     record.userMove = isValidMove ? static_cast<std::uint8_t>(userMove) : 0;
+     record.computerMove = static_cast<std::uint8_t>(computerMove);
+     record.outcome = !isValidMove                              ? RoundOutcome::Forfeit :
+                      winnerType == ParticipantType::User       ? RoundOutcome::UserWin :
+                      winnerType == ParticipantType::Computer   ? RoundOutcome::ComputerWin :
+                                                                  RoundOutcome::Draw;
+     record.userName = m_userPlayer->GetNameView();
+     record.computerName = m_computerPlayer->GetNameView();
+     record.decisionNanos = decisionNanos;
+     m_roundObserver->OnRound(record);
+ }
  
\ No newline at end of file
@@ -0,0 +1,320 @@
+/**
+ * @file SpectatorChannel.cpp
+ * @brief Implements the SpectatorChannel class.
+ */
+
+ #include "SpectatorChannel.hpp"
+ #include <algorithm>
+ #include <cerrno>
+ #include <fcntl.h>
+ #include <stdexcept>
+ #include <sys/epoll.h>
+ #include <sys/eventfd.h>
+ #include <sys/socket.h>
+ #include <sys/uio.h>
+ #include <system_error>
+ #include <unistd.h>
+
+ namespace {
+ 
+ /**
+  * @brief Frames gathered into one send; well below IOV_MAX.
+  */
+ constexpr int kMaxIovecs {64};
+ 
+ } // namespace
+ 
+ struct SpectatorChannel::Subscriber {
+     int fd {-1};
+ 
+     /**
+      * @brief Sequence of the next frame to take from the ring.
+      */
+     std::uint64_t next {};
+ 
+     /**
+      * @brief A frame taken from the ring but only partly sent, kept alive here.
+      */
+     SpectatorFrame inFlight {};
+     std::size_t offset {};
+ 
+     /**
+      * @brief The socket buffer was full; wait for EPOLLOUT.
+      */
+     bool blocked {};
+     bool closed {};
+ };
+ 
+ SpectatorChannel::SpectatorChannel(SpectatorOptions options)
+     : m_options{options}
+ {
+     std::size_t backlog { m_options.backlogFrames };
+     if (backlog == 0 || (backlog & (backlog - 1)) != 0) {
+         throw std::invalid_argument("SpectatorChannel backlog must be a power of two");
+     }
+     m_ring.resize(backlog);
+ 
+     m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+     if (m_epollFd < 0) {
+         throw std::system_error(errno, std::generic_category(), "epoll_create1");
+     }
+     m_wakeFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+     epoll_event event {};
+     event.events = EPOLLIN;
+     event.data.ptr = nullptr;
+     if (m_wakeFd < 0 || ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &event) < 0) {
+         int error { errno };
+         if (m_wakeFd >= 0) {
+             ::close(m_wakeFd);
+         }
+         ::close(m_epollFd);
+         throw std::system_error(error, std::generic_category(), "eventfd");
+     }
+ 
+     m_thread = std::thread([this]() { Run(); });
+ }
+ 
+ SpectatorChannel::~SpectatorChannel() {
+     m_stopping.store(true);
+     std::uint64_t one {1};
+     (void)::write(m_wakeFd, &one, sizeof(one));
+     m_thread.join();
+ 
+     for (auto& subscriber : m_subscribers) {
+         if (!subscriber->closed) {
+             ::close(subscriber->fd);
+         }
+     }
+     for (int fd : m_pendingSubscribers) {
+         ::close(fd);
+     }
+     ::close(m_wakeFd);
+     ::close(m_epollFd);
+ }
+ 
+ SpectatorFrame SpectatorChannel::MakeFrame(std::string bytes) {
+     return std::make_shared<const std::string>(std::move(bytes));
+ }
+ 
+ void SpectatorChannel::Subscribe(int socketFd) {
+     int flags { ::fcntl(socketFd, F_GETFL) };
+     if (flags < 0 || ::fcntl(socketFd, F_SETFL, flags | O_NONBLOCK) < 0) {
+         throw std::system_error(errno, std::generic_category(), "fcntl");
+     }
+     {
+         std::lock_guard<std::mutex> lock{m_pendingMutex};
+         m_pendingSubscribers.push_back(socketFd);
+     }
+     Wake();
+ }
+ 
+ void SpectatorChannel::Publish(SpectatorFrame frame) {
+     {
+         std::lock_guard<std::mutex> lock{m_pendingMutex};
+         // The ring keeps no more than this anyway; count the rest as missed.
+         if (m_pendingFrames.size() == m_ring.size()) {
+             m_pendingFrames.pop_front();
+             ++m_pendingDropped;
+         }
+         m_pendingFrames.push_back(std::move(frame));
+     }
+     m_framesPublished.fetch_add(1, std::memory_order_relaxed);
+     Wake();
+ }
+ 
+ SpectatorStats SpectatorChannel::Stats() const {
+     SpectatorStats stats {};
+     stats.framesPublished = m_framesPublished.load(std::memory_order_relaxed);
+     stats.subscribers = m_subscriberCount.load(std::memory_order_relaxed);
+     stats.disconnected = m_disconnected.load(std::memory_order_relaxed);
+     stats.skippedFrames = m_skippedFrames.load(std::memory_order_relaxed);
+     stats.bytesSent = m_bytesSent.load(std::memory_order_relaxed);
+     stats.sendCalls = m_sendCalls.load(std::memory_order_relaxed);
+     return stats;
+ }
+ 
+ void SpectatorChannel::Wake() {
+     // Only the first publisher since the fan-out thread last looked pays
+     // for the system call.
+     if (!m_wakePending.exchange(true, std::memory_order_acq_rel)) {
+         std::uint64_t one {1};
+         (void)::write(m_wakeFd, &one, sizeof(one));
+     }
+ }
+ 
+ void SpectatorChannel::Run() {
+     constexpr int kMaxEvents {256};
+     epoll_event events[kMaxEvents] {};
+     while (!m_stopping.load()) {
+         int ready { ::epoll_wait(m_epollFd, events, kMaxEvents, -1) };
+         if (ready < 0) {
+             if (errno == EINTR) {
+                 continue;
+             }
+             return;
+         }
+         for (int i{}; i < ready; ++i) {
+             auto* subscriber = static_cast<Subscriber*>(events[i].data.ptr);
+             if (!subscriber) {
+                 std::uint64_t count {};
+                 (void)::read(m_wakeFd, &count, sizeof(count));
+                 continue;
+             }
+             if (subscriber->closed) {
+                 continue;
+             }
+             if (events[i].events & (EPOLLHUP | EPOLLERR | EPOLLRDHUP)) {
+                 Close(*subscriber);
+             } else if (events[i].events & EPOLLOUT) {
+                 subscriber->blocked = false;
+             }
+         }
+         if (m_stopping.load()) {
+             break;
+         }
+ 
+         m_wakePending.store(false, std::memory_order_release);
+         TakePending();
+         for (auto& subscriber : m_subscribers) {
+             if (subscriber->closed) {
+                 continue;
+             }
+             // A blocked subscriber cannot be sent anything until EPOLLOUT,
+             // but falling behind is handled right away.
+             bool keep { subscriber->blocked ? CatchUp(*subscriber) : Send(*subscriber) };
+             if (!keep) {
+                 Close(*subscriber);
+             }
+         }
+         m_subscribers.erase(std::remove_if(m_subscribers.begin(), m_subscribers.end(),
+                                            [](const auto& subscriber) { return subscriber->closed; }),
+                             m_subscribers.end());
+     }
+ }
+ 
+ void SpectatorChannel::TakePending() {
+     std::uint64_t dropped {};
+     std::vector<int> subscribers;
+     {
+         std::lock_guard<std::mutex> lock{m_pendingMutex};
+         m_takenFrames.swap(m_pendingFrames);
+         dropped = m_pendingDropped;
+         m_pendingDropped = 0;
+         subscribers.swap(m_pendingSubscribers);
+     }
+ 
+     std::uint64_t mask { m_ring.size() - 1 };
+     m_head += dropped;
+     for (auto& frame : m_takenFrames) {
+         m_ring[m_head & mask] = std::move(frame);
+         ++m_head;
+     }
+     m_takenFrames.clear();
+ 
+     for (int fd : subscribers) {
+         auto subscriber = std::make_unique<Subscriber>();
+         subscriber->fd = fd;
+         subscriber->next = m_head > 0 ? m_head - 1 : 0;
+         epoll_event event {};
+         event.events = EPOLLOUT | EPOLLRDHUP | EPOLLET;
+         event.data.ptr = subscriber.get();
+         if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+             ::close(fd);
+             continue;
+         }
+         m_subscribers.push_back(std::move(subscriber));
+         m_subscriberCount.fetch_add(1, std::memory_order_relaxed);
+     }
+ }
+ 
+ bool SpectatorChannel::Send(Subscriber& subscriber) {
+     std::uint64_t mask { m_ring.size() - 1 };
+     while (subscriber.inFlight || subscriber.next < m_head) {
+         if (!CatchUp(subscriber)) {
+             return false;
+         }
+ 
+         // Point the iovecs straight into the shared frames: no copies.
+         iovec iov[kMaxIovecs] {};
+         int count {};
+         int firstFrame {};
+         if (subscriber.inFlight) {
+             iov[count].iov_base = const_cast<char*>(subscriber.inFlight->data() + subscriber.offset);
+             iov[count].iov_len = subscriber.inFlight->size() - subscriber.offset;
+             ++count;
+             firstFrame = 1;
+         }
+         for (std::uint64_t sequence { subscriber.next }; sequence < m_head && count < kMaxIovecs; ++sequence) {
+             const std::string& frame { *m_ring[sequence & mask] };
+             iov[count].iov_base = const_cast<char*>(frame.data());
+             iov[count].iov_len = frame.size();
+             ++count;
+         }
+ 
+         msghdr message {};
+         message.msg_iov = iov;
+         message.msg_iovlen = static_cast<std::size_t>(count);
+         ssize_t sent { ::sendmsg(subscriber.fd, &message, MSG_NOSIGNAL | MSG_DONTWAIT) };
+         m_sendCalls.fetch_add(1, std::memory_order_relaxed);
+         if (sent < 0) {
+             if (errno == EINTR) {
+                 continue;
+             }
+             if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                 subscriber.blocked = true;
+                 return true;
+             }
+             return false;
+         }
+         m_bytesSent.fetch_add(static_cast<std::uint64_t>(sent), std::memory_order_relaxed);
+ 
+         auto remaining = static_cast<std::size_t>(sent);
+         if (subscriber.inFlight) {
+             std::size_t rest { subscriber.inFlight->size() - subscriber.offset };
+             if (remaining < rest) {
+                 subscriber.offset += remaining;
+                 subscriber.blocked = true;
+                 return true;
+             }
+             remaining -= rest;
+             subscriber.inFlight.reset();
+             subscriber.offset = 0;
+         }
+         for (int i {firstFrame}; i < count; ++i) {
+             const SpectatorFrame& frame { m_ring[subscriber.next & mask] };
+             if (remaining < frame->size()) {
+                 // A short send means the socket buffer is full.
+                 if (remaining > 0) {
+                     subscriber.inFlight = frame;
+                     subscriber.offset = remaining;
+                     ++subscriber.next;
+                 }
+                 subscriber.blocked = true;
+                 return true;
+             }
+             remaining -= frame->size();
+             ++subscriber.next;
+         }
+     }
+     return true;
+ }
+ 
+ bool SpectatorChannel::CatchUp(Subscriber& subscriber) {
+     if (m_head - subscriber.next <= m_ring.size()) {
+         return true;
+     }
+     if (m_options.policy == SlowSubscriberPolicy::Disconnect) {
+         return false;
+     }
+     m_skippedFrames.fetch_add(m_head - 1 - subscriber.next, std::memory_order_relaxed);
+     subscriber.next = m_head - 1;
+     return true;
+ }
+ 
+ void SpectatorChannel::Close(Subscriber& subscriber) {
+     ::close(subscriber.fd);
+     subscriber.closed = true;
+     m_subscriberCount.fetch_sub(1, std::memory_order_relaxed);
+     m_disconnected.fetch_add(1, std::memory_order_relaxed);
+ }
+ 
\ No newline at end of file
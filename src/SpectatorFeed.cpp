@@ -0,0 +1,86 @@
+/**
+ * @file SpectatorFeed.cpp
+ * @brief Implements the SpectatorFeed class.
+ */
+
+ #include "SpectatorFeed.hpp"
+ #include <string>
+
+ namespace {
+ 
+ const char* MoveName(std::uint8_t move) {
+     switch (move) {
+     case 1:  return "rock";
+     case 2:  return "paper";
+     case 3:  return "scissors";
+     default: return "nothing";
+     }
+ }
+ 
+ std::string ScoreText(std::uint32_t userWins, std::uint32_t computerWins, std::uint32_t draws) {
+     return std::to_string(userWins) + "-" + std::to_string(computerWins) + ", " + std::to_string(draws) + " drawn";
+ }
+ 
+ } // namespace
+ 
+ SpectatorFeed::SpectatorFeed(SpectatorChannel& channel)
+     : m_channel{channel}
+ {
+ }
+ 
+ void SpectatorFeed::OnRound(const RoundRecord& record) {
+     Score score {};
+     {
+         std::lock_guard<std::mutex> lock{m_mutex};
+         Score& running { m_scores[record.sessionId] };
+         running.userWins += record.outcome == RoundOutcome::UserWin;
+         running.computerWins += record.outcome == RoundOutcome::ComputerWin;
+         running.draws += record.outcome == RoundOutcome::Draw;
+         score = running;
+     }
+ 
+     std::string line {"round "};
+     line.reserve(128);
+     line += std::to_string(record.round);
+     line += ": ";
+     line += record.userName;
+     line += ' ';
+     line += MoveName(record.userMove);
+     line += ", ";
+     line += record.computerName;
+     line += ' ';
+     line += MoveName(record.computerMove);
+     line += ": ";
+     if (record.outcome == RoundOutcome::Draw) {
+         line += "draw";
+     } else if (record.outcome == RoundOutcome::Forfeit) {
+         line += "no contest";
+     } else {
+         line += record.outcome == RoundOutcome::UserWin ? record.userName : record.computerName;
+         line += " wins";
+     }
+     line += " (" + ScoreText(score.userWins, score.computerWins, score.draws) + ")\n";
+     m_channel.Publish(SpectatorChannel::MakeFrame(std::move(line)));
+ }
+ 
+ void SpectatorFeed::OnSessionEnd(const SessionSummary& summary) {
+     Score score {};
+     {
+         std::lock_guard<std::mutex> lock{m_mutex};
+         auto it = m_scores.find(summary.sessionId);
+         if (it != m_scores.end()) {
+             score = it->second;
+             m_scores.erase(it);
+         }
+     }
+ 
+     std::string line {"final after "};
+     line += std::to_string(summary.rounds);
+     line += " rounds: ";
+     line += summary.userName;
+     line += " vs ";
+     line += summary.computerName;
+     line += " " + ScoreText(score.userWins, score.computerWins, score.draws) + "\n";
+     m_channel.Publish(SpectatorChannel::MakeFrame(std::move(line)));
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,428 @@
+/**
+ * @file StrategyEvolver.cpp
+ * @brief Implements the StrategyEvolver class.
+ */
+
+ #include "StrategyEvolver.hpp"
+ #include "GameRules.hpp"
+ #include "MoveStrategies.hpp"
+ #include "Xoshiro256.hpp"
+ #include <algorithm>
+ #include <chrono>
+ #include <cstdio>
+ #include <cstring>
+ #include <exception>
+ #include <fstream>
+ #include <iterator>
+ #include <numeric>
+ #include <stdexcept>
+ #include <thread>
+
+ namespace {
+ 
+ constexpr std::uint32_t kFileMagic {0x4F564552}; // "REVO" little-endian
+ constexpr std::uint32_t kFileVersion {1};
+ 
+ /**
+  * @brief Stream numbers at and above these are reserved for breeding and
+  *        for the initial population; match streams stay below 2^62.
+  */
+ constexpr std::uint64_t kBreedingStreams {std::uint64_t{1} << 62};
+ constexpr std::uint64_t kInitialStream {std::uint64_t{1} << 63};
+ 
+ void PutU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+     for (int i{}; i < 4; ++i) {
+         out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+     }
+ }
+ 
+ void PutU64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+     for (int i{}; i < 8; ++i) {
+         out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+     }
+ }
+ 
+ void PutBytes(std::vector<std::uint8_t>& out, const std::vector<std::uint8_t>& value) {
+     PutU32(out, static_cast<std::uint32_t>(value.size()));
+     out.insert(out.end(), value.begin(), value.end());
+ }
+ 
+ /**
+  * @brief Bounds-checked little-endian reader over a checkpoint.
+  */
+ class Reader {
+ public:
+     explicit Reader(const std::vector<std::uint8_t>& bytes)
+         : m_bytes{bytes}
+     {
+     }
+ 
+     std::uint64_t Get(int size) {
+         Require(static_cast<std::size_t>(size));
+         std::uint64_t value {};
+         for (int i{}; i < size; ++i) {
+             value |= static_cast<std::uint64_t>(m_bytes[m_offset++]) << (8 * i);
+         }
+         return value;
+     }
+ 
+     std::uint32_t U32() { return static_cast<std::uint32_t>(Get(4)); }
+     std::uint64_t U64() { return Get(8); }
+ 
+     std::vector<std::uint8_t> Bytes() {
+         std::size_t size { U32() };
+         Require(size);
+         std::vector<std::uint8_t> value(m_bytes.begin() + static_cast<std::ptrdiff_t>(m_offset),
+                                         m_bytes.begin() + static_cast<std::ptrdiff_t>(m_offset + size));
+         m_offset += size;
+         return value;
+     }
+ 
+     bool AtEnd() const { return m_offset == m_bytes.size(); }
+ 
+ private:
+     void Require(std::size_t size) const {
+         if (m_bytes.size() - m_offset < size) {
+             throw std::runtime_error("Truncated evolution checkpoint");
+         }
+     }
+ 
+ private:
+     const std::vector<std::uint8_t>& m_bytes;
+     std::size_t m_offset {};
+ };
+ 
+ std::uint64_t DoubleBits(double value) {
+     std::uint64_t bits {};
+     std::memcpy(&bits, &value, sizeof(bits));
+     return bits;
+ }
+ 
+ double BitsDouble(std::uint64_t bits) {
+     double value {};
+     std::memcpy(&value, &bits, sizeof(value));
+     return value;
+ }
+ 
+ /**
+  * @brief A uniform double in [0, 1).
+  */
+ double UnitInterval(Xoshiro256& random) {
+     return static_cast<double>(random() >> 11) * 0x1.0p-53;
+ }
+ 
+ void Validate(const EvolutionConfig& config) {
+     if (config.historyLength > StrategyGenome::kMaxHistoryLength) {
+         throw std::invalid_argument("History length above " + std::to_string(StrategyGenome::kMaxHistoryLength));
+     }
+     if (config.populationSize < 2 || config.roundsPerMatch < 1 || config.matchesPerOpponent < 1 ||
+         config.tournamentSize < 1) {
+         throw std::invalid_argument("Population, rounds, matches and tournament size must be positive");
+     }
+     if (config.eliteCount > config.populationSize) {
+         throw std::invalid_argument("More elites than individuals");
+     }
+     if (!(config.mutationRate >= 0.0 && config.mutationRate <= 1.0)) {
+         throw std::invalid_argument("Mutation rate must be in [0, 1]");
+     }
+     if (config.opponents.empty()) {
+         throw std::invalid_argument("No opponents to evaluate against");
+     }
+     for (const auto& name : config.opponents) {
+         if (!MakeMoveStrategy(name, 0)) {
+             throw std::invalid_argument("Unknown strategy: " + name);
+         }
+     }
+ }
+ 
+ double PerRound(std::int64_t fitness, const EvolutionConfig& config) {
+     double rounds { static_cast<double>(config.roundsPerMatch) * config.matchesPerOpponent *
+                     static_cast<double>(config.opponents.size()) };
+     return static_cast<double>(fitness) / rounds;
+ }
+ 
+ } // namespace
+ 
+ bool EvolutionConfig::operator==(const EvolutionConfig& other) const {
+     return masterSeed == other.masterSeed && historyLength == other.historyLength &&
+            populationSize == other.populationSize && roundsPerMatch == other.roundsPerMatch &&
+            matchesPerOpponent == other.matchesPerOpponent && opponents == other.opponents &&
+            eliteCount == other.eliteCount && tournamentSize == other.tournamentSize &&
+            DoubleBits(mutationRate) == DoubleBits(other.mutationRate);
+ }
+ 
+ bool EvolutionConfig::operator!=(const EvolutionConfig& other) const {
+     return !(*this == other);
+ }
+ 
+ double GenerationReport::MatchesPerSecond() const {
+     return seconds > 0 ? static_cast<double>(matches) / seconds : 0.0;
+ }
+ 
+ StrategyEvolver::StrategyEvolver(EvolutionConfig config, unsigned threads)
+     : StrategyEvolver{std::move(config), threads, true}
+ {
+ }
+ 
+ StrategyEvolver::StrategyEvolver(EvolutionConfig config, unsigned threads, bool randomize)
+     : m_config{std::move(config)}
+     , m_threads{threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())}
+ {
+     Validate(m_config);
+     if (!randomize) {
+         return;
+     }
+     Xoshiro256 random { Xoshiro256::ForStream(m_config.masterSeed, kInitialStream) };
+     m_population.assign(m_config.populationSize, StrategyGenome::Blank(m_config.historyLength));
+     for (auto& genome : m_population) {
+         for (auto& gene : genome.genes) {
+             gene = static_cast<std::uint8_t>(random.NextBelow(3));
+         }
+     }
+ }
+ 
+ GenerationReport StrategyEvolver::Step() {
+     auto begin = std::chrono::steady_clock::now();
+     std::size_t count { m_population.size() };
+     std::vector<std::int64_t> fitness(count);
+     std::size_t slices { std::min<std::size_t>(m_threads, count) };
+     std::vector<std::exception_ptr> errors(slices);
+ 
+     auto evaluateSlice = [&](std::size_t slice) {
+         try {
+             std::size_t first { count * slice / slices };
+             std::size_t last { count * (slice + 1) / slices };
+             for (std::size_t i { first }; i < last; ++i) {
+                 fitness[i] = Evaluate(m_population[i], m_generation, static_cast<std::uint32_t>(i));
+             }
+         } catch (...) {
+             errors[slice] = std::current_exception();
+         }
+     };
+ 
+     std::vector<std::thread> workers;
+     for (std::size_t slice { 1 }; slice < slices; ++slice) {
+         workers.emplace_back(evaluateSlice, slice);
+     }
+     evaluateSlice(0);
+     for (auto& worker : workers) {
+         worker.join();
+     }
+     for (const auto& error : errors) {
+         if (error) {
+             std::rethrow_exception(error);
+         }
+     }
+ 
+     GenerationReport report {};
+     report.generation = m_generation;
+     report.matches = static_cast<std::uint64_t>(count) * m_config.opponents.size() * m_config.matchesPerOpponent;
+     std::int64_t total { std::accumulate(fitness.begin(), fitness.end(), std::int64_t{}) };
+     report.meanFitness = PerRound(total, m_config) / static_cast<double>(count);
+ 
+     Breed(fitness);
+     report.bestFitness = PerRound(m_bestFitness, m_config);
+     report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+     return report;
+ }
+ 
+ std::uint32_t StrategyEvolver::Generation() const {
+     return m_generation;
+ }
+ 
+ const std::vector<StrategyGenome>& StrategyEvolver::Population() const {
+     return m_population;
+ }
+ 
+ const StrategyGenome& StrategyEvolver::Best() const {
+     if (!m_hasBest) {
+         throw std::logic_error("No generation has been evaluated yet");
+     }
+     return m_best;
+ }
+ 
+ double StrategyEvolver::BestFitness() const {
+     return PerRound(m_bestFitness, m_config);
+ }
+ 
+ const EvolutionConfig& StrategyEvolver::Config() const {
+     return m_config;
+ }
+ 
+ std::int64_t StrategyEvolver::Evaluate(const StrategyGenome& genome, std::uint32_t generation,
+                                        std::uint32_t individual) const {
+     std::uint64_t opponents { m_config.opponents.size() };
+     std::uint64_t firstStream { (static_cast<std::uint64_t>(generation) * m_config.populationSize + individual) *
+                                 opponents * m_config.matchesPerOpponent };
+     std::int64_t score {};
+     for (std::uint64_t opponent{}; opponent < opponents; ++opponent) {
+         for (std::uint64_t match{}; match < m_config.matchesPerOpponent; ++match) {
+             std::uint64_t stream { firstStream + opponent * m_config.matchesPerOpponent + match };
+             Xoshiro256 random { Xoshiro256::ForStream(m_config.masterSeed, stream % kBreedingStreams) };
+             GenomeStrategy own{genome};
+             auto other = MakeMoveStrategy(m_config.opponents[opponent], random());
+             for (std::uint32_t round{}; round < m_config.roundsPerMatch; ++round) {
+                 GameMove ownMove { own.NextMove() };
+                 GameMove otherMove { other->NextMove() };
+                 score += DoesFirstMoveWin(ownMove, otherMove) ? 1 : DoesFirstMoveWin(otherMove, ownMove) ? -1 : 0;
+                 own.ObserveRound(ownMove, otherMove);
+                 other->ObserveRound(otherMove, ownMove);
+             }
+         }
+     }
+     return score;
+ }
+ 
+ void StrategyEvolver::Breed(const std::vector<std::int64_t>& fitness) {
+     std::vector<std::uint32_t> ranking(m_population.size());
+     std::iota(ranking.begin(), ranking.end(), 0u);
+     // Ties go to the lower index, so the order is fully determined.
+     std::stable_sort(ranking.begin(), ranking.end(), [&fitness](std::uint32_t a, std::uint32_t b) {
+         return fitness[a] > fitness[b];
+     });
+     m_best = m_population[ranking[0]];
+     m_bestFitness = fitness[ranking[0]];
+     m_hasBest = true;
+ 
+     Xoshiro256 random { Xoshiro256::ForStream(m_config.masterSeed, kBreedingStreams + m_generation) };
+     auto tournament = [&]() {
+         std::uint32_t winner { static_cast<std::uint32_t>(random.NextBelow(m_population.size())) };
+         for (std::uint32_t i { 1 }; i < m_config.tournamentSize; ++i) {
+             auto rival = static_cast<std::uint32_t>(random.NextBelow(m_population.size()));
+             if (fitness[rival] > fitness[winner] || (fitness[rival] == fitness[winner] && rival < winner)) {
+                 winner = rival;
+             }
+         }
+         return winner;
+     };
+ 
+     std::vector<StrategyGenome> next;
+     next.reserve(m_population.size());
+     for (std::uint32_t i{}; i < m_config.eliteCount; ++i) {
+         next.push_back(m_population[ranking[i]]);
+     }
+     while (next.size() < m_population.size()) {
+         const StrategyGenome& mother { m_population[tournament()] };
+         const StrategyGenome& father { m_population[tournament()] };
+         StrategyGenome child { mother };
+         std::uint64_t bits {};
+         for (std::size_t g{}; g < child.genes.size(); ++g) {
+             if (g % 64 == 0) {
+                 bits = random();
+             }
+             if ((bits >> (g % 64)) & 1) {
+                 child.genes[g] = father.genes[g];
+             }
+             if (UnitInterval(random) < m_config.mutationRate) {
+                 child.genes[g] = static_cast<std::uint8_t>(random.NextBelow(3));
+             }
+         }
+         next.push_back(std::move(child));
+     }
+     m_population.swap(next);
+     ++m_generation;
+ }
+ 
+ void StrategyEvolver::SaveCheckpoint(const std::string& path) const {
+     std::vector<std::uint8_t> out;
+     PutU32(out, kFileMagic);
+     PutU32(out, kFileVersion);
+ 
+     PutU64(out, m_config.masterSeed);
+     PutU32(out, m_config.historyLength);
+     PutU32(out, m_config.populationSize);
+     PutU32(out, m_config.roundsPerMatch);
+     PutU32(out, m_config.matchesPerOpponent);
+     PutU32(out, static_cast<std::uint32_t>(m_config.opponents.size()));
+     for (const auto& name : m_config.opponents) {
+         PutBytes(out, std::vector<std::uint8_t>(name.begin(), name.end()));
+     }
+     PutU32(out, m_config.eliteCount);
+     PutU32(out, m_config.tournamentSize);
+     PutU64(out, DoubleBits(m_config.mutationRate));
+ 
+     PutU32(out, m_generation);
+     PutU32(out, m_hasBest ? 1 : 0);
+     PutU64(out, static_cast<std::uint64_t>(m_bestFitness));
+     if (m_hasBest) {
+         PutBytes(out, m_best.genes);
+     }
+     for (const auto& genome : m_population) {
+         PutBytes(out, genome.genes);
+     }
+ 
+     // Write a sibling file and rename it over the old checkpoint, so a
+     // crash mid-write leaves the previous generation intact.
+     std::string temporary { path + ".tmp" };
+     {
+         std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+         file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+         if (!file.flush()) {
+             throw std::runtime_error("Cannot write evolution checkpoint: " + temporary);
+         }
+     }
+     if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+         std::remove(temporary.c_str());
+         throw std::runtime_error("Cannot replace evolution checkpoint: " + path);
+     }
+ }
+ 
+ StrategyEvolver StrategyEvolver::LoadCheckpoint(const std::string& path, unsigned threads) {
+     std::ifstream file{path, std::ios::binary};
+     if (!file) {
+         throw std::runtime_error("Cannot read evolution checkpoint: " + path);
+     }
+     std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+     Reader reader{bytes};
+     if (reader.U32() != kFileMagic || reader.U32() != kFileVersion) {
+         throw std::runtime_error("Not an evolution checkpoint: " + path);
+     }
+ 
+     EvolutionConfig config {};
+     config.masterSeed = reader.U64();
+     config.historyLength = reader.U32();
+     config.populationSize = reader.U32();
+     config.roundsPerMatch = reader.U32();
+     config.matchesPerOpponent = reader.U32();
+     config.opponents.clear();
+     std::uint32_t opponents { reader.U32() };
+     for (std::uint32_t i{}; i < opponents; ++i) {
+         auto name = reader.Bytes();
+         config.opponents.emplace_back(name.begin(), name.end());
+     }
+     config.eliteCount = reader.U32();
+     config.tournamentSize = reader.U32();
+     config.mutationRate = BitsDouble(reader.U64());
+ 
+     auto restore = [&]() {
+         try {
+             return StrategyEvolver{std::move(config), threads, false};
+         } catch (const std::invalid_argument& error) {
+             throw std::runtime_error(std::string{"Corrupt evolution checkpoint: "} + error.what());
+         }
+     };
+     StrategyEvolver evolver { restore() };
+ 
+     auto readGenome = [&](StrategyGenome& genome) {
+         genome.historyLength = evolver.m_config.historyLength;
+         genome.genes = reader.Bytes();
+         if (!genome.IsValid()) {
+             throw std::runtime_error("Corrupt genome in evolution checkpoint");
+         }
+     };
+     evolver.m_generation = reader.U32();
+     evolver.m_hasBest = reader.U32() != 0;
+     evolver.m_bestFitness = static_cast<std::int64_t>(reader.U64());
+     if (evolver.m_hasBest) {
+         readGenome(evolver.m_best);
+     }
+     evolver.m_population.resize(evolver.m_config.populationSize);
+     for (auto& genome : evolver.m_population) {
+         readGenome(genome);
+     }
+     if (!reader.AtEnd()) {
+         throw std::runtime_error("Trailing bytes after evolution checkpoint");
+     }
+     return evolver;
+ }
+ 
\ No newline at end of file
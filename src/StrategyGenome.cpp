@@ -0,0 +1,87 @@
+/**
+ * @file StrategyGenome.cpp
+ * @brief Implements StrategyGenome and GenomeStrategy.
+ */
+
+ #include "StrategyGenome.hpp"
+ #include <stdexcept>
+ #include <string>
+
+ namespace {
+ 
+ std::uint32_t TableSize(std::uint32_t historyLength) {
+     std::uint32_t size {1};
+     for (std::uint32_t i{}; i < historyLength; ++i) {
+         size *= 9;
+     }
+     return size;
+ }
+ 
+ } // namespace
+ 
+ std::size_t StrategyGenome::GeneCount(std::uint32_t historyLength) {
+     if (historyLength > kMaxHistoryLength) {
+         throw std::invalid_argument("Genome history length above " + std::to_string(kMaxHistoryLength));
+     }
+     return historyLength + TableSize(historyLength);
+ }
+ 
+ StrategyGenome StrategyGenome::Blank(std::uint32_t historyLength) {
+     StrategyGenome genome {};
+     genome.historyLength = historyLength;
+     genome.genes.assign(GeneCount(historyLength), 0);
+     return genome;
+ }
+ 
+ bool StrategyGenome::IsValid() const {
+     if (historyLength > kMaxHistoryLength || genes.size() != GeneCount(historyLength)) {
+         return false;
+     }
+     for (std::uint8_t gene : genes) {
+         if (gene > 2) {
+             return false;
+         }
+     }
+     return true;
+ }
+ 
+ bool StrategyGenome::operator==(const StrategyGenome& other) const {
+     return historyLength == other.historyLength && genes == other.genes;
+ }
+ 
+ bool StrategyGenome::operator!=(const StrategyGenome& other) const {
+     return !(*this == other);
+ }
+ 
+ GenomeStrategy::GenomeStrategy(const StrategyGenome& genome)
+ {
+     // Only the shape is checked: the evolver builds strategies for every
+     // match, and scanning 9^k genes each time would dominate short matches.
+     if (genome.historyLength > StrategyGenome::kMaxHistoryLength ||
+         genome.genes.size() != StrategyGenome::GeneCount(genome.historyLength)) {
+         throw std::invalid_argument("Strategy genome has the wrong number of genes");
+     }
+     m_opening = genome.genes.data();
+     m_table = genome.genes.data() + genome.historyLength;
+     m_historyLength = genome.historyLength;
+     m_tableSize = TableSize(genome.historyLength);
+ }
+ 
+ GameMove GenomeStrategy::NextMove() {
+     std::uint8_t gene { m_roundsSeen < m_historyLength ? m_opening[m_roundsSeen] : m_table[m_index] };
+     return static_cast<GameMove>(1 + gene);
+ }
+ 
+ void GenomeStrategy::ObserveRound(GameMove ownMove, GameMove opponentMove) {
+     // Appending a base-9 digit and dropping the oldest keeps the last k rounds.
+     std::uint32_t pair { (static_cast<std::uint32_t>(ownMove) - 1) * 3 + (static_cast<std::uint32_t>(opponentMove) - 1) };
+     m_index = (m_index * 9 + pair) % m_tableSize;
+     if (m_roundsSeen < m_historyLength) {
+         ++m_roundsSeen;
+     }
+ }
+ 
+ bool GenomeStrategy::DependsOnHistory() const {
+     return m_historyLength > 0;
+ }
+ 
\ No newline at end of file
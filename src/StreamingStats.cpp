@@ -0,0 +1,246 @@
+/**
+ * @file StreamingStats.cpp
+ * @brief Implements the streaming aggregators.
+ */
+
+ #include "StreamingStats.hpp"
+ #include <algorithm>
+ #include <cmath>
+ #include <stdexcept>
+
+ namespace {
+ 
+ constexpr std::uint8_t kNoMove {0};
+ 
+ /**
+  * @brief Number of bits needed to represent a non-zero value.
+  */
+ int BitWidth(std::uint64_t value)
+ {
+ #if defined(__GNUC__) || defined(__clang__)
+     return 64 - __builtin_clzll(value);
+ #else
+     int width {};
+     while (value) {
+         ++width;
+         value >>= 1;
+     }
+     return width;
+ #endif
+ }
+ 
+ } // namespace
+ 
+ RoundWindow::RoundWindow(std::size_t capacity)
+     : m_slots(capacity)
+ {
+     if (capacity == 0) {
+         throw std::invalid_argument("Round window must hold at least one round");
+     }
+ }
+ 
+ void RoundWindow::Push(RoundResult result, std::uint8_t move) {
+     // Each slot packs the result in the low two bits and the move above them.
+     if (m_size == m_slots.size()) {
+         std::uint8_t evicted { m_slots[m_next] };
+         --m_results[evicted & 3u];
+         if ((evicted >> 2) != kNoMove) {
+             --m_moves[(evicted >> 2) - 1];
+         }
+     } else {
+         ++m_size;
+     }
+ 
+     bool hasMove { move >= 1 && move <= 3 };
+     m_slots[m_next] = static_cast<std::uint8_t>(static_cast<std::uint8_t>(result) | (hasMove ? move << 2 : 0));
+     m_next = m_next + 1 == m_slots.size() ? 0 : m_next + 1;
+     ++m_results[static_cast<std::size_t>(result)];
+     if (hasMove) {
+         ++m_moves[move - 1];
+     }
+ 
+     switch (result) {
+     case RoundResult::Win:
+         m_streak = m_streak > 0 ? m_streak + 1 : 1;
+         break;
+     case RoundResult::Loss:
+         m_streak = m_streak < 0 ? m_streak - 1 : -1;
+         break;
+     default:
+         m_streak = 0;
+         break;
+     }
+ }
+ 
+ std::size_t RoundWindow::Size() const {
+     return m_size;
+ }
+ 
+ std::size_t RoundWindow::Capacity() const {
+     return m_slots.size();
+ }
+ 
+ const ResultCounts& RoundWindow::Results() const {
+     return m_results;
+ }
+ 
+ const std::array<std::uint64_t, 3>& RoundWindow::Moves() const {
+     return m_moves;
+ }
+ 
+ double RoundWindow::WinRate() const {
+     std::uint64_t scored { m_size - m_results[static_cast<std::size_t>(RoundResult::Forfeit)] };
+     return scored == 0 ? 0.0 : static_cast<double>(m_results[static_cast<std::size_t>(RoundResult::Win)]) / scored;
+ }
+ 
+ std::int64_t RoundWindow::Streak() const {
+     return m_streak;
+ }
+ 
+ TimeWindow::TimeWindow(std::uint64_t spanNanos, std::size_t buckets)
+     : m_buckets(buckets)
+ {
+     if (buckets == 0 || spanNanos < buckets) {
+         throw std::invalid_argument("Time window needs at least one nanosecond per bucket");
+     }
+     m_bucketNanos = spanNanos / buckets;
+ }
+ 
+ void TimeWindow::Add(std::uint64_t nowNanos, RoundResult result) {
+     std::uint64_t bucket { nowNanos / m_bucketNanos };
+     if (bucket > m_head) {
+         Advance(bucket);
+     }
+     ++m_buckets[bucket % m_buckets.size()][static_cast<std::size_t>(result)];
+ }
+ 
+ ResultCounts TimeWindow::Totals(std::uint64_t nowNanos) const {
+     std::uint64_t now { nowNanos / m_bucketNanos };
+     ResultCounts totals {};
+     if (now >= m_head + m_buckets.size()) {
+         return totals;
+     }
+     // Buckets [now - size + 1, m_head] are still inside the span.
+     std::uint64_t newest { std::max(now, m_head) };
+     std::uint64_t oldest { newest + 1 >= m_buckets.size() ? newest + 1 - m_buckets.size() : 0 };
+     for (std::uint64_t bucket { oldest }; bucket <= m_head; ++bucket) {
+         const ResultCounts& counts { m_buckets[bucket % m_buckets.size()] };
+         for (std::size_t result{}; result < kRoundResultCount; ++result) {
+             totals[result] += counts[result];
+         }
+     }
+     return totals;
+ }
+ 
+ void TimeWindow::Advance(std::uint64_t bucket) {
+     // Clear every bucket the head moves over; at most one full turn.
+     std::uint64_t steps { std::min<std::uint64_t>(bucket - m_head, m_buckets.size()) };
+     for (std::uint64_t step { 1 }; step <= steps; ++step) {
+         m_buckets[(bucket - steps + step) % m_buckets.size()] = ResultCounts{};
+     }
+     m_head = bucket;
+ }
+ 
+ Ewma::Ewma(double alpha)
+     : m_alpha{alpha}
+ {
+     if (!(alpha > 0.0 && alpha <= 1.0)) {
+         throw std::invalid_argument("Ewma weight must be in (0, 1]");
+     }
+ }
+ 
+ void Ewma::Add(double sample) {
+     if (m_empty) {
+         m_value = sample;
+         m_empty = false;
+     } else {
+         m_value += m_alpha * (sample - m_value);
+     }
+ }
+ 
+ double Ewma::Value() const {
+     return m_value;
+ }
+ 
+ void QuantileSketch::Add(std::uint64_t value) {
+     std::size_t bucket { BucketOf(value) };
+     if (bucket >= m_counts.size()) {
+         m_counts.resize(bucket + 1);
+     }
+     ++m_counts[bucket];
+     ++m_count;
+     m_min = std::min(m_min, value);
+     m_max = std::max(m_max, value);
+ }
+ 
+ void QuantileSketch::Merge(const QuantileSketch& other) {
+     if (other.m_counts.size() > m_counts.size()) {
+         m_counts.resize(other.m_counts.size());
+     }
+     for (std::size_t bucket{}; bucket < other.m_counts.size(); ++bucket) {
+         m_counts[bucket] += other.m_counts[bucket];
+     }
+     m_count += other.m_count;
+     m_min = std::min(m_min, other.m_min);
+     m_max = std::max(m_max, other.m_max);
+ }
+ 
+ std::uint64_t QuantileSketch::Count() const {
+     return m_count;
+ }
+ 
+ std::uint64_t QuantileSketch::Min() const {
+     return m_count == 0 ? 0 : m_min;
+ }
+ 
+ std::uint64_t QuantileSketch::Max() const {
+     return m_max;
+ }
+ 
+ std::uint64_t QuantileSketch::Quantile(double q) const {
+     if (m_count == 0) {
+         return 0;
+     }
+     q = std::clamp(q, 0.0, 1.0);
+     auto rank = static_cast<std::uint64_t>(std::llround(q * static_cast<double>(m_count - 1)));
+     std::uint64_t seen {};
+     for (std::size_t bucket{}; bucket < m_counts.size(); ++bucket) {
+         seen += m_counts[bucket];
+         if (seen > rank) {
+             return std::clamp(BucketMidpoint(bucket), m_min, m_max);
+         }
+     }
+     return m_max;
+ }
+ 
+ bool QuantileSketch::operator==(const QuantileSketch& other) const {
+     std::size_t common { std::min(m_counts.size(), other.m_counts.size()) };
+     auto zero = [](std::uint64_t count) { return count == 0; };
+     return m_count == other.m_count && Min() == other.Min() && m_max == other.m_max &&
+            std::equal(m_counts.begin(), m_counts.begin() + static_cast<std::ptrdiff_t>(common), other.m_counts.begin()) &&
+            std::all_of(m_counts.begin() + static_cast<std::ptrdiff_t>(common), m_counts.end(), zero) &&
+            std::all_of(other.m_counts.begin() + static_cast<std::ptrdiff_t>(common), other.m_counts.end(), zero);
+ }
+ 
+ std::size_t QuantileSketch::BucketOf(std::uint64_t value) {
+     constexpr std::uint64_t kExact { 1ull << kSubBits };
+     if (value < kExact) {
+         return static_cast<std::size_t>(value);
+     }
+     // Exponent selects a group of 2^kSubBits buckets, the next bits pick one.
+     int shift { BitWidth(value) - 1 - kSubBits };
+     std::uint64_t mantissa { (value >> shift) & (kExact - 1) };
+     return static_cast<std::size_t>(kExact + static_cast<std::uint64_t>(shift) * kExact + mantissa);
+ }
+ 
+ std::uint64_t QuantileSketch::BucketMidpoint(std::size_t bucket) {
+     constexpr std::uint64_t kExact { 1ull << kSubBits };
+     if (bucket < kExact) {
+         return bucket;
+     }
+     std::uint64_t shift { (bucket - kExact) / kExact };
+     std::uint64_t mantissa { (bucket - kExact) % kExact };
+     std::uint64_t lower { (kExact + mantissa) << shift };
+     return lower + ((1ull << shift) >> 1);
+ }
+ 
\ No newline at end of file
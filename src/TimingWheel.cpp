@@ -0,0 +1,249 @@
+/**
+ * @file TimingWheel.cpp
+ * @brief Implements the TimingWheel class.
+ */
+
+ #include "TimingWheel.hpp"
+ #include <algorithm>
+ #include <limits>
+
+ namespace {
+ 
+ int LowestSetBit(std::uint64_t bits)
+ {
+ #if defined(__GNUC__) || defined(__clang__)
+     return __builtin_ctzll(bits);
+ #else
+     int index {};
+     while ((bits & 1u) == 0) {
+         bits >>= 1;
+         ++index;
+     }
+     return index;
+ #endif
+ }
+ 
+ } // namespace
+ 
+ TimingWheel::Timer::Timer(Callback callback)
+     : m_callback{std::move(callback)}
+ {
+ }
+ 
+ TimingWheel::Timer::~Timer() {
+     if (m_list) {
+         m_wheel->Cancel(*this);
+     }
+ }
+ 
+ void TimingWheel::Timer::SetCallback(Callback callback) {
+     m_callback = std::move(callback);
+ }
+ 
+ bool TimingWheel::Timer::IsArmed() const {
+     return m_list != nullptr;
+ }
+ 
+ std::uint64_t TimingWheel::Timer::Deadline() const {
+     return m_deadline;
+ }
+ 
+ TimingWheel::TimingWheel(std::uint64_t now)
+     : m_now{now}
+ {
+ }
+ 
+ TimingWheel::~TimingWheel() {
+     auto disarm = [](Timer* list) {
+         while (list) {
+             Timer* next { list->m_next };
+             list->m_prev = list->m_next = nullptr;
+             list->m_list = nullptr;
+             list->m_slot = -1;
+             list = next;
+         }
+     };
+     for (auto& level : m_slots) {
+         for (Timer* list : level) {
+             disarm(list);
+         }
+     }
+     disarm(m_expired);
+     disarm(m_overflow);
+ }
+ 
+ void TimingWheel::Schedule(Timer& timer, std::uint64_t deadline) {
+     Cancel(timer);
+     timer.m_wheel = this;
+     timer.m_deadline = deadline;
+     Place(timer);
+     ++m_size;
+ }
+ 
+ void TimingWheel::ScheduleAfter(Timer& timer, std::uint64_t delay) {
+     Schedule(timer, m_now + delay);
+ }
+ 
+ void TimingWheel::Cancel(Timer& timer) {
+     if (timer.m_list) {
+         Unlink(timer);
+         --m_size;
+     }
+ }
+ 
+ std::size_t TimingWheel::Advance(std::uint64_t now) {
+     std::size_t fired { FireExpired() };
+     // Jump straight from one slot that needs attention to the next.
+     while (m_size > 0) {
+         std::uint64_t next { NextEventTick() };
+         if (next > now) {
+             break;
+         }
+         m_now = next;
+         ProcessTick();
+         fired += FireExpired();
+     }
+     m_now = std::max(m_now, now);
+     return fired;
+ }
+ 
+ std::uint64_t TimingWheel::Now() const {
+     return m_now;
+ }
+ 
+ std::size_t TimingWheel::Size() const {
+     return m_size;
+ }
+ 
+ std::uint64_t TimingWheel::TicksUntilNextEvent() const {
+     if (m_size == 0) {
+         return std::numeric_limits<std::uint64_t>::max();
+     }
+     return NextEventTick() - m_now;
+ }
+ 
+ void TimingWheel::Place(Timer& timer) {
+     if (timer.m_deadline <= m_now) {
+         Link(timer, m_expired, -1);
+         return;
+     }
+ 
+     // The level is the highest byte in which deadline and now differ.
+     std::uint64_t differing { timer.m_deadline ^ m_now };
+     if (differing >> (kLevels * kSlotBits)) {
+         Link(timer, m_overflow, -1);
+         return;
+     }
+     int level {};
+     while (level + 1 < kLevels && (differing >> ((level + 1) * kSlotBits))) {
+         ++level;
+     }
+     auto slot = static_cast<std::size_t>((timer.m_deadline >> (level * kSlotBits)) & (kSlots - 1));
+     Link(timer, m_slots[level][slot], static_cast<int>(level * kSlots + slot));
+     m_occupied[level][slot / 64] |= std::uint64_t{1} << (slot % 64);
+ }
+ 
+ void TimingWheel::Link(Timer& timer, Timer*& list, int slot) {
+     timer.m_prev = nullptr;
+     timer.m_next = list;
+     if (list) {
+         list->m_prev = &timer;
+     }
+     list = &timer;
+     timer.m_list = &list;
+     timer.m_slot = slot;
+ }
+ 
+ void TimingWheel::Unlink(Timer& timer) {
+     if (timer.m_prev) {
+         timer.m_prev->m_next = timer.m_next;
+     } else {
+         *timer.m_list = timer.m_next;
+     }
+     if (timer.m_next) {
+         timer.m_next->m_prev = timer.m_prev;
+     }
+     if (timer.m_slot >= 0 && *timer.m_list == nullptr) {
+         auto level = static_cast<std::size_t>(timer.m_slot) / kSlots;
+         auto slot = static_cast<std::size_t>(timer.m_slot) % kSlots;
+         m_occupied[level][slot / 64] &= ~(std::uint64_t{1} << (slot % 64));
+     }
+     timer.m_prev = timer.m_next = nullptr;
+     timer.m_list = nullptr;
+     timer.m_slot = -1;
+ }
+ 
+ void TimingWheel::ProcessTick() {
+     constexpr std::uint64_t kWheelMask {(std::uint64_t{1} << (kLevels * kSlotBits)) - 1};
+     if ((m_now & kWheelMask) == 0) {
+         Redistribute(m_overflow);
+     }
+     // Higher levels first: their timers may land in a lower slot due now.
+     for (int level {kLevels - 1}; level >= 0; --level) {
+         std::uint64_t lowerBits { (std::uint64_t{1} << (level * kSlotBits)) - 1 };
+         if ((m_now & lowerBits) == 0) {
+             auto slot = static_cast<std::size_t>((m_now >> (level * kSlotBits)) & (kSlots - 1));
+             Redistribute(m_slots[level][slot]);
+         }
+     }
+ }
+ 
+ void TimingWheel::Redistribute(Timer*& list) {
+     Timer* pending { list };
+     while (pending) {
+         Timer* timer { pending };
+         pending = timer->m_next;
+         Unlink(*timer);
+         Place(*timer);
+     }
+ }
+ 
+ std::size_t TimingWheel::NextOccupiedSlot(int level, std::size_t from) const {
+     for (std::size_t word { from / 64 }; word < kSlots / 64; ++word) {
+         std::uint64_t bits { m_occupied[level][word] };
+         if (word == from / 64) {
+             bits &= ~std::uint64_t{0} << (from % 64);
+         }
+         if (bits) {
+             return word * 64 + static_cast<std::size_t>(LowestSetBit(bits));
+         }
+     }
+     return kSlots;
+ }
+ 
+ std::uint64_t TimingWheel::NextEventTick() const {
+     if (m_expired) {
+         return m_now;
+     }
+ 
+     std::uint64_t next { std::numeric_limits<std::uint64_t>::max() };
+     if (m_overflow) {
+         next = ((m_now >> (kLevels * kSlotBits)) + 1) << (kLevels * kSlotBits);
+     }
+     // An occupied slot needs attention when the wheel reaches its start.
+     for (int level {}; level < kLevels; ++level) {
+         int shift { level * kSlotBits };
+         auto current = static_cast<std::size_t>((m_now >> shift) & (kSlots - 1));
+         std::size_t slot { NextOccupiedSlot(level, current + 1) };
+         if (slot < kSlots) {
+             std::uint64_t blockStart { (m_now >> (shift + kSlotBits)) << (shift + kSlotBits) };
+             next = std::min(next, blockStart | (static_cast<std::uint64_t>(slot) << shift));
+         }
+     }
+     return next;
+ }
+ 
+ std::size_t TimingWheel::FireExpired() {
+     std::size_t fired {};
+     while (m_expired) {
+         Timer& timer { *m_expired };
+         Unlink(timer);
+         --m_size;
+         ++fired;
+         if (timer.m_callback) {
+             timer.m_callback();
+         }
+     }
+     return fired;
+ }
+ 
\ No newline at end of file
@@ -6,11 +6,16 @@
  #include "UserPlayer.hpp"
 
  UserPlayer::UserPlayer(const std::string& userName)
-     : m_name{"[User] " + userName}, m_score{}
+     : m_name{NameInterner::Global().GetName(NameInterner::Global().Intern("[User] " + userName))},
+       m_score{}
  {
  }
  
  std::string UserPlayer::GetName() const {
+     return std::string{m_name};
+ }
+ 
+ std::string_view UserPlayer::GetNameView() const {
      return m_name;
  }
  
@@ -0,0 +1,58 @@
+/**
+ * @file Xoshiro256.cpp
+ * @brief Implements the Xoshiro256 class.
+ */
+
+ #include "Xoshiro256.hpp"
+
+ namespace {
+ 
+ constexpr std::uint64_t RotateLeft(std::uint64_t value, int bits)
+ {
+     return (value << bits) | (value >> (64 - bits));
+ }
+ 
+ } // namespace
+ 
+ Xoshiro256::Xoshiro256(std::uint64_t seed) {
+     for (std::uint64_t& word : m_state) {
+         word = SplitMix64(seed);
+     }
+ }
+ 
+ Xoshiro256 Xoshiro256::ForStream(std::uint64_t masterSeed, std::uint64_t stream) {
+     std::uint64_t mixedStream { stream };
+     std::uint64_t streamKey { SplitMix64(mixedStream) };
+     return Xoshiro256{masterSeed ^ streamKey};
+ }
+ 
+ std::uint64_t Xoshiro256::SplitMix64(std::uint64_t& state) {
+     std::uint64_t z { state += 0x9E3779B97F4A7C15ull };
+     z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+     z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+     return z ^ (z >> 31);
+ }
+ 
+ Xoshiro256::result_type Xoshiro256::operator()() {
+     const std::uint64_t result { RotateLeft(m_state[1] * 5, 7) * 9 };
+     const std::uint64_t shifted { m_state[1] << 17 };
+ 
+     m_state[2] ^= m_state[0];
+     m_state[3] ^= m_state[1];
+     m_state[1] ^= m_state[2];
+     m_state[0] ^= m_state[3];
+     m_state[2] ^= shifted;
+     m_state[3] = RotateLeft(m_state[3], 45);
+     return result;
+ }
+ 
+ std::uint64_t Xoshiro256::NextBelow(std::uint64_t bound) {
+     // Reject the top partial block of the 64-bit range, then reduce.
+     const std::uint64_t limit { max() - max() % bound };
+     std::uint64_t value {};
+     do {
+         value = (*this)();
+     } while (value >= limit);
+     return value % bound;
+ }
+ 
\ No newline at end of file
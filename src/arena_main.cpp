@@ -0,0 +1,86 @@
+/**
+ * @file arena_main.cpp
+ * @brief Entry point for rps_arena, which plays bot matches in parallel.
+ *
+ * Usage: rps_arena <userBot> <computerBot> [matches] [rounds] [moveTimeoutMs]
+ *
+ * A bot is either a built-in strategy name (run in a forked child) or a
+ * command line starting with "exec:", e.g. "exec:./rps_bot random 7",
+ * which is executed with the arena socket as its stdin and stdout.
+ * With a move timeout, a bot that takes longer forfeits the round.
+ */
+
+ #include <chrono>
+ #include <cstdlib>
+ #include <iostream>
+ #include <sstream>
+ #include "BotArena.hpp"
+ #include "MoveStrategies.hpp"
+
+ namespace {
+ 
+ BotSpec ParseBot(const std::string& text, std::uint64_t seed)
+ {
+     BotSpec spec {};
+     spec.name = text;
+ 
+     const std::string execPrefix {"exec:"};
+     if (text.compare(0, execPrefix.size(), execPrefix) == 0) {
+         std::istringstream words{text.substr(execPrefix.size())};
+         for (std::string word; words >> word;) {
+             spec.command.push_back(word);
+         }
+         return spec;
+     }
+ 
+     spec.strategy = [text, seed]() { return MakeMoveStrategy(text, seed); };
+     return spec;
+ }
+ 
+ } // namespace
+ 
+ int main(int argc, char* argv[])
+ {
+     if (argc < 3) {
+         std::cerr << "Usage: rps_arena <userBot> <computerBot> [matches] [rounds] [moveTimeoutMs]\n";
+         return 2;
+     }
+ 
+     int matches { argc > 3 ? std::atoi(argv[3]) : 100 };
+     int rounds { argc > 4 ? std::atoi(argv[4]) : 1000 };
+     int moveTimeoutMs { argc > 5 ? std::atoi(argv[5]) : 0 };
+ 
+     BotArena arena;
+     arena.SetMoveTimeout(std::chrono::milliseconds{moveTimeoutMs});
+     for (int i{}; i < matches; ++i) {
+         // Distinct seeds per side and match keep random bots independent.
+         auto seed = static_cast<std::uint64_t>(i);
+         arena.AddMatch(ParseBot(argv[1], 2 * seed), ParseBot(argv[2], 2 * seed + 1), rounds);
+     }
+ 
+     auto begin = std::chrono::steady_clock::now();
+     std::vector<BotMatchResult> results { arena.Run() };
+     auto end = std::chrono::steady_clock::now();
+ 
+     long userWins {}, computerWins {}, totalRounds {}, invalidRounds {}, timedOutRounds {}, incomplete {};
+     for (const BotMatchResult& result : results) {
+         userWins += result.userScore;
+         computerWins += result.computerScore;
+         totalRounds += result.roundsPlayed;
+         invalidRounds += result.invalidRounds;
+         timedOutRounds += result.timedOutRounds;
+         incomplete += result.completed ? 0 : 1;
+     }
+ 
+     double seconds { std::chrono::duration<double>(end - begin).count() };
+     std::cout << "Matches:          " << results.size() << " (" << incomplete << " incomplete)\n"
+               << "Rounds:           " << totalRounds << " (" << invalidRounds << " invalid, "
+               << timedOutRounds << " timed out)\n"
+               << "Round wins:       " << argv[1] << " " << userWins << ", "
+               << argv[2] << " " << computerWins << "\n"
+               << "Rounds/second:    " << (seconds > 0 ? totalRounds / seconds : 0.0) << "\n"
+               << "Syscalls/round:   "
+               << (totalRounds > 0 ? static_cast<double>(arena.SyscallCount()) / totalRounds : 0.0) << "\n";
+     return incomplete == 0 ? 0 : 1;
+ }
+ 
\ No newline at end of file
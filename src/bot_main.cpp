@@ -0,0 +1,34 @@
+/**
+ * @file bot_main.cpp
+ * @brief Entry point for rps_bot, a built-in strategy speaking BotProtocol.
+ *
+ * Usage: rps_bot <strategy> [seed]
+ *
+ * The bot talks to the arena over its standard input and output, so any
+ * program following BotProtocol can take its place in a BotArena match.
+ */
+
+ #include <cstdlib>
+ #include <iostream>
+ #include <unistd.h>
+ #include "BotClient.hpp"
+ #include "MoveStrategies.hpp"
+
+ int main(int argc, char* argv[])
+ {
+     if (argc < 2) {
+         std::cerr << "Usage: rps_bot <strategy> [seed]\n";
+         return 2;
+     }
+ 
+     std::uint64_t seed { argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0 };
+     std::unique_ptr<IMoveStrategy> strategy { MakeMoveStrategy(argv[1], seed) };
+     if (!strategy) {
+         std::cerr << "Unknown strategy: " << argv[1] << "\n";
+         return 2;
+     }
+ 
+     BotClient client{STDIN_FILENO, STDOUT_FILENO, *strategy};
+     return client.Run();
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+ * @file evolve_main.cpp
+ * @brief Entry point for rps_evolve, which evolves lookup-table strategies.
+ *
+ * Usage:
+ *   rps_evolve [--generations G] [--population P] [--history K]
+ *              [--rounds R] [--matches M] [--opponents a,b,...]
+ *              [--seed S] [--threads T] [--checkpoint FILE]
+ *
+ * Prints one line per generation with the best and mean fitness (round
+ * wins minus losses per round) and the evaluation throughput in matches
+ * per second, then the best genome as a string of R/P/S genes.
+ *
+ * With --checkpoint the population is saved after every generation, and
+ * an existing checkpoint is resumed instead of starting over; its stored
+ * settings take precedence over the command line. G counts generations
+ * from the start of the run, so a resumed run stops at the same point.
+ */
+
+ #include <cstdio>
+ #include <cstdlib>
+ #include <iostream>
+ #include <map>
+ #include <string>
+ #include <vector>
+ #include "StrategyEvolver.hpp"
+
+ namespace {
+ 
+ /**
+  * @brief "--name value" options.
+  */
+ struct Arguments {
+     std::map<std::string, std::string> options {};
+ 
+     std::string Get(const std::string& name, const std::string& fallback) const {
+         auto it = options.find(name);
+         return it != options.end() ? it->second : fallback;
+     }
+ 
+     std::uint64_t Number(const std::string& name, const std::string& fallback) const {
+         return std::strtoull(Get(name, fallback).c_str(), nullptr, 10);
+     }
+ };
+ 
+ std::vector<std::string> SplitList(const std::string& text)
+ {
+     std::vector<std::string> items;
+     std::size_t start {};
+     while (start <= text.size()) {
+         std::size_t comma { text.find(',', start) };
+         if (comma == std::string::npos) {
+             comma = text.size();
+         }
+         if (comma > start) {
+             items.push_back(text.substr(start, comma - start));
+         }
+         start = comma + 1;
+     }
+     return items;
+ }
+ 
+ bool FileExists(const std::string& path)
+ {
+     std::FILE* file { std::fopen(path.c_str(), "rb") };
+     if (file) {
+         std::fclose(file);
+     }
+     return file != nullptr;
+ }
+ 
+ } // namespace
+ 
+ int main(int argc, char* argv[])
+ {
+     Arguments args {};
+     for (int i {1}; i < argc; ++i) {
+         std::string word {argv[i]};
+         if (word.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+             std::cerr << "Usage: rps_evolve [--generations G] [--population P] [--history K] [--rounds R]\n"
+                          "                  [--matches M] [--opponents a,b,...] [--seed S] [--threads T]\n"
+                          "                  [--checkpoint FILE]\n";
+             return 2;
+         }
+         args.options[word.substr(2)] = argv[++i];
+     }
+ 
+     try {
+         auto generations = static_cast<std::uint32_t>(args.Number("generations", "50"));
+         auto threads = static_cast<unsigned>(args.Number("threads", "0"));
+         std::string checkpoint { args.Get("checkpoint", "") };
+ 
+         EvolutionConfig config {};
+         config.masterSeed = args.Number("seed", "0");
+         config.populationSize = static_cast<std::uint32_t>(args.Number("population", "64"));
+         config.historyLength = static_cast<std::uint32_t>(args.Number("history", "2"));
+         config.roundsPerMatch = static_cast<std::uint32_t>(args.Number("rounds", "100"));
+         config.matchesPerOpponent = static_cast<std::uint32_t>(args.Number("matches", "4"));
+         if (args.options.count("opponents") > 0) {
+             config.opponents = SplitList(args.Get("opponents", ""));
+         }
+ 
+         bool resume { !checkpoint.empty() && FileExists(checkpoint) };
+         StrategyEvolver evolver { resume ? StrategyEvolver::LoadCheckpoint(checkpoint, threads)
+                                          : StrategyEvolver{config, threads} };
+         if (resume) {
+             std::cout << "resuming " << checkpoint << " at generation " << evolver.Generation() << "\n";
+         }
+ 
+         std::printf("%10s %12s %12s %14s\n", "generation", "best", "mean", "matches/s");
+         while (evolver.Generation() < generations) {
+             GenerationReport report { evolver.Step() };
+             std::printf("%10u %12.4f %12.4f %14.0f\n", report.generation, report.bestFitness, report.meanFitness,
+                         report.MatchesPerSecond());
+             if (!checkpoint.empty()) {
+                 evolver.SaveCheckpoint(checkpoint);
+             }
+         }
+ 
+         if (evolver.Generation() > 0) {
+             const StrategyGenome& best { evolver.Best() };
+             std::string genes;
+             for (std::uint8_t gene : best.genes) {
+                 genes += "RPS"[gene];
+             }
+             std::cout << "best (k=" << best.historyLength << ", fitness " << evolver.BestFitness() << "): " << genes
+                       << "\n";
+         }
+     } catch (const std::exception& e) {
+         std::cerr << e.what() << "\n";
+         return 1;
+     }
+     return 0;
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,44 @@
+/**
+ * @file http_load_main.cpp
+ * @brief Entry point for rps_http_load, a load generator for rps_http.
+ *
+ * Usage: rps_http_load <port> [connections] [pipelineDepth] [seconds] [address]
+ *
+ * Opens keep-alive connections, creates one session on each and plays
+ * moves for the given time, keeping pipelineDepth requests in flight per
+ * connection. Prints the request rate.
+ */
+
+ #include <cstdlib>
+ #include <iostream>
+ #include "HttpLoadGenerator.hpp"
+
+ int main(int argc, char* argv[])
+ {
+     if (argc < 2) {
+         std::cerr << "Usage: rps_http_load <port> [connections] [pipelineDepth] [seconds] [address]\n";
+         return 2;
+     }
+ 
+     HttpLoadOptions options {};
+     options.port = static_cast<std::uint16_t>(std::atoi(argv[1]));
+     options.connections = argc > 2 ? std::atoi(argv[2]) : 16;
+     options.pipelineDepth = argc > 3 ? std::atoi(argv[3]) : 16;
+     options.duration = std::chrono::milliseconds{argc > 4 ? std::atoi(argv[4]) * 1000 : 5000};
+     if (argc > 5) {
+         options.address = argv[5];
+     }
+ 
+     try {
+         HttpLoadReport report { HttpLoadGenerator{options}.Run() };
+         std::cout << report.requests << " requests in " << report.seconds << " s: "
+                   << static_cast<long long>(report.RequestsPerSecond()) << " requests/s, "
+                   << report.failures << " failures, " << report.meanBatchMicros << " us per batch of "
+                   << options.pipelineDepth << "\n";
+         return report.failures == 0 ? 0 : 1;
+     } catch (const std::exception& e) {
+         std::cerr << e.what() << "\n";
+         return 1;
+     }
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,73 @@
+/**
+ * @file http_main.cpp
+ * @brief Entry point for rps_http, which serves the game API over HTTP.
+ *
+ * Usage: rps_http [port] [address]
+ *
+ * Listens on 127.0.0.1:8080 unless told otherwise and serves until
+ * interrupted. The computer plays uniformly random moves.
+ *
+ *   curl -d '{"user":"Ann","computer":"Bot","rounds":3}' localhost:8080/sessions
+ *   curl -d '{"move":"rock"}' localhost:8080/sessions/1/moves
+ */
+
+ #include <csignal>
+ #include <cstdlib>
+ #include <ctime>
+ #include <iostream>
+ #include "GameSessionFactory.hpp"
+ #include "HttpGameApi.hpp"
+ #include "HttpServer.hpp"
+ #include "Xoshiro256.hpp"
+
+ namespace {
+ 
+ HttpServer* g_server {nullptr};
+ 
+ void StopServer(int)
+ {
+     // Stop() only stores an atomic flag and writes an eventfd.
+     if (g_server) {
+         g_server->Stop();
+     }
+ }
+ 
+ } // namespace
+ 
+ int main(int argc, char* argv[])
+ {
+     HttpServerOptions options {};
+     options.port = static_cast<std::uint16_t>(argc > 1 ? std::atoi(argv[1]) : 8080);
+     if (argc > 2) {
+         options.address = argv[2];
+     }
+ 
+     GameSessionFactory factory;
+     HttpGameApi api{factory, GameMode::ConsoleSinglePlayer};
+     Xoshiro256 random{static_cast<std::uint64_t>(std::time(nullptr))};
+     factory.RegisterGame<GameMode::ConsoleSinglePlayer>([&api, &random]() {
+         return HttpGameApi::MakeSinglePlayerGame(api.PendingSession(), [&random]() {
+             return static_cast<int>(random.NextBelow(3));
+         });
+     });
+ 
+     try {
+         HttpServer server{[&api](const HttpRequest& request, std::string& body) {
+             return api.Handle(request, body);
+         }, options};
+         g_server = &server;
+         std::signal(SIGINT, StopServer);
+         std::signal(SIGTERM, StopServer);
+         std::cout << "Serving on http://" << options.address << ":" << server.Port() << "\n";
+         server.Run();
+         g_server = nullptr;
+ 
+         HttpServerStats stats { server.Stats() };
+         std::cout << stats.requests << " requests on " << stats.connections << " connections\n";
+     } catch (const std::exception& e) {
+         std::cerr << e.what() << "\n";
+         return 1;
+     }
+     return 0;
+ }
+ 
\ No newline at end of file
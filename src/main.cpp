@@ -5,21 +5,93 @@
  * This file creates and configures a GameSessionFactory, registers
  * a SinglePlayerRpsGame (user vs. computer), and runs the game session.
  *
+ * With `--profiles DIR` (on platforms that build the ProfileStore), the
+ * finished match is added to the players' lifetime profiles kept in DIR.
+ * `--mode best-of|first-to|win-by-two` picks a GameMode that may end the
+ * match before the requested number of rounds.
+ *
+ * Builds configured with ROCK_PAPER_SCISSORS_TRACK_ALLOCATIONS print the
+ * heap allocations of the session, per round, and their most frequent
+ * call sites once the match is over.
+ *
  * Note: std::rand() is used here for simplicity. For production,
  *       consider <random> utilities for better randomness.
  */
 
  #include <iostream>
  #include <cstdlib>
+ #include <cstring>
  #include <ctime>
  #include "GameSessionFactory.hpp"
  #include "SinglePlayerRpsGame.hpp"
  #include "UserPlayer.hpp"
  #include "ComputerPlayer.hpp"
  #include "ConsoleMessenger.hpp"
+ #include "MatchRules.hpp"
+ #ifdef ROCK_PAPER_SCISSORS_TRACK_ALLOCATIONS
+ #include "AllocationTracker.hpp"
+ #endif
+ #ifdef ROCK_PAPER_SCISSORS_PROFILES
+ #include "MatchTally.hpp"
+ #include "ProfileStore.hpp"
+ #endif
+ 
+ /**
+  * @brief Maps a `--mode` argument to its GameMode; false if unknown.
+  */
+ static bool ParseGameMode(const char* name, GameMode& mode)
+ {
+     constexpr struct { const char* name; GameMode mode; } kModes[] {
+         {"fixed", GameMode::ConsoleSinglePlayer},
+         {"best-of", GameMode::SinglePlayerBestOf},
+         {"first-to", GameMode::SinglePlayerFirstTo},
+         {"win-by-two", GameMode::SinglePlayerWinByTwo},
+     };
+     for (const auto& entry : kModes) {
+         if (std::strcmp(name, entry.name) == 0) {
+             mode = entry.mode;
+             return true;
+         }
+     }
+     return false;
+ }
  
- int main()
+ int main(int argc, char* argv[])
  {
+     std::string profileDirectory;
+     GameMode mode {GameMode::ConsoleSinglePlayer};
+     for (int i {1}; i < argc; ++i) {
+         if (std::strcmp(argv[i], "--profiles") == 0 && i + 1 < argc) {
+             profileDirectory = argv[++i];
+         } else if (std::strcmp(argv[i], "--mode") == 0 && i + 1 < argc && ParseGameMode(argv[i + 1], mode)) {
+             ++i;
+         } else {
+             std::cout << "Usage: game [--profiles DIR] [--mode fixed|best-of|first-to|win-by-two]\n";
+             return 1;
+         }
+     }
+ 
+     IRoundObserver* observer {nullptr};
+ #ifdef ROCK_PAPER_SCISSORS_PROFILES
+     // Open the store before playing so a bad directory fails fast.
+     std::unique_ptr<ProfileStore> profiles;
+     MatchTally tally;
+     if (!profileDirectory.empty()) {
+         try {
+             profiles = std::make_unique<ProfileStore>(profileDirectory);
+         } catch (const std::exception& e) {
+             std::cout << e.what() << "\n";
+             return 1;
+         }
+         observer = &tally;
+     }
+ #else
+     if (!profileDirectory.empty()) {
+         std::cout << "Player profiles are not supported on this platform.\n";
+         return 1;
+     }
+ #endif
+ 
      // Seed the pseudo-random number generator
      std::srand(static_cast<unsigned>(std::time(nullptr)));
  
@@ -38,20 +110,31 @@
  
      messenger->ShowSetupComplete();
  
+ #ifdef ROCK_PAPER_SCISSORS_TRACK_ALLOCATIONS
+     // Count from here so creating the session is charged to it.
+     AllocationTracker::SetSamplingInterval(1);
+     AllocationObserver allocations {observer};
+     observer = &allocations;
+ #endif
+
      // Create the factory and register our single-player console-based game
      GameSessionFactory factory;
-     factory.RegisterGame(GameMode::ConsoleSinglePlayer, [=]() {
-         return std::make_unique<SinglePlayerRpsGame>(
+     MatchRules rules { MatchRulesFor(mode, rounds) };
+     factory.RegisterGame(mode, [=]() {
+         auto game = std::make_unique<SinglePlayerRpsGame>(
              std::make_shared<UserPlayer>(userName),
              std::make_shared<ComputerPlayer>(computerName),
              std::make_unique<ConsoleMessenger>(),
              rounds,
-             []() { return std::rand(); }
+             []() { return std::rand(); },
+             rules
          );
+         game->SetRoundObserver(observer, 1);
+         return game;
      });
  
      // Create the game session from the factory
-     std::unique_ptr<IGameSession> gameSession = factory.Create(GameMode::ConsoleSinglePlayer);
+     std::unique_ptr<IGameSession> gameSession = factory.Create(mode);
      if (!gameSession) {
          std::cout << "Failed to create game session.\n";
          return 1;
@@ -59,6 +142,21 @@
  
      // Start the game
      gameSession->Play();
+ #ifdef ROCK_PAPER_SCISSORS_TRACK_ALLOCATIONS
+     allocations.Print(std::cout);
+ #endif
+ 
+ #ifdef ROCK_PAPER_SCISSORS_PROFILES
+     if (profiles) {
+         MatchRecord match { tally.Match() };
+         profiles->WaitDurable(profiles->RecordMatch(match));
+         if (auto profile = profiles->Find(match.user.name)) {
+             std::cout << "Lifetime record of " << match.user.name << ": "
+                       << profile->matchesWon << " won, " << profile->matchesLost << " lost, "
+                       << profile->matchesDrawn << " drawn; rating " << profile->rating << "\n";
+         }
+     }
+ #endif
      return 0;
  }
  
\ No newline at end of file
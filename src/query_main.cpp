@@ -0,0 +1,62 @@
+/**
+ * @file query_main.cpp
+ * @brief Entry point for rps_query, which runs queries over round exports.
+ *
+ * Usage: rps_query [--where FILTERS] [--group FIELDS] [--agg AGGREGATES]
+ *                  [--threads N] FILE...
+ *
+ * Example: win rate per user strategy after the opponent played Rock twice
+ *
+ *   rps_query --where computer_move@1=rock,computer_move@2=rock \
+ *             --group user_name --agg count,rate(outcome=user_win) rounds.rcol
+ *
+ * See RoundQuery.hpp for the field, value and aggregate syntax.
+ */
+
+ #include <algorithm>
+ #include <cstdlib>
+ #include <iostream>
+ #include <string>
+ #include <thread>
+ #include <vector>
+ #include "RoundQueryEngine.hpp"
+
+ int main(int argc, char* argv[])
+ {
+     std::string where {};
+     std::string groupBy {};
+     std::string aggregates {};
+     unsigned threads { std::max(1u, std::thread::hardware_concurrency()) };
+     std::vector<std::string> paths {};
+ 
+     for (int i {1}; i < argc; ++i) {
+         std::string word {argv[i]};
+         bool hasValue { i + 1 < argc };
+         if (word == "--where" && hasValue) {
+             where = argv[++i];
+         } else if (word == "--group" && hasValue) {
+             groupBy = argv[++i];
+         } else if (word == "--agg" && hasValue) {
+             aggregates = argv[++i];
+         } else if (word == "--threads" && hasValue) {
+             threads = static_cast<unsigned>(std::atoi(argv[++i]));
+         } else {
+             paths.push_back(word);
+         }
+     }
+     if (paths.empty()) {
+         std::cerr << "Usage: rps_query [--where FILTERS] [--group FIELDS] [--agg AGGREGATES] [--threads N] FILE...\n";
+         return 2;
+     }
+ 
+     try {
+         RoundQuery query { RoundQuery::Parse(where, groupBy, aggregates) };
+         QueryResult result { RoundQueryEngine::Run(query, paths, threads) };
+         std::cout << RoundQueryEngine::Format(query, result);
+         return 0;
+     } catch (const std::exception& error) {
+         std::cerr << error.what() << "\n";
+         return 1;
+     }
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,165 @@
+/**
+ * @file rng_audit_main.cpp
+ * @brief Entry point for rps_rng_audit, which audits computer-move generators.
+ *
+ * Usage:
+ *   rps_rng_audit [--generator NAME[,NAME...]] [--moves N] [--threads T]
+ *                 [--segment N] [--seed S]
+ *
+ * Generators: "rand" (std::rand, as main.cpp uses it), "xoshiro"
+ * (Xoshiro256 streams), "mt19937" and "minstd". Each value v becomes
+ * move v % 3, as in SinglePlayerRpsGame. For every generator the tool
+ * prints the p-value of each test and the moves per second. std::rand
+ * has one global state, so it always runs on one thread.
+ */
+
+ #include <cstdio>
+ #include <cstdlib>
+ #include <iostream>
+ #include <map>
+ #include <random>
+ #include <string>
+ #include <vector>
+ #include "RngAudit.hpp"
+ #include "Xoshiro256.hpp"
+
+ namespace {
+ 
+ /**
+  * @brief "--name value" options.
+  */
+ struct Arguments {
+     std::map<std::string, std::string> options {};
+ 
+     std::string Get(const std::string& name, const std::string& fallback) const {
+         auto it = options.find(name);
+         return it != options.end() ? it->second : fallback;
+     }
+ 
+     /**
+      * @brief Accepts "1000000000" as well as "1e9".
+      */
+     std::uint64_t Number(const std::string& name, const std::string& fallback) const {
+         return static_cast<std::uint64_t>(std::strtod(Get(name, fallback).c_str(), nullptr));
+     }
+ };
+ 
+ std::vector<std::string> SplitList(const std::string& text)
+ {
+     std::vector<std::string> items;
+     std::size_t start {};
+     while (start <= text.size()) {
+         std::size_t comma { text.find(',', start) };
+         if (comma == std::string::npos) {
+             comma = text.size();
+         }
+         if (comma > start) {
+             items.push_back(text.substr(start, comma - start));
+         }
+         start = comma + 1;
+     }
+     return items;
+ }
+ 
+ /**
+  * @brief Returns the factory for a generator name, or nullptr if unknown.
+  */
+ MoveGeneratorFactory MakeFactory(const std::string& name, std::uint64_t seed)
+ {
+     if (name == "rand") {
+         std::srand(static_cast<unsigned>(seed));
+         return [](std::uint64_t) { return std::function<int()>{[]() { return std::rand(); }}; };
+     }
+     if (name == "xoshiro") {
+         return [seed](std::uint64_t segment) {
+             return std::function<int()>{[engine = Xoshiro256::ForStream(seed, segment)]() mutable {
+                 return static_cast<int>(engine() >> 33);
+             }};
+         };
+     }
+     if (name == "mt19937") {
+         return [seed](std::uint64_t segment) {
+             std::uint64_t state { seed ^ (segment * 0x9E3779B97F4A7C15ull) };
+             std::seed_seq sequence { static_cast<std::uint32_t>(Xoshiro256::SplitMix64(state)),
+                                      static_cast<std::uint32_t>(Xoshiro256::SplitMix64(state)) };
+             return std::function<int()>{[engine = std::mt19937{sequence}]() mutable {
+                 return static_cast<int>(engine() >> 1);
+             }};
+         };
+     }
+     if (name == "minstd") {
+         return [seed](std::uint64_t segment) {
+             std::uint64_t state { seed ^ (segment * 0x9E3779B97F4A7C15ull) };
+             auto start = static_cast<std::uint_fast32_t>(Xoshiro256::SplitMix64(state) % 2147483646 + 1);
+             return std::function<int()>{[engine = std::minstd_rand{start}]() mutable {
+                 return static_cast<int>(engine());
+             }};
+         };
+     }
+     return nullptr;
+ }
+ 
+ void PrintTest(const char* name, const RngTestResult& test)
+ {
+     if (test.degreesOfFreedom > 0) {
+         std::printf("  %-12s chi2 %14.3f  df %d  p %.4f\n", name, test.statistic, test.degreesOfFreedom,
+                     test.pValue);
+     } else {
+         std::printf("  %-12s z    %14.3f        p %.4f\n", name, test.statistic, test.pValue);
+     }
+ }
+ 
+ } // namespace
+ 
+ int main(int argc, char* argv[])
+ {
+     Arguments args {};
+     for (int i {1}; i < argc; ++i) {
+         std::string word {argv[i]};
+         if (word.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+             std::cerr << "Usage: rps_rng_audit [--generator rand,xoshiro,mt19937,minstd] [--moves N]\n"
+                          "                     [--threads T] [--segment N] [--seed S]\n";
+             return 2;
+         }
+         args.options[word.substr(2)] = argv[++i];
+     }
+ 
+     try {
+         RngAuditOptions options {};
+         options.moves = args.Number("moves", "1e9");
+         options.segmentMoves = args.Number("segment", "16777216");
+         auto threads = static_cast<unsigned>(args.Number("threads", "0"));
+         std::uint64_t seed { args.Number("seed", "1") };
+ 
+         int worst {0};
+         for (const auto& name : SplitList(args.Get("generator", "rand,xoshiro,mt19937,minstd"))) {
+             MoveGeneratorFactory factory { MakeFactory(name, seed) };
+             if (!factory) {
+                 std::cerr << "Unknown generator: " << name << "\n";
+                 return 2;
+             }
+             options.threads = name == "rand" ? 1 : threads;
+             RngAuditReport report { RngAudit{factory, options}.Run() };
+ 
+             std::printf("%s: %llu moves (R %llu, P %llu, S %llu), %.0f moves/s\n", name.c_str(),
+                         static_cast<unsigned long long>(report.moves),
+                         static_cast<unsigned long long>(report.moveCounts[0]),
+                         static_cast<unsigned long long>(report.moveCounts[1]),
+                         static_cast<unsigned long long>(report.moveCounts[2]), report.MovesPerSecond());
+             PrintTest("frequency", report.frequency);
+             PrintTest("serial", report.serial);
+             PrintTest("correlation", report.correlation);
+             PrintTest("runs", report.runs);
+             PrintTest("run lengths", report.runLengthTest);
+             if (report.MinPValue() < 1e-4) {
+                 std::printf("  SUSPECT: a p-value is below 1e-4\n");
+                 worst = 3;
+             }
+         }
+         return worst;
+     } catch (const std::exception& e) {
+         std::cerr << e.what() << "\n";
+         return 1;
+     }
+ }
+ 
\ No newline at end of file
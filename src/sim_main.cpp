@@ -0,0 +1,305 @@
+/**
+ * @file sim_main.cpp
+ * @brief Entry point for rps_sim, the sharded headless simulator.
+ *
+ * Usage:
+ *   rps_sim run   --seed S --matches N --rounds R --user U --computer C
+ *                 [--shard I/K] --out FILE [--rounds-out FILE]
+ *   rps_sim merge --out FILE [--threads T] FILE...
+ *   rps_sim local --shards K --dir DIR <run options>
+ *   rps_sim print FILE
+ *   rps_sim estimate --user U --computer C [--vs V] [--rounds R] [--seed S]
+ *                 [--width W] [--confidence P] [--threads T] [--independent 1]
+ *   rps_sim exact --user U --computer C [--rounds R] [--check FILE]
+ *
+ * `run` plays one shard of a campaign and writes its result file; shards
+ * may run in separate processes or on separate machines. `merge` combines
+ * any number of result files in parallel. `local` forks one process per
+ * shard, standing in for a cluster, then merges their files. The merged
+ * result is identical however the campaign was sharded. `--rounds-out`
+ * also exports every round of the shard to a columnar file.
+ *
+ * `estimate` plays matches until U's match win probability against C is
+ * known to within W (default 0.01) at confidence P (default 0.95). With
+ * `--vs V` it estimates how much more often U wins against C than V does,
+ * pairing the matches with common random numbers unless `--independent 1`.
+ *
+ * `exact` computes the match outcome probabilities of the stationary
+ * strategies rock, paper, scissors and random without simulating. With
+ * `--check FILE` it compares a campaign's result file with them.
+ */
+
+ #include <cmath>
+ #include <cstdlib>
+ #include <iostream>
+ #include <map>
+ #include <string>
+ #include <sys/wait.h>
+ #include <thread>
+ #include <unistd.h>
+ #include <vector>
+ #include "MatchDistribution.hpp"
+ #include "MatchEstimator.hpp"
+ #include "RoundColumnWriter.hpp"
+ #include "SimulationRunner.hpp"
+
+ namespace {
+ 
+ /**
+  * @brief "--name value" options followed by positional arguments.
+  */
+ struct Arguments {
+     std::map<std::string, std::string> options {};
+     std::vector<std::string> positional {};
+ 
+     std::string Get(const std::string& name, const std::string& fallback = {}) const {
+         auto it = options.find(name);
+         if (it != options.end()) {
+             return it->second;
+         }
+         if (fallback.empty()) {
+             throw std::invalid_argument("Missing option --" + name);
+         }
+         return fallback;
+     }
+ 
+     std::uint64_t Number(const std::string& name, const std::string& fallback = {}) const {
+         return std::strtoull(Get(name, fallback).c_str(), nullptr, 10);
+     }
+ };
+ 
+ Arguments ParseArguments(int argc, char* argv[], int first)
+ {
+     Arguments args {};
+     for (int i { first }; i < argc; ++i) {
+         std::string word {argv[i]};
+         if (word.compare(0, 2, "--") == 0 && i + 1 < argc) {
+             args.options[word.substr(2)] = argv[++i];
+         } else {
+             args.positional.push_back(word);
+         }
+     }
+     return args;
+ }
+ 
+ SimulationConfig ParseConfig(const Arguments& args)
+ {
+     SimulationConfig config {};
+     config.masterSeed = args.Number("seed", "0");
+     config.totalMatches = args.Number("matches");
+     config.roundsPerMatch = static_cast<std::uint32_t>(args.Number("rounds", "1000"));
+     config.userStrategy = args.Get("user");
+     config.computerStrategy = args.Get("computer");
+     return config;
+ }
+ 
+ void Print(const SimulationResult& result)
+ {
+     const SimulationConfig& config { result.Config() };
+     std::cout << "campaign:       " << config.userStrategy << " vs " << config.computerStrategy
+               << ", seed " << config.masterSeed << ", " << config.totalMatches << " matches of "
+               << config.roundsPerMatch << " rounds\n";
+     std::cout << "coverage:       ";
+     for (const auto& range : result.Coverage()) {
+         std::cout << "[" << range.first << ", " << range.second << ") ";
+     }
+     std::cout << (result.IsComplete() ? "(complete)" : "(partial)") << "\n";
+     std::cout << "matches:        " << result.UserMatchWins() << " user / " << result.ComputerMatchWins()
+               << " computer / " << result.DrawnMatches() << " drawn\n";
+     std::cout << "rounds:         " << result.UserRoundWins() << " user / " << result.ComputerRoundWins()
+               << " computer / " << result.DrawnRounds() << " drawn\n";
+     std::cout << "rating delta:   " << result.UserRatingDeltaMilli() / 1000.0 << " (user, summed)\n";
+     std::cout << "margin buckets:";
+     for (std::uint64_t count : result.MarginHistogram()) {
+         std::cout << " " << count;
+     }
+     std::cout << "\n";
+ }
+ 
+ int RunCommand(const Arguments& args)
+ {
+     std::uint64_t index {0};
+     std::uint64_t count {1};
+     std::string shard { args.Get("shard", "0/1") };
+     auto slash = shard.find('/');
+     if (slash != std::string::npos) {
+         index = std::strtoull(shard.substr(0, slash).c_str(), nullptr, 10);
+         count = std::strtoull(shard.substr(slash + 1).c_str(), nullptr, 10);
+     }
+ 
+     SimulationRunner runner{ParseConfig(args)};
+     if (args.options.count("rounds-out") == 0) {
+         runner.RunShard(index, count).Save(args.Get("out"));
+         return 0;
+     }
+ 
+     RoundColumnWriter rounds{args.Get("rounds-out")};
+     runner.RunShard(index, count, &rounds).Save(args.Get("out"));
+     rounds.Close();
+     return 0;
+ }
+ 
+ int MergeCommand(const Arguments& args)
+ {
+     auto threads = static_cast<unsigned>(args.Number("threads", std::to_string(std::thread::hardware_concurrency())));
+     SimulationResult merged { SimulationResult::MergeFiles(args.positional, threads) };
+     merged.Save(args.Get("out"));
+     Print(merged);
+     return 0;
+ }
+ 
+ int LocalCommand(const Arguments& args)
+ {
+     std::uint64_t shards { args.Number("shards") };
+     std::string dir { args.Get("dir") };
+     SimulationRunner runner{ParseConfig(args)};
+ 
+     std::vector<std::string> paths;
+     std::vector<pid_t> children;
+     for (std::uint64_t index{}; index < shards; ++index) {
+         paths.push_back(dir + "/shard-" + std::to_string(index) + ".rsim");
+         pid_t pid { ::fork() };
+         if (pid < 0) {
+             std::cerr << "fork failed\n";
+             return 1;
+         }
+         if (pid == 0) {
+             try {
+                 runner.RunShard(index, shards).Save(paths.back());
+                 ::_exit(0);
+             } catch (const std::exception& error) {
+                 std::cerr << "shard " << index << ": " << error.what() << "\n";
+                 ::_exit(1);
+             }
+         }
+         children.push_back(pid);
+     }
+ 
+     int failures {};
+     for (pid_t child : children) {
+         int status {};
+         ::waitpid(child, &status, 0);
+         failures += !(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+     }
+     if (failures > 0) {
+         std::cerr << failures << " shard(s) failed\n";
+         return 1;
+     }
+ 
+     SimulationResult merged { SimulationResult::MergeFiles(paths, std::thread::hardware_concurrency()) };
+     merged.Save(dir + "/merged.rsim");
+     Print(merged);
+     return 0;
+ }
+ 
+ int EstimateCommand(const Arguments& args)
+ {
+     MatchEstimatorOptions options {};
+     options.roundsPerMatch = static_cast<std::uint32_t>(args.Number("rounds", "21"));
+     options.masterSeed = args.Number("seed", "0");
+     options.halfWidth = std::strtod(args.Get("width", "0.01").c_str(), nullptr);
+     options.confidence = std::strtod(args.Get("confidence", "0.95").c_str(), nullptr);
+     options.threads = static_cast<unsigned>(args.Number("threads", "0"));
+     options.commonRandomNumbers = args.Number("independent", "0") == 0;
+     MatchEstimator estimator{options};
+ 
+     std::string user { args.Get("user") };
+     std::string computer { args.Get("computer") };
+     if (args.options.count("vs") == 0) {
+         WinEstimate estimate { estimator.EstimateWin(user, computer) };
+         std::cout << user << " vs " << computer << ", " << options.roundsPerMatch << " rounds: P(win) "
+                   << estimate.winProbability << " [" << estimate.lower << ", " << estimate.upper << "]\n";
+         std::cout << "matches:        " << estimate.wins << " won / " << estimate.losses << " lost / "
+                   << estimate.draws << " drawn in " << estimate.looks << " looks, "
+                   << estimate.seconds << " s" << (estimate.converged ? "" : " (max matches reached)") << "\n";
+         return 0;
+     }
+ 
+     std::string other { args.Get("vs") };
+     WinDifference difference { estimator.CompareWin(user, other, computer) };
+     std::cout << user << " vs " << computer << ": P(win) " << difference.firstWinProbability << "\n";
+     std::cout << other << " vs " << computer << ": P(win) " << difference.secondWinProbability << "\n";
+     std::cout << "difference:     " << difference.difference << " [" << difference.lower << ", "
+               << difference.upper << "]\n";
+     std::cout << "matches:        " << difference.matches << " pairs in " << difference.looks << " looks, "
+               << difference.seconds << " s, variance reduction " << difference.varianceReduction
+               << (difference.converged ? "" : " (max matches reached)") << "\n";
+     return 0;
+ }
+ 
+ int ExactCommand(const Arguments& args)
+ {
+     std::string user { args.Get("user") };
+     std::string computer { args.Get("computer") };
+     auto userMix = MatchDistribution::ForStrategy(user);
+     auto computerMix = MatchDistribution::ForStrategy(computer);
+     if (!userMix || !computerMix) {
+         throw std::invalid_argument("exact needs stationary strategies: rock, paper, scissors or random");
+     }
+     auto rounds = static_cast<std::uint32_t>(args.Number("rounds", "21"));
+     MatchDistribution exact { MatchDistribution::Compute(*userMix, *computerMix, rounds) };
+     std::cout << user << " vs " << computer << ", " << rounds << " rounds: P(win) " << exact.UserWinProbability()
+               << ", P(draw) " << exact.DrawProbability() << ", P(loss) " << exact.ComputerWinProbability() << "\n";
+     std::cout << "margin:         mean " << exact.MeanMargin() << ", variance " << exact.MarginVariance()
+               << ", truncated mass " << exact.TruncatedMass() << "\n";
+     if (args.options.count("check") == 0) {
+         return 0;
+     }
+ 
+     SimulationResult result { SimulationResult::Load(args.Get("check")) };
+     const SimulationConfig& config { result.Config() };
+     if (config.userStrategy != user || config.computerStrategy != computer || config.roundsPerMatch != rounds) {
+         throw std::invalid_argument("the result file is for a different campaign");
+     }
+     double n { static_cast<double>(result.Matches()) };
+     double worst {};
+     auto report = [&](const char* label, std::uint64_t count, double p) {
+         double z { p > 0.0 && p < 1.0 ? (static_cast<double>(count) - n * p) / std::sqrt(n * p * (1.0 - p)) : 0.0 };
+         worst = std::max(worst, std::fabs(z));
+         std::cout << label << static_cast<double>(count) / n << " simulated, z = " << z << "\n";
+     };
+     report("wins:           ", result.UserMatchWins(), exact.UserWinProbability());
+     report("draws:          ", result.DrawnMatches(), exact.DrawProbability());
+     report("losses:         ", result.ComputerMatchWins(), exact.ComputerWinProbability());
+     return worst > 5.0 ? 1 : 0;
+ }
+ 
+ } // namespace
+ 
+ int main(int argc, char* argv[])
+ {
+     if (argc < 2) {
+         std::cerr << "Usage: rps_sim run|merge|local|print|estimate|exact ...\n";
+         return 2;
+     }
+ 
+     try {
+         std::string command {argv[1]};
+         Arguments args { ParseArguments(argc, argv, 2) };
+         if (command == "run") {
+             return RunCommand(args);
+         }
+         if (command == "merge") {
+             return MergeCommand(args);
+         }
+         if (command == "local") {
+             return LocalCommand(args);
+         }
+         if (command == "estimate") {
+             return EstimateCommand(args);
+         }
+         if (command == "exact") {
+             return ExactCommand(args);
+         }
+         if (command == "print" && args.positional.size() == 1) {
+             Print(SimulationResult::Load(args.positional.front()));
+             return 0;
+         }
+         std::cerr << "Unknown command: " << command << "\n";
+         return 2;
+     } catch (const std::exception& error) {
+         std::cerr << error.what() << "\n";
+         return 1;
+     }
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,218 @@
+/**
+ * @file test_AllocationTracker.cpp
+ * @brief Unit tests and allocation budgets using the AllocationTracker.
+ *
+ * ## Test Strategy
+ * rps_tests replaces the global operator new and delete, so the tracker
+ * sees every allocation of the thread under test. Known allocations check
+ * the counts, a second thread checks that counters are per-thread, and a
+ * sampled helper checks call-site sampling. The budgets then play real
+ * sessions (real players, a silent messenger) through the factory and
+ * fail if creating a session or playing a round allocates more than it
+ * does today.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Allocations on this thread are counted
+ *   Given an AllocationScope
+ *   When an array of 100 ints is allocated and freed
+ *   Then the scope counts one allocation of 400 bytes and one free
+ *
+ * ### Scenario: Other threads' allocations are not counted
+ *   Given a running thread and an AllocationScope on the main thread
+ *   When the thread allocates 100 times and is joined
+ *   Then the thread counts 100 allocations and the main scope none
+ *
+ * ### Scenario: Call sites are sampled
+ *   Given a sampling interval of 1
+ *   When one function allocates 10 times
+ *   Then its call site has at least 10 samples
+ *
+ * ### Scenario: Creating a session stays within budget
+ *   Given a factory with a registered single-player game
+ *   When a session is created
+ *   Then it allocates at most kSessionBudget times
+ *
+ * ### Scenario: Rounds do not allocate
+ *   Given a session observed by an AllocationObserver that forwards to another observer
+ *   When 200 rounds are played
+ *   Then no round allocates, the session is reported and the next observer sees every round
+ */
+
+ #include <gtest/gtest.h>
+ #include <atomic>
+ #include <memory>
+ #include <string>
+ #include <thread>
+ #include "AllocationTracker.hpp"
+ #include "ComputerPlayer.hpp"
+ #include "GameSessionFactory.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "UserPlayer.hpp"
+
+ namespace {
+
+ /**
+  * @brief Keeps allocations observable so the compiler cannot elide them.
+  */
+ void* volatile g_sink {};
+
+ /**
+  * @brief Allocations a session makes when it is created: the session,
+  *        its messenger, both players, and the two nodes and bucket array
+  *        of the game's player table.
+  */
+ constexpr std::uint64_t kSessionBudget {7};
+
+ /**
+  * @brief A messenger that plays rock forever and shows nothing.
+  */
+ class SilentMessenger : public IGameMessenger {
+ public:
+     void ShowWelcomeScreen() override {}
+     std::string RequestUserPlayerName() override { return {}; }
+     std::string RequestComputerPlayerName() override { return {}; }
+     int RequestNumberOfRounds() override { return 0; }
+     void ShowSetupComplete() override {}
+     int RequestMoveChoice() override { return 1; }
+
+     std::size_t RequestMoveChoices(int* moves, std::size_t maxCount) override {
+         for (std::size_t i{}; i < maxCount; ++i) {
+             moves[i] = 1;
+         }
+         return maxCount;
+     }
+
+     void DisplayChosenMove(const std::shared_ptr<IPlayer>&, GameMove) override {}
+     void AnnounceRoundWinner(const std::shared_ptr<IPlayer>&) override {}
+     void AnnounceDraw() override {}
+     void ShowFinalScore(const std::shared_ptr<IPlayer>&, const std::shared_ptr<IPlayer>&) override {}
+     void ShowInvalidInputMessage() override {}
+ };
+
+ /**
+  * @brief Counts what an AllocationObserver forwards.
+  */
+ class CountingObserver : public IRoundObserver {
+ public:
+     void OnRound(const RoundRecord&) override { ++rounds; }
+     void OnSessionEnd(const SessionSummary&) override { ++sessions; }
+
+     int rounds {};
+     int sessions {};
+ };
+
+ void AllocateTenTimes() {
+     for (int i{}; i < 10; ++i) {
+         g_sink = new int {i};
+         delete static_cast<int*>(g_sink);
+     }
+ }
+
+ GameSessionFactory& Factory(int rounds) {
+     static GameSessionFactory factory;
+     factory.RegisterGame(GameMode::ConsoleSinglePlayer, [rounds]() -> std::unique_ptr<IGameSession> {
+         return std::make_unique<SinglePlayerRpsGame>(
+             std::make_shared<UserPlayer>("Alice"),
+             std::make_shared<ComputerPlayer>("Hal"),
+             std::make_unique<SilentMessenger>(),
+             rounds,
+             []() { return 2; });
+     });
+     return factory;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verify that the calling thread's allocations are counted.
+  */
+ TEST(AllocationTrackerTest, CountsThisThreadsAllocations) {
+     ASSERT_TRUE(AllocationTracker::Enabled());
+     AllocationScope scope;
+     g_sink = new int[100];
+     AllocationCounts allocated { scope.Counts() };
+     delete[] static_cast<int*>(g_sink);
+     AllocationCounts freed { scope.Counts() };
+
+     EXPECT_EQ(allocated.allocations, 1u);
+     EXPECT_EQ(allocated.bytes, 100 * sizeof(int));
+     EXPECT_EQ(allocated.deallocations, 0u);
+     EXPECT_EQ(freed.deallocations, 1u);
+ }
+
+ /**
+  * @test Verify that another thread's allocations are not counted here.
+  */
+ TEST(AllocationTrackerTest, OtherThreadsAreNotCounted) {
+     std::atomic<bool> go {false};
+     std::uint64_t threadAllocations {};
+     std::thread worker([&]() {
+         while (!go.load()) {
+             std::this_thread::yield();
+         }
+         AllocationScope scope;
+         for (int i{}; i < 100; ++i) {
+             g_sink = new int {i};
+             delete static_cast<int*>(g_sink);
+         }
+         threadAllocations = scope.Counts().allocations;
+     });
+     AllocationScope scope;
+     go.store(true);
+     worker.join();
+
+     EXPECT_EQ(threadAllocations, 100u);
+     EXPECT_EQ(scope.Counts().allocations, 0u);
+ }
+
+ /**
+  * @test Verify that call sites are sampled.
+  */
+ TEST(AllocationTrackerTest, SamplesCallSites) {
+     AllocationTracker::ClearThreadCallSites();
+     AllocationTracker::SetSamplingInterval(1);
+     AllocateTenTimes();
+     AllocationTracker::SetSamplingInterval(0);
+     std::vector<AllocationCallSite> sites { AllocationTracker::ThreadCallSites() };
+
+     ASSERT_FALSE(sites.empty());
+     EXPECT_GE(sites.front().samples, 10u);
+     EXPECT_EQ(AllocationTracker::ThreadDroppedSamples(), 0u);
+     AllocationTracker::ClearThreadCallSites();
+ }
+
+ /**
+  * @test Verify the allocation budget of creating a session.
+  */
+ TEST(AllocationTrackerTest, SessionCreationWithinBudget) {
+     GameSessionFactory& factory { Factory(10) };
+     factory.Create(GameMode::ConsoleSinglePlayer);  // interns the names once
+     AllocationScope scope;
+     std::unique_ptr<IGameSession> session { factory.Create(GameMode::ConsoleSinglePlayer) };
+     AllocationCounts created { scope.Counts() };
+
+     ASSERT_NE(session, nullptr);
+     EXPECT_LE(created.allocations, kSessionBudget);
+ }
+
+ /**
+  * @test Verify that rounds do not allocate.
+  */
+ TEST(AllocationTrackerTest, RoundsDoNotAllocate) {
+     std::unique_ptr<IGameSession> session { Factory(200).Create(GameMode::ConsoleSinglePlayer) };
+     auto* game { static_cast<SinglePlayerRpsGame*>(session.get()) };
+     CountingObserver next;
+     AllocationObserver allocations {&next};
+     game->SetRoundObserver(&allocations, 7);
+     allocations.Reset();
+     session->Play();
+     AllocationObserver::Report report { allocations.Snapshot() };
+
+     EXPECT_EQ(report.sessions, 1u);
+     EXPECT_EQ(report.rounds, 200u);
+     EXPECT_EQ(report.roundAllocations, 0u);
+     EXPECT_EQ(report.maxRoundAllocations, 0u);
+     EXPECT_EQ(next.rounds, 200);
+     EXPECT_EQ(next.sessions, 1);
+ }
+ 
\ No newline at end of file
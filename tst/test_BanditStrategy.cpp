@@ -0,0 +1,174 @@
+/**
+ * @file test_BanditStrategy.cpp
+ * @brief Unit tests for BanditStrategy.
+ *
+ * ## Test Strategy
+ * Each policy plays long games against opponents whose best response is
+ * known and must settle on the arm that plays it. A recording arm checks
+ * that every arm observes every round whether or not it was chosen, and
+ * the seeded policies must replay identically.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Every policy finds the best arm
+ *   Given the built-in portfolio and an opponent that always plays Rock
+ *   When 2000 rounds are played with UCB1, Thompson sampling and EXP3
+ *   Then the arms that play Paper are chosen most and most late rounds are won
+ *
+ * ### Scenario: Unchosen arms keep observing
+ *   Given two recording arms
+ *   When rounds are played
+ *   Then both arms observe every round with their own proposal
+ *
+ * ### Scenario: The selector follows a changing opponent
+ *   Given the three constant strategies as arms
+ *   And an opponent that switches from Rock to Scissors
+ *   When UCB1 plays on, with and without a discount
+ *   Then it wins most rounds after the switch
+ *
+ * ### Scenario: Seeded policies replay and bad options are rejected
+ *   Given two selectors with the same seed
+ *   Then they play the same moves
+ *   And empty portfolios or out-of-range options throw
+ */
+
+ #include <gtest/gtest.h>
+ #include <memory>
+ #include <stdexcept>
+ #include <vector>
+ #include "BanditStrategy.hpp"
+ #include "GameRules.hpp"
+ #include "MoveStrategies.hpp"
+
+ namespace {
+
+ class RecordingArm : public IMoveStrategy {
+ public:
+     RecordingArm(GameMove move, int& observed, int& mismatched)
+         : m_move{move}, m_observed{observed}, m_mismatched{mismatched} {}
+
+     GameMove NextMove() override { return m_move; }
+     void ObserveRound(GameMove ownMove, GameMove) override {
+         ++m_observed;
+         if (ownMove != m_move) {
+             ++m_mismatched;
+         }
+     }
+     bool DependsOnHistory() const override { return false; }
+
+ private:
+     GameMove m_move {};
+     int& m_observed;
+     int& m_mismatched;
+ };
+
+ /**
+  * @brief Plays `rounds` rounds against `opponent`; returns the wins among the last `tail`.
+  */
+ int Play(IMoveStrategy& player, IMoveStrategy& opponent, int rounds, int tail) {
+     int wins {};
+     for (int round{}; round < rounds; ++round) {
+         GameMove own { player.NextMove() };
+         GameMove other { opponent.NextMove() };
+         if (round >= rounds - tail && DoesFirstMoveWin(own, other)) {
+             ++wins;
+         }
+         player.ObserveRound(own, other);
+         opponent.ObserveRound(other, own);
+     }
+     return wins;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies that each policy settles on the best arm.
+  */
+ TEST(BanditStrategyTest, EveryPolicyFindsTheBestArm)
+ {
+     for (BanditPolicy policy : {BanditPolicy::Ucb1, BanditPolicy::Thompson, BanditPolicy::Exp3}) {
+         auto bandit = BanditStrategy::WithBuiltinPortfolio({policy, 1.0, 0.1, 3});
+         ConstantStrategy rock{GameMove::Rock};
+         int wins { Play(*bandit, rock, 2000, 500) };
+         EXPECT_GT(wins, 400) << static_cast<int>(policy);
+
+         // Against Rock, arm 1 (always Paper) and arm 5 (counter the last move) both win.
+         EXPECT_GT(bandit->Pulls(1) + bandit->Pulls(5), 1600u) << static_cast<int>(policy);
+     }
+ }
+
+ /**
+  * @test Verifies that arms observe rounds they were not chosen for.
+  */
+ TEST(BanditStrategyTest, UnchosenArmsKeepObserving)
+ {
+     int observed[2] {};
+     int mismatched[2] {};
+     std::vector<std::unique_ptr<IMoveStrategy>> arms;
+     arms.push_back(std::make_unique<RecordingArm>(GameMove::Rock, observed[0], mismatched[0]));
+     arms.push_back(std::make_unique<RecordingArm>(GameMove::Paper, observed[1], mismatched[1]));
+     BanditStrategy bandit{std::move(arms), {}};
+     EXPECT_TRUE(bandit.DependsOnHistory());
+
+     CycleStrategy opponent;
+     Play(bandit, opponent, 30, 0);
+     // A round observed without a NextMove() still reaches every arm.
+     bandit.ObserveRound(GameMove::Rock, GameMove::Rock);
+     for (int arm{}; arm < 2; ++arm) {
+         EXPECT_EQ(observed[arm], 31);
+         EXPECT_EQ(mismatched[arm], 0);
+     }
+     EXPECT_EQ(bandit.Pulls(0) + bandit.Pulls(1), 30u);
+ }
+
+ /**
+  * @test Verifies that UCB1 follows a changing opponent.
+  */
+ TEST(BanditStrategyTest, SelectorFollowsChangingOpponent)
+ {
+     auto winsAfterSwitch = [](double discount) {
+         std::vector<std::unique_ptr<IMoveStrategy>> arms;
+         for (GameMove move : {GameMove::Rock, GameMove::Paper, GameMove::Scissors}) {
+             arms.push_back(std::make_unique<ConstantStrategy>(move));
+         }
+         BanditStrategy bandit{std::move(arms), {BanditPolicy::Ucb1, discount, 0.1, 0}};
+         ConstantStrategy rock{GameMove::Rock};
+         ConstantStrategy scissors{GameMove::Scissors};
+         Play(bandit, rock, 2000, 0);
+         return Play(bandit, scissors, 500, 400);
+     };
+     EXPECT_GT(winsAfterSwitch(0.99), 300);
+     EXPECT_GT(winsAfterSwitch(1.0), 300);
+ }
+
+ /**
+  * @test Verifies seeded replay and option validation.
+  */
+ TEST(BanditStrategyTest, SeededPoliciesReplayAndBadOptionsAreRejected)
+ {
+     for (BanditPolicy policy : {BanditPolicy::Thompson, BanditPolicy::Exp3}) {
+         auto a = BanditStrategy::WithBuiltinPortfolio({policy, 1.0, 0.1, 11});
+         auto b = BanditStrategy::WithBuiltinPortfolio({policy, 1.0, 0.1, 11});
+         RandomStrategy opponent{5};
+         for (int round{}; round < 200; ++round) {
+             GameMove move { a->NextMove() };
+             ASSERT_EQ(move, b->NextMove()) << round;
+             GameMove other { opponent.NextMove() };
+             a->ObserveRound(move, other);
+             b->ObserveRound(move, other);
+         }
+     }
+
+     for (const char* name : {"ucb1", "thompson", "exp3"}) {
+         auto strategy = MakeMoveStrategy(name, 1);
+         ASSERT_NE(strategy, nullptr) << name;
+         EXPECT_TRUE(strategy->DependsOnHistory());
+     }
+
+     EXPECT_THROW(BanditStrategy({}, {}), std::invalid_argument);
+     EXPECT_THROW(BanditStrategy::WithBuiltinPortfolio({BanditPolicy::Ucb1, 0.0, 0.1, 0}), std::invalid_argument);
+     EXPECT_THROW(BanditStrategy::WithBuiltinPortfolio({BanditPolicy::Exp3, 1.0, 1.5, 0}), std::invalid_argument);
+     std::vector<std::unique_ptr<IMoveStrategy>> arms;
+     arms.push_back(nullptr);
+     EXPECT_THROW(BanditStrategy(std::move(arms), {}), std::invalid_argument);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,244 @@
+/**
+ * @file test_BotArena.cpp
+ * @brief Integration tests for the BotArena class using Google Test.
+ *
+ * ## Test Strategy
+ * Real child processes are forked running built-in strategies, so the
+ * whole path (fork, Hello, batched Requests, history, Bye, reaping) is
+ * exercised. Outcomes of deterministic strategies are known exactly.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Deterministic bots produce the expected score
+ *   Given "paper" versus "rock" for 600 rounds
+ *   When the arena runs
+ *   Then the user side wins all 600 rounds
+ *   And far fewer than one socket syscall per round was needed
+ *
+ * ### Scenario: History-dependent bots see the opponent's moves
+ *   Given "counter" versus "rock"
+ *   When the arena runs
+ *   Then the counter bot wins every round after the first
+ *
+ * ### Scenario: Many matches run concurrently
+ *   Given 40 random-versus-cycle matches
+ *   When the arena runs
+ *   Then every match completes with all rounds accounted for
+ *
+ * ### Scenario: A crashing bot ends its match without hanging
+ *   Given a bot whose strategy cannot be created
+ *   When the arena runs
+ *   Then the match is reported incomplete
+ *
+ * ### Scenario: A slow bot forfeits the rounds it is late for
+ *   Given a bot needing 70 ms per move and a 20 ms move deadline
+ *   When the arena runs
+ *   Then the match completes with at least one forfeited round
+ *   And an unrelated match in the same arena is unaffected
+ *
+ * ### Scenario: The match deadline ends a stalled match
+ *   Given a bot that never answers and a 100 ms match deadline
+ *   When the arena runs
+ *   Then every round is forfeited and Run() returns promptly
+ *
+ * ### Scenario: A launched program receives its arguments
+ *   Given the command `sh -c "exit 7"`
+ *   When it is launched and waited for
+ *   Then its exit status is 7
+ *
+ * ### Scenario: A bot that exits on end of stream is not killed
+ *   Given a bot that needs 10 ms to clean up after its socket closes
+ *   When its BotProcess is destroyed
+ *   Then the bot finishes its clean-up before it is reaped
+ */
+
+ #include <gtest/gtest.h>
+ #include <chrono>
+ #include <fcntl.h>
+ #include <string>
+ #include <thread>
+ #include <unistd.h>
+ #include "BotArena.hpp"
+ #include "BotProcess.hpp"
+ #include "MoveStrategies.hpp"
+
+ namespace {
+
+ BotSpec Builtin(const std::string& name, std::uint64_t seed = 0)
+ {
+     BotSpec spec {};
+     spec.name = name;
+     spec.strategy = [name, seed]() { return MakeMoveStrategy(name, seed); };
+     return spec;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies deterministic scores and batching.
+  */
+ TEST(BotArenaTest, DeterministicBotsProduceExpectedScore)
+ {
+     BotArena arena;
+     arena.AddMatch(Builtin("paper"), Builtin("rock"), 600);
+     auto results = arena.Run();
+
+     ASSERT_EQ(results.size(), 1u);
+     EXPECT_TRUE(results[0].completed);
+     EXPECT_EQ(results[0].roundsPlayed, 600);
+     EXPECT_EQ(results[0].userScore, 600);
+     EXPECT_EQ(results[0].computerScore, 0);
+     EXPECT_EQ(results[0].invalidRounds, 0);
+     EXPECT_LT(arena.SyscallCount(), 600u / 10);
+ }
+
+ /**
+  * @test Verifies that history reaches history-dependent bots.
+  */
+ TEST(BotArenaTest, HistoryReachesBots)
+ {
+     BotArena arena;
+     arena.AddMatch(Builtin("counter"), Builtin("rock"), 50);
+     auto results = arena.Run();
+
+     ASSERT_EQ(results.size(), 1u);
+     EXPECT_TRUE(results[0].completed);
+     // Round one: Rock vs Rock is a draw; then Paper beats Rock every time.
+     EXPECT_EQ(results[0].userScore, 49);
+     EXPECT_EQ(results[0].computerScore, 0);
+ }
+
+ /**
+  * @test Verifies that many matches run to completion together.
+  */
+ TEST(BotArenaTest, ManyMatchesRunConcurrently)
+ {
+     BotArena arena;
+     for (int i{}; i < 40; ++i) {
+         arena.AddMatch(Builtin("random", static_cast<std::uint64_t>(i)), Builtin("cycle"), 100);
+     }
+     auto results = arena.Run();
+
+     ASSERT_EQ(results.size(), 40u);
+     for (const auto& result : results) {
+         EXPECT_TRUE(result.completed);
+         EXPECT_EQ(result.roundsPlayed, 100);
+         EXPECT_LE(result.userScore + result.computerScore, 100);
+     }
+ }
+
+ /**
+  * @test Verifies that a failing bot ends its match without hanging the arena.
+  */
+ TEST(BotArenaTest, CrashingBotEndsMatch)
+ {
+     BotArena arena;
+     arena.AddMatch(Builtin("nonsense"), Builtin("rock"), 10);
+     arena.AddMatch(Builtin("rock"), Builtin("scissors"), 10);
+     auto results = arena.Run();
+
+     ASSERT_EQ(results.size(), 2u);
+     EXPECT_FALSE(results[0].completed);
+     EXPECT_EQ(results[0].roundsPlayed, 0);
+     EXPECT_TRUE(results[1].completed);
+     EXPECT_EQ(results[1].userScore, 10);
+ }
+ 
+ namespace {
+
+ /**
+  * @brief A history-dependent strategy that takes `delay` to choose each move.
+  */
+ class SlowStrategy : public IMoveStrategy {
+ public:
+     explicit SlowStrategy(std::chrono::milliseconds delay) : m_delay{delay} {}
+
+     GameMove NextMove() override {
+         std::this_thread::sleep_for(m_delay);
+         return GameMove::Rock;
+     }
+     void ObserveRound(GameMove, GameMove) override {}
+     bool DependsOnHistory() const override { return true; }
+
+ private:
+     std::chrono::milliseconds m_delay;
+ };
+
+ BotSpec Slow(std::chrono::milliseconds delay)
+ {
+     BotSpec spec {};
+     spec.name = "slow";
+     spec.strategy = [delay]() { return std::make_unique<SlowStrategy>(delay); };
+     return spec;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies that a bot missing its move deadline forfeits rounds.
+  */
+ TEST(BotArenaTest, MissedMoveDeadlineForfeitsRound)
+ {
+     BotArena arena;
+     arena.SetMoveTimeout(std::chrono::milliseconds{20});
+     arena.AddMatch(Slow(std::chrono::milliseconds{70}), Builtin("scissors"), 4);
+     arena.AddMatch(Builtin("rock"), Builtin("scissors"), 4);
+     auto results = arena.Run();
+
+     ASSERT_EQ(results.size(), 2u);
+     EXPECT_TRUE(results[0].completed);
+     EXPECT_EQ(results[0].roundsPlayed, 4);
+     EXPECT_GE(results[0].timedOutRounds, 1);
+     EXPECT_EQ(results[0].userScore + results[0].timedOutRounds, 4);
+     EXPECT_EQ(results[1].timedOutRounds, 0);
+     EXPECT_EQ(results[1].userScore, 4);
+ }
+
+ /**
+  * @test Verifies that a silent bot cannot pin its match past the match deadline.
+  */
+ TEST(BotArenaTest, MatchDeadlineForfeitsRemainingRounds)
+ {
+     BotArena arena;
+     arena.SetMatchTimeout(std::chrono::milliseconds{100});
+     arena.AddMatch(Slow(std::chrono::seconds{30}), Builtin("rock"), 10);
+
+     auto begin = std::chrono::steady_clock::now();
+     auto results = arena.Run();
+     auto elapsed = std::chrono::steady_clock::now() - begin;
+
+     ASSERT_EQ(results.size(), 1u);
+     EXPECT_TRUE(results[0].completed);
+     EXPECT_EQ(results[0].roundsPlayed, 10);
+     EXPECT_EQ(results[0].timedOutRounds, 10);
+     EXPECT_LT(elapsed, std::chrono::seconds{5});
+ }
+
+ /**
+  * @test Verifies that Launch passes the command line to the program.
+  */
+ TEST(BotProcessTest, LaunchPassesArguments)
+ {
+     BotProcess bot { BotProcess::Launch({"sh", "-c", "exit 7"}) };
+     EXPECT_EQ(bot.Wait(), 7);
+ }
+
+ /**
+  * @test Verifies that a bot exiting on end of stream gets to finish.
+  */
+ TEST(BotProcessTest, GracefulExitIsNotKilled)
+ {
+     const std::string marker { "/tmp/rps-bot-exit-" + std::to_string(::getpid()) };
+     ::unlink(marker.c_str());
+     {
+         BotProcess bot { BotProcess::Fork([&marker](int fd) {
+             char byte {};
+             while (::read(fd, &byte, 1) > 0) {
+             }
+             std::this_thread::sleep_for(std::chrono::milliseconds{10});
+             int file { ::open(marker.c_str(), O_CREAT | O_WRONLY, 0600) };
+             return file >= 0 && ::close(file) == 0 ? 0 : 1;
+         }) };
+     }
+     EXPECT_EQ(::access(marker.c_str(), F_OK), 0);
+     ::unlink(marker.c_str());
+ }
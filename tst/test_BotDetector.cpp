@@ -0,0 +1,187 @@
+/**
+ * @file test_BotDetector.cpp
+ * @brief Unit tests for BotDetector.
+ *
+ * ## Test Strategy
+ * Round streams are fed straight to OnRound(): random play, which must
+ * never be flagged, and scripts with one known weakness each, which must
+ * raise the matching flag once the window is full. Handler calls are
+ * counted to check that a flag is reported once, when it is first raised.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Random play is not flagged
+ *   Given a user playing uniformly random moves for 2000 rounds
+ *   Then entropy and compression are near their maxima and no flag is raised
+ *
+ * ### Scenario: A constant script is flagged once the window is full
+ *   Given a user who always plays Rock
+ *   When fewer rounds than the window have been played
+ *   Then no flag is raised
+ *   When the window fills
+ *   Then LowEntropy, Compressible and Predictable are raised in one handler call
+ *
+ * ### Scenario: A cycling script is flagged despite balanced moves
+ *   Given a user playing Rock, Paper, Scissors in turn
+ *   Then the move entropy is maximal but the conditional entropy is zero
+ *   And the user is flagged LowEntropy and Predictable
+ *
+ * ### Scenario: Perfect counter-play is flagged
+ *   Given a user who always beats the computer's move
+ *   Then the win rate is 1 and PerfectPlay is raised
+ *
+ * ### Scenario: Bad input is ignored or rejected
+ *   Given invalid moves, unknown names or an impossible window
+ *   Then invalid moves are not scored, unknown names have no scores and the window throws
+ */
+
+ #include <functional>
+ #include <gtest/gtest.h>
+ #include <stdexcept>
+ #include <vector>
+ #include "BotDetector.hpp"
+ #include "Xoshiro256.hpp"
+
+ namespace {
+
+ std::uint8_t Beats(std::uint8_t move) {
+     return static_cast<std::uint8_t>(move % 3 + 1);
+ }
+
+ RoundOutcome Outcome(std::uint8_t user, std::uint8_t computer) {
+     if (user == computer) {
+         return RoundOutcome::Draw;
+     }
+     return user == Beats(computer) ? RoundOutcome::UserWin : RoundOutcome::ComputerWin;
+ }
+
+ /**
+  * @brief Plays `rounds` rounds of `user` against a random computer.
+  *
+  * `user` is shown the computer's move of the same round, as a script
+  * that predicts the computer's generator would know it.
+  */
+ void Play(BotDetector& detector, const std::function<std::uint8_t(std::uint8_t computer)>& user, int rounds,
+           std::uint64_t seed = 1) {
+     Xoshiro256 random{seed};
+     for (int round{}; round < rounds; ++round) {
+         std::uint8_t next { static_cast<std::uint8_t>(1 + random.NextBelow(3)) };
+         RoundRecord record {};
+         record.userName = "ann";
+         record.computerName = "bot";
+         record.round = static_cast<std::uint32_t>(round + 1);
+         record.userMove = user(next);
+         record.computerMove = next;
+         record.outcome = Outcome(record.userMove, next);
+         detector.OnRound(record);
+     }
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies that random play keeps high scores and no flags.
+  */
+ TEST(BotDetectorTest, RandomPlayIsNotFlagged)
+ {
+     int calls {};
+     BotDetector detector{{}, [&](const BotScores&) { ++calls; }};
+     Xoshiro256 random{42};
+     Play(detector, [&](std::uint8_t) { return static_cast<std::uint8_t>(1 + random.NextBelow(3)); }, 2000);
+
+     auto scores = detector.Scores("ann");
+     ASSERT_TRUE(scores.has_value());
+     EXPECT_EQ(scores->rounds, 64u);
+     EXPECT_GT(scores->entropy, 1.4);
+     EXPECT_GT(scores->conditionalEntropy, 1.0);
+     EXPECT_GT(scores->compressionRatio, 0.8);
+     EXPECT_LT(scores->exploitability, 0.6);
+     EXPECT_EQ(scores->flags, 0);
+     EXPECT_EQ(calls, 0);
+     EXPECT_FALSE(detector.Scores("bot").has_value());
+ }
+
+ /**
+  * @test Verifies flags wait for a full window and are reported once.
+  */
+ TEST(BotDetectorTest, ConstantScriptIsFlaggedOnceWindowIsFull)
+ {
+     std::vector<BotScores> reports;
+     BotDetector detector{{}, [&](const BotScores& scores) { reports.push_back(scores); }};
+     auto rock = [](std::uint8_t) { return std::uint8_t{1}; };
+
+     Play(detector, rock, 63);
+     EXPECT_TRUE(reports.empty());
+     EXPECT_EQ(detector.Scores("ann")->flags, 0);
+
+     Play(detector, rock, 200);
+     ASSERT_EQ(reports.size(), 1u);
+     EXPECT_EQ(reports[0].name, "ann");
+     EXPECT_TRUE(HasBotFlag(reports[0].flags, BotFlag::LowEntropy));
+     EXPECT_TRUE(HasBotFlag(reports[0].flags, BotFlag::Compressible));
+     EXPECT_TRUE(HasBotFlag(reports[0].flags, BotFlag::Predictable));
+     EXPECT_FALSE(HasBotFlag(reports[0].flags, BotFlag::PerfectPlay));
+     EXPECT_DOUBLE_EQ(reports[0].entropy, 0.0);
+     EXPECT_GT(reports[0].exploitability, 0.95); // nothing predicted the very first move
+     EXPECT_DOUBLE_EQ(detector.Scores("ann")->exploitability, 1.0);
+     EXPECT_LT(detector.Scores("ann")->compressionRatio, 0.1);
+ }
+
+ /**
+  * @test Verifies that a cycle is caught by conditional entropy.
+  */
+ TEST(BotDetectorTest, CyclingScriptIsFlagged)
+ {
+     int calls {};
+     BotDetector detector{{}, [&](const BotScores&) { ++calls; }};
+     std::uint8_t move {3};
+     Play(detector, [&](std::uint8_t) { return move = Beats(move); }, 300);
+
+     auto scores = detector.Scores("ann");
+     EXPECT_NEAR(scores->entropy, 1.585, 0.01);
+     EXPECT_NEAR(scores->conditionalEntropy, 0.0, 1e-9);
+     EXPECT_DOUBLE_EQ(scores->exploitability, 1.0);
+     EXPECT_TRUE(HasBotFlag(scores->flags, BotFlag::LowEntropy));
+     EXPECT_TRUE(HasBotFlag(scores->flags, BotFlag::Predictable));
+     EXPECT_GE(calls, 1);
+ }
+
+ /**
+  * @test Verifies that winning every round raises PerfectPlay.
+  */
+ TEST(BotDetectorTest, PerfectCounterPlayIsFlagged)
+ {
+     BotDetector detector;
+     Play(detector, [](std::uint8_t computer) { return Beats(computer); }, 100);
+     auto scores = detector.Scores("ann");
+     EXPECT_DOUBLE_EQ(scores->winRate, 1.0);
+     EXPECT_TRUE(HasBotFlag(scores->flags, BotFlag::PerfectPlay));
+     EXPECT_GT(scores->entropy, 1.4);
+ }
+
+ /**
+  * @test Verifies handling of invalid moves, session ends and options.
+  */
+ TEST(BotDetectorTest, BadInputIsIgnoredOrRejected)
+ {
+     BotDetector detector{{8}};
+     RoundRecord record {};
+     record.userName = "ann";
+     record.userMove = 0;
+     record.outcome = RoundOutcome::Forfeit;
+     detector.OnRound(record);
+     EXPECT_FALSE(detector.Scores("ann").has_value());
+
+     record.userMove = 2;
+     record.computerMove = 1;
+     record.outcome = RoundOutcome::UserWin;
+     detector.OnRound(record);
+     detector.OnSessionEnd({1, 1, "ann", "bot"});
+     detector.OnRound(record);
+     // The session end broke the pair, so there is nothing to condition on yet.
+     EXPECT_EQ(detector.Scores("ann")->rounds, 2u);
+     EXPECT_DOUBLE_EQ(detector.Scores("ann")->conditionalEntropy, 0.0);
+
+     EXPECT_THROW(BotDetector{{1}}, std::invalid_argument);
+     EXPECT_THROW(BotDetector{{5000}}, std::invalid_argument);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+ * @file test_BotProtocol.cpp
+ * @brief Unit tests for the BotProtocol class using Google Test.
+ *
+ * ## Test Strategy
+ * Frames are encoded and decoded back; partial buffers must not decode.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Request round-trips with its history
+ *   Given a Request for 5 moves carrying 3 history entries
+ *   When it is encoded and peeked
+ *   Then the header fields and the frame size match
+ *
+ * ### Scenario: Incomplete frames are not decoded
+ *   Given an encoded Moves frame
+ *   When only part of it is available
+ *   Then PeekFrame returns 0 until the whole frame has arrived
+ */
+
+ #include <gtest/gtest.h>
+ #include <cstdint>
+ #include "BotProtocol.hpp"
+
+ /**
+  * @test Verifies that a Request round-trips with its history.
+  */
+ TEST(BotProtocolTest, RequestRoundTrips)
+ {
+     const std::uint8_t history[] {1, 3, 2};
+     std::uint8_t frame[BotProtocol::kMaxFrameSize] {};
+     std::size_t size { BotProtocol::EncodeRequest(5, history, 3, frame) };
+
+     BotProtocol::FrameHeader header {};
+     ASSERT_EQ(BotProtocol::PeekFrame(frame, size, header), size);
+     EXPECT_EQ(size, BotProtocol::kHeaderSize + 3);
+     EXPECT_EQ(header.type, BotProtocol::FrameType::Request);
+     EXPECT_EQ(header.count, 5);
+     EXPECT_EQ(header.historyCount, 3);
+     EXPECT_EQ(frame[BotProtocol::kHeaderSize + 1], 3);
+ }
+
+ /**
+  * @test Verifies that incomplete frames are not decoded.
+  */
+ TEST(BotProtocolTest, IncompleteFramesAreNotDecoded)
+ {
+     const std::uint8_t moves[] {1, 2, 3, 1};
+     std::uint8_t frame[BotProtocol::kMaxFrameSize] {};
+     std::size_t size { BotProtocol::EncodeMoves(moves, 4, frame) };
+
+     BotProtocol::FrameHeader header {};
+     EXPECT_EQ(BotProtocol::PeekFrame(frame, 2, header), 0u);
+     EXPECT_EQ(BotProtocol::PeekFrame(frame, size - 1, header), 0u);
+     EXPECT_EQ(BotProtocol::PeekFrame(frame, size + 10, header), size);
+     EXPECT_EQ(header.type, BotProtocol::FrameType::Moves);
+     EXPECT_EQ(header.count, 4);
+ }
+ 
\ No newline at end of file
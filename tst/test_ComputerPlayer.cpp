@@ -14,6 +14,11 @@
  *   When GetName is called
  *   Then it returns "[Computer] " + name
  *
+ * ### Scenario: ComputerPlayer name view needs no copy
+ *   Given a ComputerPlayer initialized with a name
+ *   When GetNameView is called
+ *   Then it returns the same text as GetName
+ *
  * ### Scenario: ComputerPlayer starts with 0 score
  *   Given a newly constructed ComputerPlayer
  *   When GetScore is called
@@ -51,6 +56,16 @@
      EXPECT_EQ(comp.GetName(), "[Computer] HAL9000");
  }
  
+ /**
+  * @test Verifies that the name view matches the formatted name.
+  */
+ TEST_F(ComputerPlayerTest, ComputerPlayerNameViewMatchesName)
+ {
+     ComputerPlayer comp{"HAL9000"};
+     EXPECT_EQ(comp.GetNameView(), "[Computer] HAL9000");
+     EXPECT_EQ(comp.GetNameView(), comp.GetName());
+ }
+ 
  /**
   * @test Verifies that the initial score is 0.
   */
@@ -24,6 +24,11 @@
  *   When RequestNumberOfRounds is called
  *   Then it should return -1
  *
+ * ### Scenario: DisplayChosenMove prints the player's name and move
+ *   Given a ComputerPlayer named "Hal"
+ *   When DisplayChosenMove is called with Paper
+ *   Then the output should contain "[Computer] Hal chose: Paper"
+ *
  * (And similarly for other prompts/methods.)
  */
 
@@ -32,6 +37,7 @@
  #include <string>
  #include <iostream>
  #include "ConsoleMessenger.hpp"
+ #include "ComputerPlayer.hpp"
  
  /**
   * @brief Test fixture for ConsoleMessenger to redirect I/O streams.
@@ -138,4 +144,21 @@
      std::string output = m_outputBuffer.str();
      EXPECT_NE(output.find("Invalid input!"), std::string::npos);
  }
+ 
+ /**
+  * @test Verifies DisplayChosenMove writes the player's name and move.
+  */
+ TEST_F(ConsoleMessengerTest, DisplayChosenMove_WritesNameAndMove)
+ {
+     /**
+      * Gherkin:
+      *   Given a ComputerPlayer named "Hal"
+      *   When DisplayChosenMove is called with Paper
+      *   Then the output should contain "[Computer] Hal chose: Paper"
+      */
+     std::shared_ptr<IPlayer> player = std::make_shared<ComputerPlayer>("Hal");
+     m_messenger.DisplayChosenMove(player, GameMove::Paper);
+     std::string output = m_outputBuffer.str();
+     EXPECT_NE(output.find("[Computer] Hal chose: Paper"), std::string::npos);
+ }
  
\ No newline at end of file
@@ -19,11 +19,36 @@
  *   Given a GameSessionFactory
  *   When we call Create with a mode that wasn't registered
  *   Then it returns nullptr
+ *
+ * ### Scenario: Re-registering a mode replaces its creator
+ *   Given a mode registered twice
+ *   When we call Create with that mode
+ *   Then the most recently registered creator is used
+ *
+ * ### Scenario: Create is safe while modes are being registered
+ *   Given several threads calling Create in a loop
+ *   And another thread registering modes at the same time
+ *   When all threads finish
+ *   Then every Create call returned either nullptr or a valid session
+ *
+ * ### Scenario: Built-in modes can be registered and created at compile time
+ *   Given a creator registered with RegisterGame<ConsoleSinglePlayer>
+ *   When we call Create<ConsoleSinglePlayer>() or Create(ConsoleSinglePlayer)
+ *   Then both return a valid session
+ *
+ * ### Scenario: Modes outside the built-in range still work
+ *   Given a creator registered for a GameMode value beyond the built-in modes
+ *   When we call Create with that value
+ *   Then we get a valid session
+ *   And built-in modes remain unregistered
  */
 
  #include <gtest/gtest.h>
  #include <gmock/gmock.h>
+ #include <atomic>
  #include <memory>
+ #include <thread>
+ #include <vector>
  #include "GameSessionFactory.hpp"
  #include "IGameSession.hpp"
  #include "GameMode.hpp"
@@ -88,4 +113,115 @@
      auto session = m_factory.Create(GameMode::ConsoleSinglePlayer);
      EXPECT_EQ(session, nullptr);
  }
+ 
+ /**
+  * @test Verifies that re-registering a mode replaces the previous creator.
+  */
+ TEST_F(GameSessionFactoryTest, ReRegisteringModeReplacesCreator)
+ {
+     /**
+      * Gherkin:
+      *   Given a mode registered first with a creator returning nullptr
+      *   And then registered again with a creator returning a session
+      *   When we call Create with that mode
+      *   Then we get a non-null pointer to the session
+      */
+     m_factory.RegisterGame(GameMode::ConsoleSinglePlayer, []() {
+         return std::unique_ptr<IGameSession>{};
+     });
+     m_factory.RegisterGame(GameMode::ConsoleSinglePlayer, []() {
+         return std::make_unique<MockGameSession>();
+     });
+ 
+     EXPECT_NE(m_factory.Create(GameMode::ConsoleSinglePlayer), nullptr);
+ }
+ 
+ /**
+  * @test Verifies that concurrent Create calls tolerate concurrent registration.
+  */
+ TEST_F(GameSessionFactoryTest, ConcurrentCreateWhileRegistering)
+ {
+     /**
+      * Gherkin:
+      *   Given four reader threads calling Create in a loop
+      *   And a writer thread re-registering the mode many times
+      *   When all threads finish
+      *   Then no call failed once the mode was first registered
+      */
+     constexpr int kReaders {4};
+     constexpr int kRegistrations {200};
+ 
+     std::atomic<bool> registered {false};
+     std::atomic<bool> done {false};
+     std::atomic<int> failures {0};
+ 
+     std::vector<std::thread> readers;
+     for (int i{}; i < kReaders; ++i) {
+         readers.emplace_back([&]() {
+             while (!done.load()) {
+                 bool wasRegistered { registered.load() };
+                 auto session = m_factory.Create(GameMode::ConsoleSinglePlayer);
+                 if (wasRegistered && !session) {
+                     ++failures;
+                 }
+             }
+         });
+     }
+ 
+     for (int i{}; i < kRegistrations; ++i) {
+         m_factory.RegisterGame(GameMode::ConsoleSinglePlayer, []() {
+             return std::make_unique<::testing::NiceMock<MockGameSession>>();
+         });
+         registered.store(true);
+     }
+     done.store(true);
+ 
+     for (auto& reader : readers) {
+         reader.join();
+     }
+     EXPECT_EQ(failures.load(), 0);
+     EXPECT_NE(m_factory.Create(GameMode::ConsoleSinglePlayer), nullptr);
+ }
+ 
+ /**
+  * @test Verifies the compile-time registration and creation path.
+  */
+ TEST_F(GameSessionFactoryTest, BuiltinModeCompileTimePath)
+ {
+     /**
+      * Gherkin:
+      *   Given a creator registered with RegisterGame<ConsoleSinglePlayer>
+      *   When we call Create<ConsoleSinglePlayer>() and Create(ConsoleSinglePlayer)
+      *   Then both return a non-null session
+      */
+     EXPECT_EQ(m_factory.Create<GameMode::ConsoleSinglePlayer>(), nullptr);
+ 
+     m_factory.RegisterGame<GameMode::ConsoleSinglePlayer>([]() {
+         return std::make_unique<MockGameSession>();
+     });
+ 
+     EXPECT_NE(m_factory.Create<GameMode::ConsoleSinglePlayer>(), nullptr);
+     EXPECT_NE(m_factory.Create(GameMode::ConsoleSinglePlayer), nullptr);
+ }
+ 
+ /**
+  * @test Verifies that dynamically registered modes use the fallback table.
+  */
+ TEST_F(GameSessionFactoryTest, DynamicModeOutsideBuiltinRange)
+ {
+     /**
+      * Gherkin:
+      *   Given a creator registered for a mode beyond the built-in modes
+      *   When we call Create with that mode
+      *   Then we get a non-null session
+      *   And the built-in mode is still unregistered
+      */
+     const auto dynamicMode = static_cast<GameMode>(kBuiltinGameModeCount + 41);
+     m_factory.RegisterGame(dynamicMode, []() {
+         return std::make_unique<MockGameSession>();
+     });
+ 
+     EXPECT_NE(m_factory.Create(dynamicMode), nullptr);
+     EXPECT_EQ(m_factory.Create(GameMode::ConsoleSinglePlayer), nullptr);
+ }
  
\ No newline at end of file
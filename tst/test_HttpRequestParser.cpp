@@ -0,0 +1,175 @@
+/**
+ * @file test_HttpRequestParser.cpp
+ * @brief Unit tests for HttpRequestParser.
+ *
+ * ## Test Strategy
+ * Requests are parsed straight out of string literals. Incremental arrival
+ * is simulated by parsing every prefix of a request, and pipelining by
+ * concatenating requests into one buffer.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: A complete request is parsed in place
+ *   Given a POST with headers and a body
+ *   When it is parsed
+ *   Then method, target, headers and body point into the buffer
+ *
+ * ### Scenario: A partial request asks for more bytes
+ *   Given every proper prefix of a request
+ *   When each is parsed
+ *   Then the result is Incomplete
+ *
+ * ### Scenario: Pipelined requests are taken one at a time
+ *   Given three requests in one buffer
+ *   When the parser is called repeatedly on what remains
+ *   Then each request is returned in order with its own size
+ *
+ * ### Scenario: Keep-alive follows the version and the Connection header
+ *   Given HTTP/1.1 and HTTP/1.0 requests with and without Connection
+ *   Then keepAlive is the protocol default unless the header overrides it
+ *
+ * ### Scenario: Malformed and oversized requests are rejected
+ *   Given bad request lines, chunked bodies and oversized headers or bodies
+ *   Then the parser reports Invalid or TooLarge
+ */
+
+ #include <gtest/gtest.h>
+ #include <string>
+ #include "HttpRequestParser.hpp"
+
+ namespace {
+
+ using Result = HttpRequestParser::Result;
+
+ Result Parse(const std::string& text, HttpRequest& request) {
+     std::size_t consumed {};
+     return HttpRequestParser::Parse(text, request, consumed);
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies that a complete request is parsed as views into the buffer.
+  */
+ TEST(HttpRequestParserTest, ParsesCompleteRequestInPlace)
+ {
+     const std::string text {
+         "POST /sessions HTTP/1.1\r\n"
+         "Host: localhost\r\n"
+         "content-length:  13 \r\n"
+         "X-Empty:\r\n"
+         "\r\n"
+         "{\"move\":\"ok\"}"
+     };
+     HttpRequest request {};
+     std::size_t consumed {};
+     ASSERT_EQ(HttpRequestParser::Parse(text, request, consumed), Result::Complete);
+     EXPECT_EQ(consumed, text.size());
+     EXPECT_EQ(request.method, "POST");
+     EXPECT_EQ(request.target, "/sessions");
+     EXPECT_EQ(request.minorVersion, 1);
+     EXPECT_EQ(request.headerCount, 3u);
+     EXPECT_EQ(request.Header("HOST"), "localhost");
+     EXPECT_EQ(request.Header("Content-Length"), "13");
+     EXPECT_EQ(request.Header("X-Empty"), "");
+     EXPECT_EQ(request.Header("Missing").data(), nullptr);
+     EXPECT_EQ(request.body, "{\"move\":\"ok\"}");
+     EXPECT_TRUE(request.keepAlive);
+
+     // Views into the caller's buffer, not copies.
+     EXPECT_EQ(request.target.data(), text.data() + 5);
+ }
+
+ /**
+  * @test Verifies that a truncated request asks for more input.
+  */
+ TEST(HttpRequestParserTest, PartialRequestIsIncomplete)
+ {
+     const std::string text {
+         "POST /sessions/1/moves HTTP/1.1\r\nContent-Length: 15\r\n\r\n{\"move\":\"rock\"}"
+     };
+     HttpRequest request {};
+     for (std::size_t length{}; length < text.size(); ++length) {
+         EXPECT_EQ(Parse(text.substr(0, length), request), Result::Incomplete) << length;
+     }
+     EXPECT_EQ(Parse(text, request), Result::Complete);
+ }
+
+ /**
+  * @test Verifies that back-to-back requests are consumed one at a time.
+  */
+ TEST(HttpRequestParserTest, PipelinedRequestsAreTakenInOrder)
+ {
+     const std::string text {
+         "GET /sessions/1 HTTP/1.1\r\n\r\n"
+         "POST /sessions/1/moves HTTP/1.1\r\nContent-Length: 2\r\n\r\nab"
+         "DELETE /sessions/1 HTTP/1.1\r\nConnection: close\r\n\r\n"
+     };
+     std::string_view remaining {text};
+     HttpRequest request {};
+     std::size_t consumed {};
+
+     ASSERT_EQ(HttpRequestParser::Parse(remaining, request, consumed), Result::Complete);
+     EXPECT_EQ(request.method, "GET");
+     EXPECT_TRUE(request.body.empty());
+     remaining.remove_prefix(consumed);
+
+     ASSERT_EQ(HttpRequestParser::Parse(remaining, request, consumed), Result::Complete);
+     EXPECT_EQ(request.method, "POST");
+     EXPECT_EQ(request.body, "ab");
+     remaining.remove_prefix(consumed);
+
+     ASSERT_EQ(HttpRequestParser::Parse(remaining, request, consumed), Result::Complete);
+     EXPECT_EQ(request.method, "DELETE");
+     EXPECT_FALSE(request.keepAlive);
+     remaining.remove_prefix(consumed);
+
+     EXPECT_TRUE(remaining.empty());
+     EXPECT_EQ(HttpRequestParser::Parse(remaining, request, consumed), Result::Incomplete);
+ }
+
+ /**
+  * @test Verifies the keep-alive default of each HTTP version.
+  */
+ TEST(HttpRequestParserTest, KeepAliveFollowsVersionAndConnectionHeader)
+ {
+     HttpRequest request {};
+     ASSERT_EQ(Parse("GET / HTTP/1.1\r\n\r\n", request), Result::Complete);
+     EXPECT_TRUE(request.keepAlive);
+     ASSERT_EQ(Parse("GET / HTTP/1.1\r\nConnection: Close\r\n\r\n", request), Result::Complete);
+     EXPECT_FALSE(request.keepAlive);
+     ASSERT_EQ(Parse("GET / HTTP/1.0\r\n\r\n", request), Result::Complete);
+     EXPECT_EQ(request.minorVersion, 0);
+     EXPECT_FALSE(request.keepAlive);
+     ASSERT_EQ(Parse("GET / HTTP/1.0\r\nConnection: keep-alive, Upgrade\r\n\r\n", request), Result::Complete);
+     EXPECT_TRUE(request.keepAlive);
+ }
+
+ /**
+  * @test Verifies rejection of malformed and oversized requests.
+  */
+ TEST(HttpRequestParserTest, RejectsMalformedAndOversizedRequests)
+ {
+     HttpRequest request {};
+     EXPECT_EQ(Parse("GET /\r\n\r\n", request), Result::Invalid);
+     EXPECT_EQ(Parse("GET / HTTP/2.0\r\n\r\n", request), Result::Invalid);
+     EXPECT_EQ(Parse("G(T / HTTP/1.1\r\n\r\n", request), Result::Invalid);
+     EXPECT_EQ(Parse("GET  / HTTP/1.1\r\n\r\n", request), Result::Invalid);
+     EXPECT_EQ(Parse("GET / HTTP/1.1\r\nNoColon\r\n\r\n", request), Result::Invalid);
+     EXPECT_EQ(Parse("GET / HTTP/1.1\r\nA: b\r\n folded\r\n\r\n", request), Result::Invalid);
+     EXPECT_EQ(Parse("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n", request), Result::Invalid);
+     EXPECT_EQ(Parse("POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n", request), Result::Invalid);
+     EXPECT_EQ(Parse("POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n", request),
+               Result::Invalid);
+
+     EXPECT_EQ(Parse("POST / HTTP/1.1\r\nContent-Length: 65537\r\n\r\n", request), Result::TooLarge);
+     std::string longHeader { "GET / HTTP/1.1\r\nX: " + std::string(HttpRequestParser::kMaxHeaderBytes, 'a') };
+     EXPECT_EQ(Parse(longHeader, request), Result::TooLarge);
+     EXPECT_EQ(Parse(longHeader + "\r\n\r\n", request), Result::TooLarge);
+
+     std::string manyHeaders {"GET / HTTP/1.1\r\n"};
+     for (std::size_t i{}; i <= HttpRequest::kMaxHeaders; ++i) {
+         manyHeaders += "X: y\r\n";
+     }
+     EXPECT_EQ(Parse(manyHeaders + "\r\n", request), Result::TooLarge);
+ }
+ 
\ No newline at end of file
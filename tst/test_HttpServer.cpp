@@ -0,0 +1,404 @@
+/**
+ * @file test_HttpServer.cpp
+ * @brief Unit tests for HttpGameApi, HttpServer and HttpLoadGenerator.
+ *
+ * ## Test Strategy
+ * The API is exercised directly with parsed requests against a computer
+ * that always plays rock, so every round's outcome is known. The server
+ * runs on a background thread listening on an ephemeral loopback port,
+ * and the tests talk to it over plain TCP sockets.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: A session is created, played to the end and deleted
+ *   Given a 2-round session against a rock-only computer
+ *   When the user plays paper, then rock, then another move
+ *   Then the rounds are a win and a draw, the third move is refused, and
+ *        the session can be read and then deleted
+ *
+ * ### Scenario: Bad requests are refused
+ *   Given missing fields, unsafe names, bad round counts, unknown moves,
+ *        unknown paths and wrong methods
+ *   Then each gets the matching 4xx status and an error body
+ *
+ * ### Scenario: A mode that does not build HTTP sessions
+ *   Given a factory without a creator for the API's mode
+ *   When a session is requested
+ *   Then the API answers 500
+ *
+ * ### Scenario: Rounds are forwarded to the next observer
+ *   Given an API whose next observer fans out to two observers
+ *   When a 2-round session is played to the end
+ *   Then both observers see both rounds with the players' names and the session end
+ *
+ * ### Scenario: New names are refused once the cap is reached
+ *   Given an API that accepts at most three distinct names
+ *   When sessions ask for three names, then a fourth, then known ones
+ *   Then the fourth is refused with 503 without interning it, and known names still work
+ *
+ * ### Scenario: Pipelined requests are answered in order on one connection
+ *   Given a running server and a created session
+ *   When three moves and a status request are written in one send
+ *   Then four responses arrive in request order and the connection stays open
+ *
+ * ### Scenario: Connection close and malformed requests end the connection
+ *   Given a request with "Connection: close" and, separately, garbage
+ *   Then the server answers once and closes the connection
+ *
+ * ### Scenario: The load generator measures the server
+ *   Given a running server
+ *   When the load generator runs briefly with pipelining
+ *   Then it reports requests, no failures, and the server counted them
+ */
+
+ #include <arpa/inet.h>
+ #include <gtest/gtest.h>
+ #include <netinet/in.h>
+ #include <string>
+ #include <sys/socket.h>
+ #include <thread>
+ #include <unistd.h>
+ #include <vector>
+ #include "GameSessionFactory.hpp"
+ #include "HttpGameApi.hpp"
+ #include "HttpLoadGenerator.hpp"
+ #include "HttpServer.hpp"
+ #include "NameInterner.hpp"
+ #include "RoundObserverFanOut.hpp"
+
+ namespace {
+
+ /**
+  * @brief An API whose computer always plays rock.
+  */
+ class RockApi {
+ public:
+     explicit RockApi(IRoundObserver* next = nullptr)
+         : m_api{m_factory, GameMode::ConsoleSinglePlayer, next}
+     {
+         m_factory.RegisterGame<GameMode::ConsoleSinglePlayer>([this]() {
+             return HttpGameApi::MakeSinglePlayerGame(m_api.PendingSession(), []() { return 0; });
+         });
+     }
+
+     int Call(const std::string& method, const std::string& target, const std::string& body = {}) {
+         m_text = method + " " + target + " HTTP/1.1\r\nContent-Length: " + std::to_string(body.size()) +
+                  "\r\n\r\n" + body;
+         HttpRequest request {};
+         std::size_t consumed {};
+         EXPECT_EQ(HttpRequestParser::Parse(m_text, request, consumed), HttpRequestParser::Result::Complete);
+         return m_api.Handle(request, response);
+     }
+
+     HttpGameApi& Api() {
+         return m_api;
+     }
+
+     std::string response {};
+
+ private:
+     GameSessionFactory m_factory {};
+     HttpGameApi m_api;
+     std::string m_text {};
+ };
+
+ /**
+  * @brief Records what the API forwards.
+  */
+ class RecordingObserver : public IRoundObserver {
+ public:
+     void OnRound(const RoundRecord& record) override {
+         rounds.push_back(std::string{record.userName} + "-" + std::string{record.computerName} + ":" +
+                          std::to_string(record.round));
+     }
+
+     void OnSessionEnd(const SessionSummary& summary) override {
+         sessions.push_back(summary.sessionId);
+     }
+
+     std::vector<std::string> rounds {};
+     std::vector<std::uint64_t> sessions {};
+ };
+
+ bool Contains(const std::string& text, const std::string& part) {
+     return text.find(part) != std::string::npos;
+ }
+
+ /**
+  * @brief Runs an HttpServer for RockApi on a background thread.
+  */
+ class RunningServer {
+ public:
+     RunningServer()
+         : m_server{[this](const HttpRequest& request, std::string& body) {
+               return m_api.Api().Handle(request, body);
+           }}
+         , m_thread{[this]() { m_server.Run(); }}
+     {
+     }
+
+     ~RunningServer() {
+         m_server.Stop();
+         m_thread.join();
+     }
+
+     HttpServer& Server() {
+         return m_server;
+     }
+
+     int Connect() {
+         int fd { ::socket(AF_INET, SOCK_STREAM, 0) };
+         sockaddr_in address {};
+         address.sin_family = AF_INET;
+         address.sin_port = htons(m_server.Port());
+         address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+         EXPECT_EQ(::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+         return fd;
+     }
+
+ private:
+     RockApi m_api {};
+     HttpServer m_server;
+     std::thread m_thread;
+ };
+
+ void Write(int fd, const std::string& text) {
+     ASSERT_EQ(::send(fd, text.data(), text.size(), MSG_NOSIGNAL), static_cast<ssize_t>(text.size()));
+ }
+
+ /**
+  * @brief Reads until `count` responses with JSON bodies have arrived.
+  */
+ std::string ReadResponses(int fd, std::size_t count) {
+     std::string received;
+     char buffer[4096];
+     for (;;) {
+         std::size_t responses {};
+         for (std::size_t at {}; (at = received.find("HTTP/1.1 ", at)) != std::string::npos; at += 9) {
+             ++responses;
+         }
+         if (responses == count && !received.empty() && received.back() == '}') {
+             return received;
+         }
+         ssize_t got { ::recv(fd, buffer, sizeof(buffer), 0) };
+         if (got <= 0) {
+             return received;
+         }
+         received.append(buffer, static_cast<std::size_t>(got));
+     }
+ }
+
+ /**
+  * @brief Reads until the server closes the connection.
+  */
+ std::string ReadToEnd(int fd) {
+     std::string received;
+     char buffer[4096];
+     ssize_t got {};
+     while ((got = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+         received.append(buffer, static_cast<std::size_t>(got));
+     }
+     return received;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies the session lifecycle through the API.
+  */
+ TEST(HttpGameApiTest, SessionIsCreatedPlayedAndDeleted)
+ {
+     RockApi api;
+     ASSERT_EQ(api.Call("POST", "/sessions", R"({"user":"Ann","computer":"Bot","rounds":2})"), 201);
+     EXPECT_TRUE(Contains(api.response, R"("id":1,)"));
+     EXPECT_TRUE(Contains(api.response, R"("user":"Ann","computer":"Bot","rounds":2,"played":0,)"));
+     EXPECT_EQ(api.Api().SessionCount(), 1u);
+
+     ASSERT_EQ(api.Call("POST", "/sessions/1/moves", R"({"move":"paper"})"), 200);
+     EXPECT_EQ(api.response, R"({"id":1,"round":1,"user":"paper","computer":"rock","winner":"user",)"
+                             R"("userScore":1,"computerScore":0,"finished":false})");
+     ASSERT_EQ(api.Call("POST", "/sessions/1/moves", R"({ "move" : "rock" })"), 200);
+     EXPECT_TRUE(Contains(api.response, R"("round":2,"user":"rock","computer":"rock","winner":"draw")"));
+     EXPECT_TRUE(Contains(api.response, R"("finished":true})"));
+     EXPECT_EQ(api.Call("POST", "/sessions/1/moves", R"({"move":"rock"})"), 409);
+
+     ASSERT_EQ(api.Call("GET", "/sessions/1?verbose=1"), 200);
+     EXPECT_TRUE(Contains(api.response, R"("played":2,"userScore":1,"computerScore":0,"draws":1,"finished":true})"));
+
+     EXPECT_EQ(api.Call("DELETE", "/sessions/1"), 204);
+     EXPECT_TRUE(api.response.empty());
+     EXPECT_EQ(api.Call("GET", "/sessions/1"), 404);
+     EXPECT_EQ(api.Api().SessionCount(), 0u);
+ }
+
+ /**
+  * @test Verifies the error statuses for bad requests.
+  */
+ TEST(HttpGameApiTest, BadRequestsAreRefused)
+ {
+     RockApi api;
+     EXPECT_EQ(api.Call("POST", "/sessions", R"({"user":"Ann","rounds":2})"), 400);
+     EXPECT_TRUE(Contains(api.response, R"("error":)"));
+     EXPECT_EQ(api.Call("POST", "/sessions", R"({"user":"A\"n","computer":"Bot","rounds":2})"), 400);
+     EXPECT_EQ(api.Call("POST", "/sessions", R"({"user":"","computer":"Bot","rounds":2})"), 400);
+     EXPECT_EQ(api.Call("POST", "/sessions", R"({"user":"Ann","computer":"Bot","rounds":0})"), 400);
+     EXPECT_EQ(api.Call("POST", "/sessions", R"({"user":"Ann","computer":"Bot","rounds":"2"})"), 400);
+     EXPECT_EQ(api.Call("POST", "/sessions", R"({"user":"Ann","computer":"Bot","rounds":99999999})"), 400);
+     EXPECT_EQ(api.Api().SessionCount(), 0u);
+
+     ASSERT_EQ(api.Call("POST", "/sessions", R"({"user":"Ann","computer":"Bot","rounds":2})"), 201);
+     EXPECT_EQ(api.Call("POST", "/sessions/1/moves", R"({"move":"lizard"})"), 400);
+     EXPECT_EQ(api.Call("POST", "/sessions/1/moves", ""), 400);
+     EXPECT_EQ(api.Call("POST", "/sessions/2/moves", R"({"move":"rock"})"), 404);
+     EXPECT_EQ(api.Call("POST", "/sessions/x/moves", R"({"move":"rock"})"), 404);
+     EXPECT_EQ(api.Call("POST", "/sessions/1/undo", ""), 404);
+     EXPECT_EQ(api.Call("GET", "/players"), 404);
+     EXPECT_EQ(api.Call("GET", "/sessionsX"), 404);
+     EXPECT_EQ(api.Call("GET", "/sessions"), 405);
+     EXPECT_EQ(api.Call("PUT", "/sessions/1"), 405);
+     EXPECT_EQ(api.Call("GET", "/sessions/1/moves"), 405);
+ }
+
+ /**
+  * @test Verifies that a mode without a creator yields 500.
+  */
+ TEST(HttpGameApiTest, ModeWithoutHttpCreatorIsServerError)
+ {
+     GameSessionFactory factory;
+     HttpGameApi api{factory, GameMode::ConsoleSinglePlayer};
+     std::string body { R"({"user":"Ann","computer":"Bot","rounds":2})" };
+     std::string text { "POST /sessions HTTP/1.1\r\nContent-Length: " + std::to_string(body.size()) +
+                        "\r\n\r\n" + body };
+     HttpRequest request {};
+     std::size_t consumed {};
+     ASSERT_EQ(HttpRequestParser::Parse(text, request, consumed), HttpRequestParser::Result::Complete);
+     EXPECT_EQ(api.Handle(request, body), 500);
+     EXPECT_EQ(api.SessionCount(), 0u);
+     EXPECT_THROW(api.PendingSession(), std::logic_error);
+ }
+
+ /**
+  * @test Verifies that the API forwards rounds and session ends to its next observer.
+  */
+ TEST(HttpGameApiTest, RoundsAreForwardedToTheNextObserver)
+ {
+     RecordingObserver first;
+     RecordingObserver second;
+     RoundObserverFanOut fanOut;
+     fanOut.Add(&first);
+     fanOut.Add(&second);
+     RockApi api{&fanOut};
+     ASSERT_EQ(api.Call("POST", "/sessions", R"({"user":"Ann","computer":"Bot","rounds":2})"), 201);
+     ASSERT_EQ(api.Call("POST", "/sessions/1/moves", R"({"move":"paper"})"), 200);
+     ASSERT_EQ(api.Call("POST", "/sessions/1/moves", R"({"move":"rock"})"), 200);
+
+     std::vector<std::string> expected {"[User] Ann-[Computer] Bot:1", "[User] Ann-[Computer] Bot:2"};
+     EXPECT_EQ(first.rounds, expected);
+     EXPECT_EQ(second.rounds, expected);
+     EXPECT_EQ(first.sessions, (std::vector<std::uint64_t>{1}));
+     EXPECT_EQ(second.sessions, (std::vector<std::uint64_t>{1}));
+     EXPECT_TRUE(Contains(api.response, R"("userScore":1,"computerScore":0,"finished":true})"));
+ }
+
+ /**
+  * @test Verifies that the API stops accepting new names at its cap.
+  */
+ TEST(HttpGameApiTest, NewNamesAreRefusedAtTheCap)
+ {
+     RockApi api;
+     api.Api().SetMaxDistinctNames(3);
+     ASSERT_EQ(api.Call("POST", "/sessions", R"({"user":"CapAnn","computer":"CapBot","rounds":1})"), 201);
+     ASSERT_EQ(api.Call("POST", "/sessions", R"({"user":"CapAnn","computer":"CapCid","rounds":1})"), 201);
+     EXPECT_EQ(api.Api().DistinctNameCount(), 3u);
+
+     std::size_t interned { NameInterner::Global().Size() };
+     EXPECT_EQ(api.Call("POST", "/sessions", R"({"user":"CapDan","computer":"CapBot","rounds":1})"), 503);
+     EXPECT_TRUE(Contains(api.response, "too many distinct player names"));
+     EXPECT_EQ(NameInterner::Global().Size(), interned);
+     EXPECT_EQ(api.Api().DistinctNameCount(), 3u);
+
+     EXPECT_EQ(api.Call("POST", "/sessions", R"({"user":"CapCid","computer":"CapBot","rounds":1})"), 201);
+     EXPECT_EQ(api.Api().SessionCount(), 3u);
+ }
+
+ /**
+  * @test Verifies in-order answers to pipelined requests.
+  */
+ TEST(HttpServerTest, PipelinedRequestsAreAnsweredInOrder)
+ {
+     RunningServer running;
+     int fd { running.Connect() };
+     std::string create { R"({"user":"Ann","computer":"Bot","rounds":5})" };
+     Write(fd, "POST /sessions HTTP/1.1\r\nContent-Length: " + std::to_string(create.size()) + "\r\n\r\n" + create);
+     EXPECT_TRUE(Contains(ReadResponses(fd, 1), "HTTP/1.1 201 Created\r\n"));
+
+     std::string move { "POST /sessions/1/moves HTTP/1.1\r\nContent-Length: 16\r\n\r\n{\"move\":\"paper\"}" };
+     Write(fd, move + move + move + "GET /sessions/1 HTTP/1.1\r\n\r\n");
+     std::string responses { ReadResponses(fd, 4) };
+     std::size_t first { responses.find(R"("round":1,)") };
+     std::size_t second { responses.find(R"("round":2,)") };
+     std::size_t third { responses.find(R"("round":3,)") };
+     std::size_t status { responses.find(R"("played":3,)") };
+     ASSERT_NE(first, std::string::npos);
+     EXPECT_LT(first, second);
+     EXPECT_LT(second, third);
+     EXPECT_LT(third, status);
+     EXPECT_NE(status, std::string::npos);
+     EXPECT_FALSE(Contains(responses, "Connection: close"));
+
+     // Still open: one more request on the same connection.
+     Write(fd, "GET /sessions/1 HTTP/1.1\r\n\r\n");
+     EXPECT_TRUE(Contains(ReadResponses(fd, 1), R"("played":3,)"));
+     ::close(fd);
+
+     HttpServerStats stats { running.Server().Stats() };
+     EXPECT_EQ(stats.connections, 1u);
+     EXPECT_EQ(stats.requests, 6u);
+     EXPECT_EQ(stats.rejected, 0u);
+ }
+
+ /**
+  * @test Verifies when the server closes a connection.
+  */
+ TEST(HttpServerTest, ConnectionCloseAndMalformedRequestsEndTheConnection)
+ {
+     RunningServer running;
+     int fd { running.Connect() };
+     Write(fd, "GET /sessions/1 HTTP/1.1\r\nConnection: close\r\n\r\nGET /sessions/1 HTTP/1.1\r\n\r\n");
+     std::string received { ReadToEnd(fd) };
+     EXPECT_EQ(received.find("HTTP/1.1 404 Not Found\r\n"), 0u);
+     EXPECT_TRUE(Contains(received, "Connection: close\r\n"));
+     EXPECT_EQ(received.find("HTTP/1.1", 1), std::string::npos);
+     ::close(fd);
+
+     fd = running.Connect();
+     Write(fd, "NOT HTTP\r\n\r\n");
+     received = ReadToEnd(fd);
+     EXPECT_EQ(received.find("HTTP/1.1 400 Bad Request\r\n"), 0u);
+     ::close(fd);
+     EXPECT_EQ(running.Server().Stats().rejected, 1u);
+ }
+
+ /**
+  * @test Verifies that the load generator completes requests.
+  */
+ TEST(HttpServerTest, LoadGeneratorMeasuresTheServer)
+ {
+     RunningServer running;
+     HttpLoadOptions options {};
+     options.port = running.Server().Port();
+     options.connections = 4;
+     options.pipelineDepth = 8;
+     options.duration = std::chrono::milliseconds{200};
+     options.roundsPerSession = 1000000;
+
+     HttpLoadReport report { HttpLoadGenerator{options}.Run() };
+     EXPECT_GT(report.requests, 0u);
+     EXPECT_EQ(report.requests % 8, 0u);
+     EXPECT_EQ(report.failures, 0u);
+     EXPECT_GT(report.RequestsPerSecond(), 0.0);
+
+     // Four session creations plus every measured move.
+     EXPECT_EQ(running.Server().Stats().requests, report.requests + 4);
+     EXPECT_THROW(HttpLoadGenerator{HttpLoadOptions{"localhost"}}, std::invalid_argument);
+ }
+ 
\ No newline at end of file
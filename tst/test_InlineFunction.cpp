@@ -0,0 +1,103 @@
+/**
+ * @file test_InlineFunction.cpp
+ * @brief Unit tests for the InlineFunction class template using Google Test.
+ *
+ * ## Test Strategy
+ * InlineFunction must behave like a copyable std::function whose callable
+ * lives in an inline buffer. We verify invocation, emptiness, and that
+ * copies and moves keep captured state alive with correct lifetimes.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Default-constructed wrapper is empty
+ *   Given a default-constructed InlineFunction
+ *   When it is tested in a boolean context
+ *   Then it is false
+ *
+ * ### Scenario: Stored lambda is invoked with its captures
+ *   Given an InlineFunction holding a lambda capturing a value
+ *   When it is invoked
+ *   Then it returns a result computed from the capture
+ *
+ * ### Scenario: Copies and moves preserve the callable
+ *   Given an InlineFunction holding a lambda capturing a string
+ *   When it is copied and then moved
+ *   Then both the copy and the moved-to wrapper return the string
+ *   And the moved-from wrapper is empty
+ *
+ * ### Scenario: Captured objects are destroyed exactly once
+ *   Given an InlineFunction holding a lambda capturing a shared_ptr
+ *   When the wrapper and all its copies go out of scope
+ *   Then the shared_ptr use count returns to 1
+ */
+
+ #include <gtest/gtest.h>
+ #include <memory>
+ #include <string>
+ #include "InlineFunction.hpp"
+
+ using IntFunction = InlineFunction<int(int), 64>;
+ using StringFunction = InlineFunction<std::string(), 64>;
+
+ /**
+  * @test Verifies that a default-constructed wrapper is empty.
+  */
+ TEST(InlineFunctionTest, DefaultConstructedIsEmpty)
+ {
+     IntFunction func;
+     EXPECT_FALSE(func);
+
+     IntFunction null {nullptr};
+     EXPECT_FALSE(null);
+ }
+
+ /**
+  * @test Verifies that the stored lambda is invoked with its captures.
+  */
+ TEST(InlineFunctionTest, InvokesStoredLambda)
+ {
+     int offset {40};
+     IntFunction func {[offset](int value) { return value + offset; }};
+
+     ASSERT_TRUE(func);
+     EXPECT_EQ(func(2), 42);
+ }
+
+ /**
+  * @test Verifies that copying and moving keep the callable intact.
+  */
+ TEST(InlineFunctionTest, CopyAndMovePreserveCallable)
+ {
+     std::string text {"a string long enough to defeat small-string optimization"};
+     StringFunction original {[text]() { return text; }};
+
+     StringFunction copy {original};
+     StringFunction moved {std::move(original)};
+
+     EXPECT_EQ(copy(), text);
+     EXPECT_EQ(moved(), text);
+     EXPECT_FALSE(original);
+
+     StringFunction assigned;
+     assigned = copy;
+     EXPECT_EQ(assigned(), text);
+ }
+
+ /**
+  * @test Verifies that captured objects are destroyed exactly once.
+  */
+ TEST(InlineFunctionTest, CapturesAreReleased)
+ {
+     auto shared = std::make_shared<int>(7);
+     {
+         IntFunction func {[shared](int value) { return value * *shared; }};
+         IntFunction copy {func};
+         IntFunction moved {std::move(func)};
+         EXPECT_EQ(shared.use_count(), 3);
+         EXPECT_EQ(moved(2), 14);
+
+         copy = nullptr;
+         EXPECT_EQ(shared.use_count(), 2);
+     }
+     EXPECT_EQ(shared.use_count(), 1);
+ }
+ 
\ No newline at end of file
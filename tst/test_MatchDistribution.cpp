@@ -0,0 +1,166 @@
+/**
+ * @file test_MatchDistribution.cpp
+ * @brief Unit tests for the MatchDistribution class using Google Test.
+ *
+ * ## Test Strategy
+ * Random against random has a closed-form draw probability from the
+ * trinomial distribution. Doubling must agree with the plain
+ * round-by-round recurrence over the margin, and the simulator must agree
+ * with the exact answer within sampling error. A long match checks the
+ * margin's moments and that truncation stays negligible.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Random against random matches the closed form
+ *   Given two uniformly random strategies and 21 rounds
+ *   When the distribution is computed
+ *   Then P(draw) equals the trinomial sum and wins and losses are equally likely
+ *
+ * ### Scenario: Doubling agrees with the round-by-round recurrence
+ *   Given biased mixed strategies
+ *   When 1, 37 and 64 rounds are computed both ways
+ *   Then every margin probability agrees to 1e-14
+ *
+ * ### Scenario: The simulator agrees with the exact answer
+ *   Given "random" against "rock" for 20000 matches of 21 rounds
+ *   When the campaign is simulated
+ *   Then its match win, draw and loss counts are within 5 standard errors
+ *
+ * ### Scenario: Long matches keep their moments
+ *   Given 100000 rounds of biased strategies
+ *   When the distribution is computed
+ *   Then it sums to 1 and its mean and variance match the exact values
+ *
+ * ### Scenario: Invalid strategies are rejected
+ *   Given a strategy that does not sum to 1 or has a negative entry
+ *   When the distribution is computed
+ *   Then std::invalid_argument is thrown
+ */
+
+ #include <gtest/gtest.h>
+ #include <cmath>
+ #include <stdexcept>
+ #include <vector>
+ #include "MatchDistribution.hpp"
+ #include "SimulationRunner.hpp"
+
+ namespace {
+
+ const MixedStrategy kUniform {1.0 / 3.0, 1.0 / 3.0, 1.0 / 3.0};
+ const MixedStrategy kRockHeavy {0.5, 0.3, 0.2};
+ const MixedStrategy kPaperHeavy {0.25, 0.45, 0.3};
+
+ /**
+  * @brief P(margin = d) by applying the one-round step `rounds` times.
+  */
+ std::vector<double> RoundByRound(const MatchDistribution& reference, std::uint32_t rounds) {
+     std::vector<double> p(2 * rounds + 1, 0.0);
+     p[rounds] = 1.0;
+     for (std::uint32_t round{}; round < rounds; ++round) {
+         std::vector<double> next(p.size(), 0.0);
+         for (std::size_t d{}; d < p.size(); ++d) {
+             next[d] += p[d] * reference.RoundDrawProbability();
+             if (d + 1 < p.size()) {
+                 next[d + 1] += p[d] * reference.RoundWinProbability();
+             }
+             if (d > 0) {
+                 next[d - 1] += p[d] * reference.RoundLossProbability();
+             }
+         }
+         p = std::move(next);
+     }
+     return p;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verify random against random against the trinomial closed form.
+  */
+ TEST(MatchDistributionTest, RandomAgainstRandomMatchesClosedForm) {
+     MatchDistribution distribution { MatchDistribution::Compute(kUniform, kUniform, 21) };
+     double draw {};
+     for (int wins {}; 2 * wins <= 21; ++wins) {
+         draw += std::exp(std::lgamma(22.0) - 2.0 * std::lgamma(wins + 1.0) - std::lgamma(22.0 - 2.0 * wins) -
+                          21.0 * std::log(3.0));
+     }
+
+     EXPECT_NEAR(distribution.DrawProbability(), draw, 1e-14);
+     EXPECT_NEAR(distribution.UserWinProbability(), distribution.ComputerWinProbability(), 1e-14);
+     EXPECT_NEAR(distribution.UserWinProbability() + distribution.DrawProbability() +
+                 distribution.ComputerWinProbability(), 1.0, 1e-14);
+     EXPECT_EQ(distribution.LowestMargin(), -21);
+     EXPECT_NEAR(distribution.Probability(21), std::pow(3.0, -21.0), 1e-24);
+ }
+
+ /**
+  * @test Verify that doubling agrees with the round-by-round recurrence.
+  */
+ TEST(MatchDistributionTest, DoublingAgreesWithRoundByRound) {
+     for (std::uint32_t rounds : {1u, 37u, 64u}) {
+         MatchDistribution distribution { MatchDistribution::Compute(kRockHeavy, kPaperHeavy, rounds) };
+         std::vector<double> expected { RoundByRound(distribution, rounds) };
+         for (std::size_t d{}; d < expected.size(); ++d) {
+             std::int64_t margin { static_cast<std::int64_t>(d) - static_cast<std::int64_t>(rounds) };
+             EXPECT_NEAR(distribution.Probability(margin), expected[d], 1e-14) << rounds << " rounds, margin " << margin;
+         }
+     }
+ }
+
+ /**
+  * @test Verify that the simulator agrees with the exact answer.
+  */
+ TEST(MatchDistributionTest, SimulatorAgreesWithExactAnswer) {
+     SimulationConfig config {};
+     config.masterSeed = 31;
+     config.totalMatches = 20000;
+     config.roundsPerMatch = 21;
+     config.userStrategy = "random";
+     config.computerStrategy = "rock";
+     SimulationResult simulated { SimulationRunner{config}.RunShard(0, 1) };
+     MatchDistribution exact { MatchDistribution::Compute(*MatchDistribution::ForStrategy("random"),
+                                                          *MatchDistribution::ForStrategy("rock"), 21) };
+
+     double n { static_cast<double>(config.totalMatches) };
+     auto expectClose = [n](std::uint64_t count, double p) {
+         EXPECT_NEAR(static_cast<double>(count) / n, p, 5.0 * std::sqrt(p * (1.0 - p) / n));
+     };
+     expectClose(simulated.UserMatchWins(), exact.UserWinProbability());
+     expectClose(simulated.DrawnMatches(), exact.DrawProbability());
+     expectClose(simulated.ComputerMatchWins(), exact.ComputerWinProbability());
+ }
+
+ /**
+  * @test Verify a long match's total, moments and truncation.
+  */
+ TEST(MatchDistributionTest, LongMatchKeepsMoments) {
+     MatchDistribution distribution { MatchDistribution::Compute(kRockHeavy, kPaperHeavy, 100000) };
+     double total {};
+     double mean {};
+     for (std::size_t i{}; i < distribution.Probabilities().size(); ++i) {
+         double margin { static_cast<double>(distribution.LowestMargin() + static_cast<std::int64_t>(i)) };
+         total += distribution.Probabilities()[i];
+         mean += margin * distribution.Probabilities()[i];
+     }
+     double variance {};
+     for (std::size_t i{}; i < distribution.Probabilities().size(); ++i) {
+         double margin { static_cast<double>(distribution.LowestMargin() + static_cast<std::int64_t>(i)) };
+         variance += (margin - mean) * (margin - mean) * distribution.Probabilities()[i];
+     }
+
+     EXPECT_NEAR(total, 1.0, 1e-10);
+     EXPECT_LT(distribution.TruncatedMass(), 1e-25);
+     EXPECT_NEAR(mean, distribution.MeanMargin(), 1e-6 * std::fabs(distribution.MeanMargin()));
+     EXPECT_NEAR(variance, distribution.MarginVariance(), 1e-6 * distribution.MarginVariance());
+     EXPECT_LT(distribution.Probabilities().size(), 10000u);
+ }
+
+ /**
+  * @test Verify that invalid strategies are rejected.
+  */
+ TEST(MatchDistributionTest, InvalidStrategiesAreRejected) {
+     EXPECT_THROW(MatchDistribution::Compute({0.5, 0.5, 0.5}, kUniform, 3), std::invalid_argument);
+     EXPECT_THROW(MatchDistribution::Compute(kUniform, {1.2, -0.1, -0.1}, 3), std::invalid_argument);
+     EXPECT_FALSE(MatchDistribution::ForStrategy("copycat").has_value());
+     EXPECT_DOUBLE_EQ(MatchDistribution::Compute(kUniform, kUniform, 0).DrawProbability(), 1.0);
+ }
+ 
\ No newline at end of file
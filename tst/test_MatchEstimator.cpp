@@ -0,0 +1,154 @@
+/**
+ * @file test_MatchEstimator.cpp
+ * @brief Unit tests for the MatchEstimator class using Google Test.
+ *
+ * ## Test Strategy
+ * Deterministic pairings have known answers and must stop at the first
+ * look. Random against random has an exact win probability, computed from
+ * the trinomial distribution of a match, that the interval must contain.
+ * Common random numbers are checked on two identical strategies, whose
+ * paired matches never differ, against the same comparison unpaired.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: A deterministic pairing stops at the first look
+ *   Given "paper" against "rock"
+ *   When the win probability is estimated
+ *   Then every match is won, after minMatches matches and one look
+ *
+ * ### Scenario: The interval holds the exact win probability
+ *   Given "random" against "random" over 21 rounds and a half-width of 0.02
+ *   When the win probability is estimated
+ *   Then the interval is at most 0.04 wide and contains (1 - P(draw)) / 2
+ *
+ * ### Scenario: Estimates do not depend on the thread count
+ *   Given the same options with 1 and with 4 threads
+ *   When "random" against "copycat" is estimated
+ *   Then the counts are identical
+ *
+ * ### Scenario: Common random numbers cancel shared luck
+ *   Given "random" and "random" compared against "cycle"
+ *   When the comparison runs with and without common random numbers
+ *   Then the paired run sees no difference and stops first
+ *
+ * ### Scenario: Bad options and names are rejected
+ *   Given a zero half-width, a confidence of 1 or an unknown strategy
+ *   When an estimator is built or run
+ *   Then std::invalid_argument is thrown
+ */
+
+ #include <gtest/gtest.h>
+ #include <cmath>
+ #include <stdexcept>
+ #include "MatchEstimator.hpp"
+
+ namespace {
+
+ /**
+  * @brief Probability that a match of uniformly random rounds is drawn.
+  */
+ double ExactDrawProbability(int rounds) {
+     double total {};
+     for (int wins {}; 2 * wins <= rounds; ++wins) {
+         double logWays { std::lgamma(rounds + 1.0) - 2.0 * std::lgamma(wins + 1.0) -
+                          std::lgamma(rounds - 2.0 * wins + 1.0) };
+         total += std::exp(logWays - rounds * std::log(3.0));
+     }
+     return total;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verify that a deterministic pairing stops at the first look.
+  */
+ TEST(MatchEstimatorTest, DeterministicPairingStopsAtFirstLook) {
+     MatchEstimatorOptions options {};
+     options.minMatches = 500;
+     options.threads = 2;
+     WinEstimate estimate { MatchEstimator{options}.EstimateWin("paper", "rock") };
+
+     EXPECT_TRUE(estimate.converged);
+     EXPECT_EQ(estimate.looks, 1);
+     EXPECT_EQ(estimate.matches, 500u);
+     EXPECT_EQ(estimate.wins, 500u);
+     EXPECT_DOUBLE_EQ(estimate.winProbability, 1.0);
+     EXPECT_DOUBLE_EQ(estimate.upper, 1.0);
+     EXPECT_GT(estimate.lower, 0.98);
+ }
+
+ /**
+  * @test Verify that the interval is tight enough and holds the exact answer.
+  */
+ TEST(MatchEstimatorTest, IntervalHoldsExactWinProbability) {
+     MatchEstimatorOptions options {};
+     options.halfWidth = 0.02;
+     options.masterSeed = 99;
+     WinEstimate estimate { MatchEstimator{options}.EstimateWin("random", "random") };
+     double exact { (1.0 - ExactDrawProbability(21)) / 2.0 };
+
+     EXPECT_TRUE(estimate.converged);
+     EXPECT_GT(estimate.looks, 1);
+     EXPECT_LE(estimate.upper - estimate.lower, 0.04);
+     EXPECT_LE(estimate.lower, exact);
+     EXPECT_GE(estimate.upper, exact);
+     EXPECT_EQ(estimate.wins + estimate.losses + estimate.draws, estimate.matches);
+ }
+
+ /**
+  * @test Verify that estimates do not depend on the thread count.
+  */
+ TEST(MatchEstimatorTest, ThreadCountDoesNotChangeEstimate) {
+     MatchEstimatorOptions options {};
+     options.halfWidth = 0.03;
+     options.threads = 1;
+     WinEstimate single { MatchEstimator{options}.EstimateWin("random", "copycat") };
+     options.threads = 4;
+     WinEstimate parallel { MatchEstimator{options}.EstimateWin("random", "copycat") };
+
+     EXPECT_EQ(single.matches, parallel.matches);
+     EXPECT_EQ(single.wins, parallel.wins);
+     EXPECT_EQ(single.losses, parallel.losses);
+     EXPECT_EQ(single.looks, parallel.looks);
+ }
+
+ /**
+  * @test Verify that common random numbers cancel the luck both pairings share.
+  */
+ TEST(MatchEstimatorTest, CommonRandomNumbersCancelSharedLuck) {
+     MatchEstimatorOptions options {};
+     options.halfWidth = 0.05;
+     WinDifference paired { MatchEstimator{options}.CompareWin("random", "random", "cycle") };
+     options.commonRandomNumbers = false;
+     WinDifference independent { MatchEstimator{options}.CompareWin("random", "random", "cycle") };
+
+     EXPECT_TRUE(paired.converged);
+     EXPECT_EQ(paired.looks, 1);
+     EXPECT_DOUBLE_EQ(paired.difference, 0.0);
+     EXPECT_TRUE(std::isinf(paired.varianceReduction));
+
+     EXPECT_TRUE(independent.converged);
+     EXPECT_GT(independent.matches, paired.matches);
+     EXPECT_LE(independent.lower, 0.0);
+     EXPECT_GE(independent.upper, 0.0);
+     EXPECT_NEAR(independent.varianceReduction, 1.0, 0.2);
+ }
+
+ /**
+  * @test Verify that bad options and unknown strategies are rejected.
+  */
+ TEST(MatchEstimatorTest, RejectsBadInput) {
+     MatchEstimatorOptions options {};
+     options.halfWidth = 0.0;
+     EXPECT_THROW(MatchEstimator{options}, std::invalid_argument);
+     options = {};
+     options.confidence = 1.0;
+     EXPECT_THROW(MatchEstimator{options}, std::invalid_argument);
+     options = {};
+     options.maxMatches = options.minMatches - 1;
+     EXPECT_THROW(MatchEstimator{options}, std::invalid_argument);
+
+     EXPECT_THROW(MatchEstimator{}.EstimateWin("random", "nobody"), std::invalid_argument);
+     EXPECT_NEAR(MatchEstimator::CriticalValue(0.05), 1.959964, 1e-6);
+     EXPECT_THROW(MatchEstimator::CriticalValue(0.0), std::invalid_argument);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,278 @@
+/**
+ * @file test_Matchmaker.cpp
+ * @brief Unit tests for MpmcQueue and the Matchmaker class.
+ *
+ * ## Test Strategy
+ * The queue is checked for FIFO order and bounds on one thread, then for
+ * exactly-once delivery with several producers and consumers. Matchmaker
+ * runs on a fake clock so band widening is deterministic; sessions come
+ * from a real GameSessionFactory whose creator reads CurrentPair().
+ *
+ * ## Gherkin Tests
+ * ### Scenario: The queue is a bounded FIFO
+ *   Given a queue of capacity four
+ *   When five values are pushed and then popped
+ *   Then the fifth push fails and values come out in order
+ *
+ * ### Scenario: Concurrent producers and consumers deliver every value once
+ *   Given two producers and two consumers on a small queue
+ *   When every producer pushes its values
+ *   Then the consumers together pop each value exactly once
+ *
+ * ### Scenario: Players are paired with their nearest rating in the band
+ *   Given four players in one band and one in another
+ *   When a pass runs
+ *   Then the two closest pairs get sessions from the factory
+ *   And the lone player keeps waiting
+ *
+ * ### Scenario: Bands widen while players wait
+ *   Given two players three bands apart
+ *   When passes run as time passes
+ *   Then they are only paired once one of them has waited three intervals
+ *
+ * ### Scenario: A full band rejects requests
+ *   Given a matchmaker with two slots per band
+ *   When three requests arrive in the same band
+ *   Then the third is rejected until a pass drains the band
+ *
+ * ### Scenario: Requests from many threads are all paired
+ *   Given several submitter threads and a matcher thread
+ *   When every request has been submitted and passes run to completion
+ *   Then every player is in exactly one pair
+ */
+
+ #include <gtest/gtest.h>
+ #include <atomic>
+ #include <stdexcept>
+ #include <thread>
+ #include <vector>
+ #include "Matchmaker.hpp"
+
+ namespace {
+
+ /**
+  * @brief A session that only remembers the pair it was created for.
+  */
+ class PairSession : public IGameSession {
+ public:
+     explicit PairSession(const MatchedPair& pair) : m_pair{pair} {}
+     void Play() override {}
+     const MatchedPair& Pair() const { return m_pair; }
+
+ private:
+     MatchedPair m_pair {};
+ };
+
+ constexpr std::uint64_t kSecond {1'000'000'000ull};
+
+ } // namespace
+
+ /**
+  * @test Verifies FIFO order and the capacity bound.
+  */
+ TEST(MpmcQueueTest, BoundedFifo)
+ {
+     MpmcQueue<int> queue{4};
+     for (int i{}; i < 4; ++i) {
+         EXPECT_TRUE(queue.TryPush(i));
+     }
+     EXPECT_FALSE(queue.TryPush(4));
+     EXPECT_EQ(queue.SizeApprox(), 4u);
+
+     int value {};
+     for (int i{}; i < 4; ++i) {
+         ASSERT_TRUE(queue.TryPop(value));
+         EXPECT_EQ(value, i);
+     }
+     EXPECT_FALSE(queue.TryPop(value));
+     EXPECT_TRUE(queue.TryPush(9));
+     EXPECT_THROW(MpmcQueue<int>{6}, std::invalid_argument);
+ }
+
+ /**
+  * @test Verifies exactly-once delivery under contention.
+  */
+ TEST(MpmcQueueTest, ConcurrentProducersAndConsumers)
+ {
+     constexpr int kPerProducer {50000};
+     MpmcQueue<int> queue{64};
+     std::vector<std::atomic<int>> seen(2 * kPerProducer);
+     std::atomic<int> popped {0};
+
+     std::vector<std::thread> threads;
+     for (int p{}; p < 2; ++p) {
+         threads.emplace_back([&queue, p]() {
+             for (int i{}; i < kPerProducer; ++i) {
+                 while (!queue.TryPush(p * kPerProducer + i)) {
+                     std::this_thread::yield();
+                 }
+             }
+         });
+     }
+     for (int c{}; c < 2; ++c) {
+         threads.emplace_back([&]() {
+             int value {};
+             while (popped.load() < 2 * kPerProducer) {
+                 if (queue.TryPop(value)) {
+                     seen[value].fetch_add(1);
+                     popped.fetch_add(1);
+                 } else {
+                     std::this_thread::yield();
+                 }
+             }
+         });
+     }
+     for (auto& thread : threads) {
+         thread.join();
+     }
+
+     for (const auto& count : seen) {
+         ASSERT_EQ(count.load(), 1);
+     }
+ }
+
+ /**
+  * @test Verifies pairing by nearest rating within a band.
+  */
+ TEST(MatchmakerTest, PairsNearestRatingsInBand)
+ {
+     std::uint64_t now {};
+     GameSessionFactory factory;
+     Matchmaker matchmaker{factory, GameMode::ConsoleSinglePlayer, MatchmakerOptions{}, [&now]() { return now; }};
+     factory.RegisterGame<GameMode::ConsoleSinglePlayer>([&matchmaker]() {
+         return std::make_unique<PairSession>(matchmaker.CurrentPair());
+     });
+
+     EXPECT_TRUE(matchmaker.Submit({1, 1510}));
+     EXPECT_TRUE(matchmaker.Submit({2, 1590}));
+     EXPECT_TRUE(matchmaker.Submit({3, 1505}));
+     EXPECT_TRUE(matchmaker.Submit({4, 1580}));
+     EXPECT_TRUE(matchmaker.Submit({5, 1720}));
+
+     std::vector<MatchedPair> pairs;
+     now = kSecond / 2;
+     std::size_t made { matchmaker.RunPass([&](const MatchedPair& pair, std::unique_ptr<IGameSession> session) {
+         auto* created = dynamic_cast<PairSession*>(session.get());
+         ASSERT_NE(created, nullptr);
+         EXPECT_EQ(created->Pair().first.player, pair.first.player);
+         EXPECT_EQ(created->Pair().second.player, pair.second.player);
+         pairs.push_back(pair);
+     }) };
+
+     ASSERT_EQ(made, 2u);
+     EXPECT_EQ(pairs[0].first.player, 3u);
+     EXPECT_EQ(pairs[0].second.player, 1u);
+     EXPECT_EQ(pairs[1].first.player, 4u);
+     EXPECT_EQ(pairs[1].second.player, 2u);
+     EXPECT_EQ(pairs[0].waitedNanos, kSecond / 2);
+     EXPECT_EQ(matchmaker.Waiting(), 1u);
+ }
+
+ /**
+  * @test Verifies that reach grows with waiting time.
+  */
+ TEST(MatchmakerTest, WidensBandsOverTime)
+ {
+     std::uint64_t now {};
+     GameSessionFactory factory;
+     MatchmakerOptions options {};
+     options.widenNanos = kSecond;
+     Matchmaker matchmaker{factory, GameMode::ConsoleSinglePlayer, options, [&now]() { return now; }};
+     auto ignore = [](const MatchedPair&, std::unique_ptr<IGameSession>) {};
+
+     EXPECT_EQ(matchmaker.BandOf(-50), 0u);
+     EXPECT_EQ(matchmaker.BandOf(1250), 12u);
+     EXPECT_EQ(matchmaker.BandOf(99999), options.bandCount - 1);
+
+     EXPECT_TRUE(matchmaker.Submit({1, 1200}));
+     now = kSecond;
+     EXPECT_TRUE(matchmaker.Submit({2, 1530}));
+     for (std::uint64_t second {1}; second < 3; ++second) {
+         now = second * kSecond;
+         EXPECT_EQ(matchmaker.RunPass(ignore), 0u) << "at " << second << "s";
+     }
+     EXPECT_EQ(matchmaker.Waiting(), 2u);
+
+     now = 3 * kSecond;
+     MatchedPair matched {};
+     EXPECT_EQ(matchmaker.RunPass([&](const MatchedPair& pair, std::unique_ptr<IGameSession> session) {
+         EXPECT_EQ(session, nullptr);  // No creator registered for the mode.
+         matched = pair;
+     }), 1u);
+     EXPECT_EQ(matched.first.player, 1u);
+     EXPECT_EQ(matched.waitedNanos, 3 * kSecond);
+     EXPECT_EQ(matchmaker.Waiting(), 0u);
+ }
+
+ /**
+  * @test Verifies back-pressure from a full band.
+  */
+ TEST(MatchmakerTest, FullBandRejectsRequests)
+ {
+     GameSessionFactory factory;
+     MatchmakerOptions options {};
+     options.bandCapacity = 2;
+     Matchmaker matchmaker{factory, GameMode::ConsoleSinglePlayer, options};
+
+     EXPECT_TRUE(matchmaker.Submit({1, 1500}));
+     EXPECT_TRUE(matchmaker.Submit({2, 1500}));
+     EXPECT_FALSE(matchmaker.Submit({3, 1500}));
+     EXPECT_TRUE(matchmaker.Submit({3, 1800}));
+
+     EXPECT_EQ(matchmaker.RunPass([](const MatchedPair&, std::unique_ptr<IGameSession>) {}), 1u);
+     EXPECT_TRUE(matchmaker.Submit({4, 1500}));
+
+     options.bandCapacity = 3;
+     EXPECT_THROW((Matchmaker{factory, GameMode::ConsoleSinglePlayer, options}), std::invalid_argument);
+ }
+
+ /**
+  * @test Verifies that concurrent submissions are all paired exactly once.
+  */
+ TEST(MatchmakerTest, PairsEveryConcurrentRequest)
+ {
+     constexpr int kSubmitters {3};
+     constexpr int kPerSubmitter {10000};
+     std::uint64_t now {};
+     GameSessionFactory factory;
+     MatchmakerOptions options {};
+     options.bandCapacity = 256;
+     options.widenNanos = 1;
+     options.maxWiden = options.bandCount;
+     Matchmaker matchmaker{factory, GameMode::ConsoleSinglePlayer, options, [&now]() { return now; }};
+
+     std::vector<int> matched(kSubmitters * kPerSubmitter);
+     std::atomic<int> submitted {0};
+     std::vector<std::thread> submitters;
+     for (int s{}; s < kSubmitters; ++s) {
+         submitters.emplace_back([&, s]() {
+             for (int i{}; i < kPerSubmitter; ++i) {
+                 MatchRequest request { static_cast<std::uint32_t>(s * kPerSubmitter + i), (i * 37) % 4000 };
+                 while (!matchmaker.Submit(request)) {
+                     std::this_thread::yield();
+                 }
+                 submitted.fetch_add(1);
+             }
+         });
+     }
+
+     auto count = [&](const MatchedPair& pair, std::unique_ptr<IGameSession>) {
+         ++matched[pair.first.player];
+         ++matched[pair.second.player];
+     };
+     while (submitted.load() < kSubmitters * kPerSubmitter) {
+         matchmaker.RunPass(count);
+     }
+     for (auto& submitter : submitters) {
+         submitter.join();
+     }
+     // Fake time only moves on here, so everyone left can reach everyone.
+     now = 1000;
+     matchmaker.RunPass(count);
+
+     EXPECT_EQ(matchmaker.Waiting(), 0u);
+     for (int times : matched) {
+         ASSERT_EQ(times, 1);
+     }
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,107 @@
+/**
+ * @file test_MoveStrategies.cpp
+ * @brief Unit tests for the built-in IMoveStrategy implementations using Google Test.
+ *
+ * ## Test Strategy
+ * Each strategy is driven through NextMove()/ObserveRound() and checked
+ * against its documented sequence. The factory must map names to the
+ * right strategies and reject unknown names.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Constant and cycle strategies follow their sequence
+ *   Given a ConstantStrategy(Paper) and a CycleStrategy
+ *   When several moves are requested
+ *   Then the constant strategy always plays Paper
+ *   And the cycle strategy plays Rock, Paper, Scissors, Rock
+ *
+ * ### Scenario: History-based strategies react to the opponent
+ *   Given a CopycatStrategy and a CounterLastStrategy
+ *   When a round against Scissors is observed
+ *   Then the copycat plays Scissors and the counter plays Rock
+ *
+ * ### Scenario: Random strategy is reproducible per seed
+ *   Given two RandomStrategy objects with the same seed
+ *   When many moves are requested
+ *   Then both produce the same valid sequence
+ *
+ * ### Scenario: Factory resolves names
+ *   Given the strategy names "cycle", "copycat" and "nonsense"
+ *   When MakeMoveStrategy is called
+ *   Then known names yield strategies with the right history dependence
+ *   And the unknown name yields nullptr
+ */
+
+ #include <gtest/gtest.h>
+ #include "MoveStrategies.hpp"
+
+ /**
+  * @test Verifies the constant and cycle sequences.
+  */
+ TEST(MoveStrategiesTest, ConstantAndCycleFollowSequence)
+ {
+     ConstantStrategy constant{GameMove::Paper};
+     CycleStrategy cycle;
+
+     EXPECT_EQ(cycle.NextMove(), GameMove::Rock);
+     EXPECT_EQ(cycle.NextMove(), GameMove::Paper);
+     EXPECT_EQ(cycle.NextMove(), GameMove::Scissors);
+     EXPECT_EQ(cycle.NextMove(), GameMove::Rock);
+     for (int i{}; i < 4; ++i) {
+         EXPECT_EQ(constant.NextMove(), GameMove::Paper);
+     }
+     EXPECT_FALSE(constant.DependsOnHistory());
+     EXPECT_FALSE(cycle.DependsOnHistory());
+ }
+
+ /**
+  * @test Verifies that copycat and counter strategies use the last opponent move.
+  */
+ TEST(MoveStrategiesTest, HistoryStrategiesReactToOpponent)
+ {
+     CopycatStrategy copycat;
+     CounterLastStrategy counter;
+
+     EXPECT_EQ(copycat.NextMove(), GameMove::Rock);
+     copycat.ObserveRound(GameMove::Rock, GameMove::Scissors);
+     counter.ObserveRound(GameMove::Paper, GameMove::Scissors);
+
+     EXPECT_EQ(copycat.NextMove(), GameMove::Scissors);
+     EXPECT_EQ(counter.NextMove(), GameMove::Rock);
+     EXPECT_TRUE(copycat.DependsOnHistory());
+     EXPECT_TRUE(counter.DependsOnHistory());
+     EXPECT_EQ(BeatingMove(GameMove::Paper), GameMove::Scissors);
+ }
+
+ /**
+  * @test Verifies that equal seeds give equal valid sequences.
+  */
+ TEST(MoveStrategiesTest, RandomIsReproduciblePerSeed)
+ {
+     RandomStrategy first{42};
+     RandomStrategy second{42};
+     int counts[4] {};
+     for (int i{}; i < 300; ++i) {
+         GameMove move { first.NextMove() };
+         EXPECT_EQ(move, second.NextMove());
+         ++counts[static_cast<int>(move)];
+     }
+     EXPECT_GT(counts[1], 0);
+     EXPECT_GT(counts[2], 0);
+     EXPECT_GT(counts[3], 0);
+ }
+
+ /**
+  * @test Verifies that the factory resolves known names and rejects unknown ones.
+  */
+ TEST(MoveStrategiesTest, FactoryResolvesNames)
+ {
+     auto cycle = MakeMoveStrategy("cycle", 0);
+     auto copycat = MakeMoveStrategy("copycat", 0);
+     ASSERT_NE(cycle, nullptr);
+     ASSERT_NE(copycat, nullptr);
+     EXPECT_FALSE(cycle->DependsOnHistory());
+     EXPECT_TRUE(copycat->DependsOnHistory());
+     EXPECT_EQ(MakeMoveStrategy("rock", 0)->NextMove(), GameMove::Rock);
+     EXPECT_EQ(MakeMoveStrategy("nonsense", 0), nullptr);
+ }
+ 
\ No newline at end of file
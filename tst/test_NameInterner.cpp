@@ -0,0 +1,96 @@
+/**
+ * @file test_NameInterner.cpp
+ * @brief Unit tests for the NameInterner class using Google Test.
+ *
+ * ## Test Strategy
+ * NameInterner must hand out one id per distinct name and views that stay
+ * valid while more names are added, including from several threads.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Equal names share an id
+ *   Given an interner
+ *   When the same name is interned twice
+ *   Then both calls return the same id and only one name is stored
+ *
+ * ### Scenario: Views stay valid as the table grows
+ *   Given a view of an interned name
+ *   When thousands of other names (some very long) are interned
+ *   Then the original view still points at the same text
+ *
+ * ### Scenario: Concurrent interning is consistent
+ *   Given several threads interning the same set of names
+ *   When all threads finish
+ *   Then every thread saw the same id for each name
+ */
+
+ #include <gtest/gtest.h>
+ #include <string>
+ #include <thread>
+ #include <vector>
+ #include "NameInterner.hpp"
+
+ /**
+  * @test Verifies that equal names share one id.
+  */
+ TEST(NameInternerTest, EqualNamesShareId)
+ {
+     NameInterner interner;
+     auto first = interner.Intern("Alice");
+     auto second = interner.Intern(std::string{"Ali"} + "ce");
+     auto other = interner.Intern("Bob");
+
+     EXPECT_EQ(first, second);
+     EXPECT_NE(first, other);
+     EXPECT_EQ(interner.Size(), 2u);
+     EXPECT_EQ(interner.GetName(first), "Alice");
+     EXPECT_EQ(interner.GetName(other), "Bob");
+ }
+
+ /**
+  * @test Verifies that views stay valid while the table grows.
+  */
+ TEST(NameInternerTest, ViewsStayValidAsTableGrows)
+ {
+     NameInterner interner;
+     auto id = interner.Intern("Stable");
+     std::string_view view { interner.GetName(id) };
+
+     for (int i{}; i < 5000; ++i) {
+         interner.Intern("name-" + std::to_string(i));
+     }
+     interner.Intern(std::string(64 * 1024, 'x'));
+     interner.Intern("");
+
+     EXPECT_EQ(view, "Stable");
+     EXPECT_EQ(interner.GetName(id).data(), view.data());
+     EXPECT_EQ(interner.GetName(interner.Intern(std::string(64 * 1024, 'x'))).size(), 64u * 1024u);
+ }
+
+ /**
+  * @test Verifies that concurrent interning yields consistent ids.
+  */
+ TEST(NameInternerTest, ConcurrentInterningIsConsistent)
+ {
+     constexpr int kThreads {4};
+     constexpr int kNames {500};
+     NameInterner interner;
+     std::vector<std::vector<NameInterner::NameId>> seen(kThreads);
+
+     std::vector<std::thread> threads;
+     for (int t{}; t < kThreads; ++t) {
+         threads.emplace_back([&, t]() {
+             for (int i{}; i < kNames; ++i) {
+                 seen[t].push_back(interner.Intern("player-" + std::to_string(i)));
+             }
+         });
+     }
+     for (auto& thread : threads) {
+         thread.join();
+     }
+
+     EXPECT_EQ(interner.Size(), static_cast<std::size_t>(kNames));
+     for (int t{1}; t < kThreads; ++t) {
+         EXPECT_EQ(seen[t], seen[0]);
+     }
+ }
+ 
\ No newline at end of file
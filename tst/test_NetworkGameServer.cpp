@@ -0,0 +1,265 @@
+/**
+ * @file test_NetworkGameServer.cpp
+ * @brief Unit tests for NetworkGameServer and the network backends.
+ *
+ * ## Test Strategy
+ * Clients are BotClient threads on one end of a Unix socket pair; the
+ * server gets the other end. Every scenario runs once per backend the
+ * kernel supports (io_uring is skipped where it is unavailable), so both
+ * backends are held to the same behaviour.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: A batchable client plays a whole session
+ *   Given a "paper" client against a computer that always plays rock
+ *   When the server runs 600 rounds
+ *   Then the client wins all of them in far fewer exchanges than rounds
+ *
+ * ### Scenario: A history-dependent client sees the computer's moves
+ *   Given a "counter" client, asked for one move at a time
+ *   When the server runs
+ *   Then it wins every round after the first
+ *
+ * ### Scenario: Many sessions share one backend
+ *   Given 40 sessions with random clients
+ *   When the server runs
+ *   Then every session completes with all rounds accounted for
+ *
+ * ### Scenario: A client that leaves or breaks the protocol ends its session
+ *   Given one client that disconnects after Hello and one that sends unasked Moves
+ *   When the server runs
+ *   Then both sessions are reported incomplete and Run() returns
+ *
+ * ### Scenario: Removing a connection delivers what was queued first
+ *   Given bytes queued for a connection
+ *   When it is removed
+ *   Then the peer reads those bytes, then end of stream
+ *
+ * ### Scenario: The factory falls back to epoll
+ *   Given the Automatic kind
+ *   When a backend is created
+ *   Then it is io_uring where the kernel supports it and epoll otherwise
+ */
+
+ #include <gtest/gtest.h>
+ #include <string>
+ #include <sys/socket.h>
+ #include <system_error>
+ #include <thread>
+ #include <unistd.h>
+ #include <vector>
+ #include "BotClient.hpp"
+ #include "BotProtocol.hpp"
+ #include "MoveStrategies.hpp"
+ #include "NetworkBackendFactory.hpp"
+ #include "NetworkGameServer.hpp"
+
+ namespace {
+
+ /**
+  * @brief The backends this kernel can run.
+  */
+ std::vector<NetworkBackendKind> AvailableKinds() {
+     std::vector<NetworkBackendKind> kinds {NetworkBackendKind::Epoll};
+     try {
+         NetworkBackendFactory::Create(NetworkBackendKind::IoUring);
+         kinds.push_back(NetworkBackendKind::IoUring);
+     } catch (const std::system_error&) {
+     }
+     return kinds;
+ }
+
+ /**
+  * @brief Client threads, each running a BotClient with a built-in strategy.
+  */
+ class Clients {
+ public:
+     ~Clients() {
+         for (auto& thread : m_threads) {
+             thread.join();
+         }
+     }
+
+     /**
+      * @brief Starts a client and returns the server's end of its socket.
+      */
+     int Start(const std::string& strategy, std::uint64_t seed = 0) {
+         int fds[2] {};
+         EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+         m_threads.emplace_back([client = fds[1], strategy, seed]() {
+             auto moves = MakeMoveStrategy(strategy, seed);
+             BotClient{client, client, *moves}.Run();
+             ::close(client);
+         });
+         return fds[0];
+     }
+
+     /**
+      * @brief Starts a client that runs `script` on its end of the socket.
+      */
+     template <typename Script>
+     int StartScripted(Script script) {
+         int fds[2] {};
+         EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+         m_threads.emplace_back([client = fds[1], script]() {
+             script(client);
+             ::close(client);
+         });
+         return fds[0];
+     }
+
+ private:
+     std::vector<std::thread> m_threads {};
+ };
+
+ int AlwaysRock() {
+     return 0;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies a batched session and its exchange count.
+  */
+ TEST(NetworkGameServerTest, BatchableClientPlaysWholeSession)
+ {
+     for (NetworkBackendKind kind : AvailableKinds()) {
+         // Declared first so the server closes its sockets before the clients are joined.
+         Clients clients;
+         NetworkGameServer server{NetworkBackendFactory::Create(kind)};
+         SCOPED_TRACE(server.Backend().Name());
+         server.AddSession(clients.Start("paper"), "Ann", "Bot", 600, AlwaysRock);
+
+         auto results = server.Run();
+         ASSERT_EQ(results.size(), 1u);
+         EXPECT_TRUE(results[0].completed);
+         EXPECT_EQ(results[0].roundsPlayed, 600);
+         EXPECT_EQ(results[0].userScore, 600);
+         EXPECT_EQ(results[0].computerScore, 0);
+         EXPECT_LT(server.Backend().SyscallCount(), 60u);
+     }
+ }
+
+ /**
+  * @test Verifies that Requests carry the computer's moves as history.
+  */
+ TEST(NetworkGameServerTest, HistoryDependentClientSeesComputerMoves)
+ {
+     for (NetworkBackendKind kind : AvailableKinds()) {
+         Clients clients;
+         NetworkGameServer server{NetworkBackendFactory::Create(kind)};
+         SCOPED_TRACE(server.Backend().Name());
+         server.AddSession(clients.Start("counter"), "Ann", "Bot", 50, AlwaysRock);
+
+         auto results = server.Run();
+         EXPECT_TRUE(results[0].completed);
+         EXPECT_EQ(results[0].roundsPlayed, 50);
+         EXPECT_GE(results[0].userScore, 49);
+     }
+ }
+
+ /**
+  * @test Verifies many concurrent sessions on one backend.
+  */
+ TEST(NetworkGameServerTest, ManySessionsShareOneBackend)
+ {
+     for (NetworkBackendKind kind : AvailableKinds()) {
+         Clients clients;
+         NetworkGameServer server{NetworkBackendFactory::Create(kind)};
+         SCOPED_TRACE(server.Backend().Name());
+         for (int i{}; i < 40; ++i) {
+             int counter {i};
+             server.AddSession(clients.Start(i % 2 ? "random" : "copycat", static_cast<std::uint64_t>(i)),
+                               "User" + std::to_string(i), "Bot", 100 + i, [counter]() mutable { return counter++; });
+         }
+
+         auto results = server.Run();
+         ASSERT_EQ(results.size(), 40u);
+         for (int i{}; i < 40; ++i) {
+             const auto& result { results[static_cast<std::size_t>(i)] };
+             EXPECT_TRUE(result.completed) << i;
+             EXPECT_EQ(result.roundsPlayed, 100 + i);
+             EXPECT_LE(result.userScore + result.computerScore, 100 + i);
+             EXPECT_EQ(result.invalidRounds, 0);
+         }
+     }
+ }
+
+ /**
+  * @test Verifies that a departed or misbehaving client ends only its session.
+  */
+ TEST(NetworkGameServerTest, MisbehavingClientsEndTheirSessions)
+ {
+     for (NetworkBackendKind kind : AvailableKinds()) {
+         Clients clients;
+         NetworkGameServer server{NetworkBackendFactory::Create(kind)};
+         SCOPED_TRACE(server.Backend().Name());
+         server.AddSession(clients.StartScripted([](int fd) {
+             std::uint8_t frame[BotProtocol::kMaxFrameSize];
+             (void)::write(fd, frame, BotProtocol::EncodeHello(0, frame));
+         }), "Leaver", "Bot", 10, AlwaysRock);
+         server.AddSession(clients.StartScripted([](int fd) {
+             std::uint8_t frame[BotProtocol::kMaxFrameSize];
+             std::uint8_t moves[] {1, 2};
+             (void)::write(fd, frame, BotProtocol::EncodeMoves(moves, 2, frame));
+             // Hold the socket open: only the protocol error may end the session.
+             (void)::read(fd, frame, sizeof(frame));
+         }), "Cheater", "Bot", 10, AlwaysRock);
+         server.AddSession(clients.Start("rock"), "Ann", "Bot", 10, AlwaysRock);
+
+         auto results = server.Run();
+         EXPECT_FALSE(results[0].completed);
+         EXPECT_FALSE(results[1].completed);
+         EXPECT_EQ(results[1].roundsPlayed, 0);
+         EXPECT_TRUE(results[2].completed);
+         EXPECT_EQ(results[2].roundsPlayed, 10);
+     }
+ }
+
+ /**
+  * @test Verifies that Remove() sends queued bytes before closing.
+  */
+ TEST(NetworkBackendTest, RemoveDeliversQueuedBytes)
+ {
+     for (NetworkBackendKind kind : AvailableKinds()) {
+         auto backend = NetworkBackendFactory::Create(kind);
+         SCOPED_TRACE(backend->Name());
+         int fds[2] {};
+         ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+         auto connection = backend->Add(fds[0]);
+
+         const std::string text {"goodbye"};
+         backend->Send(connection, reinterpret_cast<const std::uint8_t*>(text.data()), text.size());
+         backend->Remove(connection);
+         // io_uring completes the write and the cancelled receive asynchronously.
+         for (int i{}; i < 5; ++i) {
+             backend->Poll([](INetworkBackend::ConnectionId, const std::uint8_t*, std::size_t) {}, 20);
+         }
+
+         std::string received;
+         char buffer[64];
+         ssize_t count {};
+         while ((count = ::read(fds[1], buffer, sizeof(buffer))) > 0) {
+             received.append(buffer, static_cast<std::size_t>(count));
+         }
+         EXPECT_EQ(count, 0);
+         EXPECT_EQ(received, text);
+         ::close(fds[1]);
+     }
+ }
+
+ /**
+  * @test Verifies backend selection by kind and by name.
+  */
+ TEST(NetworkBackendFactoryTest, AutomaticFallsBackToEpoll)
+ {
+     auto kinds = AvailableKinds();
+     std::string expected { kinds.size() > 1 ? "io_uring" : "epoll" };
+     EXPECT_EQ(NetworkBackendFactory::Create()->Name(), expected);
+     EXPECT_EQ(std::string(NetworkBackendFactory::Create(NetworkBackendKind::Epoll)->Name()), "epoll");
+
+     EXPECT_EQ(NetworkBackendFactory::ParseKind("auto"), NetworkBackendKind::Automatic);
+     EXPECT_EQ(NetworkBackendFactory::ParseKind("epoll"), NetworkBackendKind::Epoll);
+     EXPECT_EQ(NetworkBackendFactory::ParseKind("io_uring"), NetworkBackendKind::IoUring);
+     EXPECT_THROW(NetworkBackendFactory::ParseKind("kqueue"), std::invalid_argument);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,56 @@
+/**
+ * @file test_PlayerHandle.cpp
+ * @brief Unit tests for the PlayerHandle class using Google Test.
+ *
+ * ## Test Strategy
+ * A PlayerHandle must behave like any other IPlayer while storing its
+ * state in a PlayerRegistry row.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Handle reads its registry row
+ *   Given a registry with a player named "Alice"
+ *   When a handle for that player is queried through IPlayer
+ *   Then it reports the registry name and score
+ *
+ * ### Scenario: Handle writes its registry row
+ *   Given a handle for one of two players
+ *   When AddWin is called on the handle
+ *   Then only that player's registry score increments
+ */
+
+ #include <gtest/gtest.h>
+ #include <memory>
+ #include "PlayerHandle.hpp"
+ #include "PlayerRegistry.hpp"
+
+ /**
+  * @test Verifies that the handle reads its registry row.
+  */
+ TEST(PlayerHandleTest, ReadsRegistryRow)
+ {
+     PlayerRegistry registry;
+     auto id = registry.Add("Alice");
+     registry.AddWin(id);
+
+     std::unique_ptr<IPlayer> player = std::make_unique<PlayerHandle>(registry, id);
+     EXPECT_EQ(player->GetName(), "Alice");
+     EXPECT_EQ(player->GetScore(), 1);
+ }
+
+ /**
+  * @test Verifies that the handle writes only its own registry row.
+  */
+ TEST(PlayerHandleTest, AddWinUpdatesRegistryRow)
+ {
+     PlayerRegistry registry;
+     auto first = registry.Add("First");
+     auto second = registry.Add("Second");
+
+     PlayerHandle handle{registry, second};
+     handle.AddWin();
+
+     EXPECT_EQ(handle.GetId(), second);
+     EXPECT_EQ(registry.GetScore(second), 1);
+     EXPECT_EQ(registry.GetScore(first), 0);
+ }
+ 
\ No newline at end of file
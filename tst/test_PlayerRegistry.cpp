@@ -0,0 +1,126 @@
+/**
+ * @file test_PlayerRegistry.cpp
+ * @brief Unit tests for the PlayerRegistry class using Google Test.
+ *
+ * ## Test Strategy
+ * PlayerRegistry keeps player state in parallel columns. We verify that
+ * per-player accessors read and write the right row, and that the bulk
+ * operations (top-K, reset) agree with a straightforward reference.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Added players get dense ids and default state
+ *   Given an empty registry
+ *   When two players are added
+ *   Then they get ids 0 and 1, zero scores, and the initial rating
+ *
+ * ### Scenario: Per-player updates touch only their own row
+ *   Given a registry with several players
+ *   When one player wins twice and another gets a new rating
+ *   Then only those rows change
+ *
+ * ### Scenario: Top-K returns the best scores, lower id first on ties
+ *   Given players with known scores
+ *   When TopKByScore is called
+ *   Then ids are returned from highest to lowest score
+ *
+ * ### Scenario: ResetAllScores clears every score
+ *   Given players with non-zero scores
+ *   When ResetAllScores is called
+ *   Then every score is zero and ratings are unchanged
+ */
+
+ #include <gtest/gtest.h>
+ #include <string>
+ #include "PlayerRegistry.hpp"
+
+ /**
+  * @brief Test fixture for PlayerRegistry.
+  */
+ class PlayerRegistryTest : public ::testing::Test {
+ protected:
+     PlayerRegistry m_registry;
+
+     /**
+      * @brief Adds a player and gives it the requested number of wins.
+      */
+     PlayerRegistry::PlayerId AddWithScore(const std::string& name, int wins) {
+         auto id = m_registry.Add(name);
+         for (int i{}; i < wins; ++i) {
+             m_registry.AddWin(id);
+         }
+         return id;
+     }
+ };
+
+ /**
+  * @test Verifies ids, names and default state of added players.
+  */
+ TEST_F(PlayerRegistryTest, AddAssignsDenseIdsAndDefaults)
+ {
+     auto alice = m_registry.Add("Alice");
+     auto bob = m_registry.Add("Bob", 1700);
+
+     EXPECT_EQ(alice, 0u);
+     EXPECT_EQ(bob, 1u);
+     EXPECT_EQ(m_registry.Size(), 2u);
+     EXPECT_EQ(m_registry.GetName(alice), "Alice");
+     EXPECT_EQ(m_registry.GetName(bob), "Bob");
+     EXPECT_EQ(m_registry.GetScore(alice), 0);
+     EXPECT_EQ(m_registry.GetRating(alice), PlayerRegistry::kInitialRating);
+     EXPECT_EQ(m_registry.GetRating(bob), 1700);
+ }
+
+ /**
+  * @test Verifies that updates only affect the targeted row.
+  */
+ TEST_F(PlayerRegistryTest, UpdatesTouchOnlyTheirRow)
+ {
+     auto a = m_registry.Add("A");
+     auto b = m_registry.Add("B");
+     auto c = m_registry.Add("C");
+
+     m_registry.AddWin(b);
+     m_registry.AddWin(b);
+     m_registry.SetRating(c, 1234);
+
+     EXPECT_EQ(m_registry.GetScore(a), 0);
+     EXPECT_EQ(m_registry.GetScore(b), 2);
+     EXPECT_EQ(m_registry.GetScore(c), 0);
+     EXPECT_EQ(m_registry.GetRating(a), PlayerRegistry::kInitialRating);
+     EXPECT_EQ(m_registry.GetRating(c), 1234);
+     EXPECT_EQ(m_registry.Scores()[b], 2);
+ }
+
+ /**
+  * @test Verifies top-K ordering and tie-breaking.
+  */
+ TEST_F(PlayerRegistryTest, TopKByScoreOrdersAndBreaksTies)
+ {
+     AddWithScore("p0", 3);
+     AddWithScore("p1", 7);
+     AddWithScore("p2", 1);
+     AddWithScore("p3", 7);
+     AddWithScore("p4", 5);
+
+     EXPECT_EQ(m_registry.TopKByScore(3), (std::vector<PlayerRegistry::PlayerId>{1, 3, 4}));
+     EXPECT_EQ(m_registry.TopKByScore(1), (std::vector<PlayerRegistry::PlayerId>{1}));
+     EXPECT_EQ(m_registry.TopKByScore(10).size(), 5u);
+     EXPECT_TRUE(m_registry.TopKByScore(0).empty());
+ }
+
+ /**
+  * @test Verifies that ResetAllScores zeroes scores only.
+  */
+ TEST_F(PlayerRegistryTest, ResetAllScoresClearsScores)
+ {
+     auto a = AddWithScore("A", 4);
+     auto b = AddWithScore("B", 2);
+     m_registry.SetRating(b, 1600);
+
+     m_registry.ResetAllScores();
+
+     EXPECT_EQ(m_registry.GetScore(a), 0);
+     EXPECT_EQ(m_registry.GetScore(b), 0);
+     EXPECT_EQ(m_registry.GetRating(b), 1600);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,257 @@
+/**
+ * @file test_ProfileStore.cpp
+ * @brief Unit tests for ProfileStore and MatchTally using Google Test.
+ *
+ * ## Test Strategy
+ * A profile store is only useful if reopening its directory gives back
+ * exactly what was recorded. Every test records matches, closes the store
+ * (or damages its files) and checks the profiles seen after reopening,
+ * whether they come from the log alone, a snapshot plus a log tail, or a
+ * log whose last write was cut short.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: A tally summarises a session
+ *   Given a MatchTally fed four rounds including a forfeit
+ *   When the match is read back
+ *   Then round counts and move models follow the valid rounds only
+ *
+ * ### Scenario: Matches survive reopening
+ *   Given a store that recorded matches between three players
+ *   When it is closed and reopened
+ *   Then every profile, including ratings, is unchanged
+ *
+ * ### Scenario: Snapshots replace the log they cover
+ *   Given a store with a tiny snapshot threshold and many matches
+ *   When it is reopened
+ *   Then profiles are loaded from the snapshot plus a short log tail
+ *   And old log segments have been deleted
+ *
+ * ### Scenario: A torn final record is dropped
+ *   Given a store directory whose last log record was cut in half
+ *   When it is reopened
+ *   Then every complete record is replayed and the torn bytes are reported
+ *
+ * ### Scenario: Concurrent writers share group commits
+ *   Given four threads recording matches at once
+ *   When all of them wait for durability and the store is reopened
+ *   Then the totals match the number of recorded matches
+ */
+
+ #include <gtest/gtest.h>
+ #include <filesystem>
+ #include <fstream>
+ #include <string>
+ #include <thread>
+ #include <vector>
+ #include "MatchTally.hpp"
+ #include "ProfileStore.hpp"
+
+ namespace {
+
+ /**
+  * @brief A fresh store directory under the test temp dir, removed afterwards.
+  */
+ class ProfileStoreTest : public ::testing::Test {
+ protected:
+     void SetUp() override {
+         const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+         m_directory = ::testing::TempDir() + "rps_profiles_" + info->name();
+         std::filesystem::remove_all(m_directory);
+     }
+
+     void TearDown() override {
+         std::filesystem::remove_all(m_directory);
+     }
+
+     std::vector<std::filesystem::path> Segments() const {
+         std::vector<std::filesystem::path> segments;
+         for (const auto& file : std::filesystem::directory_iterator(m_directory)) {
+             if (file.path().extension() == ".log") {
+                 segments.push_back(file.path());
+             }
+         }
+         return segments;
+     }
+
+     std::string m_directory {};
+ };
+
+ MatchRecord MakeMatch(std::string_view user, std::string_view computer,
+                       std::uint32_t userWins, std::uint32_t computerWins, std::uint32_t draws) {
+     MatchRecord match {};
+     match.user.name = user;
+     match.user.roundsWon = userWins;
+     match.user.model.moves = {userWins, draws, computerWins};
+     match.user.model.follows[0][1] = 1;
+     match.computer.name = computer;
+     match.computer.roundsWon = computerWins;
+     match.computer.model.moves = {draws, computerWins, userWins};
+     match.roundsDrawn = draws;
+     return match;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies that a tally counts rounds and moves of valid rounds.
+  */
+ TEST(MatchTallyTest, SummarisesSession)
+ {
+     MatchTally tally;
+     auto round = [&](std::uint8_t user, std::uint8_t computer, RoundOutcome outcome) {
+         RoundRecord record {};
+         record.userMove = user;
+         record.computerMove = computer;
+         record.outcome = outcome;
+         record.userName = "Human: Ann";
+         record.computerName = "Computer: Bot";
+         tally.OnRound(record);
+     };
+     round(1, 3, RoundOutcome::UserWin);
+     round(2, 2, RoundOutcome::Draw);
+     round(0, 1, RoundOutcome::Forfeit);
+     round(2, 3, RoundOutcome::ComputerWin);
+
+     MatchRecord match { tally.Match() };
+     EXPECT_EQ(match.user.name, "Human: Ann");
+     EXPECT_EQ(match.computer.name, "Computer: Bot");
+     EXPECT_EQ(match.user.roundsWon, 1u);
+     EXPECT_EQ(match.computer.roundsWon, 1u);
+     EXPECT_EQ(match.roundsDrawn, 1u);
+
+     EXPECT_EQ(match.user.model.moves, (std::array<std::uint64_t, 3>{1, 2, 0}));
+     EXPECT_EQ(match.user.model.follows[0][1], 1u);
+     EXPECT_EQ(match.user.model.follows[1][1], 1u);
+     EXPECT_EQ(match.computer.model.moves, (std::array<std::uint64_t, 3>{1, 1, 2}));
+     EXPECT_EQ(match.computer.model.follows[0][2], 1u);
+ }
+
+ /**
+  * @test Verifies that profiles are rebuilt from the log after reopening.
+  */
+ TEST_F(ProfileStoreTest, MatchesSurviveReopening)
+ {
+     PlayerProfile ann, bob, cat;
+     {
+         ProfileStore store{m_directory};
+         store.RecordMatch(MakeMatch("ann", "bob", 3, 1, 1));
+         store.RecordMatch(MakeMatch("bob", "cat", 2, 2, 0));
+         std::uint64_t last { store.RecordMatch(MakeMatch("cat", "ann", 0, 4, 1)) };
+         EXPECT_EQ(last, 3u);
+         store.WaitDurable(last);
+
+         ann = *store.Find("ann");
+         bob = *store.Find("bob");
+         cat = *store.Find("cat");
+     }
+     EXPECT_EQ(ann.matchesWon, 2u);
+     EXPECT_EQ(ann.roundsWon, 7u);
+     EXPECT_EQ(ann.roundsLost, 1u);
+     EXPECT_EQ(bob.matchesDrawn, 1u);
+     EXPECT_GT(ann.rating, 1500);
+     EXPECT_EQ(ann.rating + bob.rating + cat.rating, 3 * 1500);
+
+     ProfileStore reopened{m_directory};
+     EXPECT_EQ(reopened.Recovery().replayedRecords, 3u);
+     EXPECT_EQ(reopened.LastSequence(), 3u);
+     EXPECT_EQ(reopened.Size(), 3u);
+     EXPECT_EQ(*reopened.Find("ann"), ann);
+     EXPECT_EQ(*reopened.Find("bob"), bob);
+     EXPECT_EQ(*reopened.Find("cat"), cat);
+     EXPECT_FALSE(reopened.Find("dan").has_value());
+ }
+
+ /**
+  * @test Verifies recovery from a snapshot plus a log tail.
+  */
+ TEST_F(ProfileStoreTest, SnapshotsReplaceTheLogTheyCover)
+ {
+     ProfileStoreOptions options {};
+     options.snapshotBytes = 4096;
+     options.syncWrites = false;
+
+     PlayerProfile expected;
+     {
+         ProfileStore store{m_directory, options};
+         for (int i{}; i < 500; ++i) {
+             std::string user { "player" + std::to_string(i % 37) };
+             store.WaitDurable(store.RecordMatch(MakeMatch(user, "house", i % 3, 1, i % 2)));
+         }
+         store.Compact();
+         store.RecordMatch(MakeMatch("player1", "house", 5, 0, 0));
+         expected = *store.Find("house");
+     }
+
+     EXPECT_TRUE(std::filesystem::exists(m_directory + "/profiles.snapshot"));
+     EXPECT_LE(Segments().size(), 2u);
+
+     ProfileStore reopened{m_directory, options};
+     EXPECT_EQ(reopened.Recovery().snapshotProfiles, 38u);
+     EXPECT_EQ(reopened.Recovery().replayedRecords, 1u);
+     EXPECT_EQ(reopened.LastSequence(), 501u);
+     EXPECT_EQ(*reopened.Find("house"), expected);
+ }
+
+ /**
+  * @test Verifies that a half-written final record is dropped on recovery.
+  */
+ TEST_F(ProfileStoreTest, TornFinalRecordIsDropped)
+ {
+     {
+         ProfileStore store{m_directory};
+         store.RecordMatch(MakeMatch("ann", "bob", 1, 0, 0));
+         store.RecordMatch(MakeMatch("ann", "bob", 2, 0, 0));
+         store.RecordMatch(MakeMatch("ann", "bob", 4, 0, 0));
+     }
+     auto segments = Segments();
+     ASSERT_EQ(segments.size(), 1u);
+     auto size = std::filesystem::file_size(segments.front());
+     std::filesystem::resize_file(segments.front(), size - 5);
+
+     {
+         ProfileStore reopened{m_directory};
+         EXPECT_EQ(reopened.Recovery().replayedRecords, 2u);
+         EXPECT_GT(reopened.Recovery().discardedBytes, 0u);
+         EXPECT_EQ(reopened.Find("ann")->roundsWon, 3u);
+         reopened.RecordMatch(MakeMatch("ann", "bob", 8, 0, 0));
+     }
+
+     // The segment was cut back to its last whole record, so appending to it was safe.
+     EXPECT_EQ(Segments().size(), 1u);
+     ProfileStore again{m_directory};
+     EXPECT_EQ(again.Recovery().discardedBytes, 0u);
+     EXPECT_EQ(again.Find("ann")->roundsWon, 11u);
+ }
+
+ /**
+  * @test Verifies concurrent writers with durable waits.
+  */
+ TEST_F(ProfileStoreTest, ConcurrentWritersShareGroupCommits)
+ {
+     constexpr int kThreads {4};
+     constexpr int kMatchesPerThread {200};
+     {
+         ProfileStore store{m_directory};
+         std::vector<std::thread> writers;
+         for (int t{}; t < kThreads; ++t) {
+             writers.emplace_back([&store, t]() {
+                 std::string user { "writer" + std::to_string(t) };
+                 for (int i{}; i < kMatchesPerThread; ++i) {
+                     store.WaitDurable(store.RecordMatch(MakeMatch(user, "house", 1, 0, 0)));
+                 }
+             });
+         }
+         for (auto& writer : writers) {
+             writer.join();
+         }
+     }
+
+     ProfileStore reopened{m_directory};
+     EXPECT_EQ(reopened.LastSequence(), static_cast<std::uint64_t>(kThreads * kMatchesPerThread));
+     EXPECT_EQ(reopened.Find("house")->matchesLost, static_cast<std::uint64_t>(kThreads * kMatchesPerThread));
+     for (int t{}; t < kThreads; ++t) {
+         EXPECT_EQ(reopened.Find("writer" + std::to_string(t))->matchesWon,
+                   static_cast<std::uint64_t>(kMatchesPerThread));
+     }
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,55 @@
+/**
+ * @file test_QueuedMoveMessenger.cpp
+ * @brief Unit tests for the QueuedMoveMessenger class using Google Test.
+ *
+ * ## Test Strategy
+ * Moves pushed by the host must come out in order, singly or batched,
+ * and an empty queue must forfeit rather than block.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Moves are served in order
+ *   Given a messenger with moves 1, 2 and 3 queued
+ *   When one move and then a batch of up to 8 are requested
+ *   Then 1 is returned first and the batch holds 2 and 3
+ *
+ * ### Scenario: Empty queue forfeits
+ *   Given an empty messenger
+ *   When a move is requested
+ *   Then -1 is returned
+ */
+
+ #include <gtest/gtest.h>
+ #include "QueuedMoveMessenger.hpp"
+
+ /**
+  * @test Verifies that queued moves are served in order.
+  */
+ TEST(QueuedMoveMessengerTest, ServesMovesInOrder)
+ {
+     QueuedMoveMessenger messenger;
+     messenger.PushMove(1);
+     messenger.PushMove(2);
+     messenger.PushMove(3);
+
+     EXPECT_EQ(messenger.RequestMoveChoice(), 1);
+
+     int moves[8] {};
+     ASSERT_EQ(messenger.RequestMoveChoices(moves, 8), 2u);
+     EXPECT_EQ(moves[0], 2);
+     EXPECT_EQ(moves[1], 3);
+     EXPECT_EQ(messenger.PendingMoves(), 0u);
+ }
+
+ /**
+  * @test Verifies that an empty queue forfeits the move.
+  */
+ TEST(QueuedMoveMessengerTest, EmptyQueueForfeits)
+ {
+     QueuedMoveMessenger messenger;
+     EXPECT_EQ(messenger.RequestMoveChoice(), -1);
+
+     int move {};
+     ASSERT_EQ(messenger.RequestMoveChoices(&move, 1), 1u);
+     EXPECT_EQ(move, -1);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,151 @@
+/**
+ * @file test_RngAudit.cpp
+ * @brief Unit tests for RngAudit.
+ *
+ * ## Test Strategy
+ * The p-value functions are checked against textbook critical values.
+ * The audit is then fed a good generator, which must pass, and generators
+ * with known defects (bias, a fixed cycle, sticky repeats), each of which
+ * must fail the tests aimed at its defect. Reports are compared across
+ * thread counts, and bad generators and options must be rejected.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: P-values match critical values
+ *   Given the 5% critical values of chi-square and the normal distribution
+ *   Then the computed p-values are 0.05
+ *
+ * ### Scenario: A good generator passes and defective ones fail
+ *   Given Xoshiro256, a biased, a cycling and a sticky generator
+ *   When each is audited
+ *   Then Xoshiro256 passes every test
+ *   And each defect is caught by the tests that look for it
+ *
+ * ### Scenario: The report does not depend on the thread count
+ *   Given many short segments
+ *   When they are audited on 1 and on 3 threads
+ *   Then the counts and statistics are identical
+ *
+ * ### Scenario: Bad input is rejected
+ *   Given a generator that returns negative values, or too few moves
+ *   Then the audit throws
+ */
+
+ #include <gtest/gtest.h>
+ #include <stdexcept>
+ #include "RngAudit.hpp"
+ #include "Xoshiro256.hpp"
+
+ namespace {
+
+ MoveGeneratorFactory XoshiroFactory(std::uint64_t seed) {
+     return [seed](std::uint64_t segment) {
+         return std::function<int()>{[engine = Xoshiro256::ForStream(seed, segment)]() mutable {
+             return static_cast<int>(engine() >> 33);
+         }};
+     };
+ }
+
+ RngAuditReport Audit(MoveGeneratorFactory factory, std::uint64_t moves, unsigned threads = 1,
+                      std::uint64_t segment = std::uint64_t{1} << 24) {
+     return RngAudit{std::move(factory), {moves, segment, threads}}.Run();
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies the p-value functions at 5% critical values.
+  */
+ TEST(RngAuditTest, PValuesMatchCriticalValues)
+ {
+     EXPECT_NEAR(RngAudit::ChiSquarePValue(5.991, 2), 0.05, 1e-4);
+     EXPECT_NEAR(RngAudit::ChiSquarePValue(12.592, 6), 0.05, 1e-4);
+     EXPECT_NEAR(RngAudit::ChiSquarePValue(14.067, 7), 0.05, 1e-4);
+     EXPECT_NEAR(RngAudit::ChiSquarePValue(0.0, 7), 1.0, 1e-12);
+     EXPECT_LT(RngAudit::ChiSquarePValue(500.0, 2), 1e-100);
+     EXPECT_NEAR(RngAudit::NormalPValue(1.959964), 0.05, 1e-6);
+     EXPECT_NEAR(RngAudit::NormalPValue(-1.959964), 0.05, 1e-6);
+     EXPECT_THROW(RngAudit::ChiSquarePValue(1.0, 0), std::invalid_argument);
+ }
+
+ /**
+  * @test Verifies that defects are caught and a good generator passes.
+  */
+ TEST(RngAuditTest, GoodGeneratorPassesAndDefectsAreCaught)
+ {
+     constexpr std::uint64_t kMoves {1 << 20};
+     RngAuditReport good { Audit(XoshiroFactory(3), kMoves) };
+     EXPECT_EQ(good.moveCounts[0] + good.moveCounts[1] + good.moveCounts[2], kMoves);
+     EXPECT_GT(good.MinPValue(), 1e-3);
+     EXPECT_GT(good.MovesPerSecond(), 0.0);
+
+     // Move 0 a tenth more often than it should be.
+     RngAuditReport biased { Audit([](std::uint64_t) {
+         return std::function<int()>{[engine = Xoshiro256{5}]() mutable {
+             return engine.NextBelow(30) < 11 ? 0 : static_cast<int>(1 + engine.NextBelow(2));
+         }};
+     }, kMoves) };
+     EXPECT_LT(biased.frequency.pValue, 1e-9);
+
+     // Perfectly balanced, perfectly predictable.
+     RngAuditReport cycling { Audit([](std::uint64_t) {
+         return std::function<int()>{[next = 0]() mutable { return next++; }};
+     }, kMoves) };
+     EXPECT_GT(cycling.frequency.pValue, 0.99);
+     EXPECT_LT(cycling.serial.pValue, 1e-9);
+     EXPECT_LT(cycling.runs.pValue, 1e-9);
+     EXPECT_EQ(cycling.runLengths[0], kMoves - 7); // starts in the last 7 moves are dropped
+
+     // Repeats the previous move half of the time.
+     RngAuditReport sticky { Audit([](std::uint64_t) {
+         return std::function<int()>{[engine = Xoshiro256{9}, last = 0]() mutable {
+             if (engine.NextBelow(2) == 0) {
+                 last = static_cast<int>(engine.NextBelow(3));
+             }
+             return last;
+         }};
+     }, kMoves) };
+     EXPECT_GT(sticky.frequency.pValue, 1e-4);
+     EXPECT_LT(sticky.serial.pValue, 1e-9);
+     EXPECT_LT(sticky.correlation.pValue, 1e-9);
+     EXPECT_LT(sticky.runs.pValue, 1e-9);
+     EXPECT_LT(sticky.runLengthTest.pValue, 1e-9);
+
+     RngAuditReport constant { Audit([](std::uint64_t) { return std::function<int()>{[]() { return 4; }}; }, 1000) };
+     EXPECT_EQ(constant.MinPValue(), 0.0);
+ }
+
+ /**
+  * @test Verifies that the report does not depend on the thread count.
+  */
+ TEST(RngAuditTest, ReportDoesNotDependOnThreadCount)
+ {
+     RngAuditReport one { Audit(XoshiroFactory(8), 100003, 1, 1000) };
+     RngAuditReport three { Audit(XoshiroFactory(8), 100003, 3, 1000) };
+     EXPECT_EQ(one.moves, 100003u);
+     EXPECT_EQ(one.moveCounts, three.moveCounts);
+     EXPECT_EQ(one.pairCounts, three.pairCounts);
+     EXPECT_EQ(one.runLengths, three.runLengths);
+     EXPECT_EQ(one.serial.statistic, three.serial.statistic);
+     EXPECT_EQ(one.correlation.statistic, three.correlation.statistic);
+
+     // Pairs and runs stay inside segments: 101 segments, one pair fewer each.
+     std::uint64_t pairs {};
+     for (auto count : one.pairCounts) {
+         pairs += count;
+     }
+     EXPECT_EQ(pairs, 100003u - 101);
+ }
+
+ /**
+  * @test Verifies rejection of negative values and bad options.
+  */
+ TEST(RngAuditTest, BadInputIsRejected)
+ {
+     EXPECT_THROW(Audit([](std::uint64_t) { return std::function<int()>{[]() { return -1; }}; }, 100),
+                  std::runtime_error);
+     EXPECT_THROW(Audit([](std::uint64_t) { return std::function<int()>{}; }, 100), std::runtime_error);
+     EXPECT_THROW(Audit(XoshiroFactory(1), 1), std::invalid_argument);
+     EXPECT_THROW(Audit(XoshiroFactory(1), 100, 1, 1), std::invalid_argument);
+     EXPECT_THROW(RngAudit(MoveGeneratorFactory{}, {}), std::invalid_argument);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,106 @@
+/**
+ * @file test_RoundObserverFanOut.cpp
+ * @brief Unit tests for the RoundObserverFanOut class.
+ *
+ * ## Test Strategy
+ * Observers that log what they receive into one shared list are added to
+ * a fan-out, so the tests see both what each observer got and the order
+ * in which they got it. A real session then reports through the fan-out.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Every observer sees every call, in the order added
+ *   Given a fan-out with two logging observers and a nullptr
+ *   When a round and a session end are reported
+ *   Then the nullptr is ignored and both observers log both calls in order
+ *
+ * ### Scenario: A session reports to several observers
+ *   Given a 3-round session observed through a fan-out of two observers
+ *   When it is played
+ *   Then both observers see three rounds and one session end
+ */
+
+ #include <gtest/gtest.h>
+ #include <memory>
+ #include <string>
+ #include <vector>
+ #include "ComputerPlayer.hpp"
+ #include "QueuedMoveMessenger.hpp"
+ #include "RoundObserverFanOut.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "UserPlayer.hpp"
+
+ namespace {
+
+ /**
+  * @brief Appends "<tag> round <n>" and "<tag> end <id>" to a shared log.
+  */
+ class LoggingObserver : public IRoundObserver {
+ public:
+     LoggingObserver(std::string tag, std::vector<std::string>& log)
+         : m_tag{std::move(tag)}, m_log{log} {
+     }
+
+     void OnRound(const RoundRecord& record) override {
+         m_log.push_back(m_tag + " round " + std::to_string(record.round));
+     }
+
+     void OnSessionEnd(const SessionSummary& summary) override {
+         m_log.push_back(m_tag + " end " + std::to_string(summary.sessionId));
+     }
+
+ private:
+     std::string m_tag;
+     std::vector<std::string>& m_log;
+ };
+
+ } // namespace
+
+ /**
+  * @test Verify that every observer sees every call, in the order added.
+  */
+ TEST(RoundObserverFanOutTest, ForwardsToEveryObserverInOrder) {
+     std::vector<std::string> log;
+     LoggingObserver a {"a", log};
+     LoggingObserver b {"b", log};
+     RoundObserverFanOut fanOut;
+     fanOut.Add(&a);
+     fanOut.Add(nullptr);
+     fanOut.Add(&b);
+
+     RoundRecord record {};
+     record.round = 4;
+     fanOut.OnRound(record);
+     SessionSummary summary {};
+     summary.sessionId = 9;
+     fanOut.OnSessionEnd(summary);
+
+     EXPECT_EQ(fanOut.Size(), 2u);
+     EXPECT_EQ(log, (std::vector<std::string>{"a round 4", "b round 4", "a end 9", "b end 9"}));
+ }
+
+ /**
+  * @test Verify that a session reports to several observers through a fan-out.
+  */
+ TEST(RoundObserverFanOutTest, SessionReportsToSeveralObservers) {
+     std::vector<std::string> firstLog;
+     std::vector<std::string> secondLog;
+     LoggingObserver first {"x", firstLog};
+     LoggingObserver second {"x", secondLog};
+     RoundObserverFanOut fanOut;
+     fanOut.Add(&first);
+     fanOut.Add(&second);
+
+     auto messenger = std::make_unique<QueuedMoveMessenger>();
+     for (int i{}; i < 3; ++i) {
+         messenger->PushMove(1);
+     }
+     SinglePlayerRpsGame game {std::make_shared<UserPlayer>("alice"), std::make_shared<ComputerPlayer>("hal"),
+                               std::move(messenger), 3, []() { return 0; }};
+     game.SetRoundObserver(&fanOut, 5);
+     game.Play();
+
+     std::vector<std::string> expected {"x round 1", "x round 2", "x round 3", "x end 5"};
+     EXPECT_EQ(firstLog, expected);
+     EXPECT_EQ(secondLog, expected);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,158 @@
+/**
+ * @file test_RoundQuery.cpp
+ * @brief Unit tests for RoundQuery parsing and the RoundQueryEngine using Google Test.
+ *
+ * ## Test Strategy
+ * The engine is checked against exports of deterministic simulations,
+ * whose every round is known in advance. Small blocks (37 rows against
+ * 10-round matches) make sessions and lags straddle block boundaries.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Query text parses with the game's vocabulary
+ *   Given filters, lagged group fields and rate aggregates in text form
+ *   When RoundQuery::Parse is called
+ *   Then moves and outcomes resolve to GameMove and RoundOutcome values
+ *   And malformed clauses throw std::invalid_argument
+ *
+ * ### Scenario: Lagged fields see the previous rounds of the same session
+ *   Given copycat against cycle, exported across two files
+ *   When rounds are grouped by computer_move@1 with rate(outcome=computer_win)
+ *   Then every round after the first is a computer win
+ *   And the first round of each session has a missing lag
+ *
+ * ### Scenario: Thread count does not change results
+ *   Given the same query
+ *   When it runs on 1 and on 4 threads
+ *   Then the results are identical
+ *
+ * ### Scenario: Filters prune blocks by their statistics
+ *   Given a filter on session >= 45 of 50 sessions
+ *   When the query runs
+ *   Then most blocks are pruned and exactly 50 rows match
+ *   And a filter on an unknown name matches nothing
+ */
+
+ #include <gtest/gtest.h>
+ #include <cstdio>
+ #include <stdexcept>
+ #include <string>
+ #include "GameMove.hpp"
+ #include "IRoundObserver.hpp"
+ #include "RoundColumnWriter.hpp"
+ #include "RoundQueryEngine.hpp"
+ #include "SimulationRunner.hpp"
+
+ namespace {
+
+ /**
+  * @brief Exports copycat (user) against cycle (computer): 50 matches of 10 rounds in two files.
+  */
+ class RoundQueryEngineTest : public ::testing::Test {
+ protected:
+     void SetUp() override {
+         SimulationConfig config {};
+         config.totalMatches = 50;
+         config.roundsPerMatch = 10;
+         config.userStrategy = "copycat";
+         config.computerStrategy = "cycle";
+         SimulationRunner runner{config};
+
+         for (std::uint64_t shard{}; shard < 2; ++shard) {
+             m_paths.push_back(::testing::TempDir() + "rps_query_" + std::to_string(shard) + ".rcol");
+             RoundColumnWriter writer{m_paths.back(), 37};
+             runner.RunShard(shard, 2, &writer);
+             writer.Close();
+         }
+     }
+
+     void TearDown() override {
+         for (const auto& path : m_paths) {
+             std::remove(path.c_str());
+         }
+     }
+
+     std::vector<std::string> m_paths;
+ };
+
+ } // namespace
+
+ /**
+  * @test Verifies parsing of filters, groups and aggregates.
+  */
+ TEST(RoundQueryTest, ParsesGameVocabulary)
+ {
+     RoundQuery query { RoundQuery::Parse("computer_move@2=rock, round>=3, user_name!=bob",
+                                          "user_name,outcome@1", "count,rate(outcome=user_win),max(nanos)") };
+
+     ASSERT_EQ(query.filters.size(), 3u);
+     EXPECT_EQ(query.filters[0].field.column, RoundColumn::ComputerMove);
+     EXPECT_EQ(query.filters[0].field.lag, 2);
+     EXPECT_EQ(query.filters[0].value, static_cast<std::uint64_t>(GameMove::Rock));
+     EXPECT_EQ(query.filters[1].op, CompareOp::GreaterEqual);
+     EXPECT_EQ(query.filters[2].op, CompareOp::NotEqual);
+     EXPECT_EQ(query.filters[2].name, "bob");
+     ASSERT_EQ(query.groupBy.size(), 2u);
+     EXPECT_EQ(RoundQuery::FieldName(query.groupBy[1]), "outcome@1");
+     ASSERT_EQ(query.aggregates.size(), 3u);
+     EXPECT_EQ(query.aggregates[1].kind, AggregateKind::CountEqual);
+     EXPECT_EQ(query.aggregates[1].value, static_cast<std::uint64_t>(RoundOutcome::UserWin));
+
+     EXPECT_THROW(RoundQuery::Parse("bogus=1", "", ""), std::invalid_argument);
+     EXPECT_THROW(RoundQuery::Parse("user_move=lizard", "", ""), std::invalid_argument);
+     EXPECT_THROW(RoundQuery::Parse("user_name<bob", "", ""), std::invalid_argument);
+     EXPECT_THROW(RoundQuery::Parse("", "round@99", ""), std::invalid_argument);
+     EXPECT_THROW(RoundQuery::Parse("", "", "median(round)"), std::invalid_argument);
+ }
+
+ /**
+  * @test Verifies lagged fields across sessions, blocks and files.
+  */
+ TEST_F(RoundQueryEngineTest, LaggedFieldsFollowSessions)
+ {
+     RoundQuery query { RoundQuery::Parse("", "computer_move@1", "count,rate(outcome=computer_win)") };
+     QueryResult result { RoundQueryEngine::Run(query, m_paths, 1) };
+
+     // Cycle plays Rock, Paper, Scissors, ...; copycat replays it one round late and loses.
+     ASSERT_EQ(result.rows.size(), 4u);
+     EXPECT_EQ(result.rows[0].keys, std::vector<std::string>{"rock"});
+     EXPECT_EQ(result.rows[0].rows, 150u);
+     EXPECT_EQ(result.rows[0].values[1], 150u);
+     EXPECT_EQ(result.rows[3].keys, std::vector<std::string>{"-"});
+     EXPECT_EQ(result.rows[3].rows, 50u);
+     EXPECT_EQ(result.rows[3].values[1], 0u);
+     EXPECT_EQ(result.rowsMatched, 500u);
+ }
+
+ /**
+  * @test Verifies that results do not depend on the thread count.
+  */
+ TEST_F(RoundQueryEngineTest, ThreadCountDoesNotChangeResults)
+ {
+     RoundQuery query { RoundQuery::Parse("user_move@2!=scissors", "user_name,user_move",
+                                          "count,sum(round),min(round),max(computer_move@1)") };
+     QueryResult single { RoundQueryEngine::Run(query, m_paths, 1) };
+     QueryResult parallel { RoundQueryEngine::Run(query, m_paths, 4) };
+
+     ASSERT_EQ(single.rows.size(), parallel.rows.size());
+     for (std::size_t i{}; i < single.rows.size(); ++i) {
+         EXPECT_EQ(single.rows[i].keys, parallel.rows[i].keys);
+         EXPECT_EQ(single.rows[i].values, parallel.rows[i].values);
+     }
+     EXPECT_EQ(single.rowsMatched, parallel.rowsMatched);
+     EXPECT_EQ(single.rows.front().keys.front(), "copycat");
+ }
+
+ /**
+  * @test Verifies block pruning and unknown-name filters.
+  */
+ TEST_F(RoundQueryEngineTest, FiltersPruneBlocks)
+ {
+     QueryResult late { RoundQueryEngine::Run(RoundQuery::Parse("session>=45", "", ""), m_paths, 2) };
+     EXPECT_EQ(late.rowsMatched, 50u);
+     EXPECT_GT(late.blocksPruned, late.blocksScanned);
+
+     QueryResult nobody { RoundQueryEngine::Run(RoundQuery::Parse("user_name=nobody", "", ""), m_paths, 2) };
+     EXPECT_EQ(nobody.rowsMatched, 0u);
+     EXPECT_EQ(nobody.blocksScanned, 0u);
+ }
+ 
\ No newline at end of file
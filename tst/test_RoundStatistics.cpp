@@ -0,0 +1,254 @@
+/**
+ * @file test_RoundStatistics.cpp
+ * @brief Unit tests for the streaming aggregators and RoundStatistics.
+ *
+ * ## Test Strategy
+ * Each aggregator is checked against the answer recomputed from scratch:
+ * windows against the last rounds or the last span of time, the sketch
+ * against sorted samples. RoundStatistics is driven by a session and by
+ * hand-made records on a fake clock, and read while writers are running.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: A round window forgets the oldest rounds
+ *   Given a window of four rounds
+ *   When six rounds are pushed
+ *   Then counts, moves, win rate and streak cover only the last four
+ *
+ * ### Scenario: A time window expires old buckets
+ *   Given a ten-second window in ten buckets
+ *   When rounds are added over twenty seconds
+ *   Then totals only include rounds from the last ten seconds
+ *
+ * ### Scenario: Sketch quantiles are within one percent
+ *   Given a sketch of 100000 skewed values
+ *   When quantiles are queried
+ *   Then each is within 1% of the exact sample quantile
+ *
+ * ### Scenario: Sketches merge exactly
+ *   Given two sketches of disjoint halves of a sample
+ *   When one is merged into the other
+ *   Then it equals the sketch of the whole sample
+ *
+ * ### Scenario: Both sides of a round are tracked
+ *   Given a session observed by RoundStatistics
+ *   When it finishes
+ *   Then the user and computer see mirrored results and one session each
+ *
+ * ### Scenario: Snapshots are taken while games run
+ *   Given writer threads reporting rounds
+ *   When another thread takes snapshots at the same time
+ *   Then every snapshot is internally consistent
+ */
+
+ #include <gtest/gtest.h>
+ #include <algorithm>
+ #include <atomic>
+ #include <cmath>
+ #include <thread>
+ #include <vector>
+ #include "ComputerPlayer.hpp"
+ #include "QueuedMoveMessenger.hpp"
+ #include "RoundStatistics.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "UserPlayer.hpp"
+
+ namespace {
+
+ std::size_t Index(RoundResult result) {
+     return static_cast<std::size_t>(result);
+ }
+
+ RoundRecord MakeRecord(std::uint8_t userMove, std::uint8_t computerMove, RoundOutcome outcome) {
+     RoundRecord record {};
+     record.userMove = userMove;
+     record.computerMove = computerMove;
+     record.outcome = outcome;
+     record.userName = "ann";
+     record.computerName = "cycle";
+     return record;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies that the round window only reflects its last rounds.
+  */
+ TEST(RoundWindowTest, ForgetsOldestRounds)
+ {
+     RoundWindow window{4};
+     window.Push(RoundResult::Loss, 1);
+     window.Push(RoundResult::Loss, 1);
+     window.Push(RoundResult::Draw, 2);
+     window.Push(RoundResult::Forfeit, 0);
+     window.Push(RoundResult::Win, 3);
+     window.Push(RoundResult::Win, 3);
+
+     EXPECT_EQ(window.Size(), 4u);
+     EXPECT_EQ(window.Results()[Index(RoundResult::Win)], 2u);
+     EXPECT_EQ(window.Results()[Index(RoundResult::Loss)], 0u);
+     EXPECT_EQ(window.Results()[Index(RoundResult::Draw)], 1u);
+     EXPECT_EQ(window.Results()[Index(RoundResult::Forfeit)], 1u);
+     EXPECT_EQ(window.Moves(), (std::array<std::uint64_t, 3>{0, 1, 2}));
+     EXPECT_DOUBLE_EQ(window.WinRate(), 2.0 / 3.0);
+     EXPECT_EQ(window.Streak(), 2);
+
+     window.Push(RoundResult::Loss, 1);
+     EXPECT_EQ(window.Streak(), -1);
+     EXPECT_THROW(RoundWindow{0}, std::invalid_argument);
+ }
+
+ /**
+  * @test Verifies that time window buckets expire.
+  */
+ TEST(TimeWindowTest, ExpiresOldBuckets)
+ {
+     constexpr std::uint64_t kSecond {1'000'000'000ull};
+     TimeWindow window{10 * kSecond, 10};
+     for (std::uint64_t second{}; second < 20; ++second) {
+         window.Add(second * kSecond, second % 2 ? RoundResult::Win : RoundResult::Loss);
+     }
+
+     ResultCounts now { window.Totals(19 * kSecond) };
+     EXPECT_EQ(now[Index(RoundResult::Win)] + now[Index(RoundResult::Loss)], 10u);
+     EXPECT_EQ(now[Index(RoundResult::Win)], 5u);
+
+     ResultCounts later { window.Totals(25 * kSecond) };
+     EXPECT_EQ(later[Index(RoundResult::Win)] + later[Index(RoundResult::Loss)], 4u);
+     EXPECT_EQ(window.Totals(40 * kSecond), ResultCounts{});
+ }
+
+ /**
+  * @test Verifies sketch quantiles against exact sample quantiles.
+  */
+ TEST(QuantileSketchTest, QuantilesWithinOnePercent)
+ {
+     std::vector<std::uint64_t> values;
+     QuantileSketch sketch;
+     std::uint64_t state {12345};
+     for (int i{}; i < 100000; ++i) {
+         state = state * 6364136223846793005ull + 1442695040888963407ull;
+         // Roughly log-uniform from 1 to 2^30.
+         std::uint64_t value { (state >> 34) >> ((state >> 3) % 30) };
+         values.push_back(value);
+         sketch.Add(value);
+     }
+     std::sort(values.begin(), values.end());
+
+     EXPECT_EQ(sketch.Count(), values.size());
+     EXPECT_EQ(sketch.Min(), values.front());
+     EXPECT_EQ(sketch.Max(), values.back());
+     for (double q : {0.0, 0.1, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+         auto exact = static_cast<double>(values[static_cast<std::size_t>(std::llround(q * (values.size() - 1)))]);
+         auto estimate = static_cast<double>(sketch.Quantile(q));
+         EXPECT_LE(std::abs(estimate - exact), 0.01 * exact + 0.5) << "q=" << q;
+     }
+     EXPECT_EQ(QuantileSketch{}.Quantile(0.5), 0u);
+ }
+
+ /**
+  * @test Verifies that merging sketches equals sketching the union.
+  */
+ TEST(QuantileSketchTest, MergeEqualsWholeSample)
+ {
+     QuantileSketch whole, low, high;
+     for (std::uint64_t value{}; value < 5000; ++value) {
+         std::uint64_t sample { value * value * 37 };
+         whole.Add(sample);
+         (value % 2 ? low : high).Add(sample);
+     }
+     high.Merge(low);
+     EXPECT_EQ(high, whole);
+     EXPECT_EQ(high.Quantile(0.75), whole.Quantile(0.75));
+ }
+
+ /**
+  * @test Verifies that a session updates both sides with mirrored results.
+  */
+ TEST(RoundStatisticsTest, TracksBothSidesOfSession)
+ {
+     std::uint64_t now {};
+     RoundStatistics statistics{RoundStatisticsOptions{}, [&now]() { return now; }};
+
+     // Rock loses to Paper, Rock beats Scissors, Paper beats Rock.
+     auto messenger = std::make_unique<QueuedMoveMessenger>();
+     for (int choice : {1, 1, 2}) {
+         messenger->PushMove(choice);
+     }
+     int computerChoices[] {1, 2, 0};  // Paper, Scissors, Rock as `1 + x % 3`
+     int next {};
+     SinglePlayerRpsGame game{std::make_shared<UserPlayer>("Ann"), std::make_shared<ComputerPlayer>("Bot"),
+                              std::move(messenger), 3, [&]() { return computerChoices[next++]; }};
+     game.SetRoundObserver(&statistics, 9);
+     game.Play();
+
+     ASSERT_EQ(statistics.Names().size(), 2u);
+     auto user = statistics.Snapshot(statistics.Names()[0]);
+     auto computer = statistics.Snapshot(statistics.Names()[1]);
+     ASSERT_TRUE(user && computer);
+
+     EXPECT_EQ(user->totals[Index(RoundResult::Win)], 2u);
+     EXPECT_EQ(user->totals[Index(RoundResult::Loss)], 1u);
+     EXPECT_EQ(computer->totals[Index(RoundResult::Win)], 1u);
+     EXPECT_EQ(computer->totals[Index(RoundResult::Loss)], 2u);
+     EXPECT_EQ(user->streak, 2);
+     EXPECT_EQ(user->longestWinStreak, 2u);
+     EXPECT_EQ(computer->streak, -2);
+     EXPECT_EQ(user->recentMoves, (std::array<std::uint64_t, 3>{2, 1, 0}));
+     EXPECT_EQ(user->recentTime[Index(RoundResult::Win)], 2u);
+     EXPECT_EQ(user->latencyNanos.Count(), 3u);
+     EXPECT_EQ(computer->latencyNanos.Count(), 0u);
+     EXPECT_EQ(user->sessionRounds.Count(), 1u);
+     EXPECT_EQ(user->sessionRounds.Max(), 3u);
+     EXPECT_EQ(computer->sessionRounds.Count(), 1u);
+     EXPECT_FALSE(statistics.Snapshot("nobody").has_value());
+ }
+
+ /**
+  * @test Verifies snapshots taken concurrently with updates.
+  */
+ TEST(RoundStatisticsTest, SnapshotsWhileGamesRun)
+ {
+     RoundStatisticsOptions options {};
+     options.windowRounds = 64;
+     RoundStatistics statistics{options};
+
+     constexpr int kWriters {3};
+     constexpr int kRounds {20000};
+     std::atomic<bool> done {false};
+     std::vector<std::thread> writers;
+     for (int w{}; w < kWriters; ++w) {
+         writers.emplace_back([&statistics, w]() {
+             for (int round{}; round < kRounds; ++round) {
+                 RoundRecord record { MakeRecord(1 + round % 3, 1 + (round + w) % 3, RoundOutcome::UserWin) };
+                 record.decisionNanos = 1000 + static_cast<std::uint64_t>(round);
+                 statistics.OnRound(record);
+             }
+         });
+     }
+
+     std::thread reader([&]() {
+         while (!done.load()) {
+             if (auto user = statistics.Snapshot("ann")) {
+                 std::uint64_t windowed {};
+                 for (std::uint64_t count : user->recentRounds) {
+                     windowed += count;
+                 }
+                 EXPECT_EQ(windowed, std::min<std::uint64_t>(64, user->totals[Index(RoundResult::Win)]));
+                 EXPECT_EQ(user->recentRounds[Index(RoundResult::Win)], windowed);
+                 EXPECT_EQ(user->latencyNanos.Count(), user->totals[Index(RoundResult::Win)]);
+             }
+         }
+     });
+
+     for (auto& writer : writers) {
+         writer.join();
+     }
+     done = true;
+     reader.join();
+
+     auto computer = statistics.Snapshot("cycle");
+     ASSERT_TRUE(computer);
+     EXPECT_EQ(computer->totals[Index(RoundResult::Loss)], static_cast<std::uint64_t>(kWriters * kRounds));
+     EXPECT_DOUBLE_EQ(statistics.Snapshot("ann")->decayedWinRate, 1.0);
+ }
+ 
\ No newline at end of file
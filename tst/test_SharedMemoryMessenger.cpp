@@ -0,0 +1,103 @@
+/**
+ * @file test_SharedMemoryMessenger.cpp
+ * @brief Tests for SharedMemoryMessenger and SharedMemoryClient using Google Test.
+ *
+ * ## Test Strategy
+ * A real POSIX shared-memory segment is created and opened a second time,
+ * as a client process would. A full SinglePlayerRpsGame is played through
+ * the messenger while a client thread answers with a strategy.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: A whole game is played across the segment
+ *   Given a segment, a game using SharedMemoryMessenger, and a client
+ *     serving "paper" against a computer that always plays Rock
+ *   When the game is played for 50 rounds
+ *   Then the user wins all rounds and the client sees FinalScore 50:0
+ *
+ * ### Scenario: History reaches the client strategy
+ *   Given a client serving "counter" against a computer that always plays Rock
+ *   When 20 rounds are played
+ *   Then the client wins every round after the first
+ *
+ * ### Scenario: Opening a missing segment fails
+ *   Given a name that was never created
+ *   When SharedMemorySegment::Open is called
+ *   Then std::system_error is thrown
+ */
+
+ #include <gtest/gtest.h>
+ #include <atomic>
+ #include <system_error>
+ #include <thread>
+ #include <unistd.h>
+ #include "ComputerPlayer.hpp"
+ #include "MoveStrategies.hpp"
+ #include "SharedMemoryClient.hpp"
+ #include "SharedMemoryMessenger.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "UserPlayer.hpp"
+
+ namespace {
+
+ std::string UniqueName()
+ {
+     static std::atomic<int> counter {0};
+     return "/rps-test-" + std::to_string(::getpid()) + "-" + std::to_string(counter++);
+ }
+
+ /**
+  * @brief Plays `rounds` rounds with the client strategy against an all-Rock computer.
+  * @return The user's score.
+  */
+ int PlayAgainstRock(const char* strategyName, int rounds, int& clientResult)
+ {
+     auto segment = SharedMemorySegment::Create(UniqueName());
+     auto clientSegment = SharedMemorySegment::Open(segment->Name());
+
+     std::thread client([&clientSegment, &clientResult, strategyName]() {
+         auto strategy = MakeMoveStrategy(strategyName, 0);
+         SharedMemoryClient sharedClient{clientSegment};
+         clientResult = sharedClient.Serve(*strategy);
+     });
+
+     auto user = std::make_shared<UserPlayer>("Remote");
+     auto computer = std::make_shared<ComputerPlayer>("Rocky");
+     auto messenger = std::make_unique<SharedMemoryMessenger>(segment, "Remote", "Rocky", rounds);
+     messenger->SetParticipants(user, computer);
+
+     SinglePlayerRpsGame game{user, computer, std::move(messenger), rounds, []() { return 0; }};
+     game.Play();
+     client.join();
+     return user->GetScore();
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies that a whole game is played across the segment.
+  */
+ TEST(SharedMemoryMessengerTest, PlaysWholeGame)
+ {
+     int clientResult {-1};
+     EXPECT_EQ(PlayAgainstRock("paper", 50, clientResult), 50);
+     EXPECT_EQ(clientResult, 0);
+ }
+
+ /**
+  * @test Verifies that the client strategy observes completed rounds.
+  */
+ TEST(SharedMemoryMessengerTest, HistoryReachesClientStrategy)
+ {
+     int clientResult {-1};
+     EXPECT_EQ(PlayAgainstRock("counter", 20, clientResult), 19);
+     EXPECT_EQ(clientResult, 0);
+ }
+
+ /**
+  * @test Verifies that opening a missing segment throws.
+  */
+ TEST(SharedMemoryMessengerTest, OpeningMissingSegmentThrows)
+ {
+     EXPECT_THROW(SharedMemorySegment::Open("/rps-test-missing-segment"), std::system_error);
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,195 @@
+/**
+ * @file test_ShmRing.cpp
+ * @brief Unit tests for the ShmRing class using Google Test.
+ *
+ * ## Test Strategy
+ * The ring is exercised on ordinary memory: ordering, wrap-around,
+ * capacity limits, blocking hand-off between threads and shutdown.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Records come out in order across wrap-around
+ *   Given an empty ring
+ *   When more than its capacity is pushed and popped in small batches
+ *   Then every record comes out once, in order
+ *
+ * ### Scenario: A full ring rejects TryPush
+ *   Given a ring holding kCapacity records
+ *   When another record is offered with TryPush
+ *   Then it is rejected until one record is popped
+ *
+ * ### Scenario: Blocking producer and consumer hand off
+ *   Given a producer thread pushing 100000 records
+ *   When the consumer peeks and pops them
+ *   Then it receives them all, in order
+ *
+ * ### Scenario: Sleeping sides never miss a wakeup
+ *   Given a producer and a consumer that sleep without spinning
+ *   When 200000 records pass through in bursts that fill and drain the ring
+ *   Then every record arrives in order before a 30 second deadline
+ *
+ * ### Scenario: Close wakes a waiting consumer
+ *   Given a consumer blocked on an empty ring
+ *   When the producer closes the ring
+ *   Then Peek returns nullptr
+ */
+
+ #include <gtest/gtest.h>
+ #include <atomic>
+ #include <chrono>
+ #include <memory>
+ #include <thread>
+ #include "ShmRing.hpp"
+
+ namespace {
+
+ ShmRing::Record MakeRecord(std::int32_t value)
+ {
+     return ShmRing::Record{1, value, -value, 0};
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies ordering across wrap-around.
+  */
+ TEST(ShmRingTest, RecordsComeOutInOrder)
+ {
+     auto layout = std::make_unique<ShmRing::Layout>();
+     ShmRing ring{layout.get()};
+
+     std::int32_t next {};
+     std::int32_t expected {};
+     for (int batch{}; batch < 100; ++batch) {
+         for (int i{}; i < 7; ++i) {
+             ASSERT_TRUE(ring.TryPush(MakeRecord(next++)));
+         }
+         while (const ShmRing::Record* record = ring.TryPeek()) {
+             EXPECT_EQ(record->a, expected);
+             EXPECT_EQ(record->b, -expected);
+             ++expected;
+             ring.Pop();
+         }
+     }
+     EXPECT_EQ(expected, 700);
+ }
+
+ /**
+  * @test Verifies that a full ring rejects TryPush.
+  */
+ TEST(ShmRingTest, FullRingRejectsTryPush)
+ {
+     auto layout = std::make_unique<ShmRing::Layout>();
+     ShmRing ring{layout.get()};
+     for (std::uint32_t i{}; i < ShmRing::kCapacity; ++i) {
+         ASSERT_TRUE(ring.TryPush(MakeRecord(static_cast<std::int32_t>(i))));
+     }
+     EXPECT_FALSE(ring.TryPush(MakeRecord(-1)));
+
+     ring.Pop();
+     EXPECT_TRUE(ring.TryPush(MakeRecord(-1)));
+ }
+
+ /**
+  * @test Verifies the blocking hand-off between two threads.
+  */
+ TEST(ShmRingTest, BlockingHandOffBetweenThreads)
+ {
+     constexpr std::int32_t kRecords {100000};
+     auto layout = std::make_unique<ShmRing::Layout>();
+     ShmRing producer{layout.get()};
+     ShmRing consumer{layout.get()};
+
+     std::thread thread([&producer]() {
+         for (std::int32_t i{}; i < kRecords; ++i) {
+             producer.Push(MakeRecord(i));
+         }
+     });
+
+     std::int32_t expected {};
+     while (expected < kRecords) {
+         const ShmRing::Record* record { consumer.Peek() };
+         ASSERT_NE(record, nullptr);
+         ASSERT_EQ(record->a, expected);
+         consumer.Pop();
+         ++expected;
+     }
+     thread.join();
+ }
+
+ /**
+  * @test Verifies that no wakeup is lost when both sides sleep at once.
+  *
+  * With no spinning every empty or full ring puts a side to sleep, so the
+  * wake handshake runs hundreds of thousands of times. A lost wakeup leaves
+  * both sides asleep; the deadline then closes the ring to free them.
+  */
+ TEST(ShmRingTest, SleepingSidesNeverMissAWakeup)
+ {
+     constexpr std::int32_t kRecords {200000};
+     auto layout = std::make_unique<ShmRing::Layout>();
+     ShmRing producer{layout.get(), 0};
+     ShmRing consumer{layout.get(), 0};
+     std::atomic<bool> done {false};
+
+     std::thread producerThread([&producer]() {
+         for (std::int32_t i{}; i < kRecords; ++i) {
+             if (!producer.Push(MakeRecord(i))) {
+                 return;
+             }
+             if (i % 1000 == 999) {
+                 // Let the consumer drain the ring and fall asleep on it.
+                 std::this_thread::yield();
+             }
+         }
+     });
+     std::int32_t received {};
+     bool inOrder {true};
+     std::thread consumerThread([&]() {
+         while (received < kRecords) {
+             const ShmRing::Record* record { consumer.Peek() };
+             if (record == nullptr) {
+                 break;
+             }
+             inOrder = inOrder && record->a == received;
+             consumer.Pop();
+             ++received;
+         }
+         done.store(true);
+     });
+
+     auto deadline { std::chrono::steady_clock::now() + std::chrono::seconds{30} };
+     while (!done.load() && std::chrono::steady_clock::now() < deadline) {
+         std::this_thread::sleep_for(std::chrono::milliseconds{10});
+     }
+     bool finished { done.load() };
+     if (!finished) {
+         producer.Close();
+     }
+     producerThread.join();
+     consumerThread.join();
+
+     EXPECT_TRUE(finished) << "stalled after " << received << " records";
+     EXPECT_EQ(received, kRecords);
+     EXPECT_TRUE(inOrder);
+     EXPECT_GT(consumer.SyscallCount() + producer.SyscallCount(), 0u);
+ }
+
+ /**
+  * @test Verifies that Close wakes a consumer waiting on an empty ring.
+  */
+ TEST(ShmRingTest, CloseWakesWaitingConsumer)
+ {
+     auto layout = std::make_unique<ShmRing::Layout>();
+     ShmRing producer{layout.get()};
+     ShmRing consumer{layout.get()};
+
+     std::thread thread([&producer]() {
+         std::this_thread::sleep_for(std::chrono::milliseconds{20});
+         producer.Close();
+     });
+     EXPECT_EQ(consumer.Peek(), nullptr);
+     EXPECT_TRUE(consumer.IsClosed());
+     EXPECT_FALSE(producer.TryPush(MakeRecord(0)));
+     thread.join();
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,161 @@
+/**
+ * @file test_SimulationResult.cpp
+ * @brief Unit tests for the SimulationResult class using Google Test.
+ *
+ * ## Test Strategy
+ * Matches are recorded from hand-built move-count matrices, so every
+ * counter can be checked exactly. Merging must add counters, coalesce
+ * coverage and reject foreign or overlapping shards; files must round
+ * trip bit for bit and corrupt files must be rejected.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: A recorded match updates every counter
+ *   Given an empty result for a one-match campaign
+ *   When a match with 2 user wins, 1 computer win and 1 draw is added
+ *   Then round, match, move, margin and rating counters reflect it
+ *
+ * ### Scenario: Merging adds counters and coalesces coverage
+ *   Given results for matches [0, 1) and [1, 2)
+ *   When they are merged
+ *   Then the merged result covers [0, 2), is complete and sums the counters
+ *
+ * ### Scenario: Incompatible results are rejected
+ *   Given results of a different campaign or with overlapping coverage
+ *   When they are merged
+ *   Then std::invalid_argument is thrown
+ *
+ * ### Scenario: Result files round trip and merge in parallel
+ *   Given three shard results saved to files
+ *   When they are loaded, and merged with one and with four threads
+ *   Then every loaded or merged result equals the in-memory merge
+ *   And a truncated file is rejected with std::runtime_error
+ */
+
+ #include <gtest/gtest.h>
+ #include <cstdio>
+ #include <fstream>
+ #include <stdexcept>
+ #include <string>
+ #include "SimulationResult.hpp"
+
+ namespace {
+
+ using MoveCounts = std::array<std::array<std::uint64_t, 3>, 3>;
+
+ SimulationConfig MakeConfig(std::uint64_t matches)
+ {
+     SimulationConfig config {};
+     config.masterSeed = 9;
+     config.totalMatches = matches;
+     config.roundsPerMatch = 4;
+     config.userStrategy = "random";
+     config.computerStrategy = "cycle";
+     return config;
+ }
+
+ /**
+  * @brief A 4-round match: user Paper vs Rock twice, Rock vs Paper, Scissors vs Scissors.
+  */
+ MoveCounts UserWinningMatch()
+ {
+     MoveCounts counts {};
+     counts[1][0] = 2;
+     counts[0][1] = 1;
+     counts[2][2] = 1;
+     return counts;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies that AddMatch() updates every counter.
+  */
+ TEST(SimulationResultTest, AddMatchUpdatesCounters)
+ {
+     SimulationResult result{MakeConfig(1), 0, 1};
+     result.AddMatch(UserWinningMatch());
+
+     EXPECT_EQ(result.Matches(), 1u);
+     EXPECT_EQ(result.Rounds(), 4u);
+     EXPECT_EQ(result.UserRoundWins(), 2u);
+     EXPECT_EQ(result.ComputerRoundWins(), 1u);
+     EXPECT_EQ(result.DrawnRounds(), 1u);
+     EXPECT_EQ(result.UserMatchWins(), 1u);
+     EXPECT_EQ(result.MoveCounts()[1][0], 2u);
+     // Equal ratings: a win is worth K/2 = 16 points.
+     EXPECT_EQ(result.UserRatingDeltaMilli(), 16000);
+     // Margin +1 of 4 rounds lands at (1 + 4) * 40 / 8 = bucket 25.
+     EXPECT_EQ(result.MarginHistogram()[25], 1u);
+     EXPECT_TRUE(result.IsComplete());
+ }
+
+ /**
+  * @test Verifies that Merge() sums counters and coalesces coverage.
+  */
+ TEST(SimulationResultTest, MergeAddsCountersAndCoalescesCoverage)
+ {
+     SimulationResult first{MakeConfig(2), 0, 1};
+     SimulationResult second{MakeConfig(2), 1, 2};
+     first.AddMatch(UserWinningMatch());
+     MoveCounts draw {};
+     draw[0][0] = 4;
+     second.AddMatch(draw);
+
+     EXPECT_FALSE(first.IsComplete());
+     second.Merge(first);
+
+     ASSERT_EQ(second.Coverage().size(), 1u);
+     EXPECT_EQ(second.Coverage().front().first, 0u);
+     EXPECT_EQ(second.Coverage().front().second, 2u);
+     EXPECT_TRUE(second.IsComplete());
+     EXPECT_EQ(second.Matches(), 2u);
+     EXPECT_EQ(second.DrawnRounds(), 5u);
+     EXPECT_EQ(second.DrawnMatches(), 1u);
+     EXPECT_EQ(second.UserRatingDeltaMilli(), 16000);
+ }
+
+ /**
+  * @test Verifies that foreign and overlapping results are rejected.
+  */
+ TEST(SimulationResultTest, IncompatibleResultsAreRejected)
+ {
+     SimulationResult result{MakeConfig(4), 0, 2};
+
+     SimulationConfig otherConfig { MakeConfig(4) };
+     otherConfig.masterSeed = 10;
+     EXPECT_THROW(result.Merge(SimulationResult(otherConfig, 2, 4)), std::invalid_argument);
+     EXPECT_THROW(result.Merge(SimulationResult(MakeConfig(4), 1, 3)), std::invalid_argument);
+     EXPECT_THROW(SimulationResult(MakeConfig(4), 3, 5), std::invalid_argument);
+ }
+
+ /**
+  * @test Verifies that files round trip and MergeFiles() matches an in-memory merge.
+  */
+ TEST(SimulationResultTest, FilesRoundTripAndMergeInParallel)
+ {
+     std::vector<std::string> paths;
+     SimulationResult expected{MakeConfig(3), 0, 0};
+     for (std::uint64_t match{}; match < 3; ++match) {
+         SimulationResult shard{MakeConfig(3), match, match + 1};
+         MoveCounts counts { UserWinningMatch() };
+         counts[2][0] = match;
+         shard.AddMatch(counts);
+         expected.Merge(shard);
+
+         paths.push_back(::testing::TempDir() + "rps_sim_shard_" + std::to_string(match) + ".rsim");
+         shard.Save(paths.back());
+         EXPECT_EQ(SimulationResult::Load(paths.back()), shard);
+     }
+
+     EXPECT_EQ(SimulationResult::MergeFiles(paths, 1), expected);
+     EXPECT_EQ(SimulationResult::MergeFiles({paths[2], paths[0], paths[1]}, 4), expected);
+
+     std::vector<std::uint8_t> bytes { expected.Serialize() };
+     bytes.pop_back();
+     EXPECT_THROW(SimulationResult::Deserialize(bytes), std::runtime_error);
+
+     for (const auto& path : paths) {
+         std::remove(path.c_str());
+     }
+ }
+ 
\ No newline at end of file
@@ -0,0 +1,140 @@
+/**
+ * @file test_SimulationRunner.cpp
+ * @brief Unit tests for the SimulationRunner class using Google Test.
+ *
+ * ## Test Strategy
+ * Deterministic strategies give exactly predictable totals. The central
+ * property is that the merged result does not depend on how a campaign
+ * is sharded, which is checked by comparing serialized results.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Shard ranges partition the campaign
+ *   Given 10 matches split into 3 shards
+ *   When the shard ranges are computed
+ *   Then they are [0, 4), [4, 7) and [7, 10)
+ *
+ * ### Scenario: Deterministic strategies give exact totals
+ *   Given "paper" against "rock" for 5 matches of 7 rounds
+ *   When the campaign runs as one shard
+ *   Then the user wins all 35 rounds and all 5 matches
+ *
+ * ### Scenario: Results do not depend on sharding
+ *   Given "random" against "copycat" for 50 matches
+ *   When the campaign runs as 1 shard, and as 3 and 7 merged shards
+ *   Then all three results are identical
+ *
+ * ### Scenario: An observer sees every simulated round
+ *   Given "paper" against "rock" for 3 matches of 4 rounds and an observer
+ *   When the campaign runs
+ *   Then the observer receives 12 user wins tagged with match and round
+ *
+ * ### Scenario: Unknown strategies are rejected
+ *   Given a config naming an unknown strategy
+ *   When a SimulationRunner is constructed
+ *   Then std::invalid_argument is thrown
+ */
+
+ #include <gtest/gtest.h>
+ #include <stdexcept>
+ #include <vector>
+ #include "SimulationRunner.hpp"
+
+ namespace {
+
+ SimulationConfig MakeConfig(const std::string& user, const std::string& computer,
+                             std::uint64_t matches, std::uint32_t rounds)
+ {
+     SimulationConfig config {};
+     config.masterSeed = 2024;
+     config.totalMatches = matches;
+     config.roundsPerMatch = rounds;
+     config.userStrategy = user;
+     config.computerStrategy = computer;
+     return config;
+ }
+
+ SimulationResult RunSharded(const SimulationRunner& runner, std::uint64_t shards)
+ {
+     SimulationResult merged { runner.RunShard(0, shards) };
+     for (std::uint64_t index { shards }; index-- > 1;) {
+         merged.Merge(runner.RunShard(index, shards));
+     }
+     return merged;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies that shard ranges are contiguous and balanced.
+  */
+ TEST(SimulationRunnerTest, ShardRangesPartitionCampaign)
+ {
+     using Range = std::pair<std::uint64_t, std::uint64_t>;
+     EXPECT_EQ(SimulationRunner::ShardRange(10, 0, 3), Range(0, 4));
+     EXPECT_EQ(SimulationRunner::ShardRange(10, 1, 3), Range(4, 7));
+     EXPECT_EQ(SimulationRunner::ShardRange(10, 2, 3), Range(7, 10));
+     EXPECT_THROW(SimulationRunner::ShardRange(10, 3, 3), std::invalid_argument);
+ }
+
+ /**
+  * @test Verifies exact totals for deterministic strategies.
+  */
+ TEST(SimulationRunnerTest, DeterministicStrategiesGiveExactTotals)
+ {
+     SimulationRunner runner{MakeConfig("paper", "rock", 5, 7)};
+     SimulationResult result { runner.RunShard(0, 1) };
+
+     EXPECT_EQ(result.Rounds(), 35u);
+     EXPECT_EQ(result.UserRoundWins(), 35u);
+     EXPECT_EQ(result.UserMatchWins(), 5u);
+     EXPECT_EQ(result.MoveCounts()[1][0], 35u);
+     EXPECT_EQ(result.MarginHistogram().back(), 5u);
+     EXPECT_TRUE(result.IsComplete());
+ }
+
+ /**
+  * @test Verifies that any sharding yields an identical merged result.
+  */
+ TEST(SimulationRunnerTest, ResultsDoNotDependOnSharding)
+ {
+     SimulationRunner runner{MakeConfig("random", "copycat", 50, 30)};
+
+     SimulationResult single { runner.RunShard(0, 1) };
+     EXPECT_GT(single.UserRoundWins(), 0u);
+     EXPECT_GT(single.ComputerRoundWins(), 0u);
+
+     EXPECT_EQ(RunSharded(runner, 3), single);
+     EXPECT_EQ(RunSharded(runner, 7), single);
+ }
+
+ /**
+  * @test Verifies that an observer receives every round of the campaign.
+  */
+ TEST(SimulationRunnerTest, ObserverSeesEveryRound)
+ {
+     class Recorder : public IRoundObserver {
+     public:
+         void OnRound(const RoundRecord& record) override { records.push_back(record); }
+         std::vector<RoundRecord> records;
+     };
+
+     Recorder recorder;
+     SimulationRunner runner{MakeConfig("paper", "rock", 3, 4)};
+     runner.RunShard(0, 1, &recorder);
+
+     ASSERT_EQ(recorder.records.size(), 12u);
+     EXPECT_EQ(recorder.records.back().sessionId, 2u);
+     EXPECT_EQ(recorder.records.back().round, 4u);
+     for (const RoundRecord& record : recorder.records) {
+         EXPECT_EQ(record.outcome, RoundOutcome::UserWin);
+     }
+ }
+
+ /**
+  * @test Verifies that unknown strategy names are rejected.
+  */
+ TEST(SimulationRunnerTest, UnknownStrategyIsRejected)
+ {
+     EXPECT_THROW(SimulationRunner(MakeConfig("nonsense", "rock", 1, 1)), std::invalid_argument);
+ }
+ 
\ No newline at end of file
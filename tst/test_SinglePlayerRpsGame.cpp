@@ -4,7 +4,10 @@
 #include "IPlayer.hpp"
 #include "IGameMessenger.hpp"
 #include "GameMove.hpp"
+#include "IRoundObserver.hpp"
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 using ::testing::Return;
 using ::testing::_;
@@ -17,6 +20,7 @@ public:
     MOCK_METHOD(void, AddWin, (), (override));
     MOCK_METHOD(int, GetScore, (), (const, override));
     MOCK_METHOD(std::string, GetName, (), (const, override));
+    MOCK_METHOD(std::string_view, GetNameView, (), (const, override));
 };
 
 /**
@@ -38,14 +42,40 @@ public:
 };
 
 /**
- * @brief Helper to check if a player's name matches the expected value.
+ * @brief Helper to check that the argument is the expected player.
+ *
+ * Compares identities rather than calling the mocked GetName(): invoking a
+ * mock from inside a matcher deadlocks on Google Mock's internal mutex.
  */
-static auto HasPlayerName(const std::string& expectedName) {
-    return testing::Truly([expectedName](const std::shared_ptr<IPlayer>& p) {
-        return p && p->GetName() == expectedName;
+static auto IsPlayer(const std::shared_ptr<IPlayer>& expected) {
+    return testing::Truly([expected](const std::shared_ptr<IPlayer>& p) {
+        return p == expected;
     });
 }
 
+/**
+ * @brief A messenger that serves scripted moves through the batched API.
+ */
+class BatchMessenger : public ::testing::NiceMock<MockMessenger> {
+public:
+    explicit BatchMessenger(std::vector<int> moves) : m_moves{std::move(moves)} {}
+
+    std::size_t RequestMoveChoices(int* moves, std::size_t maxCount) override {
+        m_requestSizes.push_back(maxCount);
+        std::size_t count {};
+        while (count < maxCount && m_next < m_moves.size()) {
+            moves[count++] = m_moves[m_next++];
+        }
+        return count;
+    }
+
+    std::vector<std::size_t> m_requestSizes;
+
+private:
+    std::vector<int> m_moves;
+    std::size_t m_next {};
+};
+
 /**
  * @brief Test fixture for SinglePlayerRpsGame.
  */
@@ -118,17 +148,17 @@ TEST_F(SinglePlayerRpsGameTest, UserWinIsProcessedCorrectly) {
     EXPECT_CALL(*m_rawMessengerPtr, RequestMoveChoice())
         .WillOnce(Return(1));
 
-    // computer picks Scissors (3)
-    m_mockRandomValue = 3;
+    // computer picks Scissors (3): 1 + (2 % 3)
+    m_mockRandomValue = 2;
 
     // Cast back to MockPlayer to set the expectations:
     auto userMock = std::static_pointer_cast<MockPlayer>(m_user);
     auto computerMock = std::static_pointer_cast<MockPlayer>(m_computer);
 
-    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(HasPlayerName("[User] Alice"), GameMove::Rock));
-    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(HasPlayerName("[Computer] Hal"), GameMove::Scissors));
+    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(IsPlayer(m_user), GameMove::Rock));
+    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(IsPlayer(m_computer), GameMove::Scissors));
     EXPECT_CALL(*userMock, AddWin()).Times(1);
-    EXPECT_CALL(*m_rawMessengerPtr, AnnounceRoundWinner(HasPlayerName("[User] Alice")));
+    EXPECT_CALL(*m_rawMessengerPtr, AnnounceRoundWinner(IsPlayer(m_user)));
     EXPECT_CALL(*m_rawMessengerPtr, ShowFinalScore(m_user, m_computer)).Times(1);
 
     m_game->Play();
@@ -142,16 +172,16 @@ TEST_F(SinglePlayerRpsGameTest, ComputerWinIsProcessedCorrectly) {
     EXPECT_CALL(*m_rawMessengerPtr, RequestMoveChoice())
         .WillOnce(Return(3));
 
-    // computer picks Rock (1)
-    m_mockRandomValue = 1;
+    // computer picks Rock (1): 1 + (0 % 3)
+    m_mockRandomValue = 0;
 
     auto userMock = std::static_pointer_cast<MockPlayer>(m_user);
     auto computerMock = std::static_pointer_cast<MockPlayer>(m_computer);
 
-    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(HasPlayerName("[User] Alice"), GameMove::Scissors));
-    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(HasPlayerName("[Computer] Hal"), GameMove::Rock));
+    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(IsPlayer(m_user), GameMove::Scissors));
+    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(IsPlayer(m_computer), GameMove::Rock));
     EXPECT_CALL(*computerMock, AddWin()).Times(1);
-    EXPECT_CALL(*m_rawMessengerPtr, AnnounceRoundWinner(HasPlayerName("[Computer] Hal")));
+    EXPECT_CALL(*m_rawMessengerPtr, AnnounceRoundWinner(IsPlayer(m_computer)));
     EXPECT_CALL(*m_rawMessengerPtr, ShowFinalScore(m_user, m_computer)).Times(1);
 
     m_game->Play();
@@ -165,13 +195,240 @@ TEST_F(SinglePlayerRpsGameTest, DrawIsHandledCorrectly) {
     EXPECT_CALL(*m_rawMessengerPtr, RequestMoveChoice())
         .WillOnce(Return(2));
 
-    // computer picks Paper (2)
-    m_mockRandomValue = 2;
+    // computer picks Paper (2): 1 + (1 % 3)
+    m_mockRandomValue = 1;
 
-    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(HasPlayerName("[User] Alice"), GameMove::Paper));
-    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(HasPlayerName("[Computer] Hal"), GameMove::Paper));
+    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(IsPlayer(m_user), GameMove::Paper));
+    EXPECT_CALL(*m_rawMessengerPtr, DisplayChosenMove(IsPlayer(m_computer), GameMove::Paper));
     EXPECT_CALL(*m_rawMessengerPtr, AnnounceDraw());
     EXPECT_CALL(*m_rawMessengerPtr, ShowFinalScore(m_user, m_computer)).Times(1);
 
     m_game->Play();
 }
+
+/**
+ * @test Verify that a batching messenger is asked once for the whole match.
+ */
+TEST(SinglePlayerRpsGameBatchTest, BatchedMessengerIsAskedOncePerBatch) {
+    auto user = std::make_shared<::testing::NiceMock<MockPlayer>>();
+    auto computer = std::make_shared<::testing::NiceMock<MockPlayer>>();
+    auto messenger = std::make_unique<BatchMessenger>(std::vector<int>{1, 2, 3, 9});
+    BatchMessenger* rawMessenger = messenger.get();
+
+    // Computer always plays Rock: draw, user win, computer win, invalid move.
+    EXPECT_CALL(*rawMessenger, RequestMoveChoice()).Times(0);
+    EXPECT_CALL(*rawMessenger, AnnounceDraw()).Times(1);
+    EXPECT_CALL(*rawMessenger, ShowInvalidInputMessage()).Times(1);
+    EXPECT_CALL(*user, AddWin()).Times(1);
+    EXPECT_CALL(*computer, AddWin()).Times(1);
+
+    SinglePlayerRpsGame game{user, computer, std::move(messenger), 4, []() { return 0; }};
+    game.Play();
+
+    EXPECT_EQ(rawMessenger->m_requestSizes, (std::vector<std::size_t>{4}));
+}
+
+/**
+ * @test Verify that a short batch is topped up with the rounds still missing.
+ */
+TEST(SinglePlayerRpsGameBatchTest, ShortBatchIsToppedUp) {
+    auto user = std::make_shared<::testing::NiceMock<MockPlayer>>();
+    auto computer = std::make_shared<::testing::NiceMock<MockPlayer>>();
+
+    /**
+     * A messenger that delivers at most two moves per call.
+     */
+    class TwoAtATimeMessenger : public BatchMessenger {
+    public:
+        TwoAtATimeMessenger() : BatchMessenger{{1, 1, 1, 1, 1}} {}
+        std::size_t RequestMoveChoices(int* moves, std::size_t maxCount) override {
+            m_asked.push_back(maxCount);
+            return BatchMessenger::RequestMoveChoices(moves, std::min<std::size_t>(maxCount, 2));
+        }
+
+        std::vector<std::size_t> m_asked;
+    };
+
+    auto messenger = std::make_unique<TwoAtATimeMessenger>();
+    TwoAtATimeMessenger* rawMessenger = messenger.get();
+    EXPECT_CALL(*rawMessenger, AnnounceDraw()).Times(5);
+
+    SinglePlayerRpsGame game{user, computer, std::move(messenger), 5, []() { return 0; }};
+    game.Play();
+
+    // Each request asks for exactly the rounds that remain.
+    EXPECT_EQ(rawMessenger->m_asked, (std::vector<std::size_t>{5, 3, 1}));
+    EXPECT_EQ(rawMessenger->m_requestSizes, (std::vector<std::size_t>{2, 2, 1}));
+}
+
+/**
+ * @test Verify that a host can step the session one round at a time.
+ */
+TEST(SinglePlayerRpsGameBatchTest, RoundsCanBeSteppedByHost) {
+    auto user = std::make_shared<::testing::NiceMock<MockPlayer>>();
+    auto computer = std::make_shared<::testing::NiceMock<MockPlayer>>();
+    auto messenger = std::make_unique<BatchMessenger>(std::vector<int>{2, 2});
+    BatchMessenger* rawMessenger = messenger.get();
+
+    EXPECT_CALL(*user, AddWin()).Times(2);
+    EXPECT_CALL(*rawMessenger, ShowFinalScore(_, _)).Times(1);
+
+    SinglePlayerRpsGame game{user, computer, std::move(messenger), 2, []() { return 0; }};
+    EXPECT_FALSE(game.IsFinished());
+    game.PlayRound();
+    EXPECT_EQ(game.RoundsPlayed(), 1);
+    EXPECT_FALSE(game.IsFinished());
+    game.PlayRound();
+    EXPECT_TRUE(game.IsFinished());
+    game.Finish();
+}
+
+/**
+ * @brief Collects reported rounds.
+ */
+class RecordingObserver : public IRoundObserver {
+public:
+    void OnRound(const RoundRecord& record) override {
+        m_records.push_back(record);
+        m_userNames.emplace_back(record.userName);
+    }
+
+    std::vector<RoundRecord> m_records;
+    std::vector<std::string> m_userNames;
+};
+
+/**
+ * @test Verify that an observer receives one record per round.
+ */
+TEST(SinglePlayerRpsGameBatchTest, ObserverReceivesEveryRound) {
+    auto user = std::make_shared<::testing::NiceMock<MockPlayer>>();
+    auto computer = std::make_shared<::testing::NiceMock<MockPlayer>>();
+    ON_CALL(*user, GetNameView()).WillByDefault(Return(std::string_view{"alice"}));
+    auto messenger = std::make_unique<BatchMessenger>(std::vector<int>{1, 2, 3, 9});
+
+    // Computer always plays Rock: draw, user win, computer win, invalid move.
+    SinglePlayerRpsGame game{user, computer, std::move(messenger), 4, []() { return 0; }};
+    RecordingObserver observer;
+    game.SetRoundObserver(&observer, 77);
+    game.Play();
+
+    ASSERT_EQ(observer.m_records.size(), 4u);
+    EXPECT_EQ(observer.m_records[0].outcome, RoundOutcome::Draw);
+    EXPECT_EQ(observer.m_records[1].outcome, RoundOutcome::UserWin);
+    EXPECT_EQ(observer.m_records[2].outcome, RoundOutcome::ComputerWin);
+    EXPECT_EQ(observer.m_records[3].outcome, RoundOutcome::Forfeit);
+    EXPECT_EQ(observer.m_records[3].userMove, 0);
+    EXPECT_EQ(observer.m_records[2].computerMove, static_cast<std::uint8_t>(GameMove::Rock));
+    EXPECT_EQ(observer.m_records[3].round, 4u);
+    EXPECT_EQ(observer.m_records[0].sessionId, 77u);
+    EXPECT_EQ(observer.m_userNames[1], "alice");
+}
+
+/**
+ * @brief Plays a whole match against a computer that always picks Rock.
+ * @return The number of rounds played.
+ */
+static int PlayAgainstRock(std::vector<int> moves, int rounds, MatchRules rules,
+                           std::vector<std::size_t>* requestSizes = nullptr) {
+    auto user = std::make_shared<::testing::NiceMock<MockPlayer>>();
+    auto computer = std::make_shared<::testing::NiceMock<MockPlayer>>();
+    auto messenger = std::make_unique<BatchMessenger>(std::move(moves));
+    BatchMessenger* rawMessenger = messenger.get();
+
+    SinglePlayerRpsGame game{user, computer, std::move(messenger), rounds, []() { return 0; }, rules};
+    game.Play();
+    if (requestSizes) {
+        *requestSizes = rawMessenger->m_requestSizes;
+    }
+    return game.RoundsPlayed();
+}
+
+/**
+ * @test Verify that a best-of match stops once the result cannot change,
+ *       without asking for moves it will not play.
+ */
+TEST(SinglePlayerRpsGameRulesTest, BestOfStopsOnceDecided) {
+    std::vector<std::size_t> requests;
+    MatchRules bestOf {MatchTermination::BestOf, 0};
+
+    // Paper beats Rock three times: 3-0 with two rounds left.
+    EXPECT_EQ(PlayAgainstRock({2, 2, 2, 2, 2}, 5, bestOf, &requests), 3);
+    EXPECT_EQ(requests, (std::vector<std::size_t>{3}));
+
+    // Draw, win, loss, win: 2-1 with one round left is still open.
+    EXPECT_EQ(PlayAgainstRock({1, 2, 3, 2, 1}, 5, bestOf), 5);
+
+    // Without rules every round is played.
+    EXPECT_EQ(PlayAgainstRock({2, 2, 2, 2, 2}, 5, MatchRules{}), 5);
+}
+
+/**
+ * @test Verify that best-of always crowns the winner of the full-length match.
+ */
+TEST(SinglePlayerRpsGameRulesTest, BestOfAgreesWithFullMatch) {
+    std::uint64_t state {5};
+    for (int match{}; match < 2000; ++match) {
+        int rounds { 1 + match % 15 };
+        std::vector<int> outcomes;
+        for (int r{}; r < rounds; ++r) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            outcomes.push_back(static_cast<int>((state >> 33) % 3));
+        }
+        int fullLead {};
+        for (int outcome : outcomes) {
+            fullLead += outcome == 1 ? 1 : outcome == 2 ? -1 : 0;
+        }
+
+        int userWins {};
+        int computerWins {};
+        int played {};
+        MatchRules bestOf {MatchTermination::BestOf, 0};
+        while (played < rounds && !IsMatchDecided(bestOf, userWins, computerWins, rounds - played)) {
+            ASSERT_GE(RoundsBeforeDecision(bestOf, userWins, computerWins, rounds - played), 1);
+            userWins += outcomes[played] == 1;
+            computerWins += outcomes[played] == 2;
+            ++played;
+        }
+        EXPECT_EQ((userWins > computerWins) - (userWins < computerWins), (fullLead > 0) - (fullLead < 0));
+    }
+}
+
+/**
+ * @test Verify first-to counts wins and lets draws run on up to the limit.
+ */
+TEST(SinglePlayerRpsGameRulesTest, FirstToEndsOnTargetWins) {
+    MatchRules firstToTwo {MatchTermination::FirstTo, 2};
+
+    // Draw, draw, win, loss, win.
+    EXPECT_EQ(PlayAgainstRock({1, 1, 2, 3, 2, 2, 2}, 9, firstToTwo), 5);
+
+    // Draws only: the round limit still ends the match.
+    EXPECT_EQ(PlayAgainstRock({1, 1, 1, 1}, 4, firstToTwo), 4);
+}
+
+/**
+ * @test Verify win-by-two needs both the target and a two-win lead.
+ */
+TEST(SinglePlayerRpsGameRulesTest, WinByTwoNeedsTwoWinLead) {
+    MatchRules winByTwo {MatchTermination::WinByTwo, 2};
+    std::vector<std::size_t> requests;
+
+    // Win, loss, win, loss, win, win: 4-2.
+    EXPECT_EQ(PlayAgainstRock({2, 3, 2, 3, 2, 2, 2}, 20, winByTwo, &requests), 6);
+    EXPECT_EQ(requests, (std::vector<std::size_t>{2, 2, 2}));
+
+    // Alternating wins never open a lead, so the limit ends it.
+    EXPECT_EQ(PlayAgainstRock({2, 3, 2, 3, 2, 3}, 6, winByTwo), 6);
+}
+
+/**
+ * @test Verify the single-player game modes map to their rules.
+ */
+TEST(SinglePlayerRpsGameRulesTest, GameModesSelectRules) {
+    EXPECT_EQ(MatchRulesFor(GameMode::ConsoleSinglePlayer, 7).termination, MatchTermination::FixedRounds);
+    EXPECT_EQ(MatchRulesFor(GameMode::SinglePlayerBestOf, 7).termination, MatchTermination::BestOf);
+    EXPECT_EQ(MatchRulesFor(GameMode::SinglePlayerFirstTo, 7).termination, MatchTermination::FirstTo);
+    EXPECT_EQ(MatchRulesFor(GameMode::SinglePlayerFirstTo, 7).winsNeeded, 4);
+    EXPECT_EQ(MatchRulesFor(GameMode::SinglePlayerWinByTwo, 8).winsNeeded, 5);
+    static_assert(static_cast<std::size_t>(GameMode::SinglePlayerWinByTwo) + 1 == kBuiltinGameModeCount);
+}
\ No newline at end of file
@@ -0,0 +1,275 @@
+/**
+ * @file test_SpectatorChannel.cpp
+ * @brief Unit tests for SpectatorChannel and SpectatorFeed.
+ *
+ * ## Test Strategy
+ * Subscribers are one end of a Unix socket pair; the test reads the other
+ * end. A subscriber that never reads, with a small socket buffer, stands
+ * in for a slow spectator, so the slow-subscriber policies can be
+ * observed without timing assumptions.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Every subscriber receives every frame
+ *   Given a channel with three subscribers
+ *   When frames are published
+ *   Then each subscriber reads all of them, in order
+ *
+ * ### Scenario: A late subscriber starts at the latest frame
+ *   Given a channel that already published frames
+ *   When a subscriber joins
+ *   Then it first receives the latest frame, then the new ones
+ *
+ * ### Scenario: A slow subscriber is disconnected
+ *   Given a Disconnect channel with a subscriber that never reads
+ *   When far more frames are published than the backlog holds
+ *   Then the slow subscriber is closed and a reading subscriber gets every frame
+ *
+ * ### Scenario: A slow subscriber skips to the latest frame
+ *   Given a SkipToLatest channel with a subscriber that stops reading
+ *   When it resumes after many frames
+ *   Then it receives whole frames only, ending with the latest one
+ *
+ * ### Scenario: A session is broadcast round by round
+ *   Given a SpectatorFeed observing a three-round session
+ *   When the session is played
+ *   Then spectators see a line per round with the running score and a final line
+ */
+
+ #include <gtest/gtest.h>
+ #include <chrono>
+ #include <poll.h>
+ #include <string>
+ #include <sys/socket.h>
+ #include <thread>
+ #include <unistd.h>
+ #include <vector>
+ #include "ComputerPlayer.hpp"
+ #include "QueuedMoveMessenger.hpp"
+ #include "SinglePlayerRpsGame.hpp"
+ #include "SpectatorChannel.hpp"
+ #include "SpectatorFeed.hpp"
+ #include "UserPlayer.hpp"
+
+ namespace {
+
+ /**
+  * @brief A socket pair: the channel owns `channelEnd`, the test reads `viewer`.
+  */
+ struct Viewer {
+     int channelEnd {-1};
+     int viewer {-1};
+
+     explicit Viewer(int sendBuffer = 0) {
+         int fds[2] {};
+         EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+         channelEnd = fds[0];
+         viewer = fds[1];
+         if (sendBuffer > 0) {
+             ::setsockopt(channelEnd, SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+             ::setsockopt(viewer, SOL_SOCKET, SO_RCVBUF, &sendBuffer, sizeof(sendBuffer));
+         }
+     }
+
+     ~Viewer() {
+         ::close(viewer);
+     }
+
+     /**
+      * @brief Reads until `text` ends what was read, EOF, or a 5 s timeout.
+      */
+     std::string ReadUntil(const std::string& text) {
+         std::string received;
+         auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+         while (received.size() < text.size() || received.compare(received.size() - text.size(), text.size(), text) != 0) {
+             pollfd ready { viewer, POLLIN, 0 };
+             if (std::chrono::steady_clock::now() > deadline || ::poll(&ready, 1, 100) < 0) {
+                 break;
+             }
+             if (!(ready.revents & (POLLIN | POLLHUP))) {
+                 continue;
+             }
+             char buffer[4096];
+             ssize_t count { ::read(viewer, buffer, sizeof(buffer)) };
+             if (count <= 0) {
+                 break;
+             }
+             received.append(buffer, static_cast<std::size_t>(count));
+         }
+         return received;
+     }
+ };
+
+ std::string FrameText(int index) {
+     return "frame " + std::to_string(index) + "\n";
+ }
+
+ std::string FramesText(int first, int last) {
+     std::string text;
+     for (int i {first}; i <= last; ++i) {
+         text += FrameText(i);
+     }
+     return text;
+ }
+
+ template <typename Predicate>
+ bool WaitFor(Predicate predicate) {
+     auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+     while (!predicate()) {
+         if (std::chrono::steady_clock::now() > deadline) {
+             return false;
+         }
+         std::this_thread::sleep_for(std::chrono::milliseconds(1));
+     }
+     return true;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies fan-out of every frame to every subscriber.
+  */
+ TEST(SpectatorChannelTest, EverySubscriberReceivesEveryFrame)
+ {
+     SpectatorChannel channel;
+     std::vector<std::unique_ptr<Viewer>> viewers;
+     for (int i{}; i < 3; ++i) {
+         viewers.push_back(std::make_unique<Viewer>());
+         channel.Subscribe(viewers.back()->channelEnd);
+     }
+     ASSERT_TRUE(WaitFor([&]() { return channel.Stats().subscribers == 3; }));
+
+     for (int i{}; i < 100; ++i) {
+         channel.Publish(SpectatorChannel::MakeFrame(FrameText(i)));
+     }
+     for (auto& viewer : viewers) {
+         EXPECT_EQ(viewer->ReadUntil(FrameText(99)), FramesText(0, 99));
+     }
+     EXPECT_EQ(channel.Stats().framesPublished, 100u);
+     EXPECT_EQ(channel.Stats().bytesSent, 3 * FramesText(0, 99).size());
+ }
+
+ /**
+  * @test Verifies that a new subscriber starts with the latest frame.
+  */
+ TEST(SpectatorChannelTest, LateSubscriberStartsAtLatestFrame)
+ {
+     SpectatorChannel channel;
+     Viewer early;
+     channel.Subscribe(early.channelEnd);
+     ASSERT_TRUE(WaitFor([&]() { return channel.Stats().subscribers == 1; }));
+     for (int i{}; i < 5; ++i) {
+         channel.Publish(SpectatorChannel::MakeFrame(FrameText(i)));
+     }
+     ASSERT_EQ(early.ReadUntil(FrameText(4)), FramesText(0, 4));
+
+     Viewer late;
+     channel.Subscribe(late.channelEnd);
+     ASSERT_TRUE(WaitFor([&]() { return channel.Stats().subscribers == 2; }));
+     channel.Publish(SpectatorChannel::MakeFrame(FrameText(5)));
+     EXPECT_EQ(late.ReadUntil(FrameText(5)), FramesText(4, 5));
+ }
+
+ /**
+  * @test Verifies the Disconnect policy.
+  */
+ TEST(SpectatorChannelTest, DisconnectsSlowSubscriber)
+ {
+     SpectatorOptions options {};
+     options.backlogFrames = 16;
+     options.policy = SlowSubscriberPolicy::Disconnect;
+     SpectatorChannel channel{options};
+
+     Viewer slow{4096};
+     Viewer fast;
+     channel.Subscribe(slow.channelEnd);
+     channel.Subscribe(fast.channelEnd);
+     ASSERT_TRUE(WaitFor([&]() { return channel.Stats().subscribers == 2; }));
+
+     // The fast viewer keeps up by reading after every few frames.
+     std::string received;
+     std::string expected;
+     const std::string padding(200, '.');
+     for (int i{}; i < 2000; ++i) {
+         channel.Publish(SpectatorChannel::MakeFrame(padding + FrameText(i)));
+         expected += padding + FrameText(i);
+         if (i % 8 == 7) {
+             received += fast.ReadUntil(FrameText(i));
+         }
+     }
+     ASSERT_TRUE(WaitFor([&]() { return channel.Stats().disconnected == 1; }));
+     EXPECT_EQ(channel.Stats().subscribers, 1u);
+     EXPECT_EQ(received, expected);
+
+     // Whatever the slow viewer got ends at EOF after the channel closed it.
+     std::string leftover { slow.ReadUntil("\x01") };
+     EXPECT_LT(leftover.size(), 2000 * padding.size());
+ }
+
+ /**
+  * @test Verifies the SkipToLatest policy.
+  */
+ TEST(SpectatorChannelTest, SlowSubscriberSkipsToLatest)
+ {
+     SpectatorOptions options {};
+     options.backlogFrames = 16;
+     SpectatorChannel channel{options};
+
+     Viewer slow{4096};
+     channel.Subscribe(slow.channelEnd);
+     ASSERT_TRUE(WaitFor([&]() { return channel.Stats().subscribers == 1; }));
+
+     const std::string padding(200, '.');
+     for (int i{}; i < 2000; ++i) {
+         channel.Publish(SpectatorChannel::MakeFrame(padding + FrameText(i)));
+     }
+     ASSERT_TRUE(WaitFor([&]() { return channel.Stats().skippedFrames > 0; }));
+
+     std::string received { slow.ReadUntil(FrameText(1999)) };
+     ASSERT_FALSE(received.empty());
+     EXPECT_EQ(received.substr(received.size() - FrameText(1999).size()), FrameText(1999));
+     EXPECT_LT(received.size(), 2000 * padding.size());
+
+     // Only whole frames arrive: every line is padding plus a frame number.
+     std::size_t lines {};
+     for (std::size_t start {}; start < received.size(); ++lines) {
+         std::size_t end { received.find('\n', start) };
+         ASSERT_NE(end, std::string::npos);
+         std::string line { received.substr(start, end - start) };
+         ASSERT_EQ(line.compare(0, padding.size(), padding), 0) << line;
+         ASSERT_EQ(line.compare(padding.size(), 6, "frame "), 0) << line;
+         start = end + 1;
+     }
+     EXPECT_EQ(channel.Stats().skippedFrames + lines, 2000u);
+     EXPECT_EQ(channel.Stats().disconnected, 0u);
+ }
+
+ /**
+  * @test Verifies the text a SpectatorFeed publishes for a session.
+  */
+ TEST(SpectatorFeedTest, BroadcastsSessionRoundByRound)
+ {
+     SpectatorChannel channel;
+     SpectatorFeed feed{channel};
+     Viewer viewer;
+     channel.Subscribe(viewer.channelEnd);
+     ASSERT_TRUE(WaitFor([&]() { return channel.Stats().subscribers == 1; }));
+
+     // Rock vs Paper, Rock vs Scissors, Paper vs Paper.
+     auto messenger = std::make_unique<QueuedMoveMessenger>();
+     for (int choice : {1, 1, 2}) {
+         messenger->PushMove(choice);
+     }
+     int computerChoices[] {1, 2, 1};
+     int next {};
+     SinglePlayerRpsGame game{std::make_shared<UserPlayer>("Ann"), std::make_shared<ComputerPlayer>("Bot"),
+                              std::move(messenger), 3, [&]() { return computerChoices[next++]; }};
+     game.SetRoundObserver(&feed, 1);
+     game.Play();
+
+     EXPECT_EQ(viewer.ReadUntil("final after 3 rounds: [User] Ann vs [Computer] Bot 1-1, 1 drawn\n"),
+               "round 1: [User] Ann rock, [Computer] Bot paper: [Computer] Bot wins (0-1, 0 drawn)\n"
+               "round 2: [User] Ann rock, [Computer] Bot scissors: [User] Ann wins (1-1, 0 drawn)\n"
+               "round 3: [User] Ann paper, [Computer] Bot paper: draw (1-1, 1 drawn)\n"
+               "final after 3 rounds: [User] Ann vs [Computer] Bot 1-1, 1 drawn\n");
+ }
+ 
\ No newline at end of file
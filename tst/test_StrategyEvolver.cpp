@@ -0,0 +1,215 @@
+/**
+ * @file test_StrategyEvolver.cpp
+ * @brief Unit tests for StrategyGenome, GenomeStrategy and StrategyEvolver.
+ *
+ * ## Test Strategy
+ * GenomeStrategy is checked against hand-built tables. The evolver is run
+ * on small configurations: against fixed opponents a good strategy is
+ * known, and determinism is checked by comparing whole populations across
+ * thread counts and across a checkpoint round trip.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: A genome plays its opening, then its table
+ *   Given a k=1 genome whose table answers each opponent move with its counter
+ *   When it plays against a cycling opponent
+ *   Then it plays the opening move first and wins every later round
+ *
+ * ### Scenario: Evolution finds the counter to a fixed opponent
+ *   Given a population evolved against a constant "rock" player
+ *   When it runs for some generations
+ *   Then the mean fitness rises and the best reaches nearly 1
+ *
+ * ### Scenario: Evolution does not depend on the thread count
+ *   Given the same config run on 1 and on 3 threads
+ *   Then every generation's report and population are identical
+ *
+ * ### Scenario: A resumed run continues exactly
+ *   Given a run checkpointed after 2 generations and resumed for 2 more
+ *   Then its population equals that of an uninterrupted 4-generation run
+ *
+ * ### Scenario: Bad configs and checkpoints are rejected
+ *   Given unknown opponents, impossible sizes or a corrupt file
+ *   Then construction or loading throws
+ */
+
+ #include <cstdio>
+ #include <fstream>
+ #include <gtest/gtest.h>
+ #include <stdexcept>
+ #include <string>
+ #include "MoveStrategies.hpp"
+ #include "StrategyEvolver.hpp"
+
+ namespace {
+
+ EvolutionConfig SmallConfig() {
+     EvolutionConfig config {};
+     config.masterSeed = 42;
+     config.historyLength = 1;
+     config.populationSize = 24;
+     config.roundsPerMatch = 30;
+     config.matchesPerOpponent = 2;
+     config.opponents = {"rock", "cycle", "random"};
+     return config;
+ }
+
+ std::string TempPath(const char* name) {
+     return ::testing::TempDir() + name;
+ }
+
+ } // namespace
+
+ /**
+  * @test Verifies the opening moves and the table lookup.
+  */
+ TEST(StrategyGenomeTest, GenomePlaysOpeningThenTable)
+ {
+     EXPECT_EQ(StrategyGenome::GeneCount(0), 1u);
+     EXPECT_EQ(StrategyGenome::GeneCount(2), 83u);
+     EXPECT_THROW(StrategyGenome::GeneCount(StrategyGenome::kMaxHistoryLength + 1), std::invalid_argument);
+
+     // Table index = own * 3 + opponent (0-based); answer the opponent's last move's counter.
+     StrategyGenome genome { StrategyGenome::Blank(1) };
+     genome.genes[0] = 2; // open with scissors
+     for (int own{}; own < 3; ++own) {
+         for (int opponent{}; opponent < 3; ++opponent) {
+             genome.genes[1 + own * 3 + opponent] = static_cast<std::uint8_t>((opponent + 2) % 3);
+         }
+     }
+     ASSERT_TRUE(genome.IsValid());
+
+     // Against rock, paper, scissors, ...: counter the move that comes next.
+     GenomeStrategy strategy{genome};
+     EXPECT_TRUE(strategy.DependsOnHistory());
+     CycleStrategy opponent;
+     EXPECT_EQ(strategy.NextMove(), GameMove::Scissors);
+     for (int round{}; round < 12; ++round) {
+         GameMove own { strategy.NextMove() };
+         GameMove other { opponent.NextMove() };
+         if (round > 0) {
+             EXPECT_EQ(own, BeatingMove(other)) << round;
+         }
+         strategy.ObserveRound(own, other);
+     }
+
+     StrategyGenome broken { genome };
+     broken.genes.pop_back();
+     EXPECT_FALSE(broken.IsValid());
+     EXPECT_THROW(GenomeStrategy{broken}, std::invalid_argument);
+     broken = genome;
+     broken.genes[3] = 3;
+     EXPECT_FALSE(broken.IsValid());
+ }
+
+ /**
+  * @test Verifies that fitness improves against a fixed opponent.
+  */
+ TEST(StrategyEvolverTest, EvolutionFindsCounterToFixedOpponents)
+ {
+     EvolutionConfig config { SmallConfig() };
+     config.opponents = {"rock"};
+     StrategyEvolver evolver{config, 2};
+     EXPECT_THROW(evolver.Best(), std::logic_error);
+
+     GenerationReport first { evolver.Step() };
+     EXPECT_EQ(first.generation, 0u);
+     EXPECT_EQ(first.matches, 24u * 1 * 2);
+     GenerationReport last {};
+     for (int g{}; g < 30; ++g) {
+         last = evolver.Step();
+     }
+     EXPECT_EQ(evolver.Generation(), 31u);
+     EXPECT_GT(last.meanFitness, first.meanFitness + 0.3);
+     EXPECT_GT(last.bestFitness, 0.9);
+     EXPECT_GE(last.bestFitness, last.meanFitness);
+     EXPECT_GT(evolver.Evaluate(evolver.Best(), 30, 0), 0);
+     EXPECT_EQ(evolver.Population().size(), 24u);
+ }
+
+ /**
+  * @test Verifies identical runs on 1 and 3 threads.
+  */
+ TEST(StrategyEvolverTest, EvolutionDoesNotDependOnThreadCount)
+ {
+     StrategyEvolver single{SmallConfig(), 1};
+     StrategyEvolver several{SmallConfig(), 3};
+     for (int g{}; g < 4; ++g) {
+         GenerationReport a { single.Step() };
+         GenerationReport b { several.Step() };
+         EXPECT_EQ(a.bestFitness, b.bestFitness) << g;
+         EXPECT_EQ(a.meanFitness, b.meanFitness) << g;
+         ASSERT_EQ(single.Population(), several.Population()) << g;
+     }
+     EXPECT_EQ(single.Best(), several.Best());
+ }
+
+ /**
+  * @test Verifies that a checkpointed run resumes exactly.
+  */
+ TEST(StrategyEvolverTest, ResumedRunContinuesExactly)
+ {
+     std::string path { TempPath("evolver.ckpt") };
+     StrategyEvolver straight{SmallConfig(), 2};
+     for (int g{}; g < 4; ++g) {
+         straight.Step();
+     }
+
+     {
+         StrategyEvolver interrupted{SmallConfig(), 2};
+         interrupted.Step();
+         interrupted.Step();
+         interrupted.SaveCheckpoint(path);
+     }
+     StrategyEvolver resumed { StrategyEvolver::LoadCheckpoint(path, 1) };
+     EXPECT_EQ(resumed.Config(), SmallConfig());
+     EXPECT_EQ(resumed.Generation(), 2u);
+     resumed.Step();
+     resumed.Step();
+     EXPECT_EQ(resumed.Generation(), 4u);
+     EXPECT_EQ(resumed.Population(), straight.Population());
+     EXPECT_EQ(resumed.Best(), straight.Best());
+     EXPECT_EQ(resumed.BestFitness(), straight.BestFitness());
+     std::remove(path.c_str());
+ }
+
+ /**
+  * @test Verifies rejection of bad configs and checkpoint files.
+  */
+ TEST(StrategyEvolverTest, BadConfigsAndCheckpointsAreRejected)
+ {
+     EvolutionConfig config { SmallConfig() };
+     config.opponents = {"rock", "lizard"};
+     EXPECT_THROW(StrategyEvolver{config}, std::invalid_argument);
+     config = SmallConfig();
+     config.opponents.clear();
+     EXPECT_THROW(StrategyEvolver{config}, std::invalid_argument);
+     config = SmallConfig();
+     config.populationSize = 1;
+     EXPECT_THROW(StrategyEvolver{config}, std::invalid_argument);
+     config = SmallConfig();
+     config.eliteCount = 25;
+     EXPECT_THROW(StrategyEvolver{config}, std::invalid_argument);
+     config = SmallConfig();
+     config.mutationRate = 1.5;
+     EXPECT_THROW(StrategyEvolver{config}, std::invalid_argument);
+
+     std::string path { TempPath("evolver_bad.ckpt") };
+     EXPECT_THROW(StrategyEvolver::LoadCheckpoint(path + ".missing"), std::runtime_error);
+     StrategyEvolver{SmallConfig(), 1}.SaveCheckpoint(path);
+     std::string bytes;
+     {
+         std::ifstream file{path, std::ios::binary};
+         bytes.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+     }
+     for (std::size_t cut : {std::size_t{3}, bytes.size() / 2, bytes.size() - 1}) {
+         std::ofstream{path, std::ios::binary | std::ios::trunc}.write(bytes.data(), static_cast<std::streamsize>(cut));
+         EXPECT_THROW(StrategyEvolver::LoadCheckpoint(path), std::runtime_error) << cut;
+     }
+     std::string badGene { bytes };
+     badGene.back() = 7;
+     std::ofstream{path, std::ios::binary | std::ios::trunc}.write(badGene.data(),
+                                                                   static_cast<std::streamsize>(badGene.size()));
+     EXPECT_THROW(StrategyEvolver::LoadCheckpoint(path), std::runtime_error);
+     std::remove(path.c_str());
+ }
+ 
\ No newline at end of file
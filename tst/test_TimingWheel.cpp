@@ -0,0 +1,181 @@
+/**
+ * @file test_TimingWheel.cpp
+ * @brief Unit tests for the TimingWheel class using Google Test.
+ *
+ * ## Test Strategy
+ * Timers are armed at deadlines that exercise every level of the wheel
+ * and the overflow list; Advance() must fire each exactly at its tick,
+ * in any step size, and cancelled timers must never fire.
+ *
+ * ## Gherkin Tests
+ * ### Scenario: Timers fire at their deadline
+ *   Given timers due in 5, 300, 70000 and 2^25 ticks
+ *   When the wheel advances tick by tick or in one large step
+ *   Then each timer fires exactly when its deadline is reached
+ *
+ * ### Scenario: Cancelled timers do not fire
+ *   Given two armed timers
+ *   When one is cancelled and the other is destroyed
+ *   Then advancing past both deadlines fires nothing
+ *
+ * ### Scenario: Deadlines beyond the wheel wait in overflow
+ *   Given a timer due 2^33 + 7 ticks from now
+ *   When the wheel advances to one tick before and then to the deadline
+ *   Then it fires only on the second advance
+ *
+ * ### Scenario: Callbacks can re-arm their timer
+ *   Given a timer whose callback re-arms it 10 ticks later
+ *   When the wheel advances 100 ticks
+ *   Then the timer has fired 10 times
+ *
+ * ### Scenario: The next-event hint never overshoots
+ *   Given a timer due in 1000 ticks
+ *   When TicksUntilNextEvent is queried
+ *   Then it is at most 1000
+ */
+
+ #include <gtest/gtest.h>
+ #include <cstdint>
+ #include <random>
+ #include <vector>
+ #include "TimingWheel.hpp"
+
+ /**
+  * @test Verifies that timers fire exactly at their deadline at every level.
+  */
+ TEST(TimingWheelTest, TimersFireAtDeadline)
+ {
+     const std::vector<std::uint64_t> delays {5, 300, 70000, std::uint64_t{1} << 25};
+     for (bool stepwise : {true, false}) {
+         TimingWheel wheel{1000};
+         std::vector<std::uint64_t> firedAt(delays.size());
+         std::vector<TimingWheel::Timer> timers(delays.size());
+         for (std::size_t i{}; i < delays.size(); ++i) {
+             timers[i].SetCallback([&wheel, &firedAt, i]() { firedAt[i] = wheel.Now(); });
+             wheel.ScheduleAfter(timers[i], delays[i]);
+         }
+         EXPECT_EQ(wheel.Size(), delays.size());
+
+         if (stepwise) {
+             for (std::uint64_t tick {1001}; tick <= 1000 + delays.back(); ++tick) {
+                 wheel.Advance(tick);
+             }
+         } else {
+             EXPECT_EQ(wheel.Advance(1000 + delays.back()), delays.size());
+         }
+         for (std::size_t i{}; i < delays.size(); ++i) {
+             EXPECT_EQ(firedAt[i], 1000 + delays[i]);
+         }
+         EXPECT_EQ(wheel.Size(), 0u);
+     }
+ }
+
+ /**
+  * @test Verifies that random deadlines fire in time order.
+  */
+ TEST(TimingWheelTest, RandomDeadlinesFireInOrder)
+ {
+     TimingWheel wheel;
+     std::mt19937_64 engine{3};
+     std::vector<TimingWheel::Timer> timers(2000);
+     std::uint64_t lastFired {};
+     std::size_t fired {};
+     bool ordered {true};
+     for (auto& timer : timers) {
+         timer.SetCallback([&]() {
+             ordered = ordered && wheel.Now() >= lastFired;
+             lastFired = wheel.Now();
+             ++fired;
+         });
+         wheel.Schedule(timer, 1 + engine() % 5'000'000);
+     }
+     for (std::uint64_t now {}; now <= 5'000'000; now += 1 + engine() % 40'000) {
+         wheel.Advance(now);
+     }
+     wheel.Advance(5'000'000);
+     EXPECT_TRUE(ordered);
+     EXPECT_EQ(fired, timers.size());
+     for (const auto& timer : timers) {
+         EXPECT_FALSE(timer.IsArmed());
+     }
+ }
+
+ /**
+  * @test Verifies that cancelled and destroyed timers never fire.
+  */
+ TEST(TimingWheelTest, CancelledTimersDoNotFire)
+ {
+     TimingWheel wheel;
+     int fired {};
+     TimingWheel::Timer kept{[&fired]() { ++fired; }};
+     wheel.ScheduleAfter(kept, 400);
+     {
+         TimingWheel::Timer scoped{[&fired]() { ++fired; }};
+         wheel.ScheduleAfter(scoped, 10);
+     }
+     wheel.Cancel(kept);
+     EXPECT_FALSE(kept.IsArmed());
+     EXPECT_EQ(wheel.Size(), 0u);
+     EXPECT_EQ(wheel.Advance(1000), 0u);
+     EXPECT_EQ(fired, 0);
+ }
+
+ /**
+  * @test Verifies that very distant deadlines wait in the overflow list.
+  */
+ TEST(TimingWheelTest, DistantDeadlinesUseOverflow)
+ {
+     TimingWheel wheel;
+     int fired {};
+     TimingWheel::Timer timer{[&fired]() { ++fired; }};
+     const std::uint64_t deadline { (std::uint64_t{1} << 33) + 7 };
+     wheel.Schedule(timer, deadline);
+
+     wheel.Advance(deadline - 1);
+     EXPECT_EQ(fired, 0);
+     EXPECT_TRUE(timer.IsArmed());
+     wheel.Advance(deadline);
+     EXPECT_EQ(fired, 1);
+ }
+
+ /**
+  * @test Verifies that a callback may re-arm its own timer.
+  */
+ TEST(TimingWheelTest, CallbackCanRearmTimer)
+ {
+     TimingWheel wheel;
+     int fired {};
+     TimingWheel::Timer timer;
+     timer.SetCallback([&]() {
+         ++fired;
+         wheel.ScheduleAfter(timer, 10);
+     });
+     wheel.ScheduleAfter(timer, 10);
+
+     wheel.Advance(100);
+     EXPECT_EQ(fired, 10);
+     EXPECT_TRUE(timer.IsArmed());
+     EXPECT_EQ(timer.Deadline(), 110u);
+ }
+
+ /**
+  * @test Verifies that the next-event hint never overshoots the next expiry.
+  */
+ TEST(TimingWheelTest, NextEventHintNeverOvershoots)
+ {
+     TimingWheel wheel{250};
+     TimingWheel::Timer timer;
+     EXPECT_EQ(wheel.TicksUntilNextEvent(), UINT64_MAX);
+
+     wheel.ScheduleAfter(timer, 1000);
+     std::uint64_t now {250};
+     while (timer.IsArmed()) {
+         std::uint64_t hint { wheel.TicksUntilNextEvent() };
+         ASSERT_GT(hint, 0u);
+         ASSERT_LE(now + hint, 1250u);
+         now += hint;
+         wheel.Advance(now);
+     }
+     EXPECT_EQ(now, 1250u);
+ }
+ 
\ No newline at end of file
@@ -39,6 +39,7 @@
  public:
      MockUserPlayer() : UserPlayer("Mock") {}
      MOCK_METHOD(std::string, GetName, (), (const, override));
+     MOCK_METHOD(std::string_view, GetNameView, (), (const, override));
      MOCK_METHOD(int, GetScore, (), (const, override));
      MOCK_METHOD(void, AddWin, (), (override));
  };
@@ -82,6 +83,16 @@
      EXPECT_EQ(m_player->GetName(), "[User] Alice");
  }
  
+ TEST_F(UserPlayerTestFixture, GetNameViewMatchesGetName) {
+     EXPECT_EQ(m_player->GetNameView(), "[User] Alice");
+     EXPECT_EQ(m_player->GetNameView(), m_player->GetName());
+ }
+ 
+ TEST_F(UserPlayerTestFixture, EqualNamesShareInternedStorage) {
+     UserPlayer other("Alice");
+     EXPECT_EQ(other.GetNameView().data(), m_player->GetNameView().data());
+ }
+ 
  TEST_F(UserPlayerTestFixture, InitialScoreIsZero) {
      EXPECT_EQ(m_player->GetScore(), 0);
  }